@@ -7,20 +7,31 @@ subdirs   += $(call kconf_enabled,KARN_TEST,test)
 test-deps := src
 
 HEADERDIR := $(CURDIR)/include
-headers    = karn/common.h karn/farr.h karn/fabs_tree.h
+headers    = karn/common.h karn/farr.h karn/farr_tmpl.h karn/fabs_tree.h
 headers   += $(call kconf_enabled,KARN_SLIST,karn/slist.h)
 headers   += $(call kconf_enabled,KARN_DLIST,karn/dlist.h)
 headers   += $(call kconf_enabled,KARN_FBNR_HEAP,karn/fbnr_heap.h)
+headers   += $(call kconf_enabled,KARN_FDARY_HEAP,karn/fdary_heap.h)
+headers   += $(call kconf_enabled,KARN_FKEY_HEAP,karn/fkey_heap.h)
+headers   += $(call kconf_enabled,KARN_FIDX_HEAP,karn/fidx_heap.h)
+headers   += $(call kconf_enabled,KARN_FMMX_HEAP,karn/fmmx_heap.h)
+headers   += $(call kconf_enabled,KARN_FSHD_HEAP,karn/fshd_heap.h)
+headers   += $(call kconf_enabled,KARN_RADIX_HEAP,karn/radix_heap.h)
 headers   += $(call kconf_enabled,KARN_LCRS,karn/lcrs.h)
 headers   += $(call kconf_enabled,KARN_SBNM_HEAP,karn/sbnm_heap.h)
 headers   += $(call kconf_enabled,KARN_DBNM_HEAP,karn/dbnm_heap.h)
 headers   += $(call kconf_enabled,KARN_SPAIR_HEAP,karn/spair_heap.h)
+headers   += $(call kconf_enabled,KARN_RPAIR_HEAP,karn/rpair_heap.h)
+headers   += $(call kconf_enabled,KARN_RWK_HEAP,karn/rwk_heap.h)
 headers   += $(call kconf_enabled,KARN_FBMP,karn/fbmp.h)
 headers   += $(call kconf_enabled,KARN_FWK_HEAP,karn/fwk_heap.h)
 headers   += $(call kconf_enabled,KARN_PBNM_HEAP,karn/pbnm_heap.h)
 headers   += $(call kconf_enabled,KARN_FALLOC,karn/falloc.h)
+headers   += $(call kconf_enabled,KARN_FEYT_TREE,karn/feyt_tree.h)
 headers   += $(call kconf_enabled,KARN_AVL,karn/avl.h)
 headers   += $(call kconf_enabled,KARN_PAVL,karn/pavl.h)
+headers   += $(call kconf_enabled,KARN_LTREE,karn/ltree.h)
+headers   += $(call kconf_enabled,KARN_XSORT,karn/xsort.h)
 
 define libkarn_pkgconf_tmpl
 prefix=$(PREFIX)
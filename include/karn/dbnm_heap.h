@@ -39,19 +39,26 @@ struct dbnm_heap_node {
 #define dbnm_heap_entry(_node, _type, _member) \
 	containerof(_node, _type, _member)
 
+/*
+ * dbnm_lazy counts singleton roots prepended by dbnm_heap_insert_lazy() to the
+ * root list since last consolidation.
+ */
 struct dbnm_heap {
 	struct dlist_node dbnm_roots;
 	unsigned int      dbnm_count;
+	unsigned int      dbnm_lazy;
 };
 
 #define dbnm_heap_assert(_heap) \
 	karn_assert(_heap); \
-	karn_assert(dlist_empty(&(_heap)->dbnm_roots) ^ (_heap)->dbnm_count)
+	karn_assert(dlist_empty(&(_heap)->dbnm_roots) ^ (_heap)->dbnm_count); \
+	karn_assert((_heap)->dbnm_lazy <= (_heap)->dbnm_count)
 
 #define DBNM_HEAP_INIT(_heap)                                 \
 	{                                                     \
 		.dbnm_roots = DLIST_INIT((_heap).dbnm_roots), \
-		.dbnm_count = 0                               \
+		.dbnm_count = 0,                              \
+		.dbnm_lazy  = 0                               \
 	}
 
 typedef int (dbnm_heap_compare_fn)(const struct dbnm_heap_node *restrict first,
@@ -67,6 +74,22 @@ extern void dbnm_heap_insert(struct dbnm_heap      *heap,
                              struct dbnm_heap_node *key,
                              dbnm_heap_compare_fn  *compare);
 
+extern void dbnm_heap_insert_lazy(struct dbnm_heap      *heap,
+                                  struct dbnm_heap_node *key);
+
+extern void dbnm_heap_consolidate(struct dbnm_heap     *heap,
+                                  dbnm_heap_compare_fn *compare);
+
+extern void dbnm_heap_insert_batch(struct dbnm_heap      *heap,
+                                   struct dbnm_heap_node *keys[],
+                                   unsigned int           nr,
+                                   dbnm_heap_compare_fn  *compare);
+
+extern unsigned int dbnm_heap_extract_batch(struct dbnm_heap      *heap,
+                                            struct dbnm_heap_node *keys[],
+                                            unsigned int           nr,
+                                            dbnm_heap_compare_fn  *compare);
+
 extern void dbnm_heap_remove(struct dbnm_heap      *heap,
                              struct dbnm_heap_node *key,
                              dbnm_heap_compare_fn  *compare);
@@ -102,6 +125,9 @@ dbnm_heap_merge(struct dbnm_heap     *result,
 	karn_assert(result);
 	karn_assert(source);
 
+	dbnm_heap_consolidate(result, compare);
+	dbnm_heap_consolidate(source, compare);
+
 	dbnm_heap_merge_trees(&result->dbnm_roots, &source->dbnm_roots,
 	                      compare);
 
@@ -115,6 +141,7 @@ dbnm_heap_init(struct dbnm_heap* heap)
 
 	dlist_init(&heap->dbnm_roots);
 	heap->dbnm_count = 0;
+	heap->dbnm_lazy = 0;
 }
 
 #endif /* _KARN_DBNM_HEAP_H */
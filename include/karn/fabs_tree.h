@@ -30,7 +30,6 @@
 #define _KARN_FABS_TREE_H
 
 #include <karn/farr.h>
-#include <utils/pow2.h>
 #include <stdbool.h>
 
 /**
@@ -40,9 +39,9 @@
  */
 struct fabs_tree {
 	/** Number of nodes currently sitting into the tree */
-	unsigned int fabs_count;
+	size_t      fabs_count;
 	/** Array of nodes contained in this tree */
-	struct farr  fabs_nodes;
+	struct farr fabs_nodes;
 };
 
 /* Internal fabs_tree consistency checker */
@@ -61,7 +60,7 @@ struct fabs_tree {
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_nr(const struct fabs_tree *tree)
+static inline size_t fabs_tree_nr(const struct fabs_tree *tree)
 {
 	fabs_tree_assert(tree);
 
@@ -77,7 +76,7 @@ static inline unsigned int fabs_tree_nr(const struct fabs_tree *tree)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_count(const struct fabs_tree *tree)
+static inline size_t fabs_tree_count(const struct fabs_tree *tree)
 {
 	fabs_tree_assert(tree);
 
@@ -143,7 +142,7 @@ static inline size_t fabs_tree_node_size(const struct fabs_tree *tree)
  * @ingroup fabs_tree
  */
 static inline char * fabs_tree_node(const struct fabs_tree *tree,
-                                    unsigned int            index)
+                                    size_t                  index)
 {
 	fabs_tree_assert(tree);
 	karn_assert(index < farr_nr(&tree->fabs_nodes));
@@ -161,8 +160,8 @@ static inline char * fabs_tree_node(const struct fabs_tree *tree,
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_node_index(const struct fabs_tree *tree,
-                                                const char             *node)
+static inline size_t fabs_tree_node_index(const struct fabs_tree *tree,
+                                          const char             *node)
 {
 	fabs_tree_assert(tree);
 
@@ -198,7 +197,7 @@ static inline char * fabs_tree_root(const struct fabs_tree *tree)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int
+static inline size_t
 fabs_tree_last_index(const struct fabs_tree *tree)
 {
 	karn_assert(!fabs_tree_empty(tree));
@@ -234,7 +233,7 @@ static inline char * fabs_tree_last(const struct fabs_tree *tree)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_bottom_index(const struct fabs_tree *tree)
+static inline size_t fabs_tree_bottom_index(const struct fabs_tree *tree)
 {
 	karn_assert(!fabs_tree_full(tree));
 
@@ -265,7 +264,7 @@ fabs_tree_bottom(const struct fabs_tree *tree)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_left_child_index(unsigned int index)
+static inline size_t fabs_tree_left_child_index(size_t index)
 {
 	return (2 * index) + 1;
 }
@@ -279,7 +278,7 @@ static inline unsigned int fabs_tree_left_child_index(unsigned int index)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_right_child_index(unsigned int index)
+static inline size_t fabs_tree_right_child_index(size_t index)
 {
 	return (2 * index) + 2;
 }
@@ -295,7 +294,7 @@ static inline unsigned int fabs_tree_right_child_index(unsigned int index)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_parent_index(unsigned int index)
+static inline size_t fabs_tree_parent_index(size_t index)
 {
 	karn_assert(index);
 
@@ -311,9 +310,9 @@ static inline unsigned int fabs_tree_parent_index(unsigned int index)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int fabs_tree_index_depth(unsigned int index)
+static inline unsigned int fabs_tree_index_depth(size_t index)
 {
-	return pow2_lower(index + 1);
+	return farr_log2_lower(index + 1);
 }
 
 /**
@@ -337,12 +336,12 @@ static inline unsigned int fabs_tree_index_depth(unsigned int index)
  *
  * @ingroup fabs_tree
  */
-static inline unsigned int
-fabs_tree_ancestor_index(unsigned int index, unsigned int depth_offset)
+static inline size_t
+fabs_tree_ancestor_index(size_t index, unsigned int depth_offset)
 {
 	karn_assert(depth_offset <= fabs_tree_index_depth(index));
 
-	return (index - (1U << depth_offset) + 1) >> depth_offset;
+	return (index - ((size_t)1 << depth_offset) + 1) >> depth_offset;
 }
 
 /**
@@ -409,7 +408,7 @@ static inline void fabs_tree_debit(struct fabs_tree *tree)
 static inline void fabs_tree_init(struct fabs_tree *tree,
                                   char             *nodes,
                                   size_t            node_size,
-                                  unsigned int      node_nr)
+                                  size_t            node_nr)
 {
 	karn_assert(tree);
 	karn_assert(nodes);
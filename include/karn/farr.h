@@ -31,6 +31,8 @@
 
 #include <karn/common.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
 #include <sys/types.h>
 
 /**
@@ -69,11 +71,11 @@ typedef void (farr_copy_fn)(char       *restrict destination,
  * @ingroup farr
  */
 struct farr {
-        size_t        farr_size;
+        size_t  farr_size;
 	/** maximum number of slots this array can hold */
-	unsigned int  farr_nr;
+	size_t  farr_nr;
 	/** underlying memory area holding slots */
-	char         *farr_slots;
+	char   *farr_slots;
 };
 
 /* Internal farr consistency checker */
@@ -83,6 +85,25 @@ struct farr {
 	karn_assert((_array)->farr_slots); \
 	karn_assert((_array)->farr_nr)
 
+/*
+ * Internal base 2 logarithm helpers, respectively rounded down and up.
+ *
+ * Operate onto size_t wide values so that depths computed out of entry counts
+ * remain correct for arrays holding more than UINT_MAX entries.
+ */
+static inline unsigned int farr_log2_lower(size_t value)
+{
+	karn_assert(value);
+
+	return (unsigned int)((sizeof(value) * CHAR_BIT) - 1 -
+	                      (size_t)__builtin_clzl(value));
+}
+
+static inline unsigned int farr_log2_upper(size_t value)
+{
+	return farr_log2_lower(value) + !!(value & (value - 1));
+}
+
 /**
  * Retrieve the maximum number of slots a farr may contain
  *
@@ -92,7 +113,7 @@ struct farr {
  *
  * @ingroup farr
  */
-static inline unsigned int
+static inline size_t
 farr_nr(const struct farr *array)
 {
 	farr_assert(array);
@@ -131,7 +152,7 @@ farr_slot_size(const struct farr *array)
  *
  * @ingroup farr
  */
-static inline char * farr_slot(const struct farr *array, unsigned int index)
+static inline char * farr_slot(const struct farr *array, size_t index)
 {
 	farr_assert(array);
 	karn_assert(index < array->farr_nr);
@@ -168,8 +189,8 @@ static inline char * farr_slot(const struct farr *array, unsigned int index)
  *
  * @ingroup farr
  */
-static inline unsigned int farr_slot_index(const struct farr *array,
-                                           const char        *slot)
+static inline size_t farr_slot_index(const struct farr *array,
+                                     const char        *slot)
 {
 	farr_assert(array);
 	karn_assert(slot >= &array->farr_slots[0]);
@@ -232,7 +253,7 @@ static inline void farr_swap(char         *first,
 static inline void farr_init(struct farr  *array,
                              char         *slots,
                              size_t        slot_size,
-                             unsigned int  slot_nr)
+                             size_t        slot_nr)
 {
 	karn_assert(array);
 	karn_assert(slots);
@@ -256,11 +277,70 @@ static inline void farr_fini(struct farr *array __unused)
 	farr_assert(array);
 }
 
+#if defined(CONFIG_KARN_FARR_GROW)
+
+/**
+ * Size in bytes above which farr_alloc() and farr_realloc() map slots storage
+ * as anonymous memory instead of allocating it from the heap.
+ *
+ * Mapped storage is resized using mremap() which, unlike realloc(), never
+ * copies slots but moves page table entries instead.
+ *
+ * @ingroup farr
+ */
+#define FARR_MMAP_THRESHOLD (128UL * 1024UL)
+
+/**
+ * Initialize an farr and allocate its slots storage
+ *
+ * @param array     farr to initialize
+ * @param slot_size size in bytes of a single slot
+ * @param slot_nr   maximum number of slots @p array may contain
+ *
+ * Storage must be released using farr_free().
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p slot_size or a
+ * zero @p slot_nr.
+ *
+ * @ingroup farr
+ */
+extern int farr_alloc(struct farr *array, size_t slot_size, size_t slot_nr);
+
+/**
+ * Resize slots storage allocated by farr_alloc()
+ *
+ * @param array   farr to resize
+ * @param slot_nr new maximum number of slots @p array may contain
+ *
+ * Content of the first slots fitting into the new storage is preserved.
+ * @p array is left untouched on failure.
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p slot_nr.
+ *
+ * @ingroup farr
+ */
+extern int farr_realloc(struct farr *array, size_t slot_nr);
+
+/**
+ * Release slots storage allocated by farr_alloc()
+ *
+ * @param array farr to release storage for
+ *
+ * @ingroup farr
+ */
+extern void farr_free(struct farr *array);
+
+#endif /* defined(CONFIG_KARN_FARR_GROW) */
+
 #if defined(CONFIG_KARN_FARR_BUBBLE_SORT)
 
 extern void farr_bubble_sort(char            *entries,
                              size_t           entry_size,
-                             unsigned int     entry_nr,
+                             size_t           entry_nr,
                              farr_compare_fn *compare,
                              farr_copy_fn    *copy);
 
@@ -270,7 +350,7 @@ extern void farr_bubble_sort(char            *entries,
 
 extern void farr_selection_sort(char            *entries,
                                 size_t           entry_size,
-                                unsigned int     entry_nr,
+                                size_t           entry_nr,
                                 farr_compare_fn *compare,
                                 farr_copy_fn    *copy);
 
@@ -280,7 +360,7 @@ extern void farr_selection_sort(char            *entries,
 
 extern void farr_insertion_sort(char            *entries,
                                 size_t           entry_size,
-                                unsigned int     entry_nr,
+                                size_t           entry_nr,
                                 farr_compare_fn *compare,
                                 farr_copy_fn    *copy);
 
@@ -290,7 +370,7 @@ extern void farr_insertion_sort(char            *entries,
 
 extern void farr_quick_sort(char            *entries,
                             size_t           entry_size,
-                            unsigned int     entry_nr,
+                            size_t           entry_nr,
                             farr_compare_fn *compare,
                             farr_copy_fn    *copy);
 
@@ -300,10 +380,696 @@ extern void farr_quick_sort(char            *entries,
 
 extern void farr_intro_sort(char            *entries,
                             size_t           entry_size,
-                            unsigned int     entry_nr,
+                            size_t           entry_nr,
                             farr_compare_fn *compare,
                             farr_copy_fn    *copy);
 
 #endif /* defined(CONFIG_KARN_FARR_INTRO_SORT) */
 
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
+
+/**
+ * Sort array passed as argument according to pattern defeating quick sort
+ * scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ *
+ * Partition using Tukey's ninther pivots for large ranges, gather duplicates
+ * with an equal keys partitioning, detect already sorted, reversed and already
+ * partitioned ranges, break patterns causing unbalanced partitions and fall
+ * back to fbnr_heap_sort() when too many of them are encountered.
+ *
+ * Branchless block partitioning is implemented by type specialized variants
+ * generated by farr_tmpl.h only since it requires inlined comparisons.
+ *
+ * @ingroup farr
+ */
+extern void farr_pdq_sort(char            *entries,
+                          size_t           entry_size,
+                          size_t           entry_nr,
+                          farr_compare_fn *compare,
+                          farr_copy_fn    *copy);
+
+#endif /* defined(CONFIG_KARN_FARR_PDQ_SORT) */
+
+#if defined(CONFIG_KARN_FARR_TIM_SORT)
+
+/**
+ * Sort array passed as argument according to Timsort stable natural merge sort
+ * scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ *
+ * Detect existing non-descending and strictly descending runs, extend short
+ * ones up to a minimum run length using binary insertion sort then merge them
+ * using galloping mode when a run wins consistently. Entries comparing equal
+ * keep their relative order.
+ *
+ * Auxiliary memory is allocated on demand while merging and never exceeds half
+ * the array size. Presorted arrays require no allocation at all.
+ *
+ * @retval 0       success
+ * @retval -ENOMEM auxiliary memory allocation failure, entries are left in an
+ *                 unspecified order
+ *
+ * @ingroup farr
+ */
+extern int farr_tim_sort(char            *entries,
+                         size_t           entry_size,
+                         size_t           entry_nr,
+                         farr_compare_fn *compare,
+                         farr_copy_fn    *copy);
+
+#endif /* defined(CONFIG_KARN_FARR_TIM_SORT) */
+
+#if defined(CONFIG_KARN_FARR_INDIRECT_SORT)
+
+/**
+ * @typedef farr_prefix_fn
+ *
+ * @brief Array slot key prefix extraction function prototype
+ *
+ * @param entry array slot to extract key prefix from
+ *
+ * @return unsigned integer key prefix
+ *
+ * Given 2 entries, if their prefixes differ, comparing prefixes must yield
+ * the same result as the farr_compare_fn given to sorting functions does.
+ *
+ * @ingroup farr
+ */
+typedef uint64_t (farr_prefix_fn)(const char *entry);
+
+/**
+ * Sort array passed as argument indirectly.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ * @param prefix     optional key prefix extraction function
+ *
+ * Sort a compact array of pointers to entries, then move each entry once
+ * only by following permutation cycles. Meant for large entries where
+ * moving entries costs more than comparing them.
+ *
+ * When @p prefix is given, a 64 bits key prefix is cached next to each
+ * pointer so that entries are dereferenced only when prefixes are equal.
+ *
+ * Sorting is not stable.
+ *
+ * @retval 0       success
+ * @retval -ENOMEM index memory allocation failure, entries are left untouched
+ *
+ * @ingroup farr
+ */
+extern int farr_sort_indirect(char            *entries,
+                              size_t           entry_size,
+                              size_t           entry_nr,
+                              farr_compare_fn *compare,
+                              farr_copy_fn    *copy,
+                              farr_prefix_fn  *prefix);
+
+/**
+ * Array permuted alongside keys by farr_cosort().
+ *
+ * @ingroup farr
+ */
+struct farr_cosort_array {
+	/** array of entries to permute */
+	char         *cosort_entries;
+	/** size in bytes of a single array entry */
+	size_t        cosort_size;
+	/** copy function used to move entries */
+	farr_copy_fn *cosort_copy;
+};
+
+/**
+ * Sort array of keys and apply the same permutation to parallel arrays.
+ *
+ * @param keys       array of keys to sort
+ * @param key_size   size in bytes of a single key
+ * @param key_nr     number of keys, and of entries of each parallel array
+ * @param compare    comparison function used to order keys
+ * @param copy       copy function used to move keys
+ * @param prefix     optional key prefix extraction function
+ * @param payloads   parallel arrays to permute
+ * @param payload_nr number of parallel arrays
+ *
+ * Sorting is performed indirectly as for farr_sort_indirect(), including
+ * optional @p prefix caching, and is not stable.
+ *
+ * @retval 0       success
+ * @retval -ENOMEM index memory allocation failure, arrays are left untouched
+ *
+ * @ingroup farr
+ */
+extern int farr_cosort(char                           *keys,
+                       size_t                          key_size,
+                       size_t                          key_nr,
+                       farr_compare_fn                *compare,
+                       farr_copy_fn                   *copy,
+                       farr_prefix_fn                 *prefix,
+                       const struct farr_cosort_array *payloads,
+                       unsigned int                    payload_nr);
+
+#endif /* defined(CONFIG_KARN_FARR_INDIRECT_SORT) */
+
+#if defined(CONFIG_KARN_FARR_SELECT)
+
+/**
+ * Select the nth lowest entry of array passed as argument.
+ *
+ * @param entries    array of entries to select from
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param nth        index of entry to select, starting from zero
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ *
+ * Rearrange array so that entry located at index @p nth is the one that would
+ * sit there if array were sorted. Entries preceding it compare lower than or
+ * equal to it and entries following it compare greater than or equal to it.
+ *
+ * Implements introspective selection: quick selection based upon Hoare
+ * partitioning switching to median of medians pivot selection when too many
+ * unbalanced partitions are encountered so that worst case time complexity is
+ * O(n).
+ *
+ * @return pointer to selected entry
+ *
+ * @warning Behavior is undefined if @p nth is not lower than @p entry_nr.
+ *
+ * @ingroup farr
+ */
+extern char * farr_select(char            *entries,
+                          size_t           entry_size,
+                          size_t           entry_nr,
+                          size_t           nth,
+                          farr_compare_fn *compare,
+                          farr_copy_fn    *copy);
+
+/**
+ * Sort the lowest entries of array passed as argument.
+ *
+ * @param entries    array of entries to partially sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param sort_nr    number of lowest entries to sort
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ *
+ * Move the @p sort_nr lowest entries to the head of array in sorted order,
+ * leaving remaining entries in unspecified order, in O(n + k.log(k)) time
+ * complexity.
+ *
+ * @warning Behavior is undefined if @p sort_nr is zero or greater than
+ * @p entry_nr.
+ *
+ * @ingroup farr
+ */
+extern void farr_partial_sort(char            *entries,
+                              size_t           entry_size,
+                              size_t           entry_nr,
+                              size_t           sort_nr,
+                              farr_compare_fn *compare,
+                              farr_copy_fn    *copy);
+
+/**
+ * Retrieve the greatest entries of array passed as argument.
+ *
+ * @param entries    array of entries to select from
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param top        array where to store greatest entries
+ * @param top_nr     number of greatest entries to retrieve
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ *
+ * Store the @p top_nr greatest entries into @p top in descending order, i.e.
+ * greatest entry first. @p entries is left untouched and walked once only
+ * using a binary heap of @p top_nr entries, in O(n.log(k)) time complexity.
+ *
+ * @warning Behavior is undefined if @p top_nr is zero or greater than
+ * @p entry_nr.
+ *
+ * @ingroup farr
+ */
+extern void farr_top_k(const char      *entries,
+                       size_t           entry_size,
+                       size_t           entry_nr,
+                       char            *top,
+                       size_t           top_nr,
+                       farr_compare_fn *compare,
+                       farr_copy_fn    *copy);
+
+#endif /* defined(CONFIG_KARN_FARR_SELECT) */
+
+#if defined(CONFIG_KARN_FARR_NETWORK_SORT)
+
+/**
+ * Maximum number of entries sorting network functions may sort.
+ *
+ * @ingroup farr
+ */
+#define FARR_NETWORK_SORT_MAX (64U)
+
+/**
+ * Sort small array of unsigned 32 bits integers using a sorting network.
+ *
+ * @param entries  array of keys to sort
+ * @param entry_nr number of keys, up to #FARR_NETWORK_SORT_MAX
+ *
+ * Keys are sorted using a bitonic sorting network vectorized using AVX2 when
+ * the processor supports it, which is checked at runtime on x86 unless enabled
+ * at build time (-mavx2). Otherwise, SSE4.1 is used when enabled at build time
+ * (-msse4.1) and a branchless scalar fallback as a last resort. Meant to be
+ * used as the base case of larger sorting schemes. A handful of keys are
+ * insertion sorted instead.
+ *
+ * @warning Behavior is undefined if @p entry_nr is greater than
+ *          #FARR_NETWORK_SORT_MAX.
+ *
+ * @ingroup farr
+ */
+extern void farr_uint32_network_sort(uint32_t *entries, unsigned int entry_nr);
+
+/**
+ * Sort small array of signed 32 bits integers using a sorting network.
+ *
+ * @param entries  array of keys to sort
+ * @param entry_nr number of keys, up to #FARR_NETWORK_SORT_MAX
+ *
+ * @see farr_uint32_network_sort()
+ *
+ * @ingroup farr
+ */
+extern void farr_int32_network_sort(int32_t *entries, unsigned int entry_nr);
+
+/**
+ * Sort small array of floats using a sorting network.
+ *
+ * @param entries  array of keys to sort
+ * @param entry_nr number of keys, up to #FARR_NETWORK_SORT_MAX
+ *
+ * NaN keys are not handled in a consistent manner.
+ *
+ * @see farr_uint32_network_sort()
+ *
+ * @ingroup farr
+ */
+extern void farr_float_network_sort(float *entries, unsigned int entry_nr);
+
+/**
+ * Sort small array of unsigned 64 bits integers using a sorting network.
+ *
+ * @param entries  array of keys to sort
+ * @param entry_nr number of keys, up to #FARR_NETWORK_SORT_MAX
+ *
+ * Vectorized with AVX2 only since SSE4.1 provides no 64 bits comparison.
+ *
+ * @see farr_uint32_network_sort()
+ *
+ * @ingroup farr
+ */
+extern void farr_uint64_network_sort(uint64_t *entries, unsigned int entry_nr);
+
+#endif /* defined(CONFIG_KARN_FARR_NETWORK_SORT) */
+
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+
+/*
+ * Prebuilt type specialized sorting functions generated from farr_tmpl.h
+ * template. These perform comparison and copy inline, saving the function
+ * pointer dispatching overhead of their generic counterparts.
+ *
+ * Floating point sorting does not handle NaN keys in a consistent manner.
+ * Pointer sorting orders entries according to their address values.
+ *
+ * When CONFIG_KARN_FARR_NETWORK_SORT is enabled and SSE4.1 or AVX2 networks
+ * are available (see farr_uint32_network_sort()), 32 bits integer and float
+ * variants sort small partitions using sorting networks instead of insertion
+ * sort. So does the 64 bits unsigned integer variant with AVX2.
+ */
+
+extern void farr_uint32_insertion_sort(uint32_t *entries,
+                                       size_t    entry_nr);
+extern void farr_uint32_quick_sort(uint32_t *entries,
+                                   size_t    entry_nr);
+extern void farr_uint32_intro_sort(uint32_t *entries,
+                                   size_t    entry_nr);
+extern void farr_uint32_pdq_sort(uint32_t *entries,
+                                 size_t    entry_nr);
+
+extern void farr_int32_insertion_sort(int32_t *entries,
+                                      size_t   entry_nr);
+extern void farr_int32_quick_sort(int32_t *entries,
+                                  size_t   entry_nr);
+extern void farr_int32_intro_sort(int32_t *entries,
+                                  size_t   entry_nr);
+extern void farr_int32_pdq_sort(int32_t *entries,
+                                size_t   entry_nr);
+
+extern void farr_uint64_insertion_sort(uint64_t *entries,
+                                       size_t    entry_nr);
+extern void farr_uint64_quick_sort(uint64_t *entries,
+                                   size_t    entry_nr);
+extern void farr_uint64_intro_sort(uint64_t *entries,
+                                   size_t    entry_nr);
+extern void farr_uint64_pdq_sort(uint64_t *entries,
+                                 size_t    entry_nr);
+
+extern void farr_int64_insertion_sort(int64_t *entries,
+                                      size_t   entry_nr);
+extern void farr_int64_quick_sort(int64_t *entries,
+                                  size_t   entry_nr);
+extern void farr_int64_intro_sort(int64_t *entries,
+                                  size_t   entry_nr);
+extern void farr_int64_pdq_sort(int64_t *entries,
+                                size_t   entry_nr);
+
+extern void farr_float_insertion_sort(float  *entries,
+                                      size_t  entry_nr);
+extern void farr_float_quick_sort(float  *entries,
+                                  size_t  entry_nr);
+extern void farr_float_intro_sort(float  *entries,
+                                  size_t  entry_nr);
+extern void farr_float_pdq_sort(float  *entries,
+                                size_t  entry_nr);
+
+extern void farr_double_insertion_sort(double *entries,
+                                       size_t  entry_nr);
+extern void farr_double_quick_sort(double *entries,
+                                   size_t  entry_nr);
+extern void farr_double_intro_sort(double *entries,
+                                   size_t  entry_nr);
+extern void farr_double_pdq_sort(double *entries,
+                                 size_t  entry_nr);
+
+extern void farr_ptr_insertion_sort(void   **entries,
+                                    size_t   entry_nr);
+extern void farr_ptr_quick_sort(void   **entries,
+                                size_t   entry_nr);
+extern void farr_ptr_intro_sort(void   **entries,
+                                size_t   entry_nr);
+extern void farr_ptr_pdq_sort(void   **entries,
+                              size_t   entry_nr);
+
+#endif /* defined(CONFIG_KARN_FARR_TYPED_SORT) */
+
+#if defined(CONFIG_KARN_FARR_RADIX_SORT)
+
+/**
+ * @typedef farr_radix_key_fn
+ *
+ * @brief Array slot radix key extraction function prototype
+ *
+ * @param entry array slot to extract key from
+ *
+ * @return unsigned integer key
+ *
+ * Returned keys must order entries in the same way as the farr_compare_fn
+ * given to radix sorting functions does. Signed keys should be mapped to
+ * unsigned ones by flipping their sign bit.
+ *
+ * @ingroup farr
+ */
+typedef uint64_t (farr_radix_key_fn)(const char *entry);
+
+/**
+ * Sort array passed as argument according to least significant digit radix
+ * sort scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param key_size   number of significant key bytes (1 to 8)
+ * @param key        key extraction function
+ * @param copy       copy function used to move entries
+ * @param scratch    auxiliary memory area able to hold @p entry_nr entries or
+ *                   %NULL to have it allocated internally
+ *
+ * Digits are 8 bits wide. Digit histograms are computed in a single pass and
+ * passes for which all entries share the same digit are skipped.
+ * Sorting is stable.
+ *
+ * @retval 0       success
+ * @retval -ENOMEM scratch memory allocation failure
+ *
+ * @ingroup farr
+ */
+extern int farr_lsd_radix_sort(char              *entries,
+                               size_t             entry_size,
+                               size_t             entry_nr,
+                               unsigned int       key_size,
+                               farr_radix_key_fn *key,
+                               farr_copy_fn      *copy,
+                               char              *scratch);
+
+/**
+ * Sort array passed as argument according to in-place most significant digit
+ * radix sort scheme (American flag sort).
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param key_size   number of significant key bytes (1 to 8)
+ * @param key        key extraction function
+ * @param compare    comparison function used to sort small buckets
+ * @param copy       copy function used to move entries
+ *
+ * Buckets smaller than an internal threshold are sorted using insertion
+ * sort. Sorting is not stable.
+ *
+ * @ingroup farr
+ */
+extern void farr_msd_radix_sort(char              *entries,
+                                size_t             entry_size,
+                                size_t             entry_nr,
+                                unsigned int       key_size,
+                                farr_radix_key_fn *key,
+                                farr_compare_fn   *compare,
+                                farr_copy_fn      *copy);
+
+/**
+ * Sort array passed as argument according to a radix sort scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param key_size   number of significant key bytes (1 to 8)
+ * @param key        key extraction function
+ * @param compare    comparison function used to sort small buckets
+ * @param copy       copy function used to move entries
+ * @param scratch    optional auxiliary memory area able to hold @p entry_nr
+ *                   entries
+ *
+ * Use farr_lsd_radix_sort() for large arrays and farr_msd_radix_sort() for
+ * smaller ones or when scratch memory cannot be allocated.
+ *
+ * @ingroup farr
+ */
+extern void farr_radix_sort(char              *entries,
+                            size_t             entry_size,
+                            size_t             entry_nr,
+                            unsigned int       key_size,
+                            farr_radix_key_fn *key,
+                            farr_compare_fn   *compare,
+                            farr_copy_fn      *copy,
+                            char              *scratch);
+
+/**
+ * Sort array of 32 bits unsigned integers according to least significant digit
+ * radix sort scheme.
+ *
+ * @param entries  array of entries to sort
+ * @param entry_nr number of array entries
+ * @param scratch  auxiliary memory area able to hold @p entry_nr entries or
+ *                 %NULL to have it allocated internally
+ *
+ * @retval 0       success
+ * @retval -ENOMEM scratch memory allocation failure
+ *
+ * @ingroup farr
+ */
+extern int farr_uint32_radix_sort(uint32_t *entries,
+                                  size_t    entry_nr,
+                                  uint32_t *scratch);
+
+/**
+ * Sort array of 64 bits unsigned integers according to least significant digit
+ * radix sort scheme.
+ *
+ * @param entries  array of entries to sort
+ * @param entry_nr number of array entries
+ * @param scratch  auxiliary memory area able to hold @p entry_nr entries or
+ *                 %NULL to have it allocated internally
+ *
+ * @retval 0       success
+ * @retval -ENOMEM scratch memory allocation failure
+ *
+ * @ingroup farr
+ */
+extern int farr_uint64_radix_sort(uint64_t *entries,
+                                  size_t    entry_nr,
+                                  uint64_t *scratch);
+
+#endif /* defined(CONFIG_KARN_FARR_RADIX_SORT) */
+
+#if defined(CONFIG_KARN_FARR_COUNTING_SORT)
+
+/**
+ * @typedef farr_counting_key_fn
+ *
+ * @brief Array slot bounded range key extraction function prototype
+ *
+ * @param entry array slot to extract key from
+ *
+ * @return unsigned integer key
+ *
+ * Returned keys must order entries in the same way as the farr_compare_fn
+ * given to counting and bucket sorting functions does.
+ *
+ * @ingroup farr
+ */
+typedef uint64_t (farr_counting_key_fn)(const char *entry);
+
+/**
+ * Sort array passed as argument according to counting sort scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param key_nr     number of distinct keys, i.e. @p key returns values
+ *                   ranging from 0 to @p key_nr - 1
+ * @param key        key extraction function
+ * @param copy       copy function used to move entries
+ * @param scratch    auxiliary memory area able to hold @p entry_nr entries or
+ *                   %NULL to have it allocated internally
+ *
+ * Entries are scattered into @p scratch according to a histogram of keys
+ * then copied back. Runs in O(@p entry_nr + @p key_nr) time and requires
+ * @p key_nr counters. Sorting is stable.
+ *
+ * @retval 0       success
+ * @retval -ENOMEM counters or scratch memory allocation failure
+ *
+ * @ingroup farr
+ */
+extern int farr_counting_sort(char                 *entries,
+                              size_t                entry_size,
+                              size_t                entry_nr,
+                              size_t                key_nr,
+                              farr_counting_key_fn *key,
+                              farr_copy_fn         *copy,
+                              char                 *scratch);
+
+/**
+ * Sort array passed as argument according to bucket sort scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param key_min    lowest key @p key may return
+ * @param key_max    greatest key @p key may return
+ * @param key        key extraction function
+ * @param compare    comparison function used to sort buckets
+ * @param copy       copy function used to move entries
+ * @param scratch    auxiliary memory area able to hold @p entry_nr entries or
+ *                   %NULL to have it allocated internally
+ *
+ * [@p key_min, @p key_max] key range is split into up to @p entry_nr buckets
+ * of equal width. Entries are distributed into buckets which are then sorted
+ * using farr_insertion_sort(). Meant for uniformly distributed keys: runs in
+ * O(@p entry_nr) average time in this case, degrades to O(@p entry_nr ^ 2)
+ * when most keys fall into the same bucket. Sorting is stable.
+ *
+ * @retval 0       success
+ * @retval -ENOMEM counters or scratch memory allocation failure
+ *
+ * @ingroup farr
+ */
+extern int farr_bucket_sort(char                 *entries,
+                            size_t                entry_size,
+                            size_t                entry_nr,
+                            uint64_t              key_min,
+                            uint64_t              key_max,
+                            farr_counting_key_fn *key,
+                            farr_compare_fn      *compare,
+                            farr_copy_fn         *copy,
+                            char                 *scratch);
+
+/**
+ * Sort array passed as argument according to the range of its keys.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param key        key extraction function
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ * @param scratch    optional auxiliary memory area able to hold @p entry_nr
+ *                   entries
+ *
+ * Observe the range of keys in a first pass and use farr_counting_sort() when
+ * it is small relative to @p entry_nr. Fall back to farr_intro_sort()
+ * otherwise or when memory cannot be allocated, in which case sorting is not
+ * stable.
+ *
+ * @ingroup farr
+ */
+extern void farr_range_sort(char                 *entries,
+                            size_t                entry_size,
+                            size_t                entry_nr,
+                            farr_counting_key_fn *key,
+                            farr_compare_fn      *compare,
+                            farr_copy_fn         *copy,
+                            char                 *scratch);
+
+#endif /* defined(CONFIG_KARN_FARR_COUNTING_SORT) */
+
+#if defined(CONFIG_KARN_FARR_PARALLEL_SORT)
+
+/**
+ * Sort array passed as argument using multiple threads.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ * @param thread_nr  maximum number of threads to run sorting with, calling
+ *                   thread included
+ *
+ * Implement a sample sort scheme: splitters are selected out of an
+ * oversampled set of entries so that array is distributed into one bucket per
+ * thread ; each bucket is then sorted concurrently using farr_intro_sort().
+ * Entries equal to a splitter are given their own bucket which needs no
+ * sorting so that arrays with few distinct keys still spread across threads.
+ * Threads are spawned once and synchronized between phases by a barrier.
+ *
+ * Number of threads is reduced for small arrays. When auxiliary memory cannot
+ * be allocated, sorting is performed by calling thread using
+ * farr_intro_sort().
+ *
+ * @ingroup farr
+ */
+extern void farr_parallel_sort(char            *entries,
+                               size_t           entry_size,
+                               size_t           entry_nr,
+                               farr_compare_fn *compare,
+                               farr_copy_fn    *copy,
+                               unsigned int     thread_nr);
+
+#endif /* defined(CONFIG_KARN_FARR_PARALLEL_SORT) */
+
 #endif /* _KARN_FARR_H */
@@ -0,0 +1,796 @@
+/**
+ * @file      farr_tmpl.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array type specialized sorting template
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * This header is meant to be included multiple times, once per key type to
+ * generate sorting functions for. It stamps out insertion, quick,
+ * introspective and pattern defeating quick sorting variants operating upon
+ * arrays of a concrete C type where comparison and copy are inlined, i.e. with
+ * no function pointer dispatching at all.
+ *
+ * Template parameters must be defined prior to inclusion and are undefined
+ * once generation is completed:
+ * - FARR_TMPL_NAME:    name component inserted into generated symbols, i.e.
+ *                      farr_<FARR_TMPL_NAME>_intro_sort(),
+ * - FARR_TMPL_TYPE:    C type of array entries (copied by assignment),
+ * - FARR_TMPL_COMPARE: function like macro taking 2 pointers to
+ *                      FARR_TMPL_TYPE entries and returning an integer with
+ *                      the same semantics as farr_compare_fn,
+ * - FARR_TMPL_FUNC:    optional linkage / storage attributes of generated
+ *                      public functions ; defaults to "static inline",
+ * - FARR_TMPL_BASE_SORT: optional function like macro taking a pointer to
+ *                      FARR_TMPL_TYPE entries and a number of entries, used to
+ *                      sort partitions of up to FARR_TMPL_BASE_THRESHOLD
+ *                      entries instead of insertion sorting, e.g. a sorting
+ *                      network,
+ * - FARR_TMPL_BASE_THRESHOLD: maximum number of entries FARR_TMPL_BASE_SORT
+ *                      may be given ; mandatory when FARR_TMPL_BASE_SORT is
+ *                      defined.
+ *
+ * Example:
+ *
+ *     struct item { uint32_t key; uint32_t data; };
+ *
+ *     #define FARR_TMPL_NAME          item
+ *     #define FARR_TMPL_TYPE          struct item
+ *     #define FARR_TMPL_COMPARE(_a, _b) \
+ *             ((int)((_a)->key > (_b)->key) - (int)((_a)->key < (_b)->key))
+ *     #include <karn/farr_tmpl.h>
+ *
+ * generates farr_item_insertion_sort(), farr_item_quick_sort(),
+ * farr_item_intro_sort() and farr_item_pdq_sort(), all of them taking a struct
+ * item pointer and a number of entries as arguments.
+ */
+
+#ifndef _KARN_FARR_TMPL_H
+#define _KARN_FARR_TMPL_H
+
+#include <karn/farr.h>
+#include <stdbool.h>
+
+#define FARR_TMPL_INSERT_THRESHOLD      (32U)
+
+/* Pattern defeating quick sort tunables, see farr_pdq_sort(). */
+#define FARR_TMPL_PDQ_INSERT_THRESHOLD  (24U)
+#define FARR_TMPL_PDQ_NINTHER_THRESHOLD (128U)
+#define FARR_TMPL_PDQ_PARTIAL_LIMIT     (8U)
+#define FARR_TMPL_PDQ_BLOCK_SIZE        (64U)
+
+#define _farr_tmpl_concat(_prefix, _name, _suffix) _prefix ## _name ## _suffix
+
+#define farr_tmpl_concat(_prefix, _name, _suffix) \
+	_farr_tmpl_concat(_prefix, _name, _suffix)
+
+#define farr_tmpl_symbol(_suffix) \
+	farr_tmpl_concat(farr_, FARR_TMPL_NAME, _suffix)
+
+static inline unsigned int farr_tmpl_stack_depth(size_t entry_nr)
+{
+	size_t nr = (entry_nr + FARR_TMPL_INSERT_THRESHOLD - 1) /
+	            FARR_TMPL_INSERT_THRESHOLD;
+
+	return farr_log2_upper((nr > 2) ? nr : 2);
+}
+
+#endif /* _KARN_FARR_TMPL_H */
+
+#if !defined(FARR_TMPL_NAME)
+#error Missing FARR_TMPL_NAME sorting template parameter !
+#endif
+
+#if !defined(FARR_TMPL_TYPE)
+#error Missing FARR_TMPL_TYPE sorting template parameter !
+#endif
+
+#if !defined(FARR_TMPL_COMPARE)
+#error Missing FARR_TMPL_COMPARE sorting template parameter !
+#endif
+
+#if !defined(FARR_TMPL_FUNC)
+#define FARR_TMPL_FUNC static inline
+#endif
+
+#if defined(FARR_TMPL_BASE_SORT) && !defined(FARR_TMPL_BASE_THRESHOLD)
+#error Missing FARR_TMPL_BASE_THRESHOLD sorting template parameter !
+#endif
+
+static inline void farr_tmpl_symbol(_swap)(FARR_TMPL_TYPE *first,
+                                           FARR_TMPL_TYPE *second)
+{
+	FARR_TMPL_TYPE tmp = *first;
+
+	*first = *second;
+	*second = tmp;
+}
+
+static inline void farr_tmpl_symbol(_insert)(FARR_TMPL_TYPE *begin,
+                                             FARR_TMPL_TYPE *end)
+{
+	FARR_TMPL_TYPE *unsort = begin + 1;
+
+	while (unsort <= end) {
+		FARR_TMPL_TYPE  tmp = *unsort;
+		FARR_TMPL_TYPE *ent = unsort;
+
+		while ((ent > begin) && (FARR_TMPL_COMPARE(&tmp, ent - 1) < 0)) {
+			*ent = *(ent - 1);
+			ent--;
+		}
+
+		*ent = tmp;
+
+		unsort++;
+	}
+}
+
+/* Tell whether [begin, end] partition is small enough for _base_sort(). */
+static inline bool farr_tmpl_symbol(_small)(FARR_TMPL_TYPE *begin,
+                                            FARR_TMPL_TYPE *end)
+{
+#if defined(FARR_TMPL_BASE_SORT)
+	return (size_t)(end - begin) < FARR_TMPL_BASE_THRESHOLD;
+#else
+	return (size_t)(end - begin) < FARR_TMPL_INSERT_THRESHOLD;
+#endif
+}
+
+static inline void farr_tmpl_symbol(_base_sort)(FARR_TMPL_TYPE *begin,
+                                                FARR_TMPL_TYPE *end)
+{
+#if defined(FARR_TMPL_BASE_SORT)
+	FARR_TMPL_BASE_SORT(begin, (unsigned int)(end + 1 - begin));
+#else
+	farr_tmpl_symbol(_insert)(begin, end);
+#endif
+}
+
+static inline FARR_TMPL_TYPE *
+farr_tmpl_symbol(_hoare_part)(FARR_TMPL_TYPE *begin, FARR_TMPL_TYPE *end)
+{
+	FARR_TMPL_TYPE *mid = begin + ((end - begin) / 2);
+	FARR_TMPL_TYPE  pivot;
+
+	if (FARR_TMPL_COMPARE(begin, mid) > 0)
+		farr_tmpl_symbol(_swap)(begin, mid);
+
+	if (FARR_TMPL_COMPARE(mid, end) > 0) {
+		farr_tmpl_symbol(_swap)(mid, end);
+
+		if (FARR_TMPL_COMPARE(begin, mid) > 0)
+			farr_tmpl_symbol(_swap)(begin, mid);
+	}
+
+	pivot = *mid;
+
+	while (true) {
+		while (FARR_TMPL_COMPARE(&pivot, begin) > 0)
+			begin++;
+
+		while (FARR_TMPL_COMPARE(end, &pivot) > 0)
+			end--;
+
+		if (begin >= end)
+			return end;
+
+		farr_tmpl_symbol(_swap)(begin, end);
+
+		begin++;
+		end--;
+	}
+}
+
+static inline void farr_tmpl_symbol(_siftdown)(FARR_TMPL_TYPE *entries,
+                                               size_t          root,
+                                               size_t          entry_nr)
+{
+	FARR_TMPL_TYPE tmp = entries[root];
+
+	while (true) {
+		size_t child = (2 * root) + 1;
+
+		if (child >= entry_nr)
+			break;
+
+		if (((child + 1) < entry_nr) &&
+		    (FARR_TMPL_COMPARE(&entries[child], &entries[child + 1]) < 0))
+			child++;
+
+		if (FARR_TMPL_COMPARE(&tmp, &entries[child]) >= 0)
+			break;
+
+		entries[root] = entries[child];
+		root = child;
+	}
+
+	entries[root] = tmp;
+}
+
+static inline void farr_tmpl_symbol(_heap_sort)(FARR_TMPL_TYPE *entries,
+                                                size_t          entry_nr)
+{
+	size_t idx = entry_nr / 2;
+
+	while (idx--)
+		farr_tmpl_symbol(_siftdown)(entries, idx, entry_nr);
+
+	while (entry_nr > 1) {
+		entry_nr--;
+
+		farr_tmpl_symbol(_swap)(&entries[0], &entries[entry_nr]);
+		farr_tmpl_symbol(_siftdown)(entries, 0, entry_nr);
+	}
+}
+
+FARR_TMPL_FUNC void farr_tmpl_symbol(_insertion_sort)(FARR_TMPL_TYPE *entries,
+                                                      size_t          entry_nr)
+{
+	karn_assert(entries);
+	karn_assert(entry_nr);
+
+	farr_tmpl_symbol(_insert)(entries, &entries[entry_nr - 1]);
+}
+
+FARR_TMPL_FUNC void farr_tmpl_symbol(_quick_sort)(FARR_TMPL_TYPE *entries,
+                                                  size_t          entry_nr)
+{
+	karn_assert(entries);
+	karn_assert(entry_nr);
+
+	FARR_TMPL_TYPE *begin = entries;
+	FARR_TMPL_TYPE *end = &entries[entry_nr - 1];
+	unsigned int    ptop = 0;
+	struct {
+		FARR_TMPL_TYPE *begin;
+		FARR_TMPL_TYPE *end;
+	}               parts[farr_tmpl_stack_depth(entry_nr)];
+
+	while (true) {
+		FARR_TMPL_TYPE *pivot;
+
+		while (farr_tmpl_symbol(_small)(begin, end)) {
+			farr_tmpl_symbol(_base_sort)(begin, end);
+
+			if (!ptop--)
+				return;
+
+			begin = parts[ptop].begin;
+			end = parts[ptop].end;
+		}
+
+		pivot = farr_tmpl_symbol(_hoare_part)(begin, end);
+		karn_assert(ptop < array_nr(parts));
+
+		if ((pivot + 1 - begin) >= (end - pivot)) {
+			parts[ptop].begin = begin;
+			parts[ptop].end = pivot;
+			begin = pivot + 1;
+		}
+		else {
+			parts[ptop].begin = pivot + 1;
+			parts[ptop].end = end;
+			end = pivot;
+		}
+
+		ptop++;
+	}
+}
+
+FARR_TMPL_FUNC void farr_tmpl_symbol(_intro_sort)(FARR_TMPL_TYPE *entries,
+                                                  size_t          entry_nr)
+{
+	karn_assert(entries);
+	karn_assert(entry_nr);
+
+	FARR_TMPL_TYPE *begin = entries;
+	FARR_TMPL_TYPE *end = &entries[entry_nr - 1];
+	unsigned int    thres = 2 * farr_tmpl_stack_depth(entry_nr);
+	unsigned int    ptop = 0;
+	struct {
+		FARR_TMPL_TYPE *begin;
+		FARR_TMPL_TYPE *end;
+		unsigned int    thres;
+	}               parts[farr_tmpl_stack_depth(entry_nr)];
+
+	while (true) {
+		FARR_TMPL_TYPE *pivot;
+
+		if (farr_tmpl_symbol(_small)(begin, end))
+			farr_tmpl_symbol(_base_sort)(begin, end);
+		else if (!thres)
+			farr_tmpl_symbol(_heap_sort)(begin, end + 1 - begin);
+		else {
+			pivot = farr_tmpl_symbol(_hoare_part)(begin, end);
+			karn_assert(ptop < array_nr(parts));
+
+			if ((pivot + 1 - begin) >= (end - pivot)) {
+				parts[ptop].begin = begin;
+				parts[ptop].end = pivot;
+				begin = pivot + 1;
+			}
+			else {
+				parts[ptop].begin = pivot + 1;
+				parts[ptop].end = end;
+				end = pivot;
+			}
+			parts[ptop].thres = --thres;
+
+			ptop++;
+
+			continue;
+		}
+
+		if (!ptop--)
+			return;
+
+		begin = parts[ptop].begin;
+		end = parts[ptop].end;
+		thres = parts[ptop].thres;
+	}
+}
+
+/*
+ * Pattern defeating quick sort helpers. Ranges are half-open, i.e. end points
+ * right after the last entry. Unlike farr_pdq_sort(), partitioning is
+ * performed using branchless block partitioning (see "BlockQuicksort: How
+ * Branch Mispredictions don't affect Quicksort" by Stefan Edelkamp and Armin
+ * Weiss) since comparisons are inlined here.
+ */
+
+static inline void farr_tmpl_symbol(_sort2)(FARR_TMPL_TYPE *first,
+                                            FARR_TMPL_TYPE *second)
+{
+	if (FARR_TMPL_COMPARE(second, first) < 0)
+		farr_tmpl_symbol(_swap)(first, second);
+}
+
+static inline void farr_tmpl_symbol(_sort3)(FARR_TMPL_TYPE *first,
+                                            FARR_TMPL_TYPE *second,
+                                            FARR_TMPL_TYPE *third)
+{
+	farr_tmpl_symbol(_sort2)(first, second);
+	farr_tmpl_symbol(_sort2)(second, third);
+	farr_tmpl_symbol(_sort2)(first, second);
+}
+
+static inline void farr_tmpl_symbol(_pdq_insert)(FARR_TMPL_TYPE *begin,
+                                                 FARR_TMPL_TYPE *end,
+                                                 bool            guarded)
+{
+	FARR_TMPL_TYPE *cur;
+
+	for (cur = begin + 1; cur < end; cur++) {
+		FARR_TMPL_TYPE  tmp;
+		FARR_TMPL_TYPE *sift = cur;
+
+		if (FARR_TMPL_COMPARE(cur, cur - 1) >= 0)
+			continue;
+
+		tmp = *cur;
+		do {
+			*sift = *(sift - 1);
+			sift--;
+		} while ((!guarded || (sift != begin)) &&
+		         (FARR_TMPL_COMPARE(&tmp, sift - 1) < 0));
+		*sift = tmp;
+	}
+}
+
+static inline bool farr_tmpl_symbol(_pdq_partial_insert)(FARR_TMPL_TYPE *begin,
+                                                         FARR_TMPL_TYPE *end)
+{
+	FARR_TMPL_TYPE *cur;
+	size_t          moved = 0;
+
+	if (begin == end)
+		return true;
+
+	for (cur = begin + 1; cur < end; cur++) {
+		FARR_TMPL_TYPE  tmp;
+		FARR_TMPL_TYPE *sift = cur;
+
+		if (FARR_TMPL_COMPARE(cur, cur - 1) >= 0)
+			continue;
+
+		tmp = *cur;
+		do {
+			*sift = *(sift - 1);
+			sift--;
+		} while ((sift != begin) &&
+		         (FARR_TMPL_COMPARE(&tmp, sift - 1) < 0));
+		*sift = tmp;
+
+		moved += (size_t)(cur - sift);
+		if (moved > FARR_TMPL_PDQ_PARTIAL_LIMIT)
+			return false;
+	}
+
+	return true;
+}
+
+static inline void
+farr_tmpl_symbol(_pdq_swap_offsets)(FARR_TMPL_TYPE      *left,
+                                    FARR_TMPL_TYPE      *right,
+                                    const unsigned char *left_offs,
+                                    const unsigned char *right_offs,
+                                    unsigned int         num,
+                                    bool                 use_swaps)
+{
+	FARR_TMPL_TYPE  tmp;
+	FARR_TMPL_TYPE *l;
+	FARR_TMPL_TYPE *r;
+	unsigned int    o;
+
+	if (use_swaps) {
+		for (o = 0; o < num; o++)
+			farr_tmpl_symbol(_swap)(left + left_offs[o],
+			                        right - right_offs[o]);
+		return;
+	}
+
+	if (!num)
+		return;
+
+	/* Cyclic permutation saves a copy per pair of misplaced entries. */
+	l = left + left_offs[0];
+	r = right - right_offs[0];
+	tmp = *l;
+	*l = *r;
+	for (o = 1; o < num; o++) {
+		l = left + left_offs[o];
+		*r = *l;
+		r = right - right_offs[o];
+		*l = *r;
+	}
+	*r = tmp;
+}
+
+static inline FARR_TMPL_TYPE *
+farr_tmpl_symbol(_pdq_block_part)(FARR_TMPL_TYPE *begin,
+                                  FARR_TMPL_TYPE *end,
+                                  bool           *partitioned)
+{
+	FARR_TMPL_TYPE  pivot = *begin;
+	FARR_TMPL_TYPE *first = begin;
+	FARR_TMPL_TYPE *last = end;
+	FARR_TMPL_TYPE *left;
+	FARR_TMPL_TYPE *right;
+	unsigned char   left_offs[FARR_TMPL_PDQ_BLOCK_SIZE] __align(64);
+	unsigned char   right_offs[FARR_TMPL_PDQ_BLOCK_SIZE] __align(64);
+	unsigned int    left_nr = 0, right_nr = 0;
+	unsigned int    left_start = 0, right_start = 0;
+
+	/* Median of 3 guarantees an entry >= pivot exists. */
+	do {
+		first++;
+	} while (FARR_TMPL_COMPARE(first, &pivot) < 0);
+
+	/* Guard search if no entry lower than pivot was found before first. */
+	if ((first - 1) == begin) {
+		while (first < last) {
+			last--;
+			if (FARR_TMPL_COMPARE(last, &pivot) < 0)
+				break;
+		}
+	}
+	else {
+		do {
+			last--;
+		} while (FARR_TMPL_COMPARE(last, &pivot) >= 0);
+	}
+
+	*partitioned = (first >= last);
+	if (*partitioned)
+		goto pivot;
+
+	farr_tmpl_symbol(_swap)(first, last);
+	first++;
+
+	left = first;
+	right = last;
+	while (first < last) {
+		size_t       unknown = (size_t)(last - first);
+		size_t       left_split;
+		size_t       right_split;
+		unsigned int o;
+		unsigned int num;
+
+		left_split = !left_nr ? (!right_nr ? unknown / 2 : unknown) : 0;
+		right_split = !right_nr ? unknown - left_split : 0;
+
+		/* Collect offsets of misplaced entries without branching. */
+		left_split = umin(left_split, FARR_TMPL_PDQ_BLOCK_SIZE);
+		for (o = 0; o < left_split; o++) {
+			left_offs[left_nr] = (unsigned char)o;
+			left_nr += (FARR_TMPL_COMPARE(first, &pivot) >= 0);
+			first++;
+		}
+
+		right_split = umin(right_split, FARR_TMPL_PDQ_BLOCK_SIZE);
+		for (o = 1; o <= right_split; o++) {
+			last--;
+			right_offs[right_nr] = (unsigned char)o;
+			right_nr += (FARR_TMPL_COMPARE(last, &pivot) < 0);
+		}
+
+		num = umin(left_nr, right_nr);
+		farr_tmpl_symbol(_pdq_swap_offsets)(left,
+		                                    right,
+		                                    &left_offs[left_start],
+		                                    &right_offs[right_start],
+		                                    num,
+		                                    left_nr == right_nr);
+		left_nr -= num;
+		right_nr -= num;
+		left_start += num;
+		right_start += num;
+
+		if (!left_nr) {
+			left_start = 0;
+			left = first;
+		}
+
+		if (!right_nr) {
+			right_start = 0;
+			right = last;
+		}
+	}
+
+	/* Move remaining misplaced entries next to the partitioning point. */
+	if (left_nr) {
+		while (left_nr--) {
+			unsigned int o = left_offs[left_start + left_nr];
+
+			farr_tmpl_symbol(_swap)(left + o, --last);
+		}
+		first = last;
+	}
+
+	if (right_nr) {
+		while (right_nr--) {
+			unsigned int o = right_offs[right_start + right_nr];
+
+			farr_tmpl_symbol(_swap)(right - o, first++);
+		}
+	}
+
+pivot:
+	first--;
+	*begin = *first;
+	*first = pivot;
+
+	return first;
+}
+
+static inline FARR_TMPL_TYPE *
+farr_tmpl_symbol(_pdq_equal_part)(FARR_TMPL_TYPE *begin, FARR_TMPL_TYPE *end)
+{
+	FARR_TMPL_TYPE  pivot = *begin;
+	FARR_TMPL_TYPE *first = begin;
+	FARR_TMPL_TYPE *last = end;
+
+	do {
+		last--;
+	} while (FARR_TMPL_COMPARE(&pivot, last) < 0);
+
+	if ((last + 1) == end) {
+		while (first < last) {
+			first++;
+			if (FARR_TMPL_COMPARE(&pivot, first) < 0)
+				break;
+		}
+	}
+	else {
+		do {
+			first++;
+		} while (FARR_TMPL_COMPARE(&pivot, first) >= 0);
+	}
+
+	while (first < last) {
+		farr_tmpl_symbol(_swap)(first, last);
+
+		do {
+			last--;
+		} while (FARR_TMPL_COMPARE(&pivot, last) < 0);
+
+		do {
+			first++;
+		} while (FARR_TMPL_COMPARE(&pivot, first) >= 0);
+	}
+
+	*begin = *last;
+	*last = pivot;
+
+	return last;
+}
+
+static inline void farr_tmpl_symbol(_pdq_shuffle)(FARR_TMPL_TYPE *begin,
+                                                  FARR_TMPL_TYPE *end)
+{
+	size_t nr = (size_t)(end - begin);
+	size_t quarter = nr / 4;
+
+	if (nr < FARR_TMPL_PDQ_INSERT_THRESHOLD)
+		return;
+
+	farr_tmpl_symbol(_swap)(begin, begin + quarter);
+	farr_tmpl_symbol(_swap)(end - 1, end - quarter);
+
+	if (nr > FARR_TMPL_PDQ_NINTHER_THRESHOLD) {
+		farr_tmpl_symbol(_swap)(begin + 1, begin + quarter + 1);
+		farr_tmpl_symbol(_swap)(begin + 2, begin + quarter + 2);
+		farr_tmpl_symbol(_swap)(end - 2, end - quarter - 1);
+		farr_tmpl_symbol(_swap)(end - 3, end - quarter - 2);
+	}
+}
+
+static inline void farr_tmpl_symbol(_pdq_select_pivot)(FARR_TMPL_TYPE *begin,
+                                                       FARR_TMPL_TYPE *end)
+{
+	size_t          nr = (size_t)(end - begin);
+	FARR_TMPL_TYPE *mid = begin + (nr / 2);
+
+	if (nr > FARR_TMPL_PDQ_NINTHER_THRESHOLD) {
+		farr_tmpl_symbol(_sort3)(begin, mid, end - 1);
+		farr_tmpl_symbol(_sort3)(begin + 1, mid - 1, end - 2);
+		farr_tmpl_symbol(_sort3)(begin + 2, mid + 1, end - 3);
+		farr_tmpl_symbol(_sort3)(mid - 1, mid, mid + 1);
+		farr_tmpl_symbol(_swap)(begin, mid);
+	}
+	else
+		farr_tmpl_symbol(_sort3)(mid, begin, end - 1);
+}
+
+static inline bool farr_tmpl_symbol(_pdq_presorted)(FARR_TMPL_TYPE *begin,
+                                                    FARR_TMPL_TYPE *end)
+{
+	FARR_TMPL_TYPE *cur = begin + 1;
+
+	if (FARR_TMPL_COMPARE(cur, begin) >= 0) {
+		while (++cur < end)
+			if (FARR_TMPL_COMPARE(cur, cur - 1) < 0)
+				return false;
+
+		return true;
+	}
+
+	while (++cur < end)
+		if (FARR_TMPL_COMPARE(cur, cur - 1) >= 0)
+			return false;
+
+	for (end--; begin < end; begin++, end--)
+		farr_tmpl_symbol(_swap)(begin, end);
+
+	return true;
+}
+
+FARR_TMPL_FUNC void farr_tmpl_symbol(_pdq_sort)(FARR_TMPL_TYPE *entries,
+                                                size_t          entry_nr)
+{
+	karn_assert(entries);
+	karn_assert(entry_nr);
+
+	FARR_TMPL_TYPE *begin = entries;
+	FARR_TMPL_TYPE *end = &entries[entry_nr];
+	unsigned int    bad = farr_log2_lower(entry_nr);
+	bool            leftmost = true;
+	unsigned int    ptop = 0;
+	struct {
+		FARR_TMPL_TYPE *begin;
+		FARR_TMPL_TYPE *end;
+		unsigned int    bad;
+		bool            leftmost;
+	}               parts[farr_log2_upper((entry_nr > 2) ? entry_nr : 2) +
+	                      1];
+
+	if ((entry_nr >= FARR_TMPL_PDQ_INSERT_THRESHOLD) &&
+	    farr_tmpl_symbol(_pdq_presorted)(begin, end))
+		return;
+
+	while (true) {
+		size_t          nr = (size_t)(end - begin);
+		FARR_TMPL_TYPE *pivot;
+		size_t          left_nr;
+		size_t          right_nr;
+		bool            partitioned;
+
+#if defined(FARR_TMPL_BASE_SORT)
+		if (nr <= FARR_TMPL_BASE_THRESHOLD) {
+			FARR_TMPL_BASE_SORT(begin, (unsigned int)nr);
+			goto pop;
+		}
+#else
+		if (nr < FARR_TMPL_PDQ_INSERT_THRESHOLD) {
+			if (nr > 1)
+				farr_tmpl_symbol(_pdq_insert)(begin, end,
+				                              leftmost);
+			goto pop;
+		}
+#endif
+
+		farr_tmpl_symbol(_pdq_select_pivot)(begin, end);
+
+		if (!leftmost && (FARR_TMPL_COMPARE(begin - 1, begin) >= 0)) {
+			begin = farr_tmpl_symbol(_pdq_equal_part)(begin, end);
+			begin++;
+			continue;
+		}
+
+		pivot = farr_tmpl_symbol(_pdq_block_part)(begin, end,
+		                                          &partitioned);
+		left_nr = (size_t)(pivot - begin);
+		right_nr = (size_t)(end - (pivot + 1));
+
+		if ((left_nr < (nr / 8)) || (right_nr < (nr / 8))) {
+			if (!--bad) {
+				farr_tmpl_symbol(_heap_sort)(begin, nr);
+				goto pop;
+			}
+
+			farr_tmpl_symbol(_pdq_shuffle)(begin, pivot);
+			farr_tmpl_symbol(_pdq_shuffle)(pivot + 1, end);
+		}
+		else if (partitioned &&
+		         farr_tmpl_symbol(_pdq_partial_insert)(begin, pivot) &&
+		         farr_tmpl_symbol(_pdq_partial_insert)(pivot + 1, end))
+			goto pop;
+
+		karn_assert(ptop < array_nr(parts));
+		if (left_nr >= right_nr) {
+			parts[ptop].begin = begin;
+			parts[ptop].end = pivot;
+			parts[ptop].leftmost = leftmost;
+			begin = pivot + 1;
+			leftmost = false;
+		}
+		else {
+			parts[ptop].begin = pivot + 1;
+			parts[ptop].end = end;
+			parts[ptop].leftmost = false;
+			end = pivot;
+		}
+		parts[ptop].bad = bad;
+
+		ptop++;
+
+		continue;
+
+pop:
+		if (!ptop--)
+			return;
+
+		begin = parts[ptop].begin;
+		end = parts[ptop].end;
+		bad = parts[ptop].bad;
+		leftmost = parts[ptop].leftmost;
+	}
+}
+
+#undef FARR_TMPL_BASE_THRESHOLD
+#undef FARR_TMPL_BASE_SORT
+#undef FARR_TMPL_FUNC
+#undef FARR_TMPL_COMPARE
+#undef FARR_TMPL_TYPE
+#undef FARR_TMPL_NAME
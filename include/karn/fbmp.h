@@ -13,74 +13,74 @@
 #include <string.h>
 #include <errno.h>
 
-static inline unsigned int
-fbmp_word_nr(unsigned int nr)
+static inline size_t
+fbmp_word_nr(size_t nr)
 {
 	return (nr + sizeof(uintptr_t) - 1) / sizeof(uintptr_t);
 }
 
 static inline size_t
-fbmp_size(unsigned int nr)
+fbmp_size(size_t nr)
 {
 	return fbmp_word_nr(nr) * CHAR_BIT;
 }
 
 static inline bool
-fbmp_test(const uintptr_t *bitmap, unsigned int index)
+fbmp_test(const uintptr_t *bitmap, size_t index)
 {
-	unsigned int word = index / sizeof(*bitmap);
+	size_t       word = index / sizeof(*bitmap);
 	unsigned int bit = index % sizeof(*bitmap);
 
 	return !!(bitmap[word] & (__UINTPTR_C(1) << bit));
 }
 
 static inline void
-fbmp_set(uintptr_t *bitmap, unsigned int index)
+fbmp_set(uintptr_t *bitmap, size_t index)
 {
-	unsigned int word = index / sizeof(*bitmap);
+	size_t       word = index / sizeof(*bitmap);
 	unsigned int bit = index % sizeof(*bitmap);
 
 	bitmap[word] |= __UINTPTR_C(1) << bit;
 }
 
 static inline void
-fbmp_set_all(uintptr_t *bitmap, unsigned int nr)
+fbmp_set_all(uintptr_t *bitmap, size_t nr)
 {
 	memset(bitmap, 0xff, fbmp_size(nr));
 }
 
 static inline void
-fbmp_clear(uintptr_t *bitmap, unsigned int index)
+fbmp_clear(uintptr_t *bitmap, size_t index)
 {
-	unsigned int word = index / sizeof(*bitmap);
+	size_t       word = index / sizeof(*bitmap);
 	unsigned int bit = index % sizeof(*bitmap);
 
 	bitmap[word] &= ~(__UINTPTR_C(1) << bit);
 }
 
 static inline void
-fbmp_clear_all(uintptr_t *bitmap, unsigned int nr)
+fbmp_clear_all(uintptr_t *bitmap, size_t nr)
 {
 	memset(bitmap, 0, fbmp_size(nr));
 }
 
 static inline void
-fbmp_toggle(uintptr_t *bitmap, unsigned int index)
+fbmp_toggle(uintptr_t *bitmap, size_t index)
 {
-	unsigned int word = index / sizeof(*bitmap);
+	size_t       word = index / sizeof(*bitmap);
 	unsigned int bit = index % sizeof(*bitmap);
 
 	bitmap[word] ^= __UINTPTR_C(1) << bit;
 }
 
 static inline void
-fbmp_init(uintptr_t *bitmap, unsigned int nr)
+fbmp_init(uintptr_t *bitmap, size_t nr)
 {
 	fbmp_clear_all(bitmap, nr);
 }
 
 static inline uintptr_t *
-fbmp_create(unsigned int nr)
+fbmp_create(size_t nr)
 {
 	return calloc(fbmp_word_nr(nr), sizeof(uintptr_t));
 }
@@ -91,6 +91,6 @@ fbmp_destroy(uintptr_t *bitmap)
 	free(bitmap);
 }
 
-extern unsigned int fbmp_find_zero(const uintptr_t *bitmap, unsigned int nr);
+extern size_t fbmp_find_zero(const uintptr_t *bitmap, size_t nr);
 
 #endif /* _KARN_FBMP_H */
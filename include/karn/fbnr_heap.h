@@ -59,7 +59,7 @@ struct fbnr_heap {
  *
  * @ingroup fbnr_heap
  */
-static inline unsigned int fbnr_heap_nr(const struct fbnr_heap *heap)
+static inline size_t fbnr_heap_nr(const struct fbnr_heap *heap)
 {
 	fbnr_heap_assert(heap);
 
@@ -75,7 +75,7 @@ static inline unsigned int fbnr_heap_nr(const struct fbnr_heap *heap)
  *
  * @ingroup fbnr_heap
  */
-static inline unsigned int fbnr_heap_count(const struct fbnr_heap *heap)
+static inline size_t fbnr_heap_count(const struct fbnr_heap *heap)
 {
 	fbnr_heap_assert(heap);
 
@@ -173,6 +173,63 @@ extern void fbnr_heap_insert(struct fbnr_heap *heap, const char *node);
  */
 extern void fbnr_heap_extract(struct fbnr_heap *heap, char *node);
 
+/**
+ * Replace first node of a fixed length array based binary heap
+ *
+ * @param heap heap to replace first node of
+ * @param node data to replace first node with
+ *
+ * @p node is inserted by copy in place of first node which is discarded.
+ * This costs a single sift-down pass whereas a fbnr_heap_extract() /
+ * fbnr_heap_insert() sequence would sift twice.
+ *
+ * @warning Behavior is undefined if @p heap is empty or if @p node points to
+ * a node hosted by @p heap.
+ *
+ * @ingroup fbnr_heap
+ */
+extern void fbnr_heap_replace(struct fbnr_heap *heap, const char *node);
+
+/**
+ * Insert a batch of data into specified fbnr_heap
+ *
+ * @param heap  heap to insert into
+ * @param nodes array of data to insert
+ * @param nr    number of data nodes to insert
+ *
+ * @p nodes are inserted by copy. When the batch is at least as large as
+ * current @p heap content, nodes are appended then the whole heap is rebuilt
+ * in O(n) time complexity according to Floyd algorithm. Otherwise, they are
+ * sifted up one by one as fbnr_heap_insert() does.
+ *
+ * @warning Behavior is undefined if @p heap cannot host @p nr more nodes.
+ *
+ * @ingroup fbnr_heap
+ */
+extern void fbnr_heap_insert_batch(struct fbnr_heap *heap,
+                                   const char       *nodes,
+                                   size_t            nr);
+
+/**
+ * Extract a batch of first nodes from specified fbnr_heap
+ *
+ * @param heap  heap to extract from
+ * @param nodes array to extract data into
+ * @param nr    maximum number of data nodes to extract
+ *
+ * Extract up to @p nr first nodes in order and store them by copy into
+ * consecutive @p nodes slots.
+ * Extraction runs @p nr steps of heapsort in a single pass, parking first nodes
+ * into released tail slots, which are copied out at once.
+ *
+ * @return number of extracted nodes
+ *
+ * @ingroup fbnr_heap
+ */
+extern size_t fbnr_heap_extract_batch(struct fbnr_heap *heap,
+                                      char             *nodes,
+                                      size_t            nr);
+
 /**
  * Clear content of specified fbnr_heap
  *
@@ -202,7 +259,7 @@ static inline void fbnr_heap_clear(struct fbnr_heap *heap)
  *
  * @ingroup fbnr_heap
  */
-extern void fbnr_heap_build(struct fbnr_heap *heap, unsigned int count);
+extern void fbnr_heap_build(struct fbnr_heap *heap, size_t count);
 
 /**
  * Initialize a fbnr_heap
@@ -226,7 +283,7 @@ extern void fbnr_heap_build(struct fbnr_heap *heap, unsigned int count);
 extern void fbnr_heap_init(struct fbnr_heap *heap,
                            char             *nodes,
                            size_t            node_size,
-                           unsigned int      node_nr,
+                           size_t            node_nr,
                            farr_compare_fn  *compare,
                            farr_copy_fn     *copy);
 
@@ -258,7 +315,7 @@ extern void fbnr_heap_fini(struct fbnr_heap *heap __unused);
  * @ingroup fbnr_heap
  */
 extern struct fbnr_heap * fbnr_heap_create(size_t           node_size,
-                                           unsigned int     node_nr,
+                                           size_t           node_nr,
                                            farr_compare_fn *compare,
                                            farr_copy_fn    *copy);
 
@@ -272,6 +329,93 @@ extern struct fbnr_heap * fbnr_heap_create(size_t           node_size,
  */
 extern void fbnr_heap_destroy(struct fbnr_heap *heap);
 
+#if defined(CONFIG_KARN_FBNR_HEAP_GROW)
+
+/**
+ * Initialize a growable fbnr_heap
+ *
+ * @param heap      heap to initialize
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   initial number of nodes @p heap may contain
+ * @param compare   comparison function used to locate the right array slot to
+ *                  insert data into
+ * @param copy      copy function used to swap nodes / array slots.
+ *
+ * Allocate storage for @p node_nr nodes which may later be resized using
+ * fbnr_heap_reserve(), fbnr_heap_insert_grow() and
+ * fbnr_heap_extract_shrink(). Large storage is memory mapped so that resizing
+ * does not copy nodes. Fixed capacity operations remain available.
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @ingroup fbnr_heap
+ */
+extern int fbnr_heap_init_grow(struct fbnr_heap *heap,
+                               size_t            node_size,
+                               size_t            node_nr,
+                               farr_compare_fn  *compare,
+                               farr_copy_fn     *copy);
+
+/**
+ * Release resources allocated by fbnr_heap_init_grow()
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fbnr_heap
+ */
+extern void fbnr_heap_fini_grow(struct fbnr_heap *heap);
+
+/**
+ * Ensure a growable fbnr_heap may host a given number of nodes
+ *
+ * @param heap heap to grow
+ * @param nr   minimum number of nodes @p heap should be able to contain
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @ingroup fbnr_heap
+ */
+extern int fbnr_heap_reserve(struct fbnr_heap *heap, size_t nr);
+
+/**
+ * Insert data into a growable fbnr_heap
+ *
+ * @param heap heap to insert into
+ * @param node data to insert
+ *
+ * Double @p heap capacity when full before inserting @p node by copy, giving
+ * an amortized constant growing cost.
+ *
+ * @return 0 on success, -ENOMEM when out of memory in which case @p heap is
+ *         left untouched
+ *
+ * @ingroup fbnr_heap
+ */
+extern int fbnr_heap_insert_grow(struct fbnr_heap *heap, const char *node);
+
+/**
+ * Extract data from a growable fbnr_heap and release unused storage
+ *
+ * @param heap   heap to extract from
+ * @param node   data location to extract into
+ * @param min_nr capacity below which @p heap should never shrink
+ *
+ * Same as fbnr_heap_extract() but halve @p heap capacity once occupancy drops
+ * to a quarter of it, unless it would fall below @p min_nr.
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fbnr_heap
+ */
+extern void fbnr_heap_extract_shrink(struct fbnr_heap *heap,
+                                     char             *node,
+                                     size_t            min_nr);
+
+#endif /* defined(CONFIG_KARN_FBNR_HEAP_GROW) */
+
 #if defined(CONFIG_KARN_FBNR_HEAP_SORT)
 
 /**
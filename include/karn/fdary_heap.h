@@ -0,0 +1,381 @@
+/**
+ * @file      fdary_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based d-ary heap interface
+ *
+ * @defgroup fdary_heap Fixed length array based d-ary heap
+ *
+ * Implicit heap where each node has up to d children, d being a power of 2
+ * (typically 4 or 8) given at initialization time. Children of node i are
+ * stored contiguously at indices d*i + 1 to d*i + d so that a sift down step
+ * scans a single group of siblings. With small nodes, a whole group fits into
+ * a single cache line which halves (d = 4) or thirds (d = 8) tree depth
+ * compared to a binary heap at the cost of more comparisons per level.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_FDARY_HEAP_H
+#define _KARN_FDARY_HEAP_H
+
+#include <karn/fabs_tree.h>
+
+/**
+ * Cache line size fdary_heap_create() aligns groups of siblings onto.
+ *
+ * @ingroup fdary_heap
+ */
+#define FDARY_HEAP_LINE_SIZE (64U)
+
+/**
+ * Maximum arity of a fdary_heap.
+ *
+ * @ingroup fdary_heap
+ */
+#define FDARY_HEAP_ARITY_MAX (64U)
+
+/**
+ * Fixed length array based d-ary heap
+ *
+ * @ingroup fdary_heap
+ */
+struct fdary_heap {
+	/** Node comparator */
+	farr_compare_fn  *fdary_compare;
+	/** Node copier */
+	farr_copy_fn     *fdary_copy;
+	/** Base 2 logarithm of arity, i.e. of maximum number of children */
+	unsigned int      fdary_shift;
+	/** Underlying array of nodes and count of hosted nodes */
+	struct fabs_tree  fdary_tree;
+};
+
+#define fdary_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert((_heap)->fdary_compare); \
+	karn_assert((_heap)->fdary_copy); \
+	karn_assert((_heap)->fdary_shift); \
+	karn_assert((1U << (_heap)->fdary_shift) <= FDARY_HEAP_ARITY_MAX)
+
+/**
+ * Return capacity of a fdary_heap in number of nodes
+ *
+ * @param heap fdary_heap to get capacity from
+ *
+ * @return maximum number of nodes
+ *
+ * @ingroup fdary_heap
+ */
+static inline size_t fdary_heap_nr(const struct fdary_heap *heap)
+{
+	fdary_heap_assert(heap);
+
+	return fabs_tree_nr(&heap->fdary_tree);
+}
+
+/**
+ * Return count of nodes hosted by a fdary_heap
+ *
+ * @param heap fdary_heap to get count from
+ *
+ * @return count
+ *
+ * @ingroup fdary_heap
+ */
+static inline size_t fdary_heap_count(const struct fdary_heap *heap)
+{
+	fdary_heap_assert(heap);
+
+	return fabs_tree_count(&heap->fdary_tree);
+}
+
+/**
+ * Return arity of a fdary_heap
+ *
+ * @param heap fdary_heap to get arity from
+ *
+ * @return maximum number of children per node
+ *
+ * @ingroup fdary_heap
+ */
+static inline unsigned int fdary_heap_arity(const struct fdary_heap *heap)
+{
+	fdary_heap_assert(heap);
+
+	return 1U << heap->fdary_shift;
+}
+
+/**
+ * Indicate wether a fixed length array based d-ary heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup fdary_heap
+ */
+static inline bool fdary_heap_empty(const struct fdary_heap *heap)
+{
+	fdary_heap_assert(heap);
+
+	return fabs_tree_empty(&heap->fdary_tree);
+}
+
+/**
+ * Indicate wether a fixed length array based d-ary heap is full or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  full
+ * @retval false not full
+ *
+ * @ingroup fdary_heap
+ */
+static inline bool fdary_heap_full(const struct fdary_heap *heap)
+{
+	fdary_heap_assert(heap);
+
+	return fabs_tree_full(&heap->fdary_tree);
+}
+
+/**
+ * Retrieve first node satisfying the heap property
+ *
+ * @param heap heap to retrieve node from
+ *
+ * Depending on user's compare implementation given at init time,
+ * fdary_heap_peek() will return smallest node for a min-heap, greatest one for
+ * a max-heap.
+ *
+ * @return pointer to first node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fdary_heap
+ */
+static inline char * fdary_heap_peek(const struct fdary_heap *heap)
+{
+	karn_assert(!fdary_heap_empty(heap));
+
+	return fabs_tree_root(&heap->fdary_tree);
+}
+
+/**
+ * Insert data into a fixed length array based d-ary heap
+ *
+ * @param heap heap to insert into
+ * @param node data to insert
+ *
+ * @p node is inserted by copy.
+ *
+ * @warning Behavior is undefined if @p heap is full.
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_insert(struct fdary_heap *heap, const char *node);
+
+/**
+ * Extract first node from a fixed length array based d-ary heap
+ *
+ * @param heap heap to extract from
+ * @param node data location to extract into
+ *
+ * First node, i.e. the one fdary_heap_peek() would return, is extracted by copy
+ * into @p node.
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_extract(struct fdary_heap *heap, char *node);
+
+/**
+ * Insert a batch of data into specified fdary_heap
+ *
+ * @param heap  heap to insert into
+ * @param nodes array of data to insert
+ * @param nr    number of data nodes to insert
+ *
+ * @p nodes are inserted by copy. When the batch is at least as large as
+ * current @p heap content, nodes are appended then the whole heap is rebuilt
+ * in O(n) time complexity. Otherwise, they are sifted up one by one.
+ *
+ * @warning Behavior is undefined if @p heap cannot host @p nr more nodes.
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_insert_batch(struct fdary_heap *heap,
+                                    const char        *nodes,
+                                    size_t             nr);
+
+/**
+ * Extract a batch of first nodes from specified fdary_heap
+ *
+ * @param heap  heap to extract from
+ * @param nodes array to extract data into
+ * @param nr    maximum number of data nodes to extract
+ *
+ * Extract up to @p nr first nodes in order and store them by copy into
+ * consecutive @p nodes slots.
+ * Extraction runs @p nr steps of heapsort in a single pass, parking first nodes
+ * into released tail slots, which are copied out at once.
+ *
+ * @return number of extracted nodes
+ *
+ * @ingroup fdary_heap
+ */
+extern size_t fdary_heap_extract_batch(struct fdary_heap *heap,
+                                       char              *nodes,
+                                       size_t             nr);
+
+/**
+ * Clear content of specified fdary_heap
+ *
+ * @param heap heap to clear
+ *
+ * Reset heap to empty state.
+ *
+ * @ingroup fdary_heap
+ */
+static inline void fdary_heap_clear(struct fdary_heap *heap)
+{
+	fdary_heap_assert(heap);
+
+	fabs_tree_clear(&heap->fdary_tree);
+}
+
+/**
+ * Build / heapify a fdary_heap initialized with unsorted data
+ *
+ * @param heap  heap to heapify
+ * @param count count of nodes to heapify
+ *
+ * Build @p heap from the array passed as argument to fdary_heap_init()
+ * according to Floyd algorithm in O(n) time complexity.
+ *
+ * @warning Behavior is undefined if @p count is zero.
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_build(struct fdary_heap *heap, size_t count);
+
+/**
+ * Initialize a fdary_heap
+ *
+ * @param heap      heap to initialize
+ * @param nodes     underlying memory area containing nodes
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param arity     maximum number of children per node
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * @p nodes must point to a memory area large enough to contain at least
+ * @p node_nr nodes. For groups of siblings to be cache line aligned, second
+ * node, i.e. &nodes[node_size], should sit onto a cache line boundary.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr, a zero
+ * @p node_size or an @p arity which is not a power of 2 in the
+ * [2:FDARY_HEAP_ARITY_MAX] range.
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_init(struct fdary_heap *heap,
+                            char              *nodes,
+                            size_t             node_size,
+                            size_t             node_nr,
+                            unsigned int       arity,
+                            farr_compare_fn   *compare,
+                            farr_copy_fn      *copy);
+
+/**
+ * Release resources allocated for a fdary_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_fini(struct fdary_heap *heap __unused);
+
+/**
+ * Create a fdary_heap
+ *
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param arity     maximum number of children per node
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * Wrapper allocating and initializing a fdary_heap which nodes are laid out so
+ * that groups of siblings start onto a FDARY_HEAP_LINE_SIZE boundary.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr, a zero
+ * @p node_size or an @p arity which is not a power of 2 in the
+ * [2:FDARY_HEAP_ARITY_MAX] range.
+ *
+ * @return pointer to new created d-ary heap, NULL when out of memory
+ *
+ * @ingroup fdary_heap
+ */
+extern struct fdary_heap * fdary_heap_create(size_t           node_size,
+                                             size_t           node_nr,
+                                             unsigned int     arity,
+                                             farr_compare_fn *compare,
+                                             farr_copy_fn    *copy);
+
+/**
+ * Release resources allocated by fdary_heap_create() for fixed length array
+ * based d-ary heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_destroy(struct fdary_heap *heap);
+
+#if defined(CONFIG_KARN_FDARY_HEAP_SORT)
+
+/**
+ * Sort array passed as argument according to d-ary heap sort scheme.
+ *
+ * @param entries    array of entries to sort
+ * @param entry_size size in bytes of a single array entry
+ * @param entry_nr   number of array entries
+ * @param arity      maximum number of children per heap node
+ * @param compare    comparison function used to order entries
+ * @param copy       copy function used to move entries
+ *
+ * @warning Behavior is undefined when called with an @p arity which is not a
+ * power of 2 in the [2:FDARY_HEAP_ARITY_MAX] range.
+ *
+ * @ingroup fdary_heap
+ */
+extern void fdary_heap_sort(char            *entries,
+                            size_t           entry_size,
+                            size_t           entry_nr,
+                            unsigned int     arity,
+                            farr_compare_fn *compare,
+                            farr_copy_fn    *copy);
+
+#endif /* defined(CONFIG_KARN_FDARY_HEAP_SORT) */
+
+#endif /* _KARN_FDARY_HEAP_H */
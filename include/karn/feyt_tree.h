@@ -0,0 +1,317 @@
+/**
+ * @file      feyt_tree.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based Eytzinger search tree interface
+ *
+ * @defgroup feyt_tree Fixed length array based Eytzinger search tree
+ *
+ * Static sorted set / map laying nodes out in breadth first (Eytzinger) order
+ * on top of a fabs_tree. Lookups descend the implicit tree with branchless
+ * index arithmetic while prefetching descendants located a few levels below
+ * so that memory latency is mostly hidden.
+ *
+ * Content is built once from a sorted array and is read-only afterwards.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_FEYT_TREE_H
+#define _KARN_FEYT_TREE_H
+
+#include <karn/fabs_tree.h>
+
+/**
+ * Size in bytes of a cache line, used to compute prefetching distance and
+ * nodes memory area alignment.
+ *
+ * @ingroup feyt_tree
+ */
+#define FEYT_TREE_LINE_SIZE (64U)
+
+/**
+ * Maximum number of lookups interleaved by batched searches.
+ *
+ * @ingroup feyt_tree
+ */
+#define FEYT_TREE_BATCH_NR  (16U)
+
+/**
+ * Fixed length array based Eytzinger search tree
+ *
+ * @ingroup feyt_tree
+ */
+struct feyt_tree {
+	/** Node comparator */
+	farr_compare_fn  *feyt_compare;
+	/** Node copier */
+	farr_copy_fn     *feyt_copy;
+	/** Number of levels to prefetch descendants ahead of */
+	unsigned int      feyt_pref;
+	/** underlying implicit binary tree */
+	struct fabs_tree  feyt_tree;
+};
+
+#define feyt_tree_assert(_tree) \
+	karn_assert(_tree); \
+	karn_assert((_tree)->feyt_compare); \
+	karn_assert((_tree)->feyt_copy); \
+	karn_assert((_tree)->feyt_pref)
+
+/**
+ * Return capacity of a feyt_tree in number of nodes
+ *
+ * @param tree feyt_tree to get capacity from
+ *
+ * @return maximum number of nodes
+ *
+ * @ingroup feyt_tree
+ */
+static inline size_t feyt_tree_nr(const struct feyt_tree *tree)
+{
+	feyt_tree_assert(tree);
+
+	return fabs_tree_nr(&tree->feyt_tree);
+}
+
+/**
+ * Return count of nodes hosted by a feyt_tree
+ *
+ * @param tree feyt_tree to get count from
+ *
+ * @return count
+ *
+ * @ingroup feyt_tree
+ */
+static inline size_t feyt_tree_count(const struct feyt_tree *tree)
+{
+	feyt_tree_assert(tree);
+
+	return fabs_tree_count(&tree->feyt_tree);
+}
+
+/**
+ * Indicate wether a feyt_tree is empty or not
+ *
+ * @param tree feyt_tree to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup feyt_tree
+ */
+static inline bool feyt_tree_empty(const struct feyt_tree *tree)
+{
+	feyt_tree_assert(tree);
+
+	return fabs_tree_empty(&tree->feyt_tree);
+}
+
+/**
+ * Remove all nodes from specified feyt_tree
+ *
+ * @param tree feyt_tree to clear
+ *
+ * @ingroup feyt_tree
+ */
+static inline void feyt_tree_clear(struct feyt_tree *tree)
+{
+	feyt_tree_assert(tree);
+
+	fabs_tree_clear(&tree->feyt_tree);
+}
+
+/**
+ * Load a feyt_tree with sorted entries
+ *
+ * @param tree     feyt_tree to load
+ * @param entries  array of entries sorted in ascending order according to the
+ *                 comparison function passed to feyt_tree_init()
+ * @param entry_nr number of @p entries
+ *
+ * Previous content of @p tree is discarded. Entries are laid out in Eytzinger
+ * order within a single in-order pass over the tree, i.e. in O(n) time while
+ * reading @p entries sequentially. Arrays sorted using one of the farr sorting
+ * routines may be passed as is.
+ *
+ * @warning Behavior is undefined if @p entries is not sorted, if @p entries
+ * overlaps nodes memory area or if @p entry_nr is greater than @p tree
+ * capacity.
+ *
+ * @ingroup feyt_tree
+ */
+extern void feyt_tree_build(struct feyt_tree *tree,
+                            const char       *entries,
+                            size_t            entry_nr);
+
+/**
+ * Find first node not ordered before a key
+ *
+ * @param tree feyt_tree to search
+ * @param key  key to search for
+ *
+ * @p key is given as second argument to the comparison function passed to
+ * feyt_tree_init().
+ *
+ * @return pointer to first node greater than or equal to @p key, NULL if none
+ *
+ * @ingroup feyt_tree
+ */
+extern char * feyt_tree_lower_bound(const struct feyt_tree *tree,
+                                    const char             *key);
+
+/**
+ * Find first node ordered after a key
+ *
+ * @param tree feyt_tree to search
+ * @param key  key to search for
+ *
+ * @p key is given as second argument to the comparison function passed to
+ * feyt_tree_init().
+ *
+ * @return pointer to first node strictly greater than @p key, NULL if none
+ *
+ * @ingroup feyt_tree
+ */
+extern char * feyt_tree_upper_bound(const struct feyt_tree *tree,
+                                    const char             *key);
+
+/**
+ * Find node matching a key
+ *
+ * @param tree feyt_tree to search
+ * @param key  key to search for
+ *
+ * When multiple nodes match @p key, the first one in sorted order is returned.
+ *
+ * @return pointer to matching node, NULL if none
+ *
+ * @ingroup feyt_tree
+ */
+extern char * feyt_tree_find(const struct feyt_tree *tree, const char *key);
+
+/**
+ * Run multiple feyt_tree_lower_bound() lookups at once
+ *
+ * @param tree     feyt_tree to search
+ * @param keys     array of keys to search for
+ * @param key_size size in bytes of a single @p keys entry
+ * @param key_nr   number of @p keys
+ * @param nodes    array of @p key_nr pointers to store results into
+ *
+ * Descents for up to #FEYT_TREE_BATCH_NR keys are interleaved level by level
+ * so that memory accesses of independent lookups overlap.
+ *
+ * @ingroup feyt_tree
+ */
+extern void feyt_tree_lower_bound_batch(const struct feyt_tree  *tree,
+                                        const char              *keys,
+                                        size_t                   key_size,
+                                        size_t                   key_nr,
+                                        char                   **nodes);
+
+/**
+ * Run multiple feyt_tree_find() lookups at once
+ *
+ * @param tree     feyt_tree to search
+ * @param keys     array of keys to search for
+ * @param key_size size in bytes of a single @p keys entry
+ * @param key_nr   number of @p keys
+ * @param nodes    array of @p key_nr pointers to store results into
+ *
+ * @see feyt_tree_lower_bound_batch()
+ *
+ * @ingroup feyt_tree
+ */
+extern void feyt_tree_find_batch(const struct feyt_tree  *tree,
+                                 const char              *keys,
+                                 size_t                   key_size,
+                                 size_t                   key_nr,
+                                 char                   **nodes);
+
+/**
+ * Initialize a feyt_tree
+ *
+ * @param tree      feyt_tree to initialize
+ * @param nodes     underlying memory area containing nodes
+ * @param node_size size in bytes of a single node sitting into @p tree
+ * @param node_nr   maximum number of nodes @p tree may contain
+ * @param compare   comparison function used to order nodes and keys
+ * @param copy      copy function used to load nodes
+ *
+ * @p nodes must point to a memory area large enough to contain at least
+ * @p node_nr nodes. Prefetching is most effective when @p nodes is located
+ * @p node_size bytes past a #FEYT_TREE_LINE_SIZE boundary, i.e. when blocks of
+ * descendants do not straddle cache lines.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @ingroup feyt_tree
+ */
+extern void feyt_tree_init(struct feyt_tree *tree,
+                           char             *nodes,
+                           size_t            node_size,
+                           size_t            node_nr,
+                           farr_compare_fn  *compare,
+                           farr_copy_fn     *copy);
+
+/**
+ * Release resources allocated for a feyt_tree
+ *
+ * @param tree feyt_tree to release resources for
+ *
+ * @ingroup feyt_tree
+ */
+extern void feyt_tree_fini(struct feyt_tree *tree __unused);
+
+/**
+ * Create a feyt_tree
+ *
+ * @param node_size size in bytes of a single node sitting into @p tree
+ * @param node_nr   maximum number of nodes @p tree may contain
+ * @param compare   comparison function used to order nodes and keys
+ * @param copy      copy function used to load nodes
+ *
+ * Wrapper allocating and initializing a feyt_tree. Nodes memory area is laid
+ * out so that prefetching is cache line friendly.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @return pointer to new created search tree
+ *
+ * @ingroup feyt_tree
+ */
+extern struct feyt_tree * feyt_tree_create(size_t           node_size,
+                                           size_t           node_nr,
+                                           farr_compare_fn *compare,
+                                           farr_copy_fn    *copy);
+
+/**
+ * Release resources allocated by feyt_tree_create()
+ *
+ * @param tree feyt_tree to release resources for
+ *
+ * @ingroup feyt_tree
+ */
+extern void feyt_tree_destroy(struct feyt_tree *tree);
+
+#endif /* _KARN_FEYT_TREE_H */
@@ -0,0 +1,420 @@
+/**
+ * @file      fidx_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based indexed binary heap interface
+ *
+ * @defgroup fidx_heap Fixed length array based indexed binary heap
+ *
+ * Implicit binary heap where each hosted node is tagged with a caller chosen
+ * identifier in the [0:node_nr[ range, e.g. a graph vertex or a timer number.
+ *
+ * Alongside the array of nodes, the heap maintains an identifier to slot map
+ * so that any hosted node may be located in O(1) then promoted, demoted or
+ * removed in O(log(n)) time complexity, all of this using contiguous storage
+ * and no per node pointers.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_FIDX_HEAP_H
+#define _KARN_FIDX_HEAP_H
+
+#include <karn/fabs_tree.h>
+
+/**
+ * Fixed length array based indexed binary heap
+ *
+ * @ingroup fidx_heap
+ */
+struct fidx_heap {
+	/** Node comparator */
+	farr_compare_fn  *fidx_compare;
+	/** Node copier */
+	farr_copy_fn     *fidx_copy;
+	/** Slot to identifier map */
+	unsigned int     *fidx_ids;
+	/** Identifier to slot map */
+	unsigned int     *fidx_slots;
+	/** Underlying array of nodes and count of hosted nodes */
+	struct fabs_tree  fidx_tree;
+};
+
+#define fidx_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert((_heap)->fidx_compare); \
+	karn_assert((_heap)->fidx_copy); \
+	karn_assert((_heap)->fidx_ids); \
+	karn_assert((_heap)->fidx_slots)
+
+/**
+ * Return capacity of a fidx_heap in number of nodes
+ *
+ * @param heap fidx_heap to get capacity from
+ *
+ * @return maximum number of nodes, i.e. upper bound of identifiers range
+ *
+ * @ingroup fidx_heap
+ */
+static inline size_t fidx_heap_nr(const struct fidx_heap *heap)
+{
+	fidx_heap_assert(heap);
+
+	return fabs_tree_nr(&heap->fidx_tree);
+}
+
+/**
+ * Return count of nodes hosted by a fidx_heap
+ *
+ * @param heap fidx_heap to get count from
+ *
+ * @return count
+ *
+ * @ingroup fidx_heap
+ */
+static inline size_t fidx_heap_count(const struct fidx_heap *heap)
+{
+	fidx_heap_assert(heap);
+
+	return fabs_tree_count(&heap->fidx_tree);
+}
+
+/**
+ * Indicate wether a fixed length array based indexed heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup fidx_heap
+ */
+static inline bool fidx_heap_empty(const struct fidx_heap *heap)
+{
+	fidx_heap_assert(heap);
+
+	return fabs_tree_empty(&heap->fidx_tree);
+}
+
+/**
+ * Indicate wether a fixed length array based indexed heap is full or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  full
+ * @retval false not full
+ *
+ * @ingroup fidx_heap
+ */
+static inline bool fidx_heap_full(const struct fidx_heap *heap)
+{
+	fidx_heap_assert(heap);
+
+	return fabs_tree_full(&heap->fidx_tree);
+}
+
+/**
+ * Indicate wether a node with specified identifier is hosted by a fidx_heap
+ *
+ * @param heap heap to search
+ * @param id   node identifier
+ *
+ * @retval true  hosted
+ * @retval false not hosted
+ *
+ * @ingroup fidx_heap
+ */
+static inline bool fidx_heap_contains(const struct fidx_heap *heap,
+                                      unsigned int            id)
+{
+	fidx_heap_assert(heap);
+	karn_assert(id < fidx_heap_nr(heap));
+
+	/*
+	 * Identifier to slot map entries are never reset: an entry is valid
+	 * only when pointing to a hosted slot which maps back to it.
+	 */
+	unsigned int slot = heap->fidx_slots[id];
+
+	return (slot < fabs_tree_count(&heap->fidx_tree)) &&
+	       (heap->fidx_ids[slot] == id);
+}
+
+/**
+ * Retrieve node with specified identifier
+ *
+ * @param heap heap to retrieve node from
+ * @param id   node identifier
+ *
+ * @return pointer to node
+ *
+ * @warning Behavior is undefined if @p heap does not host a node identified by
+ * @p id. Returned node must not be modified in a way that breaks heap property
+ * unless it is given back to fidx_heap_promote(), fidx_heap_demote() or
+ * fidx_heap_update() right after.
+ *
+ * @ingroup fidx_heap
+ */
+static inline char * fidx_heap_node(const struct fidx_heap *heap,
+                                    unsigned int            id)
+{
+	karn_assert(fidx_heap_contains(heap, id));
+
+	return fabs_tree_node(&heap->fidx_tree, heap->fidx_slots[id]);
+}
+
+/**
+ * Retrieve first node satisfying the heap property
+ *
+ * @param heap heap to retrieve node from
+ *
+ * Depending on user's compare implementation given at init time,
+ * fidx_heap_peek() will return smallest node for a min-heap, greatest one for
+ * a max-heap.
+ *
+ * @return pointer to first node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fidx_heap
+ */
+static inline char * fidx_heap_peek(const struct fidx_heap *heap)
+{
+	karn_assert(!fidx_heap_empty(heap));
+
+	return fabs_tree_root(&heap->fidx_tree);
+}
+
+/**
+ * Retrieve identifier of first node satisfying the heap property
+ *
+ * @param heap heap to retrieve identifier from
+ *
+ * @return identifier of node fidx_heap_peek() would return
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fidx_heap
+ */
+static inline unsigned int fidx_heap_peek_id(const struct fidx_heap *heap)
+{
+	karn_assert(!fidx_heap_empty(heap));
+
+	return heap->fidx_ids[FABS_TREE_ROOT_INDEX];
+}
+
+/**
+ * Insert data into a fixed length array based indexed heap
+ *
+ * @param heap heap to insert into
+ * @param id   identifier to tag @p node with
+ * @param node data to insert
+ *
+ * @p node is inserted by copy.
+ *
+ * @warning Behavior is undefined if @p heap is full, if @p id is out of
+ * [0:fidx_heap_nr()[ range or if @p heap already hosts a node identified by
+ * @p id.
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_insert(struct fidx_heap *heap,
+                             unsigned int      id,
+                             const char       *node);
+
+/**
+ * Extract first node from a fixed length array based indexed heap
+ *
+ * @param heap heap to extract from
+ * @param node data location to extract into
+ *
+ * First node, i.e. the one fidx_heap_peek() would return, is extracted by copy
+ * into @p node.
+ *
+ * @return identifier of extracted node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fidx_heap
+ */
+extern unsigned int fidx_heap_extract(struct fidx_heap *heap, char *node);
+
+/**
+ * Remove node with specified identifier from a fixed length array based indexed
+ * heap
+ *
+ * @param heap heap to remove node from
+ * @param id   identifier of node to remove
+ * @param node data location to extract removed node into, may be NULL
+ *
+ * @warning Behavior is undefined if @p heap does not host a node identified by
+ * @p id.
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_remove(struct fidx_heap *heap,
+                             unsigned int      id,
+                             char             *node);
+
+/**
+ * Replace node with specified identifier by one ordered first
+ *
+ * @param heap heap hosting node to promote
+ * @param id   identifier of node to promote
+ * @param node new node data
+ *
+ * Replace by copy the node identified by @p id with @p node, which should be
+ * ordered first or equal compared to the replaced one, i.e. implement a
+ * decrease-key operation for min-heaps. @p node may point to the node returned
+ * by fidx_heap_node() and modified in place.
+ *
+ * @warning Behavior is undefined if @p heap does not host a node identified by
+ * @p id or if @p node is ordered after replaced one.
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_promote(struct fidx_heap *heap,
+                              unsigned int      id,
+                              const char       *node);
+
+/**
+ * Replace node with specified identifier by one ordered last
+ *
+ * @param heap heap hosting node to demote
+ * @param id   identifier of node to demote
+ * @param node new node data
+ *
+ * Counterpart of fidx_heap_promote() where @p node should be ordered last or
+ * equal compared to the replaced one, i.e. implement an increase-key operation
+ * for min-heaps.
+ *
+ * @warning Behavior is undefined if @p heap does not host a node identified by
+ * @p id or if @p node is ordered before replaced one.
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_demote(struct fidx_heap *heap,
+                             unsigned int      id,
+                             const char       *node);
+
+/**
+ * Replace node with specified identifier by arbitrary data
+ *
+ * @param heap heap hosting node to update
+ * @param id   identifier of node to update
+ * @param node new node data
+ *
+ * Promote or demote the node identified by @p id according to @p node
+ * ordering, at the cost of one additional comparison.
+ *
+ * @warning Behavior is undefined if @p heap does not host a node identified by
+ * @p id.
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_update(struct fidx_heap *heap,
+                             unsigned int      id,
+                             const char       *node);
+
+/**
+ * Clear content of specified fidx_heap
+ *
+ * @param heap heap to clear
+ *
+ * Reset heap to empty state in O(1) time complexity.
+ *
+ * @ingroup fidx_heap
+ */
+static inline void fidx_heap_clear(struct fidx_heap *heap)
+{
+	fidx_heap_assert(heap);
+
+	fabs_tree_clear(&heap->fidx_tree);
+}
+
+/**
+ * Initialize a fidx_heap
+ *
+ * @param heap      heap to initialize
+ * @param nodes     underlying memory area containing nodes
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * @p nodes must point to a memory area large enough to contain at least
+ * @p node_nr nodes. Identifier / slot maps are allocated internally.
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr, a zero
+ * @p node_size or a @p node_nr larger than UINT_MAX.
+ *
+ * @ingroup fidx_heap
+ */
+extern int fidx_heap_init(struct fidx_heap *heap,
+                          char             *nodes,
+                          size_t            node_size,
+                          size_t            node_nr,
+                          farr_compare_fn  *compare,
+                          farr_copy_fn     *copy);
+
+/**
+ * Release resources allocated for a fidx_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_fini(struct fidx_heap *heap);
+
+/**
+ * Create a fidx_heap
+ *
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * Wrapper allocating and initializing a fidx_heap.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr, a zero
+ * @p node_size or a @p node_nr larger than UINT_MAX.
+ *
+ * @return pointer to new created indexed heap, NULL when out of memory
+ *
+ * @ingroup fidx_heap
+ */
+extern struct fidx_heap * fidx_heap_create(size_t           node_size,
+                                           size_t           node_nr,
+                                           farr_compare_fn *compare,
+                                           farr_copy_fn    *copy);
+
+/**
+ * Release resources allocated by fidx_heap_create() for fixed length array
+ * based indexed heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fidx_heap
+ */
+extern void fidx_heap_destroy(struct fidx_heap *heap);
+
+#endif /* _KARN_FIDX_HEAP_H */
@@ -0,0 +1,332 @@
+/**
+ * @file      fkey_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based integer key heap interface
+ *
+ * @defgroup fkey_heap Fixed length array based integer key heap
+ *
+ * Min-heap priority queue specialized for unsigned integer keys, each one
+ * carrying an opaque pointer sized payload.
+ *
+ * Keys and payloads are stored into separate arrays. Keys are laid out as an
+ * implicit d-ary heap which arity is chosen so that a group of siblings fills
+ * exactly a single cache line, i.e. 16 children for 32 bits keys and 8 for 64
+ * bits ones. Selecting the smallest child of a node then costs a handful of
+ * vector instructions instead of d - 1 function pointer based comparisons.
+ *
+ * Child scanning is vectorized using AVX2 when enabled at build time (-mavx2)
+ * or, on x86 when built with GCC compatible compilers, when detected at
+ * runtime. A scalar fallback is used otherwise.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_FKEY_HEAP_H
+#define _KARN_FKEY_HEAP_H
+
+#include <karn/common.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Size of cache lines groups of sibling keys are aligned onto.
+ *
+ * @ingroup fkey_heap
+ */
+#define FKEY_HEAP_LINE_SIZE (64U)
+
+/*
+ * Generate a heap structure named fkey_<_name>_heap holding keys of _type and
+ * its inline accessors.
+ */
+#define FKEY_HEAP_DEFINE(_name, _type) \
+	struct fkey_ ## _name ## _heap { \
+		size_t      fkey_count; \
+		size_t      fkey_nr; \
+		_type      *fkey_keys; \
+		uintptr_t  *fkey_payloads; \
+		void      (*fkey_siftdown)(_type      *keys, \
+		                           uintptr_t  *payloads, \
+		                           size_t      count, \
+		                           _type       key, \
+		                           uintptr_t   payload); \
+		void       *fkey_mem; \
+	}; \
+	\
+	static inline size_t \
+	fkey_ ## _name ## _heap_nr(const struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		karn_assert(heap); \
+		karn_assert(heap->fkey_count <= heap->fkey_nr); \
+		\
+		return heap->fkey_nr; \
+	} \
+	\
+	static inline size_t \
+	fkey_ ## _name ## _heap_count( \
+		const struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		karn_assert(heap); \
+		karn_assert(heap->fkey_count <= heap->fkey_nr); \
+		\
+		return heap->fkey_count; \
+	} \
+	\
+	static inline bool \
+	fkey_ ## _name ## _heap_empty( \
+		const struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		return !fkey_ ## _name ## _heap_count(heap); \
+	} \
+	\
+	static inline bool \
+	fkey_ ## _name ## _heap_full( \
+		const struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		return fkey_ ## _name ## _heap_count(heap) == heap->fkey_nr; \
+	} \
+	\
+	static inline _type \
+	fkey_ ## _name ## _heap_peek_key( \
+		const struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		karn_assert(!fkey_ ## _name ## _heap_empty(heap)); \
+		\
+		return heap->fkey_keys[0]; \
+	} \
+	\
+	static inline uintptr_t \
+	fkey_ ## _name ## _heap_peek_payload( \
+		const struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		karn_assert(!fkey_ ## _name ## _heap_empty(heap)); \
+		\
+		return heap->fkey_payloads[0]; \
+	}
+
+/**
+ * Fixed length array based 32 bits unsigned integer key heap
+ *
+ * Generated accessors are:
+ * - fkey_uint32_heap_nr() returning capacity in number of nodes,
+ * - fkey_uint32_heap_count() returning count of hosted nodes,
+ * - fkey_uint32_heap_empty() / fkey_uint32_heap_full() testing for emptiness /
+ *   fullness,
+ * - fkey_uint32_heap_peek_key() / fkey_uint32_heap_peek_payload() returning
+ *   smallest key / its payload without extracting them; behavior is undefined
+ *   if heap is empty.
+ *
+ * @ingroup fkey_heap
+ */
+FKEY_HEAP_DEFINE(uint32, uint32_t)
+
+/**
+ * Fixed length array based 64 bits unsigned integer key heap
+ *
+ * Provides fkey_uint64_heap_<accessor>() counterparts of fkey_uint32_heap
+ * ones.
+ *
+ * @ingroup fkey_heap
+ */
+FKEY_HEAP_DEFINE(uint64, uint64_t)
+
+/**
+ * Insert a key and its payload into a 32 bits key heap
+ *
+ * @param heap    heap to insert into
+ * @param key     priority key
+ * @param payload opaque data attached to @p key
+ *
+ * @warning Behavior is undefined if @p heap is full.
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint32_heap_insert(struct fkey_uint32_heap *heap,
+                                    uint32_t                 key,
+                                    uintptr_t                payload);
+
+/**
+ * Extract smallest key and its payload from a 32 bits key heap
+ *
+ * @param heap    heap to extract from
+ * @param payload location where to store payload attached to extracted key,
+ *                may be NULL
+ *
+ * @return smallest key
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fkey_heap
+ */
+extern uint32_t fkey_uint32_heap_extract(struct fkey_uint32_heap *heap,
+                                         uintptr_t               *payload);
+
+/**
+ * Insert a batch of keys and their payloads into a 32 bits key heap
+ *
+ * @param heap     heap to insert into
+ * @param keys     array of priority keys
+ * @param payloads array of opaque data attached to @p keys
+ * @param nr       number of keys to insert
+ *
+ * When the batch is at least as large as current @p heap content, keys are
+ * appended then the whole heap is rebuilt in O(n) time complexity. Otherwise,
+ * they are sifted up one by one.
+ *
+ * @warning Behavior is undefined if @p heap cannot host @p nr more keys.
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint32_heap_insert_batch(struct fkey_uint32_heap *heap,
+                                          const uint32_t          *keys,
+                                          const uintptr_t         *payloads,
+                                          size_t                   nr);
+
+/**
+ * Extract a batch of smallest keys and their payloads from a 32 bits key heap
+ *
+ * @param heap     heap to extract from
+ * @param keys     array to store extracted keys into
+ * @param payloads array to store payloads attached to extracted keys into,
+ *                 may be NULL
+ * @param nr       maximum number of keys to extract
+ *
+ * Extraction runs @p nr steps of heapsort in a single pass, storing keys and
+ * payloads straight into @p keys and @p payloads in ascending key order.
+ *
+ * @return number of extracted keys
+ *
+ * @ingroup fkey_heap
+ */
+extern size_t fkey_uint32_heap_extract_batch(struct fkey_uint32_heap *heap,
+                                             uint32_t                *keys,
+                                             uintptr_t               *payloads,
+                                             size_t                   nr);
+
+/**
+ * Clear content of a 32 bits key heap
+ *
+ * @param heap heap to clear
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint32_heap_clear(struct fkey_uint32_heap *heap);
+
+/**
+ * Initialize a 32 bits key heap
+ *
+ * @param heap heap to initialize
+ * @param nr   maximum number of nodes @p heap may contain
+ *
+ * Allocate cache line aligned storage for @p nr nodes and select child
+ * scanning implementation according to CPU features.
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p nr.
+ *
+ * @ingroup fkey_heap
+ */
+extern int fkey_uint32_heap_init(struct fkey_uint32_heap *heap, size_t nr);
+
+/**
+ * Release resources allocated for a 32 bits key heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint32_heap_fini(struct fkey_uint32_heap *heap);
+
+/**
+ * Insert a key and its payload into a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_insert()
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint64_heap_insert(struct fkey_uint64_heap *heap,
+                                    uint64_t                 key,
+                                    uintptr_t                payload);
+
+/**
+ * Extract smallest key and its payload from a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_extract()
+ *
+ * @ingroup fkey_heap
+ */
+extern uint64_t fkey_uint64_heap_extract(struct fkey_uint64_heap *heap,
+                                         uintptr_t               *payload);
+
+/**
+ * Insert a batch of keys and their payloads into a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_insert_batch()
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint64_heap_insert_batch(struct fkey_uint64_heap *heap,
+                                          const uint64_t          *keys,
+                                          const uintptr_t         *payloads,
+                                          size_t                   nr);
+
+/**
+ * Extract a batch of smallest keys and their payloads from a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_extract_batch()
+ *
+ * @ingroup fkey_heap
+ */
+extern size_t fkey_uint64_heap_extract_batch(struct fkey_uint64_heap *heap,
+                                             uint64_t                *keys,
+                                             uintptr_t               *payloads,
+                                             size_t                   nr);
+
+/**
+ * Clear content of a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_clear()
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint64_heap_clear(struct fkey_uint64_heap *heap);
+
+/**
+ * Initialize a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_init()
+ *
+ * @ingroup fkey_heap
+ */
+extern int fkey_uint64_heap_init(struct fkey_uint64_heap *heap, size_t nr);
+
+/**
+ * Release resources allocated for a 64 bits key heap
+ *
+ * @see fkey_uint32_heap_fini()
+ *
+ * @ingroup fkey_heap
+ */
+extern void fkey_uint64_heap_fini(struct fkey_uint64_heap *heap);
+
+#endif /* _KARN_FKEY_HEAP_H */
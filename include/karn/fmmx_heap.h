@@ -0,0 +1,336 @@
+/**
+ * @file      fmmx_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based min-max heap interface
+ *
+ * @defgroup fmmx_heap Fixed length array based min-max heap
+ *
+ * Double-ended priority queue as described in "Min-Max Heaps and Generalized
+ * Priority Queues" by Atkinson, Sack, Santoro and Strothotte, Communications of
+ * the ACM, 1986.
+ *
+ * Implicit binary tree where nodes located at even depths (min levels) are not
+ * greater than their descendants and nodes located at odd depths (max levels)
+ * are not smaller than their descendants. Smallest node is therefore the root
+ * and greatest node is one of its children.
+ *
+ * Both ends may be retrieved in O(1) and extracted in O(log(n)) time
+ * complexity. Insertion is O(log(n)) and building from unsorted data is O(n).
+ * Insertion into a full heap may evict one of both ends in a single
+ * O(log(n)) operation which suits bounded capacity priority queues.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_FMMX_HEAP_H
+#define _KARN_FMMX_HEAP_H
+
+#include <karn/fabs_tree.h>
+
+/**
+ * Fixed length array based min-max heap
+ *
+ * @ingroup fmmx_heap
+ */
+struct fmmx_heap {
+	/** Node comparator */
+	farr_compare_fn  *fmmx_compare;
+	/** Node copier */
+	farr_copy_fn     *fmmx_copy;
+	/** underlying binary search tree */
+	struct fabs_tree  fmmx_tree;
+};
+
+#define fmmx_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert((_heap)->fmmx_compare); \
+	karn_assert((_heap)->fmmx_copy)
+
+/**
+ * Return capacity of a fmmx_heap in number of nodes
+ *
+ * @param heap fmmx_heap to get capacity from
+ *
+ * @return maximum number of nodes
+ *
+ * @ingroup fmmx_heap
+ */
+static inline size_t fmmx_heap_nr(const struct fmmx_heap *heap)
+{
+	fmmx_heap_assert(heap);
+
+	return fabs_tree_nr(&heap->fmmx_tree);
+}
+
+/**
+ * Return count of nodes hosted by a fmmx_heap
+ *
+ * @param heap fmmx_heap to get count from
+ *
+ * @return count
+ *
+ * @ingroup fmmx_heap
+ */
+static inline size_t fmmx_heap_count(const struct fmmx_heap *heap)
+{
+	fmmx_heap_assert(heap);
+
+	return fabs_tree_count(&heap->fmmx_tree);
+}
+
+/**
+ * Indicate wether a fmmx_heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup fmmx_heap
+ */
+static inline bool fmmx_heap_empty(const struct fmmx_heap *heap)
+{
+	fmmx_heap_assert(heap);
+
+	return fabs_tree_empty(&heap->fmmx_tree);
+}
+
+/**
+ * Indicate wether a fmmx_heap is full or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  full
+ * @retval false not full
+ *
+ * @ingroup fmmx_heap
+ */
+static inline bool fmmx_heap_full(const struct fmmx_heap *heap)
+{
+	fmmx_heap_assert(heap);
+
+	return fabs_tree_full(&heap->fmmx_tree);
+}
+
+/**
+ * Retrieve smallest node of a fmmx_heap
+ *
+ * @param heap heap to retrieve node from
+ *
+ * @return pointer to smallest node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fmmx_heap
+ */
+static inline char * fmmx_heap_peek_min(const struct fmmx_heap *heap)
+{
+	karn_assert(!fmmx_heap_empty(heap));
+
+	return fabs_tree_root(&heap->fmmx_tree);
+}
+
+/**
+ * Retrieve greatest node of a fmmx_heap
+ *
+ * @param heap heap to retrieve node from
+ *
+ * @return pointer to greatest node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fmmx_heap
+ */
+extern char * fmmx_heap_peek_max(const struct fmmx_heap *heap);
+
+/**
+ * Insert data into a fmmx_heap
+ *
+ * @param heap heap to insert into
+ * @param node data to insert
+ *
+ * @p node is inserted by copy.
+ *
+ * @warning Behavior is undefined if @p heap is full.
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_insert(struct fmmx_heap *heap, const char *node);
+
+/**
+ * Insert data into a fmmx_heap, evicting smallest node when full
+ *
+ * @param heap    heap to insert into
+ * @param node    data to insert
+ * @param evicted data location to evict into
+ *
+ * When @p heap is full, either its smallest node or @p node itself when not
+ * greater is copied into @p evicted so that @p heap keeps its greatest nodes.
+ * Otherwise, @p node is inserted as with fmmx_heap_insert().
+ *
+ * @retval true  a node has been evicted
+ * @retval false @p node has been inserted with no eviction
+ *
+ * @ingroup fmmx_heap
+ */
+extern bool fmmx_heap_insert_evict_min(struct fmmx_heap *heap,
+                                       const char       *node,
+                                       char             *evicted);
+
+/**
+ * Insert data into a fmmx_heap, evicting greatest node when full
+ *
+ * @param heap    heap to insert into
+ * @param node    data to insert
+ * @param evicted data location to evict into
+ *
+ * When @p heap is full, either its greatest node or @p node itself when not
+ * smaller is copied into @p evicted so that @p heap keeps its smallest nodes.
+ * Otherwise, @p node is inserted as with fmmx_heap_insert().
+ *
+ * @retval true  a node has been evicted
+ * @retval false @p node has been inserted with no eviction
+ *
+ * @ingroup fmmx_heap
+ */
+extern bool fmmx_heap_insert_evict_max(struct fmmx_heap *heap,
+                                       const char       *node,
+                                       char             *evicted);
+
+/**
+ * Extract smallest node from a fmmx_heap
+ *
+ * @param heap heap to extract from
+ * @param node data location to extract into
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_extract_min(struct fmmx_heap *heap, char *node);
+
+/**
+ * Extract greatest node from a fmmx_heap
+ *
+ * @param heap heap to extract from
+ * @param node data location to extract into
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_extract_max(struct fmmx_heap *heap, char *node);
+
+/**
+ * Clear content of specified fmmx_heap
+ *
+ * @param heap heap to clear
+ *
+ * @ingroup fmmx_heap
+ */
+static inline void fmmx_heap_clear(struct fmmx_heap *heap)
+{
+	fmmx_heap_assert(heap);
+
+	fabs_tree_clear(&heap->fmmx_tree);
+}
+
+/**
+ * Build / heapify a fmmx_heap initialized with unsorted data
+ *
+ * @param heap  heap to heapify
+ * @param count count of nodes to heapify
+ *
+ * Build @p heap from the array passed as argument to fmmx_heap_init() in O(n)
+ * time complexity.
+ *
+ * @warning Behavior is undefined if @p count is zero.
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_build(struct fmmx_heap *heap, size_t count);
+
+/**
+ * Initialize a fmmx_heap
+ *
+ * @param heap      heap to initialize
+ * @param nodes     underlying memory area containing nodes
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * @p nodes must point to a memory area large enough to contain at least
+ * @p node_nr nodes.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_init(struct fmmx_heap *heap,
+                           char             *nodes,
+                           size_t            node_size,
+                           size_t            node_nr,
+                           farr_compare_fn  *compare,
+                           farr_copy_fn     *copy);
+
+/**
+ * Release resources allocated for a fmmx_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_fini(struct fmmx_heap *heap __unused);
+
+/**
+ * Create a fmmx_heap
+ *
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * Wrapper allocating and initializing a fmmx_heap.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @return pointer to new created min-max heap
+ *
+ * @ingroup fmmx_heap
+ */
+extern struct fmmx_heap * fmmx_heap_create(size_t           node_size,
+                                           size_t           node_nr,
+                                           farr_compare_fn *compare,
+                                           farr_copy_fn    *copy);
+
+/**
+ * Release resources allocated by fmmx_heap_create()
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fmmx_heap
+ */
+extern void fmmx_heap_destroy(struct fmmx_heap *heap);
+
+#endif /* _KARN_FMMX_HEAP_H */
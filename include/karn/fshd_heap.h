@@ -0,0 +1,327 @@
+/**
+ * @file      fshd_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based shadow heap interface
+ *
+ * @defgroup fshd_heap Fixed length array based shadow heap
+ *
+ * Binary heap which array is split into 2 consecutive zones: leading nodes
+ * satisfy the binary heap property while trailing ones, the shadow, are left
+ * unordered.
+ *
+ * Insertion appends nodes to the shadow in O(1) time complexity and performs
+ * no comparison. The shadow is merged into the heap ordered zone lazily, i.e.
+ * when first node is required or when the shadow grows larger than an
+ * adaptive threshold which follows the size of the heap ordered zone. Small
+ * shadows are merged by sifting their nodes up one by one whereas larger ones
+ * are heapified bottom-up, visiting their ancestors only.
+ *
+ * This suits bursty workloads where lots of nodes are inserted before being
+ * extracted since most per-node sift-up operations are replaced by a single
+ * O(n) heapify.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_FSHD_HEAP_H
+#define _KARN_FSHD_HEAP_H
+
+#include <karn/fabs_tree.h>
+
+/**
+ * Minimum number of nodes the shadow may hold before insertion merges it.
+ *
+ * Above this, insertion merges the shadow as soon as it holds more nodes than
+ * the heap ordered zone so that merging costs O(1) amortized per inserted
+ * node.
+ *
+ * @ingroup fshd_heap
+ */
+#define FSHD_HEAP_SHADOW_MIN (32U)
+
+/**
+ * Fixed length array based shadow heap
+ *
+ * @ingroup fshd_heap
+ */
+struct fshd_heap {
+	/** Count of leading nodes satisfying the heap property */
+	size_t            fshd_ordered;
+	/** Node comparator */
+	farr_compare_fn  *fshd_compare;
+	/** Node copier */
+	farr_copy_fn     *fshd_copy;
+	/** underlying binary search tree */
+	struct fabs_tree  fshd_tree;
+};
+
+#define fshd_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert((_heap)->fshd_compare); \
+	karn_assert((_heap)->fshd_copy); \
+	karn_assert((_heap)->fshd_ordered <= \
+	            fabs_tree_count(&(_heap)->fshd_tree))
+
+/**
+ * Return capacity of a fshd_heap in number of nodes
+ *
+ * @param heap fshd_heap to get capacity from
+ *
+ * @return maximum number of nodes
+ *
+ * @ingroup fshd_heap
+ */
+static inline size_t fshd_heap_nr(const struct fshd_heap *heap)
+{
+	fshd_heap_assert(heap);
+
+	return fabs_tree_nr(&heap->fshd_tree);
+}
+
+/**
+ * Return count of nodes hosted by a fshd_heap
+ *
+ * @param heap fshd_heap to get count from
+ *
+ * @return count, shadow nodes included
+ *
+ * @ingroup fshd_heap
+ */
+static inline size_t fshd_heap_count(const struct fshd_heap *heap)
+{
+	fshd_heap_assert(heap);
+
+	return fabs_tree_count(&heap->fshd_tree);
+}
+
+/**
+ * Indicate wether a fshd_heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup fshd_heap
+ */
+static inline bool fshd_heap_empty(const struct fshd_heap *heap)
+{
+	fshd_heap_assert(heap);
+
+	return fabs_tree_empty(&heap->fshd_tree);
+}
+
+/**
+ * Indicate wether a fshd_heap is full or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  full
+ * @retval false not full
+ *
+ * @ingroup fshd_heap
+ */
+static inline bool fshd_heap_full(const struct fshd_heap *heap)
+{
+	fshd_heap_assert(heap);
+
+	return fabs_tree_full(&heap->fshd_tree);
+}
+
+/**
+ * Retrieve first node of a fshd_heap
+ *
+ * @param heap heap to retrieve node from
+ *
+ * The shadow is merged into the heap ordered zone first, hence the non const
+ * @p heap argument unlike fbnr_heap_peek().
+ *
+ * @return pointer to first node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fshd_heap
+ */
+extern char * fshd_heap_peek(struct fshd_heap *heap);
+
+/**
+ * Insert data into a fshd_heap
+ *
+ * @param heap heap to insert into
+ * @param node data to insert
+ *
+ * @p node is appended by copy to the shadow in O(1) amortized time complexity.
+ *
+ * @warning Behavior is undefined if @p heap is full.
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_insert(struct fshd_heap *heap, const char *node);
+
+/**
+ * Extract first node from a fshd_heap
+ *
+ * @param heap heap to extract from
+ * @param node data location to extract into
+ *
+ * The shadow is merged into the heap ordered zone first.
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_extract(struct fshd_heap *heap, char *node);
+
+/**
+ * Insert a batch of data into specified fshd_heap
+ *
+ * @param heap  heap to insert into
+ * @param nodes array of data to insert
+ * @param nr    number of data nodes to insert
+ *
+ * @p nodes are appended by copy to the shadow.
+ *
+ * @warning Behavior is undefined if @p heap cannot host @p nr more nodes.
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_insert_batch(struct fshd_heap *heap,
+                                   const char       *nodes,
+                                   size_t            nr);
+
+/**
+ * Extract a batch of first nodes from specified fshd_heap
+ *
+ * @param heap  heap to extract from
+ * @param nodes array to extract data into
+ * @param nr    maximum number of data nodes to extract
+ *
+ * Extract up to @p nr first nodes in order and store them by copy into
+ * consecutive @p nodes slots.
+ * The shadow is merged once for the whole batch, then first nodes are drained
+ * by consecutive sift downs with no further merge check.
+ *
+ * @return number of extracted nodes
+ *
+ * @ingroup fshd_heap
+ */
+extern size_t fshd_heap_extract_batch(struct fshd_heap *heap,
+                                      char             *nodes,
+                                      size_t            nr);
+
+/**
+ * Clear content of specified fshd_heap
+ *
+ * @param heap heap to clear
+ *
+ * Reset heap to empty state.
+ *
+ * @ingroup fshd_heap
+ */
+static inline void fshd_heap_clear(struct fshd_heap *heap)
+{
+	fshd_heap_assert(heap);
+
+	heap->fshd_ordered = 0;
+	fabs_tree_clear(&heap->fshd_tree);
+}
+
+/**
+ * Build / heapify a fshd_heap initialized with unsorted data
+ *
+ * @param heap  heap to heapify
+ * @param count count of nodes to heapify
+ *
+ * Build @p heap from the array passed as argument to fshd_heap_init()
+ * according to Floyd algorithm in O(n) time complexity.
+ *
+ * @warning Behavior is undefined if @p count is zero.
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_build(struct fshd_heap *heap, size_t count);
+
+/**
+ * Initialize a fshd_heap
+ *
+ * @param heap      heap to initialize
+ * @param nodes     underlying memory area containing nodes
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * @p nodes must point to a memory area large enough to contain at least
+ * @p node_nr nodes.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_init(struct fshd_heap *heap,
+                           char             *nodes,
+                           size_t            node_size,
+                           size_t            node_nr,
+                           farr_compare_fn  *compare,
+                           farr_copy_fn     *copy);
+
+/**
+ * Release resources allocated for a fshd_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_fini(struct fshd_heap *heap __unused);
+
+/**
+ * Create a fshd_heap
+ *
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   maximum number of nodes @p heap may contain
+ * @param compare   comparison function used to order nodes
+ * @param copy      copy function used to move nodes / array slots.
+ *
+ * Wrapper allocating and initializing a fshd_heap.
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @return pointer to new created shadow heap
+ *
+ * @ingroup fshd_heap
+ */
+extern struct fshd_heap * fshd_heap_create(size_t           node_size,
+                                           size_t           node_nr,
+                                           farr_compare_fn *compare,
+                                           farr_copy_fn    *copy);
+
+/**
+ * Release resources allocated by fshd_heap_create()
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fshd_heap
+ */
+extern void fshd_heap_destroy(struct fshd_heap *heap);
+
+#endif /* _KARN_FSHD_HEAP_H */
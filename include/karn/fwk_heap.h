@@ -43,7 +43,7 @@ struct fwk_heap {
 	/** Node copier */
 	farr_copy_fn    *fwk_copy;
 	/** Current number of hosted nodes */
-	unsigned int     fwk_count;
+	size_t           fwk_count;
 	/**
 	 * Reverse bits bitmap used to identify wether a node is a left or right
 	 * child
@@ -70,7 +70,7 @@ struct fwk_heap {
  *
  * @ingroup fwk_heap
  */
-static inline unsigned int fwk_heap_nr(const struct fwk_heap *heap)
+static inline size_t fwk_heap_nr(const struct fwk_heap *heap)
 {
 	fwk_heap_assert(heap);
 
@@ -86,7 +86,7 @@ static inline unsigned int fwk_heap_nr(const struct fwk_heap *heap)
  *
  * @ingroup fwk_heap
  */
-static inline unsigned int fwk_heap_count(const struct fwk_heap *heap)
+static inline size_t fwk_heap_count(const struct fwk_heap *heap)
 {
 	fwk_heap_assert(heap);
 
@@ -180,6 +180,45 @@ extern void fwk_heap_insert(struct fwk_heap *heap, const char *node);
  */
 extern void fwk_heap_extract(struct fwk_heap *heap, char *node);
 
+/**
+ * Insert a batch of data into specified fwk_heap
+ *
+ * @param heap  heap to insert into
+ * @param nodes array of data to insert
+ * @param nr    number of data nodes to insert
+ *
+ * @p nodes are inserted by copy. When the batch is at least as large as
+ * current @p heap content, nodes are appended then the whole heap is rebuilt
+ * in O(n) time complexity. Otherwise, they are sifted up one by one.
+ *
+ * @warning Behavior is undefined if @p heap cannot host @p nr more nodes.
+ *
+ * @ingroup fwk_heap
+ */
+extern void fwk_heap_insert_batch(struct fwk_heap *heap,
+                                  const char      *nodes,
+                                  size_t           nr);
+
+/**
+ * Extract a batch of first nodes from specified fwk_heap
+ *
+ * @param heap  heap to extract from
+ * @param nodes array to extract data into
+ * @param nr    maximum number of data nodes to extract
+ *
+ * Extract up to @p nr first nodes in order and store them by copy into
+ * consecutive @p nodes slots.
+ * Extraction runs @p nr steps of weak heapsort in a single pass, swapping first
+ * nodes into released tail slots, which are copied out at once.
+ *
+ * @return number of extracted nodes
+ *
+ * @ingroup fwk_heap
+ */
+extern size_t fwk_heap_extract_batch(struct fwk_heap *heap,
+                                     char            *nodes,
+                                     size_t           nr);
+
 /**
  * Clear content of specified fwk_heap
  *
@@ -204,7 +243,7 @@ extern void fwk_heap_clear(struct fwk_heap *heap);
  *
  * @ingroup fwk_heap
  */
-extern void fwk_heap_build(struct fwk_heap *heap, unsigned int count);
+extern void fwk_heap_build(struct fwk_heap *heap, size_t count);
 
 /**
  * Initialize a fwk_heap
@@ -228,7 +267,7 @@ extern void fwk_heap_build(struct fwk_heap *heap, unsigned int count);
 extern int fwk_heap_init(struct fwk_heap *heap,
                          char            *nodes,
                          size_t           node_size,
-                         unsigned int     node_nr,
+                         size_t           node_nr,
                          farr_compare_fn *compare,
                          farr_copy_fn    *copy);
 
@@ -260,7 +299,7 @@ extern void fwk_heap_fini(struct fwk_heap *heap);
  * @ingroup fwk_heap
  */
 extern struct fwk_heap * fwk_heap_create(size_t           node_size,
-                                         unsigned int     node_nr,
+                                         size_t           node_nr,
                                          farr_compare_fn *compare,
                                          farr_copy_fn    *copy);
 
@@ -274,6 +313,93 @@ extern struct fwk_heap * fwk_heap_create(size_t           node_size,
  */
 extern void fwk_heap_destroy(struct fwk_heap *heap);
 
+#if defined(CONFIG_KARN_FWK_HEAP_GROW)
+
+/**
+ * Initialize a growable fwk_heap
+ *
+ * @param heap      heap to initialize
+ * @param node_size size in bytes of a single node sitting into @p heap
+ * @param node_nr   initial number of nodes @p heap may contain
+ * @param compare   comparison function used to locate the right array slot to
+ *                  insert data into
+ * @param copy      copy function used to swap nodes / array slots.
+ *
+ * Allocate storage for @p node_nr nodes and their reverse bits which may later
+ * be resized using fwk_heap_reserve(), fwk_heap_insert_grow() and
+ * fwk_heap_extract_shrink(). Large node storage is memory mapped so that
+ * resizing does not copy nodes. Fixed capacity operations remain available.
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p node_nr or a zero
+ * @p node_size.
+ *
+ * @ingroup fwk_heap
+ */
+extern int fwk_heap_init_grow(struct fwk_heap *heap,
+                              size_t           node_size,
+                              size_t           node_nr,
+                              farr_compare_fn *compare,
+                              farr_copy_fn    *copy);
+
+/**
+ * Release resources allocated by fwk_heap_init_grow()
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup fwk_heap
+ */
+extern void fwk_heap_fini_grow(struct fwk_heap *heap);
+
+/**
+ * Ensure a growable fwk_heap may host a given number of nodes
+ *
+ * @param heap heap to grow
+ * @param nr   minimum number of nodes @p heap should be able to contain
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @ingroup fwk_heap
+ */
+extern int fwk_heap_reserve(struct fwk_heap *heap, size_t nr);
+
+/**
+ * Insert data into a growable fwk_heap
+ *
+ * @param heap heap to insert into
+ * @param node data to insert
+ *
+ * Double @p heap capacity when full before inserting @p node by copy, giving
+ * an amortized constant growing cost.
+ *
+ * @return 0 on success, -ENOMEM when out of memory in which case @p heap is
+ *         left untouched
+ *
+ * @ingroup fwk_heap
+ */
+extern int fwk_heap_insert_grow(struct fwk_heap *heap, const char *node);
+
+/**
+ * Extract data from a growable fwk_heap and release unused storage
+ *
+ * @param heap   heap to extract from
+ * @param node   data location to extract into
+ * @param min_nr capacity below which @p heap should never shrink
+ *
+ * Same as fwk_heap_extract() but halve @p heap capacity once occupancy drops
+ * to a quarter of it, unless it would fall below @p min_nr.
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup fwk_heap
+ */
+extern void fwk_heap_extract_shrink(struct fwk_heap *heap,
+                                    char            *node,
+                                    size_t           min_nr);
+
+#endif /* defined(CONFIG_KARN_FWK_HEAP_GROW) */
+
 #if defined(CONFIG_KARN_FWK_HEAP_SORT)
 
 /**
@@ -0,0 +1,222 @@
+/**
+ * @file      ltree.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Loser tree based k-way merging interface
+ *
+ * @defgroup ltree Loser tree based k-way merging
+ *
+ * Merge k sorted inputs using a tournament tree storing the loser of each
+ * match: producing an output element costs a single comparison per tree level
+ * instead of the 2 per level a binary heap sift requires. Exhausted inputs are
+ * handled as sentinels losing all matches. Ties are resolved in favor of the
+ * input with the lowest index so that merging is stable.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_LTREE_H
+#define _KARN_LTREE_H
+
+#include <karn/farr.h>
+
+/**
+ * Loser tree
+ *
+ * Workspace that may be reused across merges of up to ltree::ltree_nr inputs.
+ *
+ * @ingroup ltree
+ */
+struct ltree {
+	/** Maximum number of inputs */
+	unsigned int  ltree_nr;
+	/**
+	 * Index of overall winner input followed by losers of internal matches
+	 * and tree building scratch area.
+	 */
+	unsigned int *ltree_nodes;
+};
+
+#define ltree_assert(_tree) \
+	karn_assert(_tree); \
+	karn_assert((_tree)->ltree_nr); \
+	karn_assert((_tree)->ltree_nodes)
+
+/**
+ * Sorted farr run to merge
+ *
+ * @ingroup ltree
+ */
+struct ltree_run {
+	/** Next record to merge */
+	const char *ltree_next;
+	/** End of run, i.e. location past last record */
+	const char *ltree_end;
+};
+
+/**
+ * Exhausted run refill callback
+ *
+ * @param run   run to refill
+ * @param index index of @p run within runs being merged
+ * @param data  opaque data given at merge time
+ *
+ * Called when all records of @p run have been merged. Implementation should
+ * update @p run to point to next sorted records of the input, or leave it empty
+ * (ltree_run::ltree_next equal to ltree_run::ltree_end) to mark input as
+ * exhausted.
+ * Records loaded by successive refills of the same run must be sorted as a
+ * whole.
+ *
+ * @return 0 on success, a non zero value to abort merging
+ *
+ * @ingroup ltree
+ */
+typedef int (ltree_refill_fn)(struct ltree_run *run,
+                              unsigned int      index,
+                              void             *data);
+
+/**
+ * Merged record output callback
+ *
+ * @param record record to output
+ * @param data   opaque data given at merge time
+ *
+ * Called for each record in merged order. @p record remains valid until the
+ * callback returns only.
+ *
+ * @return 0 on success, a non zero value to abort merging
+ *
+ * @ingroup ltree
+ */
+typedef int (ltree_output_fn)(const char *record, void *data);
+
+/**
+ * Merge sorted farr runs in a streaming manner
+ *
+ * @param tree     loser tree
+ * @param runs     array of runs to merge
+ * @param run_nr   number of @p runs
+ * @param rec_size size in bytes of a single record
+ * @param compare  comparison function used to order records
+ * @param refill   callback refilling exhausted runs, NULL if runs are not to
+ *                 be refilled
+ * @param output   callback records are given to in merged order
+ * @param data     opaque data given to @p refill and @p output
+ *
+ * @p runs are consumed while merging.
+ *
+ * @return 0 on success, first non zero value returned by @p refill or
+ *         @p output otherwise
+ *
+ * @warning Behavior is undefined if @p run_nr is zero or greater than @p tree
+ * capacity.
+ *
+ * @ingroup ltree
+ */
+extern int ltree_merge_runs(struct ltree     *tree,
+                            struct ltree_run *runs,
+                            unsigned int      run_nr,
+                            size_t            rec_size,
+                            farr_compare_fn  *compare,
+                            ltree_refill_fn  *refill,
+                            ltree_output_fn  *output,
+                            void             *data);
+
+/**
+ * Merge sorted farr runs into an array
+ *
+ * @param tree     loser tree
+ * @param runs     array of runs to merge
+ * @param run_nr   number of @p runs
+ * @param result   array to store merged records into
+ * @param rec_size size in bytes of a single record
+ * @param compare  comparison function used to order records
+ * @param copy     copy function used to store records into @p result
+ *
+ * @p result must be large enough to hold all records of @p runs and must not
+ * overlap any of them. @p runs are consumed while merging.
+ *
+ * @warning Behavior is undefined if @p run_nr is zero or greater than @p tree
+ * capacity.
+ *
+ * @ingroup ltree
+ */
+extern void ltree_merge_farr(struct ltree     *tree,
+                             struct ltree_run *runs,
+                             unsigned int      run_nr,
+                             char             *result,
+                             size_t            rec_size,
+                             farr_compare_fn  *compare,
+                             farr_copy_fn     *copy);
+
+#if defined(CONFIG_KARN_SLIST)
+
+#include <karn/slist.h>
+
+/**
+ * Merge sorted slist into a single one
+ *
+ * @param tree    loser tree
+ * @param result  slist to append merged nodes to
+ * @param lists   array of sorted slist to merge
+ * @param list_nr number of @p lists
+ * @param compare comparison function used to order nodes
+ *
+ * Nodes are moved from @p lists to @p result tail which may be non empty. All
+ * @p lists are empty once merging completes.
+ *
+ * @warning Behavior is undefined if @p list_nr is zero or greater than @p tree
+ * capacity.
+ *
+ * @ingroup ltree
+ */
+extern void ltree_merge_slist(struct ltree     *tree,
+                              struct slist     *result,
+                              struct slist     *lists,
+                              unsigned int      list_nr,
+                              slist_compare_fn *compare);
+
+#endif /* defined(CONFIG_KARN_SLIST) */
+
+/**
+ * Initialize a loser tree
+ *
+ * @param tree loser tree to initialize
+ * @param nr   maximum number of inputs @p tree may merge
+ *
+ * @return 0 on success, -ENOMEM when out of memory
+ *
+ * @warning Behavior is undefined when called with a zero @p nr.
+ *
+ * @ingroup ltree
+ */
+extern int ltree_init(struct ltree *tree, unsigned int nr);
+
+/**
+ * Release resources allocated for a loser tree
+ *
+ * @param tree loser tree to release resources for
+ *
+ * @ingroup ltree
+ */
+extern void ltree_fini(struct ltree *tree);
+
+#endif /* _KARN_LTREE_H */
@@ -50,6 +50,14 @@ extern struct pbnm_heap_node * pbnm_heap_peek(struct pbnm_heap *heap);
 
 extern struct pbnm_heap_node * pbnm_heap_extract(struct pbnm_heap *heap);
 
+extern void pbnm_heap_insert_batch(struct pbnm_heap      *heap,
+                                   struct pbnm_heap_node *keys[],
+                                   unsigned int           nr);
+
+extern unsigned int pbnm_heap_extract_batch(struct pbnm_heap      *heap,
+                                            struct pbnm_heap_node *keys[],
+                                            unsigned int           nr);
+
 extern void pbnm_heap_remove(struct pbnm_heap      *heap,
                              struct pbnm_heap_node *key);
 
@@ -0,0 +1,265 @@
+/**
+ * @file      radix_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Radix heap interface
+ *
+ * @defgroup radix_heap Radix heap
+ *
+ * Monotone min-heap priority queue of unsigned integer keys, i.e. a priority
+ * queue where keys inserted are never smaller than the last extracted one as
+ * found in Dijkstra shortest path or discrete event simulation algorithms.
+ *
+ * Nodes are spread over 65 buckets according to the position of the most
+ * significant bit differing between their key and the last extracted key.
+ * Bucket 0 holds nodes which key equals the last extracted one, bucket i > 0
+ * holds nodes which key differs from the last extracted one starting at bit
+ * i - 1. Extracting from an empty bucket 0 locates the first non-empty bucket
+ * using a bitmap, then redistributes its nodes into lower buckets. Each node
+ * may only move down the buckets which gives an amortized O(log(C)) extraction
+ * time complexity, C being the maximum distance between keys and the last
+ * extracted one. Insertion is O(1).
+ *
+ * Buckets are singly linked lists of intrusive nodes: no node allocation nor
+ * comparison function call is ever required.
+ *
+ * Both 32 and 64 bits keys are handled by the same implementation since
+ * locating non-empty buckets costs a single bit scan whatever the key width.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_RADIX_HEAP_H
+#define _KARN_RADIX_HEAP_H
+
+#include <karn/slist.h>
+#include <stdint.h>
+
+/**
+ * Number of radix_heap buckets, i.e. one per key bit plus one for keys equal
+ * to the last extracted one.
+ *
+ * @ingroup radix_heap
+ */
+#define RADIX_HEAP_BUCKET_NR (65U)
+
+/**
+ * Radix heap node
+ *
+ * Describes a single entry linked into a radix_heap. Embed it into user
+ * structures and use radix_heap_entry() to retrieve the enclosing entry.
+ *
+ * @ingroup radix_heap
+ */
+struct radix_heap_node {
+	/** Link into bucket */
+	struct slist_node radix_slist;
+	/** Priority key */
+	uint64_t          radix_key;
+};
+
+/**
+ * Radix heap
+ *
+ * @ingroup radix_heap
+ */
+struct radix_heap {
+	/** Count of hosted nodes */
+	unsigned int radix_count;
+	/** Key of the last extracted node, lower bound of all hosted keys */
+	uint64_t     radix_last;
+	/** Bitmap of non-empty buckets, bit i - 1 standing for bucket i > 0 */
+	uint64_t     radix_bmap;
+	/** Lower bounds of keys hosted by each bucket, unused for bucket 0 */
+	uint64_t     radix_mins[RADIX_HEAP_BUCKET_NR];
+	/** Buckets of nodes */
+	struct slist radix_buckets[RADIX_HEAP_BUCKET_NR];
+};
+
+#define radix_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert(!(_heap)->radix_count == \
+	            (!(_heap)->radix_bmap && \
+	             slist_empty(&(_heap)->radix_buckets[0])))
+
+/**
+ * Retrieve the entry enclosing a radix_heap node
+ *
+ * @param _node   pointer to radix_heap_node
+ * @param _type   type of enclosing entry
+ * @param _member name of radix_heap_node member within @p _type
+ *
+ * @ingroup radix_heap
+ */
+#define radix_heap_entry(_node, _type, _member) \
+	containerof(_node, _type, _member)
+
+/**
+ * Return key of specified radix_heap node
+ *
+ * @param node node to get key from
+ *
+ * @return key
+ *
+ * @ingroup radix_heap
+ */
+static inline uint64_t radix_heap_node_key(const struct radix_heap_node *node)
+{
+	karn_assert(node);
+
+	return node->radix_key;
+}
+
+/**
+ * Return count of nodes hosted by a radix_heap
+ *
+ * @param heap radix_heap to get count from
+ *
+ * @return count
+ *
+ * @ingroup radix_heap
+ */
+static inline unsigned int radix_heap_count(const struct radix_heap *heap)
+{
+	radix_heap_assert(heap);
+
+	return heap->radix_count;
+}
+
+/**
+ * Indicate wether a radix_heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup radix_heap
+ */
+static inline bool radix_heap_empty(const struct radix_heap *heap)
+{
+	return !radix_heap_count(heap);
+}
+
+/**
+ * Return the key of the last node extracted from a radix_heap
+ *
+ * @param heap heap to get key from
+ *
+ * @return last extracted key, i.e. the smallest key that may be inserted
+ *
+ * @ingroup radix_heap
+ */
+static inline uint64_t radix_heap_last_key(const struct radix_heap *heap)
+{
+	radix_heap_assert(heap);
+
+	return heap->radix_last;
+}
+
+/**
+ * Insert a node into a radix_heap
+ *
+ * @param heap heap to insert into
+ * @param node node to insert
+ * @param key  priority key to give @p node
+ *
+ * @warning Behavior is undefined if @p key is smaller than the last extracted
+ * key, i.e. radix_heap_last_key().
+ *
+ * @ingroup radix_heap
+ */
+extern void radix_heap_insert(struct radix_heap      *heap,
+                              struct radix_heap_node *node,
+                              uint64_t                key);
+
+/**
+ * Retrieve node with smallest key from a radix_heap
+ *
+ * @param heap heap to retrieve node from
+ *
+ * Since it may have to redistribute nodes among buckets, radix_heap_peek()
+ * modifies @p heap internal state and advances radix_heap_last_key() to the
+ * smallest hosted key.
+ *
+ * @return pointer to node with smallest key
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup radix_heap
+ */
+extern struct radix_heap_node * radix_heap_peek(struct radix_heap *heap);
+
+/**
+ * Extract node with smallest key from a radix_heap
+ *
+ * @param heap heap to extract from
+ *
+ * @return pointer to extracted node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup radix_heap
+ */
+extern struct radix_heap_node * radix_heap_extract(struct radix_heap *heap);
+
+/**
+ * Decrease key of a node hosted by a radix_heap
+ *
+ * @param heap heap hosting @p node
+ * @param node node to promote
+ * @param key  new priority key
+ *
+ * When the new key falls into another bucket, @p node has to be unlinked from
+ * its current bucket which costs a walk of the singly linked bucket up to
+ * @p node.
+ *
+ * @warning Behavior is undefined if @p key is larger than current @p node key
+ * or smaller than the last extracted key, i.e. radix_heap_last_key().
+ *
+ * @ingroup radix_heap
+ */
+extern void radix_heap_promote(struct radix_heap      *heap,
+                               struct radix_heap_node *node,
+                               uint64_t                key);
+
+/**
+ * Initialize a radix_heap
+ *
+ * @param heap heap to initialize
+ * @param base lower bound of keys to insert
+ *
+ * @p base is the initial value of radix_heap_last_key(), i.e. the smallest key
+ * that may be inserted until a first node is extracted.
+ *
+ * @ingroup radix_heap
+ */
+extern void radix_heap_init(struct radix_heap *heap, uint64_t base);
+
+/**
+ * Release resources allocated for a radix_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup radix_heap
+ */
+extern void radix_heap_fini(struct radix_heap *heap __unused);
+
+#endif /* _KARN_RADIX_HEAP_H */
@@ -0,0 +1,299 @@
+/**
+ * @file      rpair_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Rank-pairing heap interface
+ *
+ * @defgroup rpair_heap Rank-pairing heap
+ *
+ * Rank-pairing heap as described in "Rank-Pairing Heaps" by Haeupler, Sen and
+ * Tarjan, SIAM Journal on Computing, 2011.
+ *
+ * Heap is a circular list of half-ordered half trees, i.e. binary trees which
+ * root has no right child and where each node key is not greater than the keys
+ * of its left subtree. Binary trees are stored using the left-child
+ * right-sibling lcrs_node representation: the left child of a node is its
+ * lcrs_node youngest child and the right child is its next sibling. Root list
+ * is chained thanks to root next sibling links.
+ *
+ * Nodes are given a rank so that linking half trees of equal rank only keeps
+ * trees balanced. Extraction performs a single pass of such linkings. Unlike
+ * pairing heaps, promoting a node cuts it from its tree and reinserts it into
+ * the root list then repairs ranks of its former ancestors only which gives an
+ * amortized O(1) decrease key time complexity. Insertion and merging are O(1),
+ * extraction and removal are O(log(n)) amortized.
+ *
+ * Both type-1 and type-2 rank rules are implemented and selected at
+ * initialization time. Type-2 rule is more relaxed and requires slightly less
+ * rank updates.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_RPAIR_HEAP_H
+#define _KARN_RPAIR_HEAP_H
+
+#include <karn/lcrs.h>
+
+/**
+ * Rank-pairing heap node
+ *
+ * Describes a single entry linked into a rpair_heap. Embed it into user
+ * structures and use rpair_heap_entry() to retrieve the enclosing entry.
+ *
+ * Unlike regular lcrs_node trees, missing children are encoded as NULL
+ * pointers.
+ *
+ * @ingroup rpair_heap
+ */
+struct rpair_heap_node {
+	/** Left child and right sibling links */
+	struct lcrs_node        rpair_lcrs;
+	/** Binary tree parent, NULL for roots */
+	struct rpair_heap_node *rpair_parent;
+	/** Rank */
+	unsigned int            rpair_rank;
+};
+
+/**
+ * Retrieve the entry enclosing a rpair_heap node
+ *
+ * @param _node   pointer to rpair_heap_node
+ * @param _type   type of enclosing entry
+ * @param _member name of rpair_heap_node member within @p _type
+ *
+ * @ingroup rpair_heap
+ */
+#define rpair_heap_entry(_node, _type, _member) \
+	containerof(_node, _type, _member)
+
+/**
+ * Rank rule enforced by a rpair_heap
+ *
+ * @ingroup rpair_heap
+ */
+enum rpair_heap_type {
+	/** Type-1 rule: children rank differences are 1 and 1 or 0 and i */
+	RPAIR_HEAP_TYPE1,
+	/** Type-2 rule: type-1 rule plus rank differences of 1 and 2 */
+	RPAIR_HEAP_TYPE2
+};
+
+/**
+ * Rank-pairing heap
+ *
+ * @ingroup rpair_heap
+ */
+struct rpair_heap {
+	/** Count of hosted nodes */
+	unsigned int            rpair_count;
+	/** Rank rule */
+	enum rpair_heap_type    rpair_type;
+	/** Root with smallest key, entry point of circular root list */
+	struct rpair_heap_node *rpair_min;
+};
+
+#define rpair_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert(!(_heap)->rpair_min ^ !!(_heap)->rpair_count)
+
+/**
+ * Compare two rpair_heap nodes
+ *
+ * @return an integer less than, equal to, or greater than zero if @p first is
+ *         found, respectively, to be less than, to match, or be greater than
+ *         @p second.
+ *
+ * @ingroup rpair_heap
+ */
+typedef int (rpair_heap_compare_fn)
+            (const struct rpair_heap_node *restrict first,
+             const struct rpair_heap_node *restrict second);
+
+/**
+ * Return count of nodes hosted by a rpair_heap
+ *
+ * @param heap rpair_heap to get count from
+ *
+ * @return count
+ *
+ * @ingroup rpair_heap
+ */
+static inline unsigned int rpair_heap_count(const struct rpair_heap *heap)
+{
+	rpair_heap_assert(heap);
+
+	return heap->rpair_count;
+}
+
+/**
+ * Indicate wether a rpair_heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup rpair_heap
+ */
+static inline bool rpair_heap_empty(const struct rpair_heap *heap)
+{
+	return !rpair_heap_count(heap);
+}
+
+/**
+ * Retrieve node with smallest key from a rpair_heap
+ *
+ * @param heap heap to retrieve node from
+ *
+ * @return pointer to node with smallest key
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup rpair_heap
+ */
+static inline struct rpair_heap_node *
+rpair_heap_peek(const struct rpair_heap *heap)
+{
+	karn_assert(!rpair_heap_empty(heap));
+
+	return heap->rpair_min;
+}
+
+/**
+ * Insert a node into a rpair_heap
+ *
+ * @param heap    heap to insert into
+ * @param node    node to insert
+ * @param compare comparison function
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_insert(struct rpair_heap      *heap,
+                              struct rpair_heap_node *node,
+                              rpair_heap_compare_fn  *compare);
+
+/**
+ * Extract node with smallest key from a rpair_heap
+ *
+ * @param heap    heap to extract from
+ * @param compare comparison function
+ *
+ * @return pointer to extracted node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup rpair_heap
+ */
+extern struct rpair_heap_node *
+rpair_heap_extract(struct rpair_heap *heap, rpair_heap_compare_fn *compare);
+
+/**
+ * Insert an array of nodes into a rpair_heap
+ *
+ * @param heap    heap to insert into
+ * @param nodes   nodes to insert
+ * @param nr      number of @p nodes
+ * @param compare comparison function
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_insert_batch(struct rpair_heap      *heap,
+                                    struct rpair_heap_node *nodes[],
+                                    unsigned int            nr,
+                                    rpair_heap_compare_fn  *compare);
+
+/**
+ * Remove a node from a rpair_heap
+ *
+ * @param heap    heap hosting @p node
+ * @param node    node to remove
+ * @param compare comparison function
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_remove(struct rpair_heap      *heap,
+                              struct rpair_heap_node *node,
+                              rpair_heap_compare_fn  *compare);
+
+/**
+ * Move all nodes of a rpair_heap into another one
+ *
+ * @param result  heap to merge into
+ * @param source  heap to merge, left empty on return
+ * @param compare comparison function
+ *
+ * @warning Both heaps must enforce the same rank rule.
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_merge(struct rpair_heap     *result,
+                             struct rpair_heap     *source,
+                             rpair_heap_compare_fn *compare);
+
+/**
+ * Restore heap property after the key of a node has been decreased
+ *
+ * @param heap    heap hosting @p key
+ * @param key     node which key has been decreased
+ * @param compare comparison function
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_promote(struct rpair_heap      *heap,
+                               struct rpair_heap_node *key,
+                               rpair_heap_compare_fn  *compare);
+
+/**
+ * Restore heap property after the key of a node has been increased
+ *
+ * @param heap    heap hosting @p key
+ * @param key     node which key has been increased
+ * @param compare comparison function
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_demote(struct rpair_heap      *heap,
+                              struct rpair_heap_node *key,
+                              rpair_heap_compare_fn  *compare);
+
+/**
+ * Initialize a rpair_heap
+ *
+ * @param heap heap to initialize
+ * @param type rank rule to enforce
+ *
+ * @ingroup rpair_heap
+ */
+extern void rpair_heap_init(struct rpair_heap *heap, enum rpair_heap_type type);
+
+/**
+ * Release resources allocated for a rpair_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup rpair_heap
+ */
+static inline void rpair_heap_fini(struct rpair_heap *heap __unused)
+{
+	rpair_heap_assert(heap);
+}
+
+#endif /* _KARN_RPAIR_HEAP_H */
@@ -0,0 +1,307 @@
+/**
+ * @file      rwk_heap.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Relaxed weak heap interface
+ *
+ * @defgroup rwk_heap Relaxed weak heap
+ *
+ * Run-relaxed weak heap following "Relaxed weak queues: an alternative to
+ * Fibonacci heaps" by Elmasry, Jensen and Katajainen, itself derived from the
+ * run-relaxed heaps of Driscoll, Gabow, Shrairman and Tarjan.
+ *
+ * Heap is a forest of perfect weak heaps with at most 2 trees per rank. Trees
+ * are stored in binary form using the lcrs_node left-child right-sibling
+ * representation: a node's right subtree (its lcrs_node youngest child) holds
+ * nodes which keys are not smaller than its own while its left subtree (its
+ * lcrs_node next sibling) is unconstrained. Seen as multiway trees, these are
+ * binomial trees where the youngest child of a node of rank r has rank r - 1.
+ *
+ * Numbers of trees per rank form a regular counter, i.e. there is a rank with
+ * no tree between any 2 ranks holding 2 trees. Insertion links the 2 trees of
+ * smallest rank holding 2 trees, if any, then adds a single node tree, hence
+ * performs at most one comparison.
+ *
+ * Decreasing a key may break heap ordering between a node and its
+ * distinguished ancestor, i.e. its multiway parent: such a node is then
+ * marked as a potential violation instead of being sifted up. Marked nodes
+ * which are consecutive siblings form runs, others are singletons. When there
+ * are more marked nodes than ranks, either a run or 2 singletons of same rank
+ * exist: a constant number of transformations relinking a handful of subtrees
+ * then reduces the number of marks.
+ *
+ * Insertion and promotion are O(1) in the worst case. Smallest key node is
+ * either a root or a marked node: peeking, extraction and removal are
+ * O(log(n)).
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_RWK_HEAP_H
+#define _KARN_RWK_HEAP_H
+
+#include <karn/lcrs.h>
+#include <karn/dlist.h>
+#include <stdint.h>
+
+/**
+ * Maximum number of distinct ranks, i.e. one per bit of node count.
+ *
+ * @ingroup rwk_heap
+ */
+#define RWK_HEAP_RANK_NR (32U)
+
+/**
+ * rwk_heap_node mark states
+ *
+ * @ingroup rwk_heap
+ */
+enum rwk_heap_state {
+	/** Not marked */
+	RWK_HEAP_CLEAN,
+	/** Marked run member following a marked younger sibling */
+	RWK_HEAP_MEMBER,
+	/** Marked singleton, linked into rwk_heap::rwk_singles */
+	RWK_HEAP_SINGLE,
+	/** Youngest marked member of a run, linked into rwk_heap::rwk_runs */
+	RWK_HEAP_RUN
+};
+
+/**
+ * Relaxed weak heap node
+ *
+ * Describes a single entry linked into a rwk_heap. Embed it into user
+ * structures and use rwk_heap_entry() to retrieve the enclosing entry.
+ *
+ * Unlike regular lcrs_node trees, missing children and siblings are encoded as
+ * NULL pointers.
+ *
+ * @ingroup rwk_heap
+ */
+struct rwk_heap_node {
+	/** Youngest child and next (elder) sibling links */
+	struct lcrs_node      rwk_lcrs;
+	/** Distinguished ancestor, i.e. multiway parent, NULL for roots */
+	struct rwk_heap_node *rwk_parent;
+	/**
+	 * Previous (younger) sibling, NULL for youngest children and first
+	 * roots of a rank
+	 */
+	struct rwk_heap_node *rwk_prev;
+	/** Link into singleton or run list when marked */
+	struct dlist_node     rwk_mark;
+	/** Rank, i.e. number of multiway children */
+	unsigned int          rwk_rank;
+	/** Mark state */
+	enum rwk_heap_state   rwk_state;
+};
+
+/**
+ * Retrieve the entry enclosing a rwk_heap node
+ *
+ * @param _node   pointer to rwk_heap_node
+ * @param _type   type of enclosing entry
+ * @param _member name of rwk_heap_node member within @p _type
+ *
+ * @ingroup rwk_heap
+ */
+#define rwk_heap_entry(_node, _type, _member) \
+	containerof(_node, _type, _member)
+
+/**
+ * Relaxed weak heap
+ *
+ * @ingroup rwk_heap
+ */
+struct rwk_heap {
+	/** Count of hosted nodes */
+	unsigned int          rwk_count;
+	/** Count of marked nodes */
+	unsigned int          rwk_marks_nr;
+	/** Bitmap of ranks holding at least one tree */
+	uint32_t              rwk_roots_bmap;
+	/** Bitmap of ranks holding 2 trees */
+	uint32_t              rwk_carries_bmap;
+	/** Bitmap of ranks holding at least one singleton */
+	uint32_t              rwk_singles_bmap;
+	/** Bitmap of ranks holding at least 2 singletons */
+	uint32_t              rwk_pairs_bmap;
+	/**
+	 * First tree root per rank, second one if any being its next
+	 * sibling
+	 */
+	struct rwk_heap_node *rwk_roots[RWK_HEAP_RANK_NR];
+	/** Youngest marked members of runs */
+	struct dlist_node     rwk_runs;
+	/** Marked singletons indexed by rank */
+	struct dlist_node     rwk_singles[RWK_HEAP_RANK_NR];
+};
+
+#define rwk_heap_assert(_heap) \
+	karn_assert(_heap); \
+	karn_assert(!(_heap)->rwk_roots_bmap == !(_heap)->rwk_count); \
+	karn_assert(!((_heap)->rwk_carries_bmap & \
+	              ~(_heap)->rwk_roots_bmap)); \
+	karn_assert((_heap)->rwk_marks_nr <= (_heap)->rwk_count)
+
+/**
+ * Compare two rwk_heap nodes
+ *
+ * @return an integer less than, equal to, or greater than zero if @p first is
+ *         found, respectively, to be less than, to match, or be greater than
+ *         @p second.
+ *
+ * @ingroup rwk_heap
+ */
+typedef int (rwk_heap_compare_fn)(const struct rwk_heap_node *restrict first,
+                                  const struct rwk_heap_node *restrict second);
+
+/**
+ * Return count of nodes hosted by a rwk_heap
+ *
+ * @param heap rwk_heap to get count from
+ *
+ * @return count
+ *
+ * @ingroup rwk_heap
+ */
+static inline unsigned int rwk_heap_count(const struct rwk_heap *heap)
+{
+	rwk_heap_assert(heap);
+
+	return heap->rwk_count;
+}
+
+/**
+ * Indicate wether a rwk_heap is empty or not
+ *
+ * @param heap heap to test
+ *
+ * @retval true  empty
+ * @retval false not empty
+ *
+ * @ingroup rwk_heap
+ */
+static inline bool rwk_heap_empty(const struct rwk_heap *heap)
+{
+	return !rwk_heap_count(heap);
+}
+
+/**
+ * Retrieve node with smallest key from a rwk_heap
+ *
+ * @param heap    heap to retrieve node from
+ * @param compare comparison function
+ *
+ * Roots and marked nodes are scanned in O(log(n)) time complexity.
+ *
+ * @return pointer to node with smallest key
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup rwk_heap
+ */
+extern struct rwk_heap_node * rwk_heap_peek(const struct rwk_heap *heap,
+                                            rwk_heap_compare_fn   *compare);
+
+/**
+ * Insert a node into a rwk_heap
+ *
+ * @param heap    heap to insert into
+ * @param node    node to insert
+ * @param compare comparison function
+ *
+ * Runs in O(1) worst-case time complexity and performs at most one comparison.
+ *
+ * @ingroup rwk_heap
+ */
+extern void rwk_heap_insert(struct rwk_heap      *heap,
+                            struct rwk_heap_node *node,
+                            rwk_heap_compare_fn  *compare);
+
+/**
+ * Extract node with smallest key from a rwk_heap
+ *
+ * @param heap    heap to extract from
+ * @param compare comparison function
+ *
+ * Runs in O(log(n)) time complexity.
+ *
+ * @return pointer to extracted node
+ *
+ * @warning Behavior is undefined if @p heap is empty.
+ *
+ * @ingroup rwk_heap
+ */
+extern struct rwk_heap_node * rwk_heap_extract(struct rwk_heap     *heap,
+                                               rwk_heap_compare_fn *compare);
+
+/**
+ * Remove a node from a rwk_heap
+ *
+ * @param heap    heap hosting @p node
+ * @param node    node to remove
+ * @param compare comparison function
+ *
+ * @ingroup rwk_heap
+ */
+extern void rwk_heap_remove(struct rwk_heap      *heap,
+                            struct rwk_heap_node *node,
+                            rwk_heap_compare_fn  *compare);
+
+/**
+ * Restore heap property after the key of a node has been decreased
+ *
+ * @param heap    heap hosting @p key
+ * @param key     node which key has been decreased
+ * @param compare comparison function
+ *
+ * Runs in O(1) worst-case time complexity: @p key is compared against its
+ * parent only and marked if smaller, a constant number of transformations
+ * bringing the number of marked nodes back within its bound.
+ *
+ * @ingroup rwk_heap
+ */
+extern void rwk_heap_promote(struct rwk_heap      *heap,
+                             struct rwk_heap_node *key,
+                             rwk_heap_compare_fn  *compare);
+
+/**
+ * Initialize a rwk_heap
+ *
+ * @param heap heap to initialize
+ *
+ * @ingroup rwk_heap
+ */
+extern void rwk_heap_init(struct rwk_heap *heap);
+
+/**
+ * Release resources allocated for a rwk_heap
+ *
+ * @param heap heap to release resources for
+ *
+ * @ingroup rwk_heap
+ */
+static inline void rwk_heap_fini(struct rwk_heap *heap __unused)
+{
+	rwk_heap_assert(heap);
+}
+
+#endif /* _KARN_RWK_HEAP_H */
@@ -48,8 +48,13 @@ sbnm_heap_node_from_lcrs(const struct lcrs_node *node)
 typedef int (sbnm_heap_compare_fn)(const struct sbnm_heap_node *first,
                                    const struct sbnm_heap_node *second);
 
+/*
+ * sbnm_lazy counts singleton roots prepended by sbnm_heap_insert_lazy() to the
+ * root list since last consolidation.
+ */
 struct sbnm_heap {
 	unsigned int          sbnm_count;
+	unsigned int          sbnm_lazy;
 	struct lcrs_node     *sbnm_roots;
 	sbnm_heap_compare_fn *sbnm_compare;
 };
@@ -57,11 +62,13 @@ struct sbnm_heap {
 #define sbnm_heap_assert(_heap) \
 	karn_assert(_heap); \
 	karn_assert(lcrs_istail((_heap)->sbnm_roots) ^ (_heap)->sbnm_count); \
+	karn_assert((_heap)->sbnm_lazy <= (_heap)->sbnm_count); \
 	karn_assert((_heap)->sbnm_compare)
 
 #define SBNM_HEAP_INIT(_heap, _compare) \
 	{ \
 		.sbnm_count   = 0, \
+		.sbnm_lazy    = 0, \
 		.sbnm_roots   = LCRS_TAIL, \
 		.sbnm_compare = _compare \
 	}
@@ -73,6 +80,19 @@ extern void sbnm_heap_insert(struct sbnm_heap      *heap,
 
 extern struct sbnm_heap_node * sbnm_heap_extract(struct sbnm_heap *heap);
 
+extern void sbnm_heap_insert_lazy(struct sbnm_heap      *heap,
+                                  struct sbnm_heap_node *key);
+
+extern void sbnm_heap_consolidate(struct sbnm_heap *heap);
+
+extern void sbnm_heap_insert_batch(struct sbnm_heap      *heap,
+                                   struct sbnm_heap_node *keys[],
+                                   unsigned int           nr);
+
+extern unsigned int sbnm_heap_extract_batch(struct sbnm_heap      *heap,
+                                            struct sbnm_heap_node *keys[],
+                                            unsigned int           nr);
+
 extern void sbnm_heap_remove(struct sbnm_heap      *heap,
                              struct sbnm_heap_node *key);
 
@@ -107,6 +127,7 @@ sbnm_heap_init(struct sbnm_heap *heap, sbnm_heap_compare_fn *compare)
 	karn_assert(compare);
 
 	heap->sbnm_count = 0;
+	heap->sbnm_lazy = 0;
 	heap->sbnm_roots = lcrs_mktail(NULL);
 	heap->sbnm_compare = compare;
 }
@@ -32,17 +32,50 @@
 #define spair_heap_entry(_node, _type, _member) \
 	containerof(_node, _type, _member)
 
+/*
+ * Pairing strategies used to link subtrees together at extraction / removal
+ * time:
+ * - two-pass pairs trees left to right then links them right to left,
+ * - multipass repeatedly pairs trees left to right till a single one is left,
+ * - front-to-back pairs trees left to right then links them left to right.
+ *
+ * SPAIR_HEAP_AUX_MODE may be OR'ed with any of them to buffer inserted (and
+ * promoted) trees into an auxiliary list linked to the main tree using
+ * multipass pairing at extraction / removal time only.
+ */
+#define SPAIR_HEAP_TWOPASS_MODE    (0U)
+#define SPAIR_HEAP_MULTIPASS_MODE  (1U)
+#define SPAIR_HEAP_FRONT2BACK_MODE (2U)
+#define SPAIR_HEAP_PAIRING_MASK    (3U)
+#define SPAIR_HEAP_AUX_MODE        (1U << 2)
+
+/*
+ * spair_min points to the smallest node when located into the auxiliary list,
+ * NULL otherwise.
+ */
 struct spair_heap {
 	unsigned int      spair_count;
+	unsigned int      spair_mode;
 	struct lcrs_node *spair_root;
+	struct lcrs_node *spair_aux;
+	struct lcrs_node *spair_min;
 };
 
 #define spair_heap_assert(_heap) \
 	karn_assert(_heap); \
-	karn_assert(!(_heap)->spair_root ^ (_heap)->spair_count)
+	karn_assert(!(_heap)->spair_root ^ (_heap)->spair_count); \
+	karn_assert((_heap)->spair_root || lcrs_istail((_heap)->spair_aux)); \
+	karn_assert(((_heap)->spair_mode & SPAIR_HEAP_PAIRING_MASK) <= \
+	            SPAIR_HEAP_FRONT2BACK_MODE)
 
 #define SPAIR_HEAP_INIT(_heap) \
-	{ .spair_root = NULL, .spair_count = 0 }
+	{ \
+		.spair_root  = NULL, \
+		.spair_count = 0, \
+		.spair_mode  = SPAIR_HEAP_TWOPASS_MODE, \
+		.spair_aux   = (struct lcrs_node *)LCRS_TAIL, \
+		.spair_min   = NULL \
+	}
 
 static inline unsigned int spair_heap_count(const struct spair_heap* heap)
 {
@@ -63,7 +96,7 @@ spair_heap_peek(const struct spair_heap *heap)
 {
 	spair_heap_assert(heap);
 
-	return heap->spair_root;
+	return heap->spair_min ? heap->spair_min : heap->spair_root;
 }
 
 extern void spair_heap_insert(struct spair_heap *heap,
@@ -73,6 +106,16 @@ extern void spair_heap_insert(struct spair_heap *heap,
 extern struct lcrs_node *
 spair_heap_extract(struct spair_heap *heap, lcrs_compare_fn *compare);
 
+extern void spair_heap_insert_batch(struct spair_heap *heap,
+                                    struct lcrs_node  *nodes[],
+                                    unsigned int       nr,
+                                    lcrs_compare_fn   *compare);
+
+extern unsigned int spair_heap_extract_batch(struct spair_heap *heap,
+                                             struct lcrs_node  *nodes[],
+                                             unsigned int       nr,
+                                             lcrs_compare_fn   *compare);
+
 extern void spair_heap_remove(struct spair_heap *heap,
                               struct lcrs_node  *node,
                               lcrs_compare_fn   *compare);
@@ -89,6 +132,8 @@ extern void spair_heap_demote(struct spair_heap *heap,
                               struct lcrs_node  *key,
                               lcrs_compare_fn   *compare);
 
+extern void spair_heap_init_mode(struct spair_heap *heap, unsigned int mode);
+
 extern void spair_heap_init(struct spair_heap *heap);
 
 static inline void spair_heap_fini(struct spair_heap *heap __unused)
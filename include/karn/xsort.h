@@ -0,0 +1,116 @@
+/**
+ * @file      xsort.h
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * External sorting interface
+ *
+ * @defgroup xsort External sorting
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _KARN_XSORT_H
+#define _KARN_XSORT_H
+
+#include <karn/farr.h>
+
+/**
+ * Minimum size in bytes of merge phase I/O blocks.
+ *
+ * Bounds the number of runs merged in a single pass so that run reads remain
+ * large and sequential.
+ *
+ * @ingroup xsort
+ */
+#define XSORT_BLOCK_MIN (1U << 20)
+
+/**
+ * External sorting statistics
+ *
+ * Timings are expressed in nanoseconds of wall clock time.
+ *
+ * @ingroup xsort
+ */
+struct xsort_stats {
+	/** number of records sorted */
+	uint64_t     xsort_rec_nr;
+	/** number of sorted runs generated out of input */
+	unsigned int xsort_run_nr;
+	/** number of merge passes */
+	unsigned int xsort_pass_nr;
+	/** time spent reading input */
+	uint64_t     xsort_read_nsec;
+	/** time spent sorting runs in memory */
+	uint64_t     xsort_sort_nsec;
+	/** time spent writing runs to temporary storage */
+	uint64_t     xsort_spill_nsec;
+	/**
+	 * time spent merging runs, output writing included, or writing output
+	 * only when input fits into memory
+	 */
+	uint64_t     xsort_merge_nsec;
+};
+
+/**
+ * Sort file of fixed size records larger than available memory.
+ *
+ * @param in_fd    file descriptor to read records from
+ * @param out_fd   file descriptor to write sorted records to
+ * @param rec_size size in bytes of a single record
+ * @param mem_size memory budget in bytes
+ * @param compare  comparison function used to order records
+ * @param copy     copy function used to move records
+ * @param tmp_dir  directory to create temporary files into or %NULL to use
+ *                 the system default one
+ * @param stats    optional location where to store statistics
+ *
+ * Records are read sequentially from @p in_fd current position up to end of
+ * file. Runs filling @p mem_size bytes are sorted using farr_intro_sort() and
+ * spilled to an unlinked temporary file. Runs are then k-way merged using a
+ * tournament tree, where k is bounded so that each run is read by blocks of at
+ * least #XSORT_BLOCK_MIN bytes when possible. Multiple merge passes are
+ * performed when there are more runs than that. Sorted records are written
+ * sequentially to @p out_fd current position.
+ *
+ * When input fits into a single run, it is sorted in memory and written to
+ * @p out_fd without spilling.
+ *
+ * Overall memory usage is bounded to @p mem_size bytes plus a few bytes per
+ * run. Sorting is not stable.
+ *
+ * @retval 0       success
+ * @retval -EINVAL @p mem_size cannot hold 3 records or input size is not a
+ *                 multiple of @p rec_size
+ * @retval -ENOMEM memory allocation failure
+ * @retval <0      other negative errno like values returned by underlying
+ *                 system calls
+ *
+ * @ingroup xsort
+ */
+extern int xsort_file(int                 in_fd,
+                      int                 out_fd,
+                      size_t              rec_size,
+                      size_t              mem_size,
+                      farr_compare_fn    *compare,
+                      farr_copy_fn       *copy,
+                      const char         *tmp_dir,
+                      struct xsort_stats *stats);
+
+#endif /* _KARN_XSORT_H */
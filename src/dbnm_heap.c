@@ -26,6 +26,9 @@
 
 #include <karn/dbnm_heap.h>
 
+/* Orders are bounded by the number of bits of dbnm_count. */
+#define DBNM_HEAP_ORDER_NR (32U)
+
 static struct dbnm_heap_node *
 dbnm_heap_sbl2node(struct dlist_node *sibling)
 {
@@ -103,6 +106,104 @@ void dbnm_heap_insert(struct dbnm_heap      *heap,
 	return;
 }
 
+void dbnm_heap_insert_lazy(struct dbnm_heap      *heap,
+                           struct dbnm_heap_node *key)
+{
+	dbnm_heap_assert(heap);
+	karn_assert(key);
+
+	key->dbnm_parent = NULL;
+	key->dbnm_child = NULL;
+	key->dbnm_order = 0;
+
+	/*
+	 * Defer linking of equal order roots to next consolidation, i.e. until
+	 * next extraction, removal or merge.
+	 */
+	dlist_nqueue_front(&heap->dbnm_roots, &key->dbnm_sibling);
+
+	heap->dbnm_count++;
+	heap->dbnm_lazy++;
+}
+
+/*
+ * Store tree into the order indexed array, joining it with trees of equal
+ * orders the same way a binary counter propagates carries.
+ *
+ * Return order of the tree stored.
+ */
+static unsigned int dbnm_heap_carry_tree(struct dbnm_heap_node *trees[],
+                                         struct dbnm_heap_node *tree,
+                                         dbnm_heap_compare_fn  *compare)
+{
+	unsigned int order = tree->dbnm_order;
+
+	karn_assert(order < DBNM_HEAP_ORDER_NR);
+
+	while (trees[order]) {
+		tree = dbnm_heap_join(trees[order], tree, compare);
+		trees[order++] = NULL;
+	}
+
+	trees[order] = tree;
+
+	return order;
+}
+
+/*
+ * Move all trees of list into the order indexed array and return the greatest
+ * order stored.
+ */
+static unsigned int dbnm_heap_spread_trees(struct dlist_node     *list,
+                                           struct dbnm_heap_node *trees[],
+                                           dbnm_heap_compare_fn  *compare)
+{
+	unsigned int top = 0;
+
+	while (!dlist_empty(list)) {
+		struct dbnm_heap_node *tree;
+		unsigned int           order;
+
+		tree = dbnm_heap_sbl2node(dlist_dqueue_front(list));
+
+		order = dbnm_heap_carry_tree(trees, tree, compare);
+		top = umax(top, order);
+	}
+
+	return top;
+}
+
+/* Rebuild order sorted root list. */
+static void dbnm_heap_gather_roots(struct dbnm_heap      *heap,
+                                   struct dbnm_heap_node *trees[],
+                                   unsigned int           top)
+{
+	unsigned int order;
+
+	for (order = 0; order <= top; order++)
+		if (trees[order])
+			dlist_nqueue_back(&heap->dbnm_roots,
+			                  &trees[order]->dbnm_sibling);
+
+	heap->dbnm_lazy = 0;
+}
+
+void dbnm_heap_consolidate(struct dbnm_heap     *heap,
+                           dbnm_heap_compare_fn *compare)
+{
+	dbnm_heap_assert(heap);
+	karn_assert(compare);
+
+	struct dbnm_heap_node *trees[DBNM_HEAP_ORDER_NR] = { NULL, };
+
+	if (!heap->dbnm_lazy)
+		return;
+
+	dbnm_heap_gather_roots(heap, trees,
+	                       dbnm_heap_spread_trees(&heap->dbnm_roots, trees,
+	                                              compare));
+}
+
 static struct dbnm_heap_node *
 dbnm_heap_inorder_child(struct dlist_node       *child,
                         const struct dlist_node *end,
@@ -135,6 +236,11 @@ dbnm_heap_peek(const struct dbnm_heap *heap, dbnm_heap_compare_fn *compare)
 	karn_assert(!dbnm_heap_empty(heap));
 	karn_assert(compare);
 
+	/*
+	 * heap cannot be consolidated from here: lazily inserted singletons
+	 * are scanned along with other roots.
+	 */
+
 	return dbnm_heap_inorder_child(heap->dbnm_roots.dlist_next,
 	                               &heap->dbnm_roots, compare);
 }
@@ -294,6 +400,8 @@ dbnm_heap_extract(struct dbnm_heap *heap, dbnm_heap_compare_fn *compare)
 	struct dlist_node     *roots = &heap->dbnm_roots;
 	struct dbnm_heap_node *key;
 
+	dbnm_heap_consolidate(heap, compare);
+
 	key = dbnm_heap_inorder_child(dlist_next(roots), roots, compare);
 
 	dbnm_heap_remove_root(heap, key, compare);
@@ -351,10 +459,91 @@ static void dbnm_heap_swap(struct dbnm_heap_node *parent,
 		parent->dbnm_child = NULL;
 }
 
+void dbnm_heap_insert_batch(struct dbnm_heap      *heap,
+                            struct dbnm_heap_node *keys[],
+                            unsigned int           nr,
+                            dbnm_heap_compare_fn  *compare)
+{
+	dbnm_heap_assert(heap);
+	karn_assert(keys || !nr);
+	karn_assert(compare);
+
+	unsigned int n;
+
+	/*
+	 * Prepend keys as singleton roots then join the whole root list at
+	 * once.
+	 */
+	for (n = 0; n < nr; n++)
+		dbnm_heap_insert_lazy(heap, keys[n]);
+
+	dbnm_heap_consolidate(heap, compare);
+}
+
+unsigned int dbnm_heap_extract_batch(struct dbnm_heap      *heap,
+                                     struct dbnm_heap_node *keys[],
+                                     unsigned int           nr,
+                                     dbnm_heap_compare_fn  *compare)
+{
+	dbnm_heap_assert(heap);
+	karn_assert(keys || !nr);
+	karn_assert(compare);
+
+	struct dbnm_heap_node *trees[DBNM_HEAP_ORDER_NR] = { NULL, };
+	unsigned int           top;
+	unsigned int           n;
+
+	if (nr > heap->dbnm_count)
+		nr = heap->dbnm_count;
+	if (!nr)
+		return 0;
+
+	/*
+	 * Keep trees into the order indexed array for the whole batch:
+	 * children of extracted roots are carried into it directly and the
+	 * root list is rebuilt once at the end only.
+	 */
+	top = dbnm_heap_spread_trees(&heap->dbnm_roots, trees, compare);
+
+	for (n = 0; n < nr; n++) {
+		struct dbnm_heap_node *key = NULL;
+		unsigned int           order;
+
+		for (order = 0; order <= top; order++) {
+			if (!trees[order])
+				continue;
+
+			if (!key || (compare(trees[order], key) < 0))
+				key = trees[order];
+		}
+
+		trees[key->dbnm_order] = NULL;
+
+		if (key->dbnm_child) {
+			struct dlist_node children;
+
+			dbnm_heap_reverse_children(&children, key->dbnm_child);
+			order = dbnm_heap_spread_trees(&children, trees,
+			                               compare);
+			top = umax(top, order);
+		}
+
+		keys[n] = key;
+	}
+
+	heap->dbnm_count -= nr;
+
+	dbnm_heap_gather_roots(heap, trees, top);
+
+	return nr;
+}
+
 void dbnm_heap_remove(struct dbnm_heap      *heap,
                       struct dbnm_heap_node *key,
                       dbnm_heap_compare_fn  *compare)
 {
+	dbnm_heap_consolidate(heap, compare);
+
 	while (key->dbnm_parent)
 		dbnm_heap_swap(key->dbnm_parent, key);
 
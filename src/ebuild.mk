@@ -4,20 +4,32 @@ libkarn.so-objs     = farr.o
 libkarn.so-objs    += $(call kconf_enabled,KARN_SLIST,slist.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_DLIST,dlist.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_FBNR_HEAP,fbnr_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_FDARY_HEAP,fdary_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_FKEY_HEAP,fkey_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_FIDX_HEAP,fidx_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_FMMX_HEAP,fmmx_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_FSHD_HEAP,fshd_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_RADIX_HEAP,radix_heap.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_LCRS,lcrs.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_SBNM_HEAP,sbnm_heap.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_DBNM_HEAP,dbnm_heap.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_SPAIR_HEAP,spair_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_RPAIR_HEAP,rpair_heap.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_RWK_HEAP,rwk_heap.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_FBMP,fbmp.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_FWK_HEAP,fwk_heap.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_PBNM_HEAP,pbnm_heap.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_FALLOC,falloc.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_FEYT_TREE,feyt_tree.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_AVL,avl.o)
 libkarn.so-objs    += $(call kconf_enabled,KARN_PAVL,pavl.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_LTREE,ltree.o)
+libkarn.so-objs    += $(call kconf_enabled,KARN_XSORT,xsort.o)
 
 libkarn.so-cflags  := -I$(SRCDIR)/../include \
                       $(EXTRA_CFLAGS) -Wall -Wextra -D_GNU_SOURCE -DPIC -fpic
 
 libkarn.so-ldflags := $(EXTRA_LDFLAGS) -shared -fpic -Wl,-soname,libkarn.so
 libkarn.so-ldflags += $(call kconf_enabled,KARN_BTRACE,-rdynamic)
+libkarn.so-ldflags += $(call kconf_enabled,KARN_FARR_PARALLEL_SORT,-pthread)
 libkarn.so-pkgconf  = libutils
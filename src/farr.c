@@ -6,7 +6,7 @@
 
 void farr_bubble_sort(char            *entries,
                       size_t           entry_size,
-                      unsigned int     entry_nr,
+                      size_t           entry_nr,
                       farr_compare_fn *compare,
                       farr_copy_fn    *copy)
 {
@@ -40,7 +40,7 @@ void farr_bubble_sort(char            *entries,
 
 void farr_selection_sort(char            *entries,
                          size_t           entry_size,
-                         unsigned int     entry_nr,
+                         size_t           entry_nr,
                          farr_compare_fn *compare,
                          farr_copy_fn    *copy)
 {
@@ -83,7 +83,8 @@ static void _farr_insertion_sort(char            *begin,
 
 		copy(tmp, unsort);
 
-		while ((ent >= begin) && (compare(tmp, ent) <= 0)) {
+		/* Stop at equal entries to keep sorting stable. */
+		while ((ent >= begin) && (compare(tmp, ent) < 0)) {
 			copy(ent + entry_size, ent);
 			ent -= entry_size;
 		}
@@ -96,7 +97,7 @@ static void _farr_insertion_sort(char            *begin,
 
 void farr_insertion_sort(char            *entries,
                          size_t           entry_size,
-                         unsigned int     entry_nr,
+                         size_t           entry_nr,
                          farr_compare_fn *compare,
                          farr_copy_fn    *copy)
 {
@@ -108,6 +109,38 @@ void farr_insertion_sort(char            *entries,
 
 #if defined(CONFIG_KARN_FARR_QUICK_SORT_UTILS)
 
+/*
+ * Hoare partitioning scheme around pivot, a copy of an entry found within
+ * [begin, end] range. Entries up to returned location compare lower than or
+ * equal to entries following it.
+ */
+static char * farr_quick_hoare_scan(char            *begin,
+                                    char            *end,
+                                    const char      *pivot,
+                                    size_t           entry_size,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	char tmp[entry_size];
+
+	begin -= entry_size;
+	end += entry_size;
+	while (true) {
+		do {
+			begin += entry_size;
+		} while (compare(pivot, begin) > 0);
+
+		do {
+			end -= entry_size;
+		} while (compare(end, pivot) > 0);
+
+		if (begin >= end)
+			return end;
+
+		farr_swap(begin, end, tmp, copy);
+	}
+}
+
 /*
  * TODO:
  *  - docs !! see https://stackoverflow.com/questions/6709055/quicksort-stack-size
@@ -136,22 +169,8 @@ static char * _farr_quick_hoare_part(char            *begin,
 
 	copy(pivot, mid);
 
-	begin -= entry_size;
-	end += entry_size;
-	while (true) {
-		do {
-			begin += entry_size;
-		} while (compare(pivot, begin) > 0);
-
-		do {
-			end -= entry_size;
-		} while (compare(end, pivot) > 0);
-
-		if (begin >= end)
-			return end;
-
-		farr_swap(begin, end, tmp, copy);
-	}
+	return farr_quick_hoare_scan(begin, end, pivot, entry_size, compare,
+	                             copy);
 }
 
 static char * farr_quick_hoare_part(char            *begin,
@@ -178,8 +197,10 @@ static char * farr_quick_hoare_part(char            *begin,
 
 static unsigned int farr_quick_stack_depth(size_t entry_nr)
 {
-	return pow2_upper(umax((entry_nr + FARR_QUICK_INSERT_THRESHOLD - 1) /
-	                       FARR_QUICK_INSERT_THRESHOLD, 2U));
+	size_t nr = (entry_nr + FARR_QUICK_INSERT_THRESHOLD - 1) /
+	            FARR_QUICK_INSERT_THRESHOLD;
+
+	return farr_log2_upper((nr > 2) ? nr : 2);
 }
 
 static bool farr_quick_switch_insert(const char *begin,
@@ -199,7 +220,7 @@ struct farr_quick_part {
 
 void farr_quick_sort(char            *entries,
                      size_t           entry_size,
-                     unsigned int     entry_nr,
+                     size_t           entry_nr,
                      farr_compare_fn *compare,
                      farr_copy_fn    *copy)
 {
@@ -262,8 +283,10 @@ void farr_quick_sort(char            *entries,
 
 static unsigned int farr_intro_stack_depth(size_t entry_nr)
 {
-	return pow2_upper(umax((entry_nr + FARR_INTRO_INSERT_THRESHOLD - 1) /
-	                       FARR_INTRO_INSERT_THRESHOLD, 2U));
+	size_t nr = (entry_nr + FARR_INTRO_INSERT_THRESHOLD - 1) /
+	            FARR_INTRO_INSERT_THRESHOLD;
+
+	return farr_log2_upper((nr > 2) ? nr : 2);
 }
 
 static unsigned int farr_intro_heap_threshold(size_t entry_nr)
@@ -289,7 +312,7 @@ struct farr_intro_part {
 
 void farr_intro_sort(char            *entries,
                      size_t           entry_size,
-                     unsigned int     entry_nr,
+                     size_t           entry_nr,
                      farr_compare_fn *compare,
                      farr_copy_fn    *copy)
 {
@@ -356,3 +379,3392 @@ void farr_intro_sort(char            *entries,
 }
 
 #endif /* defined(CONFIG_KARN_FARR_INTRO_SORT) */
+
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
+
+/*
+ * Pattern defeating quick sort, see "Pattern-defeating Quicksort" by Orson R.
+ * L. Peters.
+ *
+ * Unlike other sorting functions of this file, ranges are half-open, i.e. end
+ * points right after the last entry.
+ */
+
+#include <karn/fbnr_heap.h>
+
+/* Ranges smaller than this are insertion sorted. */
+#define FARR_PDQ_INSERT_THRESHOLD  (24U)
+/* Ranges larger than this use Tukey's ninther as pivot. */
+#define FARR_PDQ_NINTHER_THRESHOLD (128U)
+/* Maximum number of entries partial insertion sort is allowed to move. */
+#define FARR_PDQ_PARTIAL_LIMIT     (8U)
+
+static void farr_pdq_sort2(char            *first,
+                           char            *second,
+                           farr_compare_fn *compare,
+                           farr_copy_fn    *copy,
+                           char            *tmp)
+{
+	if (compare(second, first) < 0)
+		farr_swap(first, second, tmp, copy);
+}
+
+static void farr_pdq_sort3(char            *first,
+                           char            *second,
+                           char            *third,
+                           farr_compare_fn *compare,
+                           farr_copy_fn    *copy,
+                           char            *tmp)
+{
+	farr_pdq_sort2(first, second, compare, copy, tmp);
+	farr_pdq_sort2(second, third, compare, copy, tmp);
+	farr_pdq_sort2(first, second, compare, copy, tmp);
+}
+
+/*
+ * Insertion sort [begin, end[. When unguarded, entry right before begin must
+ * compare lower than or equal to all entries of the range.
+ */
+static void farr_pdq_insert(char            *begin,
+                            char            *end,
+                            size_t           entry_size,
+                            farr_compare_fn *compare,
+                            farr_copy_fn    *copy,
+                            bool             guarded)
+{
+	char  tmp[entry_size];
+	char *cur;
+
+	for (cur = begin + entry_size; cur < end; cur += entry_size) {
+		char *sift = cur;
+
+		if (compare(cur, cur - entry_size) >= 0)
+			continue;
+
+		copy(tmp, cur);
+		do {
+			copy(sift, sift - entry_size);
+			sift -= entry_size;
+		} while ((!guarded || (sift != begin)) &&
+		         (compare(tmp, sift - entry_size) < 0));
+		copy(sift, tmp);
+	}
+}
+
+/*
+ * Attempt to insertion sort [begin, end[ and give up as soon as more than
+ * FARR_PDQ_PARTIAL_LIMIT entries have been moved. Return true if range could
+ * be fully sorted.
+ */
+static bool farr_pdq_partial_insert(char            *begin,
+                                    char            *end,
+                                    size_t           entry_size,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	char          tmp[entry_size];
+	char         *cur;
+	unsigned int  moved = 0;
+
+	if (begin == end)
+		return true;
+
+	for (cur = begin + entry_size; cur < end; cur += entry_size) {
+		char *sift = cur;
+
+		if (compare(cur, cur - entry_size) >= 0)
+			continue;
+
+		copy(tmp, cur);
+		do {
+			copy(sift, sift - entry_size);
+			sift -= entry_size;
+		} while ((sift != begin) &&
+		         (compare(tmp, sift - entry_size) < 0));
+		copy(sift, tmp);
+
+		moved += (unsigned int)((cur - sift) / entry_size);
+		if (moved > FARR_PDQ_PARTIAL_LIMIT)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Partition [begin, end[ around pivot located at begin so that entries lower
+ * than pivot end up on its left and entries greater than or equal to it on
+ * its right.
+ *
+ * Return pivot final location and set *partitioned to true when no entries
+ * had to be swapped.
+ *
+ * Note that block partitioning is not used here: since comparison is performed
+ * through an opaque function pointer, its branches cannot be removed and
+ * collecting offsets only adds extra copies. See farr_tmpl.h for a block
+ * partitioning implementation with inlined comparisons.
+ */
+static char * farr_pdq_right_part(char            *begin,
+                                  char            *end,
+                                  size_t           entry_size,
+                                  farr_compare_fn *compare,
+                                  farr_copy_fn    *copy,
+                                  bool            *partitioned)
+{
+	char  tmp[entry_size];
+	char  pivot[entry_size];
+	char *first = begin;
+	char *last = end;
+
+	copy(pivot, begin);
+
+	/* Median of 3 guarantees an entry >= pivot exists. */
+	do {
+		first += entry_size;
+	} while (compare(first, pivot) < 0);
+
+	/* Guard search if no entry lower than pivot was found before first. */
+	if ((first - entry_size) == begin) {
+		while (first < last) {
+			last -= entry_size;
+			if (compare(last, pivot) < 0)
+				break;
+		}
+	}
+	else {
+		do {
+			last -= entry_size;
+		} while (compare(last, pivot) >= 0);
+	}
+
+	*partitioned = (first >= last);
+
+	while (first < last) {
+		farr_swap(first, last, tmp, copy);
+
+		do {
+			first += entry_size;
+		} while (compare(first, pivot) < 0);
+
+		do {
+			last -= entry_size;
+		} while (compare(last, pivot) >= 0);
+	}
+
+	first -= entry_size;
+	copy(begin, first);
+	copy(first, pivot);
+
+	return first;
+}
+
+/*
+ * Partition [begin, end[ around pivot located at begin so that entries equal
+ * to pivot are put on its left and entries greater than it on its right. Used
+ * when pivot is known to be equal to the entry right before begin, i.e. when
+ * range contains lots of duplicates.
+ */
+static char * farr_pdq_equal_part(char            *begin,
+                                  char            *end,
+                                  size_t           entry_size,
+                                  farr_compare_fn *compare,
+                                  farr_copy_fn    *copy)
+{
+	char  tmp[entry_size];
+	char  pivot[entry_size];
+	char *first = begin;
+	char *last = end;
+
+	copy(pivot, begin);
+
+	do {
+		last -= entry_size;
+	} while (compare(pivot, last) < 0);
+
+	if ((last + entry_size) == end) {
+		while (first < last) {
+			first += entry_size;
+			if (compare(pivot, first) < 0)
+				break;
+		}
+	}
+	else {
+		do {
+			first += entry_size;
+		} while (compare(pivot, first) >= 0);
+	}
+
+	while (first < last) {
+		farr_swap(first, last, tmp, copy);
+
+		do {
+			last -= entry_size;
+		} while (compare(pivot, last) < 0);
+
+		do {
+			first += entry_size;
+		} while (compare(pivot, first) >= 0);
+	}
+
+	copy(begin, last);
+	copy(last, pivot);
+
+	return last;
+}
+
+/*
+ * Break patterns by swapping a few entries of an unbalanced partition with
+ * entries located at its quarters.
+ */
+static void farr_pdq_shuffle(char            *begin,
+                             char            *end,
+                             size_t           entry_size,
+                             farr_copy_fn    *copy)
+{
+	char   tmp[entry_size];
+	size_t nr = (size_t)(end - begin) / entry_size;
+	size_t quarter = (nr / 4) * entry_size;
+
+	if (nr < FARR_PDQ_INSERT_THRESHOLD)
+		return;
+
+	farr_swap(begin, begin + quarter, tmp, copy);
+	farr_swap(end - entry_size, end - quarter, tmp, copy);
+
+	if (nr > FARR_PDQ_NINTHER_THRESHOLD) {
+		farr_swap(begin + entry_size, begin + quarter + entry_size,
+		          tmp, copy);
+		farr_swap(begin + (2 * entry_size),
+		          begin + quarter + (2 * entry_size),
+		          tmp,
+		          copy);
+		farr_swap(end - (2 * entry_size),
+		          end - quarter - entry_size,
+		          tmp,
+		          copy);
+		farr_swap(end - (3 * entry_size),
+		          end - quarter - (2 * entry_size),
+		          tmp,
+		          copy);
+	}
+}
+
+/*
+ * Move pivot to begin: median of 3 for small ranges, Tukey's ninther for large
+ * ones.
+ */
+static void farr_pdq_select_pivot(char            *begin,
+                                  char            *end,
+                                  size_t           entry_size,
+                                  farr_compare_fn *compare,
+                                  farr_copy_fn    *copy)
+{
+	char    tmp[entry_size];
+	size_t  nr = (size_t)(end - begin) / entry_size;
+	char   *mid = begin + ((nr / 2) * entry_size);
+	char   *last = end - entry_size;
+
+	if (nr > FARR_PDQ_NINTHER_THRESHOLD) {
+		farr_pdq_sort3(begin, mid, last, compare, copy, tmp);
+		farr_pdq_sort3(begin + entry_size, mid - entry_size,
+		               last - entry_size, compare, copy, tmp);
+		farr_pdq_sort3(begin + (2 * entry_size), mid + entry_size,
+		               last - (2 * entry_size), compare, copy, tmp);
+		farr_pdq_sort3(mid - entry_size, mid, mid + entry_size,
+		               compare, copy, tmp);
+		farr_swap(begin, mid, tmp, copy);
+	}
+	else
+		farr_pdq_sort3(mid, begin, last, compare, copy, tmp);
+}
+
+/*
+ * Return true when [begin, end[ is sorted, reversing it beforehand if it is
+ * strictly descending. Scanning stops at the first entry breaking the run so
+ * that cost is negligible for inputs that do not qualify.
+ */
+static bool farr_pdq_presorted(char            *begin,
+                               char            *end,
+                               size_t           entry_size,
+                               farr_compare_fn *compare,
+                               farr_copy_fn    *copy)
+{
+	char  tmp[entry_size];
+	char *cur = begin + entry_size;
+
+	if (compare(cur, begin) >= 0) {
+		while ((cur += entry_size) < end)
+			if (compare(cur, cur - entry_size) < 0)
+				return false;
+
+		return true;
+	}
+
+	while ((cur += entry_size) < end)
+		if (compare(cur, cur - entry_size) >= 0)
+			return false;
+
+	for (end -= entry_size; begin < end;
+	     begin += entry_size, end -= entry_size)
+		farr_swap(begin, end, tmp, copy);
+
+	return true;
+}
+
+struct farr_pdq_part {
+	char         *pdq_begin;
+	char         *pdq_end;
+	unsigned int  pdq_bad;
+	bool          pdq_leftmost;
+};
+
+void farr_pdq_sort(char            *entries,
+                   size_t           entry_size,
+                   size_t           entry_nr,
+                   farr_compare_fn *compare,
+                   farr_copy_fn    *copy)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	char                 *begin = entries;
+	char                 *end = &entries[entry_nr * entry_size];
+	unsigned int          bad = farr_log2_lower(entry_nr);
+	bool                  leftmost = true;
+	unsigned int          ptop = 0;
+	/* Smaller partition is processed first, larger one is stacked. */
+	struct farr_pdq_part  parts[farr_log2_upper((entry_nr > 2) ? entry_nr :
+	                                                             2) + 1];
+
+	if ((entry_nr >= FARR_PDQ_INSERT_THRESHOLD) &&
+	    farr_pdq_presorted(begin, end, entry_size, compare, copy))
+		return;
+
+	while (true) {
+		size_t  nr = (size_t)(end - begin) / entry_size;
+		char   *pivot;
+		char   *high;
+		size_t  left_nr;
+		size_t  right_nr;
+		bool    partitioned;
+
+		if (nr < FARR_PDQ_INSERT_THRESHOLD) {
+			if (nr > 1)
+				farr_pdq_insert(begin, end, entry_size, compare,
+				                copy, leftmost);
+			goto pop;
+		}
+
+		farr_pdq_select_pivot(begin, end, entry_size, compare, copy);
+
+		/*
+		 * If pivot equals entry preceding range, i.e. the pivot of a
+		 * previous partitioning, there is no entry lower than pivot:
+		 * gather all entries equal to pivot at once and skip them.
+		 */
+		if (!leftmost && (compare(begin - entry_size, begin) >= 0)) {
+			begin = farr_pdq_equal_part(begin, end, entry_size,
+			                            compare, copy) + entry_size;
+			continue;
+		}
+
+		pivot = farr_pdq_right_part(begin, end, entry_size, compare,
+		                            copy, &partitioned);
+		high = pivot + entry_size;
+		left_nr = (size_t)(pivot - begin) / entry_size;
+		right_nr = (size_t)(end - high) / entry_size;
+
+		if ((left_nr < (nr / 8)) || (right_nr < (nr / 8))) {
+			if (!--bad) {
+				fbnr_heap_sort(begin, entry_size, nr, compare,
+				               copy);
+				goto pop;
+			}
+
+			farr_pdq_shuffle(begin, pivot, entry_size, copy);
+			farr_pdq_shuffle(high, end, entry_size, copy);
+		}
+		else if (partitioned &&
+		         farr_pdq_partial_insert(begin, pivot, entry_size,
+		                                 compare, copy) &&
+		         farr_pdq_partial_insert(high, end, entry_size,
+		                                 compare, copy))
+			goto pop;
+
+		karn_assert(ptop < array_nr(parts));
+		if (left_nr >= right_nr) {
+			parts[ptop].pdq_begin = begin;
+			parts[ptop].pdq_end = pivot;
+			parts[ptop].pdq_leftmost = leftmost;
+			begin = high;
+			leftmost = false;
+		}
+		else {
+			parts[ptop].pdq_begin = high;
+			parts[ptop].pdq_end = end;
+			parts[ptop].pdq_leftmost = false;
+			end = pivot;
+		}
+		parts[ptop].pdq_bad = bad;
+
+		ptop++;
+
+		continue;
+
+pop:
+		if (!ptop--)
+			return;
+
+		begin = parts[ptop].pdq_begin;
+		end = parts[ptop].pdq_end;
+		bad = parts[ptop].pdq_bad;
+		leftmost = parts[ptop].pdq_leftmost;
+	}
+}
+
+#endif /* defined(CONFIG_KARN_FARR_PDQ_SORT) */
+
+#if defined(CONFIG_KARN_FARR_TIM_SORT)
+
+/*
+ * Stable natural merge sort, see Tim Peters's listsort.txt and "On the Worst-
+ * Case Complexity of TimSort" by Auger, Jugé, Nicaud and Pivoteau for the
+ * merge collapsing invariants.
+ */
+
+#include <errno.h>
+
+/* Arrays smaller than this are sorted using binary insertion only. */
+#define FARR_TIM_MIN_MERGE   (64U)
+/* Initial number of consecutive wins before switching to galloping mode. */
+#define FARR_TIM_MIN_GALLOP  (7U)
+/* Enough to hold pending runs of an array with up to SIZE_MAX entries. */
+#define FARR_TIM_STACK_DEPTH (85U)
+
+struct farr_tim_run {
+	char   *tim_base;
+	size_t  tim_nr;
+};
+
+struct farr_tim {
+	size_t               tim_size;
+	farr_compare_fn     *tim_compare;
+	farr_copy_fn        *tim_copy;
+	unsigned int         tim_gallop;
+	char                *tim_buff;
+	size_t               tim_buff_nr;
+	size_t               tim_buff_max;
+	unsigned int         tim_run_nr;
+	struct farr_tim_run  tim_runs[FARR_TIM_STACK_DEPTH];
+};
+
+#define farr_tim_entry(_tim, _base, _index) \
+	(&(_base)[(ssize_t)(_index) * (ssize_t)(_tim)->tim_size])
+
+static bool farr_tim_lower(const struct farr_tim *tim,
+                           const char            *first,
+                           const char            *second)
+{
+	return tim->tim_compare(first, second) < 0;
+}
+
+/* Copy nr entries from src to dst, forward, i.e. dst may overlap src end. */
+static void farr_tim_copy_fwd(const struct farr_tim *tim,
+                              char                  *dst,
+                              const char            *src,
+                              size_t                 nr)
+{
+	while (nr--) {
+		tim->tim_copy(dst, src);
+		dst += tim->tim_size;
+		src += tim->tim_size;
+	}
+}
+
+/* Copy nr entries from src to dst, backward, i.e. dst may overlap src start. */
+static void farr_tim_copy_bwd(const struct farr_tim *tim,
+                              char                  *dst,
+                              const char            *src,
+                              size_t                 nr)
+{
+	dst = farr_tim_entry(tim, dst, nr);
+	src = farr_tim_entry(tim, src, nr);
+
+	while (nr--) {
+		dst -= tim->tim_size;
+		src -= tim->tim_size;
+		tim->tim_copy(dst, src);
+	}
+}
+
+/*
+ * Compute minimum run length so that number of runs is a power of 2 or
+ * slightly lower, i.e. merges remain balanced.
+ */
+static unsigned int farr_tim_minrun(size_t entry_nr)
+{
+	unsigned int bit = 0;
+
+	while (entry_nr >= FARR_TIM_MIN_MERGE) {
+		bit |= (unsigned int)(entry_nr & 1);
+		entry_nr >>= 1;
+	}
+
+	return (unsigned int)entry_nr + bit;
+}
+
+/*
+ * Return length of run starting at base: either non-descending or strictly
+ * descending, in which case it is reversed in place. Strictness preserves
+ * stability.
+ */
+static size_t farr_tim_count_run(const struct farr_tim *tim,
+                                 char                  *base,
+                                 size_t                 nr)
+{
+	size_t  run = 2;
+	char   *cur;
+
+	if (nr < 2)
+		return nr;
+
+	cur = farr_tim_entry(tim, base, 1);
+	if (farr_tim_lower(tim, cur, base)) {
+		char  tmp[tim->tim_size];
+		char *end;
+
+		for (cur += tim->tim_size; run < nr; cur += tim->tim_size) {
+			if (!farr_tim_lower(tim, cur, cur - tim->tim_size))
+				break;
+			run++;
+		}
+
+		for (end = farr_tim_entry(tim, base, run - 1);
+		     base < end;
+		     base += tim->tim_size, end -= tim->tim_size)
+			farr_swap(base, end, tmp, tim->tim_copy);
+
+		return run;
+	}
+
+	for (cur += tim->tim_size; run < nr; cur += tim->tim_size) {
+		if (farr_tim_lower(tim, cur, cur - tim->tim_size))
+			break;
+		run++;
+	}
+
+	return run;
+}
+
+/*
+ * Sort the nr entries located at base knowing that the first sorted_nr ones
+ * are already sorted. Insertion points are located using binary search, right
+ * after equal entries so that sorting is stable.
+ */
+static void farr_tim_binary_insert(const struct farr_tim *tim,
+                                   char                  *base,
+                                   size_t                 nr,
+                                   size_t                 sorted_nr)
+{
+	char   pivot[tim->tim_size];
+	size_t start;
+
+	for (start = sorted_nr ? sorted_nr : 1; start < nr; start++) {
+		char   *cur = farr_tim_entry(tim, base, start);
+		size_t  low = 0;
+		size_t  high = start;
+
+		while (low < high) {
+			size_t mid = low + ((high - low) / 2);
+
+			if (farr_tim_lower(tim, cur,
+			                   farr_tim_entry(tim, base, mid)))
+				high = mid;
+			else
+				low = mid + 1;
+		}
+
+		if (low == start)
+			continue;
+
+		tim->tim_copy(pivot, cur);
+		farr_tim_copy_bwd(tim, farr_tim_entry(tim, base, low + 1),
+		                  farr_tim_entry(tim, base, low), start - low);
+		tim->tim_copy(farr_tim_entry(tim, base, low), pivot);
+	}
+}
+
+/*
+ * Locate position where key should be inserted into the sorted nr entries at
+ * base, i.e. k such that base[k - 1] < key <= base[k]. Search starts at hint
+ * then gallops by exponentially growing steps before binary searching the
+ * final range.
+ */
+static size_t farr_tim_gallop_left(const struct farr_tim *tim,
+                                   const char            *key,
+                                   const char            *base,
+                                   size_t                 nr,
+                                   size_t                 hint)
+{
+	ssize_t last = 0;
+	ssize_t ofs = 1;
+	ssize_t max;
+
+	if (farr_tim_lower(tim, farr_tim_entry(tim, base, hint), key)) {
+		/* base[hint] < key: gallop right. */
+		max = (ssize_t)(nr - hint);
+		while ((ofs < max) &&
+		       farr_tim_lower(tim,
+		                      farr_tim_entry(tim, base, hint + ofs),
+		                      key)) {
+			last = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		ofs = (ofs > max) ? max : ofs;
+
+		last += hint;
+		ofs += hint;
+	}
+	else {
+		/* key <= base[hint]: gallop left. */
+		ssize_t tmp;
+
+		max = (ssize_t)hint + 1;
+		while ((ofs < max) &&
+		       !farr_tim_lower(tim,
+		                       farr_tim_entry(tim, base, hint - ofs),
+		                       key)) {
+			last = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		ofs = (ofs > max) ? max : ofs;
+
+		tmp = last;
+		last = (ssize_t)hint - ofs;
+		ofs = (ssize_t)hint - tmp;
+	}
+
+	/* Now base[last] < key <= base[ofs]: binary search in between. */
+	last++;
+	while (last < ofs) {
+		ssize_t mid = last + ((ofs - last) / 2);
+
+		if (farr_tim_lower(tim, farr_tim_entry(tim, base, mid), key))
+			last = mid + 1;
+		else
+			ofs = mid;
+	}
+
+	return (size_t)ofs;
+}
+
+/*
+ * Same as farr_tim_gallop_left() except that returned position is located
+ * after entries equal to key, i.e. k such that base[k - 1] <= key < base[k].
+ */
+static size_t farr_tim_gallop_right(const struct farr_tim *tim,
+                                    const char            *key,
+                                    const char            *base,
+                                    size_t                 nr,
+                                    size_t                 hint)
+{
+	ssize_t last = 0;
+	ssize_t ofs = 1;
+	ssize_t max;
+
+	if (farr_tim_lower(tim, key, farr_tim_entry(tim, base, hint))) {
+		/* key < base[hint]: gallop left. */
+		ssize_t tmp;
+
+		max = (ssize_t)hint + 1;
+		while ((ofs < max) &&
+		       farr_tim_lower(tim,
+		                      key,
+		                      farr_tim_entry(tim, base, hint - ofs))) {
+			last = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		ofs = (ofs > max) ? max : ofs;
+
+		tmp = last;
+		last = (ssize_t)hint - ofs;
+		ofs = (ssize_t)hint - tmp;
+	}
+	else {
+		/* base[hint] <= key: gallop right. */
+		max = (ssize_t)(nr - hint);
+		while ((ofs < max) &&
+		       !farr_tim_lower(tim,
+		                       key,
+		                       farr_tim_entry(tim, base, hint + ofs))) {
+			last = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		ofs = (ofs > max) ? max : ofs;
+
+		last += hint;
+		ofs += hint;
+	}
+
+	/* Now base[last] <= key < base[ofs]: binary search in between. */
+	last++;
+	while (last < ofs) {
+		ssize_t mid = last + ((ofs - last) / 2);
+
+		if (farr_tim_lower(tim, key, farr_tim_entry(tim, base, mid)))
+			ofs = mid;
+		else
+			last = mid + 1;
+	}
+
+	return (size_t)ofs;
+}
+
+/*
+ * Ensure auxiliary buffer may hold nr entries. Since the smallest of both runs
+ * is always the one copied, buffer never exceeds half the array size.
+ */
+static int farr_tim_reserve(struct farr_tim *tim, size_t nr)
+{
+	char *buff;
+
+	if (nr <= tim->tim_buff_nr)
+		return 0;
+
+	/* Grow geometrically but never beyond half the array size. */
+	if (nr < (2 * tim->tim_buff_nr))
+		nr = 2 * tim->tim_buff_nr;
+	if (nr > tim->tim_buff_max)
+		nr = tim->tim_buff_max;
+	buff = malloc(nr * tim->tim_size);
+	if (!buff)
+		return -ENOMEM;
+
+	free(tim->tim_buff);
+	tim->tim_buff = buff;
+	tim->tim_buff_nr = nr;
+
+	return 0;
+}
+
+/*
+ * Merge adjacent runs a and b in place, a_nr <= b_nr, from left to right.
+ * Precondition: b[0] < a[0] and a[a_nr - 1] > b[b_nr - 1], as established by
+ * farr_tim_merge_at().
+ */
+static int farr_tim_merge_lo(struct farr_tim *tim,
+                             char            *a,
+                             size_t           a_nr,
+                             char            *b,
+                             size_t           b_nr)
+{
+	size_t        sz = tim->tim_size;
+	unsigned int  gallop = tim->tim_gallop;
+	char         *dst = a;
+	char         *pa;
+	char         *pb = b;
+	int           err;
+
+	err = farr_tim_reserve(tim, a_nr);
+	if (err)
+		return err;
+
+	pa = tim->tim_buff;
+	farr_tim_copy_fwd(tim, pa, a, a_nr);
+
+	tim->tim_copy(dst, pb);
+	dst += sz;
+	pb += sz;
+	if (!--b_nr)
+		goto done;
+	if (a_nr == 1)
+		goto copy_b;
+
+	while (true) {
+		size_t a_cnt = 0;
+		size_t b_cnt = 0;
+
+		/* One entry at a time until a run wins consistently. */
+		do {
+			if (farr_tim_lower(tim, pb, pa)) {
+				tim->tim_copy(dst, pb);
+				dst += sz;
+				pb += sz;
+				b_cnt++;
+				a_cnt = 0;
+				if (!--b_nr)
+					goto done;
+			}
+			else {
+				tim->tim_copy(dst, pa);
+				dst += sz;
+				pa += sz;
+				a_cnt++;
+				b_cnt = 0;
+				if (--a_nr == 1)
+					goto copy_b;
+			}
+		} while ((a_cnt | b_cnt) < gallop);
+
+		/* Gallop until neither run wins long enough. */
+		gallop++;
+		do {
+			size_t k;
+
+			gallop -= (gallop > 1);
+
+			k = farr_tim_gallop_right(tim, pb, pa, a_nr, 0);
+			a_cnt = k;
+			if (k) {
+				farr_tim_copy_fwd(tim, dst, pa, k);
+				dst = farr_tim_entry(tim, dst, k);
+				pa = farr_tim_entry(tim, pa, k);
+				a_nr -= k;
+				if (a_nr == 1)
+					goto copy_b;
+				/* Inconsistent comparison only. */
+				if (!a_nr)
+					goto done;
+			}
+			tim->tim_copy(dst, pb);
+			dst += sz;
+			pb += sz;
+			if (!--b_nr)
+				goto done;
+
+			k = farr_tim_gallop_left(tim, pa, pb, b_nr, 0);
+			b_cnt = k;
+			if (k) {
+				farr_tim_copy_fwd(tim, dst, pb, k);
+				dst = farr_tim_entry(tim, dst, k);
+				pb = farr_tim_entry(tim, pb, k);
+				b_nr -= k;
+				if (!b_nr)
+					goto done;
+			}
+			tim->tim_copy(dst, pa);
+			dst += sz;
+			pa += sz;
+			if (--a_nr == 1)
+				goto copy_b;
+		} while ((a_cnt >= FARR_TIM_MIN_GALLOP) ||
+		         (b_cnt >= FARR_TIM_MIN_GALLOP));
+
+		/* Penalize leaving galloping mode. */
+		gallop++;
+	}
+
+done:
+	farr_tim_copy_fwd(tim, dst, pa, a_nr);
+	tim->tim_gallop = umax(gallop, 1U);
+
+	return 0;
+
+copy_b:
+	/* Last entry of a belongs at the end of the merge. */
+	farr_tim_copy_fwd(tim, dst, pb, b_nr);
+	tim->tim_copy(farr_tim_entry(tim, dst, b_nr), pa);
+	tim->tim_gallop = umax(gallop, 1U);
+
+	return 0;
+}
+
+/*
+ * Merge adjacent runs a and b in place, a_nr >= b_nr, from right to left.
+ * Same preconditions as farr_tim_merge_lo().
+ */
+static int farr_tim_merge_hi(struct farr_tim *tim,
+                             char            *a,
+                             size_t           a_nr,
+                             char            *b,
+                             size_t           b_nr)
+{
+	size_t        sz = tim->tim_size;
+	unsigned int  gallop = tim->tim_gallop;
+	char         *dst = farr_tim_entry(tim, b, b_nr - 1);
+	char         *pa = farr_tim_entry(tim, a, a_nr - 1);
+	char         *pb;
+	char         *base;
+	int           err;
+
+	err = farr_tim_reserve(tim, b_nr);
+	if (err)
+		return err;
+
+	base = tim->tim_buff;
+	farr_tim_copy_fwd(tim, base, b, b_nr);
+	pb = farr_tim_entry(tim, base, b_nr - 1);
+
+	tim->tim_copy(dst, pa);
+	dst -= sz;
+	pa -= sz;
+	if (!--a_nr)
+		goto done;
+	if (b_nr == 1)
+		goto copy_a;
+
+	while (true) {
+		size_t a_cnt = 0;
+		size_t b_cnt = 0;
+
+		do {
+			if (farr_tim_lower(tim, pb, pa)) {
+				tim->tim_copy(dst, pa);
+				dst -= sz;
+				pa -= sz;
+				a_cnt++;
+				b_cnt = 0;
+				if (!--a_nr)
+					goto done;
+			}
+			else {
+				tim->tim_copy(dst, pb);
+				dst -= sz;
+				pb -= sz;
+				b_cnt++;
+				a_cnt = 0;
+				if (--b_nr == 1)
+					goto copy_a;
+			}
+		} while ((a_cnt | b_cnt) < gallop);
+
+		gallop++;
+		do {
+			size_t k;
+
+			gallop -= (gallop > 1);
+
+			k = a_nr - farr_tim_gallop_right(tim, pb, a, a_nr,
+			                                 a_nr - 1);
+			a_cnt = k;
+			if (k) {
+				dst = farr_tim_entry(tim, dst, -(ssize_t)k);
+				pa = farr_tim_entry(tim, pa, -(ssize_t)k);
+				farr_tim_copy_bwd(tim, dst + sz, pa + sz, k);
+				a_nr -= k;
+				if (!a_nr)
+					goto done;
+			}
+			tim->tim_copy(dst, pb);
+			dst -= sz;
+			pb -= sz;
+			if (--b_nr == 1)
+				goto copy_a;
+
+			k = b_nr - farr_tim_gallop_left(tim, pa, base, b_nr,
+			                                b_nr - 1);
+			b_cnt = k;
+			if (k) {
+				dst = farr_tim_entry(tim, dst, -(ssize_t)k);
+				pb = farr_tim_entry(tim, pb, -(ssize_t)k);
+				farr_tim_copy_fwd(tim, dst + sz, pb + sz, k);
+				b_nr -= k;
+				if (b_nr == 1)
+					goto copy_a;
+				/* Inconsistent comparison only. */
+				if (!b_nr)
+					goto done;
+			}
+			tim->tim_copy(dst, pa);
+			dst -= sz;
+			pa -= sz;
+			if (!--a_nr)
+				goto done;
+		} while ((a_cnt >= FARR_TIM_MIN_GALLOP) ||
+		         (b_cnt >= FARR_TIM_MIN_GALLOP));
+
+		gallop++;
+	}
+
+done:
+	farr_tim_copy_fwd(tim, farr_tim_entry(tim, dst, 1 - (ssize_t)b_nr),
+	                  base, b_nr);
+	tim->tim_gallop = umax(gallop, 1U);
+
+	return 0;
+
+copy_a:
+	/* First entry of b belongs at the start of the merge. */
+	dst = farr_tim_entry(tim, dst, -(ssize_t)a_nr);
+	pa = farr_tim_entry(tim, pa, -(ssize_t)a_nr);
+	farr_tim_copy_bwd(tim, dst + sz, pa + sz, a_nr);
+	tim->tim_copy(dst, pb);
+	tim->tim_gallop = umax(gallop, 1U);
+
+	return 0;
+}
+
+/* Merge pending runs at index run and run + 1. */
+static int farr_tim_merge_at(struct farr_tim *tim, unsigned int run)
+{
+	struct farr_tim_run *runs = tim->tim_runs;
+	char                *a = runs[run].tim_base;
+	size_t               a_nr = runs[run].tim_nr;
+	char                *b = runs[run + 1].tim_base;
+	size_t               b_nr = runs[run + 1].tim_nr;
+	size_t               k;
+
+	runs[run].tim_nr = a_nr + b_nr;
+	if (run == (tim->tim_run_nr - 3))
+		runs[run + 1] = runs[run + 2];
+	tim->tim_run_nr--;
+
+	/* Entries of a lower than or equal to b[0] are already in place. */
+	k = farr_tim_gallop_right(tim, b, a, a_nr, 0);
+	a = farr_tim_entry(tim, a, k);
+	a_nr -= k;
+	if (!a_nr)
+		return 0;
+
+	/* Entries of b greater than or equal to a's last are in place too. */
+	b_nr = farr_tim_gallop_left(tim, farr_tim_entry(tim, a, a_nr - 1), b,
+	                            b_nr, b_nr - 1);
+	if (!b_nr)
+		return 0;
+
+	if (a_nr <= b_nr)
+		return farr_tim_merge_lo(tim, a, a_nr, b, b_nr);
+	else
+		return farr_tim_merge_hi(tim, a, a_nr, b, b_nr);
+}
+
+/* Merge pending runs until stack invariants are restored. */
+static int farr_tim_collapse(struct farr_tim *tim)
+{
+	const struct farr_tim_run *runs = tim->tim_runs;
+
+	while (tim->tim_run_nr > 1) {
+		unsigned int run = tim->tim_run_nr - 2;
+		int          err;
+
+		if (((run > 0) &&
+		     (runs[run - 1].tim_nr <=
+		      (runs[run].tim_nr + runs[run + 1].tim_nr))) ||
+		    ((run > 1) &&
+		     (runs[run - 2].tim_nr <=
+		      (runs[run - 1].tim_nr + runs[run].tim_nr)))) {
+			if (runs[run - 1].tim_nr < runs[run + 1].tim_nr)
+				run--;
+		}
+		else if (runs[run].tim_nr > runs[run + 1].tim_nr)
+			break;
+
+		err = farr_tim_merge_at(tim, run);
+		if (err)
+			return err;
+	}
+
+	return 0;
+}
+
+/* Merge all pending runs. */
+static int farr_tim_force_collapse(struct farr_tim *tim)
+{
+	const struct farr_tim_run *runs = tim->tim_runs;
+
+	while (tim->tim_run_nr > 1) {
+		unsigned int run = tim->tim_run_nr - 2;
+		int          err;
+
+		if ((run > 0) && (runs[run - 1].tim_nr < runs[run + 1].tim_nr))
+			run--;
+
+		err = farr_tim_merge_at(tim, run);
+		if (err)
+			return err;
+	}
+
+	return 0;
+}
+
+int farr_tim_sort(char            *entries,
+                  size_t           entry_size,
+                  size_t           entry_nr,
+                  farr_compare_fn *compare,
+                  farr_copy_fn    *copy)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	struct farr_tim  tim = {
+		.tim_size     = entry_size,
+		.tim_compare  = compare,
+		.tim_copy     = copy,
+		.tim_gallop   = FARR_TIM_MIN_GALLOP,
+		.tim_buff     = NULL,
+		.tim_buff_nr  = 0,
+		.tim_buff_max = entry_nr / 2,
+		.tim_run_nr   = 0
+	};
+	unsigned int     minrun = farr_tim_minrun(entry_nr);
+	char            *base = entries;
+	size_t           remain = entry_nr;
+	int              err;
+
+	do {
+		size_t run;
+
+		run = farr_tim_count_run(&tim, base, remain);
+		if (run < minrun) {
+			size_t force = (remain < minrun) ? remain : minrun;
+
+			farr_tim_binary_insert(&tim, base, force, run);
+			run = force;
+		}
+
+		karn_assert(tim.tim_run_nr < array_nr(tim.tim_runs));
+		tim.tim_runs[tim.tim_run_nr].tim_base = base;
+		tim.tim_runs[tim.tim_run_nr].tim_nr = run;
+		tim.tim_run_nr++;
+
+		err = farr_tim_collapse(&tim);
+		if (err)
+			goto free;
+
+		base = farr_tim_entry(&tim, base, run);
+		remain -= run;
+	} while (remain);
+
+	err = farr_tim_force_collapse(&tim);
+
+free:
+	free(tim.tim_buff);
+
+	return err;
+}
+
+#endif /* defined(CONFIG_KARN_FARR_TIM_SORT) */
+
+#if defined(CONFIG_KARN_FARR_INDIRECT_SORT)
+
+#include <errno.h>
+
+/*
+ * Indirect sorting slot: a pointer to the entry it stands for and a cached key
+ * prefix.
+ */
+struct farr_indirect_slot {
+	uint64_t    ind_prefix;
+	const char *ind_entry;
+};
+
+/*
+ * farr_compare_fn carries no context: pass the entry comparison function to
+ * the slot sorting template through a thread local variable.
+ */
+static __thread farr_compare_fn *farr_indirect_compare_fn;
+
+static inline int
+farr_indirect_compare(const struct farr_indirect_slot *first,
+                      const struct farr_indirect_slot *second)
+{
+	if (first->ind_prefix != second->ind_prefix)
+		return (first->ind_prefix < second->ind_prefix) ? -1 : 1;
+
+	return farr_indirect_compare_fn(first->ind_entry, second->ind_entry);
+}
+
+#define FARR_TMPL_NAME            indirect
+#define FARR_TMPL_TYPE            struct farr_indirect_slot
+#define FARR_TMPL_COMPARE(_a, _b) farr_indirect_compare(_a, _b)
+#include <karn/farr_tmpl.h>
+
+/*
+ * Sort slots then turn them into a compact permutation stored in place of
+ * slots: entry i of permutation holds index of entry that should be moved to
+ * position i.
+ */
+static size_t *
+farr_indirect_build(const char      *entries,
+                    size_t           entry_size,
+                    size_t           entry_nr,
+                    farr_compare_fn *compare,
+                    farr_prefix_fn  *prefix)
+{
+	struct farr_indirect_slot *slots;
+	size_t                    *perm;
+	size_t                     s;
+
+	slots = malloc(entry_nr * sizeof(*slots));
+	if (!slots)
+		return NULL;
+
+	for (s = 0; s < entry_nr; s++) {
+		const char *ent = &entries[s * entry_size];
+
+		slots[s].ind_prefix = prefix ? prefix(ent) : 0;
+		slots[s].ind_entry = ent;
+	}
+
+	farr_indirect_compare_fn = compare;
+	farr_indirect_pdq_sort(slots, entry_nr);
+
+	/*
+	 * Permutation entries are smaller than slots: slot s is always read
+	 * before being overwritten.
+	 */
+	perm = (size_t *)slots;
+	for (s = 0; s < entry_nr; s++) {
+		size_t off = (size_t)(slots[s].ind_entry - entries);
+
+		perm[s] = off / entry_size;
+	}
+
+	return perm;
+}
+
+static void farr_indirect_move(const struct farr_cosort_array *arrays,
+                               unsigned int                    array_nr,
+                               size_t                          dest,
+                               size_t                          src)
+{
+	unsigned int a;
+
+	for (a = 0; a < array_nr; a++) {
+		const struct farr_cosort_array *arr = &arrays[a];
+
+		arr->cosort_copy(&arr->cosort_entries[dest * arr->cosort_size],
+		                 &arr->cosort_entries[src * arr->cosort_size]);
+	}
+}
+
+/*
+ * Apply permutation to arrays by following its cycles so that each entry is
+ * moved once only and a single temporary entry per array is needed. Cycles are
+ * walked once for all arrays, marking permutation entries as fixed points on
+ * the way.
+ */
+static void farr_indirect_permute(size_t                         *perm,
+                                  size_t                          entry_nr,
+                                  const struct farr_cosort_array *arrays,
+                                  unsigned int                    array_nr,
+                                  char                           *tmp)
+{
+	size_t s;
+
+	for (s = 0; s < entry_nr; s++) {
+		size_t       curr = s;
+		size_t       next = perm[s];
+		unsigned int a;
+		size_t       off;
+
+		if (next == s)
+			continue;
+
+		for (a = 0, off = 0; a < array_nr; a++) {
+			arrays[a].cosort_copy(&tmp[off],
+			                      &arrays[a].cosort_entries[
+			                        s * arrays[a].cosort_size]);
+			off += arrays[a].cosort_size;
+		}
+
+		do {
+			karn_assert(next < entry_nr);
+
+			farr_indirect_move(arrays, array_nr, curr, next);
+			perm[curr] = curr;
+
+			curr = next;
+			next = perm[curr];
+		} while (next != s);
+
+		for (a = 0, off = 0; a < array_nr; a++) {
+			arrays[a].cosort_copy(&arrays[a].cosort_entries[
+			                        curr * arrays[a].cosort_size],
+			                      &tmp[off]);
+			off += arrays[a].cosort_size;
+		}
+		perm[curr] = curr;
+	}
+}
+
+int farr_sort_indirect(char            *entries,
+                       size_t           entry_size,
+                       size_t           entry_nr,
+                       farr_compare_fn *compare,
+                       farr_copy_fn    *copy,
+                       farr_prefix_fn  *prefix)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	const struct farr_cosort_array arr = {
+		.cosort_entries = entries,
+		.cosort_size    = entry_size,
+		.cosort_copy    = copy
+	};
+	char                           tmp[entry_size];
+	size_t                        *perm;
+
+	perm = farr_indirect_build(entries, entry_size, entry_nr, compare,
+	                           prefix);
+	if (!perm)
+		return -ENOMEM;
+
+	farr_indirect_permute(perm, entry_nr, &arr, 1, tmp);
+
+	free(perm);
+
+	return 0;
+}
+
+int farr_cosort(char                           *keys,
+                size_t                          key_size,
+                size_t                          key_nr,
+                farr_compare_fn                *compare,
+                farr_copy_fn                   *copy,
+                farr_prefix_fn                 *prefix,
+                const struct farr_cosort_array *payloads,
+                unsigned int                    payload_nr)
+{
+	karn_assert(keys);
+	karn_assert(key_size);
+	karn_assert(key_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+	karn_assert(!payload_nr || payloads);
+
+	struct farr_cosort_array  arrs[payload_nr + 1];
+	size_t                    size = key_size;
+	unsigned int              p;
+	size_t                   *perm;
+
+	arrs[0].cosort_entries = keys;
+	arrs[0].cosort_size = key_size;
+	arrs[0].cosort_copy = copy;
+
+	for (p = 0; p < payload_nr; p++) {
+		karn_assert(payloads[p].cosort_entries);
+		karn_assert(payloads[p].cosort_size);
+		karn_assert(payloads[p].cosort_copy);
+
+		arrs[p + 1] = payloads[p];
+		size += payloads[p].cosort_size;
+	}
+
+	perm = farr_indirect_build(keys, key_size, key_nr, compare, prefix);
+	if (!perm)
+		return -ENOMEM;
+
+	{
+		char tmp[size];
+
+		farr_indirect_permute(perm, key_nr, arrs, payload_nr + 1, tmp);
+	}
+
+	free(perm);
+
+	return 0;
+}
+
+#endif /* defined(CONFIG_KARN_FARR_INDIRECT_SORT) */
+
+#if defined(CONFIG_KARN_FARR_SELECT)
+
+#include <karn/fbnr_heap.h>
+
+#define FARR_SELECT_INSERT_THRESHOLD (16U)
+#define FARR_SELECT_GROUP_NR         (5U)
+/* Inverse of the fraction of entries a balanced partition discards at least. */
+#define FARR_SELECT_UNBALANCED_RATIO (8U)
+
+static bool farr_select_switch_insert(const char *begin,
+                                      const char *end,
+                                      size_t      entry_size)
+{
+	karn_assert(end >= begin);
+
+	return ((size_t)(end - begin) <=
+	        ((FARR_SELECT_INSERT_THRESHOLD - 1) * entry_size));
+}
+
+/*
+ * Partition [begin, end] range around the median of medians of groups of
+ * FARR_SELECT_GROUP_NR entries, i.e. a pivot guaranteed to leave at least 30%
+ * of entries on each side.
+ */
+static char * farr_select_mom_part(char            *begin,
+                                   char            *end,
+                                   size_t           entry_size,
+                                   farr_compare_fn *compare,
+                                   farr_copy_fn    *copy)
+{
+	char    tmp[entry_size];
+	char    pivot[entry_size];
+	char   *grp;
+	char   *med = begin;
+	size_t  med_nr;
+
+	/* Sort each group and gather their medians at the head of range. */
+	for (grp = begin; grp <= end;
+	     grp += FARR_SELECT_GROUP_NR * entry_size) {
+		char *last = grp + ((FARR_SELECT_GROUP_NR - 1) * entry_size);
+		char *mid;
+
+		if (last > end)
+			last = end;
+
+		_farr_insertion_sort(grp, last, entry_size, compare, copy);
+
+		mid = grp + (((last - grp) / (2 * entry_size)) * entry_size);
+		if (mid != med)
+			farr_swap(med, mid, tmp, copy);
+
+		med += entry_size;
+	}
+
+	/* Recursively select the median of medians and use it as pivot. */
+	med_nr = (med - begin) / entry_size;
+	med = farr_select(begin, entry_size, med_nr, med_nr / 2, compare, copy);
+	if (med != begin)
+		farr_swap(begin, med, tmp, copy);
+
+	/*
+	 * Pivot sitting at begin of range ensures the Hoare scheme returns a
+	 * location lower than end.
+	 */
+	copy(pivot, begin);
+
+	return farr_quick_hoare_scan(begin, end, pivot, entry_size, compare,
+	                             copy);
+}
+
+char * farr_select(char            *entries,
+                   size_t           entry_size,
+                   size_t           entry_nr,
+                   size_t           nth,
+                   farr_compare_fn *compare,
+                   farr_copy_fn    *copy)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(nth < entry_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	char         *begin = entries;
+	char         *end = &begin[(entry_nr - 1) * entry_size];
+	char         *nth_ent = &begin[nth * entry_size];
+	unsigned int  thres = farr_log2_upper((entry_nr > 2) ? entry_nr : 2);
+
+	while (!farr_select_switch_insert(begin, end, entry_size)) {
+		size_t  span = (size_t)(end - begin);
+		char   *pivot;
+
+		/*
+		 * Quick select until too many unbalanced partitions have been
+		 * encountered, then switch to median of medians pivot
+		 * selection to guarantee linear time complexity.
+		 */
+		if (thres)
+			pivot = farr_quick_hoare_part(begin, end, entry_size,
+			                              compare, copy);
+		else
+			pivot = farr_select_mom_part(begin, end, entry_size,
+			                             compare, copy);
+
+		karn_assert(begin <= pivot);
+		karn_assert(pivot < end);
+
+		if (nth_ent <= pivot)
+			end = pivot;
+		else
+			begin = pivot + entry_size;
+
+		/*
+		 * Partition is unbalanced when range is left with more than
+		 * FARR_SELECT_UNBALANCED_RATIO of its entries.
+		 */
+		if (thres &&
+		    ((size_t)(end - begin) >
+		     (span - (span / FARR_SELECT_UNBALANCED_RATIO))))
+			thres--;
+	}
+
+	_farr_insertion_sort(begin, end, entry_size, compare, copy);
+
+	return nth_ent;
+}
+
+void farr_partial_sort(char            *entries,
+                       size_t           entry_size,
+                       size_t           entry_nr,
+                       size_t           sort_nr,
+                       farr_compare_fn *compare,
+                       farr_copy_fn    *copy)
+{
+	karn_assert(sort_nr);
+	karn_assert(sort_nr <= entry_nr);
+
+	if (sort_nr == entry_nr) {
+		farr_intro_sort(entries, entry_size, entry_nr, compare, copy);
+		return;
+	}
+
+	/* Entry sort_nr - 1 sits at its final location once selected. */
+	farr_select(entries, entry_size, entry_nr, sort_nr - 1, compare, copy);
+
+	if (sort_nr > 1)
+		farr_intro_sort(entries, entry_size, sort_nr - 1, compare,
+		                copy);
+}
+
+void farr_top_k(const char      *entries,
+                size_t           entry_size,
+                size_t           entry_nr,
+                char            *top,
+                size_t           top_nr,
+                farr_compare_fn *compare,
+                farr_copy_fn    *copy)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(top);
+	karn_assert(top_nr);
+	karn_assert(top_nr <= entry_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	struct fbnr_heap heap;
+	char             tmp[entry_size];
+	size_t           e;
+
+	/*
+	 * Maintain a heap of the top_nr greatest entries seen so far, rooted
+	 * at the lowest of them so that lower entries are discarded with a
+	 * single comparison.
+	 */
+	fbnr_heap_init(&heap, top, entry_size, top_nr, compare, copy);
+
+	for (e = 0; e < top_nr; e++)
+		copy(&top[e * entry_size], &entries[e * entry_size]);
+	fbnr_heap_build(&heap, top_nr);
+
+	for (; e < entry_nr; e++) {
+		const char *ent = &entries[e * entry_size];
+
+		if (compare(ent, fbnr_heap_peek(&heap)) > 0)
+			fbnr_heap_replace(&heap, ent);
+	}
+
+	/*
+	 * Extract entries in ascending order, each one into the slot just
+	 * freed at the end of heap.
+	 */
+	while (top_nr--) {
+		fbnr_heap_extract(&heap, tmp);
+		copy(&top[top_nr * entry_size], tmp);
+	}
+
+	fbnr_heap_fini(&heap);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_SELECT) */
+
+#if defined(CONFIG_KARN_FARR_NETWORK_SORT)
+
+#include <string.h>
+#include <math.h>
+
+/*
+ * Bitonic sorting networks for small arrays of scalar keys.
+ *
+ * Keys are copied into a local buffer padded with greatest possible key values
+ * up to the next power of 2 so that a single network may be used whatever the
+ * number of keys. Networks are implemented using the "alternative
+ * representation" of bitonic sorters where all comparators sort in ascending
+ * order: the first step of each merging stage compares key i with key
+ * i ^ (k - 1), remaining steps compare key i with key i ^ j.
+ *
+ * Keys are laid out into vectors of lanes so that:
+ * - comparators whose distance is lower than the number of lanes are
+ *   implemented using in-vector shuffles, min / max and blending,
+ * - remaining ones are implemented using vertical min / max between vectors.
+ *
+ * On x86, AVX2 networks are always built and, unless enabled at build time
+ * through the -mavx2 compiler flag, selected at runtime when the processor
+ * supports them. Otherwise, SSE4.1 networks are used when enabled at build
+ * time through the -msse4.1 compiler flag and scalar networks made of
+ * branchless min / max operations as a last resort.
+ */
+
+#if defined(__AVX2__)
+
+#define FARR_NETWORK_AVX2
+#define FARR_NETWORK_AVX2_ATTR
+
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+/* Build AVX2 networks anyway and select them at runtime if supported. */
+#define FARR_NETWORK_AVX2
+#define FARR_NETWORK_AVX2_RUNTIME
+#define FARR_NETWORK_AVX2_ATTR __attribute__((target("avx2")))
+
+#endif
+
+#define FARR_NETWORK_BITONIC(_kind, _vec_type, _lane_nr, _attr) \
+	static _attr void \
+	farr_ ## _kind ## _bitonic(_vec_type *vecs, unsigned int vec_nr) \
+	{ \
+		unsigned int nr = vec_nr * (_lane_nr); \
+		unsigned int k; \
+		\
+		for (k = 2; k <= nr; k *= 2) { \
+			unsigned int a; \
+			unsigned int j; \
+			\
+			if (k <= (_lane_nr)) { \
+				for (a = 0; a < vec_nr; a++) \
+					vecs[a] = farr_ ## _kind ## _flip(vecs[a], \
+					                                 k); \
+			} \
+			else { \
+				unsigned int dist = (k / (_lane_nr)) - 1; \
+				\
+				for (a = 0; a < vec_nr; a++) { \
+					unsigned int b = a ^ dist; \
+					_vec_type    rev; \
+					_vec_type    lo; \
+					\
+					if (b < a) \
+						continue; \
+					\
+					rev = farr_ ## _kind ## _rev(vecs[b]); \
+					lo = farr_ ## _kind ## _min(vecs[a], \
+					                            rev); \
+					vecs[b] = farr_ ## _kind ## _rev( \
+						farr_ ## _kind ## _max(vecs[a], \
+						                       rev)); \
+					vecs[a] = lo; \
+				} \
+			} \
+			\
+			for (j = k / 4; j; j /= 2) { \
+				if (j < (_lane_nr)) { \
+					for (a = 0; a < vec_nr; a++) \
+						vecs[a] = farr_ ## _kind ## _step( \
+							vecs[a], j); \
+					continue; \
+				} \
+				\
+				for (a = 0; a < vec_nr; a++) { \
+					unsigned int b = a ^ (j / (_lane_nr)); \
+					_vec_type    lo; \
+					\
+					if (b < a) \
+						continue; \
+					\
+					lo = farr_ ## _kind ## _min(vecs[a], \
+					                            vecs[b]); \
+					vecs[b] = farr_ ## _kind ## _max(vecs[a], \
+					                                 vecs[b]); \
+					vecs[a] = lo; \
+				} \
+			} \
+		} \
+	}
+
+/*
+ * Below this number of keys, padding up to a whole vector costs more than
+ * the network saves: insertion sort instead.
+ */
+#define FARR_NETWORK_SORT_MIN (8U)
+
+/*
+ * Generate network sorting function for keys of the given type out of lane
+ * operations of the given kind.
+ */
+#define FARR_NETWORK_SORT(_kind, _type, _greatest, _vec_type, _lane_nr, \
+                          _load, _store, _attr) \
+	FARR_NETWORK_BITONIC(_kind, _vec_type, _lane_nr, _attr) \
+	\
+	static _attr void \
+	farr_ ## _kind ## _network_sort(_type *entries, unsigned int entry_nr) \
+	{ \
+		_type        keys[FARR_NETWORK_SORT_MAX] __align(32); \
+		_vec_type    vecs[FARR_NETWORK_SORT_MAX / (_lane_nr)]; \
+		unsigned int vec_nr; \
+		unsigned int k; \
+		\
+		if (entry_nr < FARR_NETWORK_SORT_MIN) { \
+			for (k = 1; k < entry_nr; k++) { \
+				_type        key = entries[k]; \
+				unsigned int e = k; \
+				\
+				while (e && (key < entries[e - 1])) { \
+					entries[e] = entries[e - 1]; \
+					e--; \
+				} \
+				entries[e] = key; \
+			} \
+			return; \
+		} \
+		\
+		vec_nr = (entry_nr + (_lane_nr) - 1) / (_lane_nr); \
+		vec_nr = 1U << pow2_upper(vec_nr); \
+		\
+		memcpy(keys, entries, entry_nr * sizeof(keys[0])); \
+		for (k = entry_nr; k < (vec_nr * (_lane_nr)); k++) \
+			keys[k] = _greatest; \
+		\
+		for (k = 0; k < vec_nr; k++) \
+			vecs[k] = _load(&keys[k * (_lane_nr)]); \
+		\
+		farr_ ## _kind ## _bitonic(vecs, vec_nr); \
+		\
+		for (k = 0; k < vec_nr; k++) \
+			_store(&keys[k * (_lane_nr)], vecs[k]); \
+		\
+		memcpy(entries, keys, entry_nr * sizeof(keys[0])); \
+	}
+
+#if defined(FARR_NETWORK_AVX2)
+
+#include <immintrin.h>
+
+/*
+ * 8 lanes of 32 bits keys. Float keys are handled as integer vectors and cast
+ * for min / max only since shuffles and blends operate on raw bits.
+ */
+#define FARR_NETWORK_AVX2_LANE32_NR (8U)
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_avx2_shuffle32(__m256i vec, unsigned int xor)
+{
+	switch (xor) {
+	case 1:
+		return _mm256_shuffle_epi32(vec, _MM_SHUFFLE(2, 3, 0, 1));
+	case 2:
+		return _mm256_shuffle_epi32(vec, _MM_SHUFFLE(1, 0, 3, 2));
+	case 3:
+		return _mm256_shuffle_epi32(vec, _MM_SHUFFLE(0, 1, 2, 3));
+	case 4:
+		return _mm256_permute2x128_si256(vec, vec, 1);
+	default:
+		return _mm256_permutevar8x32_epi32(vec,
+		                                   _mm256_setr_epi32(7, 6, 5, 4,
+		                                                     3, 2, 1,
+		                                                     0));
+	}
+}
+
+/* Select maximum for lanes whose index has the given bit set. */
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_avx2_blend32(__m256i min, __m256i max, unsigned int bit)
+{
+	switch (bit) {
+	case 1:
+		return _mm256_blend_epi32(min, max, 0xaa);
+	case 2:
+		return _mm256_blend_epi32(min, max, 0xcc);
+	default:
+		return _mm256_blend_epi32(min, max, 0xf0);
+	}
+}
+
+#define FARR_NETWORK_AVX2_OPS32(_kind, _min_op, _max_op) \
+	static inline FARR_NETWORK_AVX2_ATTR __m256i \
+	farr_ ## _kind ## _min(__m256i a, __m256i b) \
+	{ \
+		return _min_op(a, b); \
+	} \
+	\
+	static inline FARR_NETWORK_AVX2_ATTR __m256i \
+	farr_ ## _kind ## _max(__m256i a, __m256i b) \
+	{ \
+		return _max_op(a, b); \
+	} \
+	\
+	static inline FARR_NETWORK_AVX2_ATTR __m256i \
+	farr_ ## _kind ## _rev(__m256i vec) \
+	{ \
+		return farr_avx2_shuffle32(vec, 7); \
+	} \
+	\
+	static inline FARR_NETWORK_AVX2_ATTR __m256i \
+	farr_ ## _kind ## _step(__m256i vec, unsigned int j) \
+	{ \
+		__m256i other = farr_avx2_shuffle32(vec, j); \
+		\
+		return farr_avx2_blend32(_min_op(vec, other), \
+		                         _max_op(vec, other), \
+		                         j); \
+	} \
+	\
+	static inline FARR_NETWORK_AVX2_ATTR __m256i \
+	farr_ ## _kind ## _flip(__m256i vec, unsigned int k) \
+	{ \
+		__m256i other = farr_avx2_shuffle32(vec, k - 1); \
+		\
+		return farr_avx2_blend32(_min_op(vec, other), \
+		                         _max_op(vec, other), \
+		                         k / 2); \
+	}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_avx2_min_ps(__m256i a, __m256i b)
+{
+	return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a),
+	                                         _mm256_castsi256_ps(b)));
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_avx2_max_ps(__m256i a, __m256i b)
+{
+	return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a),
+	                                         _mm256_castsi256_ps(b)));
+}
+
+FARR_NETWORK_AVX2_OPS32(uint32_avx2, _mm256_min_epu32, _mm256_max_epu32)
+FARR_NETWORK_AVX2_OPS32(int32_avx2, _mm256_min_epi32, _mm256_max_epi32)
+FARR_NETWORK_AVX2_OPS32(float_avx2, farr_avx2_min_ps, farr_avx2_max_ps)
+
+/*
+ * 4 lanes of 64 bits keys. AVX2 has no unsigned 64 bits comparison: flip sign
+ * bits and use the signed one.
+ */
+#define FARR_NETWORK_AVX2_LANE64_NR (4U)
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_uint64_avx2_greater(__m256i a, __m256i b)
+{
+	const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+
+	return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign),
+	                          _mm256_xor_si256(b, sign));
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_uint64_avx2_min(__m256i a, __m256i b)
+{
+	return _mm256_blendv_epi8(a, b, farr_uint64_avx2_greater(a, b));
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_uint64_avx2_max(__m256i a, __m256i b)
+{
+	return _mm256_blendv_epi8(b, a, farr_uint64_avx2_greater(a, b));
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_avx2_shuffle64(__m256i vec, unsigned int xor)
+{
+	switch (xor) {
+	case 1:
+		return _mm256_permute4x64_epi64(vec, _MM_SHUFFLE(2, 3, 0, 1));
+	case 2:
+		return _mm256_permute4x64_epi64(vec, _MM_SHUFFLE(1, 0, 3, 2));
+	default:
+		return _mm256_permute4x64_epi64(vec, _MM_SHUFFLE(0, 1, 2, 3));
+	}
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_avx2_blend64(__m256i min, __m256i max, unsigned int bit)
+{
+	if (bit == 1)
+		return _mm256_blend_epi32(min, max, 0xcc);
+
+	return _mm256_blend_epi32(min, max, 0xf0);
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_uint64_avx2_rev(__m256i vec)
+{
+	return farr_avx2_shuffle64(vec, 3);
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_uint64_avx2_step(__m256i vec, unsigned int j)
+{
+	__m256i other = farr_avx2_shuffle64(vec, j);
+
+	return farr_avx2_blend64(farr_uint64_avx2_min(vec, other),
+	                         farr_uint64_avx2_max(vec, other),
+	                         j);
+}
+
+static inline FARR_NETWORK_AVX2_ATTR __m256i
+farr_uint64_avx2_flip(__m256i vec, unsigned int k)
+{
+	__m256i other = farr_avx2_shuffle64(vec, k - 1);
+
+	return farr_avx2_blend64(farr_uint64_avx2_min(vec, other),
+	                         farr_uint64_avx2_max(vec, other),
+	                         k / 2);
+}
+
+#define farr_avx2_load(_keys) \
+	_mm256_load_si256((const __m256i *)(_keys))
+#define farr_avx2_store(_keys, _vec) \
+	_mm256_store_si256((__m256i *)(_keys), _vec)
+
+FARR_NETWORK_SORT(uint32_avx2, uint32_t, UINT32_MAX, __m256i,
+                  FARR_NETWORK_AVX2_LANE32_NR, farr_avx2_load, farr_avx2_store,
+                  FARR_NETWORK_AVX2_ATTR)
+FARR_NETWORK_SORT(int32_avx2, int32_t, INT32_MAX, __m256i,
+                  FARR_NETWORK_AVX2_LANE32_NR, farr_avx2_load, farr_avx2_store,
+                  FARR_NETWORK_AVX2_ATTR)
+FARR_NETWORK_SORT(float_avx2, float, HUGE_VALF, __m256i,
+                  FARR_NETWORK_AVX2_LANE32_NR, farr_avx2_load, farr_avx2_store,
+                  FARR_NETWORK_AVX2_ATTR)
+FARR_NETWORK_SORT(uint64_avx2, uint64_t, UINT64_MAX, __m256i,
+                  FARR_NETWORK_AVX2_LANE64_NR, farr_avx2_load, farr_avx2_store,
+                  FARR_NETWORK_AVX2_ATTR)
+
+#endif /* defined(FARR_NETWORK_AVX2) */
+
+#if defined(__AVX2__)
+
+/* No need for fallback networks. */
+#define FARR_NETWORK_ISA32 avx2
+#define FARR_NETWORK_ISA64 avx2
+
+#else  /* !defined(__AVX2__) */
+
+#if defined(__SSE4_1__)
+
+#include <smmintrin.h>
+
+/* 4 lanes of 32 bits keys. */
+#define FARR_NETWORK_SSE41_LANE32_NR (4U)
+
+static inline __m128i farr_sse41_shuffle32(__m128i vec, unsigned int xor)
+{
+	switch (xor) {
+	case 1:
+		return _mm_shuffle_epi32(vec, _MM_SHUFFLE(2, 3, 0, 1));
+	case 2:
+		return _mm_shuffle_epi32(vec, _MM_SHUFFLE(1, 0, 3, 2));
+	default:
+		return _mm_shuffle_epi32(vec, _MM_SHUFFLE(0, 1, 2, 3));
+	}
+}
+
+static inline __m128i farr_sse41_blend32(__m128i      min,
+                                         __m128i      max,
+                                         unsigned int bit)
+{
+	if (bit == 1)
+		return _mm_blend_epi16(min, max, 0xcc);
+
+	return _mm_blend_epi16(min, max, 0xf0);
+}
+
+#define FARR_NETWORK_SSE41_OPS32(_kind, _min_op, _max_op) \
+	static inline __m128i farr_ ## _kind ## _min(__m128i a, __m128i b) \
+	{ \
+		return _min_op(a, b); \
+	} \
+	\
+	static inline __m128i farr_ ## _kind ## _max(__m128i a, __m128i b) \
+	{ \
+		return _max_op(a, b); \
+	} \
+	\
+	static inline __m128i farr_ ## _kind ## _rev(__m128i vec) \
+	{ \
+		return farr_sse41_shuffle32(vec, 3); \
+	} \
+	\
+	static inline __m128i farr_ ## _kind ## _step(__m128i      vec, \
+	                                              unsigned int j) \
+	{ \
+		__m128i other = farr_sse41_shuffle32(vec, j); \
+		\
+		return farr_sse41_blend32(_min_op(vec, other), \
+		                          _max_op(vec, other), \
+		                          j); \
+	} \
+	\
+	static inline __m128i farr_ ## _kind ## _flip(__m128i      vec, \
+	                                              unsigned int k) \
+	{ \
+		__m128i other = farr_sse41_shuffle32(vec, k - 1); \
+		\
+		return farr_sse41_blend32(_min_op(vec, other), \
+		                          _max_op(vec, other), \
+		                          k / 2); \
+	}
+
+static inline __m128i farr_sse41_min_ps(__m128i a, __m128i b)
+{
+	return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a),
+	                                   _mm_castsi128_ps(b)));
+}
+
+static inline __m128i farr_sse41_max_ps(__m128i a, __m128i b)
+{
+	return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a),
+	                                   _mm_castsi128_ps(b)));
+}
+
+FARR_NETWORK_SSE41_OPS32(uint32_sse41, _mm_min_epu32, _mm_max_epu32)
+FARR_NETWORK_SSE41_OPS32(int32_sse41, _mm_min_epi32, _mm_max_epi32)
+FARR_NETWORK_SSE41_OPS32(float_sse41, farr_sse41_min_ps, farr_sse41_max_ps)
+
+#define farr_sse41_load(_keys) \
+	_mm_load_si128((const __m128i *)(_keys))
+#define farr_sse41_store(_keys, _vec) \
+	_mm_store_si128((__m128i *)(_keys), _vec)
+
+FARR_NETWORK_SORT(uint32_sse41, uint32_t, UINT32_MAX, __m128i,
+                  FARR_NETWORK_SSE41_LANE32_NR, farr_sse41_load,
+                  farr_sse41_store, )
+FARR_NETWORK_SORT(int32_sse41, int32_t, INT32_MAX, __m128i,
+                  FARR_NETWORK_SSE41_LANE32_NR, farr_sse41_load,
+                  farr_sse41_store, )
+FARR_NETWORK_SORT(float_sse41, float, HUGE_VALF, __m128i,
+                  FARR_NETWORK_SSE41_LANE32_NR, farr_sse41_load,
+                  farr_sse41_store, )
+
+#define FARR_NETWORK_ISA32 sse41
+
+#endif /* defined(__SSE4_1__) */
+
+/*
+ * Scalar fallback: a single key per "vector" with branchless min / max which
+ * compilers turn into conditional moves.
+ */
+#define FARR_NETWORK_SCALAR_OPS(_kind, _type) \
+	static inline _type farr_ ## _kind ## _min(_type a, _type b) \
+	{ \
+		return (b < a) ? b : a; \
+	} \
+	\
+	static inline _type farr_ ## _kind ## _max(_type a, _type b) \
+	{ \
+		return (b < a) ? a : b; \
+	} \
+	\
+	static inline _type farr_ ## _kind ## _rev(_type key) \
+	{ \
+		return key; \
+	} \
+	\
+	static inline _type farr_ ## _kind ## _step(_type        key, \
+	                                            unsigned int j __unused) \
+	{ \
+		return key; \
+	} \
+	\
+	static inline _type farr_ ## _kind ## _flip(_type        key, \
+	                                            unsigned int k __unused) \
+	{ \
+		return key; \
+	}
+
+#define farr_scalar_load(_keys)        (*(_keys))
+#define farr_scalar_store(_keys, _key) (*(_keys) = (_key))
+
+#if !defined(__SSE4_1__)
+
+FARR_NETWORK_SCALAR_OPS(uint32_scalar, uint32_t)
+FARR_NETWORK_SCALAR_OPS(int32_scalar, int32_t)
+FARR_NETWORK_SCALAR_OPS(float_scalar, float)
+
+FARR_NETWORK_SORT(uint32_scalar, uint32_t, UINT32_MAX, uint32_t, 1U,
+                  farr_scalar_load, farr_scalar_store, )
+FARR_NETWORK_SORT(int32_scalar, int32_t, INT32_MAX, int32_t, 1U,
+                  farr_scalar_load, farr_scalar_store, )
+FARR_NETWORK_SORT(float_scalar, float, HUGE_VALF, float, 1U,
+                  farr_scalar_load, farr_scalar_store, )
+
+#define FARR_NETWORK_ISA32 scalar
+
+#endif /* !defined(__SSE4_1__) */
+
+/* SSE4.1 lacks 64 bits comparison: use scalar network. */
+FARR_NETWORK_SCALAR_OPS(uint64_scalar, uint64_t)
+
+FARR_NETWORK_SORT(uint64_scalar, uint64_t, UINT64_MAX, uint64_t, 1U,
+                  farr_scalar_load, farr_scalar_store, )
+
+#define FARR_NETWORK_ISA64 scalar
+
+#endif /* defined(__AVX2__) */
+
+#if defined(FARR_NETWORK_AVX2_RUNTIME)
+
+/*
+ * Probe processor once at load time so that dispatching costs a single load
+ * and branch.
+ */
+static bool farr_network_avx2;
+
+static void __attribute__((constructor)) farr_network_probe(void)
+{
+	__builtin_cpu_init();
+
+	farr_network_avx2 = !!__builtin_cpu_supports("avx2");
+}
+
+static inline bool farr_network_has_avx2(void)
+{
+	return farr_network_avx2;
+}
+
+#define farr_network_select(_name, _isa) \
+	(farr_network_has_avx2() ? farr_ ## _name ## _avx2_network_sort : \
+	                           farr_ ## _name ## _ ## _isa ## _network_sort)
+
+#else  /* !defined(FARR_NETWORK_AVX2_RUNTIME) */
+
+#define farr_network_select(_name, _isa) \
+	farr_ ## _name ## _ ## _isa ## _network_sort
+
+#endif /* defined(FARR_NETWORK_AVX2_RUNTIME) */
+
+/*
+ * Generate public network sorting function dispatching to the fastest network
+ * available, _isa naming the one to use when AVX2 is not.
+ */
+#define FARR_NETWORK_SORT_FUNC(_name, _type, _isa) \
+	void farr_ ## _name ## _network_sort(_type       *entries, \
+	                                     unsigned int entry_nr) \
+	{ \
+		karn_assert(entries); \
+		karn_assert(entry_nr <= FARR_NETWORK_SORT_MAX); \
+		\
+		farr_network_select(_name, _isa)(entries, entry_nr); \
+	}
+
+FARR_NETWORK_SORT_FUNC(uint32, uint32_t, FARR_NETWORK_ISA32)
+FARR_NETWORK_SORT_FUNC(int32, int32_t, FARR_NETWORK_ISA32)
+FARR_NETWORK_SORT_FUNC(float, float, FARR_NETWORK_ISA32)
+FARR_NETWORK_SORT_FUNC(uint64, uint64_t, FARR_NETWORK_ISA64)
+
+#endif /* defined(CONFIG_KARN_FARR_NETWORK_SORT) */
+
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+
+#define farr_scalar_compare(_first, _second) \
+	((int)(*(_first) > *(_second)) - (int)(*(_first) < *(_second)))
+
+#define farr_ptr_compare(_first, _second) \
+	((int)((uintptr_t)*(_first) > (uintptr_t)*(_second)) - \
+	 (int)((uintptr_t)*(_first) < (uintptr_t)*(_second)))
+
+/*
+ * Sort small partitions using sorting networks for key types these are
+ * vectorized for. Scalar networks are slower than insertion sort and are not
+ * used as base case.
+ *
+ * When AVX2 networks are selected at runtime, 32 and 64 bits variants are
+ * built twice: once with AVX2 networks as base case, once with the fallback
+ * ones if vectorized. Public functions then dispatch to the former when the
+ * processor supports AVX2.
+ */
+#if defined(CONFIG_KARN_FARR_NETWORK_SORT)
+#define FARR_NETWORK_BASE_THRESHOLD FARR_NETWORK_SORT_MAX
+#define _farr_network_base(_name, _isa, _entries, _nr) \
+	farr_ ## _name ## _ ## _isa ## _network_sort(_entries, _nr)
+#define farr_network_base(_name, _isa, _entries, _nr) \
+	_farr_network_base(_name, _isa, _entries, _nr)
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#define FARR_NETWORK_BASE32 FARR_NETWORK_ISA32
+#endif
+#if defined(__AVX2__)
+#define FARR_NETWORK_BASE64 FARR_NETWORK_ISA64
+#endif
+#endif /* defined(CONFIG_KARN_FARR_NETWORK_SORT) */
+
+#if defined(FARR_NETWORK_AVX2_RUNTIME)
+
+#define farr_typed_name(_name) _name ## _dflt
+#define FARR_TYPED_FUNC        static inline
+
+#define FARR_TMPL_NAME              uint32_avx2
+#define FARR_TMPL_TYPE              uint32_t
+#define FARR_TMPL_COMPARE(_a, _b)   farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC              static inline FARR_NETWORK_AVX2_ATTR
+#define FARR_TMPL_BASE_SORT(_e, _n) farr_network_base(uint32, avx2, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME              int32_avx2
+#define FARR_TMPL_TYPE              int32_t
+#define FARR_TMPL_COMPARE(_a, _b)   farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC              static inline FARR_NETWORK_AVX2_ATTR
+#define FARR_TMPL_BASE_SORT(_e, _n) farr_network_base(int32, avx2, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME              uint64_avx2
+#define FARR_TMPL_TYPE              uint64_t
+#define FARR_TMPL_COMPARE(_a, _b)   farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC              static inline FARR_NETWORK_AVX2_ATTR
+#define FARR_TMPL_BASE_SORT(_e, _n) farr_network_base(uint64, avx2, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME              float_avx2
+#define FARR_TMPL_TYPE              float
+#define FARR_TMPL_COMPARE(_a, _b)   farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC              static inline FARR_NETWORK_AVX2_ATTR
+#define FARR_TMPL_BASE_SORT(_e, _n) farr_network_base(float, avx2, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#include <karn/farr_tmpl.h>
+
+#define FARR_TYPED_SELECT(_name, _type, _algo) \
+	void farr_ ## _name ## _ ## _algo ## _sort(_type *entries, \
+	                                           size_t entry_nr) \
+	{ \
+		if (farr_network_has_avx2()) \
+			farr_ ## _name ## _avx2_ ## _algo ## _sort(entries, \
+			                                           entry_nr); \
+		else \
+			farr_ ## _name ## _dflt_ ## _algo ## _sort(entries, \
+			                                           entry_nr); \
+	}
+
+#define FARR_TYPED_SELECTS(_name, _type) \
+	FARR_TYPED_SELECT(_name, _type, insertion) \
+	FARR_TYPED_SELECT(_name, _type, quick) \
+	FARR_TYPED_SELECT(_name, _type, intro) \
+	FARR_TYPED_SELECT(_name, _type, pdq)
+
+#else  /* !defined(FARR_NETWORK_AVX2_RUNTIME) */
+
+#define farr_typed_name(_name) _name
+#define FARR_TYPED_FUNC
+
+#endif /* defined(FARR_NETWORK_AVX2_RUNTIME) */
+
+#define FARR_TMPL_NAME             farr_typed_name(uint32)
+#define FARR_TMPL_TYPE             uint32_t
+#define FARR_TMPL_COMPARE(_a, _b)  farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC             FARR_TYPED_FUNC
+#if defined(FARR_NETWORK_BASE32)
+#define FARR_TMPL_BASE_SORT(_e, _n) \
+	farr_network_base(uint32, FARR_NETWORK_BASE32, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#endif
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME             farr_typed_name(int32)
+#define FARR_TMPL_TYPE             int32_t
+#define FARR_TMPL_COMPARE(_a, _b)  farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC             FARR_TYPED_FUNC
+#if defined(FARR_NETWORK_BASE32)
+#define FARR_TMPL_BASE_SORT(_e, _n) \
+	farr_network_base(int32, FARR_NETWORK_BASE32, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#endif
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME             farr_typed_name(uint64)
+#define FARR_TMPL_TYPE             uint64_t
+#define FARR_TMPL_COMPARE(_a, _b)  farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC             FARR_TYPED_FUNC
+#if defined(FARR_NETWORK_BASE64)
+#define FARR_TMPL_BASE_SORT(_e, _n) \
+	farr_network_base(uint64, FARR_NETWORK_BASE64, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#endif
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME             int64
+#define FARR_TMPL_TYPE             int64_t
+#define FARR_TMPL_COMPARE(_a, _b)  farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME             farr_typed_name(float)
+#define FARR_TMPL_TYPE             float
+#define FARR_TMPL_COMPARE(_a, _b)  farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC             FARR_TYPED_FUNC
+#if defined(FARR_NETWORK_BASE32)
+#define FARR_TMPL_BASE_SORT(_e, _n) \
+	farr_network_base(float, FARR_NETWORK_BASE32, _e, _n)
+#define FARR_TMPL_BASE_THRESHOLD    FARR_NETWORK_BASE_THRESHOLD
+#endif
+#include <karn/farr_tmpl.h>
+
+#if defined(FARR_NETWORK_AVX2_RUNTIME)
+FARR_TYPED_SELECTS(uint32, uint32_t)
+FARR_TYPED_SELECTS(int32, int32_t)
+FARR_TYPED_SELECTS(uint64, uint64_t)
+FARR_TYPED_SELECTS(float, float)
+#endif /* defined(FARR_NETWORK_AVX2_RUNTIME) */
+
+#define FARR_TMPL_NAME             double
+#define FARR_TMPL_TYPE             double
+#define FARR_TMPL_COMPARE(_a, _b)  farr_scalar_compare(_a, _b)
+#define FARR_TMPL_FUNC
+#include <karn/farr_tmpl.h>
+
+#define FARR_TMPL_NAME             ptr
+#define FARR_TMPL_TYPE             void *
+#define FARR_TMPL_COMPARE(_a, _b)  farr_ptr_compare(_a, _b)
+#define FARR_TMPL_FUNC
+#include <karn/farr_tmpl.h>
+
+#endif /* defined(CONFIG_KARN_FARR_TYPED_SORT) */
+
+#if defined(CONFIG_KARN_FARR_RADIX_SORT)
+
+#include <string.h>
+#include <errno.h>
+
+#define FARR_RADIX_BITS             (8U)
+#define FARR_RADIX_BUCKET_NR        (1U << FARR_RADIX_BITS)
+#define FARR_RADIX_MASK             (FARR_RADIX_BUCKET_NR - 1)
+#define FARR_RADIX_INSERT_THRESHOLD (32U)
+#define FARR_RADIX_LSD_THRESHOLD    (1024U)
+
+static unsigned int farr_radix_digit(uint64_t key, unsigned int digit)
+{
+	return (unsigned int)(key >> (digit * FARR_RADIX_BITS)) &
+	       FARR_RADIX_MASK;
+}
+
+/*
+ * Turn digit histogram into starting offsets and tell whether scattering
+ * entries according to this digit is needed, i.e. if all entries do not fall
+ * into the same bucket.
+ */
+static bool farr_radix_prefix(size_t *counts, size_t entry_nr)
+{
+	unsigned int b;
+	size_t       off = 0;
+
+	for (b = 0; b < FARR_RADIX_BUCKET_NR; b++) {
+		size_t cnt = counts[b];
+
+		if (cnt == entry_nr)
+			return false;
+
+		counts[b] = off;
+		off += cnt;
+	}
+
+	return true;
+}
+
+int farr_lsd_radix_sort(char              *entries,
+                        size_t             entry_size,
+                        size_t             entry_nr,
+                        unsigned int       key_size,
+                        farr_radix_key_fn *key,
+                        farr_copy_fn      *copy,
+                        char              *scratch)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(key_size && (key_size <= sizeof(uint64_t)));
+	karn_assert(key);
+	karn_assert(copy);
+
+	size_t        counts[key_size][FARR_RADIX_BUCKET_NR];
+	char         *buff = scratch;
+	char         *src = entries;
+	char         *dst;
+	unsigned int  d;
+	size_t        e;
+
+	if (!buff) {
+		buff = malloc(entry_nr * entry_size);
+		if (!buff)
+			return -ENOMEM;
+	}
+	dst = buff;
+
+	memset(counts, 0, sizeof(counts));
+	for (e = 0; e < entry_nr; e++) {
+		uint64_t k = key(&entries[e * entry_size]);
+
+		for (d = 0; d < key_size; d++)
+			counts[d][farr_radix_digit(k, d)]++;
+	}
+
+	for (d = 0; d < key_size; d++) {
+		char *tmp;
+
+		if (!farr_radix_prefix(counts[d], entry_nr))
+			continue;
+
+		for (e = 0; e < entry_nr; e++) {
+			const char   *ent = &src[e * entry_size];
+			unsigned int  b = farr_radix_digit(key(ent), d);
+
+			copy(&dst[counts[d][b]++ * entry_size], ent);
+		}
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if (src != entries)
+		for (e = 0; e < entry_nr; e++)
+			copy(&entries[e * entry_size], &src[e * entry_size]);
+
+	if (!scratch)
+		free(buff);
+
+	return 0;
+}
+
+struct farr_radix_part {
+	char         *radix_begin;
+	size_t        radix_nr;
+	unsigned int  radix_digit;
+};
+
+/*
+ * Permute entries in place so that they are grouped into buckets according to
+ * the given digit (American flag sort). Bucket sizes are returned into counts.
+ */
+static void farr_msd_radix_permute(char              *entries,
+                                   size_t             entry_size,
+                                   size_t             entry_nr,
+                                   unsigned int       digit,
+                                   farr_radix_key_fn *key,
+                                   farr_copy_fn      *copy,
+                                   size_t            *counts)
+{
+	size_t       heads[FARR_RADIX_BUCKET_NR];
+	size_t       tails[FARR_RADIX_BUCKET_NR];
+	unsigned int b;
+	size_t       e;
+	char         curr[entry_size];
+	char         next[entry_size];
+
+	memset(counts, 0, FARR_RADIX_BUCKET_NR * sizeof(counts[0]));
+	for (e = 0; e < entry_nr; e++) {
+		uint64_t k = key(&entries[e * entry_size]);
+
+		counts[farr_radix_digit(k, digit)]++;
+	}
+
+	for (b = 0, e = 0; b < FARR_RADIX_BUCKET_NR; b++) {
+		heads[b] = e;
+		e += counts[b];
+		tails[b] = e;
+	}
+
+	for (b = 0; b < FARR_RADIX_BUCKET_NR; b++) {
+		while (heads[b] < tails[b]) {
+			unsigned int d;
+
+			copy(curr, &entries[heads[b] * entry_size]);
+			d = farr_radix_digit(key(curr), digit);
+
+			/* Follow displacement cycle until back to bucket b. */
+			while (d != b) {
+				char *slot = &entries[heads[d]++ * entry_size];
+
+				copy(next, slot);
+				copy(slot, curr);
+				copy(curr, next);
+
+				d = farr_radix_digit(key(curr), digit);
+			}
+
+			copy(&entries[heads[b]++ * entry_size], curr);
+		}
+	}
+}
+
+void farr_msd_radix_sort(char              *entries,
+                         size_t             entry_size,
+                         size_t             entry_nr,
+                         unsigned int       key_size,
+                         farr_radix_key_fn *key,
+                         farr_compare_fn   *compare,
+                         farr_copy_fn      *copy)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(key_size && (key_size <= sizeof(uint64_t)));
+	karn_assert(key);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	/*
+	 * At most (FARR_RADIX_BUCKET_NR - 1) sub-buckets are pending per digit
+	 * level since the one being processed is popped before being split.
+	 */
+	struct farr_radix_part parts[(key_size * (FARR_RADIX_BUCKET_NR - 1)) +
+	                             1];
+	unsigned int           ptop = 0;
+
+	parts[ptop++] = (struct farr_radix_part){
+		.radix_begin = entries,
+		.radix_nr    = entry_nr,
+		.radix_digit = key_size - 1
+	};
+
+	while (ptop--) {
+		char         *begin = parts[ptop].radix_begin;
+		size_t        nr = parts[ptop].radix_nr;
+		unsigned int  digit = parts[ptop].radix_digit;
+		size_t        counts[FARR_RADIX_BUCKET_NR];
+		unsigned int  b;
+
+		if (nr < FARR_RADIX_INSERT_THRESHOLD) {
+			farr_insertion_sort(begin, entry_size, nr, compare,
+			                    copy);
+			continue;
+		}
+
+		farr_msd_radix_permute(begin, entry_size, nr, digit, key, copy,
+		                       counts);
+		if (!digit)
+			continue;
+
+		for (b = 0; b < FARR_RADIX_BUCKET_NR; b++) {
+			if (counts[b] > 1) {
+				karn_assert(ptop < array_nr(parts));
+
+				parts[ptop++] = (struct farr_radix_part){
+					.radix_begin = begin,
+					.radix_nr    = counts[b],
+					.radix_digit = digit - 1
+				};
+			}
+
+			begin += counts[b] * entry_size;
+		}
+	}
+}
+
+void farr_radix_sort(char              *entries,
+                     size_t             entry_size,
+                     size_t             entry_nr,
+                     unsigned int       key_size,
+                     farr_radix_key_fn *key,
+                     farr_compare_fn   *compare,
+                     farr_copy_fn      *copy,
+                     char              *scratch)
+{
+	if ((entry_nr >= FARR_RADIX_LSD_THRESHOLD) &&
+	    !farr_lsd_radix_sort(entries, entry_size, entry_nr, key_size, key,
+	                         copy, scratch))
+		return;
+
+	farr_msd_radix_sort(entries, entry_size, entry_nr, key_size, key,
+	                    compare, copy);
+}
+
+int farr_uint32_radix_sort(uint32_t *entries,
+                           size_t    entry_nr,
+                           uint32_t *scratch)
+{
+	karn_assert(entries);
+	karn_assert(entry_nr);
+
+	size_t        counts[sizeof(*entries)][FARR_RADIX_BUCKET_NR];
+	uint32_t     *buff = scratch;
+	uint32_t     *src = entries;
+	uint32_t     *dst;
+	unsigned int  d;
+	size_t        e;
+
+	if (!buff) {
+		buff = malloc(entry_nr * sizeof(*buff));
+		if (!buff)
+			return -ENOMEM;
+	}
+	dst = buff;
+
+	memset(counts, 0, sizeof(counts));
+	for (e = 0; e < entry_nr; e++)
+		for (d = 0; d < sizeof(*entries); d++)
+			counts[d][farr_radix_digit(entries[e], d)]++;
+
+	for (d = 0; d < sizeof(*entries); d++) {
+		uint32_t *tmp;
+
+		if (!farr_radix_prefix(counts[d], entry_nr))
+			continue;
+
+		for (e = 0; e < entry_nr; e++) {
+			uint32_t k = src[e];
+
+			dst[counts[d][farr_radix_digit(k, d)]++] = k;
+		}
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if (src != entries)
+		memcpy(entries, src, entry_nr * sizeof(*entries));
+
+	if (!scratch)
+		free(buff);
+
+	return 0;
+}
+
+int farr_uint64_radix_sort(uint64_t *entries,
+                           size_t    entry_nr,
+                           uint64_t *scratch)
+{
+	karn_assert(entries);
+	karn_assert(entry_nr);
+
+	size_t        counts[sizeof(*entries)][FARR_RADIX_BUCKET_NR];
+	uint64_t     *buff = scratch;
+	uint64_t     *src = entries;
+	uint64_t     *dst;
+	unsigned int  d;
+	size_t        e;
+
+	if (!buff) {
+		buff = malloc(entry_nr * sizeof(*buff));
+		if (!buff)
+			return -ENOMEM;
+	}
+	dst = buff;
+
+	memset(counts, 0, sizeof(counts));
+	for (e = 0; e < entry_nr; e++)
+		for (d = 0; d < sizeof(*entries); d++)
+			counts[d][farr_radix_digit(entries[e], d)]++;
+
+	for (d = 0; d < sizeof(*entries); d++) {
+		uint64_t *tmp;
+
+		if (!farr_radix_prefix(counts[d], entry_nr))
+			continue;
+
+		for (e = 0; e < entry_nr; e++) {
+			uint64_t k = src[e];
+
+			dst[counts[d][farr_radix_digit(k, d)]++] = k;
+		}
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if (src != entries)
+		memcpy(entries, src, entry_nr * sizeof(*entries));
+
+	if (!scratch)
+		free(buff);
+
+	return 0;
+}
+
+#endif /* defined(CONFIG_KARN_FARR_RADIX_SORT) */
+
+#if defined(CONFIG_KARN_FARR_COUNTING_SORT)
+
+#include <string.h>
+#include <errno.h>
+
+/*
+ * farr_range_sort() uses counting sort when observed key range is lower than
+ * this many times the number of entries.
+ */
+#define FARR_COUNTING_RANGE_RATIO (2U)
+
+static size_t farr_counting_bucket(uint64_t key,
+                                   uint64_t base,
+                                   uint64_t width)
+{
+	uint64_t off = key - base;
+
+	if (width > 1)
+		off /= width;
+
+	return (size_t)off;
+}
+
+/*
+ * Stable distribution of entries into buckets of keys of the given width,
+ * starting from base. Counts must be given zeroed and hold bucket end offsets
+ * on return. Entries are scattered into scratch then copied back.
+ */
+static void farr_counting_scatter(char                 *entries,
+                                  size_t                entry_size,
+                                  size_t                entry_nr,
+                                  size_t                bucket_nr,
+                                  uint64_t              base,
+                                  uint64_t              width,
+                                  farr_counting_key_fn *key,
+                                  farr_copy_fn         *copy,
+                                  char                 *scratch,
+                                  size_t               *counts)
+{
+	size_t b;
+	size_t e;
+	size_t off = 0;
+
+	for (e = 0; e < entry_nr; e++) {
+		b = farr_counting_bucket(key(&entries[e * entry_size]), base,
+		                         width);
+		karn_assert(b < bucket_nr);
+
+		counts[b]++;
+	}
+
+	for (b = 0; b < bucket_nr; b++) {
+		size_t cnt = counts[b];
+
+		counts[b] = off;
+		off += cnt;
+	}
+
+	for (e = 0; e < entry_nr; e++) {
+		const char *ent = &entries[e * entry_size];
+
+		b = farr_counting_bucket(key(ent), base, width);
+		copy(&scratch[counts[b]++ * entry_size], ent);
+	}
+
+	for (e = 0; e < entry_nr; e++)
+		copy(&entries[e * entry_size], &scratch[e * entry_size]);
+}
+
+static int farr_counting_sort_range(char                 *entries,
+                                    size_t                entry_size,
+                                    size_t                entry_nr,
+                                    uint64_t              key_min,
+                                    size_t                key_nr,
+                                    farr_counting_key_fn *key,
+                                    farr_copy_fn         *copy,
+                                    char                 *scratch)
+{
+	size_t *counts;
+	char   *buff = scratch;
+
+	counts = calloc(key_nr, sizeof(*counts));
+	if (!counts)
+		return -ENOMEM;
+
+	if (!buff) {
+		buff = malloc(entry_nr * entry_size);
+		if (!buff) {
+			free(counts);
+			return -ENOMEM;
+		}
+	}
+
+	farr_counting_scatter(entries, entry_size, entry_nr, key_nr, key_min, 1,
+	                      key, copy, buff, counts);
+
+	if (!scratch)
+		free(buff);
+	free(counts);
+
+	return 0;
+}
+
+int farr_counting_sort(char                 *entries,
+                       size_t                entry_size,
+                       size_t                entry_nr,
+                       size_t                key_nr,
+                       farr_counting_key_fn *key,
+                       farr_copy_fn         *copy,
+                       char                 *scratch)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(key_nr);
+	karn_assert(key);
+	karn_assert(copy);
+
+	return farr_counting_sort_range(entries, entry_size, entry_nr, 0,
+	                                key_nr, key, copy, scratch);
+}
+
+int farr_bucket_sort(char                 *entries,
+                     size_t                entry_size,
+                     size_t                entry_nr,
+                     uint64_t              key_min,
+                     uint64_t              key_max,
+                     farr_counting_key_fn *key,
+                     farr_compare_fn      *compare,
+                     farr_copy_fn         *copy,
+                     char                 *scratch)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(key_min <= key_max);
+	karn_assert(key);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	/*
+	 * Width is chosen so that (key_max - key_min) / width < entry_nr, i.e.
+	 * there are no more buckets than entries.
+	 */
+	uint64_t  width = ((key_max - key_min) / entry_nr) + 1;
+	size_t    bucket_nr = (size_t)((key_max - key_min) / width) + 1;
+	size_t   *counts;
+	char     *buff = scratch;
+	size_t    b;
+	size_t    begin = 0;
+
+	counts = calloc(bucket_nr, sizeof(*counts));
+	if (!counts)
+		return -ENOMEM;
+
+	if (!buff) {
+		buff = malloc(entry_nr * entry_size);
+		if (!buff) {
+			free(counts);
+			return -ENOMEM;
+		}
+	}
+
+	farr_counting_scatter(entries, entry_size, entry_nr, bucket_nr, key_min,
+	                      width, key, copy, buff, counts);
+
+	for (b = 0; b < bucket_nr; b++) {
+		size_t nr = counts[b] - begin;
+
+		if (nr > 1)
+			farr_insertion_sort(&entries[begin * entry_size],
+			                    entry_size, nr, compare, copy);
+
+		begin = counts[b];
+	}
+
+	if (!scratch)
+		free(buff);
+	free(counts);
+
+	return 0;
+}
+
+void farr_range_sort(char                 *entries,
+                     size_t                entry_size,
+                     size_t                entry_nr,
+                     farr_counting_key_fn *key,
+                     farr_compare_fn      *compare,
+                     farr_copy_fn         *copy,
+                     char                 *scratch)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(key);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	uint64_t kmin = key(entries);
+	uint64_t kmax = kmin;
+	size_t   e;
+
+	for (e = 1; e < entry_nr; e++) {
+		uint64_t k = key(&entries[e * entry_size]);
+
+		kmin = (k < kmin) ? k : kmin;
+		kmax = (k > kmax) ? k : kmax;
+	}
+
+	if (((kmax - kmin) < ((uint64_t)entry_nr * FARR_COUNTING_RANGE_RATIO)) &&
+	    ((kmax - kmin) < SIZE_MAX) &&
+	    !farr_counting_sort_range(entries, entry_size, entry_nr, kmin,
+	                              (size_t)(kmax - kmin) + 1, key, copy,
+	                              scratch))
+		return;
+
+	farr_intro_sort(entries, entry_size, entry_nr, compare, copy);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_COUNTING_SORT) */
+
+#if defined(CONFIG_KARN_FARR_PARALLEL_SORT)
+
+#include <pthread.h>
+#include <string.h>
+
+/* Maximum number of threads. */
+#define FARR_PARALLEL_THREAD_MAX (256U)
+/* Minimum number of entries a thread should be given to sort. */
+#define FARR_PARALLEL_MIN_NR     (8192U)
+/* Number of samples per thread used to select splitters. */
+#define FARR_PARALLEL_OVERSAMPLE (64U)
+
+/*
+ * Bucket 2 * i holds entries located between splitters i - 1 and i, bucket
+ * 2 * i + 1 those equal to splitter i so that entries sharing a popular key
+ * need no sorting and do not pile up into a single bucket. Ids fit into 16
+ * bits given FARR_PARALLEL_THREAD_MAX.
+ */
+#define farr_parallel_bucket_nr(_thread_nr) ((2 * (_thread_nr)) - 1)
+
+struct farr_parallel_sort {
+	char             *par_entries;
+	size_t            par_size;
+	size_t            par_nr;
+	farr_compare_fn  *par_compare;
+	farr_copy_fn     *par_copy;
+	/* Number of work shares, i.e. of buckets sorting may run onto. */
+	unsigned int      par_thread_nr;
+	/* Number of running workers, calling thread included. */
+	unsigned int      par_worker_nr;
+	char             *par_scratch;
+	uint16_t         *par_buckets;
+	const char       *par_splitters;
+	/* Per share per bucket entry counts, then scatter offsets. */
+	size_t           *par_counts;
+	/* Bucket boundaries within scratch area. */
+	size_t           *par_bounds;
+	/* Hold spawned workers back till the number of running ones is known. */
+	pthread_mutex_t   par_gate;
+	/* Synchronize workers between phases. */
+	pthread_barrier_t par_barrier;
+};
+
+typedef void (farr_parallel_fn)(const struct farr_parallel_sort *sort,
+                                unsigned int                     id);
+
+struct farr_parallel_worker {
+	struct farr_parallel_sort *par_sort;
+	unsigned int               par_id;
+	pthread_t                  par_thread;
+};
+
+static size_t farr_parallel_chunk(const struct farr_parallel_sort *sort,
+                                  unsigned int                     id)
+{
+	/* Split before multiplying so that the product cannot overflow. */
+	size_t quot = sort->par_nr / sort->par_thread_nr;
+	size_t rem = sort->par_nr % sort->par_thread_nr;
+
+	return (quot * id) + ((rem * id) / sort->par_thread_nr);
+}
+
+/* Return index of the bucket the given entry belongs to. */
+static unsigned int farr_parallel_bucket(const struct farr_parallel_sort *sort,
+                                         const char                      *entry)
+{
+	const char   *splits = sort->par_splitters;
+	size_t        sz = sort->par_size;
+	unsigned int  low = 0;
+	unsigned int  high = sort->par_thread_nr - 1;
+
+	/* Find first splitter greater than entry. */
+	while (low < high) {
+		unsigned int mid = (low + high) / 2;
+
+		if (sort->par_compare(entry, &splits[mid * sz]) < 0)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+
+	if (low && !sort->par_compare(entry, &splits[(low - 1) * sz]))
+		return (2 * low) - 1;
+
+	return 2 * low;
+}
+
+static void farr_parallel_classify(const struct farr_parallel_sort *sort,
+                                   unsigned int                     id)
+{
+	unsigned int  bnr = farr_parallel_bucket_nr(sort->par_thread_nr);
+	size_t       *counts = &sort->par_counts[id * bnr];
+	size_t        sz = sort->par_size;
+	size_t        e;
+
+	for (e = farr_parallel_chunk(sort, id);
+	     e < farr_parallel_chunk(sort, id + 1);
+	     e++) {
+		unsigned int b;
+
+		b = farr_parallel_bucket(sort, &sort->par_entries[e * sz]);
+		sort->par_buckets[e] = (uint16_t)b;
+		counts[b]++;
+	}
+}
+
+/*
+ * Turn counts into per share scatter offsets so that each share's part of a
+ * bucket follows the previous share's one.
+ */
+static void farr_parallel_offsets(const struct farr_parallel_sort *sort)
+{
+	unsigned int bnr = farr_parallel_bucket_nr(sort->par_thread_nr);
+	size_t       off = 0;
+	unsigned int b, t;
+
+	for (b = 0; b < bnr; b++) {
+		sort->par_bounds[b] = off;
+
+		for (t = 0; t < sort->par_thread_nr; t++) {
+			size_t *cnt = &sort->par_counts[(t * bnr) + b];
+			size_t  nr = *cnt;
+
+			*cnt = off;
+			off += nr;
+		}
+	}
+
+	sort->par_bounds[bnr] = off;
+	karn_assert(off == sort->par_nr);
+}
+
+static void farr_parallel_scatter(const struct farr_parallel_sort *sort,
+                                  unsigned int                     id)
+{
+	unsigned int  bnr = farr_parallel_bucket_nr(sort->par_thread_nr);
+	size_t       *offs = &sort->par_counts[id * bnr];
+	size_t        sz = sort->par_size;
+	size_t        e;
+
+	for (e = farr_parallel_chunk(sort, id);
+	     e < farr_parallel_chunk(sort, id + 1);
+	     e++)
+		sort->par_copy(&sort->par_scratch[offs[sort->par_buckets[e]]++ *
+		                                  sz],
+		               &sort->par_entries[e * sz]);
+}
+
+/* Sort bucket of entries located between splitters id - 1 and id. */
+static void farr_parallel_finish(const struct farr_parallel_sort *sort,
+                                 unsigned int                     id)
+{
+	size_t begin = sort->par_bounds[2 * id];
+	size_t nr = sort->par_bounds[(2 * id) + 1] - begin;
+	size_t sz = sort->par_size;
+
+	if (nr > 1)
+		farr_intro_sort(&sort->par_scratch[begin * sz], sz, nr,
+		                sort->par_compare, sort->par_copy);
+}
+
+static void farr_parallel_gather(const struct farr_parallel_sort *sort,
+                                 unsigned int                     id)
+{
+	size_t sz = sort->par_size;
+	size_t e;
+
+	for (e = farr_parallel_chunk(sort, id);
+	     e < farr_parallel_chunk(sort, id + 1);
+	     e++)
+		sort->par_copy(&sort->par_entries[e * sz],
+		               &sort->par_scratch[e * sz]);
+}
+
+/* Run given phase for all shares assigned to the worker. */
+static void farr_parallel_phase(struct farr_parallel_sort *sort,
+                                unsigned int               worker,
+                                farr_parallel_fn          *run)
+{
+	unsigned int id;
+
+	for (id = worker; id < sort->par_thread_nr; id += sort->par_worker_nr)
+		run(sort, id);
+}
+
+static void farr_parallel_work(struct farr_parallel_sort *sort,
+                               unsigned int               worker)
+{
+	farr_parallel_phase(sort, worker, farr_parallel_classify);
+	if (pthread_barrier_wait(&sort->par_barrier) ==
+	    PTHREAD_BARRIER_SERIAL_THREAD)
+		farr_parallel_offsets(sort);
+	pthread_barrier_wait(&sort->par_barrier);
+
+	farr_parallel_phase(sort, worker, farr_parallel_scatter);
+	pthread_barrier_wait(&sort->par_barrier);
+
+	farr_parallel_phase(sort, worker, farr_parallel_finish);
+	pthread_barrier_wait(&sort->par_barrier);
+
+	farr_parallel_phase(sort, worker, farr_parallel_gather);
+}
+
+static void * farr_parallel_start(void *arg)
+{
+	struct farr_parallel_worker *wrk = arg;
+	struct farr_parallel_sort   *sort = wrk->par_sort;
+
+	pthread_mutex_lock(&sort->par_gate);
+	pthread_mutex_unlock(&sort->par_gate);
+
+	/* Zero running workers means calling thread gave up. */
+	if (sort->par_worker_nr)
+		farr_parallel_work(sort, wrk->par_id);
+
+	return NULL;
+}
+
+/*
+ * Spawn workers once and run all phases. Shares no thread could be spawned
+ * for are handled by running workers.
+ * Return -1 when calling thread must sort on its own.
+ */
+static int farr_parallel_run(struct farr_parallel_sort *sort)
+{
+	struct farr_parallel_worker workers[sort->par_thread_nr];
+	unsigned int                w, nr;
+	int                         ret = -1;
+
+	if (pthread_mutex_init(&sort->par_gate, NULL))
+		return -1;
+
+	pthread_mutex_lock(&sort->par_gate);
+
+	for (nr = 1; nr < sort->par_thread_nr; nr++) {
+		workers[nr].par_sort = sort;
+		workers[nr].par_id = nr;
+		if (pthread_create(&workers[nr].par_thread, NULL,
+		                   farr_parallel_start, &workers[nr]))
+			break;
+	}
+
+	if (!pthread_barrier_init(&sort->par_barrier, NULL, nr)) {
+		sort->par_worker_nr = nr;
+		ret = 0;
+	}
+	else
+		sort->par_worker_nr = 0;
+
+	pthread_mutex_unlock(&sort->par_gate);
+
+	if (!ret)
+		farr_parallel_work(sort, 0);
+
+	for (w = 1; w < nr; w++)
+		pthread_join(workers[w].par_thread, NULL);
+
+	if (!ret)
+		pthread_barrier_destroy(&sort->par_barrier);
+	pthread_mutex_destroy(&sort->par_gate);
+
+	return ret;
+}
+
+/*
+ * Select (thread_nr - 1) splitters out of an evenly spaced sample of entries
+ * and store them at the beginning of sample area.
+ */
+static void farr_parallel_split(const struct farr_parallel_sort *sort,
+                                char                            *sample)
+{
+	unsigned int nr = sort->par_thread_nr * FARR_PARALLEL_OVERSAMPLE;
+	size_t       sz = sort->par_size;
+	unsigned int s;
+
+	for (s = 0; s < nr; s++) {
+		size_t e = ((sort->par_nr / nr) * s) +
+		           (((sort->par_nr % nr) * s) / nr);
+
+		sort->par_copy(&sample[s * sz], &sort->par_entries[e * sz]);
+	}
+
+	farr_intro_sort(sample, sz, nr, sort->par_compare, sort->par_copy);
+
+	for (s = 1; s < sort->par_thread_nr; s++)
+		sort->par_copy(&sample[(s - 1) * sz],
+		               &sample[s * FARR_PARALLEL_OVERSAMPLE * sz]);
+}
+
+void farr_parallel_sort(char            *entries,
+                        size_t           entry_size,
+                        size_t           entry_nr,
+                        farr_compare_fn *compare,
+                        farr_copy_fn    *copy,
+                        unsigned int     thread_nr)
+{
+	karn_assert(entries);
+	karn_assert(entry_size);
+	karn_assert(entry_nr);
+	karn_assert(compare);
+	karn_assert(copy);
+	karn_assert(thread_nr);
+
+	struct farr_parallel_sort sort;
+	char                     *sample;
+	int                       ret = -1;
+
+	thread_nr = umin(thread_nr, FARR_PARALLEL_THREAD_MAX);
+	if (thread_nr > (entry_nr / FARR_PARALLEL_MIN_NR))
+		thread_nr = (unsigned int)(entry_nr / FARR_PARALLEL_MIN_NR);
+	if (thread_nr <= 1)
+		goto serial;
+
+	sort.par_entries = entries;
+	sort.par_size = entry_size;
+	sort.par_nr = entry_nr;
+	sort.par_compare = compare;
+	sort.par_copy = copy;
+	sort.par_thread_nr = thread_nr;
+
+	sort.par_scratch = malloc(entry_size * entry_nr);
+	if (!sort.par_scratch)
+		goto serial;
+
+	sort.par_buckets = malloc(entry_nr * sizeof(sort.par_buckets[0]));
+	if (!sort.par_buckets)
+		goto free_scratch;
+
+	sort.par_counts = calloc(thread_nr * farr_parallel_bucket_nr(thread_nr),
+	                         sizeof(sort.par_counts[0]));
+	if (!sort.par_counts)
+		goto free_buckets;
+
+	sort.par_bounds = malloc((farr_parallel_bucket_nr(thread_nr) + 1) *
+	                         sizeof(sort.par_bounds[0]));
+	if (!sort.par_bounds)
+		goto free_counts;
+
+	sample = malloc(thread_nr * FARR_PARALLEL_OVERSAMPLE * entry_size);
+	if (!sample)
+		goto free_bounds;
+
+	farr_parallel_split(&sort, sample);
+	sort.par_splitters = sample;
+
+	ret = farr_parallel_run(&sort);
+
+	free(sample);
+free_bounds:
+	free(sort.par_bounds);
+free_counts:
+	free(sort.par_counts);
+free_buckets:
+	free(sort.par_buckets);
+free_scratch:
+	free(sort.par_scratch);
+
+	if (!ret)
+		return;
+
+serial:
+	farr_intro_sort(entries, entry_size, entry_nr, compare, copy);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_PARALLEL_SORT) */
+
+#if defined(CONFIG_KARN_FARR_GROW)
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+static bool farr_mapped(size_t size)
+{
+	return size >= FARR_MMAP_THRESHOLD;
+}
+
+static size_t farr_map_size(size_t size)
+{
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+	return (size + page - 1) & ~(page - 1);
+}
+
+static char * farr_map(size_t size)
+{
+	void *slots;
+
+	slots = mmap(NULL, farr_map_size(size), PROT_READ | PROT_WRITE,
+	             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	return (slots != MAP_FAILED) ? slots : NULL;
+}
+
+static void farr_unmap(char *slots, size_t size)
+{
+	munmap(slots, farr_map_size(size));
+}
+
+int farr_alloc(struct farr *array, size_t slot_size, size_t slot_nr)
+{
+	karn_assert(array);
+	karn_assert(slot_size);
+	karn_assert(slot_nr);
+
+	size_t  size = slot_size * slot_nr;
+	char   *slots;
+
+	if (size / slot_nr != slot_size)
+		return -ENOMEM;
+
+	if (farr_mapped(size))
+		slots = farr_map(size);
+	else
+		slots = malloc(size);
+	if (!slots)
+		return -ENOMEM;
+
+	farr_init(array, slots, slot_size, slot_nr);
+
+	return 0;
+}
+
+int farr_realloc(struct farr *array, size_t slot_nr)
+{
+	farr_assert(array);
+	karn_assert(slot_nr);
+
+	size_t  old = array->farr_size * array->farr_nr;
+	size_t  size = array->farr_size * slot_nr;
+	char   *slots;
+
+	if (size / slot_nr != array->farr_size)
+		return -ENOMEM;
+
+	if (farr_mapped(old) && farr_mapped(size)) {
+		/* Move page table entries instead of copying slots. */
+		slots = mremap(array->farr_slots, farr_map_size(old),
+		               farr_map_size(size), MREMAP_MAYMOVE);
+		if (slots == MAP_FAILED)
+			return -ENOMEM;
+	}
+	else if (!farr_mapped(old) && !farr_mapped(size)) {
+		slots = realloc(array->farr_slots, size);
+		if (!slots)
+			return -ENOMEM;
+	}
+	else {
+		/* Crossing threshold: switch storage kind. */
+		slots = farr_mapped(size) ? farr_map(size) : malloc(size);
+		if (!slots)
+			return -ENOMEM;
+
+		memcpy(slots, array->farr_slots, (old < size) ? old : size);
+
+		if (farr_mapped(old))
+			farr_unmap(array->farr_slots, old);
+		else
+			free(array->farr_slots);
+	}
+
+	array->farr_nr = slot_nr;
+	array->farr_slots = slots;
+
+	return 0;
+}
+
+void farr_free(struct farr *array)
+{
+	farr_assert(array);
+
+	size_t size = array->farr_size * array->farr_nr;
+
+	if (farr_mapped(size))
+		farr_unmap(array->farr_slots, size);
+	else
+		free(array->farr_slots);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_GROW) */
@@ -1,8 +1,8 @@
 #include <karn/fbmp.h>
 #include <utils/bitops.h>
 
-unsigned int
-fbmp_find_zero(const uintptr_t *bitmap, unsigned int nr)
+size_t
+fbmp_find_zero(const uintptr_t *bitmap, size_t nr)
 {
 	uintptr_t    word;
 	unsigned int idx;
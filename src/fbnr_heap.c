@@ -26,6 +26,8 @@
 
 #include <karn/fbnr_heap.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
 
 #if defined(CONFIG_KARN_FBNR_HEAP_UTILS)
 
@@ -34,17 +36,17 @@
 
 struct fbnr_heap_path {
 	char         *fbnr_pnode;
-	unsigned int  fbnr_cidx;
+	size_t        fbnr_cidx;
 	char         *fbnr_cnode;
 };
 
 static void fbnr_heap_inorder_path(const struct fabs_tree *tree,
                                    struct fbnr_heap_path  *path,
-                                   unsigned int            root_index,
+                                   size_t                  root_index,
                                    farr_compare_fn        *compare,
                                    bool                    regular)
 {
-	unsigned int ridx;
+	size_t ridx;
 
 	path->fbnr_pnode = fabs_tree_node(tree, root_index);
 	path->fbnr_cidx = fabs_tree_left_child_index(root_index);
@@ -69,13 +71,13 @@ static char * fbnr_heap_topdwn_siftdown(const struct fabs_tree      *tree,
                                         farr_copy_fn                *copy,
                                         bool                         regular)
 {
-	unsigned int  cnt = fabs_tree_count(tree);
+	size_t        cnt = fabs_tree_count(tree);
 	char         *empty = path->fbnr_pnode;
 	char         *sibling = path->fbnr_cnode;
-	unsigned int  sidx = path->fbnr_cidx;
+	size_t        sidx = path->fbnr_cidx;
 
 	do {
-		unsigned int  lidx;
+		size_t        lidx;
 		char         *left;
 
 		copy(empty, sibling);
@@ -103,7 +105,7 @@ static char * fbnr_heap_topdwn_siftdown(const struct fabs_tree      *tree,
 }
 
 static void fbnr_heap_build_tree(struct fabs_tree *tree,
-                                 unsigned int      count,
+                                 size_t            count,
                                  farr_compare_fn  *compare,
                                  farr_copy_fn     *copy,
                                  bool              regular)
@@ -111,7 +113,7 @@ static void fbnr_heap_build_tree(struct fabs_tree *tree,
 	karn_assert(count);
 	karn_assert(count <= fabs_tree_nr(tree));
 
-	unsigned int cnt = count / 2;
+	size_t cnt = count / 2;
 
 	/*
 	 * Update count immediatly to prevent siftdown from complaining about
@@ -152,7 +154,7 @@ void fbnr_heap_insert(struct fbnr_heap *heap, const char *node)
 	karn_assert(!fbnr_heap_full(heap));
 	karn_assert(node);
 
-	unsigned int     idx;
+	size_t           idx;
 	farr_compare_fn *cmp = heap->fbnr_compare;
 	farr_copy_fn    *cpy = heap->fbnr_copy;
 
@@ -166,7 +168,7 @@ void fbnr_heap_insert(struct fbnr_heap *heap, const char *node)
 		 * Bubble next free slot up as long as node to insert is not
 		 * heap ordered.
 		 */
-		unsigned int  pidx;
+		size_t        pidx;
 		const char   *pnode;
 
 		pidx = fabs_tree_parent_index(idx);
@@ -186,6 +188,34 @@ void fbnr_heap_insert(struct fbnr_heap *heap, const char *node)
 	fabs_tree_credit(&heap->fbnr_tree);
 }
 
+/*
+ * Sift last node down into the hole left at root by extraction of first node.
+ * Last node slot is released by caller afterwards.
+ */
+static void fbnr_heap_sift_last(const struct fbnr_heap *heap)
+{
+	karn_assert(fabs_tree_count(&heap->fbnr_tree) > 1);
+
+	struct fbnr_heap_path  path;
+	const char            *last;
+	char                  *node;
+
+	fbnr_heap_inorder_path(&heap->fbnr_tree, &path, FABS_TREE_ROOT_INDEX,
+	                       heap->fbnr_compare, FBNR_HEAP_REGULAR_ORDER);
+
+	last = fabs_tree_last(&heap->fbnr_tree);
+
+	if (heap->fbnr_compare(path.fbnr_cnode, last) < 0)
+		node = fbnr_heap_topdwn_siftdown(&heap->fbnr_tree, &path, last,
+		                                 heap->fbnr_compare,
+		                                 heap->fbnr_copy,
+		                                 FBNR_HEAP_REGULAR_ORDER);
+	else
+		node = path.fbnr_pnode;
+
+	heap->fbnr_copy(node, last);
+}
+
 void fbnr_heap_extract(struct fbnr_heap *heap, char *node)
 {
 	karn_assert(!fbnr_heap_empty(heap));
@@ -193,34 +223,118 @@ void fbnr_heap_extract(struct fbnr_heap *heap, char *node)
 
 	heap->fbnr_copy(node, fabs_tree_root(&heap->fbnr_tree));
 
+	if (fabs_tree_count(&heap->fbnr_tree) > 1)
+		fbnr_heap_sift_last(heap);
+
+	/* Update count of present nodes. */
+	fabs_tree_debit(&heap->fbnr_tree);
+}
+
+void fbnr_heap_replace(struct fbnr_heap *heap, const char *node)
+{
+	karn_assert(!fbnr_heap_empty(heap));
+	karn_assert(node);
+
+	char *slot = fabs_tree_root(&heap->fbnr_tree);
+
 	if (fabs_tree_count(&heap->fbnr_tree) > 1) {
-		struct fbnr_heap_path  path;
-		const char            *last;
+		struct fbnr_heap_path path;
 
 		fbnr_heap_inorder_path(&heap->fbnr_tree, &path,
 		                       FABS_TREE_ROOT_INDEX,
 		                       heap->fbnr_compare,
 		                       FBNR_HEAP_REGULAR_ORDER);
 
-		last = fabs_tree_last(&heap->fbnr_tree);
-
-		if (heap->fbnr_compare(path.fbnr_cnode, last) < 0)
-			node = fbnr_heap_topdwn_siftdown(&heap->fbnr_tree,
-			                                 &path, last,
+		if (heap->fbnr_compare(path.fbnr_cnode, node) < 0)
+			slot = fbnr_heap_topdwn_siftdown(&heap->fbnr_tree,
+			                                 &path, node,
 			                                 heap->fbnr_compare,
 			                                 heap->fbnr_copy,
 			                                 FBNR_HEAP_REGULAR_ORDER);
-		else
-			node = path.fbnr_pnode;
+	}
+
+	heap->fbnr_copy(slot, node);
+}
 
-		heap->fbnr_copy(node, last);
+void fbnr_heap_insert_batch(struct fbnr_heap *heap,
+                            const char       *nodes,
+                            size_t            nr)
+{
+	fbnr_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(nr <= (fbnr_heap_nr(heap) - fbnr_heap_count(heap)));
+
+	size_t cnt = fabs_tree_count(&heap->fbnr_tree);
+	size_t size = fabs_tree_node_size(&heap->fbnr_tree);
+	size_t idx;
+
+	if (!nr)
+		return;
+
+	if (nr < cnt) {
+		/*
+		 * Small batch: sifting up is cheaper than visiting all nodes,
+		 * especially since most nodes stop close to the bottom.
+		 */
+		while (nr--) {
+			fbnr_heap_insert(heap, nodes);
+			nodes += size;
+		}
+
+		return;
 	}
 
-	/* Update count of present nodes. */
-	fabs_tree_debit(&heap->fbnr_tree);
+	/* Large batch: append nodes then rebuild the whole heap. */
+	for (idx = cnt; idx < (cnt + nr); idx++, nodes += size)
+		heap->fbnr_copy(fabs_tree_node(&heap->fbnr_tree, idx), nodes);
+
+	fbnr_heap_build_tree(&heap->fbnr_tree, cnt + nr, heap->fbnr_compare,
+	                     heap->fbnr_copy, FBNR_HEAP_REGULAR_ORDER);
 }
 
-void fbnr_heap_build(struct fbnr_heap *heap, unsigned int count)
+size_t fbnr_heap_extract_batch(struct fbnr_heap *heap,
+                               char             *nodes,
+                               size_t            nr)
+{
+	fbnr_heap_assert(heap);
+	karn_assert(nodes || !nr);
+
+	struct fabs_tree *tree = &heap->fbnr_tree;
+	size_t            size = fabs_tree_node_size(tree);
+	char              tmp[size];
+	size_t            n;
+
+	if (nr > fabs_tree_count(tree))
+		nr = fabs_tree_count(tree);
+
+	/*
+	 * Run nr steps of heapsort: each first node is moved into the tail
+	 * slot its extraction releases once the last node has been sifted
+	 * down. Tail slots end up holding extracted nodes in reverse order and
+	 * are copied out in a single pass.
+	 */
+	for (n = 0; n < nr; n++) {
+		char *last = fabs_tree_last(tree);
+
+		heap->fbnr_copy(tmp, fabs_tree_root(tree));
+
+		if (fabs_tree_count(tree) > 1)
+			fbnr_heap_sift_last(heap);
+
+		heap->fbnr_copy(last, tmp);
+		fabs_tree_debit(tree);
+	}
+
+	while (n--) {
+		heap->fbnr_copy(nodes,
+		                fabs_tree_node(tree, fabs_tree_count(tree) + n));
+		nodes += size;
+	}
+
+	return nr;
+}
+
+void fbnr_heap_build(struct fbnr_heap *heap, size_t count)
 {
 	fbnr_heap_assert(heap);
 
@@ -231,7 +345,7 @@ void fbnr_heap_build(struct fbnr_heap *heap, unsigned int count)
 void fbnr_heap_init(struct fbnr_heap *heap,
                     char             *nodes,
                     size_t            node_size,
-                    unsigned int      node_nr,
+                    size_t            node_nr,
                     farr_compare_fn  *compare,
                     farr_copy_fn     *copy)
 {
@@ -253,7 +367,7 @@ void fbnr_heap_fini(struct fbnr_heap *heap __unused)
 }
 
 struct fbnr_heap * fbnr_heap_create(size_t           node_size,
-                                    unsigned int     node_nr,
+                                    size_t           node_nr,
                                     farr_compare_fn *compare,
                                     farr_copy_fn    *copy)
 {
@@ -279,16 +393,97 @@ void fbnr_heap_destroy(struct fbnr_heap *heap)
 	free(heap);
 }
 
+#if defined(CONFIG_KARN_FBNR_HEAP_GROW)
+
+int fbnr_heap_init_grow(struct fbnr_heap *heap,
+                        size_t            node_size,
+                        size_t            node_nr,
+                        farr_compare_fn  *compare,
+                        farr_copy_fn     *copy)
+{
+	karn_assert(heap);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	int err;
+
+	err = farr_alloc(&heap->fbnr_tree.fabs_nodes, node_size, node_nr);
+	if (err)
+		return err;
+
+	heap->fbnr_compare = compare;
+	heap->fbnr_copy = copy;
+	heap->fbnr_tree.fabs_count = 0;
+
+	return 0;
+}
+
+void fbnr_heap_fini_grow(struct fbnr_heap *heap)
+{
+	fbnr_heap_assert(heap);
+
+	farr_free(&heap->fbnr_tree.fabs_nodes);
+}
+
+int fbnr_heap_reserve(struct fbnr_heap *heap, size_t nr)
+{
+	fbnr_heap_assert(heap);
+
+	if (nr <= fbnr_heap_nr(heap))
+		return 0;
+
+	return farr_realloc(&heap->fbnr_tree.fabs_nodes, nr);
+}
+
+int fbnr_heap_insert_grow(struct fbnr_heap *heap, const char *node)
+{
+	if (fbnr_heap_full(heap)) {
+		size_t nr = fbnr_heap_nr(heap);
+		int    err;
+
+		if (nr > (SIZE_MAX / 2))
+			return -ENOMEM;
+
+		err = farr_realloc(&heap->fbnr_tree.fabs_nodes, 2 * nr);
+		if (err)
+			return err;
+	}
+
+	fbnr_heap_insert(heap, node);
+
+	return 0;
+}
+
+void fbnr_heap_extract_shrink(struct fbnr_heap *heap,
+                              char             *node,
+                              size_t            min_nr)
+{
+	size_t nr;
+
+	fbnr_heap_extract(heap, node);
+
+	/*
+	 * Halve capacity at quarter occupancy: giving growing room back to
+	 * half of it keeps alternating insertions and extractions from
+	 * resizing repeatedly. Failing to shrink is harmless.
+	 */
+	nr = fbnr_heap_nr(heap) / 2;
+	if ((fbnr_heap_count(heap) <= (nr / 2)) && (nr >= min_nr) && nr)
+		farr_realloc(&heap->fbnr_tree.fabs_nodes, nr);
+}
+
+#endif /* defined(CONFIG_KARN_FBNR_HEAP_GROW) */
+
 #if defined(CONFIG_KARN_FBNR_HEAP_SORT)
 
 static void fbnr_heap_botup_siftdown(const struct fabs_tree *tree,
                                      const char             *node,
-                                     unsigned int            count,
+                                     size_t                  count,
                                      farr_compare_fn        *compare,
                                      farr_copy_fn           *copy)
 {
-	unsigned int  eidx = FABS_TREE_ROOT_INDEX;
-	unsigned int  idx;
+	size_t        eidx = FABS_TREE_ROOT_INDEX;
+	size_t        idx;
 	char         *empty;
 	unsigned int  depth;
 
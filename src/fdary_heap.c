@@ -0,0 +1,474 @@
+/**
+ * @file      fdary_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based d-ary heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fdary_heap.h>
+#include <stdint.h>
+
+#define FDARY_HEAP_REGULAR_ORDER (true)
+#define FDARY_HEAP_REVERSE_ORDER (false)
+
+static inline size_t fdary_heap_first_child_index(size_t       index,
+                                                  unsigned int shift)
+{
+	return (index << shift) + 1;
+}
+
+static inline size_t fdary_heap_parent_index(size_t index, unsigned int shift)
+{
+	karn_assert(index != FABS_TREE_ROOT_INDEX);
+
+	return (index - 1) >> shift;
+}
+
+static inline unsigned int fdary_heap_arity_shift(unsigned int arity)
+{
+	karn_assert(arity > 1);
+	karn_assert(arity <= FDARY_HEAP_ARITY_MAX);
+	karn_assert(!(arity & (arity - 1)));
+
+	return farr_log2_lower(arity);
+}
+
+/*
+ * Return index of first ordered child out of the group of siblings starting at
+ * index, considering the count first nodes of tree only. Siblings are
+ * contiguous and should sit into a single cache line.
+ */
+static size_t fdary_heap_select_child(const struct fabs_tree *tree,
+                                      size_t                  index,
+                                      size_t                  count,
+                                      unsigned int            shift,
+                                      farr_compare_fn        *compare,
+                                      bool                    regular)
+{
+	karn_assert(index < count);
+
+	size_t      size = fabs_tree_node_size(tree);
+	size_t      cidx = index;
+	size_t      cnt = count - index;
+	const char *child = fabs_tree_node(tree, index);
+	const char *sibling;
+
+	if (cnt > ((size_t)1 << shift))
+		cnt = (size_t)1 << shift;
+
+	for (sibling = child + size; --cnt; sibling += size) {
+		index++;
+		if ((compare(sibling, child) < 0) == regular) {
+			child = sibling;
+			cidx = index;
+		}
+	}
+
+	return cidx;
+}
+
+/*
+ * Move the hole located at index down to where node may be stored without
+ * breaking heap property, i.e. shift heap ordered children up along the way.
+ * Only the count first nodes of tree are considered.
+ *
+ * Return the hole location where caller should store node into.
+ */
+static char * fdary_heap_topdwn_siftdown(const struct fabs_tree *tree,
+                                         size_t                  index,
+                                         const char             *node,
+                                         size_t                  count,
+                                         unsigned int            shift,
+                                         farr_compare_fn        *compare,
+                                         farr_copy_fn           *copy,
+                                         bool                    regular)
+{
+	char *hole = fabs_tree_node(tree, index);
+
+	while (true) {
+		char *child;
+
+		index = fdary_heap_first_child_index(index, shift);
+		if (index >= count)
+			break;
+
+		index = fdary_heap_select_child(tree, index, count, shift,
+		                                compare, regular);
+		child = fabs_tree_node(tree, index);
+		if ((compare(child, node) < 0) != regular)
+			break;
+
+		copy(hole, child);
+		hole = child;
+	}
+
+	return hole;
+}
+
+/*
+ * Bottom-up variant of the above starting from root: move the hole down to a
+ * leaf along the path of ordered children without comparing them against
+ * node, then move it back up to where node fits. Since node usually comes from
+ * the bottom of the heap, it saves a comparison per level at the cost of a few
+ * ones on the way back up.
+ */
+static char * fdary_heap_botup_siftdown(const struct fabs_tree *tree,
+                                        const char             *node,
+                                        size_t                  count,
+                                        unsigned int            shift,
+                                        farr_compare_fn        *compare,
+                                        farr_copy_fn           *copy,
+                                        bool                    regular)
+{
+	size_t  idx = FABS_TREE_ROOT_INDEX;
+	char   *hole = fabs_tree_node(tree, idx);
+
+	while (true) {
+		size_t  cidx = fdary_heap_first_child_index(idx, shift);
+		char   *child;
+
+		if (cidx >= count)
+			break;
+
+		idx = fdary_heap_select_child(tree, cidx, count, shift,
+		                              compare, regular);
+		child = fabs_tree_node(tree, idx);
+
+		copy(hole, child);
+		hole = child;
+	}
+
+	while (idx != FABS_TREE_ROOT_INDEX) {
+		size_t  pidx = fdary_heap_parent_index(idx, shift);
+		char   *parent = fabs_tree_node(tree, pidx);
+
+		if ((compare(node, parent) < 0) != regular)
+			break;
+
+		copy(hole, parent);
+		hole = parent;
+		idx = pidx;
+	}
+
+	return hole;
+}
+
+static void fdary_heap_build_tree(struct fabs_tree *tree,
+                                  size_t            count,
+                                  unsigned int      shift,
+                                  farr_compare_fn  *compare,
+                                  farr_copy_fn     *copy,
+                                  bool              regular)
+{
+	karn_assert(count);
+	karn_assert(count <= fabs_tree_nr(tree));
+
+	size_t idx;
+
+	tree->fabs_count = count;
+	if (count == 1)
+		return;
+
+	/*
+	 * Starting from the last internal node and moving upwards, shift the
+	 * root of each subtree downward as in the extraction algorithm until
+	 * the heap property is restored.
+	 */
+	idx = fdary_heap_parent_index(count - 1, shift) + 1;
+	while (idx--) {
+		char  tmp[fabs_tree_node_size(tree)];
+		char *node;
+
+		copy(tmp, fabs_tree_node(tree, idx));
+
+		node = fdary_heap_topdwn_siftdown(tree, idx, tmp, count, shift,
+		                                  compare, copy, regular);
+
+		copy(node, tmp);
+	}
+}
+
+void fdary_heap_insert(struct fdary_heap *heap, const char *node)
+{
+	karn_assert(!fdary_heap_full(heap));
+	karn_assert(node);
+
+	size_t           idx;
+	unsigned int     shift = heap->fdary_shift;
+	farr_compare_fn *cmp = heap->fdary_compare;
+	farr_copy_fn    *cpy = heap->fdary_copy;
+
+	idx = fabs_tree_bottom_index(&heap->fdary_tree);
+	while (idx != FABS_TREE_ROOT_INDEX) {
+		/*
+		 * Bubble next free slot up as long as node to insert is not
+		 * heap ordered.
+		 */
+		size_t      pidx;
+		const char *pnode;
+
+		pidx = fdary_heap_parent_index(idx, shift);
+		pnode = fabs_tree_node(&heap->fdary_tree, pidx);
+		if (cmp(pnode, node) <= 0)
+			break;
+
+		cpy(fabs_tree_node(&heap->fdary_tree, idx), pnode);
+
+		idx = pidx;
+	}
+
+	cpy(fabs_tree_node(&heap->fdary_tree, idx), node);
+
+	fabs_tree_credit(&heap->fdary_tree);
+}
+
+void fdary_heap_extract(struct fdary_heap *heap, char *node)
+{
+	karn_assert(!fdary_heap_empty(heap));
+	karn_assert(node);
+
+	size_t cnt = fabs_tree_count(&heap->fdary_tree) - 1;
+
+	heap->fdary_copy(node, fabs_tree_root(&heap->fdary_tree));
+
+	if (cnt) {
+		/*
+		 * Sift last node down from root, ignoring its own slot which
+		 * is released.
+		 */
+		const char *last = fabs_tree_last(&heap->fdary_tree);
+
+		node = fdary_heap_botup_siftdown(&heap->fdary_tree, last, cnt,
+		                                 heap->fdary_shift,
+		                                 heap->fdary_compare,
+		                                 heap->fdary_copy,
+		                                 FDARY_HEAP_REGULAR_ORDER);
+
+		heap->fdary_copy(node, last);
+	}
+
+	fabs_tree_debit(&heap->fdary_tree);
+}
+
+void fdary_heap_insert_batch(struct fdary_heap *heap,
+                             const char        *nodes,
+                             size_t             nr)
+{
+	fdary_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(nr <= (fdary_heap_nr(heap) - fdary_heap_count(heap)));
+
+	size_t cnt = fabs_tree_count(&heap->fdary_tree);
+	size_t size = fabs_tree_node_size(&heap->fdary_tree);
+	size_t idx;
+
+	if (!nr)
+		return;
+
+	if (nr < cnt) {
+		/* Small batch: sift nodes up one by one. */
+		while (nr--) {
+			fdary_heap_insert(heap, nodes);
+			nodes += size;
+		}
+
+		return;
+	}
+
+	/* Large batch: append nodes then rebuild the whole heap. */
+	for (idx = cnt; idx < (cnt + nr); idx++, nodes += size)
+		heap->fdary_copy(fabs_tree_node(&heap->fdary_tree, idx),
+		                 nodes);
+
+	fdary_heap_build_tree(&heap->fdary_tree, cnt + nr, heap->fdary_shift,
+	                      heap->fdary_compare, heap->fdary_copy,
+	                      FDARY_HEAP_REGULAR_ORDER);
+}
+
+size_t fdary_heap_extract_batch(struct fdary_heap *heap,
+                                char              *nodes,
+                                size_t             nr)
+{
+	fdary_heap_assert(heap);
+	karn_assert(nodes || !nr);
+
+	struct fabs_tree *tree = &heap->fdary_tree;
+	size_t            cnt = fabs_tree_count(tree);
+	size_t            size = fabs_tree_node_size(tree);
+	char              tmp[size];
+	size_t            n;
+
+	if (nr > cnt)
+		nr = cnt;
+
+	/*
+	 * Sift the last node down from root, ignoring its own slot, then park
+	 * first node into it as heapsort does. Once nr steps are done, tail
+	 * slots hold extracted nodes in reverse order.
+	 */
+	for (n = 0; n < nr; n++) {
+		char *last = fabs_tree_node(tree, --cnt);
+
+		heap->fdary_copy(tmp, fabs_tree_root(tree));
+
+		if (cnt) {
+			char *hole;
+
+			hole = fdary_heap_botup_siftdown(tree, last, cnt,
+			                                 heap->fdary_shift,
+			                                 heap->fdary_compare,
+			                                 heap->fdary_copy,
+			                                 FDARY_HEAP_REGULAR_ORDER);
+			heap->fdary_copy(hole, last);
+		}
+
+		heap->fdary_copy(last, tmp);
+	}
+
+	tree->fabs_count = cnt;
+
+	while (n--) {
+		heap->fdary_copy(nodes, fabs_tree_node(tree, cnt + n));
+		nodes += size;
+	}
+
+	return nr;
+}
+
+void fdary_heap_build(struct fdary_heap *heap, size_t count)
+{
+	fdary_heap_assert(heap);
+
+	fdary_heap_build_tree(&heap->fdary_tree, count, heap->fdary_shift,
+	                      heap->fdary_compare, heap->fdary_copy,
+	                      FDARY_HEAP_REGULAR_ORDER);
+}
+
+void fdary_heap_init(struct fdary_heap *heap,
+                     char              *nodes,
+                     size_t             node_size,
+                     size_t             node_nr,
+                     unsigned int       arity,
+                     farr_compare_fn   *compare,
+                     farr_copy_fn      *copy)
+{
+	karn_assert(heap);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	heap->fdary_compare = compare;
+	heap->fdary_copy = copy;
+	heap->fdary_shift = fdary_heap_arity_shift(arity);
+
+	fabs_tree_init(&heap->fdary_tree, nodes, node_size, node_nr);
+}
+
+void fdary_heap_fini(struct fdary_heap *heap __unused)
+{
+	karn_assert(heap);
+
+	fabs_tree_fini(&heap->fdary_tree);
+}
+
+struct fdary_heap * fdary_heap_create(size_t           node_size,
+                                      size_t           node_nr,
+                                      unsigned int     arity,
+                                      farr_compare_fn *compare,
+                                      farr_copy_fn    *copy)
+{
+	karn_assert(node_size);
+	karn_assert(node_nr);
+
+	struct fdary_heap *heap;
+	uintptr_t          nodes;
+
+	heap = malloc(sizeof(*heap) + (FDARY_HEAP_LINE_SIZE - 1) +
+	              (node_size * node_nr));
+	if (!heap)
+		return NULL;
+
+	/*
+	 * Place root node right before a cache line boundary so that groups of
+	 * siblings, i.e. starting at index d*i + 1, are cache line aligned.
+	 */
+	nodes = ((uintptr_t)&heap[1] + node_size +
+	         (FDARY_HEAP_LINE_SIZE - 1)) &
+	        ~((uintptr_t)FDARY_HEAP_LINE_SIZE - 1);
+	nodes -= node_size;
+
+	fdary_heap_init(heap, (char *)nodes, node_size, node_nr, arity,
+	                compare, copy);
+
+	return heap;
+}
+
+void fdary_heap_destroy(struct fdary_heap *heap)
+{
+	fdary_heap_fini(heap);
+
+	free(heap);
+}
+
+#if defined(CONFIG_KARN_FDARY_HEAP_SORT)
+
+void fdary_heap_sort(char            *entries,
+                     size_t           entry_size,
+                     size_t           entry_nr,
+                     unsigned int     arity,
+                     farr_compare_fn *compare,
+                     farr_copy_fn    *copy)
+{
+	if (entry_nr > 1) {
+		struct fabs_tree  tree;
+		unsigned int      shift = fdary_heap_arity_shift(arity);
+		char             *last;
+		char              tmp[entry_size];
+
+		fabs_tree_init(&tree, entries, entry_size, entry_nr);
+
+		/* Build a max-heap so that greatest entries are moved last. */
+		fdary_heap_build_tree(&tree, entry_nr, shift, compare, copy,
+		                      FDARY_HEAP_REVERSE_ORDER);
+
+		last = &entries[(entry_nr - 1) * entry_size];
+
+		do {
+			char *node;
+
+			entry_nr--;
+
+			copy(tmp, last);
+			copy(last, fabs_tree_root(&tree));
+
+			node = fdary_heap_botup_siftdown(&tree, tmp, entry_nr,
+			                                 shift, compare, copy,
+			                                 FDARY_HEAP_REVERSE_ORDER);
+			copy(node, tmp);
+
+			last -= entry_size;
+		} while (entry_nr > 1);
+
+		fabs_tree_fini(&tree);
+	}
+}
+
+#endif /* defined(CONFIG_KARN_FDARY_HEAP_SORT) */
@@ -0,0 +1,362 @@
+/**
+ * @file      feyt_tree.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based Eytzinger search tree implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/feyt_tree.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * Internally, nodes are located using 1-based ranks, i.e. fabs_tree index + 1,
+ * so that children of rank r are found at ranks 2r and 2r + 1. Descending one
+ * level is then a matter of appending the comparison result bit to the rank.
+ */
+
+#define FEYT_TREE_LOWER_BOUND (0)
+#define FEYT_TREE_UPPER_BOUND (1)
+
+static inline const char * feyt_tree_rank_node(const char *slots,
+                                               size_t      size,
+                                               size_t      rank)
+{
+	return &slots[(rank - 1) * size];
+}
+
+static inline void feyt_tree_prefetch(const char *slots,
+                                      size_t      size,
+                                      size_t      rank)
+{
+	/*
+	 * Prefetching never faults: no need to check whether rank lies within
+	 * tree bounds. Address is computed as an integer so that no out of
+	 * bounds pointer is ever formed.
+	 */
+	__builtin_prefetch((const void *)((uintptr_t)slots + ((rank - 1) * size)));
+}
+
+/*
+ * Move down one level: go right when node is ordered before key (lower bound)
+ * or when node is not ordered after key (upper bound).
+ */
+static inline size_t feyt_tree_step(const char      *slots,
+                                    size_t           size,
+                                    size_t           rank,
+                                    const char      *key,
+                                    farr_compare_fn *compare,
+                                    int              bound)
+{
+	return (2 * rank) +
+	       (compare(feyt_tree_rank_node(slots, size, rank), key) < bound);
+}
+
+/*
+ * Once descent has fallen off the tree, the searched node is the last one
+ * where descent went left: strip trailing right moves (1 bits) and the last
+ * left move (0 bit). A null rank means all nodes were ordered before key.
+ */
+static inline size_t feyt_tree_resolve(size_t rank)
+{
+	return rank >> (__builtin_ctzl(~rank) + 1);
+}
+
+static char * feyt_tree_rank_result(const struct feyt_tree *tree,
+                                    size_t                  rank,
+                                    const char             *key,
+                                    bool                    exact)
+{
+	char *node;
+
+	rank = feyt_tree_resolve(rank);
+	if (!rank)
+		return NULL;
+
+	node = fabs_tree_node(&tree->feyt_tree, rank - 1);
+	if (exact && tree->feyt_compare(node, key))
+		return NULL;
+
+	return node;
+}
+
+static size_t feyt_tree_descend(const struct feyt_tree *tree,
+                                const char             *key,
+                                int                     bound)
+{
+	const char      *slots = tree->feyt_tree.fabs_nodes.farr_slots;
+	size_t           size = fabs_tree_node_size(&tree->feyt_tree);
+	size_t           nr = fabs_tree_count(&tree->feyt_tree);
+	unsigned int     pref = tree->feyt_pref;
+	farr_compare_fn *compare = tree->feyt_compare;
+	size_t           rank = FABS_TREE_ROOT_INDEX + 1;
+
+	while (rank <= nr) {
+		/* Fetch first of the 2^pref descendants pref levels below. */
+		feyt_tree_prefetch(slots, size, rank << pref);
+		rank = feyt_tree_step(slots, size, rank, key, compare, bound);
+	}
+
+	return rank;
+}
+
+char * feyt_tree_lower_bound(const struct feyt_tree *tree, const char *key)
+{
+	feyt_tree_assert(tree);
+
+	return feyt_tree_rank_result(tree,
+	                             feyt_tree_descend(tree,
+	                                               key,
+	                                               FEYT_TREE_LOWER_BOUND),
+	                             key,
+	                             false);
+}
+
+char * feyt_tree_upper_bound(const struct feyt_tree *tree, const char *key)
+{
+	feyt_tree_assert(tree);
+
+	return feyt_tree_rank_result(tree,
+	                             feyt_tree_descend(tree,
+	                                               key,
+	                                               FEYT_TREE_UPPER_BOUND),
+	                             key,
+	                             false);
+}
+
+char * feyt_tree_find(const struct feyt_tree *tree, const char *key)
+{
+	feyt_tree_assert(tree);
+
+	return feyt_tree_rank_result(tree,
+	                             feyt_tree_descend(tree,
+	                                               key,
+	                                               FEYT_TREE_LOWER_BOUND),
+	                             key,
+	                             true);
+}
+
+/*
+ * Interleave lower bound descents of a batch of keys. All levels but the
+ * deepest one are complete, so that every descent may be moved down
+ * unconditionally until the last level. Each step prefetches the node the
+ * next step of the same key will compare, leaving the time required to
+ * process other keys of the batch for the fetch to complete.
+ */
+static void feyt_tree_batch(const struct feyt_tree  *tree,
+                            const char              *keys,
+                            size_t                   key_size,
+                            size_t                   key_nr,
+                            char                   **nodes,
+                            bool                     exact)
+{
+	const char      *slots = tree->feyt_tree.fabs_nodes.farr_slots;
+	size_t           size = fabs_tree_node_size(&tree->feyt_tree);
+	size_t           nr = fabs_tree_count(&tree->feyt_tree);
+	unsigned int     full = farr_log2_lower(nr + 1);
+	farr_compare_fn *compare = tree->feyt_compare;
+
+	while (key_nr) {
+		size_t       ranks[FEYT_TREE_BATCH_NR];
+		size_t       cnt = (key_nr < FEYT_TREE_BATCH_NR) ?
+		                   key_nr : FEYT_TREE_BATCH_NR;
+		size_t       k;
+		unsigned int l;
+
+		for (k = 0; k < cnt; k++)
+			ranks[k] = FABS_TREE_ROOT_INDEX + 1;
+
+		for (l = 0; l < full; l++) {
+			for (k = 0; k < cnt; k++) {
+				size_t rank;
+
+				rank = feyt_tree_step(slots,
+				                      size,
+				                      ranks[k],
+				                      &keys[k * key_size],
+				                      compare,
+				                      FEYT_TREE_LOWER_BOUND);
+				feyt_tree_prefetch(slots, size, rank);
+				ranks[k] = rank;
+			}
+		}
+
+		for (k = 0; k < cnt; k++) {
+			const char *key = &keys[k * key_size];
+
+			if (ranks[k] <= nr)
+				ranks[k] = feyt_tree_step(slots,
+				                          size,
+				                          ranks[k],
+				                          key,
+				                          compare,
+				                          FEYT_TREE_LOWER_BOUND);
+
+			nodes[k] = feyt_tree_rank_result(tree, ranks[k], key,
+			                                 exact);
+		}
+
+		keys += cnt * key_size;
+		nodes += cnt;
+		key_nr -= cnt;
+	}
+}
+
+void feyt_tree_lower_bound_batch(const struct feyt_tree  *tree,
+                                 const char              *keys,
+                                 size_t                   key_size,
+                                 size_t                   key_nr,
+                                 char                   **nodes)
+{
+	feyt_tree_assert(tree);
+	karn_assert(keys || !key_nr);
+	karn_assert(key_size);
+	karn_assert(nodes || !key_nr);
+
+	feyt_tree_batch(tree, keys, key_size, key_nr, nodes, false);
+}
+
+void feyt_tree_find_batch(const struct feyt_tree  *tree,
+                          const char              *keys,
+                          size_t                   key_size,
+                          size_t                   key_nr,
+                          char                   **nodes)
+{
+	feyt_tree_assert(tree);
+	karn_assert(keys || !key_nr);
+	karn_assert(key_size);
+	karn_assert(nodes || !key_nr);
+
+	feyt_tree_batch(tree, keys, key_size, key_nr, nodes, true);
+}
+
+void feyt_tree_build(struct feyt_tree *tree,
+                     const char       *entries,
+                     size_t            entry_nr)
+{
+	feyt_tree_assert(tree);
+	karn_assert(entries || !entry_nr);
+	karn_assert(entry_nr <= fabs_tree_nr(&tree->feyt_tree));
+
+	char         *slots = tree->feyt_tree.fabs_nodes.farr_slots;
+	size_t        size = fabs_tree_node_size(&tree->feyt_tree);
+	farr_copy_fn *copy = tree->feyt_copy;
+	size_t        rank;
+	size_t        e;
+
+	tree->feyt_tree.fabs_count = entry_nr;
+	if (!entry_nr)
+		return;
+
+	/* Start from leftmost node, i.e. the smallest one. */
+	rank = (size_t)1 << farr_log2_lower(entry_nr);
+
+	for (e = 0; e < entry_nr; e++) {
+		karn_assert(!e ||
+		            (tree->feyt_compare(&entries[(e - 1) * size],
+		                                &entries[e * size]) <= 0));
+
+		copy(&slots[(rank - 1) * size], &entries[e * size]);
+
+		/* Move on to in-order successor. */
+		if (((2 * rank) + 1) <= entry_nr) {
+			/* Leftmost node of right subtree. */
+			rank = (2 * rank) + 1;
+			rank <<= farr_log2_lower(entry_nr / rank);
+		}
+		else
+			/* Closest ancestor current node is a left descendant of. */
+			rank = feyt_tree_resolve(rank);
+	}
+
+	karn_assert(!rank);
+}
+
+void feyt_tree_init(struct feyt_tree *tree,
+                    char             *nodes,
+                    size_t            node_size,
+                    size_t            node_nr,
+                    farr_compare_fn  *compare,
+                    farr_copy_fn     *copy)
+{
+	karn_assert(tree);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	/*
+	 * Prefetch as many levels ahead as there are descendants fitting into a
+	 * single cache line.
+	 */
+	if (node_size <= (FEYT_TREE_LINE_SIZE / 2))
+		tree->feyt_pref = farr_log2_lower(FEYT_TREE_LINE_SIZE /
+		                                  node_size);
+	else
+		tree->feyt_pref = 1;
+
+	tree->feyt_compare = compare;
+	tree->feyt_copy = copy;
+
+	fabs_tree_init(&tree->feyt_tree, nodes, node_size, node_nr);
+}
+
+void feyt_tree_fini(struct feyt_tree *tree __unused)
+{
+	feyt_tree_assert(tree);
+
+	fabs_tree_fini(&tree->feyt_tree);
+}
+
+struct feyt_tree * feyt_tree_create(size_t           node_size,
+                                    size_t           node_nr,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	karn_assert(node_size);
+	karn_assert(node_nr);
+
+	struct feyt_tree *tree;
+	uintptr_t         nodes;
+
+	tree = malloc(sizeof(*tree) + (FEYT_TREE_LINE_SIZE - 1) +
+	              (node_size * (node_nr + 1)));
+	if (!tree)
+		return NULL;
+
+	/*
+	 * Place nodes one node past a cache line boundary so that blocks of
+	 * descendants sharing the same ancestor are cache line aligned.
+	 */
+	nodes = ((uintptr_t)&tree[1] + (FEYT_TREE_LINE_SIZE - 1)) &
+	        ~((uintptr_t)FEYT_TREE_LINE_SIZE - 1);
+	nodes += node_size;
+
+	feyt_tree_init(tree, (char *)nodes, node_size, node_nr, compare, copy);
+
+	return tree;
+}
+
+void feyt_tree_destroy(struct feyt_tree *tree)
+{
+	feyt_tree_fini(tree);
+
+	free(tree);
+}
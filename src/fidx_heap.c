@@ -0,0 +1,322 @@
+/**
+ * @file      fidx_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based indexed binary heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fidx_heap.h>
+#include <limits.h>
+#include <errno.h>
+
+/*
+ * Move node hosted at src slot into dst slot and keep identifier to slot map
+ * in sync.
+ */
+static inline void fidx_heap_move(struct fidx_heap *heap,
+                                  size_t            dst,
+                                  size_t            src)
+{
+	unsigned int id = heap->fidx_ids[src];
+
+	heap->fidx_copy(fabs_tree_node(&heap->fidx_tree, dst),
+	                fabs_tree_node(&heap->fidx_tree, src));
+	heap->fidx_ids[dst] = id;
+	heap->fidx_slots[id] = (unsigned int)dst;
+}
+
+static inline void fidx_heap_store(struct fidx_heap *heap,
+                                   size_t            slot,
+                                   unsigned int      id,
+                                   const char       *node)
+{
+	heap->fidx_copy(fabs_tree_node(&heap->fidx_tree, slot), node);
+	heap->fidx_ids[slot] = id;
+	heap->fidx_slots[id] = (unsigned int)slot;
+}
+
+/* Tell wether node should be ordered before parent of slot. */
+static inline bool fidx_heap_precedes_parent(const struct fidx_heap *heap,
+                                             size_t                  slot,
+                                             const char             *node)
+{
+	const char *parent;
+
+	if (slot == FABS_TREE_ROOT_INDEX)
+		return false;
+
+	parent = fabs_tree_node(&heap->fidx_tree, fabs_tree_parent_index(slot));
+
+	return heap->fidx_compare(node, parent) < 0;
+}
+
+/*
+ * Bubble the hole located at slot up as long as node is ordered before its
+ * parent, then store node and its identifier into the resulting hole.
+ */
+static void fidx_heap_siftup(struct fidx_heap *heap,
+                             size_t            slot,
+                             unsigned int      id,
+                             const char       *node)
+{
+	farr_compare_fn *cmp = heap->fidx_compare;
+
+	while (slot != FABS_TREE_ROOT_INDEX) {
+		size_t pidx = fabs_tree_parent_index(slot);
+
+		if (cmp(fabs_tree_node(&heap->fidx_tree, pidx), node) <= 0)
+			break;
+
+		fidx_heap_move(heap, slot, pidx);
+		slot = pidx;
+	}
+
+	fidx_heap_store(heap, slot, id, node);
+}
+
+/*
+ * Move the hole located at slot down as long as one of its children is ordered
+ * before node, considering the count first nodes only, then store node and its
+ * identifier into the resulting hole.
+ */
+static void fidx_heap_siftdown(struct fidx_heap *heap,
+                               size_t            slot,
+                               size_t            count,
+                               unsigned int      id,
+                               const char       *node)
+{
+	farr_compare_fn *cmp = heap->fidx_compare;
+
+	while (true) {
+		size_t      cidx = fabs_tree_left_child_index(slot);
+		const char *child;
+
+		if (cidx >= count)
+			break;
+
+		child = fabs_tree_node(&heap->fidx_tree, cidx);
+		if ((cidx + 1) < count) {
+			const char *right = fabs_tree_node(&heap->fidx_tree,
+			                                   cidx + 1);
+
+			if (cmp(right, child) < 0) {
+				child = right;
+				cidx++;
+			}
+		}
+
+		if (cmp(child, node) >= 0)
+			break;
+
+		fidx_heap_move(heap, slot, cidx);
+		slot = cidx;
+	}
+
+	fidx_heap_store(heap, slot, id, node);
+}
+
+/*
+ * Fill the hole left by the node hosted at slot with the last one, restoring
+ * heap property in whichever direction is required.
+ */
+static void fidx_heap_unlink(struct fidx_heap *heap, size_t slot)
+{
+	size_t       cnt = fabs_tree_count(&heap->fidx_tree) - 1;
+	const char  *last;
+	unsigned int id;
+
+	if (slot != cnt) {
+		/*
+		 * Last slot is released and never overwritten by the sift
+		 * operations below since these consider the cnt first nodes
+		 * only.
+		 */
+		last = fabs_tree_node(&heap->fidx_tree, cnt);
+		id = heap->fidx_ids[cnt];
+
+		if (fidx_heap_precedes_parent(heap, slot, last))
+			fidx_heap_siftup(heap, slot, id, last);
+		else
+			fidx_heap_siftdown(heap, slot, cnt, id, last);
+	}
+
+	fabs_tree_debit(&heap->fidx_tree);
+}
+
+void fidx_heap_insert(struct fidx_heap *heap,
+                      unsigned int      id,
+                      const char       *node)
+{
+	karn_assert(!fidx_heap_full(heap));
+	karn_assert(!fidx_heap_contains(heap, id));
+	karn_assert(node);
+
+	fidx_heap_siftup(heap, fabs_tree_bottom_index(&heap->fidx_tree), id,
+	                 node);
+
+	fabs_tree_credit(&heap->fidx_tree);
+}
+
+unsigned int fidx_heap_extract(struct fidx_heap *heap, char *node)
+{
+	karn_assert(!fidx_heap_empty(heap));
+	karn_assert(node);
+
+	unsigned int id = heap->fidx_ids[FABS_TREE_ROOT_INDEX];
+
+	heap->fidx_copy(node, fabs_tree_root(&heap->fidx_tree));
+
+	fidx_heap_unlink(heap, FABS_TREE_ROOT_INDEX);
+
+	return id;
+}
+
+void fidx_heap_remove(struct fidx_heap *heap, unsigned int id, char *node)
+{
+	karn_assert(fidx_heap_contains(heap, id));
+
+	size_t slot = heap->fidx_slots[id];
+
+	if (node)
+		heap->fidx_copy(node, fabs_tree_node(&heap->fidx_tree, slot));
+
+	fidx_heap_unlink(heap, slot);
+}
+
+void fidx_heap_promote(struct fidx_heap *heap,
+                       unsigned int      id,
+                       const char       *node)
+{
+	karn_assert(fidx_heap_contains(heap, id));
+	karn_assert(node);
+
+	char tmp[fabs_tree_node_size(&heap->fidx_tree)];
+
+	/* node may alias its own slot which the sift up would overwrite. */
+	heap->fidx_copy(tmp, node);
+
+	fidx_heap_siftup(heap, heap->fidx_slots[id], id, tmp);
+}
+
+void fidx_heap_demote(struct fidx_heap *heap,
+                      unsigned int      id,
+                      const char       *node)
+{
+	karn_assert(fidx_heap_contains(heap, id));
+	karn_assert(node);
+
+	char tmp[fabs_tree_node_size(&heap->fidx_tree)];
+
+	heap->fidx_copy(tmp, node);
+
+	fidx_heap_siftdown(heap, heap->fidx_slots[id],
+	                   fabs_tree_count(&heap->fidx_tree), id, tmp);
+}
+
+void fidx_heap_update(struct fidx_heap *heap,
+                      unsigned int      id,
+                      const char       *node)
+{
+	karn_assert(fidx_heap_contains(heap, id));
+	karn_assert(node);
+
+	size_t slot = heap->fidx_slots[id];
+	char   tmp[fabs_tree_node_size(&heap->fidx_tree)];
+
+	heap->fidx_copy(tmp, node);
+
+	if (fidx_heap_precedes_parent(heap, slot, tmp))
+		fidx_heap_siftup(heap, slot, id, tmp);
+	else
+		fidx_heap_siftdown(heap, slot, fabs_tree_count(&heap->fidx_tree),
+		                   id, tmp);
+}
+
+int fidx_heap_init(struct fidx_heap *heap,
+                   char             *nodes,
+                   size_t            node_size,
+                   size_t            node_nr,
+                   farr_compare_fn  *compare,
+                   farr_copy_fn     *copy)
+{
+	karn_assert(heap);
+	karn_assert(node_nr);
+	karn_assert(node_nr <= UINT_MAX);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	/*
+	 * Both maps share a single allocation. Identifier to slot map is
+	 * zeroed so that fidx_heap_contains() never reads indeterminate
+	 * values.
+	 */
+	heap->fidx_ids = calloc(2 * node_nr, sizeof(heap->fidx_ids[0]));
+	if (!heap->fidx_ids)
+		return -ENOMEM;
+
+	heap->fidx_slots = &heap->fidx_ids[node_nr];
+	heap->fidx_compare = compare;
+	heap->fidx_copy = copy;
+
+	fabs_tree_init(&heap->fidx_tree, nodes, node_size, node_nr);
+
+	return 0;
+}
+
+void fidx_heap_fini(struct fidx_heap *heap)
+{
+	fidx_heap_assert(heap);
+
+	fabs_tree_fini(&heap->fidx_tree);
+
+	free(heap->fidx_ids);
+}
+
+struct fidx_heap * fidx_heap_create(size_t           node_size,
+                                    size_t           node_nr,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	karn_assert(node_size);
+	karn_assert(node_nr);
+
+	struct fidx_heap *heap;
+
+	heap = malloc(sizeof(*heap) + (node_size * node_nr));
+	if (!heap)
+		return NULL;
+
+	if (fidx_heap_init(heap, (char *)&heap[1], node_size, node_nr, compare,
+	                   copy)) {
+		free(heap);
+		return NULL;
+	}
+
+	return heap;
+}
+
+void fidx_heap_destroy(struct fidx_heap *heap)
+{
+	fidx_heap_fini(heap);
+
+	free(heap);
+}
@@ -0,0 +1,474 @@
+/**
+ * @file      fkey_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based integer key heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fkey_heap.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * Keys are stored so that keys[1], i.e. the first child of root, sits onto a
+ * cache line boundary: groups of siblings, starting at index (i * d) + 1, are
+ * then cache line aligned. Key slots located past the last node are filled
+ * with the greatest key value so that child scanning may always operate onto
+ * whole groups. Ties being resolved in favor of the lowest index, a filler is
+ * never selected in place of a genuine child.
+ */
+
+#if defined(__AVX2__)
+
+#define FKEY_HEAP_AVX2
+#define FKEY_HEAP_AVX2_ATTR
+
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+/* Build AVX2 variants anyway and select them at runtime if supported. */
+#define FKEY_HEAP_AVX2
+#define FKEY_HEAP_AVX2_RUNTIME
+#define FKEY_HEAP_AVX2_ATTR __attribute__((target("avx2")))
+
+#endif
+
+/* 16 children of 32 bits keys and 8 of 64 bits ones per cache line. */
+#define FKEY_HEAP_UINT32_SHIFT (4U)
+#define FKEY_HEAP_UINT64_SHIFT (3U)
+
+/*
+ * Generate scalar child scanning returning index of smallest key out of a
+ * group of 1 << _shift siblings.
+ */
+#define FKEY_HEAP_SCALAR_SELECT(_name, _type, _shift) \
+	static inline size_t \
+	fkey_ ## _name ## _scalar_select(const _type *keys) \
+	{ \
+		size_t idx = 0; \
+		size_t c; \
+		\
+		for (c = 1; c < (1U << (_shift)); c++) \
+			if (keys[c] < keys[idx]) \
+				idx = c; \
+		\
+		return idx; \
+	}
+
+/*
+ * Generate bottom-up sift down of key / payload from root using the given
+ * child scanning implementation: move the hole down to a leaf along the path
+ * of smallest children, then back up to where key fits. Key usually comes from
+ * the bottom of the heap hence the way back up is short.
+ */
+#define FKEY_HEAP_SIFTDOWN(_name, _type, _shift, _isa, _attr) \
+	static _attr void \
+	fkey_ ## _name ## _ ## _isa ## _siftdown(_type     *keys, \
+	                                         uintptr_t *payloads, \
+	                                         size_t     count, \
+	                                         _type      key, \
+	                                         uintptr_t  payload) \
+	{ \
+		size_t idx = 0; \
+		\
+		while (true) { \
+			size_t cidx = (idx << (_shift)) + 1; \
+			\
+			if (cidx >= count) \
+				break; \
+			\
+			cidx += fkey_ ## _name ## _ ## _isa ## _select( \
+				&keys[cidx]); \
+			\
+			keys[idx] = keys[cidx]; \
+			payloads[idx] = payloads[cidx]; \
+			idx = cidx; \
+		} \
+		\
+		while (idx) { \
+			size_t pidx = (idx - 1) >> (_shift); \
+			\
+			if (keys[pidx] <= key) \
+				break; \
+			\
+			keys[idx] = keys[pidx]; \
+			payloads[idx] = payloads[pidx]; \
+			idx = pidx; \
+		} \
+		\
+		keys[idx] = key; \
+		payloads[idx] = payload; \
+	}
+
+/*
+ * Generate Floyd heap construction out of count unordered keys / payloads:
+ * starting from the last internal node and moving upwards, sift the root of
+ * each subtree down until heap property is restored. Being called for batches
+ * only, child scanning relies upon the scalar implementation.
+ */
+#define FKEY_HEAP_BUILD(_name, _type, _shift) \
+	static void \
+	fkey_ ## _name ## _build(_type *keys, uintptr_t *payloads, size_t count) \
+	{ \
+		karn_assert(count > 1); \
+		\
+		size_t idx = ((count - 2) >> (_shift)) + 1; \
+		\
+		while (idx--) { \
+			_type     key = keys[idx]; \
+			uintptr_t payload = payloads[idx]; \
+			size_t    hole = idx; \
+			\
+			while (true) { \
+				size_t cidx = (hole << (_shift)) + 1; \
+				\
+				if (cidx >= count) \
+					break; \
+				\
+				cidx += fkey_ ## _name ## _scalar_select( \
+					&keys[cidx]); \
+				if (keys[cidx] >= key) \
+					break; \
+				\
+				keys[hole] = keys[cidx]; \
+				payloads[hole] = payloads[cidx]; \
+				hole = cidx; \
+			} \
+			\
+			keys[hole] = key; \
+			payloads[hole] = payload; \
+		} \
+	}
+
+FKEY_HEAP_SCALAR_SELECT(uint32, uint32_t, FKEY_HEAP_UINT32_SHIFT)
+FKEY_HEAP_BUILD(uint32, uint32_t, FKEY_HEAP_UINT32_SHIFT)
+
+FKEY_HEAP_SCALAR_SELECT(uint64, uint64_t, FKEY_HEAP_UINT64_SHIFT)
+FKEY_HEAP_BUILD(uint64, uint64_t, FKEY_HEAP_UINT64_SHIFT)
+
+#if !defined(__AVX2__)
+
+FKEY_HEAP_SIFTDOWN(uint32, uint32_t, FKEY_HEAP_UINT32_SHIFT, scalar, )
+FKEY_HEAP_SIFTDOWN(uint64, uint64_t, FKEY_HEAP_UINT64_SHIFT, scalar, )
+
+#endif /* !defined(__AVX2__) */
+
+#if defined(FKEY_HEAP_AVX2)
+
+#include <immintrin.h>
+
+/*
+ * Compute minimum of 2 vectors of 8 keys, reduce it horizontally so that all
+ * lanes hold it and locate its first occurrence using comparison masks.
+ */
+static inline FKEY_HEAP_AVX2_ATTR size_t
+fkey_uint32_avx2_select(const uint32_t *keys)
+{
+	__m256i      lo = _mm256_load_si256((const __m256i *)keys);
+	__m256i      hi = _mm256_load_si256((const __m256i *)&keys[8]);
+	__m256i      min = _mm256_min_epu32(lo, hi);
+	unsigned int mask;
+
+	min = _mm256_min_epu32(min, _mm256_permute2x128_si256(min, min, 1));
+	min = _mm256_min_epu32(min,
+	                       _mm256_shuffle_epi32(min,
+	                                            _MM_SHUFFLE(1, 0, 3, 2)));
+	min = _mm256_min_epu32(min,
+	                       _mm256_shuffle_epi32(min,
+	                                            _MM_SHUFFLE(2, 3, 0, 1)));
+
+	mask = (unsigned int)
+	       _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lo,
+	                                                                 min)));
+	mask |= (unsigned int)
+	        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(hi,
+	                                                                  min))) <<
+	        8;
+
+	return (size_t)__builtin_ctz(mask);
+}
+
+/*
+ * AVX2 has no unsigned 64 bits minimum nor comparison: flip sign bits and use
+ * the signed comparison to blend.
+ */
+static inline FKEY_HEAP_AVX2_ATTR __m256i
+fkey_uint64_avx2_min(__m256i first, __m256i second)
+{
+	const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+	__m256i       gt;
+
+	gt = _mm256_cmpgt_epi64(_mm256_xor_si256(first, sign),
+	                        _mm256_xor_si256(second, sign));
+
+	return _mm256_blendv_epi8(first, second, gt);
+}
+
+static inline FKEY_HEAP_AVX2_ATTR size_t
+fkey_uint64_avx2_select(const uint64_t *keys)
+{
+	__m256i      lo = _mm256_load_si256((const __m256i *)keys);
+	__m256i      hi = _mm256_load_si256((const __m256i *)&keys[4]);
+	__m256i      min = fkey_uint64_avx2_min(lo, hi);
+	unsigned int mask;
+
+	min = fkey_uint64_avx2_min(min,
+	                           _mm256_permute4x64_epi64(
+	                                   min,
+	                                   _MM_SHUFFLE(1, 0, 3, 2)));
+	min = fkey_uint64_avx2_min(min,
+	                           _mm256_permute4x64_epi64(
+	                                   min,
+	                                   _MM_SHUFFLE(2, 3, 0, 1)));
+
+	mask = (unsigned int)
+	       _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lo,
+	                                                                 min)));
+	mask |= (unsigned int)
+	        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hi,
+	                                                                  min))) <<
+	        4;
+
+	return (size_t)__builtin_ctz(mask);
+}
+
+FKEY_HEAP_SIFTDOWN(uint32, uint32_t, FKEY_HEAP_UINT32_SHIFT, avx2,
+                   FKEY_HEAP_AVX2_ATTR)
+FKEY_HEAP_SIFTDOWN(uint64, uint64_t, FKEY_HEAP_UINT64_SHIFT, avx2,
+                   FKEY_HEAP_AVX2_ATTR)
+
+#endif /* defined(FKEY_HEAP_AVX2) */
+
+#if defined(FKEY_HEAP_AVX2_RUNTIME)
+
+static bool fkey_heap_has_avx2(void)
+{
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx2");
+}
+
+#define fkey_heap_select_siftdown(_name) \
+	(fkey_heap_has_avx2() ? fkey_ ## _name ## _avx2_siftdown : \
+	                        fkey_ ## _name ## _scalar_siftdown)
+
+#elif defined(FKEY_HEAP_AVX2)
+
+#define fkey_heap_select_siftdown(_name) \
+	fkey_ ## _name ## _avx2_siftdown
+
+#else  /* !defined(FKEY_HEAP_AVX2) */
+
+#define fkey_heap_select_siftdown(_name) \
+	fkey_ ## _name ## _scalar_siftdown
+
+#endif /* defined(FKEY_HEAP_AVX2_RUNTIME) */
+
+/* Number of key slots, fillers included, allocated for nr nodes. */
+#define fkey_heap_slot_nr(_nr, _shift) \
+	((_nr) + (1U << (_shift)) - 1)
+
+#define FKEY_HEAP_FUNCS(_name, _type, _max, _shift) \
+	void fkey_ ## _name ## _heap_insert( \
+		struct fkey_ ## _name ## _heap *heap, \
+		_type                           key, \
+		uintptr_t                       payload) \
+	{ \
+		karn_assert(!fkey_ ## _name ## _heap_full(heap)); \
+		\
+		_type     *keys = heap->fkey_keys; \
+		uintptr_t *payloads = heap->fkey_payloads; \
+		size_t     idx = heap->fkey_count++; \
+		\
+		while (idx) { \
+			size_t pidx = (idx - 1) >> (_shift); \
+			\
+			if (keys[pidx] <= key) \
+				break; \
+			\
+			keys[idx] = keys[pidx]; \
+			payloads[idx] = payloads[pidx]; \
+			idx = pidx; \
+		} \
+		\
+		keys[idx] = key; \
+		payloads[idx] = payload; \
+	} \
+	\
+	_type fkey_ ## _name ## _heap_extract( \
+		struct fkey_ ## _name ## _heap *heap, \
+		uintptr_t                      *payload) \
+	{ \
+		karn_assert(!fkey_ ## _name ## _heap_empty(heap)); \
+		\
+		_type     *keys = heap->fkey_keys; \
+		uintptr_t *payloads = heap->fkey_payloads; \
+		_type      min = keys[0]; \
+		size_t     cnt = --heap->fkey_count; \
+		_type      last = keys[cnt]; \
+		\
+		if (payload) \
+			*payload = payloads[0]; \
+		\
+		keys[cnt] = _max; \
+		if (cnt) \
+			heap->fkey_siftdown(keys, payloads, cnt, last, \
+			                    payloads[cnt]); \
+		\
+		return min; \
+	} \
+	\
+	void fkey_ ## _name ## _heap_insert_batch( \
+		struct fkey_ ## _name ## _heap *heap, \
+		const _type                    *keys, \
+		const uintptr_t                *payloads, \
+		size_t                          nr) \
+	{ \
+		karn_assert(heap); \
+		karn_assert((keys && payloads) || !nr); \
+		karn_assert(nr <= (heap->fkey_nr - heap->fkey_count)); \
+		\
+		size_t cnt = heap->fkey_count; \
+		\
+		if (nr < cnt) { \
+			/* Small batch: sift keys up one by one. */ \
+			while (nr--) \
+				fkey_ ## _name ## _heap_insert(heap, \
+				                               *keys++, \
+				                               *payloads++); \
+			return; \
+		} \
+		\
+		/* Large batch: append keys then rebuild the whole heap. */ \
+		memcpy(&heap->fkey_keys[cnt], keys, nr * sizeof(*keys)); \
+		memcpy(&heap->fkey_payloads[cnt], payloads, \
+		       nr * sizeof(*payloads)); \
+		heap->fkey_count += nr; \
+		\
+		if (heap->fkey_count > 1) \
+			fkey_ ## _name ## _build(heap->fkey_keys, \
+			                         heap->fkey_payloads, \
+			                         heap->fkey_count); \
+	} \
+	\
+	size_t fkey_ ## _name ## _heap_extract_batch( \
+		struct fkey_ ## _name ## _heap *heap, \
+		_type                          *keys, \
+		uintptr_t                      *payloads, \
+		size_t                          nr) \
+	{ \
+		karn_assert(heap); \
+		karn_assert(keys || !nr); \
+		\
+		_type     *heap_keys = heap->fkey_keys; \
+		uintptr_t *heap_payloads = heap->fkey_payloads; \
+		size_t     cnt = heap->fkey_count; \
+		size_t     n; \
+		\
+		if (nr > cnt) \
+			nr = cnt; \
+		\
+		/* \
+		 * Run nr steps of heapsort straight into caller's arrays since \
+		 * released tail slots must hold fillers for child scanning to \
+		 * operate onto whole groups. \
+		 */ \
+		for (n = 0; n < nr; n++) { \
+			_type last; \
+			\
+			keys[n] = heap_keys[0]; \
+			if (payloads) \
+				payloads[n] = heap_payloads[0]; \
+			\
+			last = heap_keys[--cnt]; \
+			heap_keys[cnt] = _max; \
+			if (cnt) \
+				heap->fkey_siftdown(heap_keys, heap_payloads, \
+				                    cnt, last, \
+				                    heap_payloads[cnt]); \
+		} \
+		\
+		heap->fkey_count = cnt; \
+		\
+		return nr; \
+	} \
+	\
+	void fkey_ ## _name ## _heap_clear( \
+		struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		karn_assert(heap); \
+		\
+		size_t n; \
+		\
+		for (n = 0; n < heap->fkey_count; n++) \
+			heap->fkey_keys[n] = _max; \
+		\
+		heap->fkey_count = 0; \
+	} \
+	\
+	int fkey_ ## _name ## _heap_init(struct fkey_ ## _name ## _heap *heap, \
+	                                 size_t                          nr) \
+	{ \
+		karn_assert(heap); \
+		karn_assert(nr); \
+		\
+		size_t slot_nr = fkey_heap_slot_nr(nr, _shift); \
+		size_t size; \
+		size_t n; \
+		\
+		/* Room for padding preceding root, rounded to a line. */ \
+		size = FKEY_HEAP_LINE_SIZE + ((slot_nr - 1) * sizeof(_type)); \
+		size = (size + FKEY_HEAP_LINE_SIZE - 1) & \
+		       ~((size_t)FKEY_HEAP_LINE_SIZE - 1); \
+		\
+		heap->fkey_mem = aligned_alloc(FKEY_HEAP_LINE_SIZE, size); \
+		if (!heap->fkey_mem) \
+			return -ENOMEM; \
+		\
+		heap->fkey_payloads = malloc(nr * sizeof(heap->fkey_payloads[0])); \
+		if (!heap->fkey_payloads) { \
+			free(heap->fkey_mem); \
+			return -ENOMEM; \
+		} \
+		\
+		heap->fkey_keys = (_type *)((char *)heap->fkey_mem + \
+		                            FKEY_HEAP_LINE_SIZE - \
+		                            sizeof(_type)); \
+		for (n = 0; n < slot_nr; n++) \
+			heap->fkey_keys[n] = _max; \
+		\
+		heap->fkey_count = 0; \
+		heap->fkey_nr = nr; \
+		heap->fkey_siftdown = fkey_heap_select_siftdown(_name); \
+		\
+		return 0; \
+	} \
+	\
+	void fkey_ ## _name ## _heap_fini(struct fkey_ ## _name ## _heap *heap) \
+	{ \
+		karn_assert(heap); \
+		\
+		free(heap->fkey_payloads); \
+		free(heap->fkey_mem); \
+	}
+
+FKEY_HEAP_FUNCS(uint32, uint32_t, UINT32_MAX, FKEY_HEAP_UINT32_SHIFT)
+FKEY_HEAP_FUNCS(uint64, uint64_t, UINT64_MAX, FKEY_HEAP_UINT64_SHIFT)
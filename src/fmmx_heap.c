@@ -0,0 +1,401 @@
+/**
+ * @file      fmmx_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based min-max heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fmmx_heap.h>
+#include <stdlib.h>
+
+#define FMMX_HEAP_MIN_LEVEL (true)
+#define FMMX_HEAP_MAX_LEVEL (false)
+
+static inline bool fmmx_heap_min_level(size_t index)
+{
+	return !(fabs_tree_index_depth(index) & 1);
+}
+
+/*
+ * Tell wether first should sit above second within the hierarchy of min levels
+ * (when min is true) or max levels.
+ */
+static inline bool fmmx_heap_above(const char      *first,
+                                   const char      *second,
+                                   farr_compare_fn *compare,
+                                   bool             min)
+{
+	int ret = compare(first, second);
+
+	return min ? (ret < 0) : (ret > 0);
+}
+
+static size_t fmmx_heap_max_index(const struct fabs_tree *tree,
+                                  farr_compare_fn        *compare)
+{
+	size_t cnt = fabs_tree_count(tree);
+
+	if (cnt < 3)
+		return cnt - 1;
+
+	if (compare(fabs_tree_node(tree, 1), fabs_tree_node(tree, 2)) >= 0)
+		return 1;
+
+	return 2;
+}
+
+/*
+ * Move node up from the empty slot at index, first across its parent if it
+ * belongs to the other level hierarchy, then from grandparent to grandparent.
+ */
+static void fmmx_heap_siftup(const struct fabs_tree *tree,
+                             size_t                  index,
+                             const char             *node,
+                             farr_compare_fn        *compare,
+                             farr_copy_fn           *copy)
+{
+	if (index != FABS_TREE_ROOT_INDEX) {
+		size_t      pidx = fabs_tree_parent_index(index);
+		const char *pnode = fabs_tree_node(tree, pidx);
+		bool        min = fmmx_heap_min_level(index);
+
+		if (fmmx_heap_above(pnode, node, compare, min)) {
+			copy(fabs_tree_node(tree, index), pnode);
+			index = pidx;
+			min = !min;
+		}
+
+		while (index > 2) {
+			size_t      gidx;
+			const char *gnode;
+
+			gidx = fabs_tree_parent_index(
+				fabs_tree_parent_index(index));
+			gnode = fabs_tree_node(tree, gidx);
+			if (!fmmx_heap_above(node, gnode, compare, min))
+				break;
+
+			copy(fabs_tree_node(tree, index), gnode);
+			index = gidx;
+		}
+	}
+
+	copy(fabs_tree_node(tree, index), node);
+}
+
+/*
+ * Move node down from the empty slot at index within the hierarchy of min
+ * levels (when min is true) or max levels, swapping it with nodes of the other
+ * hierarchy on the way when required.
+ *
+ * node must point to writable memory located outside of hosted nodes since it
+ * holds the node being moved down, which may change along the way.
+ */
+static void fmmx_heap_siftdown(const struct fabs_tree *tree,
+                               size_t                  index,
+                               char                   *node,
+                               farr_compare_fn        *compare,
+                               farr_copy_fn           *copy,
+                               bool                    min)
+{
+	size_t cnt = fabs_tree_count(tree);
+
+	while (true) {
+		size_t      cidx = fabs_tree_left_child_index(index);
+		size_t      gidx, last, midx, idx;
+		const char *mnode;
+		char       *pnode;
+
+		if (cidx >= cnt)
+			break;
+
+		/* Locate topmost node among children and grandchildren. */
+		midx = cidx;
+		mnode = fabs_tree_node(tree, cidx);
+
+		if ((cidx + 1) < cnt) {
+			const char *curr = fabs_tree_node(tree, cidx + 1);
+
+			if (fmmx_heap_above(curr, mnode, compare, min)) {
+				midx = cidx + 1;
+				mnode = curr;
+			}
+		}
+
+		/* Grandchildren are stored contiguously. */
+		gidx = fabs_tree_left_child_index(cidx);
+		last = ((gidx + 4) < cnt) ? (gidx + 4) : cnt;
+		for (idx = gidx; idx < last; idx++) {
+			const char *curr = fabs_tree_node(tree, idx);
+
+			if (fmmx_heap_above(curr, mnode, compare, min)) {
+				midx = idx;
+				mnode = curr;
+			}
+		}
+
+		if (!fmmx_heap_above(mnode, node, compare, min))
+			break;
+
+		copy(fabs_tree_node(tree, index), mnode);
+		index = midx;
+
+		if (midx < gidx)
+			/*
+			 * Node moved down to a child slot of the other
+			 * hierarchy which descendants cannot be above it.
+			 */
+			break;
+
+		/*
+		 * Node moved down 2 levels: if it belongs to the other
+		 * hierarchy than its new parent's, exchange them using the
+		 * empty slot as temporary storage then carry on moving former
+		 * parent down.
+		 */
+		pnode = fabs_tree_node(tree, fabs_tree_parent_index(midx));
+		if (fmmx_heap_above(pnode, node, compare, min)) {
+			char *empty = fabs_tree_node(tree, midx);
+
+			copy(empty, pnode);
+			copy(pnode, node);
+			copy(node, empty);
+		}
+	}
+
+	copy(fabs_tree_node(tree, index), node);
+}
+
+char * fmmx_heap_peek_max(const struct fmmx_heap *heap)
+{
+	karn_assert(!fmmx_heap_empty(heap));
+
+	return fabs_tree_node(&heap->fmmx_tree,
+	                      fmmx_heap_max_index(&heap->fmmx_tree,
+	                                          heap->fmmx_compare));
+}
+
+void fmmx_heap_insert(struct fmmx_heap *heap, const char *node)
+{
+	karn_assert(!fmmx_heap_full(heap));
+	karn_assert(node);
+
+	fmmx_heap_siftup(&heap->fmmx_tree,
+	                 fabs_tree_bottom_index(&heap->fmmx_tree), node,
+	                 heap->fmmx_compare, heap->fmmx_copy);
+
+	fabs_tree_credit(&heap->fmmx_tree);
+}
+
+bool fmmx_heap_insert_evict_min(struct fmmx_heap *heap,
+                                const char       *node,
+                                char             *evicted)
+{
+	fmmx_heap_assert(heap);
+	karn_assert(node);
+	karn_assert(evicted);
+
+	struct fabs_tree *tree = &heap->fmmx_tree;
+	char             *root;
+
+	if (!fabs_tree_full(tree)) {
+		fmmx_heap_insert(heap, node);
+		return false;
+	}
+
+	root = fabs_tree_root(tree);
+	if (heap->fmmx_compare(node, root) <= 0) {
+		heap->fmmx_copy(evicted, node);
+	}
+	else {
+		char tmp[fabs_tree_node_size(tree)];
+
+		heap->fmmx_copy(evicted, root);
+		heap->fmmx_copy(tmp, node);
+		fmmx_heap_siftdown(tree, FABS_TREE_ROOT_INDEX, tmp,
+		                   heap->fmmx_compare, heap->fmmx_copy,
+		                   FMMX_HEAP_MIN_LEVEL);
+	}
+
+	return true;
+}
+
+bool fmmx_heap_insert_evict_max(struct fmmx_heap *heap,
+                                const char       *node,
+                                char             *evicted)
+{
+	fmmx_heap_assert(heap);
+	karn_assert(node);
+	karn_assert(evicted);
+
+	struct fabs_tree *tree = &heap->fmmx_tree;
+	size_t            midx;
+	char             *max;
+
+	if (!fabs_tree_full(tree)) {
+		fmmx_heap_insert(heap, node);
+		return false;
+	}
+
+	midx = fmmx_heap_max_index(tree, heap->fmmx_compare);
+	max = fabs_tree_node(tree, midx);
+	if (heap->fmmx_compare(node, max) >= 0) {
+		heap->fmmx_copy(evicted, node);
+	}
+	else {
+		char  tmp[fabs_tree_node_size(tree)];
+		char *root = fabs_tree_root(tree);
+
+		heap->fmmx_copy(evicted, max);
+		heap->fmmx_copy(tmp, node);
+
+		if (midx == FABS_TREE_ROOT_INDEX) {
+			heap->fmmx_copy(root, tmp);
+			return true;
+		}
+
+		if (heap->fmmx_compare(tmp, root) < 0) {
+			/* Node becomes the new root, move former one down. */
+			heap->fmmx_copy(max, root);
+			heap->fmmx_copy(root, tmp);
+			heap->fmmx_copy(tmp, max);
+		}
+
+		fmmx_heap_siftdown(tree, midx, tmp, heap->fmmx_compare,
+		                   heap->fmmx_copy, FMMX_HEAP_MAX_LEVEL);
+	}
+
+	return true;
+}
+
+void fmmx_heap_extract_min(struct fmmx_heap *heap, char *node)
+{
+	karn_assert(!fmmx_heap_empty(heap));
+	karn_assert(node);
+
+	struct fabs_tree *tree = &heap->fmmx_tree;
+
+	heap->fmmx_copy(node, fabs_tree_root(tree));
+
+	/* Last node slot now lies outside hosted nodes. */
+	fabs_tree_debit(tree);
+
+	if (!fabs_tree_empty(tree))
+		fmmx_heap_siftdown(tree, FABS_TREE_ROOT_INDEX,
+		                   fabs_tree_node(tree, fabs_tree_count(tree)),
+		                   heap->fmmx_compare, heap->fmmx_copy,
+		                   FMMX_HEAP_MIN_LEVEL);
+}
+
+void fmmx_heap_extract_max(struct fmmx_heap *heap, char *node)
+{
+	karn_assert(!fmmx_heap_empty(heap));
+	karn_assert(node);
+
+	struct fabs_tree *tree = &heap->fmmx_tree;
+	size_t            midx = fmmx_heap_max_index(tree, heap->fmmx_compare);
+
+	heap->fmmx_copy(node, fabs_tree_node(tree, midx));
+
+	fabs_tree_debit(tree);
+
+	if (midx != fabs_tree_count(tree))
+		fmmx_heap_siftdown(tree, midx,
+		                   fabs_tree_node(tree, fabs_tree_count(tree)),
+		                   heap->fmmx_compare, heap->fmmx_copy,
+		                   FMMX_HEAP_MAX_LEVEL);
+}
+
+void fmmx_heap_build(struct fmmx_heap *heap, size_t count)
+{
+	fmmx_heap_assert(heap);
+	karn_assert(count);
+	karn_assert(count <= fmmx_heap_nr(heap));
+
+	struct fabs_tree *tree = &heap->fmmx_tree;
+	char              tmp[fabs_tree_node_size(tree)];
+	size_t            idx = count / 2;
+
+	tree->fabs_count = count;
+
+	/*
+	 * Starting from the lowest heap level and moving upwards, move the root
+	 * of each subtree down according to its level.
+	 */
+	while (idx--) {
+		heap->fmmx_copy(tmp, fabs_tree_node(tree, idx));
+
+		fmmx_heap_siftdown(tree, idx, tmp, heap->fmmx_compare,
+		                   heap->fmmx_copy, fmmx_heap_min_level(idx));
+	}
+}
+
+void fmmx_heap_init(struct fmmx_heap *heap,
+                    char             *nodes,
+                    size_t            node_size,
+                    size_t            node_nr,
+                    farr_compare_fn  *compare,
+                    farr_copy_fn     *copy)
+{
+	karn_assert(heap);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	heap->fmmx_compare = compare;
+	heap->fmmx_copy = copy;
+
+	fabs_tree_init(&heap->fmmx_tree, nodes, node_size, node_nr);
+}
+
+void fmmx_heap_fini(struct fmmx_heap *heap __unused)
+{
+	karn_assert(heap);
+
+	fabs_tree_fini(&heap->fmmx_tree);
+}
+
+struct fmmx_heap * fmmx_heap_create(size_t           node_size,
+                                    size_t           node_nr,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	karn_assert(node_size);
+	karn_assert(node_nr);
+
+	struct fmmx_heap *heap;
+
+	heap = malloc(sizeof(*heap) + (node_size * node_nr));
+	if (!heap)
+		return NULL;
+
+	fmmx_heap_init(heap, (char *)&heap[1], node_size, node_nr, compare,
+	               copy);
+
+	return heap;
+}
+
+void fmmx_heap_destroy(struct fmmx_heap *heap)
+{
+	fmmx_heap_fini(heap);
+
+	free(heap);
+}
@@ -0,0 +1,376 @@
+/**
+ * @file      fshd_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based shadow heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fshd_heap.h>
+#include <stdlib.h>
+
+/*
+ * Move node up from the slot at index till its parent is not greater.
+ *
+ * tmp must point to memory large enough to hold a node and located outside of
+ * hosted nodes.
+ */
+static void fshd_heap_siftup(const struct fabs_tree *tree,
+                             size_t                  index,
+                             char                   *tmp,
+                             farr_compare_fn        *compare,
+                             farr_copy_fn           *copy)
+{
+	size_t pidx;
+
+	if (index == FABS_TREE_ROOT_INDEX)
+		return;
+
+	pidx = fabs_tree_parent_index(index);
+	if (compare(fabs_tree_node(tree, pidx),
+	            fabs_tree_node(tree, index)) <= 0)
+		return;
+
+	copy(tmp, fabs_tree_node(tree, index));
+
+	do {
+		copy(fabs_tree_node(tree, index), fabs_tree_node(tree, pidx));
+		index = pidx;
+		if (index == FABS_TREE_ROOT_INDEX)
+			break;
+
+		pidx = fabs_tree_parent_index(index);
+	} while (compare(fabs_tree_node(tree, pidx), tmp) > 0);
+
+	copy(fabs_tree_node(tree, index), tmp);
+}
+
+/*
+ * Move node down from the empty slot at index, swapping it with its smallest
+ * child till none of the count first nodes is smaller.
+ *
+ * node must point to memory located outside of the count first nodes.
+ */
+static void fshd_heap_siftdown(const struct fabs_tree *tree,
+                               size_t                  index,
+                               const char             *node,
+                               size_t                  count,
+                               farr_compare_fn        *compare,
+                               farr_copy_fn           *copy)
+{
+	while (true) {
+		size_t      cidx = fabs_tree_left_child_index(index);
+		const char *child;
+
+		if (cidx >= count)
+			break;
+
+		child = fabs_tree_node(tree, cidx);
+		if ((cidx + 1) < count) {
+			const char *right = fabs_tree_node(tree, cidx + 1);
+
+			if (compare(right, child) < 0) {
+				cidx++;
+				child = right;
+			}
+		}
+
+		if (compare(child, node) >= 0)
+			break;
+
+		copy(fabs_tree_node(tree, index), child);
+		index = cidx;
+	}
+
+	copy(fabs_tree_node(tree, index), node);
+}
+
+/*
+ * Restore heap property over the count first nodes given that nodes located
+ * before first already satisfy it.
+ *
+ * According to Floyd algorithm, nodes are moved down in reverse order, skipping
+ * those which subtree contains no node located after first: starting from
+ * [first:count[ range, walk up one level at a time across the contiguous range
+ * of ancestors till the root is reached.
+ */
+static void fshd_heap_heapify(const struct fabs_tree *tree,
+                              size_t                  first,
+                              size_t                  count,
+                              farr_compare_fn        *compare,
+                              farr_copy_fn           *copy)
+{
+	char   tmp[fabs_tree_node_size(tree)];
+	size_t last = count;
+
+	while (true) {
+		/* Only nodes located before count / 2 have children. */
+		size_t idx = (last < (count / 2)) ? last : (count / 2);
+
+		while (idx-- > first) {
+			char       *node = fabs_tree_node(tree, idx);
+			size_t      cidx = fabs_tree_left_child_index(idx);
+			const char *child = fabs_tree_node(tree, cidx);
+
+			if ((cidx + 1) < count) {
+				const char *right = fabs_tree_node(tree,
+				                                   cidx + 1);
+
+				if (compare(right, child) < 0) {
+					cidx++;
+					child = right;
+				}
+			}
+
+			/* Skip subtrees already ordered. */
+			if (compare(child, node) >= 0)
+				continue;
+
+			copy(tmp, node);
+			copy(node, child);
+			fshd_heap_siftdown(tree, cidx, tmp, count, compare,
+			                   copy);
+		}
+
+		if (first == FABS_TREE_ROOT_INDEX)
+			break;
+
+		last = fabs_tree_parent_index(last - 1) + 1;
+		if (last > first)
+			/* Upper range overlaps the one just processed. */
+			last = first;
+		first = fabs_tree_parent_index(first);
+	}
+}
+
+/*
+ * Merge the shadow into the heap ordered zone.
+ *
+ * Sifting nodes up costs O(1) comparisons on average since most of them stop
+ * close to the bottom whereas heapifying visits all ancestors of the shadow.
+ * As fbnr_heap_insert_batch() does, heapify only shadows at least as large as
+ * the heap ordered zone.
+ */
+static void fshd_heap_merge(struct fshd_heap *heap)
+{
+	struct fabs_tree *tree = &heap->fshd_tree;
+	size_t            cnt = fabs_tree_count(tree);
+	size_t            idx = heap->fshd_ordered;
+
+	if ((cnt - idx) < idx) {
+		char tmp[fabs_tree_node_size(tree)];
+
+		for (; idx < cnt; idx++)
+			fshd_heap_siftup(tree, idx, tmp, heap->fshd_compare,
+			                 heap->fshd_copy);
+	}
+	else
+		fshd_heap_heapify(tree, idx, cnt, heap->fshd_compare,
+		                  heap->fshd_copy);
+
+	heap->fshd_ordered = cnt;
+}
+
+/*
+ * Merge the shadow once it exceeds the adaptive threshold, i.e. when it holds
+ * more nodes than both FSHD_HEAP_SHADOW_MIN and the heap ordered zone.
+ */
+static void fshd_heap_shadow_overflow(struct fshd_heap *heap)
+{
+	size_t ord = heap->fshd_ordered;
+	size_t thres = (ord > FSHD_HEAP_SHADOW_MIN) ? ord :
+	                                              FSHD_HEAP_SHADOW_MIN;
+
+	if ((fabs_tree_count(&heap->fshd_tree) - ord) > thres)
+		fshd_heap_merge(heap);
+}
+
+char * fshd_heap_peek(struct fshd_heap *heap)
+{
+	karn_assert(!fshd_heap_empty(heap));
+
+	if (heap->fshd_ordered != fabs_tree_count(&heap->fshd_tree))
+		fshd_heap_merge(heap);
+
+	return fabs_tree_root(&heap->fshd_tree);
+}
+
+void fshd_heap_insert(struct fshd_heap *heap, const char *node)
+{
+	karn_assert(!fshd_heap_full(heap));
+	karn_assert(node);
+
+	heap->fshd_copy(fabs_tree_bottom(&heap->fshd_tree), node);
+	fabs_tree_credit(&heap->fshd_tree);
+
+	fshd_heap_shadow_overflow(heap);
+}
+
+void fshd_heap_extract(struct fshd_heap *heap, char *node)
+{
+	karn_assert(!fshd_heap_empty(heap));
+	karn_assert(node);
+
+	struct fabs_tree *tree = &heap->fshd_tree;
+	size_t            cnt;
+
+	if (heap->fshd_ordered != fabs_tree_count(tree))
+		fshd_heap_merge(heap);
+
+	heap->fshd_copy(node, fabs_tree_root(tree));
+
+	/* Last node slot now lies outside hosted nodes. */
+	fabs_tree_debit(tree);
+
+	cnt = fabs_tree_count(tree);
+	heap->fshd_ordered = cnt;
+	if (cnt)
+		fshd_heap_siftdown(tree, FABS_TREE_ROOT_INDEX,
+		                   fabs_tree_node(tree, cnt), cnt,
+		                   heap->fshd_compare, heap->fshd_copy);
+}
+
+void fshd_heap_insert_batch(struct fshd_heap *heap,
+                            const char       *nodes,
+                            size_t            nr)
+{
+	fshd_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(nr <= (fshd_heap_nr(heap) - fshd_heap_count(heap)));
+
+	struct fabs_tree *tree = &heap->fshd_tree;
+	size_t            size = fabs_tree_node_size(tree);
+
+	while (nr--) {
+		heap->fshd_copy(fabs_tree_bottom(tree), nodes);
+		fabs_tree_credit(tree);
+		nodes += size;
+	}
+
+	fshd_heap_shadow_overflow(heap);
+}
+
+size_t fshd_heap_extract_batch(struct fshd_heap *heap,
+                               char             *nodes,
+                               size_t            nr)
+{
+	fshd_heap_assert(heap);
+	karn_assert(nodes || !nr);
+
+	struct fabs_tree *tree = &heap->fshd_tree;
+	size_t            cnt = fabs_tree_count(tree);
+	size_t            size = fabs_tree_node_size(tree);
+	size_t            n;
+
+	if (nr > cnt)
+		nr = cnt;
+	if (!nr)
+		return 0;
+
+	/*
+	 * Merge the shadow once: nothing is inserted in between extractions,
+	 * hence the whole batch may be drained by consecutive sift downs of the
+	 * last node.
+	 */
+	if (heap->fshd_ordered != cnt)
+		fshd_heap_merge(heap);
+
+	for (n = 0; n < nr; n++) {
+		heap->fshd_copy(nodes, fabs_tree_root(tree));
+		nodes += size;
+
+		if (--cnt)
+			fshd_heap_siftdown(tree, FABS_TREE_ROOT_INDEX,
+			                   fabs_tree_node(tree, cnt), cnt,
+			                   heap->fshd_compare, heap->fshd_copy);
+	}
+
+	tree->fabs_count = cnt;
+	heap->fshd_ordered = cnt;
+
+	return nr;
+}
+
+void fshd_heap_build(struct fshd_heap *heap, size_t count)
+{
+	fshd_heap_assert(heap);
+	karn_assert(count);
+	karn_assert(count <= fshd_heap_nr(heap));
+
+	heap->fshd_tree.fabs_count = count;
+
+	fshd_heap_heapify(&heap->fshd_tree, FABS_TREE_ROOT_INDEX, count,
+	                  heap->fshd_compare, heap->fshd_copy);
+
+	heap->fshd_ordered = count;
+}
+
+void fshd_heap_init(struct fshd_heap *heap,
+                    char             *nodes,
+                    size_t            node_size,
+                    size_t            node_nr,
+                    farr_compare_fn  *compare,
+                    farr_copy_fn     *copy)
+{
+	karn_assert(heap);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	heap->fshd_ordered = 0;
+	heap->fshd_compare = compare;
+	heap->fshd_copy = copy;
+
+	fabs_tree_init(&heap->fshd_tree, nodes, node_size, node_nr);
+}
+
+void fshd_heap_fini(struct fshd_heap *heap __unused)
+{
+	karn_assert(heap);
+
+	fabs_tree_fini(&heap->fshd_tree);
+}
+
+struct fshd_heap * fshd_heap_create(size_t           node_size,
+                                    size_t           node_nr,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	karn_assert(node_size);
+	karn_assert(node_nr);
+
+	struct fshd_heap *heap;
+
+	heap = malloc(sizeof(*heap) + (node_size * node_nr));
+	if (!heap)
+		return NULL;
+
+	fshd_heap_init(heap, (char *)&heap[1], node_size, node_nr, compare,
+	               copy);
+
+	return heap;
+}
+
+void fshd_heap_destroy(struct fshd_heap *heap)
+{
+	fshd_heap_fini(heap);
+
+	free(heap);
+}
@@ -31,23 +31,23 @@
 #define FWK_HEAP_REGULAR_ORDER (true)
 #define FWK_HEAP_REVERSE_ORDER (false)
 
-static unsigned int fwk_heap_parent_index(unsigned int index)
+static size_t fwk_heap_parent_index(size_t index)
 {
 	karn_assert(index);
 
 	return index / 2;
 }
 
-static unsigned int fwk_heap_left_index(const uintptr_t *rbits,
-                                        unsigned int     index)
+static size_t fwk_heap_left_index(const uintptr_t *rbits,
+                                  size_t           index)
 {
-	return (2 * index) + (unsigned int)fbmp_test(rbits, index);
+	return (2 * index) + (size_t)fbmp_test(rbits, index);
 }
 
-static unsigned int fwk_heap_right_index(const uintptr_t *rbits,
-                                         unsigned int     index)
+static size_t fwk_heap_right_index(const uintptr_t *rbits,
+                                   size_t           index)
 {
-	return (2 * index) + 1 - (unsigned int)fbmp_test(rbits, index);
+	return (2 * index) + 1 - (size_t)fbmp_test(rbits, index);
 }
 
 /*
@@ -70,8 +70,8 @@ static unsigned int fwk_heap_right_index(const uintptr_t *rbits,
  */
 static inline bool fwk_heap_join(const struct farr *nodes,
                                  uintptr_t         *rbits,
-                                 unsigned int       dancestor,
-                                 unsigned int       node,
+                                 size_t             dancestor,
+                                 size_t             node,
                                  farr_compare_fn   *compare,
                                  farr_copy_fn      *copy,
                                  bool               regular)
@@ -116,18 +116,18 @@ static inline bool fwk_heap_join(const struct farr *nodes,
  */
 static void fwk_heap_siftdown(const struct farr *nodes,
                               uintptr_t         *rbits,
-                              unsigned int       count,
+                              size_t             count,
                               farr_compare_fn   *compare,
                               farr_copy_fn      *copy,
                               bool               regular)
 {
-	unsigned int idx;
+	size_t idx;
 
 	idx = fwk_heap_right_index(rbits, FWK_HEAP_ROOT_INDEX);
 
 	/* Identify last node of root's right subtree left spine. */
 	while (true) {
-		unsigned int cidx;
+		size_t cidx;
 
 		cidx = fwk_heap_left_index(rbits, idx);
 		if (cidx >= count)
@@ -159,11 +159,11 @@ static void fwk_heap_siftdown(const struct farr *nodes,
  *
  * Unpredictable result if a 0 "index" is passed as argument.
  */
-static unsigned int fwk_heap_fast_dancestor_index(unsigned int index)
+static size_t fwk_heap_fast_dancestor_index(size_t index)
 {
 	karn_assert(index);
 
-	return index >> (__builtin_ctz(index) + 1);
+	return index >> (__builtin_ctzl(index) + 1);
 }
 
 /*
@@ -174,7 +174,7 @@ static unsigned int fwk_heap_fast_dancestor_index(unsigned int index)
  */
 static void fwk_heap_make(const struct farr *nodes,
                           uintptr_t         *rbits,
-                          unsigned int       count,
+                          size_t             count,
                           farr_compare_fn   *compare,
                           farr_copy_fn      *copy,
                           bool               regular)
@@ -187,19 +187,19 @@ static void fwk_heap_make(const struct farr *nodes,
 
 #endif /* defined(CONFIG_KARN_FWK_HEAP_UTILS) */
 
-static unsigned int fwk_heap_bottom_index(const struct fwk_heap *heap)
+static size_t fwk_heap_bottom_index(const struct fwk_heap *heap)
 {
 	return heap->fwk_count;
 }
 
 static bool fwk_heap_isleft_child(const uintptr_t   *rbits,
-                                  unsigned int       index)
+                                  size_t             index)
 {
 	return (!!(index & 1)) == fbmp_test(rbits,
 	                                    fwk_heap_parent_index(index));
 }
 
-static bool fwk_heap_single_leaf(unsigned int index)
+static bool fwk_heap_single_leaf(size_t index)
 {
 	return !(index & 1);
 }
@@ -212,8 +212,8 @@ static bool fwk_heap_single_leaf(unsigned int index)
  * "index" if "index" points to a right child, and the distinguished ancestor of
  * the parent of "index" if "index" is a left child.
  */
-static unsigned int fwk_heap_dancestor_index(const struct fwk_heap *heap,
-                                             unsigned int           index)
+static size_t fwk_heap_dancestor_index(const struct fwk_heap *heap,
+                                       size_t                 index)
 {
 	/* Root has no ancestor... */
 	karn_assert(index);
@@ -231,7 +231,7 @@ void fwk_heap_insert(struct fwk_heap *heap, const char *node)
 	karn_assert(!fwk_heap_full(heap));
 	karn_assert(node);
 
-	unsigned int       idx = fwk_heap_bottom_index(heap);
+	size_t             idx = fwk_heap_bottom_index(heap);
 	farr_copy_fn      *cpy = heap->fwk_copy;
 	farr_compare_fn   *cmp = heap->fwk_compare;
 	const struct farr *nodes = &heap->fwk_nodes;
@@ -256,7 +256,7 @@ void fwk_heap_insert(struct fwk_heap *heap, const char *node)
 		 * ancestors.
 		 */
 		do {
-			unsigned int didx;
+			size_t didx;
 
 			/* Find distinguished ancestor for current node */
 			didx = fwk_heap_dancestor_index(heap, idx);
@@ -285,7 +285,7 @@ void fwk_heap_extract(struct fwk_heap *heap, char *node)
 	const struct farr *nodes = &heap->fwk_nodes;
 	char              *root = farr_slot(nodes, FWK_HEAP_ROOT_INDEX);
 	farr_copy_fn      *cpy = heap->fwk_copy;
-	unsigned int       cnt = --heap->fwk_count;
+	size_t             cnt = --heap->fwk_count;
 
 	/* Copy root node to caller specified location. */
 	cpy(node, root);
@@ -307,7 +307,7 @@ void fwk_heap_clear(struct fwk_heap *heap)
 	fbmp_clear_all(heap->fwk_rbits, farr_nr(&heap->fwk_nodes));
 }
 
-void fwk_heap_build(struct fwk_heap *heap, unsigned int count)
+void fwk_heap_build(struct fwk_heap *heap, size_t count)
 {
 	fwk_heap_assert(heap);
 	karn_assert(count);
@@ -321,10 +321,87 @@ void fwk_heap_build(struct fwk_heap *heap, unsigned int count)
 	              FWK_HEAP_REGULAR_ORDER);
 }
 
+void fwk_heap_insert_batch(struct fwk_heap *heap,
+                           const char      *nodes,
+                           size_t           nr)
+{
+	fwk_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(nr <= (fwk_heap_nr(heap) - fwk_heap_count(heap)));
+
+	size_t cnt = heap->fwk_count;
+	size_t size = farr_slot_size(&heap->fwk_nodes);
+	size_t idx;
+
+	if (!nr)
+		return;
+
+	if (nr < cnt) {
+		/* Small batch: sift nodes up one by one. */
+		while (nr--) {
+			fwk_heap_insert(heap, nodes);
+			nodes += size;
+		}
+
+		return;
+	}
+
+	/* Large batch: append nodes then rebuild the whole heap. */
+	for (idx = cnt; idx < (cnt + nr); idx++, nodes += size)
+		heap->fwk_copy(farr_slot(&heap->fwk_nodes, idx), nodes);
+
+	fwk_heap_build(heap, cnt + nr);
+}
+
+size_t fwk_heap_extract_batch(struct fwk_heap *heap,
+                              char            *nodes,
+                              size_t           nr)
+{
+	fwk_heap_assert(heap);
+	karn_assert(nodes || !nr);
+
+	const struct farr *slots = &heap->fwk_nodes;
+	char              *root = farr_slot(slots, FWK_HEAP_ROOT_INDEX);
+	size_t             cnt = heap->fwk_count;
+	size_t             size = farr_slot_size(slots);
+	char               tmp[size];
+	size_t             n;
+
+	if (nr > cnt)
+		nr = cnt;
+
+	/*
+	 * Run nr steps of weak heapsort: swap root with the last node, then
+	 * sift the new root down. Tail slots end up holding extracted nodes in
+	 * reverse order.
+	 */
+	for (n = 0; n < nr; n++) {
+		if (!--cnt)
+			/* Last node already sits into its tail slot. */
+			continue;
+
+		farr_swap(root, farr_slot(slots, cnt), tmp, heap->fwk_copy);
+
+		if (cnt > 1)
+			fwk_heap_siftdown(slots, heap->fwk_rbits, cnt,
+			                  heap->fwk_compare, heap->fwk_copy,
+			                  FWK_HEAP_REGULAR_ORDER);
+	}
+
+	heap->fwk_count = cnt;
+
+	while (n--) {
+		heap->fwk_copy(nodes, farr_slot(slots, cnt + n));
+		nodes += size;
+	}
+
+	return nr;
+}
+
 int fwk_heap_init(struct fwk_heap *heap,
                   char            *nodes,
                   size_t           node_size,
-                  unsigned int     node_nr,
+                  size_t           node_nr,
                   farr_compare_fn *compare,
                   farr_copy_fn    *copy)
 {
@@ -354,7 +431,7 @@ void fwk_heap_fini(struct fwk_heap *heap)
 }
 
 struct fwk_heap * fwk_heap_create(size_t           node_size,
-                                  unsigned int     node_nr,
+                                  size_t           node_nr,
                                   farr_compare_fn *compare,
                                   farr_copy_fn    *copy)
 {
@@ -387,6 +464,123 @@ void fwk_heap_destroy(struct fwk_heap *heap)
 	free(heap);
 }
 
+#if defined(CONFIG_KARN_FWK_HEAP_GROW)
+
+/*
+ * Resize nodes and reverse bits storage. Reverse bits are always kept at least
+ * as large as nodes so that fwk_heap_clear() and fwk_heap_build() may safely
+ * reset all of them. Grown reverse bits need no initialization since
+ * fwk_heap_insert() clears them as nodes are added.
+ */
+static int fwk_heap_resize(struct fwk_heap *heap, size_t nr)
+{
+	uintptr_t *rbits;
+	int        err;
+
+	if (nr > farr_nr(&heap->fwk_nodes)) {
+		rbits = realloc(heap->fwk_rbits,
+		                fbmp_word_nr(nr) * sizeof(*rbits));
+		if (!rbits)
+			return -ENOMEM;
+		heap->fwk_rbits = rbits;
+
+		return farr_realloc(&heap->fwk_nodes, nr);
+	}
+
+	err = farr_realloc(&heap->fwk_nodes, nr);
+	if (err)
+		return err;
+
+	/* Keeping larger reverse bits on failure is harmless. */
+	rbits = realloc(heap->fwk_rbits, fbmp_word_nr(nr) * sizeof(*rbits));
+	if (rbits)
+		heap->fwk_rbits = rbits;
+
+	return 0;
+}
+
+int fwk_heap_init_grow(struct fwk_heap *heap,
+                       size_t           node_size,
+                       size_t           node_nr,
+                       farr_compare_fn *compare,
+                       farr_copy_fn    *copy)
+{
+	karn_assert(heap);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	int err;
+
+	heap->fwk_rbits = fbmp_create(node_nr);
+	if (!heap->fwk_rbits)
+		return -ENOMEM;
+
+	err = farr_alloc(&heap->fwk_nodes, node_size, node_nr);
+	if (err) {
+		fbmp_destroy(heap->fwk_rbits);
+		return err;
+	}
+
+	heap->fwk_compare = compare;
+	heap->fwk_copy = copy;
+	heap->fwk_count = 0;
+
+	return 0;
+}
+
+void fwk_heap_fini_grow(struct fwk_heap *heap)
+{
+	fwk_heap_assert(heap);
+
+	farr_free(&heap->fwk_nodes);
+	fbmp_destroy(heap->fwk_rbits);
+}
+
+int fwk_heap_reserve(struct fwk_heap *heap, size_t nr)
+{
+	fwk_heap_assert(heap);
+
+	if (nr <= fwk_heap_nr(heap))
+		return 0;
+
+	return fwk_heap_resize(heap, nr);
+}
+
+int fwk_heap_insert_grow(struct fwk_heap *heap, const char *node)
+{
+	if (fwk_heap_full(heap)) {
+		size_t nr = fwk_heap_nr(heap);
+		int    err;
+
+		if (nr > (SIZE_MAX / 2))
+			return -ENOMEM;
+
+		err = fwk_heap_resize(heap, 2 * nr);
+		if (err)
+			return err;
+	}
+
+	fwk_heap_insert(heap, node);
+
+	return 0;
+}
+
+void fwk_heap_extract_shrink(struct fwk_heap *heap,
+                             char            *node,
+                             size_t           min_nr)
+{
+	size_t nr;
+
+	fwk_heap_extract(heap, node);
+
+	/* See fbnr_heap_extract_shrink(). */
+	nr = fwk_heap_nr(heap) / 2;
+	if ((fwk_heap_count(heap) <= (nr / 2)) && (nr >= min_nr) && nr)
+		fwk_heap_resize(heap, nr);
+}
+
+#endif /* defined(CONFIG_KARN_FWK_HEAP_GROW) */
+
 #if defined(CONFIG_KARN_FWK_HEAP_SORT)
 
 int fwk_heap_sort(char            *entries,
@@ -0,0 +1,294 @@
+/**
+ * @file      ltree.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Loser tree based k-way merging implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/ltree.h>
+#include <stdlib.h>
+#include <errno.h>
+
+/*
+ * Tree of k inputs is laid out as an implicit binary tree: nodes[0] holds the
+ * index of the overall winner, i.e. the input holding the smallest element,
+ * nodes[1] to nodes[k - 1] hold losers of matches played at internal nodes.
+ * Leaf of input i sits at implicit position i + k. nodes[k] to nodes[2k - 1]
+ * are used as scratch area to hold internal nodes winners at building time.
+ */
+
+/*
+ * Generate tree building and match replaying functions for inputs of the
+ * given kind, out of the ltree_<kind>_beats() function telling whether
+ * first input should be output before second one.
+ */
+#define LTREE_MATCHES(_kind, _input_type, _compare_type) \
+	static void ltree_ ## _kind ## _build(unsigned int       *nodes, \
+	                                      unsigned int        nr, \
+	                                      const _input_type  *inputs, \
+	                                      _compare_type      *compare) \
+	{ \
+		unsigned int *winners = &nodes[nr]; \
+		unsigned int  n; \
+		\
+		for (n = nr - 1; n > 0; n--) { \
+			unsigned int l = 2 * n; \
+			unsigned int r = l + 1; \
+			\
+			l = (l < nr) ? winners[l] : (l - nr); \
+			r = (r < nr) ? winners[r] : (r - nr); \
+			\
+			if (ltree_ ## _kind ## _beats(inputs, compare, l, r)) { \
+				winners[n] = l; \
+				nodes[n] = r; \
+			} \
+			else { \
+				winners[n] = r; \
+				nodes[n] = l; \
+			} \
+		} \
+		\
+		nodes[0] = (nr > 1) ? winners[1] : 0; \
+	} \
+	\
+	static void ltree_ ## _kind ## _replay(unsigned int       *nodes, \
+	                                       unsigned int        nr, \
+	                                       const _input_type  *inputs, \
+	                                       _compare_type      *compare, \
+	                                       unsigned int        winner) \
+	{ \
+		unsigned int node = (winner + nr) / 2; \
+		\
+		while (node) { \
+			unsigned int loser = nodes[node]; \
+			\
+			if (ltree_ ## _kind ## _beats(inputs, compare, loser, \
+			                              winner)) { \
+				nodes[node] = winner; \
+				winner = loser; \
+			} \
+			\
+			node /= 2; \
+		} \
+		\
+		nodes[0] = winner; \
+	}
+
+static inline bool ltree_run_empty(const struct ltree_run *run)
+{
+	return run->ltree_next == run->ltree_end;
+}
+
+/*
+ * Exhausted runs lose all matches. Ties are won by lowest index run to keep
+ * merging stable.
+ */
+static inline bool ltree_runs_beats(const struct ltree_run *runs,
+                                    farr_compare_fn        *compare,
+                                    unsigned int            first,
+                                    unsigned int            second)
+{
+	const struct ltree_run *fst = &runs[first];
+	const struct ltree_run *snd = &runs[second];
+	int                     ret;
+
+	if (ltree_run_empty(fst))
+		return false;
+	if (ltree_run_empty(snd))
+		return true;
+
+	ret = compare(fst->ltree_next, snd->ltree_next);
+
+	return (ret < 0) || (!ret && (first < second));
+}
+
+LTREE_MATCHES(runs, struct ltree_run, farr_compare_fn)
+
+int ltree_merge_runs(struct ltree     *tree,
+                     struct ltree_run *runs,
+                     unsigned int      run_nr,
+                     size_t            rec_size,
+                     farr_compare_fn  *compare,
+                     ltree_refill_fn  *refill,
+                     ltree_output_fn  *output,
+                     void             *data)
+{
+	ltree_assert(tree);
+	karn_assert(runs);
+	karn_assert(run_nr);
+	karn_assert(run_nr <= tree->ltree_nr);
+	karn_assert(rec_size);
+	karn_assert(compare);
+	karn_assert(output);
+
+	unsigned int *nodes = tree->ltree_nodes;
+	unsigned int  r;
+	int           err;
+
+	if (refill) {
+		for (r = 0; r < run_nr; r++) {
+			if (!ltree_run_empty(&runs[r]))
+				continue;
+
+			err = refill(&runs[r], r, data);
+			if (err)
+				return err;
+		}
+	}
+
+	ltree_runs_build(nodes, run_nr, runs, compare);
+
+	while (true) {
+		unsigned int      w = nodes[0];
+		struct ltree_run *run = &runs[w];
+
+		if (ltree_run_empty(run))
+			/* Winner is a sentinel: all runs are exhausted. */
+			return 0;
+
+		err = output(run->ltree_next, data);
+		if (err)
+			return err;
+
+		run->ltree_next += rec_size;
+		if (ltree_run_empty(run) && refill) {
+			err = refill(run, w, data);
+			if (err)
+				return err;
+		}
+
+		ltree_runs_replay(nodes, run_nr, runs, compare, w);
+	}
+}
+
+void ltree_merge_farr(struct ltree     *tree,
+                      struct ltree_run *runs,
+                      unsigned int      run_nr,
+                      char             *result,
+                      size_t            rec_size,
+                      farr_compare_fn  *compare,
+                      farr_copy_fn     *copy)
+{
+	ltree_assert(tree);
+	karn_assert(runs);
+	karn_assert(run_nr);
+	karn_assert(run_nr <= tree->ltree_nr);
+	karn_assert(result);
+	karn_assert(rec_size);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	unsigned int *nodes = tree->ltree_nodes;
+
+	ltree_runs_build(nodes, run_nr, runs, compare);
+
+	while (true) {
+		unsigned int      w = nodes[0];
+		struct ltree_run *run = &runs[w];
+
+		if (ltree_run_empty(run))
+			return;
+
+		copy(result, run->ltree_next);
+		result += rec_size;
+		run->ltree_next += rec_size;
+
+		ltree_runs_replay(nodes, run_nr, runs, compare, w);
+	}
+}
+
+#if defined(CONFIG_KARN_SLIST)
+
+static inline bool ltree_slists_beats(const struct slist *lists,
+                                      slist_compare_fn   *compare,
+                                      unsigned int        first,
+                                      unsigned int        second)
+{
+	const struct slist *fst = &lists[first];
+	const struct slist *snd = &lists[second];
+	int                 ret;
+
+	if (slist_empty(fst))
+		return false;
+	if (slist_empty(snd))
+		return true;
+
+	ret = compare(slist_first(fst), slist_first(snd));
+
+	return (ret < 0) || (!ret && (first < second));
+}
+
+LTREE_MATCHES(slists, struct slist, slist_compare_fn)
+
+void ltree_merge_slist(struct ltree     *tree,
+                       struct slist     *result,
+                       struct slist     *lists,
+                       unsigned int      list_nr,
+                       slist_compare_fn *compare)
+{
+	ltree_assert(tree);
+	karn_assert(result);
+	karn_assert(lists);
+	karn_assert(list_nr);
+	karn_assert(list_nr <= tree->ltree_nr);
+	karn_assert(compare);
+
+	unsigned int *nodes = tree->ltree_nodes;
+
+	ltree_slists_build(nodes, list_nr, lists, compare);
+
+	while (true) {
+		unsigned int  w = nodes[0];
+		struct slist *list = &lists[w];
+
+		if (slist_empty(list))
+			return;
+
+		slist_nqueue(result, slist_dqueue(list));
+
+		ltree_slists_replay(nodes, list_nr, lists, compare, w);
+	}
+}
+
+#endif /* defined(CONFIG_KARN_SLIST) */
+
+int ltree_init(struct ltree *tree, unsigned int nr)
+{
+	karn_assert(tree);
+	karn_assert(nr);
+
+	/* Tree nodes followed by ltree_<kind>_build() scratch area. */
+	tree->ltree_nodes = malloc(2 * nr * sizeof(tree->ltree_nodes[0]));
+	if (!tree->ltree_nodes)
+		return -ENOMEM;
+
+	tree->ltree_nr = nr;
+
+	return 0;
+}
+
+void ltree_fini(struct ltree *tree)
+{
+	ltree_assert(tree);
+
+	free(tree->ltree_nodes);
+}
@@ -1,5 +1,8 @@
 #include <karn/pbnm_heap.h>
 
+/* Ranks are bounded by the number of bits of pbnm_count. */
+#define PBNM_HEAP_RANK_NR (32U)
+
 #define pbnm_heap_assert_node(_node) \
 	karn_assert(_node); \
 	karn_assert((_node)->pbnm_handle); \
@@ -152,6 +155,75 @@ pbnm_heap_merge_trees(struct pbnm_heap_node *first,
 	return res;
 }
 
+/*
+ * Store tree into the rank indexed array, joining it with trees of equal ranks
+ * the same way a binary counter propagates carries.
+ *
+ * Return rank of the tree stored.
+ */
+static unsigned int
+pbnm_heap_carry_tree(struct pbnm_heap_node *trees[],
+                     struct pbnm_heap_node *tree,
+                     pbnm_heap_compare_fn  *compare)
+{
+	unsigned int rank = tree->pbnm_rank;
+
+	karn_assert(rank < PBNM_HEAP_RANK_NR);
+
+	while (trees[rank]) {
+		tree = pbnm_heap_join(trees[rank], tree, compare);
+		trees[rank++] = NULL;
+	}
+
+	trees[rank] = tree;
+
+	return rank;
+}
+
+/*
+ * Move all roots into the rank indexed array and return the greatest rank
+ * stored.
+ */
+static unsigned int
+pbnm_heap_spread_roots(struct pbnm_heap      *heap,
+                       struct pbnm_heap_node *trees[])
+{
+	struct pbnm_heap_node *root = heap->pbnm_roots;
+	unsigned int           top = 0;
+
+	while (root) {
+		struct pbnm_heap_node *nxt = root->pbnm_sibling;
+		unsigned int           rank;
+
+		rank = pbnm_heap_carry_tree(trees, root, heap->pbnm_compare);
+		top = umax(top, rank);
+
+		root = nxt;
+	}
+
+	return top;
+}
+
+/* Rebuild rank ordered root list starting from greatest rank. */
+static void
+pbnm_heap_gather_roots(struct pbnm_heap      *heap,
+                       struct pbnm_heap_node *trees[],
+                       unsigned int           top)
+{
+	struct pbnm_heap_node *root = NULL;
+	unsigned int           rank = top + 1;
+
+	while (rank--) {
+		if (!trees[rank])
+			continue;
+
+		trees[rank]->pbnm_sibling = root;
+		root = trees[rank];
+	}
+
+	heap->pbnm_roots = root;
+}
+
 static void
 pbnm_heap_remove_root(struct pbnm_heap       *heap,
                       struct pbnm_heap_node **previous,
@@ -282,6 +354,103 @@ pbnm_heap_extract(struct pbnm_heap *heap)
 	return key;
 }
 
+void
+pbnm_heap_insert_batch(struct pbnm_heap      *heap,
+                       struct pbnm_heap_node *keys[],
+                       unsigned int           nr)
+{
+	pbnm_heap_assert(heap);
+	karn_assert(keys || !nr);
+
+	struct pbnm_heap_node *trees[PBNM_HEAP_RANK_NR] = { NULL, };
+	unsigned int           top;
+	unsigned int           n;
+
+	if (!nr)
+		return;
+
+	/*
+	 * Carry keys as singleton trees into the rank indexed array holding
+	 * current roots, then rebuild the root list once.
+	 */
+	top = pbnm_heap_spread_roots(heap, trees);
+
+	for (n = 0; n < nr; n++) {
+		struct pbnm_heap_node *key = keys[n];
+		unsigned int           rank;
+
+		pbnm_heap_assert_node(key);
+
+		key->pbnm_parent = NULL;
+		key->pbnm_youngest = NULL;
+		key->pbnm_rank = 0;
+
+		rank = pbnm_heap_carry_tree(trees, key, heap->pbnm_compare);
+		top = umax(top, rank);
+	}
+
+	heap->pbnm_count += nr;
+
+	pbnm_heap_gather_roots(heap, trees, top);
+}
+
+unsigned int
+pbnm_heap_extract_batch(struct pbnm_heap      *heap,
+                        struct pbnm_heap_node *keys[],
+                        unsigned int           nr)
+{
+	pbnm_heap_assert(heap);
+	karn_assert(keys || !nr);
+
+	struct pbnm_heap_node *trees[PBNM_HEAP_RANK_NR] = { NULL, };
+	pbnm_heap_compare_fn  *cmp = heap->pbnm_compare;
+	unsigned int           top;
+	unsigned int           n;
+
+	if (nr > heap->pbnm_count)
+		nr = heap->pbnm_count;
+	if (!nr)
+		return 0;
+
+	/* See sbnm_heap_extract_batch(). */
+	top = pbnm_heap_spread_roots(heap, trees);
+
+	for (n = 0; n < nr; n++) {
+		struct pbnm_heap_node *key = NULL;
+		struct pbnm_heap_node *child;
+		unsigned int           rank;
+
+		for (rank = 0; rank <= top; rank++) {
+			if (!trees[rank])
+				continue;
+
+			if (!key || (cmp(trees[rank], key) < 0))
+				key = trees[rank];
+		}
+
+		trees[key->pbnm_rank] = NULL;
+
+		child = key->pbnm_youngest;
+		while (child) {
+			struct pbnm_heap_node *nxt = child->pbnm_sibling;
+
+			child->pbnm_parent = NULL;
+			rank = pbnm_heap_carry_tree(trees, child, cmp);
+			top = umax(top, rank);
+
+			child = nxt;
+		}
+
+		keys[n] = key;
+	}
+
+	heap->pbnm_count -= nr;
+
+	pbnm_heap_gather_roots(heap, trees, top);
+
+	return nr;
+}
+
 void
 pbnm_heap_remove(struct pbnm_heap *heap, struct pbnm_heap_node *key)
 {
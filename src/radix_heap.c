@@ -0,0 +1,202 @@
+/**
+ * @file      radix_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Radix heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/radix_heap.h>
+
+/* Return index of bucket key belongs to relative to last extracted key. */
+static inline unsigned int radix_heap_bucket_index(uint64_t last, uint64_t key)
+{
+	karn_assert(key >= last);
+
+	if (key == last)
+		return 0;
+
+	return 64U - (unsigned int)__builtin_clzll(key ^ last);
+}
+
+/*
+ * Link node at the head of bucket: unlike enqueueing at the tail, this does not
+ * touch any other node which would most probably cost a cache miss.
+ */
+static inline void radix_heap_link(struct radix_heap      *heap,
+                                   struct radix_heap_node *node,
+                                   unsigned int            bucket)
+{
+	struct slist *list = &heap->radix_buckets[bucket];
+
+	slist_append(list, slist_head(list), &node->radix_slist);
+
+	if (node->radix_key < heap->radix_mins[bucket])
+		heap->radix_mins[bucket] = node->radix_key;
+
+	if (bucket)
+		heap->radix_bmap |= UINT64_C(1) << (bucket - 1);
+}
+
+/*
+ * Ensure bucket 0 is not empty, i.e. advance last extracted key to the
+ * smallest key of the first non-empty bucket and redistribute its nodes into
+ * lower buckets. Smallest key node lands into bucket 0.
+ *
+ * Bucket smallest keys are maintained at link time so that buckets are walked
+ * only once. Since they are not raised when radix_heap_promote() unlinks a
+ * node, they are lower bounds only and a few rounds may be required.
+ */
+static void radix_heap_settle(struct radix_heap *heap)
+{
+	karn_assert(heap->radix_count);
+
+	while (slist_empty(&heap->radix_buckets[0])) {
+		unsigned int  bucket;
+		struct slist *list;
+		uint64_t      min;
+
+		bucket = (unsigned int)__builtin_ctzll(heap->radix_bmap) + 1;
+		list = &heap->radix_buckets[bucket];
+		min = heap->radix_mins[bucket];
+
+		heap->radix_last = min;
+		heap->radix_bmap &= ~(UINT64_C(1) << (bucket - 1));
+		heap->radix_mins[bucket] = UINT64_MAX;
+
+		/*
+		 * All keys of bucket share the bucket - 1 most significant
+		 * bits of min: every node moves to a strictly lower bucket.
+		 */
+		do {
+			struct radix_heap_node *node;
+
+			node = slist_entry(slist_dqueue(list),
+			                   struct radix_heap_node,
+			                   radix_slist);
+
+			radix_heap_link(heap,
+			                node,
+			                radix_heap_bucket_index(min,
+			                                        node->radix_key));
+		} while (!slist_empty(list));
+	}
+}
+
+void radix_heap_insert(struct radix_heap      *heap,
+                       struct radix_heap_node *node,
+                       uint64_t                key)
+{
+	radix_heap_assert(heap);
+	karn_assert(node);
+	karn_assert(key >= heap->radix_last);
+
+	node->radix_key = key;
+
+	radix_heap_link(heap, node,
+	                radix_heap_bucket_index(heap->radix_last, key));
+
+	heap->radix_count++;
+}
+
+struct radix_heap_node * radix_heap_peek(struct radix_heap *heap)
+{
+	karn_assert(!radix_heap_empty(heap));
+
+	radix_heap_settle(heap);
+
+	return slist_first_entry(&heap->radix_buckets[0],
+	                         struct radix_heap_node,
+	                         radix_slist);
+}
+
+struct radix_heap_node * radix_heap_extract(struct radix_heap *heap)
+{
+	karn_assert(!radix_heap_empty(heap));
+
+	radix_heap_settle(heap);
+
+	heap->radix_count--;
+
+	return slist_entry(slist_dqueue(&heap->radix_buckets[0]),
+	                   struct radix_heap_node,
+	                   radix_slist);
+}
+
+void radix_heap_promote(struct radix_heap      *heap,
+                        struct radix_heap_node *node,
+                        uint64_t                key)
+{
+	radix_heap_assert(heap);
+	karn_assert(node);
+	karn_assert(key <= node->radix_key);
+	karn_assert(key >= heap->radix_last);
+
+	unsigned int       old = radix_heap_bucket_index(heap->radix_last,
+	                                                 node->radix_key);
+	unsigned int       bucket = radix_heap_bucket_index(heap->radix_last,
+	                                                    key);
+	struct slist      *list;
+	struct slist_node *prev;
+
+	node->radix_key = key;
+	if (bucket == old) {
+		/* Buckets are not ordered: just track smallest key. */
+		if (key < heap->radix_mins[bucket])
+			heap->radix_mins[bucket] = key;
+
+		return;
+	}
+
+	list = &heap->radix_buckets[old];
+	prev = slist_head(list);
+	while (slist_next(prev) != &node->radix_slist)
+		prev = slist_next(prev);
+
+	slist_remove(list, prev, &node->radix_slist);
+	if (slist_empty(list)) {
+		heap->radix_bmap &= ~(UINT64_C(1) << (old - 1));
+		heap->radix_mins[old] = UINT64_MAX;
+	}
+
+	radix_heap_link(heap, node, bucket);
+}
+
+void radix_heap_init(struct radix_heap *heap, uint64_t base)
+{
+	karn_assert(heap);
+
+	unsigned int b;
+
+	heap->radix_count = 0;
+	heap->radix_last = base;
+	heap->radix_bmap = 0;
+
+	for (b = 0; b < RADIX_HEAP_BUCKET_NR; b++) {
+		slist_init(&heap->radix_buckets[b]);
+		heap->radix_mins[b] = UINT64_MAX;
+	}
+}
+
+void radix_heap_fini(struct radix_heap *heap __unused)
+{
+	radix_heap_assert(heap);
+}
@@ -0,0 +1,416 @@
+/**
+ * @file      rpair_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Rank-pairing heap implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/rpair_heap.h>
+
+/*
+ * Maximum rank + 1. Ranks are bounded by log_phi(n) + O(1) for both rank
+ * rules, phi being the golden ratio, i.e. less than 48 for 32 bits counts.
+ */
+#define RPAIR_HEAP_RANK_NR (64U)
+
+/*
+ * Binary tree accessors. rpair_lcrs being the first rpair_heap_node field,
+ * casts preserve NULL pointers.
+ */
+static inline struct rpair_heap_node *
+rpair_heap_left(const struct rpair_heap_node *node)
+{
+	return (struct rpair_heap_node *)node->rpair_lcrs.lcrs_youngest;
+}
+
+static inline void rpair_heap_set_left(struct rpair_heap_node *node,
+                                       struct rpair_heap_node *left)
+{
+	node->rpair_lcrs.lcrs_youngest = (struct lcrs_node *)left;
+}
+
+static inline struct rpair_heap_node *
+rpair_heap_right(const struct rpair_heap_node *node)
+{
+	return (struct rpair_heap_node *)node->rpair_lcrs.lcrs_sibling;
+}
+
+static inline void rpair_heap_set_right(struct rpair_heap_node *node,
+                                        struct rpair_heap_node *right)
+{
+	node->rpair_lcrs.lcrs_sibling = (struct lcrs_node *)right;
+}
+
+/* Return rank of node, missing nodes being given a rank of -1. */
+static inline int rpair_heap_rank(const struct rpair_heap_node *node)
+{
+	return node ? (int)node->rpair_rank : -1;
+}
+
+/* Insert root into root list right after min. */
+static inline void rpair_heap_splice(struct rpair_heap_node *min,
+                                     struct rpair_heap_node *root)
+{
+	root->rpair_parent = NULL;
+	rpair_heap_set_right(root, rpair_heap_right(min));
+	rpair_heap_set_right(min, root);
+}
+
+/* Insert root into root list and update smallest root. */
+static void rpair_heap_enroot(struct rpair_heap      *heap,
+                              struct rpair_heap_node *root,
+                              rpair_heap_compare_fn  *compare)
+{
+	struct rpair_heap_node *min = heap->rpair_min;
+
+	if (!min) {
+		root->rpair_parent = NULL;
+		rpair_heap_set_right(root, root);
+		heap->rpair_min = root;
+
+		return;
+	}
+
+	rpair_heap_splice(min, root);
+
+	if (compare(root, min) < 0)
+		heap->rpair_min = root;
+}
+
+/*
+ * Link 2 half trees of equal rank: the root with larger key becomes the left
+ * child of the other one, its former left subtree becoming its right subtree.
+ */
+static struct rpair_heap_node *
+rpair_heap_link(struct rpair_heap_node *first,
+                struct rpair_heap_node *second,
+                rpair_heap_compare_fn  *compare)
+{
+	karn_assert(first->rpair_rank == second->rpair_rank);
+
+	struct rpair_heap_node *root, *child, *left;
+
+	if (compare(second, first) < 0) {
+		root = second;
+		child = first;
+	}
+	else {
+		root = first;
+		child = second;
+	}
+
+	left = rpair_heap_left(root);
+
+	rpair_heap_set_right(child, left);
+	if (left)
+		left->rpair_parent = child;
+
+	rpair_heap_set_left(root, child);
+	child->rpair_parent = root;
+	root->rpair_rank++;
+
+	return root;
+}
+
+/*
+ * One-pass linking: link root with the half tree of same rank seen last if
+ * any and move the result into the root list. Otherwise, keep root pending till
+ * another half tree of same rank shows up.
+ */
+static void rpair_heap_bucket(struct rpair_heap      *heap,
+                              struct rpair_heap_node *buckets[],
+                              struct rpair_heap_node *root,
+                              rpair_heap_compare_fn  *compare)
+{
+	unsigned int rank = root->rpair_rank;
+
+	karn_assert(rank < RPAIR_HEAP_RANK_NR);
+
+	if (!buckets[rank]) {
+		buckets[rank] = root;
+		return;
+	}
+
+	root = rpair_heap_link(buckets[rank], root, compare);
+	buckets[rank] = NULL;
+
+	rpair_heap_enroot(heap, root, compare);
+}
+
+/*
+ * Restore rank rule on the path going from node up to its root after one of
+ * node's subtrees has been cut.
+ */
+static void rpair_heap_repair(const struct rpair_heap *heap,
+                              struct rpair_heap_node  *node)
+{
+	while (node->rpair_parent) {
+		int left = rpair_heap_rank(rpair_heap_left(node));
+		int right = rpair_heap_rank(rpair_heap_right(node));
+		int rank = (left > right) ? left : right;
+
+		if (heap->rpair_type == RPAIR_HEAP_TYPE1) {
+			if (left == right)
+				rank++;
+		}
+		else if (uabs(left - right) <= 1)
+			rank++;
+
+		/* Ranks may only decrease: stop as soon as one is left as is. */
+		if (rank >= (int)node->rpair_rank)
+			return;
+
+		node->rpair_rank = (unsigned int)rank;
+		node = node->rpair_parent;
+	}
+
+	node->rpair_rank = (unsigned int)
+	                   (rpair_heap_rank(rpair_heap_left(node)) + 1);
+}
+
+/*
+ * Detach non root node along with its left subtree from its half tree. Node's
+ * right subtree takes its place.
+ */
+static void rpair_heap_cut(const struct rpair_heap *heap,
+                           struct rpair_heap_node  *node)
+{
+	struct rpair_heap_node *parent = node->rpair_parent;
+	struct rpair_heap_node *right = rpair_heap_right(node);
+
+	karn_assert(parent);
+
+	if (rpair_heap_left(parent) == node)
+		rpair_heap_set_left(parent, right);
+	else
+		rpair_heap_set_right(parent, right);
+
+	if (right)
+		right->rpair_parent = parent;
+
+	node->rpair_rank = (unsigned int)
+	                   (rpair_heap_rank(rpair_heap_left(node)) + 1);
+
+	rpair_heap_repair(heap, parent);
+}
+
+void rpair_heap_insert(struct rpair_heap      *heap,
+                       struct rpair_heap_node *node,
+                       rpair_heap_compare_fn  *compare)
+{
+	rpair_heap_assert(heap);
+	karn_assert(node);
+	karn_assert(compare);
+
+	rpair_heap_set_left(node, NULL);
+	node->rpair_rank = 0;
+
+	rpair_heap_enroot(heap, node, compare);
+
+	heap->rpair_count++;
+}
+
+void rpair_heap_insert_batch(struct rpair_heap      *heap,
+                             struct rpair_heap_node *nodes[],
+                             unsigned int            nr,
+                             rpair_heap_compare_fn  *compare)
+{
+	rpair_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(compare);
+
+	unsigned int n;
+
+	/*
+	 * Insertion is already lazy: nodes are linked together at next
+	 * extraction time only.
+	 */
+	for (n = 0; n < nr; n++)
+		rpair_heap_insert(heap, nodes[n], compare);
+}
+
+struct rpair_heap_node * rpair_heap_extract(struct rpair_heap     *heap,
+                                            rpair_heap_compare_fn *compare)
+{
+	karn_assert(!rpair_heap_empty(heap));
+	karn_assert(compare);
+
+	struct rpair_heap_node *min = heap->rpair_min;
+	struct rpair_heap_node *buckets[RPAIR_HEAP_RANK_NR] = { NULL, };
+	struct rpair_heap_node *node;
+	unsigned int            r;
+
+	heap->rpair_count--;
+	heap->rpair_min = NULL;
+
+	/* Link remaining roots... */
+	node = rpair_heap_right(min);
+	while (node != min) {
+		struct rpair_heap_node *next = rpair_heap_right(node);
+
+		rpair_heap_bucket(heap, buckets, node, compare);
+		node = next;
+	}
+
+	/*
+	 * ...then the half trees found along the right spine of min's left
+	 * subtree.
+	 */
+	node = rpair_heap_left(min);
+	while (node) {
+		struct rpair_heap_node *next = rpair_heap_right(node);
+
+		node->rpair_rank = (unsigned int)
+		                   (rpair_heap_rank(rpair_heap_left(node)) + 1);
+		rpair_heap_bucket(heap, buckets, node, compare);
+		node = next;
+	}
+
+	/* Finally move unpaired half trees into the root list. */
+	for (r = 0; r < RPAIR_HEAP_RANK_NR; r++)
+		if (buckets[r])
+			rpair_heap_enroot(heap, buckets[r], compare);
+
+	return min;
+}
+
+void rpair_heap_remove(struct rpair_heap      *heap,
+                       struct rpair_heap_node *node,
+                       rpair_heap_compare_fn  *compare)
+{
+	karn_assert(!rpair_heap_empty(heap));
+	karn_assert(node);
+	karn_assert(compare);
+
+	if (node->rpair_parent) {
+		rpair_heap_cut(heap, node);
+		rpair_heap_splice(heap->rpair_min, node);
+	}
+
+	/* Make node the smallest root, i.e. as if promoted to minus infinity. */
+	heap->rpair_min = node;
+
+	rpair_heap_extract(heap, compare);
+}
+
+void rpair_heap_merge(struct rpair_heap     *result,
+                      struct rpair_heap     *source,
+                      rpair_heap_compare_fn *compare)
+{
+	rpair_heap_assert(result);
+	rpair_heap_assert(source);
+	karn_assert(result->rpair_type == source->rpair_type);
+	karn_assert(compare);
+
+	struct rpair_heap_node *rmin = result->rpair_min;
+	struct rpair_heap_node *smin = source->rpair_min;
+
+	if (!smin)
+		return;
+
+	if (rmin) {
+		/* Concatenate circular root lists. */
+		struct rpair_heap_node *right = rpair_heap_right(rmin);
+
+		rpair_heap_set_right(rmin, rpair_heap_right(smin));
+		rpair_heap_set_right(smin, right);
+
+		if (compare(smin, rmin) < 0)
+			result->rpair_min = smin;
+	}
+	else
+		result->rpair_min = smin;
+
+	result->rpair_count += source->rpair_count;
+
+	source->rpair_min = NULL;
+	source->rpair_count = 0;
+}
+
+void rpair_heap_promote(struct rpair_heap      *heap,
+                        struct rpair_heap_node *key,
+                        rpair_heap_compare_fn  *compare)
+{
+	karn_assert(!rpair_heap_empty(heap));
+	karn_assert(key);
+	karn_assert(compare);
+
+	if (key->rpair_parent) {
+		rpair_heap_cut(heap, key);
+		rpair_heap_splice(heap->rpair_min, key);
+	}
+
+	if (compare(key, heap->rpair_min) < 0)
+		heap->rpair_min = key;
+}
+
+void rpair_heap_demote(struct rpair_heap      *heap,
+                       struct rpair_heap_node *key,
+                       rpair_heap_compare_fn  *compare)
+{
+	karn_assert(!rpair_heap_empty(heap));
+	karn_assert(key);
+	karn_assert(compare);
+
+	struct rpair_heap_node *node;
+
+	if (key == heap->rpair_min) {
+		/* Smallest root has to be searched for again. */
+		rpair_heap_remove(heap, key, compare);
+		rpair_heap_insert(heap, key, compare);
+
+		return;
+	}
+
+	if (key->rpair_parent) {
+		rpair_heap_cut(heap, key);
+		rpair_heap_splice(heap->rpair_min, key);
+	}
+
+	/*
+	 * Keys found into key's left subtree may now be smaller than key: break
+	 * its right spine into half trees moved to the root list. These may not
+	 * be smaller than current smallest root.
+	 */
+	node = rpair_heap_left(key);
+	while (node) {
+		struct rpair_heap_node *next = rpair_heap_right(node);
+
+		node->rpair_rank = (unsigned int)
+		                   (rpair_heap_rank(rpair_heap_left(node)) + 1);
+		rpair_heap_splice(heap->rpair_min, node);
+		node = next;
+	}
+
+	rpair_heap_set_left(key, NULL);
+	key->rpair_rank = 0;
+}
+
+void rpair_heap_init(struct rpair_heap *heap, enum rpair_heap_type type)
+{
+	karn_assert(heap);
+	karn_assert((type == RPAIR_HEAP_TYPE1) || (type == RPAIR_HEAP_TYPE2));
+
+	heap->rpair_count = 0;
+	heap->rpair_type = type;
+	heap->rpair_min = NULL;
+}
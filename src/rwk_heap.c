@@ -0,0 +1,800 @@
+/**
+ * @file      rwk_heap.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Relaxed weak heap implementation
+ *
+ * Besides weak heap ordering of unmarked nodes, the following invariants are
+ * maintained:
+ * - roots are never marked ;
+ * - there are at most 2 trees per rank and a rank with no tree between any 2
+ *   ranks holding 2 trees ;
+ * - there are no more marked nodes than ranks non root nodes may have, i.e.
+ *   floor(log2(n)).
+ *
+ * Marked nodes are classified according to their siblings so that either a
+ * run or 2 singletons of same rank may be retrieved in constant time when the
+ * number of marks must be reduced.
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/rwk_heap.h>
+#include <utils/pow2.h>
+
+/*
+ * Tree accessors. rwk_lcrs being the first rwk_heap_node field, casts preserve
+ * NULL pointers.
+ */
+static inline struct rwk_heap_node *
+rwk_heap_youngest(const struct rwk_heap_node *node)
+{
+	return (struct rwk_heap_node *)node->rwk_lcrs.lcrs_youngest;
+}
+
+static inline void rwk_heap_set_youngest(struct rwk_heap_node *node,
+                                         struct rwk_heap_node *youngest)
+{
+	node->rwk_lcrs.lcrs_youngest = (struct lcrs_node *)youngest;
+}
+
+static inline struct rwk_heap_node *
+rwk_heap_next(const struct rwk_heap_node *node)
+{
+	return (struct rwk_heap_node *)node->rwk_lcrs.lcrs_sibling;
+}
+
+static inline void rwk_heap_set_next(struct rwk_heap_node *node,
+                                     struct rwk_heap_node *next)
+{
+	node->rwk_lcrs.lcrs_sibling = (struct lcrs_node *)next;
+}
+
+#define rwk_heap_mark_entry(_mark) \
+	dlist_entry(_mark, struct rwk_heap_node, rwk_mark)
+
+static inline bool rwk_heap_marked(const struct rwk_heap_node *node)
+{
+	return node && (node->rwk_state != RWK_HEAP_CLEAN);
+}
+
+/*
+ * Maximum number of marked nodes, i.e. the number of ranks non root nodes may
+ * have. Beyond this, either 2 singletons share the same rank or a run exists.
+ */
+static inline unsigned int rwk_heap_marks_max(const struct rwk_heap *heap)
+{
+	return heap->rwk_count ? pow2_lower(heap->rwk_count) : 0;
+}
+
+/* Update bitmaps of singletons once list of given rank has been modified. */
+static void rwk_heap_count_singles(struct rwk_heap *heap, unsigned int rank)
+{
+	const struct dlist_node *list = &heap->rwk_singles[rank];
+	uint32_t                 bit = UINT32_C(1) << rank;
+
+	if (dlist_empty(list)) {
+		heap->rwk_singles_bmap &= ~bit;
+		heap->rwk_pairs_bmap &= ~bit;
+		return;
+	}
+
+	heap->rwk_singles_bmap |= bit;
+	if (dlist_next(dlist_next(list)) != list)
+		heap->rwk_pairs_bmap |= bit;
+	else
+		heap->rwk_pairs_bmap &= ~bit;
+}
+
+/*
+ * Update state of a marked node according to its siblings: a marked node
+ * following a marked younger sibling is a run member, otherwise it is either
+ * the youngest member of a run or a singleton.
+ *
+ * Called on every node which siblings may have changed. Marked nodes ranks
+ * must not change since singletons are indexed by rank.
+ */
+static void rwk_heap_classify(struct rwk_heap *heap, struct rwk_heap_node *node)
+{
+	enum rwk_heap_state state;
+
+	if (!rwk_heap_marked(node))
+		return;
+
+	if (rwk_heap_marked(node->rwk_prev))
+		state = RWK_HEAP_MEMBER;
+	else if (rwk_heap_marked(rwk_heap_next(node)))
+		state = RWK_HEAP_RUN;
+	else
+		state = RWK_HEAP_SINGLE;
+
+	if (state == node->rwk_state)
+		return;
+
+	if (node->rwk_state != RWK_HEAP_MEMBER) {
+		dlist_remove(&node->rwk_mark);
+		if (node->rwk_state == RWK_HEAP_SINGLE)
+			rwk_heap_count_singles(heap, node->rwk_rank);
+	}
+
+	switch (state) {
+	case RWK_HEAP_RUN:
+		dlist_nqueue_back(&heap->rwk_runs, &node->rwk_mark);
+		break;
+
+	case RWK_HEAP_SINGLE:
+		dlist_nqueue_back(&heap->rwk_singles[node->rwk_rank],
+		                  &node->rwk_mark);
+		rwk_heap_count_singles(heap, node->rwk_rank);
+		break;
+
+	default:
+		break;
+	}
+
+	node->rwk_state = state;
+}
+
+static void rwk_heap_mark(struct rwk_heap *heap, struct rwk_heap_node *node)
+{
+	karn_assert(node->rwk_parent);
+	karn_assert(!rwk_heap_marked(node));
+
+	/* Start as a run member which belongs to no list. */
+	node->rwk_state = RWK_HEAP_MEMBER;
+	heap->rwk_marks_nr++;
+
+	rwk_heap_classify(heap, node);
+	if (node->rwk_prev)
+		rwk_heap_classify(heap, node->rwk_prev);
+	if (rwk_heap_next(node))
+		rwk_heap_classify(heap, rwk_heap_next(node));
+}
+
+static void rwk_heap_unmark(struct rwk_heap      *heap,
+                            struct rwk_heap_node *node)
+{
+	if (!rwk_heap_marked(node))
+		return;
+
+	if (node->rwk_state != RWK_HEAP_MEMBER) {
+		dlist_remove(&node->rwk_mark);
+		if (node->rwk_state == RWK_HEAP_SINGLE)
+			rwk_heap_count_singles(heap, node->rwk_rank);
+	}
+
+	node->rwk_state = RWK_HEAP_CLEAN;
+	heap->rwk_marks_nr--;
+
+	if (node->rwk_prev)
+		rwk_heap_classify(heap, node->rwk_prev);
+	if (rwk_heap_next(node))
+		rwk_heap_classify(heap, rwk_heap_next(node));
+}
+
+/*
+ * Link node into the slot described by parent, prev and next. A slot without
+ * parent nor previous sibling is the first root slot of node's rank.
+ */
+static void rwk_heap_place(struct rwk_heap      *heap,
+                           struct rwk_heap_node *node,
+                           struct rwk_heap_node *parent,
+                           struct rwk_heap_node *prev,
+                           struct rwk_heap_node *next)
+{
+	node->rwk_parent = parent;
+	node->rwk_prev = prev;
+	rwk_heap_set_next(node, next);
+
+	if (prev)
+		rwk_heap_set_next(prev, node);
+	else if (parent)
+		rwk_heap_set_youngest(parent, node);
+	else
+		heap->rwk_roots[node->rwk_rank] = node;
+
+	if (next)
+		next->rwk_prev = node;
+
+	rwk_heap_classify(heap, node);
+	if (prev)
+		rwk_heap_classify(heap, prev);
+	if (next)
+		rwk_heap_classify(heap, next);
+}
+
+/* Move node into the slot of old, both having the same rank. */
+static void rwk_heap_replace(struct rwk_heap      *heap,
+                             struct rwk_heap_node *old,
+                             struct rwk_heap_node *node)
+{
+	karn_assert(old->rwk_rank == node->rwk_rank);
+
+	rwk_heap_place(heap, node, old->rwk_parent, old->rwk_prev,
+	               rwk_heap_next(old));
+}
+
+/* Exchange slots of 2 unrelated and non adjacent nodes of same rank. */
+static void rwk_heap_swap(struct rwk_heap      *heap,
+                          struct rwk_heap_node *first,
+                          struct rwk_heap_node *second)
+{
+	struct rwk_heap_node *parent = first->rwk_parent;
+	struct rwk_heap_node *prev = first->rwk_prev;
+	struct rwk_heap_node *next = rwk_heap_next(first);
+
+	rwk_heap_replace(heap, second, first);
+	rwk_heap_place(heap, second, parent, prev, next);
+}
+
+/* Detach youngest child of an unmarked node. */
+static struct rwk_heap_node * rwk_heap_cut(struct rwk_heap      *heap,
+                                           struct rwk_heap_node *node)
+{
+	struct rwk_heap_node *child = rwk_heap_youngest(node);
+	struct rwk_heap_node *next = rwk_heap_next(child);
+
+	karn_assert(node->rwk_rank);
+	karn_assert(!rwk_heap_marked(node));
+	karn_assert(!rwk_heap_marked(child));
+
+	rwk_heap_set_youngest(node, next);
+	if (next) {
+		next->rwk_prev = NULL;
+		rwk_heap_classify(heap, next);
+	}
+
+	node->rwk_rank--;
+
+	return child;
+}
+
+/*
+ * Join 2 unmarked trees of same rank: the root with larger key becomes the
+ * youngest child of the other one. Slot of returned root is left untouched.
+ */
+static struct rwk_heap_node * rwk_heap_link(struct rwk_heap      *heap,
+                                            struct rwk_heap_node *first,
+                                            struct rwk_heap_node *second,
+                                            rwk_heap_compare_fn  *compare)
+{
+	karn_assert(first->rwk_rank == second->rwk_rank);
+	karn_assert(!rwk_heap_marked(first));
+	karn_assert(!rwk_heap_marked(second));
+
+	struct rwk_heap_node *root, *child, *young;
+
+	if (compare(second, first) < 0) {
+		root = second;
+		child = first;
+	}
+	else {
+		root = first;
+		child = second;
+	}
+
+	young = rwk_heap_youngest(root);
+
+	child->rwk_parent = root;
+	child->rwk_prev = NULL;
+	rwk_heap_set_next(child, young);
+	if (young) {
+		young->rwk_prev = child;
+		rwk_heap_classify(heap, young);
+	}
+
+	rwk_heap_set_youngest(root, child);
+	root->rwk_rank++;
+
+	return root;
+}
+
+/* Mark node moved into a slot where it may be smaller than its parent. */
+static void rwk_heap_settle(struct rwk_heap      *heap,
+                            struct rwk_heap_node *node,
+                            rwk_heap_compare_fn  *compare)
+{
+	if (node->rwk_parent && (compare(node, node->rwk_parent) < 0))
+		rwk_heap_mark(heap, node);
+}
+
+/*
+ * Sibling transformation: node's younger sibling is not marked but the latter's
+ * youngest child (the nephew) is. Join node and nephew into the younger
+ * sibling's slot and move what remains of younger sibling into node's slot.
+ * Return root of joined tree which may break heap order.
+ */
+static struct rwk_heap_node *
+rwk_heap_sibling(struct rwk_heap      *heap,
+                 struct rwk_heap_node *node,
+                 rwk_heap_compare_fn  *compare)
+{
+	struct rwk_heap_node *sibl = node->rwk_prev;
+	struct rwk_heap_node *parent = node->rwk_parent;
+	struct rwk_heap_node *prev = sibl->rwk_prev;
+	struct rwk_heap_node *next = rwk_heap_next(node);
+	struct rwk_heap_node *nephew;
+	struct rwk_heap_node *root;
+
+	rwk_heap_unmark(heap, node);
+
+	nephew = rwk_heap_youngest(sibl);
+	rwk_heap_unmark(heap, nephew);
+	rwk_heap_cut(heap, sibl);
+
+	root = rwk_heap_link(heap, node, nephew, compare);
+
+	rwk_heap_place(heap, root, parent, prev, sibl);
+	rwk_heap_place(heap, sibl, parent, root, next);
+
+	return root;
+}
+
+/*
+ * Run transformation: node and its younger sibling are marked, the latter being
+ * the youngest child of their parent. Split parent's tree into 4 trees of
+ * node's rank and join them back into parent's slot.
+ * Return root of joined tree if it may break heap order, NULL otherwise.
+ */
+static struct rwk_heap_node * rwk_heap_run(struct rwk_heap      *heap,
+                                           struct rwk_heap_node *node,
+                                           rwk_heap_compare_fn  *compare)
+{
+	struct rwk_heap_node *sibl = node->rwk_prev;
+	struct rwk_heap_node *parent = node->rwk_parent;
+	struct rwk_heap_node *gparent = parent->rwk_parent;
+	struct rwk_heap_node *prev = parent->rwk_prev;
+	struct rwk_heap_node *next = rwk_heap_next(parent);
+	bool                  marked = rwk_heap_marked(parent);
+	struct rwk_heap_node *nephew;
+	struct rwk_heap_node *first, *second, *root;
+
+	karn_assert(!sibl->rwk_prev);
+	karn_assert(parent->rwk_rank == (node->rwk_rank + 2));
+
+	rwk_heap_unmark(heap, parent);
+	rwk_heap_unmark(heap, sibl);
+	rwk_heap_unmark(heap, node);
+
+	nephew = rwk_heap_youngest(sibl);
+	rwk_heap_unmark(heap, nephew);
+	rwk_heap_cut(heap, sibl);
+
+	rwk_heap_cut(heap, parent);
+	rwk_heap_cut(heap, parent);
+
+	first = rwk_heap_link(heap, parent, node, compare);
+	second = rwk_heap_link(heap, sibl, nephew, compare);
+	root = rwk_heap_link(heap, first, second, compare);
+
+	rwk_heap_place(heap, root, gparent, prev, next);
+
+	if (root != parent)
+		return root;
+
+	/* Parent is left in place: restore its mark if any. */
+	if (marked)
+		rwk_heap_mark(heap, parent);
+
+	return NULL;
+}
+
+/*
+ * Pair transformation: node and other are youngest children of same rank.
+ * Join both parents into the slot of the smallest one and both nodes into the
+ * slot of the other parent.
+ * Return root of nodes joined tree which may break heap order.
+ */
+static struct rwk_heap_node * rwk_heap_pair(struct rwk_heap      *heap,
+                                            struct rwk_heap_node *node,
+                                            struct rwk_heap_node *other,
+                                            rwk_heap_compare_fn  *compare)
+{
+	struct rwk_heap_node *first = node->rwk_parent;
+	struct rwk_heap_node *second = other->rwk_parent;
+	struct rwk_heap_node *fparent = first->rwk_parent;
+	struct rwk_heap_node *fprev = first->rwk_prev;
+	struct rwk_heap_node *fnext = rwk_heap_next(first);
+	struct rwk_heap_node *sparent = second->rwk_parent;
+	struct rwk_heap_node *sprev = second->rwk_prev;
+	struct rwk_heap_node *snext = rwk_heap_next(second);
+	bool                  fmark = rwk_heap_marked(first);
+	bool                  smark = rwk_heap_marked(second);
+	struct rwk_heap_node *root;
+
+	karn_assert(first != second);
+	karn_assert(!node->rwk_prev);
+	karn_assert(!other->rwk_prev);
+
+	rwk_heap_unmark(heap, node);
+	rwk_heap_unmark(heap, other);
+	rwk_heap_unmark(heap, first);
+	rwk_heap_unmark(heap, second);
+
+	rwk_heap_cut(heap, first);
+	rwk_heap_cut(heap, second);
+
+	root = rwk_heap_link(heap, node, other, compare);
+
+	/* Winning parent stays in place and keeps its mark if any. */
+	if (rwk_heap_link(heap, first, second, compare) == first) {
+		rwk_heap_place(heap, root, sparent, sprev, snext);
+		if (fmark)
+			rwk_heap_mark(heap, first);
+	}
+	else {
+		rwk_heap_place(heap, root, fparent, fprev, fnext);
+		if (smark)
+			rwk_heap_mark(heap, second);
+	}
+
+	return root;
+}
+
+/*
+ * Reduce the number of marks of a run by applying a run transformation to its
+ * 2 youngest members, first moving them below their younger sibling if any.
+ */
+static void rwk_heap_reduce_run(struct rwk_heap      *heap,
+                                struct rwk_heap_node *young,
+                                rwk_heap_compare_fn  *compare)
+{
+	struct rwk_heap_node *node = rwk_heap_next(young);
+	struct rwk_heap_node *sibl = young->rwk_prev;
+	struct rwk_heap_node *root;
+
+	if (sibl) {
+		/*
+		 * Younger sibling is unmarked hence not smaller than parent:
+		 * its 2 youngest children may move below parent in place of
+		 * run members.
+		 */
+		struct rwk_heap_node *nephew = rwk_heap_youngest(sibl);
+		struct rwk_heap_node *next = rwk_heap_next(nephew);
+
+		rwk_heap_swap(heap, young, nephew);
+		rwk_heap_swap(heap, node, next);
+	}
+
+	root = rwk_heap_run(heap, node, compare);
+	if (root)
+		rwk_heap_settle(heap, root, compare);
+}
+
+/*
+ * Reduce the number of marks using 2 singletons of same rank. Turn each of them
+ * into a youngest child thanks to a cleaning transformation then apply a pair
+ * transformation, unless a sibling transformation applies.
+ */
+static void rwk_heap_reduce_pair(struct rwk_heap      *heap,
+                                 struct rwk_heap_node *node,
+                                 struct rwk_heap_node *other,
+                                 rwk_heap_compare_fn  *compare)
+{
+	struct rwk_heap_node *singles[] = { node, other };
+	struct rwk_heap_node *root;
+	unsigned int          s;
+
+	for (s = 0; s < array_nr(singles); s++) {
+		struct rwk_heap_node *sibl = singles[s]->rwk_prev;
+		struct rwk_heap_node *nephew;
+
+		if (!sibl)
+			continue;
+
+		nephew = rwk_heap_youngest(sibl);
+		if (rwk_heap_marked(nephew)) {
+			root = rwk_heap_sibling(heap, singles[s], compare);
+			rwk_heap_settle(heap, root, compare);
+			return;
+		}
+
+		/*
+		 * Cleaning transformation: nephew is not smaller than sibling,
+		 * itself not smaller than singleton's parent.
+		 */
+		rwk_heap_swap(heap, singles[s], nephew);
+	}
+
+	root = rwk_heap_pair(heap, node, other, compare);
+	rwk_heap_settle(heap, root, compare);
+}
+
+/*
+ * Apply a constant number of transformations to bring the number of marks
+ * back to its maximum. Since the number of marks exceeds the number of ranks
+ * marked nodes may have, either a run or 2 singletons of same rank exist.
+ */
+static void rwk_heap_reduce(struct rwk_heap     *heap,
+                            rwk_heap_compare_fn *compare)
+{
+	while (heap->rwk_marks_nr > rwk_heap_marks_max(heap)) {
+		if (!dlist_empty(&heap->rwk_runs)) {
+			struct dlist_node *young = dlist_next(&heap->rwk_runs);
+
+			rwk_heap_reduce_run(heap, rwk_heap_mark_entry(young),
+			                    compare);
+		}
+		else {
+			unsigned int       rank;
+			struct dlist_node *node;
+
+			karn_assert(heap->rwk_pairs_bmap);
+
+			rank = (unsigned int)
+			       __builtin_ctz(heap->rwk_pairs_bmap);
+			node = dlist_next(&heap->rwk_singles[rank]);
+
+			rwk_heap_reduce_pair(heap, rwk_heap_mark_entry(node),
+			                     rwk_heap_mark_entry(
+			                             dlist_next(node)),
+			                     compare);
+		}
+	}
+}
+
+/* Insert tree rooted at unmarked node into root set. */
+static void rwk_heap_add_root(struct rwk_heap      *heap,
+                              struct rwk_heap_node *node)
+{
+	unsigned int rank = node->rwk_rank;
+	uint32_t     bit = UINT32_C(1) << rank;
+
+	karn_assert(rank < RWK_HEAP_RANK_NR);
+	karn_assert(!(heap->rwk_carries_bmap & bit));
+
+	if (heap->rwk_roots_bmap & bit) {
+		rwk_heap_place(heap, node, NULL, heap->rwk_roots[rank], NULL);
+		heap->rwk_carries_bmap |= bit;
+	}
+	else {
+		rwk_heap_place(heap, node, NULL, NULL, NULL);
+		heap->rwk_roots_bmap |= bit;
+	}
+}
+
+/* Detach tree rooted at first root of its rank from root set. */
+static void rwk_heap_del_root(struct rwk_heap      *heap,
+                              struct rwk_heap_node *root)
+{
+	unsigned int rank = root->rwk_rank;
+	uint32_t     bit = UINT32_C(1) << rank;
+
+	karn_assert(heap->rwk_roots[rank] == root);
+
+	if (heap->rwk_carries_bmap & bit) {
+		/* Second root of same rank becomes the first one. */
+		heap->rwk_carries_bmap &= ~bit;
+		rwk_heap_place(heap, rwk_heap_next(root), NULL, NULL, NULL);
+	}
+	else
+		heap->rwk_roots_bmap &= ~bit;
+}
+
+/*
+ * Link both trees of smallest rank holding 2 trees, if any. Given that there
+ * is a rank with no tree between any 2 ranks holding 2 trees, next rank holds
+ * at most one tree.
+ */
+static void rwk_heap_fix_carry(struct rwk_heap     *heap,
+                               rwk_heap_compare_fn *compare)
+{
+	unsigned int          rank;
+	struct rwk_heap_node *first, *second;
+
+	if (!heap->rwk_carries_bmap)
+		return;
+
+	rank = (unsigned int)__builtin_ctz(heap->rwk_carries_bmap);
+	first = heap->rwk_roots[rank];
+	second = rwk_heap_next(first);
+
+	heap->rwk_carries_bmap &= ~(UINT32_C(1) << rank);
+	heap->rwk_roots_bmap &= ~(UINT32_C(1) << rank);
+
+	rwk_heap_add_root(heap, rwk_heap_link(heap, first, second, compare));
+}
+
+/*
+ * Detach tree rooted at smallest rank root, move its subtrees into root set
+ * and return its former root as a single node tree.
+ */
+static struct rwk_heap_node * rwk_heap_split_root(struct rwk_heap *heap)
+{
+	unsigned int          rank = (unsigned int)
+	                             __builtin_ctz(heap->rwk_roots_bmap);
+	struct rwk_heap_node *root = heap->rwk_roots[rank];
+	struct rwk_heap_node *child = rwk_heap_youngest(root);
+
+	rwk_heap_del_root(heap, root);
+
+	/* Smaller ranks hold no tree: at most one tree per rank results. */
+	while (child) {
+		struct rwk_heap_node *next = rwk_heap_next(child);
+
+		rwk_heap_unmark(heap, child);
+		rwk_heap_add_root(heap, child);
+
+		child = next;
+	}
+
+	rwk_heap_set_youngest(root, NULL);
+	root->rwk_rank = 0;
+
+	return root;
+}
+
+/*
+ * Rebuild a tree of node's rank made of node's subtrees and a spare node taken
+ * from the smallest tree, then move it into node's slot.
+ */
+static void rwk_heap_remove_node(struct rwk_heap      *heap,
+                                 struct rwk_heap_node *node,
+                                 rwk_heap_compare_fn  *compare)
+{
+	struct rwk_heap_node *children[RWK_HEAP_RANK_NR];
+	struct rwk_heap_node *spare;
+	struct rwk_heap_node *child;
+	unsigned int          c;
+
+	rwk_heap_unmark(heap, node);
+
+	spare = rwk_heap_split_root(heap);
+	if (spare == node)
+		return;
+
+	c = node->rwk_rank;
+	child = rwk_heap_youngest(node);
+	while (child) {
+		rwk_heap_unmark(heap, child);
+		children[--c] = child;
+		child = rwk_heap_next(child);
+	}
+
+	for (c = 0; c < node->rwk_rank; c++)
+		spare = rwk_heap_link(heap, spare, children[c], compare);
+
+	rwk_heap_replace(heap, node, spare);
+	rwk_heap_settle(heap, spare, compare);
+}
+
+struct rwk_heap_node * rwk_heap_peek(const struct rwk_heap *heap,
+                                     rwk_heap_compare_fn   *compare)
+{
+	karn_assert(!rwk_heap_empty(heap));
+	karn_assert(compare);
+
+	struct rwk_heap_node *min = NULL;
+	struct rwk_heap_node *node;
+	uint32_t              bmap;
+
+	for (bmap = heap->rwk_roots_bmap; bmap; bmap &= bmap - 1) {
+		node = heap->rwk_roots[__builtin_ctz(bmap)];
+		do {
+			if (!min || (compare(node, min) < 0))
+				min = node;
+			node = rwk_heap_next(node);
+		} while (node);
+	}
+
+	for (bmap = heap->rwk_singles_bmap; bmap; bmap &= bmap - 1) {
+		const struct dlist_node *list;
+
+		list = &heap->rwk_singles[__builtin_ctz(bmap)];
+		dlist_foreach_entry(list, node, rwk_mark)
+			if (compare(node, min) < 0)
+				min = node;
+	}
+
+	dlist_foreach_entry(&heap->rwk_runs, node, rwk_mark) {
+		struct rwk_heap_node *memb = node;
+
+		do {
+			if (compare(memb, min) < 0)
+				min = memb;
+			memb = rwk_heap_next(memb);
+		} while (rwk_heap_marked(memb));
+	}
+
+	return min;
+}
+
+void rwk_heap_insert(struct rwk_heap      *heap,
+                     struct rwk_heap_node *node,
+                     rwk_heap_compare_fn  *compare)
+{
+	rwk_heap_assert(heap);
+	karn_assert(node);
+	karn_assert(compare);
+
+	rwk_heap_set_youngest(node, NULL);
+	node->rwk_rank = 0;
+	node->rwk_state = RWK_HEAP_CLEAN;
+
+	/*
+	 * Fixing carry first ensures rank 0 holds at most one tree and keeps
+	 * a rank with no tree between any 2 ranks holding 2 trees.
+	 */
+	rwk_heap_fix_carry(heap, compare);
+	rwk_heap_add_root(heap, node);
+
+	heap->rwk_count++;
+}
+
+struct rwk_heap_node * rwk_heap_extract(struct rwk_heap     *heap,
+                                        rwk_heap_compare_fn *compare)
+{
+	karn_assert(!rwk_heap_empty(heap));
+	karn_assert(compare);
+
+	struct rwk_heap_node *min = rwk_heap_peek(heap, compare);
+
+	rwk_heap_remove(heap, min, compare);
+
+	return min;
+}
+
+void rwk_heap_remove(struct rwk_heap      *heap,
+                     struct rwk_heap_node *node,
+                     rwk_heap_compare_fn  *compare)
+{
+	karn_assert(!rwk_heap_empty(heap));
+	karn_assert(node);
+	karn_assert(compare);
+
+	rwk_heap_remove_node(heap, node, compare);
+
+	heap->rwk_count--;
+	rwk_heap_reduce(heap, compare);
+}
+
+void rwk_heap_promote(struct rwk_heap      *heap,
+                      struct rwk_heap_node *key,
+                      rwk_heap_compare_fn  *compare)
+{
+	karn_assert(!rwk_heap_empty(heap));
+	karn_assert(key);
+	karn_assert(compare);
+
+	/* Roots and marked nodes may be smaller than their parent. */
+	if (!key->rwk_parent || rwk_heap_marked(key))
+		return;
+
+	rwk_heap_settle(heap, key, compare);
+	rwk_heap_reduce(heap, compare);
+}
+
+void rwk_heap_init(struct rwk_heap *heap)
+{
+	karn_assert(heap);
+
+	unsigned int r;
+
+	heap->rwk_count = 0;
+	heap->rwk_marks_nr = 0;
+	heap->rwk_roots_bmap = 0;
+	heap->rwk_carries_bmap = 0;
+	heap->rwk_singles_bmap = 0;
+	heap->rwk_pairs_bmap = 0;
+
+	dlist_init(&heap->rwk_runs);
+	for (r = 0; r < RWK_HEAP_RANK_NR; r++)
+		dlist_init(&heap->rwk_singles[r]);
+}
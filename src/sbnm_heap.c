@@ -26,6 +26,9 @@
 
 #include <karn/sbnm_heap.h>
 
+/* Ranks are bounded by the number of bits of sbnm_count. */
+#define SBNM_HEAP_RANK_NR (32U)
+
 static struct sbnm_heap_node *
 sbnm_heap_parent_node(const struct sbnm_heap_node *node)
 {
@@ -100,6 +103,10 @@ sbnm_heap_peek(const struct sbnm_heap *heap)
 	const struct sbnm_heap_node *key;
 	const struct sbnm_heap_node *curr;
 
+	/*
+	 * heap cannot be consolidated from here: lazily inserted singletons
+	 * are scanned along with other roots.
+	 */
 	key = sbnm_heap_node_from_lcrs(heap->sbnm_roots);
 	curr = key;
 
@@ -226,6 +233,89 @@ sbnm_heap_merge_roots(struct lcrs_node     *first,
 	return res;
 }
 
+/*
+ * Store tree into the rank indexed array, linking it with trees of equal ranks
+ * the same way a binary counter propagates carries.
+ *
+ * Return rank of the tree stored.
+ */
+static unsigned int
+sbnm_heap_carry_tree(struct sbnm_heap_node *trees[],
+                     struct sbnm_heap_node *tree,
+                     sbnm_heap_compare_fn  *compare)
+{
+	unsigned int rank = tree->sbnm_rank;
+
+	karn_assert(rank < SBNM_HEAP_RANK_NR);
+
+	while (trees[rank]) {
+		tree = sbnm_heap_join(trees[rank], tree, compare);
+		trees[rank++] = NULL;
+	}
+
+	trees[rank] = tree;
+
+	return rank;
+}
+
+/*
+ * Move all roots into the rank indexed array and return the greatest rank
+ * stored.
+ */
+static unsigned int
+sbnm_heap_spread_roots(struct sbnm_heap      *heap,
+                       struct sbnm_heap_node *trees[])
+{
+	struct lcrs_node *root = heap->sbnm_roots;
+	unsigned int      top = 0;
+
+	while (!lcrs_istail(root)) {
+		struct sbnm_heap_node *tree = sbnm_heap_node_from_lcrs(root);
+		unsigned int           rank;
+
+		root = lcrs_next(root);
+
+		rank = sbnm_heap_carry_tree(trees, tree, heap->sbnm_compare);
+		top = umax(top, rank);
+	}
+
+	return top;
+}
+
+/* Rebuild rank ordered root list starting from greatest rank. */
+static void
+sbnm_heap_gather_roots(struct sbnm_heap      *heap,
+                       struct sbnm_heap_node *trees[],
+                       unsigned int           top)
+{
+	struct lcrs_node *root = lcrs_mktail(NULL);
+	unsigned int      rank = top + 1;
+
+	while (rank--) {
+		if (!trees[rank])
+			continue;
+
+		lcrs_assign_next(&trees[rank]->sbnm_lcrs, root);
+		root = &trees[rank]->sbnm_lcrs;
+	}
+
+	heap->sbnm_roots = root;
+	heap->sbnm_lazy = 0;
+}
+
+void
+sbnm_heap_consolidate(struct sbnm_heap *heap)
+{
+	sbnm_heap_assert(heap);
+
+	struct sbnm_heap_node *trees[SBNM_HEAP_RANK_NR] = { NULL, };
+
+	if (!heap->sbnm_lazy)
+		return;
+
+	sbnm_heap_gather_roots(heap, trees,
+	                       sbnm_heap_spread_roots(heap, trees));
+}
 
 static void
 sbnm_heap_remove_root(struct sbnm_heap  *heap,
@@ -273,7 +363,9 @@ sbnm_heap_remove_key(struct sbnm_heap *heap, struct sbnm_heap_node *key)
 	karn_assert(heap->sbnm_count);
 
 	struct lcrs_node *root = &key->sbnm_lcrs;
-	
+
+	sbnm_heap_consolidate(heap);
+
 	while (true) {
 		struct sbnm_heap_node *parent;
 
@@ -306,16 +398,39 @@ sbnm_heap_insert(struct sbnm_heap *heap, struct sbnm_heap_node *key)
 	                                              heap->sbnm_compare);
 }
 
+void
+sbnm_heap_insert_lazy(struct sbnm_heap *heap, struct sbnm_heap_node *key)
+{
+	sbnm_heap_assert(heap);
+	karn_assert(key);
+
+	lcrs_init(&key->sbnm_lcrs);
+	key->sbnm_rank = 0;
+
+	/*
+	 * Defer linking of equal rank roots to next consolidation, i.e. until
+	 * next extraction, removal or merge.
+	 */
+	lcrs_assign_next(&key->sbnm_lcrs, heap->sbnm_roots);
+	heap->sbnm_roots = &key->sbnm_lcrs;
+
+	heap->sbnm_count++;
+	heap->sbnm_lazy++;
+}
+
 struct sbnm_heap_node *
 sbnm_heap_extract(struct sbnm_heap *heap)
 {
 	sbnm_heap_assert(heap);
 	karn_assert(heap->sbnm_count);
 
-	struct lcrs_node      **prev = &heap->sbnm_roots;
+	struct lcrs_node      **prev;
 	struct sbnm_heap_node  *key;
 	struct sbnm_heap_node  *curr;
 
+	sbnm_heap_consolidate(heap);
+
+	prev = &heap->sbnm_roots;
 	key = sbnm_heap_node_from_lcrs(*prev);
 	curr = key;
 
@@ -339,6 +454,88 @@ sbnm_heap_extract(struct sbnm_heap *heap)
 	return key;
 }
 
+void
+sbnm_heap_insert_batch(struct sbnm_heap      *heap,
+                       struct sbnm_heap_node *keys[],
+                       unsigned int           nr)
+{
+	sbnm_heap_assert(heap);
+	karn_assert(keys || !nr);
+
+	unsigned int n;
+
+	/*
+	 * Prepend keys as singleton roots then link the whole root list at
+	 * once.
+	 */
+	for (n = 0; n < nr; n++)
+		sbnm_heap_insert_lazy(heap, keys[n]);
+
+	sbnm_heap_consolidate(heap);
+}
+
+unsigned int
+sbnm_heap_extract_batch(struct sbnm_heap      *heap,
+                        struct sbnm_heap_node *keys[],
+                        unsigned int           nr)
+{
+	sbnm_heap_assert(heap);
+	karn_assert(keys || !nr);
+
+	struct sbnm_heap_node *trees[SBNM_HEAP_RANK_NR] = { NULL, };
+	sbnm_heap_compare_fn  *cmp = heap->sbnm_compare;
+	unsigned int           top;
+	unsigned int           n;
+
+	if (nr > heap->sbnm_count)
+		nr = heap->sbnm_count;
+	if (!nr)
+		return 0;
+
+	/*
+	 * Keep trees into the rank indexed array for the whole batch: children
+	 * of extracted roots are carried into it directly and the root list is
+	 * rebuilt once at the end only.
+	 */
+	top = sbnm_heap_spread_roots(heap, trees);
+
+	for (n = 0; n < nr; n++) {
+		struct sbnm_heap_node *key = NULL;
+		struct lcrs_node      *child;
+		unsigned int           rank;
+
+		for (rank = 0; rank <= top; rank++) {
+			if (!trees[rank])
+				continue;
+
+			if (!key || (cmp(trees[rank], key) < 0))
+				key = trees[rank];
+		}
+
+		trees[key->sbnm_rank] = NULL;
+
+		child = lcrs_youngest(&key->sbnm_lcrs);
+		while (!lcrs_istail(child)) {
+			struct lcrs_node      *nxt = lcrs_next(child);
+			struct sbnm_heap_node *tree;
+
+			tree = sbnm_heap_node_from_lcrs(child);
+			rank = sbnm_heap_carry_tree(trees, tree, cmp);
+			top = umax(top, rank);
+
+			child = nxt;
+		}
+
+		keys[n] = key;
+	}
+
+	heap->sbnm_count -= nr;
+
+	sbnm_heap_gather_roots(heap, trees, top);
+
+	return nr;
+}
+
 void
 sbnm_heap_remove(struct sbnm_heap *heap, struct sbnm_heap_node *key)
 {
@@ -384,6 +581,9 @@ sbnm_heap_merge(struct sbnm_heap *result, struct sbnm_heap *source)
 	karn_assert(source->sbnm_count);
 	karn_assert(result->sbnm_compare == source->sbnm_compare);
 
+	sbnm_heap_consolidate(result);
+	sbnm_heap_consolidate(source);
+
 	result->sbnm_count += source->sbnm_count;
 
 	result->sbnm_roots = sbnm_heap_merge_roots(result->sbnm_roots,
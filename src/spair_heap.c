@@ -94,16 +94,149 @@ spair_heap_merge_roots(struct lcrs_node *roots, lcrs_compare_fn *compare)
 	return curr;
 }
 
+/*
+ * Link a list of trees into a single one by repeatedly pairing adjacent trees
+ * left to right, halving their number at each round. Unlike two-pass pairing,
+ * resulting root ends up with a logarithmic number of children.
+ */
 static struct lcrs_node *
-spair_heap_remove_key(struct lcrs_node *root,
-                      struct lcrs_node *key,
-                      bool              isroot,
-                      lcrs_compare_fn  *compare)
+spair_heap_multipass_roots(struct lcrs_node *roots, lcrs_compare_fn *compare)
 {
-	karn_assert(root);
+	karn_assert(roots);
+	karn_assert(!lcrs_istail(roots));
+	karn_assert(compare);
+
+	while (!lcrs_istail(roots->lcrs_sibling)) {
+		struct lcrs_node  *curr = roots;
+		struct lcrs_node **tail = &roots;
+
+		do {
+			struct lcrs_node *nxt = curr->lcrs_sibling;
+			struct lcrs_node *tmp;
+
+			if (lcrs_istail(nxt)) {
+				*tail = curr;
+				tail = &curr->lcrs_sibling;
+				break;
+			}
+
+			tmp = nxt->lcrs_sibling;
+
+			curr = spair_heap_join(curr, nxt, compare);
+			*tail = curr;
+			tail = &curr->lcrs_sibling;
+
+			curr = tmp;
+		} while (!lcrs_istail(curr));
+
+		*tail = lcrs_mktail(NULL);
+	}
+
+	return roots;
+}
+
+/*
+ * Link a list of trees into a single one by pairing adjacent trees left to
+ * right and linking each resulting pair to the tree accumulated so far, i.e.
+ * front to back instead of back to front as two-pass pairing does.
+ */
+static struct lcrs_node *
+spair_heap_front2back_roots(struct lcrs_node *roots, lcrs_compare_fn *compare)
+{
+	karn_assert(roots);
+	karn_assert(!lcrs_istail(roots));
+	karn_assert(compare);
+
+	struct lcrs_node *curr = roots;
+	struct lcrs_node *res = NULL;
+
+	do {
+		struct lcrs_node *nxt = curr->lcrs_sibling;
+
+		if (!lcrs_istail(nxt)) {
+			struct lcrs_node *tmp = nxt->lcrs_sibling;
+
+			curr = spair_heap_join(curr, nxt, compare);
+			nxt = tmp;
+		}
+
+		curr->lcrs_sibling = lcrs_mktail(NULL);
+		res = res ? spair_heap_join(res, curr, compare) : curr;
+
+		curr = nxt;
+	} while (!lcrs_istail(curr));
+
+	return res;
+}
+
+static struct lcrs_node *
+spair_heap_pair_roots(const struct spair_heap *heap,
+                      struct lcrs_node        *roots,
+                      lcrs_compare_fn         *compare)
+{
+	switch (heap->spair_mode & SPAIR_HEAP_PAIRING_MASK) {
+	case SPAIR_HEAP_MULTIPASS_MODE:
+		return spair_heap_multipass_roots(roots, compare);
+
+	case SPAIR_HEAP_FRONT2BACK_MODE:
+		return spair_heap_front2back_roots(roots, compare);
+
+	default:
+		return spair_heap_merge_roots(roots, compare);
+	}
+}
+
+/*
+ * Prepend a tree to the auxiliary list, keeping track of the smallest node.
+ */
+static void
+spair_heap_buffer(struct spair_heap *heap,
+                  struct lcrs_node  *tree,
+                  lcrs_compare_fn   *compare)
+{
+	karn_assert(heap->spair_root);
+
+	if (compare(tree, spair_heap_peek(heap)) < 0)
+		heap->spair_min = tree;
+
+	lcrs_assign_next(tree, heap->spair_aux);
+	heap->spair_aux = tree;
+}
+
+/*
+ * Link trees buffered into the auxiliary list using multipass pairing then
+ * link the result to the main tree.
+ */
+static void
+spair_heap_settle(struct spair_heap *heap, lcrs_compare_fn *compare)
+{
+	struct lcrs_node *aux = heap->spair_aux;
+
+	if (lcrs_istail(aux))
+		return;
+
+	aux = spair_heap_multipass_roots(aux, compare);
+	heap->spair_root = spair_heap_join(heap->spair_root, aux, compare);
+
+	heap->spair_aux = lcrs_mktail(NULL);
+	heap->spair_min = NULL;
+}
+
+static struct lcrs_node *
+spair_heap_remove_key(const struct spair_heap *heap,
+                      struct lcrs_node        *key,
+                      bool                     isroot,
+                      lcrs_compare_fn         *compare)
+{
+	karn_assert(heap);
 	karn_assert(key);
 	karn_assert(compare);
 
+	struct lcrs_node *root = heap->spair_root;
+
+	karn_assert(root);
+	karn_assert(lcrs_istail(heap->spair_aux));
+
 	if (!lcrs_has_child(key)) {
 		if (!isroot) {
 			lcrs_split(key, lcrs_youngest_ref(lcrs_parent(key)));
@@ -117,12 +250,12 @@ spair_heap_remove_key(struct lcrs_node *root,
 	if (!isroot) {
 		lcrs_split(key, lcrs_youngest_ref(lcrs_parent(key)));
 
-		key = spair_heap_merge_roots(lcrs_youngest(key), compare);
+		key = spair_heap_pair_roots(heap, lcrs_youngest(key), compare);
 
 		return spair_heap_join(root, key, compare);
 	}
 
-	return spair_heap_merge_roots(lcrs_youngest(key), compare);
+	return spair_heap_pair_roots(heap, lcrs_youngest(key), compare);
 }
 
 static void
@@ -133,12 +266,44 @@ spair_heap_update_key(struct spair_heap *heap,
 {
 	struct lcrs_node *node;
 
-	node = spair_heap_remove_key(heap->spair_root, key, isroot, compare);
+	node = spair_heap_remove_key(heap, key, isroot, compare);
 
 	lcrs_init(key);
 	heap->spair_root = spair_heap_join(node, key, compare);
 }
 
+/*
+ * Cut promoted key subtree off its parent and buffer it into the auxiliary
+ * list.
+ */
+static void
+spair_heap_promote_aux(struct spair_heap *heap,
+                       struct lcrs_node  *key,
+                       bool               isroot,
+                       lcrs_compare_fn   *compare)
+{
+	struct lcrs_node *min = spair_heap_peek(heap);
+	struct lcrs_node *parent;
+
+	if (key == min)
+		return;
+
+	parent = isroot ? NULL : lcrs_parent(key);
+	if (parent) {
+		if (compare(parent, key) <= 0)
+			return;
+
+		lcrs_split(key, lcrs_youngest_ref(parent));
+		spair_heap_buffer(heap, key, compare);
+
+		return;
+	}
+
+	/* Key is the root of main tree or of a buffered one. */
+	if (compare(key, min) < 0)
+		heap->spair_min = isroot ? NULL : key;
+}
+
 void spair_heap_merge(struct spair_heap *result,
                       struct spair_heap *source,
                       lcrs_compare_fn   *compare)
@@ -149,6 +314,9 @@ void spair_heap_merge(struct spair_heap *result,
 	karn_assert(source->spair_count);
 	karn_assert(compare);
 
+	spair_heap_settle(result, compare);
+	spair_heap_settle(source, compare);
+
 	result->spair_count += source->spair_count;
 
 	result->spair_root = spair_heap_join(result->spair_root,
@@ -173,9 +341,59 @@ void spair_heap_insert(struct spair_heap *heap,
 		return;
 	}
 
+	if (heap->spair_mode & SPAIR_HEAP_AUX_MODE) {
+		spair_heap_buffer(heap, key, compare);
+
+		return;
+	}
+
 	heap->spair_root = spair_heap_join(heap->spair_root, key, compare);
 }
 
+void spair_heap_insert_batch(struct spair_heap *heap,
+                             struct lcrs_node  *nodes[],
+                             unsigned int       nr,
+                             lcrs_compare_fn   *compare)
+{
+	spair_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(compare);
+
+	struct lcrs_node *roots = lcrs_mktail(NULL);
+	unsigned int      n = nr;
+
+	if (!nr)
+		return;
+
+	/*
+	 * Link batch nodes together first so that the root is compared once
+	 * only and does not end up with one child per inserted node.
+	 */
+	while (n--) {
+		lcrs_init(nodes[n]);
+		nodes[n]->lcrs_sibling = roots;
+		roots = nodes[n];
+	}
+
+	roots = spair_heap_multipass_roots(roots, compare);
+
+	heap->spair_count += nr;
+
+	if (!heap->spair_root) {
+		heap->spair_root = roots;
+
+		return;
+	}
+
+	if (heap->spair_mode & SPAIR_HEAP_AUX_MODE) {
+		spair_heap_buffer(heap, roots, compare);
+
+		return;
+	}
+
+	heap->spair_root = spair_heap_join(heap->spair_root, roots, compare);
+}
+
 struct lcrs_node * spair_heap_extract(struct spair_heap *heap,
                                       lcrs_compare_fn   *compare)
 {
@@ -183,7 +401,11 @@ struct lcrs_node * spair_heap_extract(struct spair_heap *heap,
 	karn_assert(heap->spair_count);
 	karn_assert(compare);
 
-	struct lcrs_node *root = heap->spair_root;
+	struct lcrs_node *root;
+
+	spair_heap_settle(heap, compare);
+
+	root = heap->spair_root;
 
 	heap->spair_count--;
 
@@ -193,11 +415,54 @@ struct lcrs_node * spair_heap_extract(struct spair_heap *heap,
 		return root;
 	}
 
-	heap->spair_root = spair_heap_merge_roots(lcrs_youngest(root), compare);
+	heap->spair_root = spair_heap_pair_roots(heap, lcrs_youngest(root),
+	                                         compare);
 
 	return root;
 }
 
+unsigned int spair_heap_extract_batch(struct spair_heap *heap,
+                                      struct lcrs_node  *nodes[],
+                                      unsigned int       nr,
+                                      lcrs_compare_fn   *compare)
+{
+	spair_heap_assert(heap);
+	karn_assert(nodes || !nr);
+	karn_assert(compare);
+
+	struct lcrs_node *root;
+	unsigned int      n;
+
+	if (nr > heap->spair_count)
+		nr = heap->spair_count;
+	if (!nr)
+		return 0;
+
+	/*
+	 * Link trees buffered into the auxiliary list once for the whole batch,
+	 * then pair children of each extracted root in turn.
+	 */
+	spair_heap_settle(heap, compare);
+
+	root = heap->spair_root;
+	for (n = 0; n < nr; n++) {
+		nodes[n] = root;
+
+		if (!lcrs_has_child(root)) {
+			root = NULL;
+			continue;
+		}
+
+		root = spair_heap_pair_roots(heap, lcrs_youngest(root),
+		                             compare);
+	}
+
+	heap->spair_root = root;
+	heap->spair_count -= nr;
+
+	return nr;
+}
+
 void spair_heap_remove(struct spair_heap *heap,
                        struct lcrs_node  *key,
                        lcrs_compare_fn   *compare)
@@ -207,9 +472,11 @@ void spair_heap_remove(struct spair_heap *heap,
 	karn_assert(key);
 	karn_assert(compare);
 
+	spair_heap_settle(heap, compare);
+
 	heap->spair_count--;
 
-	heap->spair_root = spair_heap_remove_key(heap->spair_root, key,
+	heap->spair_root = spair_heap_remove_key(heap, key,
 	                                         key == heap->spair_root,
 	                                         compare);
 }
@@ -225,6 +492,12 @@ void spair_heap_promote(struct spair_heap *heap,
 
 	bool isroot = (key == heap->spair_root);
 
+	if (heap->spair_mode & SPAIR_HEAP_AUX_MODE) {
+		spair_heap_promote_aux(heap, key, isroot, compare);
+
+		return;
+	}
+
 	if (isroot)
 		return;
 
@@ -246,11 +519,26 @@ void spair_heap_demote(struct spair_heap *heap,
 	if (heap->spair_count == 1)
 		return;
 
+	spair_heap_settle(heap, compare);
+
 	spair_heap_update_key(heap, key, key == heap->spair_root, compare);
 }
 
-void spair_heap_init(struct spair_heap *heap)
+void spair_heap_init_mode(struct spair_heap *heap, unsigned int mode)
 {
+	karn_assert(heap);
+	karn_assert((mode & SPAIR_HEAP_PAIRING_MASK) <=
+	            SPAIR_HEAP_FRONT2BACK_MODE);
+	karn_assert(!(mode & ~(SPAIR_HEAP_PAIRING_MASK | SPAIR_HEAP_AUX_MODE)));
+
 	heap->spair_root = NULL;
 	heap->spair_count = 0;
+	heap->spair_mode = mode;
+	heap->spair_aux = lcrs_mktail(NULL);
+	heap->spair_min = NULL;
+}
+
+void spair_heap_init(struct spair_heap *heap)
+{
+	spair_heap_init_mode(heap, SPAIR_HEAP_TWOPASS_MODE);
 }
@@ -0,0 +1,509 @@
+/**
+ * @file      xsort.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * External sorting implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/xsort.h>
+#include <karn/ltree.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Sorted sequence of records stored into a temporary file. */
+struct xsort_run {
+	off_t    xrun_off;
+	uint64_t xrun_nr;
+};
+
+/* Merge input: a run being read block by block. */
+struct xsort_cursor {
+	char     *xcur_buff;
+	off_t     xcur_off;
+	uint64_t  xcur_left;
+};
+
+/*
+ * k-way merge state. Runs are merged using a loser tree, refilling cursors'
+ * blocks as they get exhausted and buffering output into a block of its own.
+ */
+struct xsort_merge {
+	struct ltree         xmrg_tree;
+	struct ltree_run    *xmrg_runs;
+	struct xsort_cursor *xmrg_curs;
+	int                  xmrg_in_fd;
+	int                  xmrg_out_fd;
+	char                *xmrg_out;
+	size_t               xmrg_len;
+	size_t               xmrg_blk_size;
+	size_t               xmrg_rec_size;
+	farr_compare_fn     *xmrg_compare;
+	farr_copy_fn        *xmrg_copy;
+};
+
+static uint64_t xsort_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*
+ * Read up to size bytes, retrying on short reads so that buff is filled
+ * unless end of file is reached. Return number of bytes read.
+ */
+static ssize_t xsort_read(int fd, char *buff, size_t size)
+{
+	size_t done = 0;
+
+	while (done < size) {
+		ssize_t ret;
+
+		ret = read(fd, &buff[done], size - done);
+		if (ret > 0) {
+			done += (size_t)ret;
+			continue;
+		}
+
+		if (!ret)
+			break;
+
+		if (errno != EINTR)
+			return -errno;
+	}
+
+	return (ssize_t)done;
+}
+
+static int xsort_pread(int fd, char *buff, size_t size, off_t off)
+{
+	while (size) {
+		ssize_t ret;
+
+		ret = pread(fd, buff, size, off);
+		if (ret > 0) {
+			buff += ret;
+			size -= (size_t)ret;
+			off += ret;
+			continue;
+		}
+
+		if (!ret)
+			return -EIO;
+
+		if (errno != EINTR)
+			return -errno;
+	}
+
+	return 0;
+}
+
+static int xsort_write(int fd, const char *buff, size_t size)
+{
+	while (size) {
+		ssize_t ret;
+
+		ret = write(fd, buff, size);
+		if (ret >= 0) {
+			buff += ret;
+			size -= (size_t)ret;
+			continue;
+		}
+
+		if (errno != EINTR)
+			return -errno;
+	}
+
+	return 0;
+}
+
+/* Create an unlinked temporary file. */
+static int xsort_open_tmp(const char *tmp_dir)
+{
+	char path[PATH_MAX];
+	int  fd;
+
+	if (!tmp_dir)
+		tmp_dir = P_tmpdir;
+
+	if (snprintf(path, sizeof(path), "%s/karn_xsort.XXXXXX", tmp_dir) >=
+	    (int)sizeof(path))
+		return -ENAMETOOLONG;
+
+	fd = mkstemp(path);
+	if (fd < 0)
+		return -errno;
+
+	unlink(path);
+
+	return fd;
+}
+
+/* Load next block of records of cursor's run. */
+static int xsort_fetch(struct ltree_run *run, unsigned int index, void *data)
+{
+	const struct xsort_merge *merge = data;
+	struct xsort_cursor      *cursor = &merge->xmrg_curs[index];
+	uint64_t                  nr = merge->xmrg_blk_size /
+	                               merge->xmrg_rec_size;
+	size_t                    size;
+	int                       err;
+
+	if (!cursor->xcur_left)
+		/* Leave run empty to mark it as exhausted. */
+		return 0;
+
+	if (nr > cursor->xcur_left)
+		nr = cursor->xcur_left;
+	size = (size_t)nr * merge->xmrg_rec_size;
+
+	err = xsort_pread(merge->xmrg_in_fd, cursor->xcur_buff, size,
+	                  cursor->xcur_off);
+	if (err)
+		return err;
+
+	run->ltree_next = cursor->xcur_buff;
+	run->ltree_end = &cursor->xcur_buff[size];
+	cursor->xcur_off += (off_t)size;
+	cursor->xcur_left -= nr;
+
+	return 0;
+}
+
+/* Buffer merged record, flushing output block once full. */
+static int xsort_output(const char *record, void *data)
+{
+	struct xsort_merge *merge = data;
+
+	merge->xmrg_copy(&merge->xmrg_out[merge->xmrg_len], record);
+
+	merge->xmrg_len += merge->xmrg_rec_size;
+	if (merge->xmrg_len == merge->xmrg_blk_size) {
+		merge->xmrg_len = 0;
+
+		return xsort_write(merge->xmrg_out_fd, merge->xmrg_out,
+		                   merge->xmrg_blk_size);
+	}
+
+	return 0;
+}
+
+/*
+ * Merge the given runs stored into in_fd and write result sequentially to
+ * out_fd. Cursors' blocks are laid out consecutively into buff, followed by
+ * output block.
+ */
+static int xsort_merge_runs(struct xsort_merge     *merge,
+                            const struct xsort_run *runs,
+                            unsigned int            run_nr,
+                            int                     in_fd,
+                            int                     out_fd,
+                            char                   *buff)
+{
+	size_t       blk_size = merge->xmrg_blk_size;
+	unsigned int r;
+	int          err;
+
+	karn_assert(run_nr);
+
+	merge->xmrg_in_fd = in_fd;
+	merge->xmrg_out_fd = out_fd;
+	merge->xmrg_out = &buff[run_nr * blk_size];
+	merge->xmrg_len = 0;
+
+	for (r = 0; r < run_nr; r++) {
+		struct xsort_cursor *cur = &merge->xmrg_curs[r];
+
+		cur->xcur_buff = &buff[r * blk_size];
+		cur->xcur_off = runs[r].xrun_off;
+		cur->xcur_left = runs[r].xrun_nr;
+
+		/* Empty runs are loaded by ltree_merge_runs() refilling. */
+		merge->xmrg_runs[r].ltree_next = cur->xcur_buff;
+		merge->xmrg_runs[r].ltree_end = cur->xcur_buff;
+	}
+
+	err = ltree_merge_runs(&merge->xmrg_tree, merge->xmrg_runs, run_nr,
+	                       merge->xmrg_rec_size, merge->xmrg_compare,
+	                       xsort_fetch, xsort_output, merge);
+	if (err)
+		return err;
+
+	if (merge->xmrg_len)
+		return xsort_write(out_fd, merge->xmrg_out, merge->xmrg_len);
+
+	return 0;
+}
+
+/*
+ * Merge runs pass after pass, ping-ponging between temporary files, until
+ * there are few enough of them to be merged into out_fd in a single pass.
+ * run_fd is updated with the temporary file holding last pass input, which
+ * caller remains responsible for closing.
+ */
+static int xsort_merge_all(struct xsort_run   *runs,
+                           unsigned int        run_nr,
+                           int                *run_fd,
+                           int                 out_fd,
+                           char               *buff,
+                           size_t              mem_size,
+                           size_t              rec_size,
+                           farr_compare_fn    *compare,
+                           farr_copy_fn       *copy,
+                           const char         *tmp_dir,
+                           struct xsort_stats *stats)
+{
+	struct xsort_merge merge;
+	size_t             blk_nr;
+	unsigned int       fanin;
+	int                in_fd = *run_fd;
+	int                tmp_fd = -1;
+	int                err = 0;
+
+	/* Keep room for output block. */
+	blk_nr = mem_size / XSORT_BLOCK_MIN;
+	if (blk_nr < 3)
+		fanin = 2;
+	else if (blk_nr > run_nr)
+		fanin = run_nr;
+	else
+		fanin = (unsigned int)(blk_nr - 1);
+	fanin = umin(fanin, run_nr);
+
+	merge.xmrg_curs = malloc(fanin * (sizeof(merge.xmrg_curs[0]) +
+	                                  sizeof(merge.xmrg_runs[0])));
+	if (!merge.xmrg_curs)
+		return -ENOMEM;
+	merge.xmrg_runs = (struct ltree_run *)&merge.xmrg_curs[fanin];
+
+	err = ltree_init(&merge.xmrg_tree, fanin);
+	if (err)
+		goto free;
+
+	merge.xmrg_rec_size = rec_size;
+	merge.xmrg_blk_size = ((mem_size / (fanin + 1)) / rec_size) * rec_size;
+	merge.xmrg_compare = compare;
+	merge.xmrg_copy = copy;
+
+	while (run_nr > fanin) {
+		unsigned int r;
+		unsigned int nr = 0;
+		off_t        off = 0;
+
+		if (tmp_fd < 0) {
+			tmp_fd = xsort_open_tmp(tmp_dir);
+			if (tmp_fd < 0) {
+				err = tmp_fd;
+				goto fini;
+			}
+		}
+		else if (lseek(tmp_fd, 0, SEEK_SET) < 0) {
+			err = -errno;
+			goto close;
+		}
+
+		for (r = 0; r < run_nr; r += fanin) {
+			unsigned int cnt = umin(fanin, run_nr - r);
+			uint64_t     rec_nr = 0;
+			unsigned int c;
+
+			for (c = 0; c < cnt; c++)
+				rec_nr += runs[r + c].xrun_nr;
+
+			err = xsort_merge_runs(&merge, &runs[r], cnt, in_fd,
+			                       tmp_fd, buff);
+			if (err)
+				goto close;
+
+			/* Merged run may safely replace one of its inputs. */
+			runs[nr].xrun_off = off;
+			runs[nr].xrun_nr = rec_nr;
+			nr++;
+
+			off += (off_t)(rec_nr * rec_size);
+		}
+
+		run_nr = nr;
+		if (stats)
+			stats->xsort_pass_nr++;
+
+		/* Previous pass output becomes next pass input. */
+		*run_fd = tmp_fd;
+		tmp_fd = in_fd;
+		in_fd = *run_fd;
+	}
+
+	err = xsort_merge_runs(&merge, runs, run_nr, in_fd, out_fd, buff);
+	if (!err && stats)
+		stats->xsort_pass_nr++;
+
+close:
+	if (tmp_fd >= 0)
+		close(tmp_fd);
+fini:
+	ltree_fini(&merge.xmrg_tree);
+free:
+	free(merge.xmrg_curs);
+
+	return err;
+}
+
+int xsort_file(int                 in_fd,
+               int                 out_fd,
+               size_t              rec_size,
+               size_t              mem_size,
+               farr_compare_fn    *compare,
+               farr_copy_fn       *copy,
+               const char         *tmp_dir,
+               struct xsort_stats *stats)
+{
+	karn_assert(in_fd >= 0);
+	karn_assert(out_fd >= 0);
+	karn_assert(rec_size);
+	karn_assert(compare);
+	karn_assert(copy);
+
+	size_t            run_size;
+	char             *buff;
+	struct xsort_run *runs = NULL;
+	unsigned int      run_nr = 0;
+	unsigned int      run_max = 0;
+	int               run_fd = -1;
+	off_t             off = 0;
+	uint64_t          start;
+	int               err = 0;
+
+	if (mem_size < (3 * rec_size))
+		return -EINVAL;
+
+	if (stats)
+		memset(stats, 0, sizeof(*stats));
+
+	run_size = (mem_size / rec_size) * rec_size;
+
+	buff = malloc(mem_size);
+	if (!buff)
+		return -ENOMEM;
+
+	posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+	while (true) {
+		ssize_t ret;
+		size_t  nr;
+
+		start = xsort_now();
+		ret = xsort_read(in_fd, buff, run_size);
+		if (stats)
+			stats->xsort_read_nsec += xsort_now() - start;
+
+		if (ret < 0) {
+			err = (int)ret;
+			goto close;
+		}
+		if ((size_t)ret % rec_size) {
+			err = -EINVAL;
+			goto close;
+		}
+		if (!ret)
+			break;
+
+		nr = (size_t)ret / rec_size;
+
+		start = xsort_now();
+		farr_intro_sort(buff, rec_size, nr, compare, copy);
+		if (stats) {
+			stats->xsort_sort_nsec += xsort_now() - start;
+			stats->xsort_rec_nr += nr;
+			stats->xsort_run_nr++;
+		}
+
+		if (!run_nr && ((size_t)ret < run_size)) {
+			/*
+			 * Whole input fits into memory: skip spilling and
+			 * account output writing as the merge phase does.
+			 */
+			start = xsort_now();
+			err = xsort_write(out_fd, buff, (size_t)ret);
+			if (stats)
+				stats->xsort_merge_nsec += xsort_now() - start;
+			goto free;
+		}
+
+		if (run_fd < 0) {
+			run_fd = xsort_open_tmp(tmp_dir);
+			if (run_fd < 0) {
+				err = run_fd;
+				goto free;
+			}
+		}
+
+		if (run_nr == run_max) {
+			struct xsort_run *tmp;
+
+			run_max = run_max ? (2 * run_max) : 16;
+			tmp = realloc(runs, run_max * sizeof(runs[0]));
+			if (!tmp) {
+				err = -ENOMEM;
+				goto close;
+			}
+			runs = tmp;
+		}
+
+		start = xsort_now();
+		err = xsort_write(run_fd, buff, (size_t)ret);
+		if (stats)
+			stats->xsort_spill_nsec += xsort_now() - start;
+		if (err)
+			goto close;
+
+		runs[run_nr].xrun_off = off;
+		runs[run_nr].xrun_nr = nr;
+		run_nr++;
+
+		off += (off_t)ret;
+	}
+
+	if (run_nr) {
+		start = xsort_now();
+		err = xsort_merge_all(runs, run_nr, &run_fd, out_fd, buff,
+		                      mem_size, rec_size, compare, copy,
+		                      tmp_dir, stats);
+		if (stats)
+			stats->xsort_merge_nsec += xsort_now() - start;
+	}
+
+close:
+	if (run_fd >= 0)
+		close(run_fd);
+free:
+	free(runs);
+	free(buff);
+
+	return err;
+}
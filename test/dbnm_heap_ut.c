@@ -2082,3 +2082,192 @@ CUTE_PNP_TEST(dbnmhut_remove27, &dbnmhut_remove)
 	dbnmhut_check_remove(&dbnmhut_heap, 8, dbnmhut_remove_nodes, checks,
 	                     array_nr(dbnmhut_remove_nodes));
 }
+
+#define DBNMHUT_BATCH_NR (40U)
+
+static void dbnmhut_check_batch(struct dbnmhut_node *nodes,
+                                unsigned int        nr)
+{
+	struct dbnm_heap_node *keys[DBNMHUT_BATCH_NR];
+	struct dbnm_heap_node *out[DBNMHUT_BATCH_NR];
+	unsigned int           n;
+	int                    prev = -1;
+
+	for (n = 0; n < nr; n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % nr) / 2;
+		keys[n] = &nodes[n].heap;
+	}
+
+	dbnm_heap_insert_batch(&dbnmhut_heap, keys, 25, dbnmhut_compare_min);
+	cute_ensure(dbnm_heap_count(&dbnmhut_heap) == 25);
+	dbnm_heap_insert_batch(&dbnmhut_heap, &keys[25], nr - 25,
+	                       dbnmhut_compare_min);
+	cute_ensure(dbnm_heap_count(&dbnmhut_heap) == nr);
+
+	cute_ensure(dbnm_heap_extract_batch(&dbnmhut_heap, out, 10,
+	                                    dbnmhut_compare_min) == 10);
+	cute_ensure(dbnm_heap_extract_batch(&dbnmhut_heap, &out[10], nr,
+	                                    dbnmhut_compare_min) ==
+	            (nr - 10));
+	cute_ensure(dbnm_heap_empty(&dbnmhut_heap));
+
+	for (n = 0; n < nr; n++) {
+		int key = ((struct dbnmhut_node *)out[n])->key;
+
+		cute_ensure(key >= prev);
+		prev = key;
+	}
+}
+
+static CUTE_PNP_FIXTURED_SUITE(dbnmhut_batch, &dbnmhut, dbnmhut_setup_empty,
+                               NULL);
+
+CUTE_PNP_TEST(dbnmhut_batch_insert_extract, &dbnmhut_batch)
+{
+	struct dbnmhut_node nodes[DBNMHUT_BATCH_NR];
+
+	dbnmhut_check_batch(nodes, array_nr(nodes));
+}
+
+#define DBNMHUT_LAZY_NR (40U)
+
+static void dbnmhut_insert_lazy(struct dbnm_heap    *heap,
+                                struct dbnmhut_node *nodes,
+                                unsigned int         nr)
+{
+	unsigned int n;
+	unsigned int count = dbnm_heap_count(heap);
+
+	for (n = 0; n < nr; n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % nr) / 2;
+
+		dbnm_heap_insert_lazy(heap, &nodes[n].heap);
+		cute_ensure(dbnm_heap_count(heap) == (count + n + 1));
+	}
+}
+
+static void dbnmhut_check_lazy_extract(struct dbnm_heap *heap,
+                                       unsigned int      nr)
+{
+	unsigned int n;
+	int          prev = -1;
+
+	cute_ensure(dbnm_heap_count(heap) == nr);
+
+	for (n = 0; n < nr; n++) {
+		const struct dbnm_heap_node *node;
+		int                          key;
+
+		node = dbnm_heap_peek(heap, dbnmhut_compare_min);
+		key = ((struct dbnmhut_node *)node)->key;
+		cute_ensure(key >= prev);
+
+		/* Consolidation may reorder nodes with equal keys. */
+		node = dbnm_heap_extract(heap, dbnmhut_compare_min);
+		cute_ensure(((struct dbnmhut_node *)node)->key == key);
+		cute_ensure(dbnm_heap_count(heap) == (nr - n - 1));
+
+		prev = key;
+	}
+
+	cute_ensure(dlist_empty(&heap->dbnm_roots));
+}
+
+static CUTE_PNP_FIXTURED_SUITE(dbnmhut_lazy, &dbnmhut, dbnmhut_setup_empty,
+                               NULL);
+
+CUTE_PNP_TEST(dbnmhut_lazy_consolidate, &dbnmhut_lazy)
+{
+	struct dbnmhut_node nodes[DBNMHUT_LAZY_NR];
+	unsigned int        nr;
+
+	for (nr = 1; nr <= array_nr(nodes); nr++) {
+		dbnmhut_insert_lazy(&dbnmhut_heap, nodes, nr);
+
+		dbnm_heap_consolidate(&dbnmhut_heap, dbnmhut_compare_min);
+		dbnmhut_check_roots(&dbnmhut_heap, nr);
+
+		dbnmhut_check_lazy_extract(&dbnmhut_heap, nr);
+	}
+}
+
+CUTE_PNP_TEST(dbnmhut_lazy_extract, &dbnmhut_lazy)
+{
+	struct dbnmhut_node nodes[DBNMHUT_LAZY_NR];
+	unsigned int        nr;
+
+	for (nr = 1; nr <= array_nr(nodes); nr++) {
+		dbnmhut_insert_lazy(&dbnmhut_heap, nodes, nr);
+		dbnmhut_check_lazy_extract(&dbnmhut_heap, nr);
+	}
+}
+
+CUTE_PNP_TEST(dbnmhut_lazy_mixed, &dbnmhut_lazy)
+{
+	struct dbnmhut_node nodes[DBNMHUT_LAZY_NR];
+	bool                present[DBNMHUT_LAZY_NR] = { false, };
+	unsigned int        n;
+
+	for (n = 0; n < array_nr(nodes); n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % array_nr(nodes));
+
+		if (n % 3)
+			dbnm_heap_insert_lazy(&dbnmhut_heap, &nodes[n].heap);
+		else
+			dbnm_heap_insert(&dbnmhut_heap, &nodes[n].heap,
+			                 dbnmhut_compare_min);
+		present[n] = true;
+
+		if (!(n % 5)) {
+			dbnm_heap_remove(&dbnmhut_heap, &nodes[n].heap,
+			                 dbnmhut_compare_min);
+			present[n] = false;
+		}
+
+		if (!(n % 7) && !dbnm_heap_empty(&dbnmhut_heap)) {
+			struct dbnmhut_node *node;
+			unsigned int         m;
+
+			node = (struct dbnmhut_node *)
+			       dbnm_heap_extract(&dbnmhut_heap,
+			                         dbnmhut_compare_min);
+
+			for (m = 0; m <= n; m++)
+				if (present[m])
+					cute_ensure(nodes[m].key >= node->key);
+
+			present[node - nodes] = false;
+		}
+	}
+
+	for (n = 0; n < array_nr(nodes); n++) {
+		if (!present[n])
+			continue;
+
+		dbnm_heap_remove(&dbnmhut_heap, &nodes[n].heap,
+		                 dbnmhut_compare_min);
+		present[n] = false;
+		break;
+	}
+
+	dbnmhut_check_lazy_extract(&dbnmhut_heap,
+	                           dbnm_heap_count(&dbnmhut_heap));
+}
+
+CUTE_PNP_TEST(dbnmhut_lazy_merge, &dbnmhut_lazy)
+{
+	struct dbnmhut_node fst_nodes[DBNMHUT_LAZY_NR];
+	struct dbnmhut_node snd_nodes[DBNMHUT_LAZY_NR / 2];
+	struct dbnm_heap    snd;
+
+	dbnm_heap_init(&snd);
+	dbnmhut_insert_lazy(&dbnmhut_heap, fst_nodes, array_nr(fst_nodes));
+	dbnmhut_insert_lazy(&snd, snd_nodes, array_nr(snd_nodes));
+
+	dbnm_heap_merge(&dbnmhut_heap, &snd, dbnmhut_compare_min);
+
+	dbnmhut_check_roots(&dbnmhut_heap,
+	                    array_nr(fst_nodes) + array_nr(snd_nodes));
+	dbnmhut_check_lazy_extract(&dbnmhut_heap,
+	                           array_nr(fst_nodes) + array_nr(snd_nodes));
+}
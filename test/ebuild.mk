@@ -12,12 +12,23 @@ karn_ut-objs        = test/karn_ut.o test/utils_ut.o
 karn_ut-objs       += $(call kconf_enabled,KARN_SLIST,slist_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_DLIST,dlist_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_FBNR_HEAP,fbnr_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_FDARY_HEAP,fdary_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_FKEY_HEAP,fkey_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_FIDX_HEAP,fidx_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_FMMX_HEAP,fmmx_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_FSHD_HEAP,fshd_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_RADIX_HEAP,radix_heap_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_SBNM_HEAP,sbnm_heap_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_DBNM_HEAP,dbnm_heap_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_SPAIR_HEAP,spair_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_RPAIR_HEAP,rpair_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_RWK_HEAP,rwk_heap_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_FWK_HEAP,fwk_heap_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_LCRS,lcrs_ut.o)
 karn_ut-objs       += $(call kconf_enabled,KARN_PBNM_HEAP,pbnm_heap_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_LTREE,ltree_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_XSORT,xsort_ut.o)
+karn_ut-objs       += $(call kconf_enabled,KARN_FEYT_TREE,feyt_tree_ut.o)
 ifeq ($(strip $(or $(CONFIG_KARN_FARR_BUBBLE_SORT), \
                    $(CONFIG_KARN_FARR_SELECTION_SORT), \
                    $(CONFIG_KARN_FARR_INSERTION_SORT), \
@@ -52,11 +63,37 @@ slist_pt-ldflags   := $(KARN_PT_LDFLAGS) -lkarn_pt
 slist_pt-pkgconf   := $(KARN_PT_PKGCONF)
 slist_pt-objs      := slist_pt.o
 
+bins               += $(call kconf_enabled,KARN_XSORT,xsort_pt)
+xsort_pt-cflags    := $(KARN_PT_CFLAGS)
+xsort_pt-ldflags   := $(KARN_PT_LDFLAGS) -lkarn_pt
+xsort_pt-pkgconf   := $(KARN_PT_PKGCONF)
+xsort_pt-objs      := xsort_pt.o
+
+bins               += $(call kconf_enabled,KARN_LTREE,merge_pt)
+merge_pt-cflags    := $(KARN_PT_CFLAGS)
+merge_pt-ldflags   := $(KARN_PT_LDFLAGS) -lkarn_pt
+merge_pt-pkgconf   := $(KARN_PT_PKGCONF)
+merge_pt-objs      := merge_pt.o
+
+bins               += $(call kconf_enabled,KARN_FEYT_TREE,search_pt)
+search_pt-cflags   := $(KARN_PT_CFLAGS)
+search_pt-ldflags  := $(KARN_PT_LDFLAGS) -lkarn_pt
+search_pt-pkgconf  := $(KARN_PT_PKGCONF)
+search_pt-objs     := search_pt.o
+
 ifeq ($(or $(CONFIG_KARN_FBNR_HEAP), \
+           $(CONFIG_KARN_FDARY_HEAP), \
+           $(CONFIG_KARN_FKEY_HEAP), \
+           $(CONFIG_KARN_FIDX_HEAP), \
+           $(CONFIG_KARN_FMMX_HEAP), \
+           $(CONFIG_KARN_FSHD_HEAP), \
+           $(CONFIG_KARN_RADIX_HEAP), \
            $(CONFIG_KARN_FWK_HEAP), \
            $(CONFIG_KARN_SBNM_HEAP), \
            $(CONFIG_KARN_DBNM_HEAP), \
            $(CONFIG_KARN_SPAIR_HEAP), \
+           $(CONFIG_KARN_RPAIR_HEAP), \
+           $(CONFIG_KARN_RWK_HEAP), \
            $(CONFIG_KARN_PBNM_HEAP))),y)
 
 bins              += heap_pt
@@ -66,10 +103,18 @@ heap_pt-pkgconf   := $(KARN_PT_PKGCONF)
 heap_pt-objs      := heap_pt.o
 
 endif # ifeq ($(or $(CONFIG_KARN_FBNR_HEAP), \
+      #            $(CONFIG_KARN_FDARY_HEAP), \
+      #            $(CONFIG_KARN_FKEY_HEAP), \
+      #            $(CONFIG_KARN_FIDX_HEAP), \
+      #            $(CONFIG_KARN_FMMX_HEAP), \
+      #            $(CONFIG_KARN_FSHD_HEAP), \
+      #            $(CONFIG_KARN_RADIX_HEAP), \
       #            $(CONFIG_KARN_FWK_HEAP), \
       #            $(CONFIG_KARN_SBNM_HEAP), \
       #            $(CONFIG_KARN_DBNM_HEAP), \
       #            $(CONFIG_KARN_SPAIR_HEAP), \
+      #            $(CONFIG_KARN_RPAIR_HEAP), \
+      #            $(CONFIG_KARN_RWK_HEAP), \
       #            $(CONFIG_KARN_PBNM_HEAP))),y)
 
 endif # ($(CONFIG_KARN_PERF),y)
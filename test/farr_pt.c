@@ -7,14 +7,33 @@
 #include <errno.h>
 #include <string.h>
 
+/* Parameter a sorting algorithm measurement may be swept over. */
+enum fapt_param {
+	FAPT_NO_PARAM = 0,  /* algorithm has no sweepable parameter */
+	FAPT_THREAD_PARAM,  /* number of threads */
+	FAPT_SIZE_PARAM,    /* size of entries */
+	FAPT_CHUNK_PARAM    /* number of keys per sorted chunk */
+};
+
 struct fapt_iface {
-	char  *fapt_name;
-	int  (*fapt_validate)(void);
-	int  (*fapt_sort)(unsigned long long *nsecs);
+	char            *fapt_name;
+	int            (*fapt_validate)(void);
+	int            (*fapt_sort)(unsigned long long *nsecs);
+	enum fapt_param  fapt_param;
 };
 
+/* Bounds of entry size given to algorithms sorting large records. */
+#define FAPT_RECORD_SIZE_MIN (2 * sizeof(unsigned int))
+#define FAPT_RECORD_SIZE_MAX (4096U)
+
+#define FAPT_CHUNK_NR_MAX (64U)
+
 static struct pt_entries  fapt_entries;
 static unsigned int      *fapt_keys;
+static unsigned int       fapt_thread_nr = 1;
+static size_t             fapt_entry_size = 128;
+static unsigned int       fapt_select_nr;
+static unsigned int       fapt_chunk_nr = 16;
 
 /******************************************************************************
  * Glibc's quick sorting
@@ -394,6 +413,90 @@ static int fapt_fbnr_heap_sort(unsigned long long *nsecs)
 
 #endif /* defined(CONFIG_KARN_FBNR_HEAP_SORT) */
 
+/******************************************************************************
+ * Fixed array based d-ary heap sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FDARY_HEAP_SORT)
+
+#include "fdary_heap.h"
+
+static int fapt_fdary_heap_validate(unsigned int arity)
+{
+	int           n;
+	unsigned int *keys;
+	int           ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	fdary_heap_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                arity, pt_compare_min, pt_copy_key);
+
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_fdary_heap_sort(unsigned long long *nsecs, unsigned int arity)
+{
+	struct timespec  start, elapse;
+	unsigned int    *keys;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	fdary_heap_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                arity, pt_compare_min, pt_copy_key);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_fdary4_heap_validate(void)
+{
+	return fapt_fdary_heap_validate(4);
+}
+
+static int fapt_fdary4_heap_sort(unsigned long long *nsecs)
+{
+	return fapt_fdary_heap_sort(nsecs, 4);
+}
+
+static int fapt_fdary8_heap_validate(void)
+{
+	return fapt_fdary_heap_validate(8);
+}
+
+static int fapt_fdary8_heap_sort(unsigned long long *nsecs)
+{
+	return fapt_fdary_heap_sort(nsecs, 8);
+}
+
+#endif /* defined(CONFIG_KARN_FDARY_HEAP_SORT) */
+
 /******************************************************************************
  * Fixed array based weak heap sorting
  ******************************************************************************/
@@ -530,182 +633,1464 @@ static int fapt_intro_sort(unsigned long long *nsecs)
 #endif /* defined(CONFIG_KARN_FARR_INTRO_SORT) */
 
 /******************************************************************************
- * Main measurment task handling
+ * Fixed array based pattern defeating quick sorting
  ******************************************************************************/
 
-static const struct fapt_iface fapt_algos[] = {
-	{
-		.fapt_name     = "qsort",
-		.fapt_validate = fapt_qsort_validate,
-		.fapt_sort     = fapt_qsort_sort
-	},
-#if defined(CONFIG_KARN_FBNR_HEAP_SORT)
-	{
-		.fapt_name     = "fbnrh",
-		.fapt_validate = fapt_fbnr_heap_validate,
-		.fapt_sort     = fapt_fbnr_heap_sort
-	},
-#endif
-#if defined(CONFIG_KARN_FWK_HEAP_SORT)
-	{
-		.fapt_name     = "fwkh",
-		.fapt_validate = fapt_fwk_heap_validate,
-		.fapt_sort     = fapt_fwk_heap_sort
-	},
-#endif
-#if defined(CONFIG_KARN_FARR_BUBBLE_SORT)
-	{
-		.fapt_name     = "bubble",
-		.fapt_validate = fapt_bubble_validate,
-		.fapt_sort     = fapt_bubble_sort
-	},
-#endif
-#if defined(CONFIG_KARN_FARR_SELECTION_SORT)
-	{
-		.fapt_name     = "selection",
-		.fapt_validate = fapt_selection_validate,
-		.fapt_sort     = fapt_selection_sort
-	},
-#endif
-#if defined(CONFIG_KARN_FARR_INSERTION_SORT)
-	{
-		.fapt_name     = "insertion",
-		.fapt_validate = fapt_insertion_validate,
-		.fapt_sort     = fapt_insertion_sort
-	},
-#endif
-#if defined(CONFIG_KARN_FARR_QUICK_SORT)
-	{
-		.fapt_name     = "quick",
-		.fapt_validate = fapt_quick_validate,
-		.fapt_sort     = fapt_quick_sort
-	},
-#endif
-#if defined(CONFIG_KARN_FARR_INTRO_SORT)
-	{
-		.fapt_name     = "intro",
-		.fapt_validate = fapt_intro_validate,
-		.fapt_sort     = fapt_intro_sort
-	},
-#endif
-};
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
 
-static int fapt_load(const char *pathname)
-{
-	unsigned int *k;
+#include "farr.h"
 
-	if (pt_open_entries(pathname, &fapt_entries))
-		return EXIT_FAILURE;
+static int fapt_pdq_validate(void)
+{
+	int           n;
+	unsigned int *keys;
+	int           ret = EXIT_FAILURE;
 
-	fapt_keys = malloc(sizeof(*k) * fapt_entries.pt_nr);
-	if (!fapt_keys)
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
 		return EXIT_FAILURE;
 
-	pt_init_entry_iter(&fapt_entries);
-
-	k = fapt_keys;
-	while (!pt_iter_entry(&fapt_entries, k))
-		k++;
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
 
-	return EXIT_SUCCESS;
-}
+	farr_pdq_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	              pt_compare_min, pt_copy_key);
 
-static const struct fapt_iface *
-fapt_setup_algo(const char *algo_name)
-{
-	unsigned int a;
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
 
-	for (a = 0; a < array_nr(fapt_algos); a++)
-		if (!strcmp(algo_name, fapt_algos[a].fapt_name))
-			return &fapt_algos[a];
+	ret = EXIT_SUCCESS;
 
-	fprintf(stderr, "Invalid \"%s\" sort algorithm\n", algo_name);
+free:
+	free(keys);
 
-	return NULL;
+	return ret;
 }
 
-static void
-usage(const char *me)
+static int fapt_pdq_sort(unsigned long long *nsecs)
 {
-	fprintf(stderr,
-	        "Usage: %s [OPTIONS] FILE ALGORITHM LOOPS\n"
-	        "where OPTIONS:\n"
-	        "    -p|--prio  PRIORITY\n"
-	        "    -h|--help\n",
-	        me);
-}
+	struct timespec  start, elapse;
+	unsigned int    *keys;
 
-int main(int argc, char *argv[])
-{
-	const struct fapt_iface *algo;
-	unsigned int             l, loops = 0;
-	int                      prio = 0;
-	unsigned long long       nsecs;
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
 
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
 
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	farr_pdq_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	              pt_compare_min, pt_copy_key);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
 
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
 
-	while (true) {
-		int                        opt;
-		static const struct option lopts[] = {
-			{"help",    0, NULL, 'h'},
-			{"prio",    1, NULL, 'p'},
-			{0,         0, 0,    0}
-		};
+	free(keys);
 
-		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
-		if (opt < 0)
-			/* No more options: go parsing positional arguments. */
-			break;
+	return EXIT_SUCCESS;
+}
 
-		switch (opt) {
-		case 'p': /* priority */
-			if (pt_parse_sched_prio(optarg, &prio)) {
-				usage(argv[0]);
-				return EXIT_FAILURE;
-			}
+#endif /* defined(CONFIG_KARN_FARR_PDQ_SORT) */
 
-			break;
+/******************************************************************************
+ * Fixed array based Timsort stable sorting
+ ******************************************************************************/
 
-		case 'h': /* Help message. */
-			usage(argv[0]);
-			return EXIT_SUCCESS;
+#if defined(CONFIG_KARN_FARR_TIM_SORT)
 
-		case '?': /* Unknown option. */
-		default:
-			usage(argv[0]);
-			return EXIT_FAILURE;
-		}
-	}
+#include "farr.h"
 
-	/*
-	 * Check positional arguments are properly specified on command
-	 * line.
-	 */
-	argc -= optind;
-	if (argc != 3) {
-		fprintf(stderr, "Invalid number of arguments\n");
-		usage(argv[0]);
-		return EXIT_FAILURE;
-	}
+static int fapt_tim_validate(void)
+{
+	int           n;
+	unsigned int *keys;
+	int           ret = EXIT_FAILURE;
 
-	algo = fapt_setup_algo(argv[optind + 1]);
-	if (!algo)
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
 		return EXIT_FAILURE;
 
-	if (pt_parse_loop_nr(argv[optind + 2], &loops))
-		return EXIT_FAILURE;
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
 
-	if (fapt_load(argv[optind]))
-		return EXIT_FAILURE;
+	if (farr_tim_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                  pt_compare_min, pt_copy_key))
+		goto free;
 
-	if (algo->fapt_validate())
-		return EXIT_FAILURE;
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
 
-	if (pt_setup_sched_prio(prio))
-		return EXIT_FAILURE;
+	ret = EXIT_SUCCESS;
 
-	for (l = 0; l < loops; l++) {
+free:
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_tim_sort(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *keys;
+	int              ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	if (farr_tim_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                  pt_compare_min, pt_copy_key))
+		goto free;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+#endif /* defined(CONFIG_KARN_FARR_TIM_SORT) */
+
+/******************************************************************************
+ * Fixed array based indirect sorting of large records
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_INDIRECT_SORT)
+
+#include "farr.h"
+
+/*
+ * Records are made of an unsigned int key followed by a payload filled with
+ * key's least significant byte so that records integrity may be checked once
+ * sorted.
+ */
+typedef void (fapt_record_fn)(char *records);
+
+static void fapt_copy_record(char *restrict dst, const char *restrict src)
+{
+	memcpy(dst, src, fapt_entry_size);
+}
+
+static void fapt_copy_payload(char *restrict dst, const char *restrict src)
+{
+	memcpy(dst, src, fapt_entry_size - sizeof(unsigned int));
+}
+
+static uint64_t fapt_record_prefix(const char *record)
+{
+	return *(const unsigned int *)record;
+}
+
+static void fapt_fill_payload(unsigned char *payload, unsigned int key)
+{
+	memset(payload, key & 0xff, fapt_entry_size - sizeof(unsigned int));
+}
+
+static int fapt_check_payload(const unsigned char *payload, unsigned int key)
+{
+	size_t size = fapt_entry_size - sizeof(unsigned int);
+
+	return ((payload[0] != (key & 0xff)) ||
+	        (payload[size - 1] != (key & 0xff))) ? -1 : 0;
+}
+
+static char * fapt_alloc_records(void)
+{
+	char *recs;
+	int   n;
+
+	recs = malloc(fapt_entry_size * fapt_entries.pt_nr);
+	if (!recs)
+		return NULL;
+
+	for (n = 0; n < fapt_entries.pt_nr; n++) {
+		char *rec = &recs[n * fapt_entry_size];
+
+		*(unsigned int *)rec = fapt_keys[n];
+		fapt_fill_payload((unsigned char *)&rec[sizeof(unsigned int)],
+		                  fapt_keys[n]);
+	}
+
+	return recs;
+}
+
+static int fapt_check_records(const char *records)
+{
+	int n;
+
+	for (n = 0; n < fapt_entries.pt_nr; n++) {
+		const char   *rec = &records[n * fapt_entry_size];
+		unsigned int  key = *(const unsigned int *)rec;
+
+		if ((n && (*(const unsigned int *)(rec - fapt_entry_size) >
+		           key)) ||
+		    fapt_check_payload((const unsigned char *)
+		                       &rec[sizeof(unsigned int)], key)) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_record_validate(fapt_record_fn *sort)
+{
+	char *recs;
+	int   ret;
+
+	recs = fapt_alloc_records();
+	if (!recs)
+		return EXIT_FAILURE;
+
+	sort(recs);
+
+	ret = fapt_check_records(recs);
+
+	free(recs);
+
+	return ret;
+}
+
+static int fapt_record_sort(fapt_record_fn *sort, unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	char            *recs;
+
+	recs = fapt_alloc_records();
+	if (!recs)
+		return EXIT_FAILURE;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	sort(recs);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(recs);
+
+	return EXIT_SUCCESS;
+}
+
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
+
+/* Direct sorting of records, i.e. moving records at each swap. */
+static void fapt_pdq_records(char *records)
+{
+	farr_pdq_sort(records, fapt_entry_size, fapt_entries.pt_nr,
+	              pt_compare_min, fapt_copy_record);
+}
+
+static int fapt_pdq_record_validate(void)
+{
+	return fapt_record_validate(fapt_pdq_records);
+}
+
+static int fapt_pdq_record_sort(unsigned long long *nsecs)
+{
+	return fapt_record_sort(fapt_pdq_records, nsecs);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_PDQ_SORT) */
+
+static void fapt_indirect_records(char *records)
+{
+	if (farr_sort_indirect(records, fapt_entry_size, fapt_entries.pt_nr,
+	                       pt_compare_min, fapt_copy_record, NULL))
+		abort();
+}
+
+static int fapt_indirect_record_validate(void)
+{
+	return fapt_record_validate(fapt_indirect_records);
+}
+
+static int fapt_indirect_record_sort(unsigned long long *nsecs)
+{
+	return fapt_record_sort(fapt_indirect_records, nsecs);
+}
+
+static void fapt_prefix_records(char *records)
+{
+	if (farr_sort_indirect(records, fapt_entry_size, fapt_entries.pt_nr,
+	                       pt_compare_min, fapt_copy_record,
+	                       fapt_record_prefix))
+		abort();
+}
+
+static int fapt_prefix_record_validate(void)
+{
+	return fapt_record_validate(fapt_prefix_records);
+}
+
+static int fapt_prefix_record_sort(unsigned long long *nsecs)
+{
+	return fapt_record_sort(fapt_prefix_records, nsecs);
+}
+
+/*
+ * Co-sorting of an array of keys along with an array of payloads, i.e. records
+ * split into 2 parallel arrays.
+ */
+static unsigned char * fapt_alloc_payloads(void)
+{
+	size_t         size = fapt_entry_size - sizeof(unsigned int);
+	unsigned char *plds;
+	int            n;
+
+	plds = malloc(size * fapt_entries.pt_nr);
+	if (!plds)
+		return NULL;
+
+	for (n = 0; n < fapt_entries.pt_nr; n++)
+		fapt_fill_payload(&plds[n * size], fapt_keys[n]);
+
+	return plds;
+}
+
+static int fapt_cosort_records(unsigned int       *keys,
+                               unsigned char      *payloads,
+                               unsigned long long *nsecs)
+{
+	struct timespec                start, elapse;
+	const struct farr_cosort_array pld = {
+		.cosort_entries = (char *)payloads,
+		.cosort_size    = fapt_entry_size - sizeof(unsigned int),
+		.cosort_copy    = fapt_copy_payload
+	};
+	int                            ret;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	ret = farr_cosort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                  pt_compare_min, pt_copy_key, fapt_record_prefix, &pld,
+	                  1);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	if (ret)
+		return EXIT_FAILURE;
+
+	if (nsecs) {
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs = pt_tspec2ns(&elapse);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_cosort_record_run(unsigned long long *nsecs)
+{
+	size_t         size = fapt_entry_size - sizeof(unsigned int);
+	unsigned int  *keys;
+	unsigned char *plds;
+	int            n;
+	int            ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	plds = fapt_alloc_payloads();
+	if (!plds)
+		goto free_keys;
+
+	if (fapt_cosort_records(keys, plds, nsecs))
+		goto free_plds;
+
+	if (!nsecs) {
+		for (n = 0; n < fapt_entries.pt_nr; n++) {
+			if ((n && (keys[n - 1] > keys[n])) ||
+			    fapt_check_payload(&plds[n * size], keys[n])) {
+				fprintf(stderr, "Bogus sorting scheme\n");
+				goto free_plds;
+			}
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free_plds:
+	free(plds);
+free_keys:
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_cosort_record_validate(void)
+{
+	return fapt_cosort_record_run(NULL);
+}
+
+static int fapt_cosort_record_sort(unsigned long long *nsecs)
+{
+	return fapt_cosort_record_run(nsecs);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_INDIRECT_SORT) */
+
+/******************************************************************************
+ * Fixed array based selection and partial sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_SELECT)
+
+#include "farr.h"
+
+/*
+ * Number of entries to select: median for selection, 1% of entries for partial
+ * sorting and top-k unless specified on command line.
+ */
+static unsigned int fapt_select_count(bool median)
+{
+	if (fapt_select_nr)
+		return umin(fapt_select_nr, (unsigned int)fapt_entries.pt_nr);
+
+	if (median)
+		return (fapt_entries.pt_nr / 2) + 1;
+
+	return umax((unsigned int)fapt_entries.pt_nr / 100, 1U);
+}
+
+static unsigned int * fapt_select_sorted_keys(void)
+{
+	unsigned int *keys;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return NULL;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+	qsort(keys, fapt_entries.pt_nr, sizeof(*keys), pt_qsort_compare);
+
+	return keys;
+}
+
+static void fapt_select_keys(unsigned int *keys)
+{
+	farr_select((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	            fapt_select_count(true) - 1, pt_compare_min, pt_copy_key);
+}
+
+static void fapt_partial_sort_keys(unsigned int *keys)
+{
+	farr_partial_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                  fapt_select_count(false), pt_compare_min,
+	                  pt_copy_key);
+}
+
+static int fapt_select_validate(void)
+{
+	unsigned int *keys;
+	unsigned int *sorted;
+	unsigned int  nth = fapt_select_count(true) - 1;
+	int           ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	sorted = fapt_select_sorted_keys();
+	if (!sorted)
+		goto free;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	fapt_select_keys(keys);
+
+	if (keys[nth] != sorted[nth]) {
+		fprintf(stderr, "Bogus selection scheme\n");
+		goto free;
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(sorted);
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_partial_sort_validate(void)
+{
+	unsigned int *keys;
+	unsigned int *sorted;
+	int           ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	sorted = fapt_select_sorted_keys();
+	if (!sorted)
+		goto free;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	fapt_partial_sort_keys(keys);
+
+	if (memcmp(keys, sorted, sizeof(*keys) * fapt_select_count(false))) {
+		fprintf(stderr, "Bogus partial sorting scheme\n");
+		goto free;
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(sorted);
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_select_run(void (*run)(unsigned int *keys),
+                           unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *keys;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	run(keys);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_select_sort(unsigned long long *nsecs)
+{
+	return fapt_select_run(fapt_select_keys, nsecs);
+}
+
+static int fapt_partial_sort_sort(unsigned long long *nsecs)
+{
+	return fapt_select_run(fapt_partial_sort_keys, nsecs);
+}
+
+static int fapt_top_k_validate(void)
+{
+	unsigned int  nr = fapt_select_count(false);
+	unsigned int *top;
+	unsigned int *sorted;
+	unsigned int  k;
+	int           ret = EXIT_FAILURE;
+
+	top = malloc(sizeof(*top) * nr);
+	if (!top)
+		return EXIT_FAILURE;
+
+	sorted = fapt_select_sorted_keys();
+	if (!sorted)
+		goto free;
+
+	farr_top_k((char *)fapt_keys, sizeof(*fapt_keys), fapt_entries.pt_nr,
+	           (char *)top, nr, pt_compare_min, pt_copy_key);
+
+	for (k = 0; k < nr; k++) {
+		if (top[k] != sorted[fapt_entries.pt_nr - 1 - k]) {
+			fprintf(stderr, "Bogus top-k scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(sorted);
+	free(top);
+
+	return ret;
+}
+
+static int fapt_top_k_sort(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     nr = fapt_select_count(false);
+	unsigned int    *top;
+
+	top = malloc(sizeof(*top) * nr);
+	if (!top)
+		return EXIT_FAILURE;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	farr_top_k((char *)fapt_keys, sizeof(*fapt_keys), fapt_entries.pt_nr,
+	           (char *)top, nr, pt_compare_min, pt_copy_key);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(top);
+
+	return EXIT_SUCCESS;
+}
+
+#endif /* defined(CONFIG_KARN_FARR_SELECT) */
+
+/******************************************************************************
+ * Fixed array based type specialized sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+
+#include "farr.h"
+
+static int fapt_typed_validate(void (*sort)(uint32_t *, unsigned int))
+{
+	int       n;
+	uint32_t *keys;
+	int       ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	sort(keys, fapt_entries.pt_nr);
+
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_typed_sort(void               (*sort)(uint32_t *,
+                                                      unsigned int),
+                           unsigned long long  *nsecs)
+{
+	struct timespec  start, elapse;
+	uint32_t        *keys;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	sort(keys, fapt_entries.pt_nr);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_quick_uint32_validate(void)
+{
+	return fapt_typed_validate(farr_uint32_quick_sort);
+}
+
+static int fapt_quick_uint32_sort(unsigned long long *nsecs)
+{
+	return fapt_typed_sort(farr_uint32_quick_sort, nsecs);
+}
+
+static int fapt_pdq_uint32_validate(void)
+{
+	return fapt_typed_validate(farr_uint32_pdq_sort);
+}
+
+static int fapt_pdq_uint32_sort(unsigned long long *nsecs)
+{
+	return fapt_typed_sort(farr_uint32_pdq_sort, nsecs);
+}
+
+static int fapt_intro_uint32_validate(void)
+{
+	return fapt_typed_validate(farr_uint32_intro_sort);
+}
+
+static int fapt_intro_uint32_sort(unsigned long long *nsecs)
+{
+	return fapt_typed_sort(farr_uint32_intro_sort, nsecs);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_TYPED_SORT) */
+
+/******************************************************************************
+ * Small chunks sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_NETWORK_SORT)
+
+/*
+ * Loaded keys are split into consecutive chunks of fapt_chunk_nr keys which are
+ * sorted one after the other so that small partitions base case sorting may be
+ * measured for each size.
+ */
+static int fapt_chunk_validate(void (*sort)(uint32_t *, unsigned int))
+{
+	int       n;
+	uint32_t *keys;
+	int       ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	for (n = 0; n < fapt_entries.pt_nr; n += fapt_chunk_nr)
+		sort(&keys[n],
+		     umin(fapt_chunk_nr, (unsigned int)(fapt_entries.pt_nr - n)));
+
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if ((n % fapt_chunk_nr) && (keys[n - 1] > keys[n])) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+static int fapt_chunk_sort(void               (*sort)(uint32_t *,
+                                                      unsigned int),
+                           unsigned long long  *nsecs)
+{
+	struct timespec  start, elapse;
+	int              n;
+	uint32_t        *keys;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	for (n = 0; n < fapt_entries.pt_nr; n += fapt_chunk_nr)
+		sort(&keys[n],
+		     umin(fapt_chunk_nr, (unsigned int)(fapt_entries.pt_nr - n)));
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_network_uint32_validate(void)
+{
+	return fapt_chunk_validate(farr_uint32_network_sort);
+}
+
+static int fapt_network_uint32_sort(unsigned long long *nsecs)
+{
+	return fapt_chunk_sort(farr_uint32_network_sort, nsecs);
+}
+
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+
+static int fapt_insertion_uint32_validate(void)
+{
+	return fapt_chunk_validate(farr_uint32_insertion_sort);
+}
+
+static int fapt_insertion_uint32_sort(unsigned long long *nsecs)
+{
+	return fapt_chunk_sort(farr_uint32_insertion_sort, nsecs);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_TYPED_SORT) */
+
+#endif /* defined(CONFIG_KARN_FARR_NETWORK_SORT) */
+
+/******************************************************************************
+ * Fixed array based radix sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_RADIX_SORT)
+
+#include "farr.h"
+
+typedef void (fapt_radix_fn)(uint32_t *keys, uint32_t *scratch);
+
+static uint64_t fapt_radix_key(const char *entry)
+{
+	return *(const uint32_t *)entry;
+}
+
+static void fapt_lsd_radix(uint32_t *keys, uint32_t *scratch)
+{
+	farr_lsd_radix_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                    sizeof(*keys), fapt_radix_key, pt_copy_key,
+	                    (char *)scratch);
+}
+
+static void fapt_msd_radix(uint32_t *keys, uint32_t *scratch __unused)
+{
+	farr_msd_radix_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                    sizeof(*keys), fapt_radix_key, pt_compare_min,
+	                    pt_copy_key);
+}
+
+static void fapt_radix(uint32_t *keys, uint32_t *scratch)
+{
+	farr_radix_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                sizeof(*keys), fapt_radix_key, pt_compare_min,
+	                pt_copy_key, (char *)scratch);
+}
+
+static void fapt_uint32_radix(uint32_t *keys, uint32_t *scratch)
+{
+	farr_uint32_radix_sort(keys, fapt_entries.pt_nr, scratch);
+}
+
+static int fapt_radix_validate(fapt_radix_fn *sort)
+{
+	int       n;
+	uint32_t *keys;
+	int       ret = EXIT_FAILURE;
+
+	keys = malloc(2 * sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	sort(keys, &keys[fapt_entries.pt_nr]);
+
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+/*
+ * Scratch memory is allocated out of the measurement loop to exclude
+ * allocation costs.
+ */
+static int fapt_radix_sort(fapt_radix_fn *sort, unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	uint32_t        *keys;
+
+	keys = malloc(2 * sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	sort(keys, &keys[fapt_entries.pt_nr]);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_lsd_radix_validate(void)
+{
+	return fapt_radix_validate(fapt_lsd_radix);
+}
+
+static int fapt_lsd_radix_sort(unsigned long long *nsecs)
+{
+	return fapt_radix_sort(fapt_lsd_radix, nsecs);
+}
+
+static int fapt_msd_radix_validate(void)
+{
+	return fapt_radix_validate(fapt_msd_radix);
+}
+
+static int fapt_msd_radix_sort(unsigned long long *nsecs)
+{
+	return fapt_radix_sort(fapt_msd_radix, nsecs);
+}
+
+static int fapt_generic_radix_validate(void)
+{
+	return fapt_radix_validate(fapt_radix);
+}
+
+static int fapt_generic_radix_sort(unsigned long long *nsecs)
+{
+	return fapt_radix_sort(fapt_radix, nsecs);
+}
+
+static int fapt_uint32_radix_validate(void)
+{
+	return fapt_radix_validate(fapt_uint32_radix);
+}
+
+static int fapt_uint32_radix_sort(unsigned long long *nsecs)
+{
+	return fapt_radix_sort(fapt_uint32_radix, nsecs);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_RADIX_SORT) */
+
+/******************************************************************************
+ * Fixed array based counting and bucket sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_COUNTING_SORT)
+
+typedef void (fapt_counting_fn)(uint32_t *keys, uint32_t *scratch);
+
+static uint64_t fapt_counting_key(const char *entry)
+{
+	return *(const uint32_t *)entry;
+}
+
+/* Loaded keys are assumed to be evenly spread over the whole 32 bits range. */
+static void fapt_bucket(uint32_t *keys, uint32_t *scratch)
+{
+	farr_bucket_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr, 0,
+	                 UINT32_MAX, fapt_counting_key, pt_compare_min,
+	                 pt_copy_key, (char *)scratch);
+}
+
+static void fapt_range(uint32_t *keys, uint32_t *scratch)
+{
+	farr_range_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                fapt_counting_key, pt_compare_min, pt_copy_key,
+	                (char *)scratch);
+}
+
+static int fapt_counting_validate(fapt_counting_fn *sort)
+{
+	int       n;
+	uint32_t *keys;
+	int       ret = EXIT_FAILURE;
+
+	keys = malloc(2 * sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	sort(keys, &keys[fapt_entries.pt_nr]);
+
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+/*
+ * Scratch memory is allocated out of the measurement loop to exclude
+ * allocation costs.
+ */
+static int fapt_counting_sort(fapt_counting_fn   *sort,
+                              unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	uint32_t        *keys;
+
+	keys = malloc(2 * sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	sort(keys, &keys[fapt_entries.pt_nr]);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_bucket_validate(void)
+{
+	return fapt_counting_validate(fapt_bucket);
+}
+
+static int fapt_bucket_sort(unsigned long long *nsecs)
+{
+	return fapt_counting_sort(fapt_bucket, nsecs);
+}
+
+static int fapt_range_validate(void)
+{
+	return fapt_counting_validate(fapt_range);
+}
+
+static int fapt_range_sort(unsigned long long *nsecs)
+{
+	return fapt_counting_sort(fapt_range, nsecs);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_COUNTING_SORT) */
+
+/******************************************************************************
+ * Fixed array based multi-threaded sorting
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FARR_PARALLEL_SORT)
+
+#include "farr.h"
+
+static int fapt_parallel_validate(void)
+{
+	int           n;
+	unsigned int *keys;
+	int           ret = EXIT_FAILURE;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	farr_parallel_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                   pt_compare_min, pt_copy_key, fapt_thread_nr);
+
+	for (n = 1; n < fapt_entries.pt_nr; n++) {
+		if (keys[n - 1] > keys[n]) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			goto free;
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+free:
+	free(keys);
+
+	return ret;
+}
+
+/*
+ * Wall clock time is measured here since sorting is spread over multiple
+ * threads.
+ */
+static int fapt_parallel_sort(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *keys;
+
+	keys = malloc(sizeof(*keys) * fapt_entries.pt_nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	memcpy(keys, fapt_keys, sizeof(*keys) * fapt_entries.pt_nr);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	farr_parallel_sort((char *)keys, sizeof(*keys), fapt_entries.pt_nr,
+	                   pt_compare_min, pt_copy_key, fapt_thread_nr);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	free(keys);
+
+	return EXIT_SUCCESS;
+}
+
+#endif /* defined(CONFIG_KARN_FARR_PARALLEL_SORT) */
+
+/******************************************************************************
+ * Main measurment task handling
+ ******************************************************************************/
+
+static const struct fapt_iface fapt_algos[] = {
+	{
+		.fapt_name     = "qsort",
+		.fapt_validate = fapt_qsort_validate,
+		.fapt_sort     = fapt_qsort_sort
+	},
+#if defined(CONFIG_KARN_FBNR_HEAP_SORT)
+	{
+		.fapt_name     = "fbnrh",
+		.fapt_validate = fapt_fbnr_heap_validate,
+		.fapt_sort     = fapt_fbnr_heap_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FDARY_HEAP_SORT)
+	{
+		.fapt_name     = "fdary4h",
+		.fapt_validate = fapt_fdary4_heap_validate,
+		.fapt_sort     = fapt_fdary4_heap_sort
+	},
+	{
+		.fapt_name     = "fdary8h",
+		.fapt_validate = fapt_fdary8_heap_validate,
+		.fapt_sort     = fapt_fdary8_heap_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FWK_HEAP_SORT)
+	{
+		.fapt_name     = "fwkh",
+		.fapt_validate = fapt_fwk_heap_validate,
+		.fapt_sort     = fapt_fwk_heap_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_BUBBLE_SORT)
+	{
+		.fapt_name     = "bubble",
+		.fapt_validate = fapt_bubble_validate,
+		.fapt_sort     = fapt_bubble_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_SELECTION_SORT)
+	{
+		.fapt_name     = "selection",
+		.fapt_validate = fapt_selection_validate,
+		.fapt_sort     = fapt_selection_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_INSERTION_SORT)
+	{
+		.fapt_name     = "insertion",
+		.fapt_validate = fapt_insertion_validate,
+		.fapt_sort     = fapt_insertion_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_QUICK_SORT)
+	{
+		.fapt_name     = "quick",
+		.fapt_validate = fapt_quick_validate,
+		.fapt_sort     = fapt_quick_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_INTRO_SORT)
+	{
+		.fapt_name     = "intro",
+		.fapt_validate = fapt_intro_validate,
+		.fapt_sort     = fapt_intro_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
+	{
+		.fapt_name     = "pdq",
+		.fapt_validate = fapt_pdq_validate,
+		.fapt_sort     = fapt_pdq_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_TIM_SORT)
+	{
+		.fapt_name     = "tim",
+		.fapt_validate = fapt_tim_validate,
+		.fapt_sort     = fapt_tim_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+	{
+		.fapt_name     = "quick_uint32",
+		.fapt_validate = fapt_quick_uint32_validate,
+		.fapt_sort     = fapt_quick_uint32_sort
+	},
+	{
+		.fapt_name     = "intro_uint32",
+		.fapt_validate = fapt_intro_uint32_validate,
+		.fapt_sort     = fapt_intro_uint32_sort
+	},
+	{
+		.fapt_name     = "pdq_uint32",
+		.fapt_validate = fapt_pdq_uint32_validate,
+		.fapt_sort     = fapt_pdq_uint32_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_RADIX_SORT)
+	{
+		.fapt_name     = "lsd_radix",
+		.fapt_validate = fapt_lsd_radix_validate,
+		.fapt_sort     = fapt_lsd_radix_sort
+	},
+	{
+		.fapt_name     = "msd_radix",
+		.fapt_validate = fapt_msd_radix_validate,
+		.fapt_sort     = fapt_msd_radix_sort
+	},
+	{
+		.fapt_name     = "radix",
+		.fapt_validate = fapt_generic_radix_validate,
+		.fapt_sort     = fapt_generic_radix_sort
+	},
+	{
+		.fapt_name     = "radix_uint32",
+		.fapt_validate = fapt_uint32_radix_validate,
+		.fapt_sort     = fapt_uint32_radix_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_COUNTING_SORT)
+	{
+		.fapt_name     = "bucket",
+		.fapt_validate = fapt_bucket_validate,
+		.fapt_sort     = fapt_bucket_sort
+	},
+	{
+		.fapt_name     = "range",
+		.fapt_validate = fapt_range_validate,
+		.fapt_sort     = fapt_range_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_PARALLEL_SORT)
+	{
+		.fapt_name     = "parallel",
+		.fapt_validate = fapt_parallel_validate,
+		.fapt_sort     = fapt_parallel_sort,
+		.fapt_param    = FAPT_THREAD_PARAM
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_INDIRECT_SORT)
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
+	{
+		.fapt_name     = "pdq_record",
+		.fapt_validate = fapt_pdq_record_validate,
+		.fapt_sort     = fapt_pdq_record_sort,
+		.fapt_param    = FAPT_SIZE_PARAM
+	},
+#endif
+	{
+		.fapt_name     = "indirect_record",
+		.fapt_validate = fapt_indirect_record_validate,
+		.fapt_sort     = fapt_indirect_record_sort,
+		.fapt_param    = FAPT_SIZE_PARAM
+	},
+	{
+		.fapt_name     = "prefix_record",
+		.fapt_validate = fapt_prefix_record_validate,
+		.fapt_sort     = fapt_prefix_record_sort,
+		.fapt_param    = FAPT_SIZE_PARAM
+	},
+	{
+		.fapt_name     = "cosort_record",
+		.fapt_validate = fapt_cosort_record_validate,
+		.fapt_sort     = fapt_cosort_record_sort,
+		.fapt_param    = FAPT_SIZE_PARAM
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_SELECT)
+	{
+		.fapt_name     = "select",
+		.fapt_validate = fapt_select_validate,
+		.fapt_sort     = fapt_select_sort
+	},
+	{
+		.fapt_name     = "partial_sort",
+		.fapt_validate = fapt_partial_sort_validate,
+		.fapt_sort     = fapt_partial_sort_sort
+	},
+	{
+		.fapt_name     = "top_k",
+		.fapt_validate = fapt_top_k_validate,
+		.fapt_sort     = fapt_top_k_sort
+	},
+#endif
+#if defined(CONFIG_KARN_FARR_NETWORK_SORT)
+	{
+		.fapt_name     = "network_uint32",
+		.fapt_validate = fapt_network_uint32_validate,
+		.fapt_sort     = fapt_network_uint32_sort,
+		.fapt_param    = FAPT_CHUNK_PARAM
+	},
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+	{
+		.fapt_name     = "insertion_uint32",
+		.fapt_validate = fapt_insertion_uint32_validate,
+		.fapt_sort     = fapt_insertion_uint32_sort,
+		.fapt_param    = FAPT_CHUNK_PARAM
+	},
+#endif
+#endif
+};
+
+static int fapt_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &fapt_entries))
+		return EXIT_FAILURE;
+
+	fapt_keys = malloc(sizeof(*k) * fapt_entries.pt_nr);
+	if (!fapt_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&fapt_entries);
+
+	k = fapt_keys;
+	while (!pt_iter_entry(&fapt_entries, k))
+		k++;
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Input key orderings generated out of loaded keys so that adaptive algorithms
+ * may be assessed.
+ */
+enum fapt_order {
+	FAPT_FILE_ORDER,      /* keys are kept in file order */
+	FAPT_PRESORTED_ORDER, /* keys are sorted */
+	FAPT_REVERSED_ORDER,  /* keys are sorted in reverse order */
+	FAPT_PARTIAL_ORDER    /* sorted keys followed by an unsorted tail */
+};
+
+/* Percentage of keys left unsorted in the tail of partially sorted input. */
+#define FAPT_PARTIAL_TAIL (10U)
+
+static int fapt_parse_order(const char *arg, enum fapt_order *order)
+{
+	if (!strcmp(arg, "file"))
+		*order = FAPT_FILE_ORDER;
+	else if (!strcmp(arg, "presorted"))
+		*order = FAPT_PRESORTED_ORDER;
+	else if (!strcmp(arg, "reversed"))
+		*order = FAPT_REVERSED_ORDER;
+	else if (!strcmp(arg, "partial"))
+		*order = FAPT_PARTIAL_ORDER;
+	else {
+		fprintf(stderr, "Invalid \"%s\" input order\n", arg);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void fapt_arrange(enum fapt_order order)
+{
+	unsigned int nr = fapt_entries.pt_nr;
+	unsigned int k;
+
+	switch (order) {
+	case FAPT_FILE_ORDER:
+		return;
+
+	case FAPT_PRESORTED_ORDER:
+		break;
+
+	case FAPT_REVERSED_ORDER:
+		qsort(fapt_keys, nr, sizeof(*fapt_keys), pt_qsort_compare);
+		for (k = 0; k < (nr / 2); k++) {
+			unsigned int tmp = fapt_keys[k];
+
+			fapt_keys[k] = fapt_keys[nr - 1 - k];
+			fapt_keys[nr - 1 - k] = tmp;
+		}
+		return;
+
+	case FAPT_PARTIAL_ORDER:
+		nr -= (nr * FAPT_PARTIAL_TAIL) / 100;
+		break;
+	}
+
+	qsort(fapt_keys, nr, sizeof(*fapt_keys), pt_qsort_compare);
+}
+
+static const struct fapt_iface *
+fapt_setup_algo(const char *algo_name)
+{
+	unsigned int a;
+
+	for (a = 0; a < array_nr(fapt_algos); a++)
+		if (!strcmp(algo_name, fapt_algos[a].fapt_name))
+			return &fapt_algos[a];
+
+	fprintf(stderr, "Invalid \"%s\" sort algorithm\n", algo_name);
+
+	return NULL;
+}
+
+static int fapt_parse_thread_nr(const char *arg, unsigned int *thread_nr)
+{
+	char         *str;
+	unsigned int  nr;
+	int           err = 0;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str)
+		err = EINVAL;
+	else if (!nr)
+		err = ERANGE;
+
+	if (err) {
+		fprintf(stderr, "Invalid number of threads specified: %s\n",
+		        strerror(err));
+		return EXIT_FAILURE;
+	}
+
+	*thread_nr = nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_run(const struct fapt_iface *algo, unsigned int loops)
+{
+	unsigned int       l;
+	unsigned long long nsecs;
+
+	for (l = 0; l < loops; l++) {
 		if (algo->fapt_sort(&nsecs))
 			return EXIT_FAILURE;
 		printf("nsec=%llu\n", nsecs);
@@ -713,3 +2098,322 @@ int main(int argc, char *argv[])
 
 	return EXIT_SUCCESS;
 }
+
+static int fapt_parse_select_nr(const char *arg, unsigned int *select_nr)
+{
+	char         *str;
+	unsigned int  nr;
+	int           err = 0;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str)
+		err = EINVAL;
+	else if (!nr)
+		err = ERANGE;
+
+	if (err) {
+		fprintf(stderr, "Invalid number of entries to select: %s\n",
+		        strerror(err));
+		return EXIT_FAILURE;
+	}
+
+	*select_nr = nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_parse_chunk_nr(const char *arg, unsigned int *chunk_nr)
+{
+	char         *str;
+	unsigned int  nr;
+	int           err = 0;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str)
+		err = EINVAL;
+	else if (!nr || (nr > FAPT_CHUNK_NR_MAX))
+		err = ERANGE;
+
+	if (err) {
+		fprintf(stderr, "Invalid chunk size specified: %s\n",
+		        strerror(err));
+		return EXIT_FAILURE;
+	}
+
+	*chunk_nr = nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_parse_entry_size(const char *arg, size_t *entry_size)
+{
+	char          *str;
+	unsigned long  size;
+	int            err = 0;
+
+	size = strtoul(arg, &str, 0);
+	if (*str)
+		err = EINVAL;
+	else if ((size < FAPT_RECORD_SIZE_MIN) ||
+	         (size > FAPT_RECORD_SIZE_MAX) ||
+	         (size % sizeof(unsigned int)))
+		err = ERANGE;
+
+	if (err) {
+		fprintf(stderr, "Invalid entry size specified: %s\n",
+		        strerror(err));
+		return EXIT_FAILURE;
+	}
+
+	*entry_size = size;
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Run measurements for a number of threads doubling at each step up to the
+ * requested maximum so that scaling efficiency may be computed.
+ */
+static int fapt_sweep_threads(const struct fapt_iface *algo,
+                              unsigned int             loops)
+{
+	unsigned int max_nr = fapt_thread_nr;
+	unsigned int nr = 1;
+
+	while (true) {
+		unsigned int       l;
+		unsigned long long nsecs;
+
+		fapt_thread_nr = nr;
+
+		for (l = 0; l < loops; l++) {
+			if (algo->fapt_sort(&nsecs))
+				return EXIT_FAILURE;
+			printf("threads=%u nsec=%llu\n", nr, nsecs);
+		}
+
+		if (nr == max_nr)
+			return EXIT_SUCCESS;
+
+		nr = umin(2 * nr, max_nr);
+	}
+}
+
+/*
+ * Run measurements for an entry size doubling at each step up to the requested
+ * maximum so that the cost of moving entries around may be assessed.
+ */
+static int fapt_sweep_sizes(const struct fapt_iface *algo, unsigned int loops)
+{
+	size_t max_size = fapt_entry_size;
+	size_t size = FAPT_RECORD_SIZE_MIN;
+
+	while (true) {
+		unsigned int       l;
+		unsigned long long nsecs;
+
+		fapt_entry_size = size;
+
+		for (l = 0; l < loops; l++) {
+			if (algo->fapt_sort(&nsecs))
+				return EXIT_FAILURE;
+			printf("size=%zu nsec=%llu\n", size, nsecs);
+		}
+
+		if (size == max_size)
+			return EXIT_SUCCESS;
+
+		size = umin(2 * size, max_size);
+	}
+}
+
+/*
+ * Run measurements for each chunk size up to the requested maximum so that
+ * small partitions base case sorting may be tuned.
+ */
+static int fapt_sweep_chunks(const struct fapt_iface *algo, unsigned int loops)
+{
+	unsigned int max_nr = fapt_chunk_nr;
+	unsigned int nr;
+
+	for (nr = 1; nr <= max_nr; nr++) {
+		unsigned int       l;
+		unsigned long long nsecs;
+
+		fapt_chunk_nr = nr;
+
+		for (l = 0; l < loops; l++) {
+			if (algo->fapt_sort(&nsecs))
+				return EXIT_FAILURE;
+			printf("chunk=%u nsec=%llu\n", nr, nsecs);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int fapt_sweep(const struct fapt_iface *algo, unsigned int loops)
+{
+	switch (algo->fapt_param) {
+	case FAPT_THREAD_PARAM:
+		return fapt_sweep_threads(algo, loops);
+
+	case FAPT_SIZE_PARAM:
+		return fapt_sweep_sizes(algo, loops);
+
+	case FAPT_CHUNK_PARAM:
+		return fapt_sweep_chunks(algo, loops);
+
+	default:
+		fprintf(stderr,
+		        "Sweeping not supported by \"%s\" sort algorithm\n",
+		        algo->fapt_name);
+		return EXIT_FAILURE;
+	}
+}
+
+static void
+usage(const char *me)
+{
+	fprintf(stderr,
+	        "Usage: %s [OPTIONS] FILE ALGORITHM LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio       PRIORITY\n"
+	        "    -t|--threads    THREADS\n"
+	        "    -e|--entry-size BYTES\n"
+	        "    -k|--select     COUNT\n"
+	        "    -c|--chunk      COUNT\n"
+	        "    -s|--sweep\n"
+	        "    -o|--order      file|presorted|reversed|partial\n"
+	        "    -h|--help\n",
+	        me);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct fapt_iface *algo;
+	unsigned int             loops = 0;
+	int                      prio = 0;
+	bool                     sweep = false;
+	enum fapt_order          order = FAPT_FILE_ORDER;
+
+
+
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help",       0, NULL, 'h'},
+			{"prio",       1, NULL, 'p'},
+			{"threads",    1, NULL, 't'},
+			{"entry-size", 1, NULL, 'e'},
+			{"select",     1, NULL, 'k'},
+			{"chunk",      1, NULL, 'c'},
+			{"sweep",      0, NULL, 's'},
+			{"order",      1, NULL, 'o'},
+			{0,            0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:t:e:k:c:so:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (pt_parse_sched_prio(optarg, &prio)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 't': /* maximum number of threads */
+			if (fapt_parse_thread_nr(optarg, &fapt_thread_nr)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'e': /* maximum size of entries */
+			if (fapt_parse_entry_size(optarg, &fapt_entry_size)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'k': /* number of entries to select */
+			if (fapt_parse_select_nr(optarg, &fapt_select_nr)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'c': /* maximum number of keys per chunk */
+			if (fapt_parse_chunk_nr(optarg, &fapt_chunk_nr)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 's': /* algorithm parameter sweep */
+			sweep = true;
+			break;
+
+		case 'o': /* input keys order */
+			if (fapt_parse_order(optarg, &order)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+
+		case '?': /* Unknown option. */
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 3) {
+		fprintf(stderr, "Invalid number of arguments\n");
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	algo = fapt_setup_algo(argv[optind + 1]);
+	if (!algo)
+		return EXIT_FAILURE;
+
+	if (pt_parse_loop_nr(argv[optind + 2], &loops))
+		return EXIT_FAILURE;
+
+	if (fapt_load(argv[optind]))
+		return EXIT_FAILURE;
+
+	fapt_arrange(order);
+
+	if (algo->fapt_validate())
+		return EXIT_FAILURE;
+
+	if (pt_setup_sched_prio(prio))
+		return EXIT_FAILURE;
+
+	if (sweep)
+		return fapt_sweep(algo, loops);
+
+	return fapt_run(algo, loops);
+}
@@ -28,6 +28,7 @@
 
 #include <karn/farr.h>
 #include <cute/cute.h>
+#include <string.h>
 
 static int farrut_compare_min(const char *first, const char *second)
 {
@@ -41,7 +42,7 @@ static void farrut_copy(char *restrict dest, const char *restrict src)
 
 typedef void (farrut_sort_fn)(char *,
                               size_t,
-                              unsigned int,
+                              size_t,
                               farr_compare_fn *,
                               farr_copy_fn *);
 
@@ -348,3 +349,1435 @@ CUTE_PNP_TEST(farrut_quick_sort_unsorted_duplicates, &farrut_quick_sort)
 }
 
 #endif /* defined(CONFIG_KARN_FARR_QUICK_SORT) */
+
+#if defined(CONFIG_KARN_FARR_PDQ_SORT)
+
+#define FARRUT_PDQ_NR (4096U)
+
+static void farrut_pdq_check(int *entries, unsigned int nr)
+{
+	unsigned int e;
+
+	farr_pdq_sort((char *)entries, sizeof(entries[0]), nr,
+	              farrut_compare_min, farrut_copy);
+
+	for (e = 1; e < nr; e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+static CUTE_PNP_SUITE(farrut_pdq_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_pdq_sort_single, &farrut_pdq_sort)
+{
+	farrut_sort_single(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_inorder2, &farrut_pdq_sort)
+{
+	farrut_sort_inorder2(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_revorder2, &farrut_pdq_sort)
+{
+	farrut_sort_revorder2(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_duplicates, &farrut_pdq_sort)
+{
+	farrut_sort_duplicates(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_presorted, &farrut_pdq_sort)
+{
+	farrut_sort_presorted(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_reverse_sorted, &farrut_pdq_sort)
+{
+	farrut_sort_reverse_sorted(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_unsorted, &farrut_pdq_sort)
+{
+	farrut_sort_unsorted(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_unsorted_duplicates, &farrut_pdq_sort)
+{
+	farrut_sort_unsorted_duplicates(farr_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_random, &farrut_pdq_sort)
+{
+	int          entries[FARRUT_PDQ_NR];
+	unsigned int seed = 1;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++) {
+		seed = (seed * 1103515245U) + 12345U;
+		entries[e] = (int)(seed >> 8);
+	}
+
+	farrut_pdq_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_few_uniques, &farrut_pdq_sort)
+{
+	int          entries[FARRUT_PDQ_NR];
+	unsigned int seed = 2;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++) {
+		seed = (seed * 1103515245U) + 12345U;
+		entries[e] = (int)((seed >> 16) % 4);
+	}
+
+	farrut_pdq_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_sawtooth, &farrut_pdq_sort)
+{
+	int          entries[FARRUT_PDQ_NR];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)(e % 97);
+
+	farrut_pdq_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_large_reverse_sorted, &farrut_pdq_sort)
+{
+	int          entries[FARRUT_PDQ_NR];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)(array_nr(entries) - e);
+
+	farrut_pdq_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_pdq_sort_organ_pipe, &farrut_pdq_sort)
+{
+	int          entries[FARRUT_PDQ_NR];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)umin(e, array_nr(entries) - e);
+
+	farrut_pdq_check(entries, array_nr(entries));
+}
+
+#endif /* defined(CONFIG_KARN_FARR_PDQ_SORT) */
+
+#if defined(CONFIG_KARN_FARR_TIM_SORT)
+
+#define FARRUT_TIM_NR (4096U)
+
+struct farrut_tim_entry {
+	unsigned int key;
+	unsigned int seq;
+};
+
+static int farrut_tim_compare(const char *first, const char *second)
+{
+	unsigned int fst = ((const struct farrut_tim_entry *)first)->key;
+	unsigned int snd = ((const struct farrut_tim_entry *)second)->key;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static void farrut_tim_copy(char *restrict dest, const char *restrict src)
+{
+	*(struct farrut_tim_entry *)dest = *(const struct farrut_tim_entry *)src;
+}
+
+static void farrut_tim_sort_entries(char            *entries,
+                                    size_t           entry_size,
+                                    size_t           entry_nr,
+                                    farr_compare_fn *compare,
+                                    farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_tim_sort(entries, entry_size, entry_nr, compare,
+	                           copy));
+}
+
+/* Sort entries and check they are ordered and stable. */
+static void farrut_tim_check(struct farrut_tim_entry *entries,
+                             unsigned int             nr)
+{
+	unsigned int e;
+
+	for (e = 0; e < nr; e++)
+		entries[e].seq = e;
+
+	farrut_tim_sort_entries((char *)entries, sizeof(entries[0]), nr,
+	                        farrut_tim_compare, farrut_tim_copy);
+
+	for (e = 1; e < nr; e++) {
+		cute_ensure(entries[e - 1].key <= entries[e].key);
+		if (entries[e - 1].key == entries[e].key)
+			cute_ensure(entries[e - 1].seq < entries[e].seq);
+	}
+}
+
+static unsigned int farrut_tim_rand(unsigned int *seed, unsigned int modulo)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return (*seed >> 8) % modulo;
+}
+
+static CUTE_PNP_SUITE(farrut_tim_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_tim_sort_single, &farrut_tim_sort)
+{
+	farrut_sort_single(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_inorder2, &farrut_tim_sort)
+{
+	farrut_sort_inorder2(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_revorder2, &farrut_tim_sort)
+{
+	farrut_sort_revorder2(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_duplicates, &farrut_tim_sort)
+{
+	farrut_sort_duplicates(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_presorted, &farrut_tim_sort)
+{
+	farrut_sort_presorted(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_reverse_sorted, &farrut_tim_sort)
+{
+	farrut_sort_reverse_sorted(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_unsorted, &farrut_tim_sort)
+{
+	farrut_sort_unsorted(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_unsorted_duplicates, &farrut_tim_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_tim_sort_entries);
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_random_stable, &farrut_tim_sort)
+{
+	struct farrut_tim_entry entries[FARRUT_TIM_NR];
+	unsigned int            seed = 1;
+	unsigned int            e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e].key = farrut_tim_rand(&seed, 64);
+
+	farrut_tim_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_appended_tail, &farrut_tim_sort)
+{
+	struct farrut_tim_entry entries[FARRUT_TIM_NR];
+	unsigned int            seed = 2;
+	unsigned int            e;
+
+	for (e = 0; e < (array_nr(entries) * 7) / 8; e++)
+		entries[e].key = e / 4;
+	for (; e < array_nr(entries); e++)
+		entries[e].key = farrut_tim_rand(&seed, array_nr(entries));
+
+	farrut_tim_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_tim_sort_runs, &farrut_tim_sort)
+{
+	struct farrut_tim_entry entries[FARRUT_TIM_NR];
+	unsigned int            e;
+
+	/* Interleave ascending and descending runs of various lengths. */
+	for (e = 0; e < array_nr(entries); e++) {
+		unsigned int run = e / 300;
+
+		if (run & 1)
+			entries[e].key = 1000 - (e % 300);
+		else
+			entries[e].key = (e % 300) * (run + 1);
+	}
+
+	farrut_tim_check(entries, array_nr(entries));
+}
+
+#endif /* defined(CONFIG_KARN_FARR_TIM_SORT) */
+
+#if defined(CONFIG_KARN_FARR_INDIRECT_SORT)
+
+#define FARRUT_INDIRECT_NR (4096U)
+#define FARRUT_COSORT_NR   (1024U)
+
+struct farrut_indirect_record {
+	int          key;
+	unsigned int payload[31];
+};
+
+static uint64_t farrut_indirect_prefix(const char *entry)
+{
+	/* Flip sign bit so that unsigned ordering matches signed ordering. */
+	return (uint64_t)((uint32_t)*(const int *)entry ^ 0x80000000U);
+}
+
+static void farrut_indirect_sort_entries(char            *entries,
+                                         size_t           entry_size,
+                                         size_t           entry_nr,
+                                         farr_compare_fn *compare,
+                                         farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_sort_indirect(entries, entry_size, entry_nr, compare,
+	                                copy, NULL));
+}
+
+static void farrut_indirect_sort_prefixed(char            *entries,
+                                          size_t           entry_size,
+                                          size_t           entry_nr,
+                                          farr_compare_fn *compare,
+                                          farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_sort_indirect(entries, entry_size, entry_nr, compare,
+	                                copy, farrut_indirect_prefix));
+}
+
+static void farrut_indirect_copy_record(char *restrict       dest,
+                                        const char *restrict src)
+{
+	*(struct farrut_indirect_record *)dest =
+		*(const struct farrut_indirect_record *)src;
+}
+
+static void farrut_indirect_copy_uint(char *restrict dest,
+                                      const char *restrict src)
+{
+	*(unsigned int *)dest = *(const unsigned int *)src;
+}
+
+static int farrut_indirect_rand(unsigned int *seed, unsigned int modulo)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return (int)((*seed >> 8) % modulo) - (int)(modulo / 2);
+}
+
+static void farrut_indirect_check_records(farr_prefix_fn *prefix)
+{
+	struct farrut_indirect_record *recs;
+	unsigned int                   seed = 3;
+	unsigned int                   e;
+
+	recs = malloc(FARRUT_INDIRECT_NR * sizeof(*recs));
+	cute_ensure(recs);
+
+	for (e = 0; e < FARRUT_INDIRECT_NR; e++) {
+		unsigned int p;
+
+		recs[e].key = farrut_indirect_rand(&seed, 1024);
+		for (p = 0; p < array_nr(recs[e].payload); p++)
+			recs[e].payload[p] = (unsigned int)recs[e].key + p;
+	}
+
+	cute_ensure(!farr_sort_indirect((char *)recs, sizeof(recs[0]),
+	                                FARRUT_INDIRECT_NR, farrut_compare_min,
+	                                farrut_indirect_copy_record, prefix));
+
+	for (e = 0; e < FARRUT_INDIRECT_NR; e++) {
+		unsigned int p;
+
+		if (e)
+			cute_ensure(recs[e - 1].key <= recs[e].key);
+		for (p = 0; p < array_nr(recs[e].payload); p++)
+			cute_ensure(recs[e].payload[p] ==
+			            (unsigned int)recs[e].key + p);
+	}
+
+	free(recs);
+}
+
+static CUTE_PNP_SUITE(farrut_indirect_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_indirect_sort_single, &farrut_indirect_sort)
+{
+	farrut_sort_single(farrut_indirect_sort_entries);
+	farrut_sort_single(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_inorder2, &farrut_indirect_sort)
+{
+	farrut_sort_inorder2(farrut_indirect_sort_entries);
+	farrut_sort_inorder2(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_revorder2, &farrut_indirect_sort)
+{
+	farrut_sort_revorder2(farrut_indirect_sort_entries);
+	farrut_sort_revorder2(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_duplicates, &farrut_indirect_sort)
+{
+	farrut_sort_duplicates(farrut_indirect_sort_entries);
+	farrut_sort_duplicates(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_presorted, &farrut_indirect_sort)
+{
+	farrut_sort_presorted(farrut_indirect_sort_entries);
+	farrut_sort_presorted(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_reverse_sorted, &farrut_indirect_sort)
+{
+	farrut_sort_reverse_sorted(farrut_indirect_sort_entries);
+	farrut_sort_reverse_sorted(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_unsorted, &farrut_indirect_sort)
+{
+	farrut_sort_unsorted(farrut_indirect_sort_entries);
+	farrut_sort_unsorted(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_unsorted_duplicates, &farrut_indirect_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_indirect_sort_entries);
+	farrut_sort_unsorted_duplicates(farrut_indirect_sort_prefixed);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_records, &farrut_indirect_sort)
+{
+	farrut_indirect_check_records(NULL);
+}
+
+CUTE_PNP_TEST(farrut_indirect_sort_prefixed_records, &farrut_indirect_sort)
+{
+	farrut_indirect_check_records(farrut_indirect_prefix);
+}
+
+CUTE_PNP_TEST(farrut_indirect_cosort, &farrut_indirect_sort)
+{
+	int                            keys[FARRUT_COSORT_NR];
+	unsigned int                   idx[FARRUT_COSORT_NR];
+	struct farrut_indirect_record  recs[FARRUT_COSORT_NR];
+	const struct farr_cosort_array plds[] = {
+		{
+			.cosort_entries = (char *)idx,
+			.cosort_size    = sizeof(idx[0]),
+			.cosort_copy    = farrut_indirect_copy_uint
+		},
+		{
+			.cosort_entries = (char *)recs,
+			.cosort_size    = sizeof(recs[0]),
+			.cosort_copy    = farrut_indirect_copy_record
+		}
+	};
+	int                            orig[FARRUT_COSORT_NR];
+	unsigned int                   seed = 4;
+	unsigned int                   e;
+
+	for (e = 0; e < FARRUT_COSORT_NR; e++) {
+		keys[e] = farrut_indirect_rand(&seed, 256);
+		orig[e] = keys[e];
+		idx[e] = e;
+		recs[e].key = keys[e];
+		recs[e].payload[0] = e;
+	}
+
+	cute_ensure(!farr_cosort((char *)keys, sizeof(keys[0]),
+	                         FARRUT_COSORT_NR, farrut_compare_min,
+	                         farrut_copy, farrut_indirect_prefix, plds,
+	                         array_nr(plds)));
+
+	for (e = 0; e < FARRUT_COSORT_NR; e++) {
+		if (e)
+			cute_ensure(keys[e - 1] <= keys[e]);
+		cute_ensure(orig[idx[e]] == keys[e]);
+		cute_ensure(recs[e].key == keys[e]);
+		cute_ensure(recs[e].payload[0] == idx[e]);
+	}
+}
+
+#endif /* defined(CONFIG_KARN_FARR_INDIRECT_SORT) */
+
+#if defined(CONFIG_KARN_FARR_SELECT)
+
+#define FARRUT_SELECT_NR (1024U)
+
+static int farrut_select_rand(unsigned int *seed, unsigned int modulo)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return (int)((*seed >> 8) % modulo);
+}
+
+static int farrut_qsort_compare(const void *first, const void *second)
+{
+	return farrut_compare_min(first, second);
+}
+
+/* Select every nth entry of entries and check against a sorted copy. */
+static void farrut_select_check(const int *entries, unsigned int nr)
+{
+	int          sorted[nr];
+	int          sel[nr];
+	unsigned int n;
+
+	memcpy(sorted, entries, sizeof(sorted));
+	qsort(sorted, nr, sizeof(sorted[0]), farrut_qsort_compare);
+
+	for (n = 0; n < nr; n++) {
+		unsigned int  e;
+		int          *ent;
+
+		memcpy(sel, entries, sizeof(sel));
+
+		ent = (int *)farr_select((char *)sel, sizeof(sel[0]), nr, n,
+		                         farrut_compare_min, farrut_copy);
+		cute_ensure(ent == &sel[n]);
+		cute_ensure(*ent == sorted[n]);
+
+		for (e = 0; e < n; e++)
+			cute_ensure(sel[e] <= *ent);
+		for (e = n + 1; e < nr; e++)
+			cute_ensure(sel[e] >= *ent);
+	}
+}
+
+static CUTE_PNP_SUITE(farrut_select, &farrut);
+
+CUTE_PNP_TEST(farrut_select_single, &farrut_select)
+{
+	const int entries[] = { 0 };
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_select_duplicates, &farrut_select)
+{
+	const int entries[] = { 2, 0, 2, 1, 0, 2, 1, 1, 0, 2, 2, 0, 1 };
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_select_presorted, &farrut_select)
+{
+	int          entries[100];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)e;
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_select_reverse_sorted, &farrut_select)
+{
+	int          entries[100];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)(array_nr(entries) - e);
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_select_organ_pipe, &farrut_select)
+{
+	int          entries[257];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)umin(e, array_nr(entries) - e);
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_select_random, &farrut_select)
+{
+	int          entries[FARRUT_SELECT_NR];
+	unsigned int seed = 5;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = farrut_select_rand(&seed, 1U << 20);
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_select_few_uniques, &farrut_select)
+{
+	int          entries[FARRUT_SELECT_NR];
+	unsigned int seed = 6;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = farrut_select_rand(&seed, 4);
+
+	farrut_select_check(entries, array_nr(entries));
+}
+
+CUTE_PNP_TEST(farrut_partial_sort, &farrut_select)
+{
+	int          entries[FARRUT_SELECT_NR];
+	int          sorted[FARRUT_SELECT_NR];
+	int          part[FARRUT_SELECT_NR];
+	unsigned int seed = 7;
+	unsigned int k;
+
+	for (k = 0; k < array_nr(entries); k++)
+		entries[k] = farrut_select_rand(&seed, 512);
+
+	memcpy(sorted, entries, sizeof(sorted));
+	qsort(sorted, array_nr(sorted), sizeof(sorted[0]),
+	      farrut_qsort_compare);
+
+	for (k = 1; k <= array_nr(entries); k += 37) {
+		unsigned int e;
+
+		memcpy(part, entries, sizeof(part));
+
+		farr_partial_sort((char *)part, sizeof(part[0]),
+		                  array_nr(part), k, farrut_compare_min,
+		                  farrut_copy);
+
+		for (e = 0; e < k; e++)
+			cute_ensure(part[e] == sorted[e]);
+		for (; e < array_nr(part); e++)
+			cute_ensure(part[e] >= sorted[k - 1]);
+	}
+
+	memcpy(part, entries, sizeof(part));
+	farr_partial_sort((char *)part, sizeof(part[0]), array_nr(part),
+	                  array_nr(part), farrut_compare_min, farrut_copy);
+	cute_ensure(!memcmp(part, sorted, sizeof(part)));
+}
+
+CUTE_PNP_TEST(farrut_top_k, &farrut_select)
+{
+	int          entries[FARRUT_SELECT_NR];
+	int          orig[FARRUT_SELECT_NR];
+	int          sorted[FARRUT_SELECT_NR];
+	int          top[FARRUT_SELECT_NR];
+	unsigned int seed = 8;
+	unsigned int k;
+
+	for (k = 0; k < array_nr(entries); k++)
+		entries[k] = farrut_select_rand(&seed, 512);
+
+	memcpy(orig, entries, sizeof(orig));
+	memcpy(sorted, entries, sizeof(sorted));
+	qsort(sorted, array_nr(sorted), sizeof(sorted[0]),
+	      farrut_qsort_compare);
+
+	for (k = 1; k <= array_nr(entries); k += 37) {
+		unsigned int e;
+
+		farr_top_k((char *)entries, sizeof(entries[0]),
+		           array_nr(entries), (char *)top, k,
+		           farrut_compare_min, farrut_copy);
+
+		for (e = 0; e < k; e++)
+			cute_ensure(top[e] ==
+			            sorted[array_nr(sorted) - 1 - e]);
+	}
+
+	farr_top_k((char *)entries, sizeof(entries[0]), array_nr(entries),
+	           (char *)top, array_nr(top), farrut_compare_min,
+	           farrut_copy);
+	for (k = 0; k < array_nr(top); k++)
+		cute_ensure(top[k] == sorted[array_nr(sorted) - 1 - k]);
+
+	cute_ensure(!memcmp(entries, orig, sizeof(entries)));
+}
+
+#endif /* defined(CONFIG_KARN_FARR_SELECT) */
+
+#if defined(CONFIG_KARN_FARR_TYPED_SORT)
+
+#define FARRUT_TYPED_NR (1024U)
+
+/* Wrappers allowing to run typed sorts against common test datasets. */
+static void farrut_uint32_quick_sort(char            *entries,
+                                     size_t           entry_size __unused,
+                                     size_t           entry_nr,
+                                     farr_compare_fn *compare __unused,
+                                     farr_copy_fn    *copy __unused)
+{
+	farr_uint32_quick_sort((uint32_t *)entries, entry_nr);
+}
+
+static void farrut_uint32_intro_sort(char            *entries,
+                                     size_t           entry_size __unused,
+                                     size_t           entry_nr,
+                                     farr_compare_fn *compare __unused,
+                                     farr_copy_fn    *copy __unused)
+{
+	farr_uint32_intro_sort((uint32_t *)entries, entry_nr);
+}
+
+static void farrut_uint32_pdq_sort(char            *entries,
+                                   size_t           entry_size __unused,
+                                   size_t           entry_nr,
+                                   farr_compare_fn *compare __unused,
+                                   farr_copy_fn    *copy __unused)
+{
+	farr_uint32_pdq_sort((uint32_t *)entries, entry_nr);
+}
+
+/* Generate pseudo random keys with lots of duplicates. */
+static unsigned int farrut_typed_rand(unsigned int *seed)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return (*seed >> 16) % (FARRUT_TYPED_NR / 2);
+}
+
+static CUTE_PNP_SUITE(farrut_typed_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_uint32_quick_sort_presorted, &farrut_typed_sort)
+{
+	farrut_sort_presorted(farrut_uint32_quick_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_quick_sort_reverse_sorted, &farrut_typed_sort)
+{
+	farrut_sort_reverse_sorted(farrut_uint32_quick_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_quick_sort_unsorted_duplicates, &farrut_typed_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_uint32_quick_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_intro_sort_single, &farrut_typed_sort)
+{
+	farrut_sort_single(farrut_uint32_intro_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_intro_sort_revorder2, &farrut_typed_sort)
+{
+	farrut_sort_revorder2(farrut_uint32_intro_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_intro_sort_unsorted_duplicates, &farrut_typed_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_uint32_intro_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_pdq_sort_single, &farrut_typed_sort)
+{
+	farrut_sort_single(farrut_uint32_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_pdq_sort_reverse_sorted, &farrut_typed_sort)
+{
+	farrut_sort_reverse_sorted(farrut_uint32_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint32_pdq_sort_unsorted_duplicates, &farrut_typed_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_uint32_pdq_sort);
+}
+
+CUTE_PNP_TEST(farrut_uint64_intro_sort_random, &farrut_typed_sort)
+{
+	uint64_t     entries[FARRUT_TYPED_NR];
+	unsigned int seed = 1;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (uint64_t)farrut_typed_rand(&seed) << 32;
+
+	farr_uint64_intro_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_int64_quick_sort_random, &farrut_typed_sort)
+{
+	int64_t      entries[FARRUT_TYPED_NR];
+	unsigned int seed = 2;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int64_t)farrut_typed_rand(&seed) -
+		             (int64_t)(FARRUT_TYPED_NR / 4);
+
+	farr_int64_quick_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_double_intro_sort_random, &farrut_typed_sort)
+{
+	double       entries[FARRUT_TYPED_NR];
+	unsigned int seed = 3;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (double)farrut_typed_rand(&seed) / 7.0;
+
+	farr_double_intro_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_uint64_pdq_sort_random, &farrut_typed_sort)
+{
+	uint64_t     entries[FARRUT_TYPED_NR];
+	unsigned int seed = 4;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (uint64_t)farrut_typed_rand(&seed) << 32;
+
+	farr_uint64_pdq_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_int32_pdq_sort_random, &farrut_typed_sort)
+{
+	int32_t      entries[FARRUT_TYPED_NR];
+	unsigned int seed = 5;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int32_t)farrut_typed_rand(&seed) -
+		             (int32_t)(FARRUT_TYPED_NR / 4);
+
+	farr_int32_pdq_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_float_intro_sort_random, &farrut_typed_sort)
+{
+	float        entries[FARRUT_TYPED_NR];
+	unsigned int seed = 6;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = ((float)farrut_typed_rand(&seed) - 100.0f) / 7.0f;
+
+	farr_float_intro_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_uint32_quick_sort_random, &farrut_typed_sort)
+{
+	uint32_t     entries[FARRUT_TYPED_NR];
+	unsigned int seed = 7;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = farrut_typed_rand(&seed);
+
+	farr_uint32_quick_sort(entries, array_nr(entries));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_ptr_intro_sort_reverse_sorted, &farrut_typed_sort)
+{
+	char         area[FARRUT_TYPED_NR];
+	void        *entries[FARRUT_TYPED_NR];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = &area[array_nr(area) - 1 - e];
+
+	farr_ptr_intro_sort(entries, array_nr(entries));
+
+	for (e = 0; e < array_nr(entries); e++)
+		cute_ensure(entries[e] == &area[e]);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_TYPED_SORT) */
+
+#if defined(CONFIG_KARN_FARR_NETWORK_SORT)
+
+static unsigned int farrut_network_rand(unsigned int *seed)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return *seed;
+}
+
+#define FARRUT_NETWORK_QSORT_COMPARE(_name, _type) \
+	static int farrut_network_ ## _name ## _compare(const void *first, \
+	                                                const void *second) \
+	{ \
+		_type fst = *(const _type *)first; \
+		_type snd = *(const _type *)second; \
+		\
+		return (fst > snd) - (fst < snd); \
+	}
+
+FARRUT_NETWORK_QSORT_COMPARE(uint32, uint32_t)
+FARRUT_NETWORK_QSORT_COMPARE(int32, int32_t)
+FARRUT_NETWORK_QSORT_COMPARE(float, float)
+FARRUT_NETWORK_QSORT_COMPARE(uint64, uint64_t)
+
+/*
+ * Sort every possible number of keys, twice: once with keys spread over the
+ * whole range, once with lots of duplicates. Results are checked against
+ * qsort().
+ */
+#define FARRUT_NETWORK_CHECK(_name, _type, _key) \
+	do { \
+		_type        keys[FARR_NETWORK_SORT_MAX]; \
+		_type        check[FARR_NETWORK_SORT_MAX]; \
+		unsigned int seed = 1; \
+		unsigned int mod; \
+		\
+		for (mod = 0; mod < 2; mod++) { \
+			unsigned int nr; \
+			\
+			for (nr = 0; nr <= FARR_NETWORK_SORT_MAX; nr++) { \
+				unsigned int k; \
+				\
+				for (k = 0; k < nr; k++) { \
+					unsigned int r; \
+					\
+					r = farrut_network_rand(&seed); \
+					if (mod) \
+						r %= 7; \
+					keys[k] = _key(r); \
+				} \
+				\
+				memcpy(check, keys, nr * sizeof(keys[0])); \
+				qsort(check, nr, sizeof(check[0]), \
+				      farrut_network_ ## _name ## _compare); \
+				\
+				farr_ ## _name ## _network_sort(keys, nr); \
+				\
+				cute_ensure(!memcmp(keys, check, \
+				                    nr * sizeof(keys[0]))); \
+			} \
+		} \
+	} while (0)
+
+#define farrut_network_uint32_key(_r) ((uint32_t)(_r) | 0x80000000U)
+#define farrut_network_int32_key(_r)  ((int32_t)(_r))
+#define farrut_network_float_key(_r)  ((float)(int32_t)(_r) / 3.0f)
+#define farrut_network_uint64_key(_r) \
+	(((uint64_t)(_r) << 33) | ((uint64_t)(_r) & 1))
+
+static CUTE_PNP_SUITE(farrut_network_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_uint32_network_sort, &farrut_network_sort)
+{
+	FARRUT_NETWORK_CHECK(uint32, uint32_t, farrut_network_uint32_key);
+}
+
+CUTE_PNP_TEST(farrut_int32_network_sort, &farrut_network_sort)
+{
+	FARRUT_NETWORK_CHECK(int32, int32_t, farrut_network_int32_key);
+}
+
+CUTE_PNP_TEST(farrut_float_network_sort, &farrut_network_sort)
+{
+	FARRUT_NETWORK_CHECK(float, float, farrut_network_float_key);
+}
+
+CUTE_PNP_TEST(farrut_uint64_network_sort, &farrut_network_sort)
+{
+	FARRUT_NETWORK_CHECK(uint64, uint64_t, farrut_network_uint64_key);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_NETWORK_SORT) */
+
+#if defined(CONFIG_KARN_FARR_RADIX_SORT)
+
+#define FARRUT_RADIX_NR (1024U)
+
+/* Map signed integer to unsigned key preserving ordering. */
+static uint64_t farrut_radix_key(const char *entry)
+{
+	return (uint32_t)*(int *)entry ^ (1U << 31);
+}
+
+static void farrut_lsd_radix_sort(char            *entries,
+                                  size_t           entry_size,
+                                  size_t           entry_nr,
+                                  farr_compare_fn *compare __unused,
+                                  farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_lsd_radix_sort(entries, entry_size, entry_nr,
+	                                 sizeof(int), farrut_radix_key, copy,
+	                                 NULL));
+}
+
+static void farrut_msd_radix_sort(char            *entries,
+                                  size_t           entry_size,
+                                  size_t           entry_nr,
+                                  farr_compare_fn *compare,
+                                  farr_copy_fn    *copy)
+{
+	farr_msd_radix_sort(entries, entry_size, entry_nr, sizeof(int),
+	                    farrut_radix_key, compare, copy);
+}
+
+/* Generate pseudo random signed keys with some duplicates. */
+static int farrut_radix_rand(unsigned int *seed)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return (int)(*seed >> 8) - (1 << 23);
+}
+
+static void farrut_radix_sort_random(farrut_sort_fn *sort, unsigned int seed)
+{
+	int          entries[FARRUT_RADIX_NR];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = farrut_radix_rand(&seed);
+
+	sort((char *)entries, sizeof(entries[0]), array_nr(entries),
+	     farrut_compare_min, farrut_copy);
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+static CUTE_PNP_SUITE(farrut_radix_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_lsd_radix_sort_single, &farrut_radix_sort)
+{
+	farrut_sort_single(farrut_lsd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_lsd_radix_sort_revorder2, &farrut_radix_sort)
+{
+	farrut_sort_revorder2(farrut_lsd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_lsd_radix_sort_presorted, &farrut_radix_sort)
+{
+	farrut_sort_presorted(farrut_lsd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_lsd_radix_sort_unsorted_duplicates, &farrut_radix_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_lsd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_lsd_radix_sort_random, &farrut_radix_sort)
+{
+	farrut_radix_sort_random(farrut_lsd_radix_sort, 1);
+}
+
+CUTE_PNP_TEST(farrut_lsd_radix_sort_stable, &farrut_radix_sort)
+{
+	int          entries[FARRUT_RADIX_NR];
+	int          scratch[FARRUT_RADIX_NR];
+	unsigned int e;
+
+	/* Sort on upper 16 bits only, lower ones record original order. */
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (int)((((array_nr(entries) - e) % 7) << 16) | e);
+
+	cute_ensure(!farr_lsd_radix_sort((char *)entries, sizeof(entries[0]),
+	                                 array_nr(entries), 3,
+	                                 farrut_radix_key, farrut_copy,
+	                                 (char *)scratch));
+
+	for (e = 1; e < array_nr(entries); e++) {
+		cute_ensure((entries[e - 1] >> 16) <= (entries[e] >> 16));
+		if ((entries[e - 1] >> 16) == (entries[e] >> 16))
+			cute_ensure((entries[e - 1] & 0xffff) <
+			            (entries[e] & 0xffff));
+	}
+}
+
+CUTE_PNP_TEST(farrut_msd_radix_sort_single, &farrut_radix_sort)
+{
+	farrut_sort_single(farrut_msd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_msd_radix_sort_reverse_sorted, &farrut_radix_sort)
+{
+	farrut_sort_reverse_sorted(farrut_msd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_msd_radix_sort_unsorted_duplicates, &farrut_radix_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_msd_radix_sort);
+}
+
+CUTE_PNP_TEST(farrut_msd_radix_sort_random, &farrut_radix_sort)
+{
+	farrut_radix_sort_random(farrut_msd_radix_sort, 2);
+}
+
+CUTE_PNP_TEST(farrut_uint32_radix_sort_random, &farrut_radix_sort)
+{
+	uint32_t     entries[FARRUT_RADIX_NR];
+	unsigned int seed = 3;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = (uint32_t)farrut_radix_rand(&seed);
+
+	cute_ensure(!farr_uint32_radix_sort(entries, array_nr(entries), NULL));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+CUTE_PNP_TEST(farrut_uint64_radix_sort_random, &farrut_radix_sort)
+{
+	uint64_t     entries[FARRUT_RADIX_NR];
+	uint64_t     scratch[FARRUT_RADIX_NR];
+	unsigned int seed = 4;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = ((uint64_t)farrut_radix_rand(&seed) << 32) |
+		             (uint32_t)farrut_radix_rand(&seed);
+
+	cute_ensure(!farr_uint64_radix_sort(entries, array_nr(entries),
+	                                    scratch));
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_RADIX_SORT) */
+
+#if defined(CONFIG_KARN_FARR_COUNTING_SORT)
+
+#define FARRUT_COUNTING_NR  (1024U)
+#define FARRUT_COUNTING_MIN (-16)
+#define FARRUT_COUNTING_MAX (15)
+
+/* Map bounded signed integer to unsigned key preserving ordering. */
+static uint64_t farrut_counting_key(const char *entry)
+{
+	return (uint64_t)(*(int *)entry - FARRUT_COUNTING_MIN);
+}
+
+/* Map signed integer to unsigned key preserving ordering. */
+static uint64_t farrut_counting_full_key(const char *entry)
+{
+	return (uint32_t)*(int *)entry ^ (1U << 31);
+}
+
+/* Generate pseudo random signed keys with some duplicates. */
+static int farrut_counting_rand(unsigned int *seed)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return (int)(*seed >> 8) - (1 << 23);
+}
+
+static void farrut_counting_sort_random(farrut_sort_fn *sort,
+                                        unsigned int    seed)
+{
+	int          entries[FARRUT_COUNTING_NR];
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++)
+		entries[e] = farrut_counting_rand(&seed);
+
+	sort((char *)entries, sizeof(entries[0]), array_nr(entries),
+	     farrut_compare_min, farrut_copy);
+
+	for (e = 1; e < array_nr(entries); e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+}
+
+static void farrut_counting_sort(char            *entries,
+                                 size_t           entry_size,
+                                 size_t           entry_nr,
+                                 farr_compare_fn *compare __unused,
+                                 farr_copy_fn    *copy)
+{
+	/* Test vectors hold keys ranging from 0 to 13. */
+	cute_ensure(!farr_counting_sort(entries, entry_size, entry_nr,
+	                                14 - FARRUT_COUNTING_MIN,
+	                                farrut_counting_key, copy, NULL));
+}
+
+static void farrut_bucket_sort(char            *entries,
+                               size_t           entry_size,
+                               size_t           entry_nr,
+                               farr_compare_fn *compare,
+                               farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_bucket_sort(entries, entry_size, entry_nr, 0,
+	                              UINT32_MAX, farrut_counting_full_key,
+	                              compare, copy, NULL));
+}
+
+static void farrut_range_sort(char            *entries,
+                              size_t           entry_size,
+                              size_t           entry_nr,
+                              farr_compare_fn *compare,
+                              farr_copy_fn    *copy)
+{
+	farr_range_sort(entries, entry_size, entry_nr,
+	                farrut_counting_full_key, compare, copy, NULL);
+}
+
+/*
+ * Check sorting of keys within [FARRUT_COUNTING_MIN, FARRUT_COUNTING_MAX]:
+ * upper 16 bits hold key, lower ones record original order.
+ */
+static void farrut_counting_check_stable(farrut_sort_fn *sort)
+{
+	int          entries[FARRUT_COUNTING_NR];
+	unsigned int seed = 1;
+	unsigned int e;
+
+	for (e = 0; e < array_nr(entries); e++) {
+		int k = (farrut_counting_rand(&seed) & 0x1f) +
+		        FARRUT_COUNTING_MIN;
+
+		entries[e] = (int)((unsigned int)k << 16) | (int)e;
+	}
+
+	sort((char *)entries, sizeof(entries[0]), array_nr(entries),
+	     farrut_compare_min, farrut_copy);
+
+	for (e = 1; e < array_nr(entries); e++) {
+		cute_ensure((entries[e - 1] >> 16) <= (entries[e] >> 16));
+		if ((entries[e - 1] >> 16) == (entries[e] >> 16))
+			cute_ensure((entries[e - 1] & 0xffff) <
+			            (entries[e] & 0xffff));
+	}
+}
+
+static uint64_t farrut_counting_stable_key(const char *entry)
+{
+	return (uint64_t)((*(int *)entry >> 16) - FARRUT_COUNTING_MIN);
+}
+
+/* Compare keys only so that original order bits cannot hide instability. */
+static int farrut_counting_stable_compare(const char *first,
+                                          const char *second)
+{
+	return (*(int *)first >> 16) - (*(int *)second >> 16);
+}
+
+static void farrut_counting_stable_sort(char            *entries,
+                                        size_t           entry_size,
+                                        size_t           entry_nr,
+                                        farr_compare_fn *compare __unused,
+                                        farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_counting_sort(entries, entry_size, entry_nr,
+	                                FARRUT_COUNTING_MAX -
+	                                FARRUT_COUNTING_MIN + 1,
+	                                farrut_counting_stable_key, copy,
+	                                NULL));
+}
+
+static void farrut_bucket_stable_sort(char            *entries,
+                                      size_t           entry_size,
+                                      size_t           entry_nr,
+                                      farr_compare_fn *compare __unused,
+                                      farr_copy_fn    *copy)
+{
+	cute_ensure(!farr_bucket_sort(entries, entry_size, entry_nr, 0,
+	                              FARRUT_COUNTING_MAX - FARRUT_COUNTING_MIN,
+	                              farrut_counting_stable_key,
+	                              farrut_counting_stable_compare, copy,
+	                              NULL));
+}
+
+static void farrut_range_stable_sort(char            *entries,
+                                     size_t           entry_size,
+                                     size_t           entry_nr,
+                                     farr_compare_fn *compare __unused,
+                                     farr_copy_fn    *copy)
+{
+	farr_range_sort(entries, entry_size, entry_nr,
+	                farrut_counting_stable_key,
+	                farrut_counting_stable_compare, copy, NULL);
+}
+
+static CUTE_PNP_SUITE(farrut_bounded_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_counting_sort_single, &farrut_bounded_sort)
+{
+	farrut_sort_single(farrut_counting_sort);
+}
+
+CUTE_PNP_TEST(farrut_counting_sort_revorder2, &farrut_bounded_sort)
+{
+	farrut_sort_revorder2(farrut_counting_sort);
+}
+
+CUTE_PNP_TEST(farrut_counting_sort_reverse_sorted, &farrut_bounded_sort)
+{
+	farrut_sort_reverse_sorted(farrut_counting_sort);
+}
+
+CUTE_PNP_TEST(farrut_counting_sort_unsorted_duplicates, &farrut_bounded_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_counting_sort);
+}
+
+CUTE_PNP_TEST(farrut_counting_sort_stable, &farrut_bounded_sort)
+{
+	farrut_counting_check_stable(farrut_counting_stable_sort);
+}
+
+CUTE_PNP_TEST(farrut_bucket_sort_single, &farrut_bounded_sort)
+{
+	farrut_sort_single(farrut_bucket_sort);
+}
+
+CUTE_PNP_TEST(farrut_bucket_sort_reverse_sorted, &farrut_bounded_sort)
+{
+	farrut_sort_reverse_sorted(farrut_bucket_sort);
+}
+
+CUTE_PNP_TEST(farrut_bucket_sort_unsorted_duplicates, &farrut_bounded_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_bucket_sort);
+}
+
+CUTE_PNP_TEST(farrut_bucket_sort_random, &farrut_bounded_sort)
+{
+	farrut_counting_sort_random(farrut_bucket_sort, 1);
+}
+
+CUTE_PNP_TEST(farrut_bucket_sort_stable, &farrut_bounded_sort)
+{
+	farrut_counting_check_stable(farrut_bucket_stable_sort);
+}
+
+CUTE_PNP_TEST(farrut_range_sort_unsorted_duplicates, &farrut_bounded_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_range_sort);
+}
+
+CUTE_PNP_TEST(farrut_range_sort_random, &farrut_bounded_sort)
+{
+	farrut_counting_sort_random(farrut_range_sort, 2);
+}
+
+CUTE_PNP_TEST(farrut_range_sort_stable, &farrut_bounded_sort)
+{
+	farrut_counting_check_stable(farrut_range_stable_sort);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_COUNTING_SORT) */
+
+#if defined(CONFIG_KARN_FARR_PARALLEL_SORT)
+
+#define FARRUT_PARALLEL_NR      (1U << 16)
+#define FARRUT_PARALLEL_THREADS (4U)
+
+static void farrut_parallel_sort_threads(char            *entries,
+                                         size_t           entry_size,
+                                         size_t           entry_nr,
+                                         farr_compare_fn *compare,
+                                         farr_copy_fn    *copy)
+{
+	farr_parallel_sort(entries, entry_size, entry_nr, compare, copy,
+	                   FARRUT_PARALLEL_THREADS);
+}
+
+static void farrut_parallel_sort_large(unsigned int modulo)
+{
+	int          *entries;
+	unsigned int  seed = 1;
+	unsigned int  e;
+
+	entries = malloc(FARRUT_PARALLEL_NR * sizeof(*entries));
+	cute_ensure(entries);
+
+	for (e = 0; e < FARRUT_PARALLEL_NR; e++) {
+		seed = (seed * 1103515245U) + 12345U;
+		entries[e] = (int)((seed >> 8) % modulo);
+	}
+
+	farrut_parallel_sort_threads((char *)entries, sizeof(*entries),
+	                             FARRUT_PARALLEL_NR, farrut_compare_min,
+	                             farrut_copy);
+
+	for (e = 1; e < FARRUT_PARALLEL_NR; e++)
+		cute_ensure(entries[e - 1] <= entries[e]);
+
+	free(entries);
+}
+
+static CUTE_PNP_SUITE(farrut_parallel_sort, &farrut);
+
+CUTE_PNP_TEST(farrut_parallel_sort_single, &farrut_parallel_sort)
+{
+	farrut_sort_single(farrut_parallel_sort_threads);
+}
+
+CUTE_PNP_TEST(farrut_parallel_sort_reverse_sorted, &farrut_parallel_sort)
+{
+	farrut_sort_reverse_sorted(farrut_parallel_sort_threads);
+}
+
+CUTE_PNP_TEST(farrut_parallel_sort_unsorted_duplicates, &farrut_parallel_sort)
+{
+	farrut_sort_unsorted_duplicates(farrut_parallel_sort_threads);
+}
+
+CUTE_PNP_TEST(farrut_parallel_sort_random, &farrut_parallel_sort)
+{
+	farrut_parallel_sort_large(1U << 24);
+}
+
+CUTE_PNP_TEST(farrut_parallel_sort_few_uniques, &farrut_parallel_sort)
+{
+	farrut_parallel_sort_large(3);
+}
+
+CUTE_PNP_TEST(farrut_parallel_sort_all_equal, &farrut_parallel_sort)
+{
+	farrut_parallel_sort_large(1);
+}
+
+CUTE_PNP_TEST(farrut_parallel_sort_presorted, &farrut_parallel_sort)
+{
+	int          *entries;
+	unsigned int  e;
+
+	entries = malloc(FARRUT_PARALLEL_NR * sizeof(*entries));
+	cute_ensure(entries);
+
+	for (e = 0; e < FARRUT_PARALLEL_NR; e++)
+		entries[e] = (int)e;
+
+	farrut_parallel_sort_threads((char *)entries, sizeof(*entries),
+	                             FARRUT_PARALLEL_NR, farrut_compare_min,
+	                             farrut_copy);
+
+	for (e = 0; e < FARRUT_PARALLEL_NR; e++)
+		cute_ensure(entries[e] == (int)e);
+
+	free(entries);
+}
+
+#endif /* defined(CONFIG_KARN_FARR_PARALLEL_SORT) */
@@ -29,6 +29,8 @@
 #include <karn/fbnr_heap.h>
 #include <cute/cute.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
 #include <string.h>
 
 static struct fbnr_heap fbnrhut_heap;
@@ -590,6 +592,46 @@ CUTE_PNP_TEST(fbnrhut_extract_mixorder20, &fbnrhut_extract)
 	fbnrhut_check_extract(&fbnrhut_heap, nodes, array_nr(nodes));
 }
 
+/**
+ * Replace first node of a fbnr_heap with nodes ordered anywhere then check
+ * extraction order
+ *
+ * @ingroup fbnrhut
+ */
+CUTE_PNP_TEST(fbnrhut_extract_replace, &fbnrhut_extract)
+{
+	int nodes[] = { 20, 19, 18, 17, 16, 16, 8, 4, 7, 5,
+	                1, 3, 2, 4, 10, 11, 12, 13, 19 };
+	int repl[] = { 0, 14, 21, 3, 9, 16, 2 };
+	int check[array_nr(nodes)];
+	int n, r;
+
+	memcpy(check, nodes, sizeof(nodes));
+
+	for (n = 0; n < (int)array_nr(nodes); n++)
+		fbnr_heap_insert(&fbnrhut_heap, (char *)&nodes[n]);
+
+	for (r = 0; r < (int)array_nr(repl); r++) {
+		/* Replace lowest of remaining check entries. */
+		qsort(check, array_nr(check), sizeof(check[0]),
+		      fbnrhut_qsort_compare_min);
+		cute_ensure(*(int *)fbnr_heap_peek(&fbnrhut_heap) == check[0]);
+
+		fbnr_heap_replace(&fbnrhut_heap, (char *)&repl[r]);
+		check[0] = repl[r];
+		fbnrhut_check_nodes(&fbnrhut_heap, array_nr(nodes));
+	}
+
+	qsort(check, array_nr(check), sizeof(check[0]),
+	      fbnrhut_qsort_compare_min);
+	for (n = 0; n < (int)array_nr(nodes); n++) {
+		int curr = -1;
+
+		fbnr_heap_extract(&fbnrhut_heap, (char *)&curr);
+		cute_ensure(curr == check[n]);
+	}
+}
+
 static struct fbnr_heap *fbnrhut_created;
 
 static void
@@ -791,6 +833,32 @@ CUTE_PNP_TEST(fbnrhut_build_mixorder20, &fbnrhut_build)
 	fbnrhut_check_build(nodes, array_nr(nodes));
 }
 
+#if SIZE_MAX > UINT_MAX
+
+static CUTE_PNP_SUITE(fbnrhut_index, &fbnrhut);
+
+/**
+ * Check underlying tree index arithmetic holds for nodes located beyond
+ * UINT_MAX
+ *
+ * @ingroup fbnrhut
+ */
+CUTE_PNP_TEST(fbnrhut_wide_index, &fbnrhut_index)
+{
+	size_t idx = ((size_t)1 << 40) + 5;
+
+	cute_ensure(fabs_tree_index_depth(idx) == 40);
+	cute_ensure(fabs_tree_parent_index(fabs_tree_left_child_index(idx)) ==
+	            idx);
+	cute_ensure(fabs_tree_parent_index(fabs_tree_right_child_index(idx)) ==
+	            idx);
+	cute_ensure(fabs_tree_ancestor_index(idx, 1) ==
+	            fabs_tree_parent_index(idx));
+	cute_ensure(fabs_tree_ancestor_index(idx, 40) == FABS_TREE_ROOT_INDEX);
+}
+
+#endif /* SIZE_MAX > UINT_MAX */
+
 #if defined(CONFIG_KARN_FBNR_HEAP_SORT)
 
 static CUTE_PNP_SUITE(fbnrhut_sort, &fbnrhut);
@@ -905,3 +973,144 @@ CUTE_PNP_TEST(fbnrhut_sort_unsorted_duplicates, &fbnrhut_sort)
 }
 
 #endif /* defined(CONFIG_KARN_FBNR_HEAP_SORT) */
+
+#if defined(CONFIG_KARN_FBNR_HEAP_GROW)
+
+/* Large enough for nodes storage to cross FARR_MMAP_THRESHOLD. */
+#define FBNRHUT_GROW_NR (100000U)
+
+static CUTE_PNP_SUITE(fbnrhut_grow, &fbnrhut);
+
+/**
+ * Grow a heap from a tiny capacity till node storage gets memory mapped then
+ * extract all nodes while shrinking it back
+ *
+ * @ingroup fbnrhut
+ */
+CUTE_PNP_TEST(fbnrhut_grow_shrink, &fbnrhut_grow)
+{
+	struct fbnr_heap heap;
+	unsigned int    n;
+	int             prev = -1;
+
+	cute_ensure(!fbnr_heap_init_grow(&heap, sizeof(int), 4,
+	                                 fbnrhut_compare_min, fbnrhut_copy));
+	cute_ensure(fbnr_heap_nr(&heap) == 4);
+
+	for (n = 0; n < FBNRHUT_GROW_NR; n++) {
+		int key = (int)((n * 7919U) % FBNRHUT_GROW_NR);
+
+		cute_ensure(!fbnr_heap_insert_grow(&heap, (char *)&key));
+	}
+	cute_ensure(fbnr_heap_count(&heap) == FBNRHUT_GROW_NR);
+	cute_ensure(fbnr_heap_nr(&heap) >= FBNRHUT_GROW_NR);
+	cute_ensure((fbnr_heap_nr(&heap) * sizeof(int)) >= FARR_MMAP_THRESHOLD);
+
+	for (n = 0; n < FBNRHUT_GROW_NR; n++) {
+		int key;
+
+		fbnr_heap_extract_shrink(&heap, (char *)&key, 16);
+		cute_ensure(key > prev);
+		prev = key;
+
+		/* Capacity is halved each time occupancy drops to a quarter. */
+		cute_ensure((fbnr_heap_nr(&heap) == 16) ||
+		            (fbnr_heap_count(&heap) > (fbnr_heap_nr(&heap) / 4)));
+	}
+	cute_ensure(fbnr_heap_empty(&heap));
+	cute_ensure(fbnr_heap_nr(&heap) == 16);
+
+	fbnr_heap_fini_grow(&heap);
+}
+
+/**
+ * Reserve room for nodes then fill heap without growing it
+ *
+ * @ingroup fbnrhut
+ */
+CUTE_PNP_TEST(fbnrhut_grow_reserve, &fbnrhut_grow)
+{
+	struct fbnr_heap heap;
+	const int      *check;
+	int             key;
+	unsigned int    n;
+
+	cute_ensure(!fbnr_heap_init_grow(&heap, sizeof(int), 2,
+	                                 fbnrhut_compare_min, fbnrhut_copy));
+
+	key = 0;
+	cute_ensure(!fbnr_heap_insert_grow(&heap, (char *)&key));
+
+	cute_ensure(!fbnr_heap_reserve(&heap, 1000));
+	cute_ensure(fbnr_heap_nr(&heap) == 1000);
+	cute_ensure(!fbnr_heap_reserve(&heap, 10));
+	cute_ensure(fbnr_heap_nr(&heap) == 1000);
+
+	check = (const int *)fbnr_heap_peek(&heap);
+	cute_ensure(*check == 0);
+
+	for (n = 1; n < 1000; n++) {
+		key = (int)(1000 - n);
+		fbnr_heap_insert(&heap, (char *)&key);
+	}
+	cute_ensure(fbnr_heap_full(&heap));
+
+	for (n = 0; n < 1000; n++) {
+		fbnr_heap_extract(&heap, (char *)&key);
+		cute_ensure(key == (int)n);
+	}
+
+	fbnr_heap_fini_grow(&heap);
+}
+
+#endif /* defined(CONFIG_KARN_FBNR_HEAP_GROW) */
+
+/* Batch sizes going through both sift up and rebuild insertion schemes. */
+static const unsigned int fbnrhut_batch_sizes[] = { 10, 5, 60, 1, 24 };
+
+#define FBNRHUT_BATCH_NR (100U)
+
+static CUTE_PNP_SUITE(fbnrhut_batch, &fbnrhut);
+
+/**
+ * Insert batches of nodes then extract them by batches
+ *
+ * @ingroup fbnrhut
+ */
+CUTE_PNP_TEST(fbnrhut_batch_insert_extract, &fbnrhut_batch)
+{
+	struct fbnr_heap heap;
+	int              nodes[FBNRHUT_BATCH_NR];
+	int              keys[FBNRHUT_BATCH_NR];
+	int              check[FBNRHUT_BATCH_NR];
+	int              out[FBNRHUT_BATCH_NR];
+	unsigned int     b, n, nr = 0;
+
+	for (n = 0; n < FBNRHUT_BATCH_NR; n++)
+		keys[n] = (int)(((n * 37U) + 11U) % FBNRHUT_BATCH_NR) / 2;
+
+	fbnr_heap_init(&heap, (char *)nodes, sizeof(nodes[0]),
+	               array_nr(nodes), fbnrhut_compare_min, fbnrhut_copy);
+
+	for (b = 0; b < array_nr(fbnrhut_batch_sizes); b++) {
+		fbnr_heap_insert_batch(&heap, (char *)&keys[nr],
+		                       fbnrhut_batch_sizes[b]);
+		nr += fbnrhut_batch_sizes[b];
+		cute_ensure(fbnr_heap_count(&heap) == nr);
+	}
+
+	memcpy(check, keys, sizeof(check));
+	qsort(check, nr, sizeof(check[0]), fbnrhut_qsort_compare_min);
+
+	cute_ensure(fbnr_heap_extract_batch(&heap, (char *)out, 30) == 30);
+	cute_ensure(fbnr_heap_count(&heap) == (nr - 30));
+	cute_ensure(fbnr_heap_extract_batch(&heap, (char *)&out[30],
+	                                    FBNRHUT_BATCH_NR) == (nr - 30));
+	cute_ensure(fbnr_heap_empty(&heap));
+	cute_ensure(!fbnr_heap_extract_batch(&heap, (char *)out, 1));
+
+	for (n = 0; n < nr; n++)
+		cute_ensure(out[n] == check[n]);
+
+	fbnr_heap_fini(&heap);
+}
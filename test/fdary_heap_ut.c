@@ -0,0 +1,327 @@
+/**
+ * @file      fdary_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based d-ary heap unit tests implementation
+ *
+ * @defgroup fdaryhut Fixed length array based d-ary heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fdary_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Large enough to get 4 levels deep with arity 4 and 3 with arity 8. */
+#define FDARYHUT_NODE_NR (90U)
+
+static struct fdary_heap fdaryhut_heap;
+
+static int fdaryhut_nodes[FDARYHUT_NODE_NR];
+
+static void fdaryhut_copy(char *restrict dest, const char *restrict src)
+{
+	*(int *)dest = *(int *)src;
+}
+
+static int fdaryhut_compare_min(const char *first, const char *second)
+{
+	return *(int *)first - *(int *)second;
+}
+
+static int fdaryhut_qsort_compare_min(const void *first, const void *second)
+{
+	return fdaryhut_compare_min((const char *)first, (const char *)second);
+}
+
+/* Fill keys with scrambled values in the [0:nr / 2] range, with duplicates. */
+static void fdaryhut_fill_keys(int *keys, unsigned int nr)
+{
+	unsigned int n;
+
+	for (n = 0; n < nr; n++)
+		keys[n] = (int)(((n * 37U) + 11U) % nr) / 2;
+}
+
+static void fdaryhut_check_nodes(const struct fdary_heap *heap, size_t count)
+{
+	const int    *nodes = (const int *)fabs_tree_root(&heap->fdary_tree);
+	unsigned int  arity = fdary_heap_arity(heap);
+	size_t        n;
+
+	cute_ensure(fdary_heap_count(heap) == count);
+
+	for (n = 1; n < count; n++)
+		cute_ensure(nodes[(n - 1) / arity] <= nodes[n]);
+}
+
+static void fdaryhut_check_extract(struct fdary_heap *heap, const int *check,
+                                   unsigned int nr)
+{
+	unsigned int n;
+
+	for (n = 0; n < nr; n++) {
+		int curr = -1;
+
+		fdaryhut_check_nodes(heap, nr - n);
+		cute_ensure(*(int *)fdary_heap_peek(heap) == check[n]);
+
+		fdary_heap_extract(heap, (char *)&curr);
+		cute_ensure(curr == check[n]);
+	}
+
+	cute_ensure(fdary_heap_empty(heap));
+}
+
+static void fdaryhut_check_insert_extract(unsigned int arity, unsigned int nr)
+{
+	int          keys[nr];
+	int          check[nr];
+	unsigned int n;
+
+	fdaryhut_fill_keys(keys, nr);
+	memcpy(check, keys, sizeof(keys));
+	qsort(check, nr, sizeof(check[0]), fdaryhut_qsort_compare_min);
+
+	fdary_heap_init(&fdaryhut_heap, (char *)fdaryhut_nodes,
+	                sizeof(fdaryhut_nodes[0]), nr, arity,
+	                fdaryhut_compare_min, fdaryhut_copy);
+	cute_ensure(fdary_heap_arity(&fdaryhut_heap) == arity);
+	cute_ensure(fdary_heap_nr(&fdaryhut_heap) == nr);
+	cute_ensure(fdary_heap_empty(&fdaryhut_heap));
+
+	for (n = 0; n < nr; n++) {
+		fdary_heap_insert(&fdaryhut_heap, (char *)&keys[n]);
+		fdaryhut_check_nodes(&fdaryhut_heap, n + 1);
+	}
+	cute_ensure(fdary_heap_full(&fdaryhut_heap));
+
+	fdaryhut_check_extract(&fdaryhut_heap, check, nr);
+
+	fdary_heap_fini(&fdaryhut_heap);
+}
+
+static void fdaryhut_check_build(unsigned int arity, unsigned int nr)
+{
+	int check[nr];
+
+	fdaryhut_fill_keys(fdaryhut_nodes, nr);
+	memcpy(check, fdaryhut_nodes, sizeof(check));
+	qsort(check, nr, sizeof(check[0]), fdaryhut_qsort_compare_min);
+
+	fdary_heap_init(&fdaryhut_heap, (char *)fdaryhut_nodes,
+	                sizeof(fdaryhut_nodes[0]), nr, arity,
+	                fdaryhut_compare_min, fdaryhut_copy);
+	fdary_heap_build(&fdaryhut_heap, nr);
+
+	fdaryhut_check_extract(&fdaryhut_heap, check, nr);
+
+	fdary_heap_fini(&fdaryhut_heap);
+}
+
+static CUTE_PNP_SUITE(fdaryhut, NULL);
+
+/**
+ * Insert then extract 1 up to FDARYHUT_NODE_NR nodes into / from 4-ary heaps
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_insert_extract4, &fdaryhut)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FDARYHUT_NODE_NR; nr++)
+		fdaryhut_check_insert_extract(4, nr);
+}
+
+/**
+ * Insert then extract 1 up to FDARYHUT_NODE_NR nodes into / from 8-ary heaps
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_insert_extract8, &fdaryhut)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FDARYHUT_NODE_NR; nr++)
+		fdaryhut_check_insert_extract(8, nr);
+}
+
+/**
+ * Build 4-ary heaps made of 1 up to FDARYHUT_NODE_NR unsorted nodes
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_build4, &fdaryhut)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FDARYHUT_NODE_NR; nr++)
+		fdaryhut_check_build(4, nr);
+}
+
+/**
+ * Build 8-ary heaps made of 1 up to FDARYHUT_NODE_NR unsorted nodes
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_build8, &fdaryhut)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FDARYHUT_NODE_NR; nr++)
+		fdaryhut_check_build(8, nr);
+}
+
+/**
+ * Check dynamically created heaps cache line align groups of siblings and
+ * behave properly
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_create, &fdaryhut)
+{
+	static const unsigned int arities[] = { 4, 8 };
+	int                       keys[FDARYHUT_NODE_NR];
+	int                       check[FDARYHUT_NODE_NR];
+	unsigned int              a, n;
+
+	fdaryhut_fill_keys(keys, FDARYHUT_NODE_NR);
+	memcpy(check, keys, sizeof(keys));
+	qsort(check, FDARYHUT_NODE_NR, sizeof(check[0]),
+	      fdaryhut_qsort_compare_min);
+
+	for (a = 0; a < array_nr(arities); a++) {
+		struct fdary_heap *heap;
+
+		heap = fdary_heap_create(sizeof(keys[0]), FDARYHUT_NODE_NR,
+		                         arities[a], fdaryhut_compare_min,
+		                         fdaryhut_copy);
+		cute_ensure(heap != NULL);
+
+		cute_ensure(!((uintptr_t)fabs_tree_node(&heap->fdary_tree, 1) %
+		              FDARY_HEAP_LINE_SIZE));
+
+		for (n = 0; n < FDARYHUT_NODE_NR; n++)
+			fdary_heap_insert(heap, (char *)&keys[n]);
+
+		fdaryhut_check_extract(heap, check, FDARYHUT_NODE_NR);
+
+		fdary_heap_destroy(heap);
+	}
+}
+
+#if defined(CONFIG_KARN_FDARY_HEAP_SORT)
+
+static void fdaryhut_check_sort(unsigned int arity)
+{
+	unsigned int nr;
+
+	for (nr = 0; nr <= FDARYHUT_NODE_NR; nr++) {
+		int          entries[FDARYHUT_NODE_NR];
+		int          check[FDARYHUT_NODE_NR];
+		unsigned int n;
+
+		fdaryhut_fill_keys(entries, nr);
+		memcpy(check, entries, nr * sizeof(entries[0]));
+		qsort(check, nr, sizeof(check[0]), fdaryhut_qsort_compare_min);
+
+		fdary_heap_sort((char *)entries, sizeof(entries[0]), nr, arity,
+		                fdaryhut_compare_min, fdaryhut_copy);
+
+		for (n = 0; n < nr; n++)
+			cute_ensure(entries[n] == check[n]);
+	}
+}
+
+/**
+ * Sort 0 up to FDARYHUT_NODE_NR unsorted entries using a 4-ary heap
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_sort4, &fdaryhut)
+{
+	fdaryhut_check_sort(4);
+}
+
+/**
+ * Sort 0 up to FDARYHUT_NODE_NR unsorted entries using a 8-ary heap
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_sort8, &fdaryhut)
+{
+	fdaryhut_check_sort(8);
+}
+
+#endif /* defined(CONFIG_KARN_FDARY_HEAP_SORT) */
+
+/* Batch sizes going through both sift up and rebuild insertion schemes. */
+static const unsigned int fdaryhut_batch_sizes[] = { 10, 5, 60, 1, 24 };
+
+#define FDARYHUT_BATCH_NR (100U)
+
+static CUTE_PNP_SUITE(fdaryhut_batch, &fdaryhut);
+
+/**
+ * Insert batches of nodes then extract them by batches
+ *
+ * @ingroup fdaryhut
+ */
+CUTE_PNP_TEST(fdaryhut_batch_insert_extract, &fdaryhut_batch)
+{
+	struct fdary_heap heap;
+	int               nodes[FDARYHUT_BATCH_NR];
+	int               keys[FDARYHUT_BATCH_NR];
+	int               check[FDARYHUT_BATCH_NR];
+	int               out[FDARYHUT_BATCH_NR];
+	unsigned int      b, n, nr = 0;
+
+	for (n = 0; n < FDARYHUT_BATCH_NR; n++)
+		keys[n] = (int)(((n * 37U) + 11U) % FDARYHUT_BATCH_NR) / 2;
+
+	fdary_heap_init(&heap, (char *)nodes, sizeof(nodes[0]),
+	                array_nr(nodes), 4, fdaryhut_compare_min, fdaryhut_copy);
+
+	for (b = 0; b < array_nr(fdaryhut_batch_sizes); b++) {
+		fdary_heap_insert_batch(&heap, (char *)&keys[nr],
+		                        fdaryhut_batch_sizes[b]);
+		nr += fdaryhut_batch_sizes[b];
+		cute_ensure(fdary_heap_count(&heap) == nr);
+	}
+
+	memcpy(check, keys, sizeof(check));
+	qsort(check, nr, sizeof(check[0]), fdaryhut_qsort_compare_min);
+
+	cute_ensure(fdary_heap_extract_batch(&heap, (char *)out, 30) == 30);
+	cute_ensure(fdary_heap_count(&heap) == (nr - 30));
+	cute_ensure(fdary_heap_extract_batch(&heap, (char *)&out[30],
+	                                     FDARYHUT_BATCH_NR) == (nr - 30));
+	cute_ensure(fdary_heap_empty(&heap));
+	cute_ensure(!fdary_heap_extract_batch(&heap, (char *)out, 1));
+
+	for (n = 0; n < nr; n++)
+		cute_ensure(out[n] == check[n]);
+
+	fdary_heap_fini(&heap);
+}
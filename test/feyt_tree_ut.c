@@ -0,0 +1,225 @@
+/**
+ * @file      feyt_tree_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based Eytzinger search tree unit tests implementation
+ *
+ * @defgroup feytut Fixed length array based Eytzinger search tree unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/feyt_tree.h>
+#include <cute/cute.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define FEYTUT_NODE_NR (70U)
+
+struct feytut_node {
+	int          key;
+	unsigned int seq;
+};
+
+static struct feyt_tree   feytut_tree;
+static struct feytut_node feytut_nodes[FEYTUT_NODE_NR];
+
+static int feytut_compare(const char *first, const char *second)
+{
+	return ((const struct feytut_node *)first)->key -
+	       ((const struct feytut_node *)second)->key;
+}
+
+static void feytut_copy(char *restrict dest, const char *restrict src)
+{
+	*(struct feytut_node *)dest = *(const struct feytut_node *)src;
+}
+
+static int feytut_key(const char *node)
+{
+	return ((const struct feytut_node *)node)->key;
+}
+
+static void feytut_setup(void)
+{
+	feyt_tree_init(&feytut_tree, (char *)feytut_nodes,
+	               sizeof(feytut_nodes[0]), array_nr(feytut_nodes),
+	               feytut_compare, feytut_copy);
+}
+
+static CUTE_PNP_SUITE(feytut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(feytut_lookup, &feytut, feytut_setup, NULL);
+
+/**
+ * Check lookups into an empty feyt_tree fail
+ *
+ * @ingroup feytut
+ */
+CUTE_PNP_TEST(feytut_empty, &feytut_lookup)
+{
+	struct feytut_node  key = { .key = 0 };
+	char               *res = (char *)&key;
+
+	feyt_tree_build(&feytut_tree, NULL, 0);
+	cute_ensure(feyt_tree_empty(&feytut_tree) == true);
+
+	cute_ensure(!feyt_tree_lower_bound(&feytut_tree, (char *)&key));
+	cute_ensure(!feyt_tree_upper_bound(&feytut_tree, (char *)&key));
+	cute_ensure(!feyt_tree_find(&feytut_tree, (char *)&key));
+
+	feyt_tree_find_batch(&feytut_tree, (char *)&key, sizeof(key), 1, &res);
+	cute_ensure(!res);
+}
+
+/*
+ * Load tree with nr even keys 0, 2, ..., 2 * (nr - 1) then check every key in
+ * range [-1, 2 * nr] is properly located by all lookup flavours.
+ */
+static void feytut_check_even(unsigned int nr)
+{
+	struct feytut_node  sorted[FEYTUT_NODE_NR];
+	struct feytut_node  keys[(2 * FEYTUT_NODE_NR) + 2];
+	char               *lower[array_nr(keys)];
+	char               *found[array_nr(keys)];
+	unsigned int        n;
+	int                 max = 2 * ((int)nr - 1);
+
+	for (n = 0; n < nr; n++) {
+		sorted[n].key = 2 * (int)n;
+		sorted[n].seq = n;
+	}
+
+	feyt_tree_build(&feytut_tree, (char *)sorted, nr);
+	cute_ensure(feyt_tree_count(&feytut_tree) == nr);
+
+	for (n = 0; n < ((2 * nr) + 2); n++)
+		keys[n].key = (int)n - 1;
+
+	feyt_tree_lower_bound_batch(&feytut_tree, (char *)keys, sizeof(keys[0]),
+	                            (2 * nr) + 2, lower);
+	feyt_tree_find_batch(&feytut_tree, (char *)keys, sizeof(keys[0]),
+	                     (2 * nr) + 2, found);
+
+	for (n = 0; n < ((2 * nr) + 2); n++) {
+		const char *key = (char *)&keys[n];
+		int         k = keys[n].key;
+		int         lo = (k < 0) ? 0 : (k + (k & 1));
+		int         up = (k < 0) ? 0 : (k + 2 - (k & 1));
+		char       *res;
+
+		res = feyt_tree_lower_bound(&feytut_tree, key);
+		if (lo > max)
+			cute_ensure(!res);
+		else
+			cute_ensure(res && (feytut_key(res) == lo));
+		cute_ensure(lower[n] == res);
+
+		res = feyt_tree_upper_bound(&feytut_tree, key);
+		if (up > max)
+			cute_ensure(!res);
+		else
+			cute_ensure(res && (feytut_key(res) == up));
+
+		res = feyt_tree_find(&feytut_tree, key);
+		if ((k < 0) || (k > max) || (k & 1))
+			cute_ensure(!res);
+		else
+			cute_ensure(res && (feytut_key(res) == k));
+		cute_ensure(found[n] == res);
+	}
+}
+
+/**
+ * Check lookups for all tree shapes up to FEYTUT_NODE_NR nodes
+ *
+ * @ingroup feytut
+ */
+CUTE_PNP_TEST(feytut_shapes, &feytut_lookup)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FEYTUT_NODE_NR; nr++)
+		feytut_check_even(nr);
+}
+
+/**
+ * Check lookups return first of multiple matching nodes in sorted order
+ *
+ * @ingroup feytut
+ */
+CUTE_PNP_TEST(feytut_duplicates, &feytut_lookup)
+{
+	const struct feytut_node sorted[] = {
+		{ 1, 0 }, { 1, 1 }, { 2, 2 }, { 2, 3 }, { 2, 4 }, { 3, 5 },
+		{ 3, 6 }, { 5, 7 }, { 5, 8 }, { 5, 9 }
+	};
+	struct feytut_node       key;
+	const char              *res;
+
+	feyt_tree_build(&feytut_tree, (const char *)sorted, array_nr(sorted));
+
+	key.key = 2;
+	res = feyt_tree_lower_bound(&feytut_tree, (char *)&key);
+	cute_ensure(res && (((const struct feytut_node *)res)->seq == 2));
+	res = feyt_tree_find(&feytut_tree, (char *)&key);
+	cute_ensure(res && (((const struct feytut_node *)res)->seq == 2));
+	res = feyt_tree_upper_bound(&feytut_tree, (char *)&key);
+	cute_ensure(res && (((const struct feytut_node *)res)->seq == 5));
+
+	key.key = 4;
+	res = feyt_tree_lower_bound(&feytut_tree, (char *)&key);
+	cute_ensure(res && (((const struct feytut_node *)res)->seq == 7));
+	cute_ensure(!feyt_tree_find(&feytut_tree, (char *)&key));
+
+	key.key = 5;
+	res = feyt_tree_upper_bound(&feytut_tree, (char *)&key);
+	cute_ensure(!res);
+}
+
+/**
+ * Check feyt_tree_create() lays nodes out onto cache line boundaries
+ *
+ * @ingroup feytut
+ */
+CUTE_PNP_TEST(feytut_create, &feytut)
+{
+	const struct feytut_node  sorted[] = {
+		{ 1, 0 }, { 3, 1 }, { 5, 2 }, { 7, 3 }, { 11, 4 }, { 13, 5 }
+	};
+	struct feytut_node        key = { .key = 7 };
+	struct feyt_tree         *tree;
+	uintptr_t                 nodes;
+	const char               *res;
+
+	tree = feyt_tree_create(sizeof(sorted[0]), 32, feytut_compare,
+	                        feytut_copy);
+	cute_ensure(tree);
+
+	nodes = (uintptr_t)tree->feyt_tree.fabs_nodes.farr_slots;
+	cute_ensure(!((nodes - sizeof(sorted[0])) % FEYT_TREE_LINE_SIZE));
+	cute_ensure(tree->feyt_pref == 3);
+
+	feyt_tree_build(tree, (const char *)sorted, array_nr(sorted));
+	res = feyt_tree_find(tree, (char *)&key);
+	cute_ensure(res && (((const struct feytut_node *)res)->seq == 3));
+
+	feyt_tree_destroy(tree);
+}
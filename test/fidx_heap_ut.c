@@ -0,0 +1,299 @@
+/**
+ * @file      fidx_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based indexed binary heap unit tests implementation
+ *
+ * @defgroup fidxhut Fixed length array based indexed binary heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fidx_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIDXHUT_NODE_NR (64U)
+
+static struct fidx_heap *fidxhut_heap;
+
+static int fidxhut_keys[FIDXHUT_NODE_NR];
+
+static void fidxhut_copy(char *restrict dest, const char *restrict src)
+{
+	*(int *)dest = *(int *)src;
+}
+
+static int fidxhut_compare_min(const char *first, const char *second)
+{
+	return *(int *)first - *(int *)second;
+}
+
+static int fidxhut_qsort_compare_min(const void *first, const void *second)
+{
+	return fidxhut_compare_min((const char *)first, (const char *)second);
+}
+
+/* Check heap property and consistency of identifier / slot maps. */
+static void fidxhut_check_nodes(const struct fidx_heap *heap, size_t count)
+{
+	size_t n;
+
+	cute_ensure(fidx_heap_count(heap) == count);
+
+	for (n = 0; n < count; n++) {
+		unsigned int id = heap->fidx_ids[n];
+
+		cute_ensure(fidx_heap_contains(heap, id));
+		cute_ensure(heap->fidx_slots[id] == n);
+		cute_ensure(*(int *)fidx_heap_node(heap, id) == fidxhut_keys[id]);
+		if (n)
+			cute_ensure(*(int *)fabs_tree_node(&heap->fidx_tree,
+			                                   (n - 1) / 2) <=
+			            *(int *)fabs_tree_node(&heap->fidx_tree, n));
+	}
+}
+
+/* Extract all nodes, checking they come out in order along with their ids. */
+static void fidxhut_check_extract(struct fidx_heap *heap)
+{
+	size_t nr = fidx_heap_count(heap);
+	int    check[FIDXHUT_NODE_NR];
+	size_t n, c = 0;
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n++)
+		if (fidx_heap_contains(heap, n))
+			check[c++] = fidxhut_keys[n];
+	cute_ensure(c == nr);
+
+	qsort(check, nr, sizeof(check[0]), fidxhut_qsort_compare_min);
+
+	for (n = 0; n < nr; n++) {
+		int          curr = -1;
+		unsigned int id;
+
+		cute_ensure(*(int *)fidx_heap_peek(heap) == check[n]);
+		cute_ensure(fidxhut_keys[fidx_heap_peek_id(heap)] == check[n]);
+
+		id = fidx_heap_extract(heap, (char *)&curr);
+		cute_ensure(curr == check[n]);
+		cute_ensure(fidxhut_keys[id] == curr);
+		cute_ensure(!fidx_heap_contains(heap, id));
+
+		fidxhut_check_nodes(heap, nr - n - 1);
+	}
+
+	cute_ensure(fidx_heap_empty(heap));
+}
+
+/* Insert all nodes with scrambled keys in the [0:nr / 2] range. */
+static void fidxhut_insert_all(struct fidx_heap *heap)
+{
+	unsigned int n;
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n++) {
+		fidxhut_keys[n] = (int)(((n * 37U) + 11U) % FIDXHUT_NODE_NR) / 2;
+		cute_ensure(!fidx_heap_contains(heap, n));
+
+		fidx_heap_insert(heap, n, (char *)&fidxhut_keys[n]);
+		fidxhut_check_nodes(heap, n + 1);
+	}
+	cute_ensure(fidx_heap_full(heap));
+}
+
+static void fidxhut_setup(void)
+{
+	fidxhut_heap = fidx_heap_create(sizeof(fidxhut_keys[0]),
+	                                FIDXHUT_NODE_NR, fidxhut_compare_min,
+	                                fidxhut_copy);
+	cute_ensure(fidxhut_heap != NULL);
+}
+
+static void fidxhut_teardown(void)
+{
+	fidx_heap_destroy(fidxhut_heap);
+}
+
+static CUTE_PNP_SUITE(fidxhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(fidxhut_ops, &fidxhut, fidxhut_setup,
+                               fidxhut_teardown);
+
+/**
+ * Check heaps are initialized empty
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_init, &fidxhut_ops)
+{
+	unsigned int n;
+
+	cute_ensure(fidx_heap_nr(fidxhut_heap) == FIDXHUT_NODE_NR);
+	cute_ensure(fidx_heap_empty(fidxhut_heap));
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n++)
+		cute_ensure(!fidx_heap_contains(fidxhut_heap, n));
+}
+
+/**
+ * Insert then extract FIDXHUT_NODE_NR nodes
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_insert_extract, &fidxhut_ops)
+{
+	fidxhut_insert_all(fidxhut_heap);
+	fidxhut_check_extract(fidxhut_heap);
+
+	/* Identifiers may be reused once extracted. */
+	fidxhut_insert_all(fidxhut_heap);
+	fidx_heap_clear(fidxhut_heap);
+	cute_ensure(!fidx_heap_contains(fidxhut_heap, 0));
+	fidxhut_insert_all(fidxhut_heap);
+	fidxhut_check_extract(fidxhut_heap);
+}
+
+/**
+ * Promote every other node then check extraction order
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_promote, &fidxhut_ops)
+{
+	unsigned int n;
+
+	fidxhut_insert_all(fidxhut_heap);
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n += 2) {
+		fidxhut_keys[n] -= (int)FIDXHUT_NODE_NR;
+		fidx_heap_promote(fidxhut_heap, n, (char *)&fidxhut_keys[n]);
+		fidxhut_check_nodes(fidxhut_heap, FIDXHUT_NODE_NR);
+	}
+
+	/* Modify nodes in place. */
+	for (n = 1; n < FIDXHUT_NODE_NR; n += 2) {
+		int *node = (int *)fidx_heap_node(fidxhut_heap, n);
+
+		*node -= 3;
+		fidxhut_keys[n] = *node;
+		fidx_heap_promote(fidxhut_heap, n, (char *)node);
+		fidxhut_check_nodes(fidxhut_heap, FIDXHUT_NODE_NR);
+	}
+
+	fidxhut_check_extract(fidxhut_heap);
+}
+
+/**
+ * Demote every other node then check extraction order
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_demote, &fidxhut_ops)
+{
+	unsigned int n;
+
+	fidxhut_insert_all(fidxhut_heap);
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n += 2) {
+		fidxhut_keys[n] += (int)FIDXHUT_NODE_NR;
+		fidx_heap_demote(fidxhut_heap, n, (char *)&fidxhut_keys[n]);
+		fidxhut_check_nodes(fidxhut_heap, FIDXHUT_NODE_NR);
+	}
+
+	for (n = 1; n < FIDXHUT_NODE_NR; n += 2) {
+		int *node = (int *)fidx_heap_node(fidxhut_heap, n);
+
+		*node += 3;
+		fidxhut_keys[n] = *node;
+		fidx_heap_demote(fidxhut_heap, n, (char *)node);
+		fidxhut_check_nodes(fidxhut_heap, FIDXHUT_NODE_NR);
+	}
+
+	fidxhut_check_extract(fidxhut_heap);
+}
+
+/**
+ * Update nodes in both directions then check extraction order
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_update, &fidxhut_ops)
+{
+	unsigned int n;
+
+	fidxhut_insert_all(fidxhut_heap);
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n++) {
+		fidxhut_keys[n] = (int)(((n * 13U) + 5U) % FIDXHUT_NODE_NR) -
+		                  (int)(FIDXHUT_NODE_NR / 4);
+		fidx_heap_update(fidxhut_heap, n, (char *)&fidxhut_keys[n]);
+		fidxhut_check_nodes(fidxhut_heap, FIDXHUT_NODE_NR);
+	}
+
+	fidxhut_check_extract(fidxhut_heap);
+}
+
+/**
+ * Remove nodes located at arbitrary slots then check extraction order
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_remove, &fidxhut_ops)
+{
+	unsigned int n, nr = FIDXHUT_NODE_NR;
+
+	fidxhut_insert_all(fidxhut_heap);
+
+	for (n = 0; n < FIDXHUT_NODE_NR; n += 3) {
+		int curr = -1;
+
+		fidx_heap_remove(fidxhut_heap, n, (char *)&curr);
+		cute_ensure(curr == fidxhut_keys[n]);
+		cute_ensure(!fidx_heap_contains(fidxhut_heap, n));
+		fidxhut_check_nodes(fidxhut_heap, --nr);
+	}
+
+	/* Remove without retrieving content. */
+	fidx_heap_remove(fidxhut_heap, 1, NULL);
+	fidxhut_check_nodes(fidxhut_heap, --nr);
+
+	fidxhut_check_extract(fidxhut_heap);
+}
+
+/**
+ * Check heaps initialized with caller supplied node storage
+ *
+ * @ingroup fidxhut
+ */
+CUTE_PNP_TEST(fidxhut_init_fini, &fidxhut)
+{
+	struct fidx_heap heap;
+	int              nodes[FIDXHUT_NODE_NR];
+
+	cute_ensure(!fidx_heap_init(&heap, (char *)nodes, sizeof(nodes[0]),
+	                            array_nr(nodes), fidxhut_compare_min,
+	                            fidxhut_copy));
+
+	fidxhut_insert_all(&heap);
+	fidxhut_check_extract(&heap);
+
+	fidx_heap_fini(&heap);
+}
@@ -0,0 +1,250 @@
+/**
+ * @file      fkey_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based integer key heap unit tests implementation
+ *
+ * @defgroup fkeyhut Fixed length array based integer key heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fkey_heap.h>
+#include <cute/cute.h>
+#include <string.h>
+
+/* Large enough to get 3 levels deep with 16 children per node. */
+#define FKEYHUT_NODE_NR (300U)
+
+static struct fkey_uint32_heap fkeyhut_heap32;
+static struct fkey_uint64_heap fkeyhut_heap64;
+
+/*
+ * Scrambled keys with duplicates, greatest representable key included so that
+ * it collides with fillers.
+ */
+static uint64_t fkeyhut_key(unsigned int index, uint64_t max)
+{
+	if (!(index % 7))
+		return max;
+
+	return ((index * 37U) + 11U) % (FKEYHUT_NODE_NR / 3);
+}
+
+static int fkeyhut_qsort_compare(const void *first, const void *second)
+{
+	uint64_t fst = *(const uint64_t *)first;
+	uint64_t snd = *(const uint64_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static void fkeyhut_setup(void)
+{
+	cute_ensure(!fkey_uint32_heap_init(&fkeyhut_heap32, FKEYHUT_NODE_NR));
+	cute_ensure(!fkey_uint64_heap_init(&fkeyhut_heap64, FKEYHUT_NODE_NR));
+}
+
+static void fkeyhut_teardown(void)
+{
+	fkey_uint32_heap_fini(&fkeyhut_heap32);
+	fkey_uint64_heap_fini(&fkeyhut_heap64);
+}
+
+static CUTE_PNP_SUITE(fkeyhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(fkeyhut_ops, &fkeyhut, fkeyhut_setup,
+                               fkeyhut_teardown);
+
+/**
+ * Check heaps are initialized empty with keys of first children aligned onto
+ * cache lines
+ *
+ * @ingroup fkeyhut
+ */
+CUTE_PNP_TEST(fkeyhut_init, &fkeyhut_ops)
+{
+	cute_ensure(fkey_uint32_heap_nr(&fkeyhut_heap32) == FKEYHUT_NODE_NR);
+	cute_ensure(fkey_uint32_heap_empty(&fkeyhut_heap32));
+	cute_ensure(!((uintptr_t)&fkeyhut_heap32.fkey_keys[1] %
+	              FKEY_HEAP_LINE_SIZE));
+
+	cute_ensure(fkey_uint64_heap_nr(&fkeyhut_heap64) == FKEYHUT_NODE_NR);
+	cute_ensure(fkey_uint64_heap_empty(&fkeyhut_heap64));
+	cute_ensure(!((uintptr_t)&fkeyhut_heap64.fkey_keys[1] %
+	              FKEY_HEAP_LINE_SIZE));
+}
+
+/**
+ * Insert then extract up to FKEYHUT_NODE_NR 32 bits keys
+ *
+ * @ingroup fkeyhut
+ */
+CUTE_PNP_TEST(fkeyhut_uint32, &fkeyhut_ops)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FKEYHUT_NODE_NR; nr += 13) {
+		uint64_t     check[FKEYHUT_NODE_NR];
+		unsigned int n;
+
+		fkey_uint32_heap_clear(&fkeyhut_heap32);
+
+		for (n = 0; n < nr; n++) {
+			check[n] = fkeyhut_key(n, UINT32_MAX);
+			fkey_uint32_heap_insert(&fkeyhut_heap32,
+			                        (uint32_t)check[n],
+			                        (uintptr_t)check[n] * 3);
+		}
+		cute_ensure(fkey_uint32_heap_count(&fkeyhut_heap32) == nr);
+
+		qsort(check, nr, sizeof(check[0]), fkeyhut_qsort_compare);
+
+		for (n = 0; n < nr; n++) {
+			uintptr_t payload;
+
+			cute_ensure(fkey_uint32_heap_peek_key(&fkeyhut_heap32) ==
+			            check[n]);
+			cute_ensure(fkey_uint32_heap_extract(&fkeyhut_heap32,
+			                                     &payload) ==
+			            check[n]);
+			cute_ensure(payload == (uintptr_t)check[n] * 3);
+		}
+
+		cute_ensure(fkey_uint32_heap_empty(&fkeyhut_heap32));
+	}
+}
+
+/**
+ * Insert then extract up to FKEYHUT_NODE_NR 64 bits keys
+ *
+ * @ingroup fkeyhut
+ */
+CUTE_PNP_TEST(fkeyhut_uint64, &fkeyhut_ops)
+{
+	unsigned int nr;
+
+	for (nr = 1; nr <= FKEYHUT_NODE_NR; nr += 13) {
+		uint64_t     check[FKEYHUT_NODE_NR];
+		unsigned int n;
+
+		fkey_uint64_heap_clear(&fkeyhut_heap64);
+
+		for (n = 0; n < nr; n++) {
+			/* Exercise keys with the most significant bit set. */
+			check[n] = fkeyhut_key(n, UINT64_MAX);
+			if (n & 1)
+				check[n] |= (uint64_t)1 << 63;
+			fkey_uint64_heap_insert(&fkeyhut_heap64, check[n], n);
+		}
+
+		qsort(check, nr, sizeof(check[0]), fkeyhut_qsort_compare);
+
+		for (n = 0; n < nr; n++)
+			cute_ensure(fkey_uint64_heap_extract(&fkeyhut_heap64,
+			                                     NULL) == check[n]);
+
+		cute_ensure(fkey_uint64_heap_empty(&fkeyhut_heap64));
+	}
+}
+
+/**
+ * Interleave insertions and extractions, clearing heaps before completion
+ *
+ * @ingroup fkeyhut
+ */
+CUTE_PNP_TEST(fkeyhut_mixed, &fkeyhut_ops)
+{
+	uint32_t     min = 0;
+	unsigned int n;
+
+	for (n = 0; n < FKEYHUT_NODE_NR; n++) {
+		uint32_t key = (uint32_t)(fkeyhut_key(n, UINT32_MAX) % 100);
+
+		/* Keep inserted keys above the last extracted one. */
+		fkey_uint32_heap_insert(&fkeyhut_heap32, min + key, n);
+		if (n & 1) {
+			uint32_t cur;
+
+			cur = fkey_uint32_heap_extract(&fkeyhut_heap32, NULL);
+			cute_ensure(cur >= min);
+			min = cur;
+		}
+	}
+
+	cute_ensure(fkey_uint32_heap_count(&fkeyhut_heap32) ==
+	            FKEYHUT_NODE_NR / 2);
+
+	fkey_uint32_heap_clear(&fkeyhut_heap32);
+	cute_ensure(fkey_uint32_heap_empty(&fkeyhut_heap32));
+
+	fkey_uint32_heap_insert(&fkeyhut_heap32, 3, 3);
+	fkey_uint32_heap_insert(&fkeyhut_heap32, 1, 1);
+	fkey_uint32_heap_insert(&fkeyhut_heap32, 2, 2);
+	cute_ensure(fkey_uint32_heap_peek_payload(&fkeyhut_heap32) == 1);
+	cute_ensure(fkey_uint32_heap_extract(&fkeyhut_heap32, NULL) == 1);
+	cute_ensure(fkey_uint32_heap_extract(&fkeyhut_heap32, NULL) == 2);
+	cute_ensure(fkey_uint32_heap_extract(&fkeyhut_heap32, NULL) == 3);
+}
+
+/**
+ * Insert keys by batches going through both sift up and rebuild schemes then
+ * extract them by batches
+ *
+ * @ingroup fkeyhut
+ */
+CUTE_PNP_TEST(fkeyhut_batch, &fkeyhut_ops)
+{
+	static const unsigned int sizes[] = { 40, 7, 100, 1, 152 };
+	uint32_t                  keys[FKEYHUT_NODE_NR];
+	uintptr_t                 payloads[FKEYHUT_NODE_NR];
+	uint64_t                  check[FKEYHUT_NODE_NR];
+	uint32_t                  out[FKEYHUT_NODE_NR];
+	uintptr_t                 outp[FKEYHUT_NODE_NR];
+	unsigned int              b, n, nr = 0;
+
+	for (n = 0; n < FKEYHUT_NODE_NR; n++) {
+		check[n] = fkeyhut_key(n, UINT32_MAX);
+		keys[n] = (uint32_t)check[n];
+		payloads[n] = n;
+	}
+
+	for (b = 0; b < array_nr(sizes); b++) {
+		fkey_uint32_heap_insert_batch(&fkeyhut_heap32, &keys[nr],
+		                              &payloads[nr], sizes[b]);
+		nr += sizes[b];
+		cute_ensure(fkey_uint32_heap_count(&fkeyhut_heap32) == nr);
+	}
+
+	qsort(check, nr, sizeof(check[0]), fkeyhut_qsort_compare);
+
+	cute_ensure(fkey_uint32_heap_extract_batch(&fkeyhut_heap32, out, outp,
+	                                           100) == 100);
+	cute_ensure(fkey_uint32_heap_extract_batch(&fkeyhut_heap32, &out[100],
+	                                           &outp[100],
+	                                           FKEYHUT_NODE_NR) ==
+	            (nr - 100));
+	cute_ensure(fkey_uint32_heap_empty(&fkeyhut_heap32));
+
+	for (n = 0; n < nr; n++) {
+		cute_ensure(out[n] == check[n]);
+		cute_ensure(keys[outp[n]] == out[n]);
+	}
+}
@@ -0,0 +1,338 @@
+/**
+ * @file      fmmx_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based min-max heap unit tests implementation
+ *
+ * @defgroup fmmxhut Fixed length array based min-max heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fmmx_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+
+#define FMMXHUT_NODE_NR (64U)
+
+static struct fmmx_heap *fmmxhut_heap;
+
+static int fmmxhut_keys[FMMXHUT_NODE_NR];
+
+static void fmmxhut_copy(char *restrict dest, const char *restrict src)
+{
+	*(int *)dest = *(int *)src;
+}
+
+static int fmmxhut_compare_min(const char *first, const char *second)
+{
+	return *(int *)first - *(int *)second;
+}
+
+static int fmmxhut_qsort_compare_min(const void *first, const void *second)
+{
+	return fmmxhut_compare_min((const char *)first, (const char *)second);
+}
+
+static int fmmxhut_key(const struct fmmx_heap *heap, size_t index)
+{
+	return *(int *)fabs_tree_node(&heap->fmmx_tree, index);
+}
+
+/*
+ * Check nodes located at even depths are not greater than their descendants and
+ * nodes located at odd depths are not smaller than their descendants.
+ */
+static void fmmxhut_check_nodes(const struct fmmx_heap *heap, size_t count)
+{
+	size_t n;
+
+	cute_ensure(fmmx_heap_count(heap) == count);
+
+	for (n = 1; n < count; n++) {
+		size_t idx = n;
+
+		do {
+			int diff;
+
+			idx = fabs_tree_parent_index(idx);
+			diff = fmmxhut_key(heap, idx) - fmmxhut_key(heap, n);
+
+			if (fabs_tree_index_depth(idx) & 1)
+				cute_ensure(diff >= 0);
+			else
+				cute_ensure(diff <= 0);
+		} while (idx);
+	}
+}
+
+/* Insert first nr keys scrambled in the [0:nr / 2] range. */
+static void fmmxhut_insert_all(struct fmmx_heap *heap, size_t nr)
+{
+	unsigned int n;
+
+	for (n = 0; n < nr; n++) {
+		fmmxhut_keys[n] = (int)(((n * 37U) + 11U) %
+		                        FMMXHUT_NODE_NR) / 2;
+
+		fmmx_heap_insert(heap, (char *)&fmmxhut_keys[n]);
+		fmmxhut_check_nodes(heap, n + 1);
+	}
+}
+
+/*
+ * Extract all nodes, alternating ends according to the bits of pattern, and
+ * check they come out in order.
+ */
+static void fmmxhut_check_extract(struct fmmx_heap *heap, unsigned int pattern)
+{
+	size_t nr = fmmx_heap_count(heap);
+	int    check[FMMXHUT_NODE_NR];
+	size_t first = 0, last = nr, n;
+
+	for (n = 0; n < nr; n++)
+		check[n] = fmmxhut_keys[n];
+	qsort(check, nr, sizeof(check[0]), fmmxhut_qsort_compare_min);
+
+	for (n = 0; n < nr; n++) {
+		int curr = -1;
+
+		cute_ensure(*(int *)fmmx_heap_peek_min(heap) ==
+		            check[first]);
+		cute_ensure(*(int *)fmmx_heap_peek_max(heap) ==
+		            check[last - 1]);
+
+		if ((pattern >> (n % 32)) & 1) {
+			fmmx_heap_extract_max(heap, (char *)&curr);
+			cute_ensure(curr == check[--last]);
+		}
+		else {
+			fmmx_heap_extract_min(heap, (char *)&curr);
+			cute_ensure(curr == check[first++]);
+		}
+
+		fmmxhut_check_nodes(heap, nr - n - 1);
+	}
+
+	cute_ensure(fmmx_heap_empty(heap));
+}
+
+static void fmmxhut_setup(void)
+{
+	fmmxhut_heap = fmmx_heap_create(sizeof(fmmxhut_keys[0]),
+	                                FMMXHUT_NODE_NR, fmmxhut_compare_min,
+	                                fmmxhut_copy);
+	cute_ensure(fmmxhut_heap != NULL);
+}
+
+static void fmmxhut_teardown(void)
+{
+	fmmx_heap_destroy(fmmxhut_heap);
+}
+
+static CUTE_PNP_SUITE(fmmxhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(fmmxhut_ops, &fmmxhut, fmmxhut_setup,
+                               fmmxhut_teardown);
+
+/**
+ * Check heaps are initialized empty
+ *
+ * @ingroup fmmxhut
+ */
+CUTE_PNP_TEST(fmmxhut_init, &fmmxhut_ops)
+{
+	cute_ensure(fmmx_heap_nr(fmmxhut_heap) == FMMXHUT_NODE_NR);
+	cute_ensure(fmmx_heap_empty(fmmxhut_heap));
+	cute_ensure(!fmmx_heap_full(fmmxhut_heap));
+}
+
+/**
+ * Insert then extract nodes from both ends for all heap sizes
+ *
+ * @ingroup fmmxhut
+ */
+CUTE_PNP_TEST(fmmxhut_insert_extract, &fmmxhut_ops)
+{
+	static const unsigned int patterns[] = {
+		0U, ~0U, 0xaaaaaaaaU, 0x3c3c3c3cU, 0x0ff00ff0U
+	};
+	unsigned int              p;
+	size_t                    nr;
+
+	for (p = 0; p < array_nr(patterns); p++) {
+		for (nr = 1; nr <= FMMXHUT_NODE_NR; nr++) {
+			fmmxhut_insert_all(fmmxhut_heap, nr);
+			fmmxhut_check_extract(fmmxhut_heap, patterns[p]);
+		}
+	}
+}
+
+/**
+ * Build heaps of all sizes from unsorted data then extract nodes from both ends
+ *
+ * @ingroup fmmxhut
+ */
+CUTE_PNP_TEST(fmmxhut_build, &fmmxhut_ops)
+{
+	size_t nr, n;
+
+	for (nr = 1; nr <= FMMXHUT_NODE_NR; nr++) {
+		for (n = 0; n < nr; n++) {
+			fmmxhut_keys[n] = (int)(((n * 13U) + 5U) %
+			                        FMMXHUT_NODE_NR) / 3;
+			*(int *)fabs_tree_node(&fmmxhut_heap->fmmx_tree, n) =
+				fmmxhut_keys[n];
+		}
+
+		fmmx_heap_build(fmmxhut_heap, nr);
+		fmmxhut_check_nodes(fmmxhut_heap, nr);
+		fmmxhut_check_extract(fmmxhut_heap, 0x5a5a5a5aU);
+	}
+}
+
+/**
+ * Insert into bounded heaps evicting smallest nodes and check greatest ones are
+ * kept
+ *
+ * @ingroup fmmxhut
+ */
+CUTE_PNP_TEST(fmmxhut_evict_min, &fmmxhut_ops)
+{
+	int          check[3 * FMMXHUT_NODE_NR];
+	unsigned int n, evicted = 0;
+
+	for (n = 0; n < array_nr(check); n++) {
+		int key = (int)(((n * 71U) + 3U) % array_nr(check)) / 2;
+		int out = -1;
+
+		check[n] = key;
+		if (fmmx_heap_insert_evict_min(fmmxhut_heap, (char *)&key,
+		                               (char *)&out)) {
+			cute_ensure(n >= FMMXHUT_NODE_NR);
+			cute_ensure(out <=
+			            *(int *)fmmx_heap_peek_min(fmmxhut_heap));
+			evicted++;
+		}
+		else
+			cute_ensure(n < FMMXHUT_NODE_NR);
+
+		fmmxhut_check_nodes(fmmxhut_heap,
+		                    (n < FMMXHUT_NODE_NR) ? n + 1 :
+		                                            FMMXHUT_NODE_NR);
+	}
+	cute_ensure(evicted == (array_nr(check) - FMMXHUT_NODE_NR));
+
+	qsort(check, array_nr(check), sizeof(check[0]),
+	      fmmxhut_qsort_compare_min);
+
+	for (n = array_nr(check) - FMMXHUT_NODE_NR; n < array_nr(check); n++) {
+		int curr = -1;
+
+		fmmx_heap_extract_min(fmmxhut_heap, (char *)&curr);
+		cute_ensure(curr == check[n]);
+	}
+
+	cute_ensure(fmmx_heap_empty(fmmxhut_heap));
+}
+
+/**
+ * Insert into bounded heaps evicting greatest nodes and check smallest ones are
+ * kept
+ *
+ * @ingroup fmmxhut
+ */
+CUTE_PNP_TEST(fmmxhut_evict_max, &fmmxhut_ops)
+{
+	int          check[3 * FMMXHUT_NODE_NR];
+	unsigned int n, evicted = 0;
+
+	for (n = 0; n < array_nr(check); n++) {
+		int key = (int)(((n * 71U) + 3U) % array_nr(check)) / 2;
+		int out = -1;
+
+		check[n] = key;
+		if (fmmx_heap_insert_evict_max(fmmxhut_heap, (char *)&key,
+		                               (char *)&out)) {
+			cute_ensure(n >= FMMXHUT_NODE_NR);
+			cute_ensure(out >=
+			            *(int *)fmmx_heap_peek_max(fmmxhut_heap));
+			evicted++;
+		}
+		else
+			cute_ensure(n < FMMXHUT_NODE_NR);
+
+		fmmxhut_check_nodes(fmmxhut_heap,
+		                    (n < FMMXHUT_NODE_NR) ? n + 1 :
+		                                            FMMXHUT_NODE_NR);
+	}
+	cute_ensure(evicted == (array_nr(check) - FMMXHUT_NODE_NR));
+
+	qsort(check, array_nr(check), sizeof(check[0]),
+	      fmmxhut_qsort_compare_min);
+
+	for (n = FMMXHUT_NODE_NR; n > 0; n--) {
+		int curr = -1;
+
+		fmmx_heap_extract_max(fmmxhut_heap, (char *)&curr);
+		cute_ensure(curr == check[n - 1]);
+	}
+
+	cute_ensure(fmmx_heap_empty(fmmxhut_heap));
+}
+
+/**
+ * Check heaps initialized with caller supplied node storage, including single
+ * node ones
+ *
+ * @ingroup fmmxhut
+ */
+CUTE_PNP_TEST(fmmxhut_init_fini, &fmmxhut)
+{
+	struct fmmx_heap heap;
+	int              node;
+	int              key, out;
+
+	fmmx_heap_init(&heap, (char *)&node, sizeof(node), 1,
+	               fmmxhut_compare_min, fmmxhut_copy);
+
+	key = 4;
+	cute_ensure(!fmmx_heap_insert_evict_max(&heap, (char *)&key,
+	                                        (char *)&out));
+	cute_ensure(fmmx_heap_full(&heap));
+
+	key = 2;
+	cute_ensure(fmmx_heap_insert_evict_max(&heap, (char *)&key,
+	                                       (char *)&out));
+	cute_ensure(out == 4);
+	cute_ensure(*(int *)fmmx_heap_peek_max(&heap) == 2);
+
+	key = 3;
+	cute_ensure(fmmx_heap_insert_evict_min(&heap, (char *)&key,
+	                                       (char *)&out));
+	cute_ensure(out == 2);
+	cute_ensure(*(int *)fmmx_heap_peek_min(&heap) == 3);
+
+	fmmx_heap_extract_max(&heap, (char *)&out);
+	cute_ensure(out == 3);
+	cute_ensure(fmmx_heap_empty(&heap));
+
+	fmmx_heap_fini(&heap);
+}
@@ -0,0 +1,323 @@
+/**
+ * @file      fshd_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Fixed length array based shadow heap unit tests implementation
+ *
+ * @defgroup fshdhut Fixed length array based shadow heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/fshd_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+
+#define FSHDHUT_NODE_NR (256U)
+
+static struct fshd_heap *fshdhut_heap;
+
+static int fshdhut_keys[FSHDHUT_NODE_NR];
+
+static void fshdhut_copy(char *restrict dest, const char *restrict src)
+{
+	*(int *)dest = *(int *)src;
+}
+
+static int fshdhut_compare_min(const char *first, const char *second)
+{
+	return *(int *)first - *(int *)second;
+}
+
+static int fshdhut_qsort_compare_min(const void *first, const void *second)
+{
+	return fshdhut_compare_min((const char *)first, (const char *)second);
+}
+
+static int fshdhut_key(const struct fshd_heap *heap, size_t index)
+{
+	return *(int *)fabs_tree_node(&heap->fshd_tree, index);
+}
+
+/* Generate nr keys scrambled in the [0:nr / 2] range. */
+static void fshdhut_init_keys(size_t nr, unsigned int seed)
+{
+	unsigned int n;
+
+	for (n = 0; n < nr; n++)
+		fshdhut_keys[n] = (int)(((n * 37U) + seed) %
+		                        FSHDHUT_NODE_NR) / 2;
+}
+
+/* Check nodes of the heap ordered zone are not smaller than their parent. */
+static void fshdhut_check_nodes(const struct fshd_heap *heap, size_t count)
+{
+	size_t n;
+
+	cute_ensure(fshd_heap_count(heap) == count);
+	cute_ensure(heap->fshd_ordered <= count);
+
+	for (n = 1; n < heap->fshd_ordered; n++)
+		cute_ensure(fshdhut_key(heap, fabs_tree_parent_index(n)) <=
+		            fshdhut_key(heap, n));
+}
+
+/* Extract all nodes and check they come out in order. */
+static void fshdhut_check_extract(struct fshd_heap *heap, size_t nr)
+{
+	int    check[FSHDHUT_NODE_NR];
+	size_t n;
+
+	for (n = 0; n < nr; n++)
+		check[n] = fshdhut_keys[n];
+	qsort(check, nr, sizeof(check[0]), fshdhut_qsort_compare_min);
+
+	for (n = 0; n < nr; n++) {
+		int curr = -1;
+
+		cute_ensure(*(int *)fshd_heap_peek(heap) == check[n]);
+		fshd_heap_extract(heap, (char *)&curr);
+		cute_ensure(curr == check[n]);
+		fshdhut_check_nodes(heap, nr - n - 1);
+	}
+
+	cute_ensure(fshd_heap_empty(heap));
+}
+
+static void fshdhut_setup(void)
+{
+	fshdhut_heap = fshd_heap_create(sizeof(fshdhut_keys[0]),
+	                                FSHDHUT_NODE_NR, fshdhut_compare_min,
+	                                fshdhut_copy);
+	cute_ensure(fshdhut_heap != NULL);
+}
+
+static void fshdhut_teardown(void)
+{
+	fshd_heap_destroy(fshdhut_heap);
+}
+
+static CUTE_PNP_SUITE(fshdhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(fshdhut_ops, &fshdhut, fshdhut_setup,
+                               fshdhut_teardown);
+
+/**
+ * Check heaps are initialized empty
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_init, &fshdhut_ops)
+{
+	cute_ensure(fshd_heap_nr(fshdhut_heap) == FSHDHUT_NODE_NR);
+	cute_ensure(fshd_heap_empty(fshdhut_heap));
+	cute_ensure(!fshd_heap_full(fshdhut_heap));
+}
+
+/**
+ * Insert nodes one by one then extract them for all heap sizes
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_insert_extract, &fshdhut_ops)
+{
+	size_t nr, n;
+
+	for (nr = 1; nr <= FSHDHUT_NODE_NR; nr++) {
+		fshdhut_init_keys(nr, 11U);
+
+		for (n = 0; n < nr; n++) {
+			fshd_heap_insert(fshdhut_heap,
+			                 (char *)&fshdhut_keys[n]);
+			fshdhut_check_nodes(fshdhut_heap, n + 1);
+		}
+
+		fshdhut_check_extract(fshdhut_heap, nr);
+	}
+}
+
+/**
+ * Check insertion merges the shadow once larger than the heap ordered zone
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_shadow_overflow, &fshdhut_ops)
+{
+	size_t n;
+
+	fshdhut_init_keys(FSHDHUT_NODE_NR, 3U);
+
+	for (n = 0; n < FSHD_HEAP_SHADOW_MIN; n++)
+		fshd_heap_insert(fshdhut_heap, (char *)&fshdhut_keys[n]);
+	cute_ensure(fshdhut_heap->fshd_ordered == 0);
+
+	fshd_heap_insert(fshdhut_heap, (char *)&fshdhut_keys[n++]);
+	cute_ensure(fshdhut_heap->fshd_ordered == n);
+
+	for (; n < (2 * (FSHD_HEAP_SHADOW_MIN + 1)); n++)
+		fshd_heap_insert(fshdhut_heap, (char *)&fshdhut_keys[n]);
+	cute_ensure(fshdhut_heap->fshd_ordered == (FSHD_HEAP_SHADOW_MIN + 1));
+
+	fshd_heap_insert(fshdhut_heap, (char *)&fshdhut_keys[n++]);
+	cute_ensure(fshdhut_heap->fshd_ordered == n);
+	fshdhut_check_nodes(fshdhut_heap, n);
+
+	fshdhut_check_extract(fshdhut_heap, n);
+}
+
+/**
+ * Interleave insertions and extractions so that shadows of all sizes are
+ * merged into heap ordered zones of all sizes
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_interleave, &fshdhut_ops)
+{
+	size_t ord, nr, n;
+
+	for (ord = 0; ord < (FSHDHUT_NODE_NR / 2); ord += 7) {
+		for (nr = 1; nr <= (FSHDHUT_NODE_NR - ord); nr += 5) {
+			fshdhut_init_keys(ord + nr, (unsigned int)nr);
+
+			for (n = 0; n < ord; n++)
+				fshd_heap_insert(fshdhut_heap,
+				                 (char *)&fshdhut_keys[n]);
+			if (ord)
+				fshd_heap_peek(fshdhut_heap);
+			fshdhut_check_nodes(fshdhut_heap, ord);
+			cute_ensure(fshdhut_heap->fshd_ordered == ord);
+
+			for (; n < (ord + nr); n++)
+				fshd_heap_insert(fshdhut_heap,
+				                 (char *)&fshdhut_keys[n]);
+			fshdhut_check_nodes(fshdhut_heap, ord + nr);
+
+			fshdhut_check_extract(fshdhut_heap, ord + nr);
+		}
+	}
+}
+
+/**
+ * Insert batches then extract part of them in a burst-then-drain fashion
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_batch, &fshdhut_ops)
+{
+	static const size_t bursts[] = { 1, 3, 17, 64, 100 };
+	int                 check[FSHDHUT_NODE_NR];
+	int                 out[FSHDHUT_NODE_NR];
+	unsigned int        b;
+
+	for (b = 0; b < array_nr(bursts); b++) {
+		size_t burst = bursts[b];
+		size_t first = 0, last = 0, cnt, n;
+
+		fshdhut_init_keys(FSHDHUT_NODE_NR, (unsigned int)b);
+
+		while (last < FSHDHUT_NODE_NR) {
+			size_t nr = FSHDHUT_NODE_NR - last;
+
+			if (nr > burst)
+				nr = burst;
+
+			fshd_heap_insert_batch(fshdhut_heap,
+			                       (char *)&fshdhut_keys[last], nr);
+			last += nr;
+			fshdhut_check_nodes(fshdhut_heap, last - first);
+
+			/* Drain till half a burst is left pending. */
+			for (n = last - nr; n < last; n++)
+				check[n] = fshdhut_keys[n];
+			qsort(&check[first], last - first, sizeof(check[0]),
+			      fshdhut_qsort_compare_min);
+
+			cnt = fshd_heap_extract_batch(fshdhut_heap,
+			                              (char *)out,
+			                              (last - first) -
+			                              (burst / 2));
+			cute_ensure(cnt == ((last - first) - (burst / 2)));
+			for (n = 0; n < cnt; n++)
+				cute_ensure(out[n] == check[first + n]);
+
+			first += cnt;
+			fshdhut_check_nodes(fshdhut_heap, last - first);
+		}
+
+		cnt = fshd_heap_extract_batch(fshdhut_heap, (char *)out,
+		                              FSHDHUT_NODE_NR);
+		cute_ensure(cnt == (last - first));
+		for (n = 0; n < cnt; n++)
+			cute_ensure(out[n] == check[first + n]);
+
+		cute_ensure(fshd_heap_empty(fshdhut_heap));
+	}
+}
+
+/**
+ * Build heaps of all sizes from unsorted data then extract nodes
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_build, &fshdhut_ops)
+{
+	size_t nr, n;
+
+	for (nr = 1; nr <= FSHDHUT_NODE_NR; nr++) {
+		fshdhut_init_keys(nr, 5U);
+		for (n = 0; n < nr; n++)
+			*(int *)fabs_tree_node(&fshdhut_heap->fshd_tree, n) =
+				fshdhut_keys[n];
+
+		fshd_heap_build(fshdhut_heap, nr);
+		cute_ensure(fshdhut_heap->fshd_ordered == nr);
+		fshdhut_check_nodes(fshdhut_heap, nr);
+		fshdhut_check_extract(fshdhut_heap, nr);
+	}
+}
+
+/**
+ * Check heaps initialized with caller supplied node storage, including single
+ * node ones
+ *
+ * @ingroup fshdhut
+ */
+CUTE_PNP_TEST(fshdhut_init_fini, &fshdhut)
+{
+	struct fshd_heap heap;
+	int              node;
+	int              key;
+
+	fshd_heap_init(&heap, (char *)&node, sizeof(node), 1,
+	               fshdhut_compare_min, fshdhut_copy);
+	cute_ensure(fshd_heap_empty(&heap));
+
+	key = 4;
+	fshd_heap_insert(&heap, (char *)&key);
+	cute_ensure(fshd_heap_full(&heap));
+	cute_ensure(*(int *)fshd_heap_peek(&heap) == 4);
+
+	key = -1;
+	fshd_heap_extract(&heap, (char *)&key);
+	cute_ensure(key == 4);
+	cute_ensure(fshd_heap_empty(&heap));
+
+	fshd_heap_fini(&heap);
+}
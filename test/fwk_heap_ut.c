@@ -930,3 +930,145 @@ CUTE_PNP_TEST(fwkhut_sort_unsorted_duplicates, &fwkhut_sort)
 }
 
 #endif /* defined(CONFIG_KARN_FWK_HEAP_SORT) */
+
+#if defined(CONFIG_KARN_FWK_HEAP_GROW)
+
+/* Large enough for nodes storage to cross FARR_MMAP_THRESHOLD. */
+#define FWKHUT_GROW_NR (100000U)
+
+static CUTE_PNP_SUITE(fwkhut_grow, &fwkhut);
+
+/**
+ * Grow a heap from a tiny capacity till node storage gets memory mapped then
+ * extract all nodes while shrinking it back
+ *
+ * @ingroup fwkhut
+ */
+CUTE_PNP_TEST(fwkhut_grow_shrink, &fwkhut_grow)
+{
+	struct fwk_heap heap;
+	unsigned int    n;
+	int             prev = -1;
+
+	cute_ensure(!fwk_heap_init_grow(&heap, sizeof(int), 4,
+	                                 fwkhut_compare_min, fwkhut_copy));
+	cute_ensure(fwk_heap_nr(&heap) == 4);
+
+	for (n = 0; n < FWKHUT_GROW_NR; n++) {
+		int key = (int)((n * 7919U) % FWKHUT_GROW_NR);
+
+		cute_ensure(!fwk_heap_insert_grow(&heap, (char *)&key));
+	}
+	cute_ensure(fwk_heap_count(&heap) == FWKHUT_GROW_NR);
+	cute_ensure(fwk_heap_nr(&heap) >= FWKHUT_GROW_NR);
+	cute_ensure((fwk_heap_nr(&heap) * sizeof(int)) >= FARR_MMAP_THRESHOLD);
+
+	for (n = 0; n < FWKHUT_GROW_NR; n++) {
+		int key;
+
+		fwk_heap_extract_shrink(&heap, (char *)&key, 16);
+		cute_ensure(key > prev);
+		prev = key;
+
+		/* Capacity is halved each time occupancy drops to a quarter. */
+		cute_ensure((fwk_heap_nr(&heap) == 16) ||
+		            (fwk_heap_count(&heap) > (fwk_heap_nr(&heap) / 4)));
+	}
+	cute_ensure(fwk_heap_empty(&heap));
+	cute_ensure(fwk_heap_nr(&heap) == 16);
+
+	fwk_heap_fini_grow(&heap);
+}
+
+/**
+ * Reserve room for nodes then fill heap without growing it
+ *
+ * @ingroup fwkhut
+ */
+CUTE_PNP_TEST(fwkhut_grow_reserve, &fwkhut_grow)
+{
+	struct fwk_heap heap;
+	const int      *check;
+	int             key;
+	unsigned int    n;
+
+	cute_ensure(!fwk_heap_init_grow(&heap, sizeof(int), 2,
+	                                 fwkhut_compare_min, fwkhut_copy));
+
+	key = 0;
+	cute_ensure(!fwk_heap_insert_grow(&heap, (char *)&key));
+
+	cute_ensure(!fwk_heap_reserve(&heap, 1000));
+	cute_ensure(fwk_heap_nr(&heap) == 1000);
+	cute_ensure(!fwk_heap_reserve(&heap, 10));
+	cute_ensure(fwk_heap_nr(&heap) == 1000);
+
+	check = (const int *)fwk_heap_peek(&heap);
+	cute_ensure(*check == 0);
+
+	for (n = 1; n < 1000; n++) {
+		key = (int)(1000 - n);
+		fwk_heap_insert(&heap, (char *)&key);
+	}
+	cute_ensure(fwk_heap_full(&heap));
+
+	for (n = 0; n < 1000; n++) {
+		fwk_heap_extract(&heap, (char *)&key);
+		cute_ensure(key == (int)n);
+	}
+
+	fwk_heap_fini_grow(&heap);
+}
+
+#endif /* defined(CONFIG_KARN_FWK_HEAP_GROW) */
+
+/* Batch sizes going through both sift up and rebuild insertion schemes. */
+static const unsigned int fwkhut_batch_sizes[] = { 10, 5, 60, 1, 24 };
+
+#define FWKHUT_BATCH_NR (100U)
+
+static CUTE_PNP_SUITE(fwkhut_batch, &fwkhut);
+
+/**
+ * Insert batches of nodes then extract them by batches
+ *
+ * @ingroup fwkhut
+ */
+CUTE_PNP_TEST(fwkhut_batch_insert_extract, &fwkhut_batch)
+{
+	struct fwk_heap heap;
+	int             nodes[FWKHUT_BATCH_NR];
+	int             keys[FWKHUT_BATCH_NR];
+	int             check[FWKHUT_BATCH_NR];
+	int             out[FWKHUT_BATCH_NR];
+	unsigned int    b, n, nr = 0;
+
+	for (n = 0; n < FWKHUT_BATCH_NR; n++)
+		keys[n] = (int)(((n * 37U) + 11U) % FWKHUT_BATCH_NR) / 2;
+
+	cute_ensure(!fwk_heap_init(&heap, (char *)nodes, sizeof(nodes[0]),
+	                           array_nr(nodes), fwkhut_compare_min,
+	                           fwkhut_copy));
+
+	for (b = 0; b < array_nr(fwkhut_batch_sizes); b++) {
+		fwk_heap_insert_batch(&heap, (char *)&keys[nr],
+		                      fwkhut_batch_sizes[b]);
+		nr += fwkhut_batch_sizes[b];
+		cute_ensure(fwk_heap_count(&heap) == nr);
+	}
+
+	memcpy(check, keys, sizeof(check));
+	qsort(check, nr, sizeof(check[0]), fwkhut_qsort_compare_min);
+
+	cute_ensure(fwk_heap_extract_batch(&heap, (char *)out, 30) == 30);
+	cute_ensure(fwk_heap_count(&heap) == (nr - 30));
+	cute_ensure(fwk_heap_extract_batch(&heap, (char *)&out[30],
+	                                   FWKHUT_BATCH_NR) == (nr - 30));
+	cute_ensure(fwk_heap_empty(&heap));
+	cute_ensure(!fwk_heap_extract_batch(&heap, (char *)out, 1));
+
+	for (n = 0; n < nr; n++)
+		cute_ensure(out[n] == check[n]);
+
+	fwk_heap_fini(&heap);
+}
@@ -1,11 +1,19 @@
 #include "karn_pt.h"
 #include <karn/fbnr_heap.h>
+#include <karn/fdary_heap.h>
+#include <karn/fkey_heap.h>
+#include <karn/fidx_heap.h>
+#include <karn/fmmx_heap.h>
+#include <karn/fshd_heap.h>
+#include <karn/radix_heap.h>
 #include <karn/fwk_heap.h>
 #include <karn/sbnm_heap.h>
 #include <karn/dbnm_heap.h>
 #include <karn/falloc.h>
 #include <karn/pbnm_heap.h>
 #include <karn/spair_heap.h>
+#include <karn/rpair_heap.h>
+#include <karn/rwk_heap.h>
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
@@ -21,10 +29,55 @@ struct hppt_iface {
 	void (*hppt_demote)(unsigned long long *nsecs);
 	//void (*hppt_merge)(unsigned long long *nsecs);
 	void (*hppt_build)(unsigned long long *nsecs);
+	void (*hppt_burst)(unsigned long long *nsecs);
+	void (*hppt_monotone)(unsigned long long *nsecs);
+	void (*hppt_sparse)(unsigned long long *nsecs);
 };
 
+/*
+ * Burst scheme: producers insert bursts of HPPT_BURST_NR keys while consumers
+ * drain first keys after each burst till half a burst is left pending, then
+ * the remaining ones.
+ */
+#define HPPT_BURST_NR (4096)
+
+/*
+ * Monotone scheme: a discrete event simulation like hold model where
+ * HPPT_MONOTONE_NR events are kept pending. Each step extracts the earliest
+ * event and schedules a new one, delayed from it by a key loaded from file
+ * shifted right by HPPT_MONOTONE_SHIFT bits. Extracted keys never decrease.
+ */
+#define HPPT_MONOTONE_NR    (65536)
+#define HPPT_MONOTONE_SHIFT (12)
+
+/*
+ * Sparse scheme: an insert heavy / extract light workload where all keys are
+ * inserted and the smallest pending one is extracted once every HPPT_SPARSE_NR
+ * insertions.
+ */
+#define HPPT_SPARSE_NR (64)
+
+#define hppt_monotone_delay(_key) \
+	((_key) >> HPPT_MONOTONE_SHIFT)
+
 static struct pt_entries hppt_entries;
 
+/*
+ * Comparison counting mode: when enabled, each key comparison performed while
+ * running a scheme is accounted for, heap setup included.
+ */
+static bool               hppt_count;
+static unsigned long long hppt_compare_nr;
+
+static inline int
+hppt_compare_min(const char *a, const char *b)
+{
+	if (hppt_count)
+		hppt_compare_nr++;
+
+	return pt_compare_min(a, b);
+}
+
 /******************************************************************************
  * Fixed array based binomial heap
  ******************************************************************************/
@@ -73,7 +126,7 @@ hppt_fbnr_validate(void)
 {
 	hppt_fbnr_heap = fbnr_heap_create(sizeof(*hppt_fbnr_keys),
 	                                  hppt_entries.pt_nr,
-	                                  pt_compare_min, pt_copy_key);
+	                                  hppt_compare_min, pt_copy_key);
 	if (!hppt_fbnr_heap)
 		return EXIT_FAILURE;
 
@@ -83,7 +136,7 @@ hppt_fbnr_validate(void)
 
 	memcpy(hppt_fbnr_heap->fbnr_tree.fabs_nodes.farr_slots,
 	       hppt_fbnr_keys,
-	       sizeof(*hppt_fbnr_keys * hppt_entries.pt_nr));
+	       sizeof(*hppt_fbnr_keys) * hppt_entries.pt_nr);
 	fbnr_heap_build(hppt_fbnr_heap, hppt_entries.pt_nr);
 	return hppt_fbnr_check_entries("build");
 }
@@ -152,7 +205,7 @@ hppt_fbnr_build(unsigned long long *nsecs)
 
 	memcpy(hppt_fbnr_heap->fbnr_tree.fabs_nodes.farr_slots,
 	       hppt_fbnr_keys,
-	       sizeof(*hppt_fbnr_keys * hppt_entries.pt_nr));
+	       sizeof(*hppt_fbnr_keys) * hppt_entries.pt_nr);
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
 	fbnr_heap_build(hppt_fbnr_heap, hppt_entries.pt_nr);
@@ -162,42 +215,136 @@ hppt_fbnr_build(unsigned long long *nsecs)
 	*nsecs = pt_tspec2ns(&elapse);
 }
 
+static void
+hppt_fbnr_burst(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     out[HPPT_BURST_NR];
+	unsigned int    *k = hppt_fbnr_keys;
+	int              n = hppt_entries.pt_nr;
+
+	fbnr_heap_clear(hppt_fbnr_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+
+		fbnr_heap_insert_batch(hppt_fbnr_heap, (char *)k, nr);
+		fbnr_heap_extract_batch(hppt_fbnr_heap, (char *)out,
+		                        fbnr_heap_count(hppt_fbnr_heap) -
+		                        (HPPT_BURST_NR / 2));
+
+		k += nr;
+		n -= nr;
+	}
+	while (fbnr_heap_extract_batch(hppt_fbnr_heap, (char *)out, array_nr(out)))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fbnr_monotone(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	int              n;
+
+	fbnr_heap_clear(hppt_fbnr_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; (n < HPPT_MONOTONE_NR) && (n < hppt_entries.pt_nr); n++) {
+		cur = hppt_monotone_delay(hppt_fbnr_keys[n]);
+		fbnr_heap_insert(hppt_fbnr_heap, (char *)&cur);
+	}
+	for (; n < hppt_entries.pt_nr; n++) {
+		fbnr_heap_extract(hppt_fbnr_heap, (char *)&cur);
+		cur += hppt_monotone_delay(hppt_fbnr_keys[n]);
+		fbnr_heap_insert(hppt_fbnr_heap, (char *)&cur);
+	}
+	while (!fbnr_heap_empty(hppt_fbnr_heap))
+		fbnr_heap_extract(hppt_fbnr_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fbnr_sparse(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	unsigned int    *k;
+	int              n;
+
+	fbnr_heap_clear(hppt_fbnr_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fbnr_keys; n < hppt_entries.pt_nr; n++, k++) {
+		fbnr_heap_insert(hppt_fbnr_heap, (char *)k);
+		if (!((n + 1) % HPPT_SPARSE_NR))
+			fbnr_heap_extract(hppt_fbnr_heap, (char *)&cur);
+	}
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
 #endif /* defined(CONFIG_KARN_FBNR_HEAP) */
 
 /******************************************************************************
- * Fixed array based weak heap
+ * Growable fixed array based binomial heap
  ******************************************************************************/
 
-#if defined(CONFIG_KARN_FWK_HEAP)
+#if defined(CONFIG_KARN_FBNR_HEAP_GROW)
 
-static unsigned int    *hppt_fwk_keys;
-static struct fwk_heap *hppt_fwk_heap;
+/*
+ * Initial capacity of growable heaps: start small so that insertion timings
+ * account for all reallocations required to reach the final heap size.
+ */
+#define HPPT_FBNRG_MIN_NR (16U)
 
-static void
-hppt_fwk_insert_bulk(void)
-{
-	unsigned int *k;
-	int           n;
+static unsigned int     *hppt_fbnrg_keys;
+static struct fbnr_heap  hppt_fbnrg_heap;
 
-	fwk_heap_clear(hppt_fwk_heap);
+static int
+hppt_fbnrg_reset(void)
+{
+	fbnr_heap_fini_grow(&hppt_fbnrg_heap);
 
-	for (n = 0, k = hppt_fwk_keys; n < hppt_entries.pt_nr; n++, k++)
-		fwk_heap_insert(hppt_fwk_heap, (char *)k);
+	return fbnr_heap_init_grow(&hppt_fbnrg_heap, sizeof(*hppt_fbnrg_keys),
+	                           HPPT_FBNRG_MIN_NR, hppt_compare_min,
+	                           pt_copy_key);
 }
 
 static int
-hppt_fwk_check_entries(const char *scheme)
+hppt_fbnrg_validate(void)
 {
-	unsigned int cur, old;
-	int          n;
+	unsigned int  cur, old;
+	unsigned int *k;
+	int           n;
 
-	fwk_heap_extract(hppt_fwk_heap, (char *)&old);
+	if (fbnr_heap_init_grow(&hppt_fbnrg_heap, sizeof(*hppt_fbnrg_keys),
+	                        HPPT_FBNRG_MIN_NR, hppt_compare_min,
+	                        pt_copy_key))
+		return EXIT_FAILURE;
+
+	for (n = 0, k = hppt_fbnrg_keys; n < hppt_entries.pt_nr; n++, k++)
+		if (fbnr_heap_insert_grow(&hppt_fbnrg_heap, (char *)k))
+			return EXIT_FAILURE;
 
+	fbnr_heap_extract_shrink(&hppt_fbnrg_heap, (char *)&old,
+	                         HPPT_FBNRG_MIN_NR);
 	for (n = 1; n < hppt_entries.pt_nr; n++) {
-		fwk_heap_extract(hppt_fwk_heap, (char *)&cur);
+		fbnr_heap_extract_shrink(&hppt_fbnrg_heap, (char *)&cur,
+		                         HPPT_FBNRG_MIN_NR);
 
 		if (old > cur) {
-			fprintf(stderr, "Bogus heap %s scheme\n", scheme);
+			fprintf(stderr, "Bogus heap insert/extract scheme\n");
 			return EXIT_FAILURE;
 		}
 
@@ -208,77 +355,39 @@ hppt_fwk_check_entries(const char *scheme)
 }
 
 static int
-hppt_fwk_validate(void)
-{
-	hppt_fwk_heap = fwk_heap_create(sizeof(*hppt_fwk_keys),
-	                                hppt_entries.pt_nr,
-	                                pt_compare_min, pt_copy_key);
-	if (!hppt_fwk_heap)
-		return EXIT_FAILURE;
-
-	hppt_fwk_insert_bulk();
-	if (hppt_fwk_check_entries("insert/extract"))
-		return EXIT_FAILURE;
-
-	memcpy(hppt_fwk_heap->fwk_nodes.farr_slots,
-	       hppt_fwk_keys,
-	       sizeof(*hppt_fwk_keys * hppt_entries.pt_nr));
-	fwk_heap_build(hppt_fwk_heap, hppt_entries.pt_nr);
-
-	return hppt_fwk_check_entries("build");
-}
-
-static int
-hppt_fwk_load(const char *pathname)
+hppt_fbnrg_load(const char *pathname)
 {
 	unsigned int *k;
 
 	if (pt_open_entries(pathname, &hppt_entries))
 		return EXIT_FAILURE;
 
-	hppt_fwk_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
-	if (!hppt_fwk_keys)
+	hppt_fbnrg_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fbnrg_keys)
 		return EXIT_FAILURE;
 
 	pt_init_entry_iter(&hppt_entries);
 
-	k = hppt_fwk_keys;
+	k = hppt_fbnrg_keys;
 	while (!pt_iter_entry(&hppt_entries, k))
 		k++;
 
-	return hppt_fwk_validate();
+	return hppt_fbnrg_validate();
 }
 
 static void
-hppt_fwk_insert(unsigned long long *nsecs)
+hppt_fbnrg_insert(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
 	unsigned int    *k;
 	int              n;
 
-	fwk_heap_clear(hppt_fwk_heap);
-
-	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	for (n = 0, k = hppt_fwk_keys; n < hppt_entries.pt_nr; n++, k++)
-		fwk_heap_insert(hppt_fwk_heap, (char *)k);
-	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
-
-	elapse = pt_tspec_sub(&elapse, &start);
-	*nsecs = pt_tspec2ns(&elapse);
-}
-
-static void
-hppt_fwk_extract(unsigned long long *nsecs)
-{
-	struct timespec start, elapse;
-	unsigned int    cur;
-	int             n;
-
-	hppt_fwk_insert_bulk();
+	if (hppt_fbnrg_reset())
+		return;
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	for (n = 0; n < hppt_entries.pt_nr; n++)
-		fwk_heap_extract(hppt_fwk_heap, (char *)&cur);
+	for (n = 0, k = hppt_fbnrg_keys; n < hppt_entries.pt_nr; n++, k++)
+		fbnr_heap_insert_grow(&hppt_fbnrg_heap, (char *)k);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -286,73 +395,67 @@ hppt_fwk_extract(unsigned long long *nsecs)
 }
 
 static void
-hppt_fwk_build(unsigned long long *nsecs)
+hppt_fbnrg_extract(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
+	unsigned int     cur;
+	unsigned int    *k;
+	int              n;
 
-	memcpy(hppt_fwk_heap->fwk_nodes.farr_slots,
-	       hppt_fwk_keys,
-	       sizeof(*hppt_fwk_keys * hppt_entries.pt_nr));
+	if (hppt_fbnrg_reset())
+		return;
+
+	for (n = 0, k = hppt_fbnrg_keys; n < hppt_entries.pt_nr; n++, k++)
+		fbnr_heap_insert_grow(&hppt_fbnrg_heap, (char *)k);
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	fwk_heap_build(hppt_fwk_heap, hppt_entries.pt_nr);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fbnr_heap_extract_shrink(&hppt_fbnrg_heap, (char *)&cur,
+		                         HPPT_FBNRG_MIN_NR);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
 	*nsecs = pt_tspec2ns(&elapse);
 }
 
-#endif /* defined(CONFIG_KARN_FWK_HEAP) */
+#endif /* defined(CONFIG_KARN_FBNR_HEAP_GROW) */
 
 /******************************************************************************
- * Singly linked list based binomial heap
+ * Fixed array based d-ary heap
  ******************************************************************************/
 
-#if defined(CONFIG_KARN_SBNM_HEAP)
-
-struct hppt_sbnm_key {
-	struct sbnm_heap_node node;
-	unsigned int          value;
-};
-
-static struct hppt_sbnm_key *sbnm_heap_keys;
-static unsigned int          sbnm_heap_min;
+#if defined(CONFIG_KARN_FDARY_HEAP)
 
-static int
-hppt_sbnm_compare_min(const struct sbnm_heap_node *first,
-                      const struct sbnm_heap_node *second)
-{
-	return pt_compare_min((char *)&((struct hppt_sbnm_key *)first)->value,
-	                      (char *)&((struct hppt_sbnm_key *)second)->value);
-}
+static unsigned int      *hppt_fdary_keys;
+static struct fdary_heap *hppt_fdary_heap;
 
 static void
-hppt_sbnm_insert_bulk(struct sbnm_heap *heap)
+hppt_fdary_insert_bulk(void)
 {
-	int                   n;
-	struct hppt_sbnm_key *k;
+	unsigned int *k;
+	int           n;
 
-	sbnm_heap_init(heap, hppt_sbnm_compare_min);
+	fdary_heap_clear(hppt_fdary_heap);
 
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		sbnm_heap_insert(heap, &k->node);
+	for (n = 0, k = hppt_fdary_keys; n < hppt_entries.pt_nr; n++, k++)
+		fdary_heap_insert(hppt_fdary_heap, (char *)k);
 }
 
 static int
-hppt_sbnm_check_heap(struct sbnm_heap *heap)
+hppt_fdary_check_entries(const char *scheme)
 {
-	int                   n;
-	struct hppt_sbnm_key *cur, *old;
+	unsigned int cur, old;
+	int          n;
 
-	old = sbnm_heap_entry(sbnm_heap_extract(heap),
-	                      struct hppt_sbnm_key, node);
+	fdary_heap_extract(hppt_fdary_heap, (char *)&old);
 
 	for (n = 1; n < hppt_entries.pt_nr; n++) {
-		cur = sbnm_heap_entry(sbnm_heap_extract(heap),
-		                      struct hppt_sbnm_key, node);
+		fdary_heap_extract(hppt_fdary_heap, (char *)&cur);
 
-		if (old->value > cur->value)
+		if (old > cur) {
+			fprintf(stderr, "Bogus heap %s scheme\n", scheme);
 			return EXIT_FAILURE;
+		}
 
 		old = cur;
 	}
@@ -361,88 +464,71 @@ hppt_sbnm_check_heap(struct sbnm_heap *heap)
 }
 
 static int
-hppt_sbnm_validate(void)
+hppt_fdary_validate(unsigned int arity)
 {
-	struct sbnm_heap      heap;
-	int                   n;
-	struct hppt_sbnm_key *k;
-
-	hppt_sbnm_insert_bulk(&heap);
-
-	if (hppt_sbnm_check_heap(&heap)) {
-		fprintf(stderr, "Bogus heap insert / extract scheme\n");
-		return EXIT_FAILURE;
-	}
-
-	hppt_sbnm_insert_bulk(&heap);
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= sbnm_heap_min;
-		sbnm_heap_promote(&heap, &k->node);
-	}
-	if (hppt_sbnm_check_heap(&heap)) {
-		fprintf(stderr, "Bogus heap promote scheme\n");
+	hppt_fdary_heap = fdary_heap_create(sizeof(*hppt_fdary_keys),
+	                                    hppt_entries.pt_nr, arity,
+	                                    hppt_compare_min, pt_copy_key);
+	if (!hppt_fdary_heap)
 		return EXIT_FAILURE;
-	}
-
-	/*
-	 * Reset keys to their original values so that next computation loop
-	 * gives consistent numbers...
-	 */
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += sbnm_heap_min;
 
-	hppt_sbnm_insert_bulk(&heap);
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value += sbnm_heap_min;
-		sbnm_heap_demote(&heap, &k->node);
-	}
-	if (hppt_sbnm_check_heap(&heap)) {
-		fprintf(stderr, "Bogus heap demote scheme\n");
+	hppt_fdary_insert_bulk();
+	if (hppt_fdary_check_entries("insert/extract"))
 		return EXIT_FAILURE;
-	}
 
-	/*
-	 * Reset keys to their original values so that next computation loop
-	 * gives consistent numbers...
-	 */
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value -= sbnm_heap_min;
+	memcpy(hppt_fdary_heap->fdary_tree.fabs_nodes.farr_slots,
+	       hppt_fdary_keys,
+	       sizeof(*hppt_fdary_keys) * hppt_entries.pt_nr);
+	fdary_heap_build(hppt_fdary_heap, hppt_entries.pt_nr);
 
-	return EXIT_SUCCESS;
+	return hppt_fdary_check_entries("build");
 }
 
 static int
-hppt_sbnm_load(const char *pathname)
+hppt_fdary_load(const char *pathname, unsigned int arity)
 {
-	struct hppt_sbnm_key *k;
+	unsigned int *k;
 
 	if (pt_open_entries(pathname, &hppt_entries))
 		return EXIT_FAILURE;
 
-	sbnm_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*sbnm_heap_keys));
-	if (!sbnm_heap_keys)
+	hppt_fdary_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fdary_keys)
 		return EXIT_FAILURE;
 
 	pt_init_entry_iter(&hppt_entries);
 
-	k = sbnm_heap_keys;
-	sbnm_heap_min = UINT_MAX;
-	while (!pt_iter_entry(&hppt_entries, &k->value)) {
-		sbnm_heap_min = umin(k->value, sbnm_heap_min);
+	k = hppt_fdary_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
 		k++;
-	}
 
-	return hppt_sbnm_validate();
+	return hppt_fdary_validate(arity);
+}
+
+static int
+hppt_fdary4_load(const char *pathname)
+{
+	return hppt_fdary_load(pathname, 4);
+}
+
+static int
+hppt_fdary8_load(const char *pathname)
+{
+	return hppt_fdary_load(pathname, 8);
 }
 
 static void
-hppt_sbnm_insert(unsigned long long *nsecs)
+hppt_fdary_insert(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
-	struct sbnm_heap heap;
+	unsigned int    *k;
+	int              n;
+
+	fdary_heap_clear(hppt_fdary_heap);
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	hppt_sbnm_insert_bulk(&heap);
+	for (n = 0, k = hppt_fdary_keys; n < hppt_entries.pt_nr; n++, k++)
+		fdary_heap_insert(hppt_fdary_heap, (char *)k);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -450,17 +536,17 @@ hppt_sbnm_insert(unsigned long long *nsecs)
 }
 
 static void
-hppt_sbnm_extract(unsigned long long *nsecs)
+hppt_fdary_extract(unsigned long long *nsecs)
 {
-	struct timespec  start, elapse;
-	struct sbnm_heap heap;
-	int              n;
+	struct timespec start, elapse;
+	unsigned int    cur;
+	int             n;
 
-	hppt_sbnm_insert_bulk(&heap);
+	hppt_fdary_insert_bulk();
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
 	for (n = 0; n < hppt_entries.pt_nr; n++)
-		sbnm_heap_extract(&heap);
+		fdary_heap_extract(hppt_fdary_heap, (char *)&cur);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -468,20 +554,2245 @@ hppt_sbnm_extract(unsigned long long *nsecs)
 }
 
 static void
-hppt_sbnm_remove(unsigned long long *nsecs)
+hppt_fdary_build(unsigned long long *nsecs)
 {
-	int                   n;
-	struct hppt_sbnm_key *k;
-	struct sbnm_heap      heap;
+	struct timespec  start, elapse;
+
+	memcpy(hppt_fdary_heap->fdary_tree.fabs_nodes.farr_slots,
+	       hppt_fdary_keys,
+	       sizeof(*hppt_fdary_keys) * hppt_entries.pt_nr);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	fdary_heap_build(hppt_fdary_heap, hppt_entries.pt_nr);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fdary_burst(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     out[HPPT_BURST_NR];
+	unsigned int    *k = hppt_fdary_keys;
+	int              n = hppt_entries.pt_nr;
+
+	fdary_heap_clear(hppt_fdary_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+
+		fdary_heap_insert_batch(hppt_fdary_heap, (char *)k, nr);
+		fdary_heap_extract_batch(hppt_fdary_heap, (char *)out,
+		                         fdary_heap_count(hppt_fdary_heap) -
+		                         (HPPT_BURST_NR / 2));
+
+		k += nr;
+		n -= nr;
+	}
+	while (fdary_heap_extract_batch(hppt_fdary_heap, (char *)out, array_nr(out)))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_FDARY_HEAP) */
+
+/******************************************************************************
+ * Fixed array based integer key heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FKEY_HEAP)
+
+static unsigned int            *hppt_fkey_keys;
+static struct fkey_uint32_heap  hppt_fkey_heap;
+
+static void
+hppt_fkey_insert_bulk(void)
+{
+	int n;
+
+	fkey_uint32_heap_clear(&hppt_fkey_heap);
+
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fkey_uint32_heap_insert(&hppt_fkey_heap, hppt_fkey_keys[n],
+		                        (uintptr_t)n);
+}
+
+static int
+hppt_fkey_validate(void)
+{
+	unsigned int cur, old;
+	uintptr_t    payload;
+	int          n;
+
+	if (fkey_uint32_heap_init(&hppt_fkey_heap, hppt_entries.pt_nr))
+		return EXIT_FAILURE;
+
+	hppt_fkey_insert_bulk();
+
+	old = fkey_uint32_heap_extract(&hppt_fkey_heap, &payload);
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		cur = fkey_uint32_heap_extract(&hppt_fkey_heap, &payload);
+
+		if ((old > cur) || (hppt_fkey_keys[payload] != cur)) {
+			fprintf(stderr, "Bogus heap insert/extract scheme\n");
+			return EXIT_FAILURE;
+		}
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_fkey_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_fkey_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fkey_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_fkey_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
+		k++;
+
+	return hppt_fkey_validate();
+}
+
+static void
+hppt_fkey_insert(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	int             n;
+
+	fkey_uint32_heap_clear(&hppt_fkey_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fkey_uint32_heap_insert(&hppt_fkey_heap, hppt_fkey_keys[n],
+		                        (uintptr_t)n);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fkey_extract(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	uintptr_t       payload;
+	int             n;
+
+	hppt_fkey_insert_bulk();
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fkey_uint32_heap_extract(&hppt_fkey_heap, &payload);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fkey_burst(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	uintptr_t        payloads[HPPT_BURST_NR];
+	unsigned int     out[HPPT_BURST_NR];
+	unsigned int    *k = hppt_fkey_keys;
+	int              n = hppt_entries.pt_nr;
+	int              p;
+
+	for (p = 0; p < HPPT_BURST_NR; p++)
+		payloads[p] = (uintptr_t)p;
+
+	fkey_uint32_heap_clear(&hppt_fkey_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+
+		fkey_uint32_heap_insert_batch(&hppt_fkey_heap, k, payloads, nr);
+		fkey_uint32_heap_extract_batch(
+			&hppt_fkey_heap, out, NULL,
+			fkey_uint32_heap_count(&hppt_fkey_heap) -
+			(HPPT_BURST_NR / 2));
+
+		k += nr;
+		n -= nr;
+	}
+	while (fkey_uint32_heap_extract_batch(&hppt_fkey_heap, out, NULL,
+	                                      array_nr(out)))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fkey_monotone(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	int              n;
+
+	fkey_uint32_heap_clear(&hppt_fkey_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; (n < HPPT_MONOTONE_NR) && (n < hppt_entries.pt_nr); n++)
+		fkey_uint32_heap_insert(&hppt_fkey_heap,
+		                        hppt_monotone_delay(hppt_fkey_keys[n]),
+		                        (uintptr_t)n);
+	for (; n < hppt_entries.pt_nr; n++) {
+		uintptr_t payload;
+
+		cur = fkey_uint32_heap_extract(&hppt_fkey_heap, &payload);
+		fkey_uint32_heap_insert(&hppt_fkey_heap,
+		                        cur +
+		                        hppt_monotone_delay(hppt_fkey_keys[n]),
+		                        payload);
+	}
+	while (!fkey_uint32_heap_empty(&hppt_fkey_heap))
+		fkey_uint32_heap_extract(&hppt_fkey_heap, NULL);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_FKEY_HEAP) */
+
+/******************************************************************************
+ * Fixed array based indexed binary heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FIDX_HEAP)
+
+static unsigned int     *hppt_fidx_keys;
+static unsigned int      hppt_fidx_min;
+static struct fidx_heap *hppt_fidx_heap;
+
+static void
+hppt_fidx_insert_bulk(void)
+{
+	unsigned int *k;
+	int           n;
+
+	fidx_heap_clear(hppt_fidx_heap);
+
+	for (n = 0, k = hppt_fidx_keys; n < hppt_entries.pt_nr; n++, k++)
+		fidx_heap_insert(hppt_fidx_heap, n, (char *)k);
+}
+
+static int
+hppt_fidx_check_entries(const char *scheme)
+{
+	unsigned int cur, old;
+	int          n;
+
+	fidx_heap_extract(hppt_fidx_heap, (char *)&old);
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		fidx_heap_extract(hppt_fidx_heap, (char *)&cur);
+
+		if (old > cur) {
+			fprintf(stderr, "Bogus heap %s scheme\n", scheme);
+			return EXIT_FAILURE;
+		}
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_fidx_validate(void)
+{
+	unsigned int key;
+	int          n;
+
+	hppt_fidx_heap = fidx_heap_create(sizeof(*hppt_fidx_keys),
+	                                  hppt_entries.pt_nr,
+	                                  hppt_compare_min, pt_copy_key);
+	if (!hppt_fidx_heap)
+		return EXIT_FAILURE;
+
+	hppt_fidx_insert_bulk();
+	if (hppt_fidx_check_entries("insert/extract"))
+		return EXIT_FAILURE;
+
+	hppt_fidx_insert_bulk();
+	for (n = 0; n < hppt_entries.pt_nr; n++) {
+		key = hppt_fidx_keys[n] - hppt_fidx_min;
+		fidx_heap_promote(hppt_fidx_heap, n, (char *)&key);
+	}
+	if (hppt_fidx_check_entries("promote"))
+		return EXIT_FAILURE;
+
+	hppt_fidx_insert_bulk();
+	for (n = 0; n < hppt_entries.pt_nr; n++) {
+		key = hppt_fidx_keys[n] + hppt_fidx_min;
+		fidx_heap_demote(hppt_fidx_heap, n, (char *)&key);
+	}
+	if (hppt_fidx_check_entries("demote"))
+		return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_fidx_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_fidx_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fidx_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_fidx_keys;
+	hppt_fidx_min = UINT_MAX;
+	while (!pt_iter_entry(&hppt_entries, k)) {
+		hppt_fidx_min = umin(*k, hppt_fidx_min);
+		k++;
+	}
+
+	return hppt_fidx_validate();
+}
+
+static void
+hppt_fidx_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *k;
+	int              n;
+
+	fidx_heap_clear(hppt_fidx_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fidx_keys; n < hppt_entries.pt_nr; n++, k++)
+		fidx_heap_insert(hppt_fidx_heap, n, (char *)k);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fidx_extract(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    cur;
+	int             n;
+
+	hppt_fidx_insert_bulk();
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fidx_heap_extract(hppt_fidx_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fidx_remove(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	int             n;
+
+	*nsecs = 0;
+
+	hppt_fidx_insert_bulk();
+
+	for (n = 0; n < hppt_entries.pt_nr; n++) {
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		fidx_heap_remove(hppt_fidx_heap, n, NULL);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+}
+
+static void
+hppt_fidx_promote(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    key;
+	int             n;
+
+	*nsecs = 0;
+
+	hppt_fidx_insert_bulk();
+
+	for (n = 0; n < hppt_entries.pt_nr; n++) {
+		key = hppt_fidx_keys[n] - hppt_fidx_min;
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		fidx_heap_promote(hppt_fidx_heap, n, (char *)&key);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+}
+
+static void
+hppt_fidx_demote(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    key;
+	int             n;
+
+	*nsecs = 0;
+
+	hppt_fidx_insert_bulk();
+
+	for (n = 0; n < hppt_entries.pt_nr; n++) {
+		key = hppt_fidx_keys[n] + hppt_fidx_min;
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		fidx_heap_demote(hppt_fidx_heap, n, (char *)&key);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+}
+
+#endif /* defined(CONFIG_KARN_FIDX_HEAP) */
+
+/******************************************************************************
+ * Fixed array based min-max heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FMMX_HEAP)
+
+static unsigned int     *hppt_fmmx_keys;
+static struct fmmx_heap *hppt_fmmx_heap;
+
+static void
+hppt_fmmx_insert_bulk(void)
+{
+	unsigned int *k;
+	int           n;
+
+	fmmx_heap_clear(hppt_fmmx_heap);
+
+	for (n = 0, k = hppt_fmmx_keys; n < hppt_entries.pt_nr; n++, k++)
+		fmmx_heap_insert(hppt_fmmx_heap, (char *)k);
+}
+
+/* Extract smallest keys from one half and greatest keys from the other. */
+static int
+hppt_fmmx_check_entries(const char *scheme)
+{
+	unsigned int min, max, cur;
+	int          n;
+
+	fmmx_heap_extract_min(hppt_fmmx_heap, (char *)&min);
+	max = min;
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		if (n & 1) {
+			fmmx_heap_extract_max(hppt_fmmx_heap, (char *)&cur);
+			if ((n > 1) && (cur > max))
+				goto err;
+			max = cur;
+		}
+		else {
+			fmmx_heap_extract_min(hppt_fmmx_heap, (char *)&cur);
+			if (cur < min)
+				goto err;
+			min = cur;
+		}
+
+		if (min > max)
+			goto err;
+	}
+
+	return EXIT_SUCCESS;
+
+err:
+	fprintf(stderr, "Bogus heap %s scheme\n", scheme);
+	return EXIT_FAILURE;
+}
+
+static int
+hppt_fmmx_validate(void)
+{
+	hppt_fmmx_heap = fmmx_heap_create(sizeof(*hppt_fmmx_keys),
+	                                  hppt_entries.pt_nr,
+	                                  hppt_compare_min, pt_copy_key);
+	if (!hppt_fmmx_heap)
+		return EXIT_FAILURE;
+
+	hppt_fmmx_insert_bulk();
+	if (hppt_fmmx_check_entries("insert/extract"))
+		return EXIT_FAILURE;
+
+	memcpy(hppt_fmmx_heap->fmmx_tree.fabs_nodes.farr_slots,
+	       hppt_fmmx_keys,
+	       sizeof(*hppt_fmmx_keys) * hppt_entries.pt_nr);
+	fmmx_heap_build(hppt_fmmx_heap, hppt_entries.pt_nr);
+	return hppt_fmmx_check_entries("build");
+}
+
+static int
+hppt_fmmx_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_fmmx_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fmmx_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_fmmx_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
+		k++;
+
+	return hppt_fmmx_validate();
+}
+
+static void
+hppt_fmmx_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *k;
+	int              n;
+
+	fmmx_heap_clear(hppt_fmmx_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fmmx_keys; n < hppt_entries.pt_nr; n++, k++)
+		fmmx_heap_insert(hppt_fmmx_heap, (char *)k);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fmmx_extract(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    cur;
+	int             n;
+
+	hppt_fmmx_insert_bulk();
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fmmx_heap_extract_min(hppt_fmmx_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fmmx_build(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+
+	memcpy(hppt_fmmx_heap->fmmx_tree.fabs_nodes.farr_slots,
+	       hppt_fmmx_keys,
+	       sizeof(*hppt_fmmx_keys) * hppt_entries.pt_nr);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	fmmx_heap_build(hppt_fmmx_heap, hppt_entries.pt_nr);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fmmx_monotone(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	int              n;
+
+	fmmx_heap_clear(hppt_fmmx_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; (n < HPPT_MONOTONE_NR) && (n < hppt_entries.pt_nr); n++) {
+		cur = hppt_monotone_delay(hppt_fmmx_keys[n]);
+		fmmx_heap_insert(hppt_fmmx_heap, (char *)&cur);
+	}
+	for (; n < hppt_entries.pt_nr; n++) {
+		fmmx_heap_extract_min(hppt_fmmx_heap, (char *)&cur);
+		cur += hppt_monotone_delay(hppt_fmmx_keys[n]);
+		fmmx_heap_insert(hppt_fmmx_heap, (char *)&cur);
+	}
+	while (!fmmx_heap_empty(hppt_fmmx_heap))
+		fmmx_heap_extract_min(hppt_fmmx_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_FMMX_HEAP) */
+
+/******************************************************************************
+ * Fixed array based shadow heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FSHD_HEAP)
+
+static unsigned int     *hppt_fshd_keys;
+static struct fshd_heap *hppt_fshd_heap;
+
+static void
+hppt_fshd_insert_bulk(void)
+{
+	unsigned int *k;
+	int           n;
+
+	fshd_heap_clear(hppt_fshd_heap);
+
+	for (n = 0, k = hppt_fshd_keys; n < hppt_entries.pt_nr; n++, k++)
+		fshd_heap_insert(hppt_fshd_heap, (char *)k);
+}
+
+static int
+hppt_fshd_check_entries(const char *scheme)
+{
+	unsigned int cur, old;
+	int          n;
+
+	fshd_heap_extract(hppt_fshd_heap, (char *)&old);
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		fshd_heap_extract(hppt_fshd_heap, (char *)&cur);
+
+		if (old > cur) {
+			fprintf(stderr, "Bogus heap %s scheme\n", scheme);
+			return EXIT_FAILURE;
+		}
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_fshd_validate(void)
+{
+	hppt_fshd_heap = fshd_heap_create(sizeof(*hppt_fshd_keys),
+	                                  hppt_entries.pt_nr,
+	                                  hppt_compare_min, pt_copy_key);
+	if (!hppt_fshd_heap)
+		return EXIT_FAILURE;
+
+	hppt_fshd_insert_bulk();
+	if (hppt_fshd_check_entries("insert/extract"))
+		return EXIT_FAILURE;
+
+	memcpy(hppt_fshd_heap->fshd_tree.fabs_nodes.farr_slots,
+	       hppt_fshd_keys,
+	       sizeof(*hppt_fshd_keys) * hppt_entries.pt_nr);
+	fshd_heap_build(hppt_fshd_heap, hppt_entries.pt_nr);
+	return hppt_fshd_check_entries("build");
+}
+
+static int
+hppt_fshd_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_fshd_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fshd_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_fshd_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
+		k++;
+
+	return hppt_fshd_validate();
+}
+
+static void
+hppt_fshd_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *k;
+	int              n;
+
+	fshd_heap_clear(hppt_fshd_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fshd_keys; n < hppt_entries.pt_nr; n++, k++)
+		fshd_heap_insert(hppt_fshd_heap, (char *)k);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fshd_extract(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    cur;
+	int             n;
+
+	hppt_fshd_insert_bulk();
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fshd_heap_extract(hppt_fshd_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fshd_build(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+
+	memcpy(hppt_fshd_heap->fshd_tree.fabs_nodes.farr_slots,
+	       hppt_fshd_keys,
+	       sizeof(*hppt_fshd_keys) * hppt_entries.pt_nr);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	fshd_heap_build(hppt_fshd_heap, hppt_entries.pt_nr);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fshd_burst(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     out[HPPT_BURST_NR];
+	unsigned int    *k = hppt_fshd_keys;
+	int              n = hppt_entries.pt_nr;
+
+	fshd_heap_clear(hppt_fshd_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+
+		fshd_heap_insert_batch(hppt_fshd_heap, (char *)k, nr);
+		fshd_heap_extract_batch(hppt_fshd_heap, (char *)out,
+		                        fshd_heap_count(hppt_fshd_heap) -
+		                        (HPPT_BURST_NR / 2));
+
+		k += nr;
+		n -= nr;
+	}
+	while (fshd_heap_extract_batch(hppt_fshd_heap, (char *)out,
+	                               array_nr(out)))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fshd_monotone(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	int              n;
+
+	fshd_heap_clear(hppt_fshd_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; (n < HPPT_MONOTONE_NR) && (n < hppt_entries.pt_nr); n++) {
+		cur = hppt_monotone_delay(hppt_fshd_keys[n]);
+		fshd_heap_insert(hppt_fshd_heap, (char *)&cur);
+	}
+	for (; n < hppt_entries.pt_nr; n++) {
+		fshd_heap_extract(hppt_fshd_heap, (char *)&cur);
+		cur += hppt_monotone_delay(hppt_fshd_keys[n]);
+		fshd_heap_insert(hppt_fshd_heap, (char *)&cur);
+	}
+	while (!fshd_heap_empty(hppt_fshd_heap))
+		fshd_heap_extract(hppt_fshd_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fshd_sparse(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	unsigned int    *k;
+	int              n;
+
+	fshd_heap_clear(hppt_fshd_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fshd_keys; n < hppt_entries.pt_nr; n++, k++) {
+		fshd_heap_insert(hppt_fshd_heap, (char *)k);
+		if (!((n + 1) % HPPT_SPARSE_NR))
+			fshd_heap_extract(hppt_fshd_heap, (char *)&cur);
+	}
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_FSHD_HEAP) */
+
+/******************************************************************************
+ * Radix heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_RADIX_HEAP)
+
+static unsigned int           *hppt_radix_keys;
+static struct radix_heap_node *hppt_radix_nodes;
+static struct radix_heap       hppt_radix_heap;
+
+static void
+hppt_radix_insert_bulk(void)
+{
+	int n;
+
+	radix_heap_init(&hppt_radix_heap, 0);
+
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		radix_heap_insert(&hppt_radix_heap, &hppt_radix_nodes[n],
+		                  hppt_radix_keys[n]);
+}
+
+static int
+hppt_radix_check_entries(const char *scheme)
+{
+	uint64_t cur, old;
+	int      n;
+
+	old = radix_heap_node_key(radix_heap_extract(&hppt_radix_heap));
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		cur = radix_heap_node_key(radix_heap_extract(&hppt_radix_heap));
+
+		if (old > cur) {
+			fprintf(stderr, "Bogus heap %s scheme\n", scheme);
+			return EXIT_FAILURE;
+		}
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_radix_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_radix_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_radix_keys)
+		return EXIT_FAILURE;
+
+	hppt_radix_nodes = malloc(sizeof(*hppt_radix_nodes) *
+	                          hppt_entries.pt_nr);
+	if (!hppt_radix_nodes)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_radix_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
+		k++;
+
+	hppt_radix_insert_bulk();
+
+	return hppt_radix_check_entries("insert/extract");
+}
+
+static void
+hppt_radix_insert(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	int             n;
+
+	radix_heap_init(&hppt_radix_heap, 0);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		radix_heap_insert(&hppt_radix_heap, &hppt_radix_nodes[n],
+		                  hppt_radix_keys[n]);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_radix_extract(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	int             n;
+
+	hppt_radix_insert_bulk();
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		radix_heap_extract(&hppt_radix_heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_radix_monotone(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	int              n;
+
+	radix_heap_init(&hppt_radix_heap, 0);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; (n < HPPT_MONOTONE_NR) && (n < hppt_entries.pt_nr); n++)
+		radix_heap_insert(&hppt_radix_heap, &hppt_radix_nodes[n],
+		                  hppt_monotone_delay(hppt_radix_keys[n]));
+	for (; n < hppt_entries.pt_nr; n++) {
+		struct radix_heap_node *node;
+
+		node = radix_heap_extract(&hppt_radix_heap);
+		radix_heap_insert(&hppt_radix_heap, node,
+		                  radix_heap_node_key(node) +
+		                  hppt_monotone_delay(hppt_radix_keys[n]));
+	}
+	while (!radix_heap_empty(&hppt_radix_heap))
+		radix_heap_extract(&hppt_radix_heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_RADIX_HEAP) */
+
+/******************************************************************************
+ * Fixed array based weak heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FWK_HEAP)
+
+static unsigned int    *hppt_fwk_keys;
+static struct fwk_heap *hppt_fwk_heap;
+
+static void
+hppt_fwk_insert_bulk(void)
+{
+	unsigned int *k;
+	int           n;
+
+	fwk_heap_clear(hppt_fwk_heap);
+
+	for (n = 0, k = hppt_fwk_keys; n < hppt_entries.pt_nr; n++, k++)
+		fwk_heap_insert(hppt_fwk_heap, (char *)k);
+}
+
+static int
+hppt_fwk_check_entries(const char *scheme)
+{
+	unsigned int cur, old;
+	int          n;
+
+	fwk_heap_extract(hppt_fwk_heap, (char *)&old);
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		fwk_heap_extract(hppt_fwk_heap, (char *)&cur);
+
+		if (old > cur) {
+			fprintf(stderr, "Bogus heap %s scheme\n", scheme);
+			return EXIT_FAILURE;
+		}
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_fwk_validate(void)
+{
+	hppt_fwk_heap = fwk_heap_create(sizeof(*hppt_fwk_keys),
+	                                hppt_entries.pt_nr,
+	                                hppt_compare_min, pt_copy_key);
+	if (!hppt_fwk_heap)
+		return EXIT_FAILURE;
+
+	hppt_fwk_insert_bulk();
+	if (hppt_fwk_check_entries("insert/extract"))
+		return EXIT_FAILURE;
+
+	memcpy(hppt_fwk_heap->fwk_nodes.farr_slots,
+	       hppt_fwk_keys,
+	       sizeof(*hppt_fwk_keys * hppt_entries.pt_nr));
+	fwk_heap_build(hppt_fwk_heap, hppt_entries.pt_nr);
+
+	return hppt_fwk_check_entries("build");
+}
+
+static int
+hppt_fwk_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_fwk_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fwk_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_fwk_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
+		k++;
+
+	return hppt_fwk_validate();
+}
+
+static void
+hppt_fwk_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *k;
+	int              n;
+
+	fwk_heap_clear(hppt_fwk_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fwk_keys; n < hppt_entries.pt_nr; n++, k++)
+		fwk_heap_insert(hppt_fwk_heap, (char *)k);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fwk_extract(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    cur;
+	int             n;
+
+	hppt_fwk_insert_bulk();
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fwk_heap_extract(hppt_fwk_heap, (char *)&cur);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fwk_build(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+
+	memcpy(hppt_fwk_heap->fwk_nodes.farr_slots,
+	       hppt_fwk_keys,
+	       sizeof(*hppt_fwk_keys * hppt_entries.pt_nr));
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	fwk_heap_build(hppt_fwk_heap, hppt_entries.pt_nr);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fwk_burst(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     out[HPPT_BURST_NR];
+	unsigned int    *k = hppt_fwk_keys;
+	int              n = hppt_entries.pt_nr;
+
+	fwk_heap_clear(hppt_fwk_heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+
+		fwk_heap_insert_batch(hppt_fwk_heap, (char *)k, nr);
+		fwk_heap_extract_batch(hppt_fwk_heap, (char *)out,
+		                       fwk_heap_count(hppt_fwk_heap) -
+		                       (HPPT_BURST_NR / 2));
+
+		k += nr;
+		n -= nr;
+	}
+	while (fwk_heap_extract_batch(hppt_fwk_heap, (char *)out, array_nr(out)))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_FWK_HEAP) */
+
+/******************************************************************************
+ * Growable fixed array based weak heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FWK_HEAP_GROW)
+
+/*
+ * Initial capacity of growable heaps: start small so that insertion timings
+ * account for all reallocations required to reach the final heap size.
+ */
+#define HPPT_FWKG_MIN_NR (16U)
+
+static unsigned int    *hppt_fwkg_keys;
+static struct fwk_heap  hppt_fwkg_heap;
+
+static int
+hppt_fwkg_reset(void)
+{
+	fwk_heap_fini_grow(&hppt_fwkg_heap);
+
+	return fwk_heap_init_grow(&hppt_fwkg_heap, sizeof(*hppt_fwkg_keys),
+	                          HPPT_FWKG_MIN_NR, hppt_compare_min,
+	                          pt_copy_key);
+}
+
+static int
+hppt_fwkg_validate(void)
+{
+	unsigned int  cur, old;
+	unsigned int *k;
+	int           n;
+
+	if (fwk_heap_init_grow(&hppt_fwkg_heap, sizeof(*hppt_fwkg_keys),
+	                       HPPT_FWKG_MIN_NR, hppt_compare_min,
+	                       pt_copy_key))
+		return EXIT_FAILURE;
+
+	for (n = 0, k = hppt_fwkg_keys; n < hppt_entries.pt_nr; n++, k++)
+		if (fwk_heap_insert_grow(&hppt_fwkg_heap, (char *)k))
+			return EXIT_FAILURE;
+
+	fwk_heap_extract_shrink(&hppt_fwkg_heap, (char *)&old, HPPT_FWKG_MIN_NR);
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		fwk_heap_extract_shrink(&hppt_fwkg_heap, (char *)&cur,
+		                        HPPT_FWKG_MIN_NR);
+
+		if (old > cur) {
+			fprintf(stderr, "Bogus heap insert/extract scheme\n");
+			return EXIT_FAILURE;
+		}
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_fwkg_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	hppt_fwkg_keys = malloc(sizeof(*k) * hppt_entries.pt_nr);
+	if (!hppt_fwkg_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = hppt_fwkg_keys;
+	while (!pt_iter_entry(&hppt_entries, k))
+		k++;
+
+	return hppt_fwkg_validate();
+}
+
+static void
+hppt_fwkg_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int    *k;
+	int              n;
+
+	if (hppt_fwkg_reset())
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = hppt_fwkg_keys; n < hppt_entries.pt_nr; n++, k++)
+		fwk_heap_insert_grow(&hppt_fwkg_heap, (char *)k);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_fwkg_extract(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	unsigned int     cur;
+	unsigned int    *k;
+	int              n;
+
+	if (hppt_fwkg_reset())
+		return;
+
+	for (n = 0, k = hppt_fwkg_keys; n < hppt_entries.pt_nr; n++, k++)
+		fwk_heap_insert_grow(&hppt_fwkg_heap, (char *)k);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		fwk_heap_extract_shrink(&hppt_fwkg_heap, (char *)&cur,
+		                        HPPT_FWKG_MIN_NR);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_FWK_HEAP_GROW) */
+
+/******************************************************************************
+ * Singly linked list based binomial heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_SBNM_HEAP)
+
+struct hppt_sbnm_key {
+	struct sbnm_heap_node node;
+	unsigned int          value;
+};
+
+static struct hppt_sbnm_key *sbnm_heap_keys;
+static unsigned int          sbnm_heap_min;
+
+static int
+hppt_sbnm_compare_min(const struct sbnm_heap_node *first,
+                      const struct sbnm_heap_node *second)
+{
+	return hppt_compare_min((char *)&((struct hppt_sbnm_key *)
+	                                  first)->value,
+	                        (char *)&((struct hppt_sbnm_key *)
+	                                  second)->value);
+}
+
+static void
+hppt_sbnm_insert_bulk(struct sbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_sbnm_key *k;
+
+	sbnm_heap_init(heap, hppt_sbnm_compare_min);
+
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		sbnm_heap_insert(heap, &k->node);
+}
+
+static int
+hppt_sbnm_check_heap(struct sbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_sbnm_key *cur, *old;
+
+	old = sbnm_heap_entry(sbnm_heap_extract(heap),
+	                      struct hppt_sbnm_key, node);
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		cur = sbnm_heap_entry(sbnm_heap_extract(heap),
+		                      struct hppt_sbnm_key, node);
+
+		if (old->value > cur->value)
+			return EXIT_FAILURE;
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_sbnm_validate(void)
+{
+	struct sbnm_heap      heap;
+	int                   n;
+	struct hppt_sbnm_key *k;
+
+	hppt_sbnm_insert_bulk(&heap);
+
+	if (hppt_sbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap insert / extract scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	hppt_sbnm_insert_bulk(&heap);
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= sbnm_heap_min;
+		sbnm_heap_promote(&heap, &k->node);
+	}
+	if (hppt_sbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap promote scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += sbnm_heap_min;
+
+	hppt_sbnm_insert_bulk(&heap);
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += sbnm_heap_min;
+		sbnm_heap_demote(&heap, &k->node);
+	}
+	if (hppt_sbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap demote scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= sbnm_heap_min;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_sbnm_load(const char *pathname)
+{
+	struct hppt_sbnm_key *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	sbnm_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*sbnm_heap_keys));
+	if (!sbnm_heap_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = sbnm_heap_keys;
+	sbnm_heap_min = UINT_MAX;
+	while (!pt_iter_entry(&hppt_entries, &k->value)) {
+		sbnm_heap_min = umin(k->value, sbnm_heap_min);
+		k++;
+	}
+
+	return hppt_sbnm_validate();
+}
+
+static void
+hppt_sbnm_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct sbnm_heap heap;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	hppt_sbnm_insert_bulk(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_sbnm_extract(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct sbnm_heap heap;
+	int              n;
+
+	hppt_sbnm_insert_bulk(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		sbnm_heap_extract(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_sbnm_remove(unsigned long long *nsecs)
+{
+	int                   n;
+	struct hppt_sbnm_key *k;
+	struct sbnm_heap      heap;
+	struct timespec       start, elapse;
+
+	*nsecs = 0;
+
+	hppt_sbnm_insert_bulk(&heap);
+
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		sbnm_heap_remove(&heap, &k->node);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+}
+
+static void
+hppt_sbnm_promote(unsigned long long *nsecs)
+{
+	int                   n;
+	struct hppt_sbnm_key *k;
+	struct sbnm_heap      heap;
+	struct timespec       start, elapse;
+
+	*nsecs = 0;
+
+	hppt_sbnm_insert_bulk(&heap);
+
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= sbnm_heap_min;
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		sbnm_heap_promote(&heap, &k->node);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += sbnm_heap_min;
+}
+
+static void
+hppt_sbnm_demote(unsigned long long *nsecs)
+{
+	int                   n;
+	struct hppt_sbnm_key *k;
+	struct sbnm_heap      heap;
+	struct timespec       start, elapse;
+
+	*nsecs = 0;
+
+	hppt_sbnm_insert_bulk(&heap);
+
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += sbnm_heap_min;
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		sbnm_heap_demote(&heap, &k->node);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= sbnm_heap_min;
+}
+
+static void
+hppt_sbnm_run_sparse(unsigned long long *nsecs,
+                     void              (*insert)(struct sbnm_heap      *heap,
+                                                 struct sbnm_heap_node *key))
+{
+	struct timespec       start, elapse;
+	struct sbnm_heap      heap;
+	struct hppt_sbnm_key *k;
+	int                   n;
+
+	sbnm_heap_init(&heap, hppt_sbnm_compare_min);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		insert(&heap, &k->node);
+		if (!((n + 1) % HPPT_SPARSE_NR))
+			sbnm_heap_extract(&heap);
+	}
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_sbnm_sparse(unsigned long long *nsecs)
+{
+	hppt_sbnm_run_sparse(nsecs, sbnm_heap_insert);
+}
+
+static void
+hppt_sbnm_burst(unsigned long long *nsecs)
+{
+	struct timespec        start, elapse;
+	struct sbnm_heap       heap;
+	struct sbnm_heap_node *nodes[HPPT_BURST_NR];
+	struct hppt_sbnm_key  *k = sbnm_heap_keys;
+	int                    n = hppt_entries.pt_nr;
+
+	sbnm_heap_init(&heap, hppt_sbnm_compare_min);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+		int i;
+
+		for (i = 0; i < nr; i++)
+			nodes[i] = &k[i].node;
+
+		sbnm_heap_insert_batch(&heap, nodes, nr);
+		sbnm_heap_extract_batch(&heap, nodes,
+		                        sbnm_heap_count(&heap) -
+		                        (HPPT_BURST_NR / 2));
+
+		k += nr;
+		n -= nr;
+	}
+	while (sbnm_heap_extract_batch(&heap, nodes, array_nr(nodes)))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+/*
+ * Lazy insertion variant: singletons are prepended to the root list and
+ * consolidated at extraction time.
+ */
+static void
+hppt_sbnml_insert_bulk(struct sbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_sbnm_key *k;
+
+	sbnm_heap_init(heap, hppt_sbnm_compare_min);
+
+	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		sbnm_heap_insert_lazy(heap, &k->node);
+}
+
+static int
+hppt_sbnml_load(const char *pathname)
+{
+	struct sbnm_heap heap;
+
+	if (hppt_sbnm_load(pathname))
+		return EXIT_FAILURE;
+
+	hppt_sbnml_insert_bulk(&heap);
+	if (hppt_sbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap lazy insert / extract scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void
+hppt_sbnml_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct sbnm_heap heap;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	hppt_sbnml_insert_bulk(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_sbnml_extract(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct sbnm_heap heap;
+	int              n;
+
+	hppt_sbnml_insert_bulk(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		sbnm_heap_extract(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_sbnml_sparse(unsigned long long *nsecs)
+{
+	hppt_sbnm_run_sparse(nsecs, sbnm_heap_insert_lazy);
+}
+
+#endif /* defined(CONFIG_KARN_SBNM_HEAP) */
+
+/******************************************************************************
+ * Doubly linked list based binomial heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_DBNM_HEAP)
+
+struct hppt_dbnm_key {
+	struct dbnm_heap_node node;
+	unsigned int          value;
+};
+
+static struct hppt_dbnm_key *dbnm_heap_keys;
+static unsigned int          dbnm_heap_min;
+
+static int
+hppt_dbnm_compare_min(const struct dbnm_heap_node *first,
+                      const struct dbnm_heap_node *second)
+{
+	return hppt_compare_min((char *)&((struct hppt_dbnm_key *)
+	                                  first)->value,
+	                        (char *)&((struct hppt_dbnm_key *)
+	                                  second)->value);
+}
+
+static void
+hppt_dbnm_insert_bulk(struct dbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_dbnm_key *k;
+
+	dbnm_heap_init(heap);
+
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		dbnm_heap_insert(heap, &k->node, hppt_dbnm_compare_min);
+}
+
+static int
+hppt_dbnm_check_heap(struct dbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_dbnm_key *cur, *old;
+
+	old = dbnm_heap_entry(dbnm_heap_extract(heap, hppt_dbnm_compare_min),
+	                      struct hppt_dbnm_key, node);
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		cur = dbnm_heap_entry(dbnm_heap_extract(heap,
+		                                        hppt_dbnm_compare_min),
+		                      struct hppt_dbnm_key, node);
+
+		if (old->value > cur->value)
+			return EXIT_FAILURE;
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_dbnm_validate(void)
+{
+	struct dbnm_heap      heap;
+#if 0
+	int                   n;
+	struct hppt_dbnm_key *k;
+#endif
+
+
+	hppt_dbnm_insert_bulk(&heap);
+
+	if (hppt_dbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap insert / extract scheme\n");
+		return EXIT_FAILURE;
+	}
+
+#if 0
+	hppt_dbnm_insert_bulk(&heap);
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= dbnm_heap_min;
+		dbnm_heap_promote(&heap, &k->node, hppt_dbnm_compare_min);
+	}
+
+	if (hppt_dbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap promote scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += dbnm_heap_min;
+#endif
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_dbnm_load(const char *pathname)
+{
+	struct hppt_dbnm_key *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	dbnm_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*dbnm_heap_keys));
+	if (!dbnm_heap_keys)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = dbnm_heap_keys;
+	dbnm_heap_min = UINT_MAX;
+	while (!pt_iter_entry(&hppt_entries, &k->value)) {
+		dbnm_heap_min = umin(k->value, dbnm_heap_min);
+		k++;
+	}
+
+	return hppt_dbnm_validate();
+}
+
+static void
+hppt_dbnm_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct dbnm_heap heap;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	hppt_dbnm_insert_bulk(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_dbnm_extract(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct dbnm_heap heap;
+	int              n;
+
+	hppt_dbnm_insert_bulk(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		dbnm_heap_extract(&heap, hppt_dbnm_compare_min);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_dbnm_remove(unsigned long long *nsecs)
+{
+	int                   n;
+	struct hppt_dbnm_key *k;
+	struct dbnm_heap      heap;
+	struct timespec       start, elapse;
+
+	*nsecs = 0;
+
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		hppt_dbnm_insert_bulk(&heap);
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		dbnm_heap_remove(&heap, &k->node, hppt_dbnm_compare_min);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+}
+
+static void
+hppt_dbnm_promote(unsigned long long *nsecs)
+{
+	int                   n;
+	struct hppt_dbnm_key *k;
+	struct dbnm_heap      heap;
+	struct timespec       start, elapse;
+
+	*nsecs = 0;
+
+	hppt_dbnm_insert_bulk(&heap);
+
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= dbnm_heap_min;
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		dbnm_heap_update(&k->node, hppt_dbnm_compare_min);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += dbnm_heap_min;
+}
+
+static void
+hppt_dbnm_sparse(unsigned long long *nsecs)
+{
+	struct timespec       start, elapse;
+	struct dbnm_heap      heap;
+	struct hppt_dbnm_key *k;
+	int                   n;
+
+	dbnm_heap_init(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		dbnm_heap_insert(&heap, &k->node, hppt_dbnm_compare_min);
+		if (!((n + 1) % HPPT_SPARSE_NR))
+			dbnm_heap_extract(&heap, hppt_dbnm_compare_min);
+	}
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_dbnm_burst(unsigned long long *nsecs)
+{
+	struct timespec        start, elapse;
+	struct dbnm_heap       heap;
+	struct dbnm_heap_node *nodes[HPPT_BURST_NR];
+	struct hppt_dbnm_key  *k = dbnm_heap_keys;
+	int                    n = hppt_entries.pt_nr;
+
+	dbnm_heap_init(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+		int i;
+
+		for (i = 0; i < nr; i++)
+			nodes[i] = &k[i].node;
+
+		dbnm_heap_insert_batch(&heap, nodes, nr,
+		                       hppt_dbnm_compare_min);
+		dbnm_heap_extract_batch(&heap, nodes,
+		                        dbnm_heap_count(&heap) -
+		                        (HPPT_BURST_NR / 2),
+		                        hppt_dbnm_compare_min);
+
+		k += nr;
+		n -= nr;
+	}
+	while (dbnm_heap_extract_batch(&heap, nodes, array_nr(nodes),
+	                               hppt_dbnm_compare_min))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+/*
+ * Lazy insertion variant: singletons are prepended to the root list and
+ * consolidated at extraction time.
+ */
+static void
+hppt_dbnml_insert_bulk(struct dbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_dbnm_key *k;
+
+	dbnm_heap_init(heap);
+
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		dbnm_heap_insert_lazy(heap, &k->node);
+}
+
+static int
+hppt_dbnml_load(const char *pathname)
+{
+	struct dbnm_heap heap;
+
+	if (hppt_dbnm_load(pathname))
+		return EXIT_FAILURE;
+
+	hppt_dbnml_insert_bulk(&heap);
+	if (hppt_dbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap lazy insert / extract scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void
+hppt_dbnml_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct dbnm_heap heap;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	hppt_dbnml_insert_bulk(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_dbnml_extract(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct dbnm_heap heap;
+	int              n;
+
+	hppt_dbnml_insert_bulk(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		dbnm_heap_extract(&heap, hppt_dbnm_compare_min);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_dbnml_sparse(unsigned long long *nsecs)
+{
+	struct timespec       start, elapse;
+	struct dbnm_heap      heap;
+	struct hppt_dbnm_key *k;
+	int                   n;
+
+	dbnm_heap_init(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		dbnm_heap_insert_lazy(&heap, &k->node);
+		if (!((n + 1) % HPPT_SPARSE_NR))
+			dbnm_heap_extract(&heap, hppt_dbnm_compare_min);
+	}
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_DBNM_HEAP) */
+
+/******************************************************************************
+ * Parented LCRS based binomial heap
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_PBNM_HEAP)
+
+struct hppt_pbnm_key {
+	struct pbnm_heap_node *node;
+	unsigned int           value;
+};
+
+static struct falloc         pbnm_alloc;
+static struct hppt_pbnm_key *pbnm_heap_keys;
+static unsigned int          pbnm_heap_min;
+
+static int
+hppt_pbnm_compare_min(const struct pbnm_heap_node *restrict first,
+                      const struct pbnm_heap_node *restrict second)
+{
+	return hppt_compare_min((char *)&pbnm_heap_entry(first,
+	                                                 struct hppt_pbnm_key,
+	                                                 node)->value,
+	                        (char *)&pbnm_heap_entry(second,
+	                                                 struct hppt_pbnm_key,
+	                                                 node)->value);
+}
+
+static int
+hppt_pbnm_doinsert(struct pbnm_heap *heap, struct hppt_pbnm_key *key)
+{
+	key->node = falloc_alloc(&pbnm_alloc);
+	//key->node = malloc(sizeof(*key->node));
+	if (!key->node)
+		return EXIT_FAILURE;
+
+	pbnm_heap_init_node(key->node, &key->node);
+
+	pbnm_heap_insert(heap, key->node);
+
+	return EXIT_SUCCESS;
+}
+
+static struct hppt_pbnm_key *
+hppt_pbnm_doextract(struct pbnm_heap *heap)
+{
+	struct hppt_pbnm_key *key;
+
+	key = pbnm_heap_entry(pbnm_heap_extract(heap), typeof(*key), node);
+
+	//free(key->node);
+	falloc_free(&pbnm_alloc, key->node);
+
+	return key;
+}
+
+static void
+hppt_pbnm_doremove(struct pbnm_heap *heap, struct hppt_pbnm_key *key)
+{
+	pbnm_heap_remove(heap, key->node);
+
+	//free(key->node);
+	falloc_free(&pbnm_alloc, key->node);
+}
+
+static int
+hppt_pbnm_insert_bulk(struct pbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_pbnm_key *k;
+
+	pbnm_heap_init(heap, hppt_pbnm_compare_min);
+
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		if (hppt_pbnm_doinsert(heap, k))
+			break;
+
+	if (n == hppt_entries.pt_nr)
+		return EXIT_SUCCESS;
+
+	while (n--)
+		//free(pbnm_heap_keys[n].node);
+		falloc_free(&pbnm_alloc, pbnm_heap_keys[n].node);
+
+	fprintf(stderr, "failed to allocate heap node\n");
+
+	return EXIT_FAILURE;
+}
+
+static int
+hppt_pbnm_check_heap(struct pbnm_heap *heap)
+{
+	int                   n;
+	struct hppt_pbnm_key *cur, *old;
+
+	old = hppt_pbnm_doextract(heap);
+
+	for (n = 1; n < hppt_entries.pt_nr; n++) {
+		cur = hppt_pbnm_doextract(heap);
+
+		if (old->value > cur->value)
+			return EXIT_FAILURE;
+
+		old = cur;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_pbnm_validate(void)
+{
+	struct pbnm_heap      heap;
+	int                   n;
+	struct hppt_pbnm_key *k;
+
+	if (hppt_pbnm_insert_bulk(&heap))
+		return EXIT_FAILURE;
+
+	if (hppt_pbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap insert / extract scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	if (hppt_pbnm_insert_bulk(&heap))
+		return EXIT_FAILURE;
+
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= pbnm_heap_min;
+		pbnm_heap_promote(&heap, k->node);
+	}
+	if (hppt_pbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap promote scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += pbnm_heap_min;
+
+	if (hppt_pbnm_insert_bulk(&heap))
+		return EXIT_FAILURE;
+
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += pbnm_heap_min;
+		pbnm_heap_demote(&heap, k->node);
+	}
+	if (hppt_pbnm_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap demote scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= pbnm_heap_min;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+hppt_pbnm_load(const char *pathname)
+{
+	struct hppt_pbnm_key *k;
+
+	if (pt_open_entries(pathname, &hppt_entries))
+		return EXIT_FAILURE;
+
+	pbnm_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*pbnm_heap_keys));
+	if (!pbnm_heap_keys)
+		return EXIT_FAILURE;
+
+	falloc_init(&pbnm_alloc, sizeof(*k->node));
+
+	pt_init_entry_iter(&hppt_entries);
+
+	k = pbnm_heap_keys;
+	pbnm_heap_min = UINT_MAX;
+	while (!pt_iter_entry(&hppt_entries, &k->value)) {
+		pbnm_heap_min = umin(k->value, pbnm_heap_min);
+		k++;
+	}
+
+	return hppt_pbnm_validate();
+}
+
+static void
+hppt_pbnm_insert(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct pbnm_heap heap;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	hppt_pbnm_insert_bulk(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_pbnm_extract(unsigned long long *nsecs)
+{
+	struct timespec  start, elapse;
+	struct pbnm_heap heap;
+	int              n;
+
+	hppt_pbnm_insert_bulk(&heap);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < hppt_entries.pt_nr; n++)
+		hppt_pbnm_doextract(&heap);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void
+hppt_pbnm_remove(unsigned long long *nsecs)
+{
+	int                   n;
+	struct hppt_pbnm_key *k;
+	struct pbnm_heap      heap;
 	struct timespec       start, elapse;
 
 	*nsecs = 0;
 
-	hppt_sbnm_insert_bulk(&heap);
+	hppt_pbnm_insert_bulk(&heap);
 
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		sbnm_heap_remove(&heap, &k->node);
+		hppt_pbnm_doremove(&heap, k);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -490,22 +2801,22 @@ hppt_sbnm_remove(unsigned long long *nsecs)
 }
 
 static void
-hppt_sbnm_promote(unsigned long long *nsecs)
+hppt_pbnm_promote(unsigned long long *nsecs)
 {
 	int                   n;
-	struct hppt_sbnm_key *k;
-	struct sbnm_heap      heap;
+	struct hppt_pbnm_key *k;
+	struct pbnm_heap      heap;
 	struct timespec       start, elapse;
 
 	*nsecs = 0;
 
-	hppt_sbnm_insert_bulk(&heap);
+	hppt_pbnm_insert_bulk(&heap);
 
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= sbnm_heap_min;
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= pbnm_heap_min;
 
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		sbnm_heap_promote(&heap, &k->node);
+		pbnm_heap_promote(&heap, k->node);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -516,27 +2827,30 @@ hppt_sbnm_promote(unsigned long long *nsecs)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += sbnm_heap_min;
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		//free(k->node);
+		falloc_free(&pbnm_alloc, k->node);
+		k->value += pbnm_heap_min;
+	}
 }
 
 static void
-hppt_sbnm_demote(unsigned long long *nsecs)
+hppt_pbnm_demote(unsigned long long *nsecs)
 {
 	int                   n;
-	struct hppt_sbnm_key *k;
-	struct sbnm_heap      heap;
+	struct hppt_pbnm_key *k;
+	struct pbnm_heap      heap;
 	struct timespec       start, elapse;
 
 	*nsecs = 0;
 
-	hppt_sbnm_insert_bulk(&heap);
+	hppt_pbnm_insert_bulk(&heap);
 
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value += sbnm_heap_min;
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += pbnm_heap_min;
 
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		sbnm_heap_demote(&heap, &k->node);
+		pbnm_heap_demote(&heap, k->node);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -547,59 +2861,115 @@ hppt_sbnm_demote(unsigned long long *nsecs)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = sbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value -= sbnm_heap_min;
+	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		//free(k->node);
+		falloc_free(&pbnm_alloc, k->node);
+		k->value -= pbnm_heap_min;
+	}
 }
 
-#endif /* defined(CONFIG_KARN_SBNM_HEAP) */
+static void
+hppt_pbnm_burst(unsigned long long *nsecs)
+{
+	struct timespec        start, elapse;
+	struct pbnm_heap       heap;
+	struct pbnm_heap_node *nodes[HPPT_BURST_NR];
+	struct hppt_pbnm_key  *k = pbnm_heap_keys;
+	int                    n = hppt_entries.pt_nr;
+	unsigned int           cnt;
+
+	pbnm_heap_init(&heap, hppt_pbnm_compare_min);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+		int i;
+
+		for (i = 0; i < nr; i++) {
+			k[i].node = falloc_alloc(&pbnm_alloc);
+			if (!k[i].node)
+				break;
+
+			pbnm_heap_init_node(k[i].node, &k[i].node);
+			nodes[i] = k[i].node;
+		}
+
+		pbnm_heap_insert_batch(&heap, nodes, i);
+		if (i != nr) {
+			fprintf(stderr, "failed to allocate heap node\n");
+			break;
+		}
+
+		cnt = pbnm_heap_extract_batch(&heap, nodes,
+		                              pbnm_heap_count(&heap) -
+		                              (HPPT_BURST_NR / 2));
+		while (cnt--)
+			falloc_free(&pbnm_alloc, nodes[cnt]);
+
+		k += nr;
+		n -= nr;
+	}
+	while ((cnt = pbnm_heap_extract_batch(&heap, nodes, array_nr(nodes))))
+		while (cnt--)
+			falloc_free(&pbnm_alloc, nodes[cnt]);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_PBNM_HEAP) */
 
 /******************************************************************************
- * Doubly linked list based binomial heap
+ * Singly linked list based pairing heap
  ******************************************************************************/
 
-#if defined(CONFIG_KARN_DBNM_HEAP)
+#if defined(CONFIG_KARN_SPAIR_HEAP)
 
-struct hppt_dbnm_key {
-	struct dbnm_heap_node node;
-	unsigned int          value;
+struct hppt_spair_key {
+	struct lcrs_node node;
+	unsigned int     value;
 };
 
-static struct hppt_dbnm_key *dbnm_heap_keys;
-static unsigned int          dbnm_heap_min;
+static struct hppt_spair_key *spair_heap_keys;
+static unsigned int           spair_heap_min;
+static unsigned int           spair_heap_mode = SPAIR_HEAP_TWOPASS_MODE;
 
 static int
-hppt_dbnm_compare_min(const struct dbnm_heap_node *first,
-                      const struct dbnm_heap_node *second)
+hppt_spair_compare_min(const struct lcrs_node *restrict first,
+                       const struct lcrs_node *restrict second)
 {
-	return pt_compare_min((char *)&((struct hppt_dbnm_key *)first)->value,
-	                      (char *)&((struct hppt_dbnm_key *)second)->value);
+	return hppt_compare_min((char *)&((struct hppt_spair_key *)
+	                                  first)->value,
+	                        (char *)&((struct hppt_spair_key *)
+	                                  second)->value);
 }
 
 static void
-hppt_dbnm_insert_bulk(struct dbnm_heap *heap)
+hppt_spair_insert_bulk(struct spair_heap *heap)
 {
 	int                   n;
-	struct hppt_dbnm_key *k;
+	struct hppt_spair_key *k;
 
-	dbnm_heap_init(heap);
+	spair_heap_init_mode(heap, spair_heap_mode);
 
-	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		dbnm_heap_insert(heap, &k->node, hppt_dbnm_compare_min);
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		spair_heap_insert(heap, &k->node, hppt_spair_compare_min);
 }
 
 static int
-hppt_dbnm_check_heap(struct dbnm_heap *heap)
+hppt_spair_check_heap(struct spair_heap *heap)
 {
-	int                   n;
-	struct hppt_dbnm_key *cur, *old;
+	int                    n;
+	struct hppt_spair_key *cur, *old;
 
-	old = dbnm_heap_entry(dbnm_heap_extract(heap, hppt_dbnm_compare_min),
-	                      struct hppt_dbnm_key, node);
+	old = spair_heap_entry(spair_heap_extract(heap, hppt_spair_compare_min),
+	                       struct hppt_spair_key, node);
 
 	for (n = 1; n < hppt_entries.pt_nr; n++) {
-		cur = dbnm_heap_entry(dbnm_heap_extract(heap,
-		                                        hppt_dbnm_compare_min),
-		                      struct hppt_dbnm_key, node);
+		cur = spair_heap_entry(
+			spair_heap_extract(heap, hppt_spair_compare_min),
+			struct hppt_spair_key, node);
 
 		if (old->value > cur->value)
 			return EXIT_FAILURE;
@@ -611,31 +2981,42 @@ hppt_dbnm_check_heap(struct dbnm_heap *heap)
 }
 
 static int
-hppt_dbnm_validate(void)
+hppt_spair_validate(void)
 {
-	struct dbnm_heap      heap;
-#if 0
-	int                   n;
-	struct hppt_dbnm_key *k;
-#endif
-
-
-	hppt_dbnm_insert_bulk(&heap);
+	struct spair_heap      heap;
+	int                    n;
+	struct hppt_spair_key *k;
 
-	if (hppt_dbnm_check_heap(&heap)) {
+	hppt_spair_insert_bulk(&heap);
+	if (hppt_spair_check_heap(&heap)) {
 		fprintf(stderr, "Bogus heap insert / extract scheme\n");
 		return EXIT_FAILURE;
 	}
 
-#if 0
-	hppt_dbnm_insert_bulk(&heap);
-	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= dbnm_heap_min;
-		dbnm_heap_promote(&heap, &k->node, hppt_dbnm_compare_min);
+	hppt_spair_insert_bulk(&heap);
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= spair_heap_min;
+		spair_heap_promote(&heap, &k->node, hppt_spair_compare_min);
+	}
+	if (hppt_spair_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap promote scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += spair_heap_min;
+
+	hppt_spair_insert_bulk(&heap);
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += spair_heap_min;
+		spair_heap_demote(&heap, &k->node, hppt_spair_compare_min);
 	}
-
-	if (hppt_dbnm_check_heap(&heap)) {
-		fprintf(stderr, "Bogus heap promote scheme\n");
+	if (hppt_spair_check_heap(&heap)) {
+		fprintf(stderr, "Bogus heap demote scheme\n");
 		return EXIT_FAILURE;
 	}
 
@@ -643,45 +3024,44 @@ hppt_dbnm_validate(void)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += dbnm_heap_min;
-#endif
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= spair_heap_min;
 
 	return EXIT_SUCCESS;
 }
 
 static int
-hppt_dbnm_load(const char *pathname)
+hppt_spair_load(const char *pathname)
 {
-	struct hppt_dbnm_key *k;
+	struct hppt_spair_key *k;
 
 	if (pt_open_entries(pathname, &hppt_entries))
 		return EXIT_FAILURE;
 
-	dbnm_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*dbnm_heap_keys));
-	if (!dbnm_heap_keys)
+	spair_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*spair_heap_keys));
+	if (!spair_heap_keys)
 		return EXIT_FAILURE;
 
 	pt_init_entry_iter(&hppt_entries);
 
-	k = dbnm_heap_keys;
-	dbnm_heap_min = UINT_MAX;
+	k = spair_heap_keys;
+	spair_heap_min = UINT_MAX;
 	while (!pt_iter_entry(&hppt_entries, &k->value)) {
-		dbnm_heap_min = umin(k->value, dbnm_heap_min);
+		spair_heap_min = umin(k->value, spair_heap_min);
 		k++;
 	}
 
-	return hppt_dbnm_validate();
+	return hppt_spair_validate();
 }
 
 static void
-hppt_dbnm_insert(unsigned long long *nsecs)
+hppt_spair_insert(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
-	struct dbnm_heap heap;
+	struct spair_heap heap;
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	hppt_dbnm_insert_bulk(&heap);
+	hppt_spair_insert_bulk(&heap);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -689,17 +3069,17 @@ hppt_dbnm_insert(unsigned long long *nsecs)
 }
 
 static void
-hppt_dbnm_extract(unsigned long long *nsecs)
+hppt_spair_extract(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
-	struct dbnm_heap heap;
+	struct spair_heap heap;
 	int              n;
 
-	hppt_dbnm_insert_bulk(&heap);
+	hppt_spair_insert_bulk(&heap);
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
 	for (n = 0; n < hppt_entries.pt_nr; n++)
-		dbnm_heap_extract(&heap, hppt_dbnm_compare_min);
+		spair_heap_extract(&heap, hppt_spair_compare_min);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -707,20 +3087,20 @@ hppt_dbnm_extract(unsigned long long *nsecs)
 }
 
 static void
-hppt_dbnm_remove(unsigned long long *nsecs)
+hppt_spair_remove(unsigned long long *nsecs)
 {
 	int                   n;
-	struct hppt_dbnm_key *k;
-	struct dbnm_heap      heap;
+	struct hppt_spair_key *k;
+	struct spair_heap      heap;
 	struct timespec       start, elapse;
 
 	*nsecs = 0;
 
-	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		hppt_dbnm_insert_bulk(&heap);
+	hppt_spair_insert_bulk(&heap);
 
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		dbnm_heap_remove(&heap, &k->node, hppt_dbnm_compare_min);
+		spair_heap_remove(&heap, &k->node, hppt_spair_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -729,22 +3109,22 @@ hppt_dbnm_remove(unsigned long long *nsecs)
 }
 
 static void
-hppt_dbnm_promote(unsigned long long *nsecs)
+hppt_spair_promote(unsigned long long *nsecs)
 {
-	int                   n;
-	struct hppt_dbnm_key *k;
-	struct dbnm_heap      heap;
-	struct timespec       start, elapse;
+	int                    n;
+	struct hppt_spair_key *k;
+	struct spair_heap      heap;
+	struct timespec        start, elapse;
 
 	*nsecs = 0;
 
-	hppt_dbnm_insert_bulk(&heap);
+	hppt_spair_insert_bulk(&heap);
 
-	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= dbnm_heap_min;
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= spair_heap_min;
 
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		dbnm_heap_update(&k->node, hppt_dbnm_compare_min);
+		spair_heap_promote(&heap, &k->node, hppt_spair_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -755,110 +3135,185 @@ hppt_dbnm_promote(unsigned long long *nsecs)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = dbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += dbnm_heap_min;
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += spair_heap_min;
 }
 
-#endif /* defined(CONFIG_KARN_DBNM_HEAP) */
+static void
+hppt_spair_demote(unsigned long long *nsecs)
+{
+	int                    n;
+	struct hppt_spair_key *k;
+	struct spair_heap      heap;
+	struct timespec        start, elapse;
 
-/******************************************************************************
- * Parented LCRS based binomial heap
- ******************************************************************************/
+	*nsecs = 0;
 
-#if defined(CONFIG_KARN_PBNM_HEAP)
+	hppt_spair_insert_bulk(&heap);
 
-struct hppt_pbnm_key {
-	struct pbnm_heap_node *node;
-	unsigned int           value;
-};
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += spair_heap_min;
 
-static struct falloc         pbnm_alloc;
-static struct hppt_pbnm_key *pbnm_heap_keys;
-static unsigned int          pbnm_heap_min;
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		spair_heap_demote(&heap, &k->node, hppt_spair_compare_min);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
-static int
-hppt_pbnm_compare_min(const struct pbnm_heap_node *restrict first,
-                      const struct pbnm_heap_node *restrict second)
+		elapse = pt_tspec_sub(&elapse, &start);
+		*nsecs += pt_tspec2ns(&elapse);
+	}
+
+	/*
+	 * Reset keys to their original values so that next computation loop
+	 * gives consistent numbers...
+	 */
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= spair_heap_min;
+}
+
+static void
+hppt_spair_sparse(unsigned long long *nsecs)
 {
-	return pt_compare_min((char *)&pbnm_heap_entry(first,
-	                                               struct hppt_pbnm_key,
-	                                               node)->value,
-	                      (char *)&pbnm_heap_entry(second,
-	                                               struct hppt_pbnm_key,
-	                                               node)->value);
+	struct timespec        start, elapse;
+	struct spair_heap      heap;
+	struct hppt_spair_key *k;
+	int                    n;
+
+	spair_heap_init_mode(&heap, spair_heap_mode);
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		spair_heap_insert(&heap, &k->node, hppt_spair_compare_min);
+		if (!((n + 1) % HPPT_SPARSE_NR))
+			spair_heap_extract(&heap, hppt_spair_compare_min);
+	}
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
 }
 
-static int
-hppt_pbnm_doinsert(struct pbnm_heap *heap, struct hppt_pbnm_key *key)
+static void
+hppt_spair_burst(unsigned long long *nsecs)
 {
-	key->node = falloc_alloc(&pbnm_alloc);
-	//key->node = malloc(sizeof(*key->node));
-	if (!key->node)
-		return EXIT_FAILURE;
+	struct timespec        start, elapse;
+	struct spair_heap      heap;
+	struct lcrs_node      *nodes[HPPT_BURST_NR];
+	struct hppt_spair_key *k = spair_heap_keys;
+	int                    n = hppt_entries.pt_nr;
 
-	pbnm_heap_init_node(key->node, &key->node);
+	spair_heap_init_mode(&heap, spair_heap_mode);
 
-	pbnm_heap_insert(heap, key->node);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	while (n > 0) {
+		int nr = (n < HPPT_BURST_NR) ? n : HPPT_BURST_NR;
+		int i;
+
+		for (i = 0; i < nr; i++)
+			nodes[i] = &k[i].node;
+
+		spair_heap_insert_batch(&heap, nodes, nr,
+		                        hppt_spair_compare_min);
+		spair_heap_extract_batch(&heap, nodes,
+		                         spair_heap_count(&heap) -
+		                         (HPPT_BURST_NR / 2),
+		                         hppt_spair_compare_min);
+
+		k += nr;
+		n -= nr;
+	}
+	while (spair_heap_extract_batch(&heap, nodes, array_nr(nodes),
+	                                hppt_spair_compare_min))
+		;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
-	return EXIT_SUCCESS;
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
 }
 
-static struct hppt_pbnm_key *
-hppt_pbnm_doextract(struct pbnm_heap *heap)
+static int
+hppt_spairmp_load(const char *pathname)
 {
-	struct hppt_pbnm_key *key;
+	spair_heap_mode = SPAIR_HEAP_MULTIPASS_MODE;
 
-	key = pbnm_heap_entry(pbnm_heap_extract(heap), typeof(*key), node);
+	return hppt_spair_load(pathname);
+}
 
-	//free(key->node);
-	falloc_free(&pbnm_alloc, key->node);
+static int
+hppt_spairfb_load(const char *pathname)
+{
+	spair_heap_mode = SPAIR_HEAP_FRONT2BACK_MODE;
 
-	return key;
+	return hppt_spair_load(pathname);
 }
 
-static void
-hppt_pbnm_doremove(struct pbnm_heap *heap, struct hppt_pbnm_key *key)
+static int
+hppt_spaira_load(const char *pathname)
 {
-	pbnm_heap_remove(heap, key->node);
+	spair_heap_mode = SPAIR_HEAP_AUX_MODE | SPAIR_HEAP_TWOPASS_MODE;
 
-	//free(key->node);
-	falloc_free(&pbnm_alloc, key->node);
+	return hppt_spair_load(pathname);
 }
 
 static int
-hppt_pbnm_insert_bulk(struct pbnm_heap *heap)
+hppt_spairamp_load(const char *pathname)
 {
-	int                   n;
-	struct hppt_pbnm_key *k;
+	spair_heap_mode = SPAIR_HEAP_AUX_MODE | SPAIR_HEAP_MULTIPASS_MODE;
 
-	pbnm_heap_init(heap, hppt_pbnm_compare_min);
+	return hppt_spair_load(pathname);
+}
 
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		if (hppt_pbnm_doinsert(heap, k))
-			break;
+#endif /* defined(CONFIG_KARN_SPAIR_HEAP) */
 
-	if (n == hppt_entries.pt_nr)
-		return EXIT_SUCCESS;
+/******************************************************************************
+ * Rank-pairing heap
+ ******************************************************************************/
 
-	while (n--)
-		//free(pbnm_heap_keys[n].node);
-		falloc_free(&pbnm_alloc, pbnm_heap_keys[n].node);
+#if defined(CONFIG_KARN_RPAIR_HEAP)
 
-	fprintf(stderr, "failed to allocate heap node\n");
+struct hppt_rpair_key {
+	struct rpair_heap_node node;
+	unsigned int     value;
+};
 
-	return EXIT_FAILURE;
-}
+static struct hppt_rpair_key *rpair_heap_keys;
+static unsigned int           rpair_heap_min;
+static enum rpair_heap_type   rpair_heap_type;
 
 static int
-hppt_pbnm_check_heap(struct pbnm_heap *heap)
+hppt_rpair_compare_min(const struct rpair_heap_node *restrict first,
+                       const struct rpair_heap_node *restrict second)
+{
+	return hppt_compare_min((char *)&((struct hppt_rpair_key *)
+	                                  first)->value,
+	                        (char *)&((struct hppt_rpair_key *)
+	                                  second)->value);
+}
+
+static void
+hppt_rpair_insert_bulk(struct rpair_heap *heap)
 {
 	int                   n;
-	struct hppt_pbnm_key *cur, *old;
+	struct hppt_rpair_key *k;
 
-	old = hppt_pbnm_doextract(heap);
+	rpair_heap_init(heap, rpair_heap_type);
+
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		rpair_heap_insert(heap, &k->node, hppt_rpair_compare_min);
+}
+
+static int
+hppt_rpair_check_heap(struct rpair_heap *heap)
+{
+	int                    n;
+	struct hppt_rpair_key *cur, *old;
+
+	old = rpair_heap_entry(rpair_heap_extract(heap, hppt_rpair_compare_min),
+	                       struct hppt_rpair_key, node);
 
 	for (n = 1; n < hppt_entries.pt_nr; n++) {
-		cur = hppt_pbnm_doextract(heap);
+		cur = rpair_heap_entry(
+			rpair_heap_extract(heap, hppt_rpair_compare_min),
+			struct hppt_rpair_key, node);
 
 		if (old->value > cur->value)
 			return EXIT_FAILURE;
@@ -870,28 +3325,24 @@ hppt_pbnm_check_heap(struct pbnm_heap *heap)
 }
 
 static int
-hppt_pbnm_validate(void)
+hppt_rpair_validate(void)
 {
-	struct pbnm_heap      heap;
-	int                   n;
-	struct hppt_pbnm_key *k;
-
-	if (hppt_pbnm_insert_bulk(&heap))
-		return EXIT_FAILURE;
+	struct rpair_heap      heap;
+	int                    n;
+	struct hppt_rpair_key *k;
 
-	if (hppt_pbnm_check_heap(&heap)) {
+	hppt_rpair_insert_bulk(&heap);
+	if (hppt_rpair_check_heap(&heap)) {
 		fprintf(stderr, "Bogus heap insert / extract scheme\n");
 		return EXIT_FAILURE;
 	}
 
-	if (hppt_pbnm_insert_bulk(&heap))
-		return EXIT_FAILURE;
-
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= pbnm_heap_min;
-		pbnm_heap_promote(&heap, k->node);
+	hppt_rpair_insert_bulk(&heap);
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= rpair_heap_min;
+		rpair_heap_promote(&heap, &k->node, hppt_rpair_compare_min);
 	}
-	if (hppt_pbnm_check_heap(&heap)) {
+	if (hppt_rpair_check_heap(&heap)) {
 		fprintf(stderr, "Bogus heap promote scheme\n");
 		return EXIT_FAILURE;
 	}
@@ -900,17 +3351,15 @@ hppt_pbnm_validate(void)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += pbnm_heap_min;
-
-	if (hppt_pbnm_insert_bulk(&heap))
-		return EXIT_FAILURE;
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += rpair_heap_min;
 
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value += pbnm_heap_min;
-		pbnm_heap_demote(&heap, k->node);
+	hppt_rpair_insert_bulk(&heap);
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += rpair_heap_min;
+		rpair_heap_demote(&heap, &k->node, hppt_rpair_compare_min);
 	}
-	if (hppt_pbnm_check_heap(&heap)) {
+	if (hppt_rpair_check_heap(&heap)) {
 		fprintf(stderr, "Bogus heap demote scheme\n");
 		return EXIT_FAILURE;
 	}
@@ -919,46 +3368,58 @@ hppt_pbnm_validate(void)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value -= pbnm_heap_min;
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= rpair_heap_min;
 
 	return EXIT_SUCCESS;
 }
 
 static int
-hppt_pbnm_load(const char *pathname)
+hppt_rpair_load(const char *pathname, enum rpair_heap_type type)
 {
-	struct hppt_pbnm_key *k;
+	struct hppt_rpair_key *k;
+
+	rpair_heap_type = type;
 
 	if (pt_open_entries(pathname, &hppt_entries))
 		return EXIT_FAILURE;
 
-	pbnm_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*pbnm_heap_keys));
-	if (!pbnm_heap_keys)
+	rpair_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*rpair_heap_keys));
+	if (!rpair_heap_keys)
 		return EXIT_FAILURE;
 
-	falloc_init(&pbnm_alloc, sizeof(*k->node));
-
 	pt_init_entry_iter(&hppt_entries);
 
-	k = pbnm_heap_keys;
-	pbnm_heap_min = UINT_MAX;
+	k = rpair_heap_keys;
+	rpair_heap_min = UINT_MAX;
 	while (!pt_iter_entry(&hppt_entries, &k->value)) {
-		pbnm_heap_min = umin(k->value, pbnm_heap_min);
+		rpair_heap_min = umin(k->value, rpair_heap_min);
 		k++;
 	}
 
-	return hppt_pbnm_validate();
+	return hppt_rpair_validate();
+}
+
+static int
+hppt_rpair1_load(const char *pathname)
+{
+	return hppt_rpair_load(pathname, RPAIR_HEAP_TYPE1);
+}
+
+static int
+hppt_rpair2_load(const char *pathname)
+{
+	return hppt_rpair_load(pathname, RPAIR_HEAP_TYPE2);
 }
 
 static void
-hppt_pbnm_insert(unsigned long long *nsecs)
+hppt_rpair_insert(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
-	struct pbnm_heap heap;
+	struct rpair_heap heap;
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	hppt_pbnm_insert_bulk(&heap);
+	hppt_rpair_insert_bulk(&heap);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -966,17 +3427,17 @@ hppt_pbnm_insert(unsigned long long *nsecs)
 }
 
 static void
-hppt_pbnm_extract(unsigned long long *nsecs)
+hppt_rpair_extract(unsigned long long *nsecs)
 {
 	struct timespec  start, elapse;
-	struct pbnm_heap heap;
+	struct rpair_heap heap;
 	int              n;
 
-	hppt_pbnm_insert_bulk(&heap);
+	hppt_rpair_insert_bulk(&heap);
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
 	for (n = 0; n < hppt_entries.pt_nr; n++)
-		hppt_pbnm_doextract(&heap);
+		rpair_heap_extract(&heap, hppt_rpair_compare_min);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -984,20 +3445,20 @@ hppt_pbnm_extract(unsigned long long *nsecs)
 }
 
 static void
-hppt_pbnm_remove(unsigned long long *nsecs)
+hppt_rpair_remove(unsigned long long *nsecs)
 {
 	int                   n;
-	struct hppt_pbnm_key *k;
-	struct pbnm_heap      heap;
+	struct hppt_rpair_key *k;
+	struct rpair_heap      heap;
 	struct timespec       start, elapse;
 
 	*nsecs = 0;
 
-	hppt_pbnm_insert_bulk(&heap);
+	hppt_rpair_insert_bulk(&heap);
 
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		hppt_pbnm_doremove(&heap, k);
+		rpair_heap_remove(&heap, &k->node, hppt_rpair_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -1006,22 +3467,22 @@ hppt_pbnm_remove(unsigned long long *nsecs)
 }
 
 static void
-hppt_pbnm_promote(unsigned long long *nsecs)
+hppt_rpair_promote(unsigned long long *nsecs)
 {
-	int                   n;
-	struct hppt_pbnm_key *k;
-	struct pbnm_heap      heap;
-	struct timespec       start, elapse;
+	int                    n;
+	struct hppt_rpair_key *k;
+	struct rpair_heap      heap;
+	struct timespec        start, elapse;
 
 	*nsecs = 0;
 
-	hppt_pbnm_insert_bulk(&heap);
+	hppt_rpair_insert_bulk(&heap);
 
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= pbnm_heap_min;
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= rpair_heap_min;
 
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		pbnm_heap_promote(&heap, k->node);
+		rpair_heap_promote(&heap, &k->node, hppt_rpair_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -1032,30 +3493,27 @@ hppt_pbnm_promote(unsigned long long *nsecs)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		//free(k->node);
-		falloc_free(&pbnm_alloc, k->node);
-		k->value += pbnm_heap_min;
-	}
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += rpair_heap_min;
 }
 
 static void
-hppt_pbnm_demote(unsigned long long *nsecs)
+hppt_rpair_demote(unsigned long long *nsecs)
 {
-	int                   n;
-	struct hppt_pbnm_key *k;
-	struct pbnm_heap      heap;
-	struct timespec       start, elapse;
+	int                    n;
+	struct hppt_rpair_key *k;
+	struct rpair_heap      heap;
+	struct timespec        start, elapse;
 
 	*nsecs = 0;
 
-	hppt_pbnm_insert_bulk(&heap);
+	hppt_rpair_insert_bulk(&heap);
 
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value += pbnm_heap_min;
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value += rpair_heap_min;
 
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		pbnm_heap_demote(&heap, k->node);
+		rpair_heap_demote(&heap, &k->node, hppt_rpair_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -1066,64 +3524,61 @@ hppt_pbnm_demote(unsigned long long *nsecs)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = pbnm_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		//free(k->node);
-		falloc_free(&pbnm_alloc, k->node);
-		k->value -= pbnm_heap_min;
-	}
+	for (n = 0, k = rpair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value -= rpair_heap_min;
 }
 
-#endif /* defined(CONFIG_KARN_PBNM_HEAP) */
+#endif /* defined(CONFIG_KARN_RPAIR_HEAP) */
 
 /******************************************************************************
- * Singly linked list based pairing heap
+ * Relaxed weak heap
  ******************************************************************************/
 
-#if defined(CONFIG_KARN_SPAIR_HEAP)
+#if defined(CONFIG_KARN_RWK_HEAP)
 
-struct hppt_spair_key {
-	struct lcrs_node node;
-	unsigned int     value;
+struct hppt_rwk_key {
+	struct rwk_heap_node node;
+	unsigned int         value;
 };
 
-static struct hppt_spair_key *spair_heap_keys;
-static unsigned int           spair_heap_min;
+static struct hppt_rwk_key *rwk_heap_keys;
+static unsigned int         rwk_heap_min;
 
 static int
-hppt_spair_compare_min(const struct lcrs_node *restrict first,
-                       const struct lcrs_node *restrict second)
+hppt_rwk_compare_min(const struct rwk_heap_node *restrict first,
+                     const struct rwk_heap_node *restrict second)
 {
-	return pt_compare_min((char *)&((struct hppt_spair_key *)
-	                                first)->value,
-	                      (char *)&((struct hppt_spair_key *)
-	                                second)->value);
+	return hppt_compare_min((char *)&((struct hppt_rwk_key *)
+	                                  first)->value,
+	                        (char *)&((struct hppt_rwk_key *)
+	                                  second)->value);
 }
 
 static void
-hppt_spair_insert_bulk(struct spair_heap *heap)
+hppt_rwk_insert_bulk(struct rwk_heap *heap)
 {
-	int                   n;
-	struct hppt_spair_key *k;
+	int                  n;
+	struct hppt_rwk_key *k;
 
-	spair_heap_init(heap);
+	rwk_heap_init(heap);
 
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		spair_heap_insert(heap, &k->node, hppt_spair_compare_min);
+	for (n = 0, k = rwk_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		rwk_heap_insert(heap, &k->node, hppt_rwk_compare_min);
 }
 
 static int
-hppt_spair_check_heap(struct spair_heap *heap)
+hppt_rwk_check_heap(struct rwk_heap *heap)
 {
-	int                    n;
-	struct hppt_spair_key *cur, *old;
+	int                  n;
+	struct hppt_rwk_key *cur, *old;
 
-	old = spair_heap_entry(spair_heap_extract(heap, hppt_spair_compare_min),
-	                       struct hppt_spair_key, node);
+	old = rwk_heap_entry(rwk_heap_extract(heap, hppt_rwk_compare_min),
+	                     struct hppt_rwk_key, node);
 
 	for (n = 1; n < hppt_entries.pt_nr; n++) {
-		cur = spair_heap_entry(
-			spair_heap_extract(heap, hppt_spair_compare_min),
-			struct hppt_spair_key, node);
+		cur = rwk_heap_entry(rwk_heap_extract(heap,
+		                                      hppt_rwk_compare_min),
+		                     struct hppt_rwk_key, node);
 
 		if (old->value > cur->value)
 			return EXIT_FAILURE;
@@ -1135,24 +3590,24 @@ hppt_spair_check_heap(struct spair_heap *heap)
 }
 
 static int
-hppt_spair_validate(void)
+hppt_rwk_validate(void)
 {
-	struct spair_heap      heap;
-	int                    n;
-	struct hppt_spair_key *k;
+	struct rwk_heap      heap;
+	int                  n;
+	struct hppt_rwk_key *k;
 
-	hppt_spair_insert_bulk(&heap);
-	if (hppt_spair_check_heap(&heap)) {
+	hppt_rwk_insert_bulk(&heap);
+	if (hppt_rwk_check_heap(&heap)) {
 		fprintf(stderr, "Bogus heap insert / extract scheme\n");
 		return EXIT_FAILURE;
 	}
 
-	hppt_spair_insert_bulk(&heap);
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= spair_heap_min;
-		spair_heap_promote(&heap, &k->node, hppt_spair_compare_min);
+	hppt_rwk_insert_bulk(&heap);
+	for (n = 0, k = rwk_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= rwk_heap_min;
+		rwk_heap_promote(&heap, &k->node, hppt_rwk_compare_min);
 	}
-	if (hppt_spair_check_heap(&heap)) {
+	if (hppt_rwk_check_heap(&heap)) {
 		fprintf(stderr, "Bogus heap promote scheme\n");
 		return EXIT_FAILURE;
 	}
@@ -1161,61 +3616,44 @@ hppt_spair_validate(void)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += spair_heap_min;
-
-	hppt_spair_insert_bulk(&heap);
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value += spair_heap_min;
-		spair_heap_demote(&heap, &k->node, hppt_spair_compare_min);
-	}
-	if (hppt_spair_check_heap(&heap)) {
-		fprintf(stderr, "Bogus heap demote scheme\n");
-		return EXIT_FAILURE;
-	}
-
-	/*
-	 * Reset keys to their original values so that next computation loop
-	 * gives consistent numbers...
-	 */
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value -= spair_heap_min;
+	for (n = 0, k = rwk_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += rwk_heap_min;
 
 	return EXIT_SUCCESS;
 }
 
 static int
-hppt_spair_load(const char *pathname)
+hppt_rwk_load(const char *pathname)
 {
-	struct hppt_spair_key *k;
+	struct hppt_rwk_key *k;
 
 	if (pt_open_entries(pathname, &hppt_entries))
 		return EXIT_FAILURE;
 
-	spair_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*spair_heap_keys));
-	if (!spair_heap_keys)
+	rwk_heap_keys = malloc(hppt_entries.pt_nr * sizeof(*rwk_heap_keys));
+	if (!rwk_heap_keys)
 		return EXIT_FAILURE;
 
 	pt_init_entry_iter(&hppt_entries);
 
-	k = spair_heap_keys;
-	spair_heap_min = UINT_MAX;
+	k = rwk_heap_keys;
+	rwk_heap_min = UINT_MAX;
 	while (!pt_iter_entry(&hppt_entries, &k->value)) {
-		spair_heap_min = umin(k->value, spair_heap_min);
+		rwk_heap_min = umin(k->value, rwk_heap_min);
 		k++;
 	}
 
-	return hppt_spair_validate();
+	return hppt_rwk_validate();
 }
 
 static void
-hppt_spair_insert(unsigned long long *nsecs)
+hppt_rwk_insert(unsigned long long *nsecs)
 {
-	struct timespec  start, elapse;
-	struct spair_heap heap;
+	struct timespec start, elapse;
+	struct rwk_heap heap;
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-	hppt_spair_insert_bulk(&heap);
+	hppt_rwk_insert_bulk(&heap);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -1223,17 +3661,17 @@ hppt_spair_insert(unsigned long long *nsecs)
 }
 
 static void
-hppt_spair_extract(unsigned long long *nsecs)
+hppt_rwk_extract(unsigned long long *nsecs)
 {
-	struct timespec  start, elapse;
-	struct spair_heap heap;
-	int              n;
+	struct timespec start, elapse;
+	struct rwk_heap heap;
+	int             n;
 
-	hppt_spair_insert_bulk(&heap);
+	hppt_rwk_insert_bulk(&heap);
 
 	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
 	for (n = 0; n < hppt_entries.pt_nr; n++)
-		spair_heap_extract(&heap, hppt_spair_compare_min);
+		rwk_heap_extract(&heap, hppt_rwk_compare_min);
 	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 	elapse = pt_tspec_sub(&elapse, &start);
@@ -1241,75 +3679,44 @@ hppt_spair_extract(unsigned long long *nsecs)
 }
 
 static void
-hppt_spair_remove(unsigned long long *nsecs)
-{
-	int                   n;
-	struct hppt_spair_key *k;
-	struct spair_heap      heap;
-	struct timespec       start, elapse;
-
-	*nsecs = 0;
-
-	hppt_spair_insert_bulk(&heap);
-
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		spair_heap_remove(&heap, &k->node, hppt_spair_compare_min);
-		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
-
-		elapse = pt_tspec_sub(&elapse, &start);
-		*nsecs += pt_tspec2ns(&elapse);
-	}
-}
-
-static void
-hppt_spair_promote(unsigned long long *nsecs)
+hppt_rwk_remove(unsigned long long *nsecs)
 {
-	int                    n;
-	struct hppt_spair_key *k;
-	struct spair_heap      heap;
-	struct timespec        start, elapse;
+	int                  n;
+	struct hppt_rwk_key *k;
+	struct rwk_heap      heap;
+	struct timespec      start, elapse;
 
 	*nsecs = 0;
 
-	hppt_spair_insert_bulk(&heap);
-
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value -= spair_heap_min;
+	hppt_rwk_insert_bulk(&heap);
 
+	for (n = 0, k = rwk_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		spair_heap_promote(&heap, &k->node, hppt_spair_compare_min);
+		rwk_heap_remove(&heap, &k->node, hppt_rwk_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
 		*nsecs += pt_tspec2ns(&elapse);
 	}
-
-	/*
-	 * Reset keys to their original values so that next computation loop
-	 * gives consistent numbers...
-	 */
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value += spair_heap_min;
 }
 
 static void
-hppt_spair_demote(unsigned long long *nsecs)
+hppt_rwk_promote(unsigned long long *nsecs)
 {
-	int                    n;
-	struct hppt_spair_key *k;
-	struct spair_heap      heap;
-	struct timespec        start, elapse;
+	int                  n;
+	struct hppt_rwk_key *k;
+	struct rwk_heap      heap;
+	struct timespec      start, elapse;
 
 	*nsecs = 0;
 
-	hppt_spair_insert_bulk(&heap);
+	hppt_rwk_insert_bulk(&heap);
 
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
-		k->value += spair_heap_min;
+	for (n = 0, k = rwk_heap_keys; n < hppt_entries.pt_nr; n++, k++) {
+		k->value -= rwk_heap_min;
 
 		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-		spair_heap_demote(&heap, &k->node, hppt_spair_compare_min);
+		rwk_heap_promote(&heap, &k->node, hppt_rwk_compare_min);
 		clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
 
 		elapse = pt_tspec_sub(&elapse, &start);
@@ -1320,11 +3727,11 @@ hppt_spair_demote(unsigned long long *nsecs)
 	 * Reset keys to their original values so that next computation loop
 	 * gives consistent numbers...
 	 */
-	for (n = 0, k = spair_heap_keys; n < hppt_entries.pt_nr; n++, k++)
-		k->value -= spair_heap_min;
+	for (n = 0, k = rwk_heap_keys; n < hppt_entries.pt_nr; n++, k++)
+		k->value += rwk_heap_min;
 }
 
-#endif /* defined(CONFIG_KARN_SPAIR_HEAP) */
+#endif /* defined(CONFIG_KARN_RWK_HEAP) */
 
 /******************************************************************************
  * Main measurment task handling
@@ -1333,12 +3740,99 @@ hppt_spair_demote(unsigned long long *nsecs)
 static const struct hppt_iface hppt_algos[] = {
 #if defined(CONFIG_KARN_FBNR_HEAP)
 	{
-		.hppt_name    = "fbnr",
-		.hppt_load    = hppt_fbnr_load,
-		.hppt_insert  = hppt_fbnr_insert,
-		.hppt_extract = hppt_fbnr_extract,
+		.hppt_name     = "fbnr",
+		.hppt_load     = hppt_fbnr_load,
+		.hppt_insert   = hppt_fbnr_insert,
+		.hppt_extract  = hppt_fbnr_extract,
+		.hppt_remove   = NULL,
+		.hppt_build    = hppt_fbnr_build,
+		.hppt_burst    = hppt_fbnr_burst,
+		.hppt_monotone = hppt_fbnr_monotone,
+		.hppt_sparse   = hppt_fbnr_sparse
+	},
+#endif
+#if defined(CONFIG_KARN_FBNR_HEAP_GROW)
+	{
+		.hppt_name    = "fbnrg",
+		.hppt_load    = hppt_fbnrg_load,
+		.hppt_insert  = hppt_fbnrg_insert,
+		.hppt_extract = hppt_fbnrg_extract,
+		.hppt_remove  = NULL
+	},
+#endif
+#if defined(CONFIG_KARN_FDARY_HEAP)
+	{
+		.hppt_name    = "fdary4",
+		.hppt_load    = hppt_fdary4_load,
+		.hppt_insert  = hppt_fdary_insert,
+		.hppt_extract = hppt_fdary_extract,
+		.hppt_remove  = NULL,
+		.hppt_build   = hppt_fdary_build,
+		.hppt_burst   = hppt_fdary_burst
+	},
+	{
+		.hppt_name    = "fdary8",
+		.hppt_load    = hppt_fdary8_load,
+		.hppt_insert  = hppt_fdary_insert,
+		.hppt_extract = hppt_fdary_extract,
 		.hppt_remove  = NULL,
-		.hppt_build   = hppt_fbnr_build
+		.hppt_build   = hppt_fdary_build,
+		.hppt_burst   = hppt_fdary_burst
+	},
+#endif
+#if defined(CONFIG_KARN_FKEY_HEAP)
+	{
+		.hppt_name     = "fkey",
+		.hppt_load     = hppt_fkey_load,
+		.hppt_insert   = hppt_fkey_insert,
+		.hppt_extract  = hppt_fkey_extract,
+		.hppt_remove   = NULL,
+		.hppt_burst    = hppt_fkey_burst,
+		.hppt_monotone = hppt_fkey_monotone
+	},
+#endif
+#if defined(CONFIG_KARN_FIDX_HEAP)
+	{
+		.hppt_name    = "fidx",
+		.hppt_load    = hppt_fidx_load,
+		.hppt_insert  = hppt_fidx_insert,
+		.hppt_extract = hppt_fidx_extract,
+		.hppt_remove  = hppt_fidx_remove,
+		.hppt_promote = hppt_fidx_promote,
+		.hppt_demote  = hppt_fidx_demote
+	},
+#endif
+#if defined(CONFIG_KARN_FMMX_HEAP)
+	{
+		.hppt_name     = "fmmx",
+		.hppt_load     = hppt_fmmx_load,
+		.hppt_insert   = hppt_fmmx_insert,
+		.hppt_extract  = hppt_fmmx_extract,
+		.hppt_remove   = NULL,
+		.hppt_build    = hppt_fmmx_build,
+		.hppt_monotone = hppt_fmmx_monotone
+	},
+#endif
+#if defined(CONFIG_KARN_FSHD_HEAP)
+	{
+		.hppt_name     = "fshd",
+		.hppt_load     = hppt_fshd_load,
+		.hppt_insert   = hppt_fshd_insert,
+		.hppt_extract  = hppt_fshd_extract,
+		.hppt_remove   = NULL,
+		.hppt_build    = hppt_fshd_build,
+		.hppt_burst    = hppt_fshd_burst,
+		.hppt_monotone = hppt_fshd_monotone,
+		.hppt_sparse   = hppt_fshd_sparse
+	},
+#endif
+#if defined(CONFIG_KARN_RADIX_HEAP)
+	{
+		.hppt_name     = "radix",
+		.hppt_load     = hppt_radix_load,
+		.hppt_insert   = hppt_radix_insert,
+		.hppt_extract  = hppt_radix_extract,
+		.hppt_monotone = hppt_radix_monotone
 	},
 #endif
 #if defined(CONFIG_KARN_FWK_HEAP)
@@ -1348,7 +3842,17 @@ static const struct hppt_iface hppt_algos[] = {
 		.hppt_insert  = hppt_fwk_insert,
 		.hppt_extract = hppt_fwk_extract,
 		.hppt_remove  = NULL,
-		.hppt_build   = hppt_fwk_build
+		.hppt_build   = hppt_fwk_build,
+		.hppt_burst   = hppt_fwk_burst
+	},
+#endif
+#if defined(CONFIG_KARN_FWK_HEAP_GROW)
+	{
+		.hppt_name    = "fwkg",
+		.hppt_load    = hppt_fwkg_load,
+		.hppt_insert  = hppt_fwkg_insert,
+		.hppt_extract = hppt_fwkg_extract,
+		.hppt_remove  = NULL
 	},
 #endif
 #if defined(CONFIG_KARN_SBNM_HEAP)
@@ -1359,7 +3863,16 @@ static const struct hppt_iface hppt_algos[] = {
 		.hppt_extract = hppt_sbnm_extract,
 		.hppt_remove  = hppt_sbnm_remove,
 		.hppt_promote = hppt_sbnm_promote,
-		.hppt_demote  = hppt_sbnm_demote
+		.hppt_demote  = hppt_sbnm_demote,
+		.hppt_burst   = hppt_sbnm_burst,
+		.hppt_sparse  = hppt_sbnm_sparse
+	},
+	{
+		.hppt_name    = "sbnml",
+		.hppt_load    = hppt_sbnml_load,
+		.hppt_insert  = hppt_sbnml_insert,
+		.hppt_extract = hppt_sbnml_extract,
+		.hppt_sparse  = hppt_sbnml_sparse
 	},
 #endif
 #if defined(CONFIG_KARN_DBNM_HEAP)
@@ -1369,7 +3882,16 @@ static const struct hppt_iface hppt_algos[] = {
 		.hppt_insert  = hppt_dbnm_insert,
 		.hppt_extract = hppt_dbnm_extract,
 		.hppt_remove  = hppt_dbnm_remove,
-		.hppt_promote = hppt_dbnm_promote
+		.hppt_promote = hppt_dbnm_promote,
+		.hppt_burst   = hppt_dbnm_burst,
+		.hppt_sparse  = hppt_dbnm_sparse
+	},
+	{
+		.hppt_name    = "dbnml",
+		.hppt_load    = hppt_dbnml_load,
+		.hppt_insert  = hppt_dbnml_insert,
+		.hppt_extract = hppt_dbnml_extract,
+		.hppt_sparse  = hppt_dbnml_sparse
 	},
 #endif
 #if defined(CONFIG_KARN_SPAIR_HEAP)
@@ -1380,7 +3902,83 @@ static const struct hppt_iface hppt_algos[] = {
 		.hppt_extract = hppt_spair_extract,
 		.hppt_remove  = hppt_spair_remove,
 		.hppt_promote = hppt_spair_promote,
-		.hppt_demote  = hppt_spair_demote
+		.hppt_demote  = hppt_spair_demote,
+		.hppt_burst   = hppt_spair_burst,
+		.hppt_sparse  = hppt_spair_sparse
+	},
+	{
+		.hppt_name    = "spairmp",
+		.hppt_load    = hppt_spairmp_load,
+		.hppt_insert  = hppt_spair_insert,
+		.hppt_extract = hppt_spair_extract,
+		.hppt_remove  = hppt_spair_remove,
+		.hppt_promote = hppt_spair_promote,
+		.hppt_demote  = hppt_spair_demote,
+		.hppt_burst   = hppt_spair_burst,
+		.hppt_sparse  = hppt_spair_sparse
+	},
+	{
+		.hppt_name    = "spairfb",
+		.hppt_load    = hppt_spairfb_load,
+		.hppt_insert  = hppt_spair_insert,
+		.hppt_extract = hppt_spair_extract,
+		.hppt_remove  = hppt_spair_remove,
+		.hppt_promote = hppt_spair_promote,
+		.hppt_demote  = hppt_spair_demote,
+		.hppt_burst   = hppt_spair_burst,
+		.hppt_sparse  = hppt_spair_sparse
+	},
+	{
+		.hppt_name    = "spaira",
+		.hppt_load    = hppt_spaira_load,
+		.hppt_insert  = hppt_spair_insert,
+		.hppt_extract = hppt_spair_extract,
+		.hppt_remove  = hppt_spair_remove,
+		.hppt_promote = hppt_spair_promote,
+		.hppt_demote  = hppt_spair_demote,
+		.hppt_burst   = hppt_spair_burst,
+		.hppt_sparse  = hppt_spair_sparse
+	},
+	{
+		.hppt_name    = "spairamp",
+		.hppt_load    = hppt_spairamp_load,
+		.hppt_insert  = hppt_spair_insert,
+		.hppt_extract = hppt_spair_extract,
+		.hppt_remove  = hppt_spair_remove,
+		.hppt_promote = hppt_spair_promote,
+		.hppt_demote  = hppt_spair_demote,
+		.hppt_burst   = hppt_spair_burst,
+		.hppt_sparse  = hppt_spair_sparse
+	},
+#endif
+#if defined(CONFIG_KARN_RPAIR_HEAP)
+	{
+		.hppt_name    = "rpair1",
+		.hppt_load    = hppt_rpair1_load,
+		.hppt_insert  = hppt_rpair_insert,
+		.hppt_extract = hppt_rpair_extract,
+		.hppt_remove  = hppt_rpair_remove,
+		.hppt_promote = hppt_rpair_promote,
+		.hppt_demote  = hppt_rpair_demote
+	},
+	{
+		.hppt_name    = "rpair2",
+		.hppt_load    = hppt_rpair2_load,
+		.hppt_insert  = hppt_rpair_insert,
+		.hppt_extract = hppt_rpair_extract,
+		.hppt_remove  = hppt_rpair_remove,
+		.hppt_promote = hppt_rpair_promote,
+		.hppt_demote  = hppt_rpair_demote
+	},
+#endif
+#if defined(CONFIG_KARN_RWK_HEAP)
+	{
+		.hppt_name    = "rwk",
+		.hppt_load    = hppt_rwk_load,
+		.hppt_insert  = hppt_rwk_insert,
+		.hppt_extract = hppt_rwk_extract,
+		.hppt_remove  = hppt_rwk_remove,
+		.hppt_promote = hppt_rwk_promote
 	},
 #endif
 #if defined(CONFIG_KARN_PBNM_HEAP)
@@ -1391,7 +3989,8 @@ static const struct hppt_iface hppt_algos[] = {
 		.hppt_extract = hppt_pbnm_extract,
 		.hppt_remove  = hppt_pbnm_remove,
 		.hppt_promote = hppt_pbnm_promote,
-		.hppt_demote  = hppt_pbnm_demote
+		.hppt_demote  = hppt_pbnm_demote,
+		.hppt_burst   = hppt_pbnm_burst
 	},
 #endif
 };
@@ -1427,6 +4026,18 @@ pt_parse_scheme(const char               *arg,
 		if (!algo->hppt_build)
 			goto inval;
 	}
+	else if (!strcmp(arg, "burst")) {
+		if (!algo->hppt_burst)
+			goto inval;
+	}
+	else if (!strcmp(arg, "monotone")) {
+		if (!algo->hppt_monotone)
+			goto inval;
+	}
+	else if (!strcmp(arg, "sparse")) {
+		if (!algo->hppt_sparse)
+			goto inval;
+	}
 	else if (!strcmp(arg, "remove")) {
 		if (!algo->hppt_remove)
 			goto inval;
@@ -1453,6 +4064,16 @@ inval:
 	return EXIT_FAILURE;
 }
 
+static void
+hppt_report(const char *scheme, unsigned long long nsecs)
+{
+	if (hppt_count)
+		printf("%s: nsec=%llu compares=%llu\n",
+		       scheme, nsecs, hppt_compare_nr);
+	else
+		printf("%s: nsec=%llu\n", scheme, nsecs);
+}
+
 static void
 usage(const char *me)
 {
@@ -1460,6 +4081,7 @@ usage(const char *me)
 	        "Usage: %s [OPTIONS] FILE ALGORITHM LOOPS [SCHEME]\n"
 	        "where OPTIONS:\n"
 	        "    -p|--prio  PRIORITY\n"
+	        "    -c|--compares\n"
 	        "    -h|--help\n",
 	        me);
 }
@@ -1475,12 +4097,13 @@ int main(int argc, char *argv[])
 	while (true) {
 		int                        opt;
 		static const struct option lopts[] = {
-			{"help",    0, NULL, 'h'},
-			{"prio",    1, NULL, 'p'},
-			{0,         0, 0,    0}
+			{"help",     0, NULL, 'h'},
+			{"prio",     1, NULL, 'p'},
+			{"compares", 0, NULL, 'c'},
+			{0,          0, 0,    0}
 		};
 
-		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		opt = getopt_long(argc, argv, "hp:c", lopts, NULL);
 		if (opt < 0)
 			/* No more options: go parsing positional arguments. */
 			break;
@@ -1494,6 +4117,10 @@ int main(int argc, char *argv[])
 
 			break;
 
+		case 'c': /* count comparisons */
+			hppt_count = true;
+			break;
+
 		case 'h': /* Help message. */
 			usage(argv[0]);
 			return EXIT_SUCCESS;
@@ -1536,43 +4163,74 @@ int main(int argc, char *argv[])
 
 	if ((!*scheme && algo->hppt_insert) || !strcmp(scheme, "insert")) {
 		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
 			algo->hppt_insert(&nsecs);
-			printf("insert: nsec=%llu\n", nsecs);
+			hppt_report("insert", nsecs);
 		}
 	}
 
 	if ((!*scheme && algo->hppt_extract) || !strcmp(scheme, "extract")) {
 		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
 			algo->hppt_extract(&nsecs);
-			printf("extract: nsec=%llu\n", nsecs);
+			hppt_report("extract", nsecs);
 		}
 	}
 
 	if ((!*scheme && algo->hppt_build) || !strcmp(scheme, "build")) {
 		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
 			algo->hppt_build(&nsecs);
-			printf("build: nsec=%llu\n", nsecs);
+			hppt_report("build", nsecs);
+		}
+	}
+
+	if ((!*scheme && algo->hppt_burst) || !strcmp(scheme, "burst")) {
+		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
+			algo->hppt_burst(&nsecs);
+			hppt_report("burst", nsecs);
+		}
+	}
+
+	if ((!*scheme && algo->hppt_monotone) ||
+	    !strcmp(scheme, "monotone")) {
+		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
+			algo->hppt_monotone(&nsecs);
+			hppt_report("monotone", nsecs);
+		}
+	}
+
+	if ((!*scheme && algo->hppt_sparse) || !strcmp(scheme, "sparse")) {
+		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
+			algo->hppt_sparse(&nsecs);
+			hppt_report("sparse", nsecs);
 		}
 	}
 
 	if ((!*scheme && algo->hppt_remove) || !strcmp(scheme, "remove")) {
 		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
 			algo->hppt_remove(&nsecs);
-			printf("remove: nsec=%llu\n", nsecs);
+			hppt_report("remove", nsecs);
 		}
 	}
 
 	if ((!*scheme && algo->hppt_promote) || !strcmp(scheme, "promote")) {
 		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
 			algo->hppt_promote(&nsecs);
-			printf("promote: nsec=%llu\n", nsecs);
+			hppt_report("promote", nsecs);
 		}
 	}
 
 	if ((!*scheme && algo->hppt_demote) || !strcmp(scheme, "demote")) {
 		for (l = 0; l < loops; l++) {
+			hppt_compare_nr = 0;
 			algo->hppt_demote(&nsecs);
-			printf("demote: nsec=%llu\n", nsecs);
+			hppt_report("demote", nsecs);
 		}
 	}
 
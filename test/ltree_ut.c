@@ -0,0 +1,280 @@
+/**
+ * @file      ltree_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Loser tree based k-way merging unit tests implementation
+ *
+ * @defgroup ltreeut Loser tree based k-way merging unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/ltree.h>
+#include <cute/cute.h>
+#include <string.h>
+#include <errno.h>
+
+#define LTREEUT_RUN_NR (9U)
+#define LTREEUT_REC_NR (8U)
+
+struct ltreeut_rec {
+	int          key;
+	unsigned int run;
+	unsigned int seq;
+};
+
+static struct ltree       ltreeut_tree;
+static struct ltreeut_rec ltreeut_recs[LTREEUT_RUN_NR][LTREEUT_REC_NR];
+static struct ltreeut_rec ltreeut_res[LTREEUT_RUN_NR * LTREEUT_REC_NR];
+static unsigned int       ltreeut_res_nr;
+
+static int ltreeut_compare(const char *first, const char *second)
+{
+	return ((const struct ltreeut_rec *)first)->key -
+	       ((const struct ltreeut_rec *)second)->key;
+}
+
+static void ltreeut_copy(char *restrict dest, const char *restrict src)
+{
+	*(struct ltreeut_rec *)dest = *(const struct ltreeut_rec *)src;
+}
+
+/*
+ * Fill run_nr runs with r % LTREEUT_REC_NR records each, run r being made of
+ * keys (r % 4), (r % 4) + 3... so that keys of different runs collide.
+ */
+static unsigned int ltreeut_fill_runs(struct ltree_run *runs,
+                                      unsigned int      run_nr)
+{
+	unsigned int r, n;
+	unsigned int nr = 0;
+
+	for (r = 0; r < run_nr; r++) {
+		unsigned int cnt = r % LTREEUT_REC_NR;
+
+		for (n = 0; n < cnt; n++) {
+			ltreeut_recs[r][n].key = (int)((r % 4) + (3 * n));
+			ltreeut_recs[r][n].run = r;
+			ltreeut_recs[r][n].seq = n;
+		}
+
+		runs[r].ltree_next = (const char *)&ltreeut_recs[r][0];
+		runs[r].ltree_end = (const char *)&ltreeut_recs[r][cnt];
+		nr += cnt;
+	}
+
+	return nr;
+}
+
+/* Check result is sorted and that equal keys appear in run order. */
+static void ltreeut_check_result(unsigned int nr)
+{
+	unsigned int n;
+
+	for (n = 1; n < nr; n++) {
+		const struct ltreeut_rec *prev = &ltreeut_res[n - 1];
+		const struct ltreeut_rec *cur = &ltreeut_res[n];
+
+		cute_ensure(prev->key <= cur->key);
+		if (prev->key == cur->key)
+			cute_ensure((prev->run < cur->run) ||
+			            ((prev->run == cur->run) &&
+			             (prev->seq < cur->seq)));
+	}
+}
+
+static void ltreeut_setup(void)
+{
+	cute_ensure(!ltree_init(&ltreeut_tree, LTREEUT_RUN_NR));
+	ltreeut_res_nr = 0;
+}
+
+static void ltreeut_teardown(void)
+{
+	ltree_fini(&ltreeut_tree);
+}
+
+static CUTE_PNP_SUITE(ltreeut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(ltreeut_merge, &ltreeut, ltreeut_setup,
+                               ltreeut_teardown);
+
+/**
+ * Merge from 1 up to LTREEUT_RUN_NR runs into an array
+ *
+ * @ingroup ltreeut
+ */
+CUTE_PNP_TEST(ltreeut_farr, &ltreeut_merge)
+{
+	struct ltree_run runs[LTREEUT_RUN_NR];
+	unsigned int     run_nr;
+
+	for (run_nr = 1; run_nr <= LTREEUT_RUN_NR; run_nr++) {
+		unsigned int nr = ltreeut_fill_runs(runs, run_nr);
+
+		memset(ltreeut_res, 0, sizeof(ltreeut_res));
+		ltree_merge_farr(&ltreeut_tree, runs, run_nr,
+		                 (char *)ltreeut_res, sizeof(ltreeut_res[0]),
+		                 ltreeut_compare, ltreeut_copy);
+
+		ltreeut_check_result(nr);
+		if (nr < array_nr(ltreeut_res))
+			cute_ensure(!ltreeut_res[nr].key &&
+			            !ltreeut_res[nr].run &&
+			            !ltreeut_res[nr].seq);
+	}
+}
+
+static int ltreeut_output(const char *record, void *data)
+{
+	unsigned int *limit = data;
+
+	if (ltreeut_res_nr == *limit)
+		return -EPIPE;
+
+	ltreeut_copy((char *)&ltreeut_res[ltreeut_res_nr++], record);
+
+	return 0;
+}
+
+/* Hand records of ltreeut_recs over 2 by 2. */
+static int ltreeut_refill(struct ltree_run *run,
+                          unsigned int      index,
+                          void             *data __unused)
+{
+	const struct ltreeut_rec *end = &ltreeut_recs[index][index %
+	                                                     LTREEUT_REC_NR];
+	const struct ltreeut_rec *next = (const struct ltreeut_rec *)
+	                                 run->ltree_end;
+
+	if (next == end)
+		return 0;
+
+	run->ltree_next = (const char *)next;
+	run->ltree_end = (const char *)((next + 2 <= end) ? next + 2 : end);
+
+	return 0;
+}
+
+/**
+ * Merge runs refilled on demand and streamed to an output callback
+ *
+ * @ingroup ltreeut
+ */
+CUTE_PNP_TEST(ltreeut_refilled, &ltreeut_merge)
+{
+	struct ltree_run runs[LTREEUT_RUN_NR];
+	unsigned int     nr;
+	unsigned int     limit = array_nr(ltreeut_res);
+	unsigned int     r;
+
+	nr = ltreeut_fill_runs(runs, LTREEUT_RUN_NR);
+
+	/* Start with empty runs so that refilling loads them. */
+	for (r = 0; r < LTREEUT_RUN_NR; r++)
+		runs[r].ltree_end = runs[r].ltree_next;
+
+	cute_ensure(!ltree_merge_runs(&ltreeut_tree, runs, LTREEUT_RUN_NR,
+	                              sizeof(ltreeut_res[0]),
+	                              ltreeut_compare, ltreeut_refill,
+	                              ltreeut_output, &limit));
+
+	cute_ensure(ltreeut_res_nr == nr);
+	ltreeut_check_result(nr);
+}
+
+/**
+ * Check merging stops as soon as output callback fails
+ *
+ * @ingroup ltreeut
+ */
+CUTE_PNP_TEST(ltreeut_abort, &ltreeut_merge)
+{
+	struct ltree_run runs[LTREEUT_RUN_NR];
+	unsigned int     limit = 5;
+
+	ltreeut_fill_runs(runs, LTREEUT_RUN_NR);
+
+	cute_ensure(ltree_merge_runs(&ltreeut_tree, runs, LTREEUT_RUN_NR,
+	                             sizeof(ltreeut_res[0]), ltreeut_compare,
+	                             NULL, ltreeut_output, &limit) == -EPIPE);
+	cute_ensure(ltreeut_res_nr == limit);
+	ltreeut_check_result(limit);
+}
+
+#if defined(CONFIG_KARN_SLIST)
+
+struct ltreeut_node {
+	struct slist_node node;
+	int               key;
+};
+
+static int ltreeut_compare_node(const struct slist_node *restrict first,
+                                const struct slist_node *restrict second)
+{
+	return slist_entry(first, struct ltreeut_node, node)->key -
+	       slist_entry(second, struct ltreeut_node, node)->key;
+}
+
+/**
+ * Merge slist, one of them being empty, to a non empty result list
+ *
+ * @ingroup ltreeut
+ */
+CUTE_PNP_TEST(ltreeut_slist, &ltreeut_merge)
+{
+	static const int     keys[] = { 0, 4, 8, 1, 2, 9, 3, 5, 6, 7 };
+	static const int     bounds[] = { 0, 3, 6, 6, 10 };
+	struct ltreeut_node  nodes[array_nr(keys)];
+	struct ltreeut_node  head = { .key = -1 };
+	struct slist         lists[array_nr(bounds) - 1];
+	struct slist         res;
+	struct ltreeut_node *node;
+	unsigned int         l;
+	int                  n;
+
+	for (l = 0; l < array_nr(lists); l++) {
+		slist_init(&lists[l]);
+		for (n = bounds[l]; n < bounds[l + 1]; n++) {
+			nodes[n].key = keys[n];
+			slist_nqueue(&lists[l], &nodes[n].node);
+		}
+	}
+
+	slist_init(&res);
+	slist_nqueue(&res, &head.node);
+
+	ltree_merge_slist(&ltreeut_tree, &res, lists, array_nr(lists),
+	                  ltreeut_compare_node);
+
+	for (l = 0; l < array_nr(lists); l++)
+		cute_ensure(slist_empty(&lists[l]));
+
+	n = -1;
+	slist_foreach_entry(&res, node, node) {
+		cute_ensure(node->key == n);
+		n++;
+	}
+	cute_ensure(n == (int)array_nr(keys));
+	cute_ensure(slist_last_entry(&res, struct ltreeut_node, node)->key ==
+	            (int)array_nr(keys) - 1);
+}
+
+#endif /* defined(CONFIG_KARN_SLIST) */
@@ -0,0 +1,346 @@
+#include "karn_pt.h"
+#include <karn/ltree.h>
+#include <karn/fbnr_heap.h>
+#include <utils/cdefs.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <errno.h>
+#include <string.h>
+
+#define MGPT_RUN_NR_MIN (2U)
+
+struct mgpt_iface {
+	char  *mgpt_name;
+	int  (*mgpt_merge)(unsigned long long *nsecs);
+};
+
+static struct pt_entries  mgpt_entries;
+/* Keys in file order. */
+static unsigned int      *mgpt_orig;
+/* Keys split into mgpt_run_nr consecutive sorted runs. */
+static unsigned int      *mgpt_keys;
+static unsigned int      *mgpt_result;
+static unsigned int       mgpt_run_nr;
+static unsigned int       mgpt_run_max = 1024;
+
+static const unsigned int * mgpt_run_begin(unsigned int run)
+{
+	return &mgpt_keys[((size_t)mgpt_entries.pt_nr * run) / mgpt_run_nr];
+}
+
+static int mgpt_validate(void)
+{
+	int n;
+
+	for (n = 1; n < mgpt_entries.pt_nr; n++) {
+		if (mgpt_result[n - 1] > mgpt_result[n]) {
+			fprintf(stderr, "Bogus merging scheme\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Loser tree merging
+ ******************************************************************************/
+
+static int mgpt_ltree_merge(unsigned long long *nsecs)
+{
+	struct ltree      tree;
+	struct ltree_run *runs;
+	struct timespec   start, elapse;
+	unsigned int      r;
+
+	runs = malloc(mgpt_run_nr * sizeof(*runs));
+	if (!runs)
+		return EXIT_FAILURE;
+
+	if (ltree_init(&tree, mgpt_run_nr)) {
+		free(runs);
+		return EXIT_FAILURE;
+	}
+
+	for (r = 0; r < mgpt_run_nr; r++) {
+		runs[r].ltree_next = (const char *)mgpt_run_begin(r);
+		runs[r].ltree_end = (const char *)mgpt_run_begin(r + 1);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	ltree_merge_farr(&tree, runs, mgpt_run_nr, (char *)mgpt_result,
+	                 sizeof(*mgpt_result), pt_compare_min, pt_copy_key);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	ltree_fini(&tree);
+	free(runs);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	return mgpt_validate();
+}
+
+/******************************************************************************
+ * Binary heap merging
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_FBNR_HEAP)
+
+/* Heap node: key first so that pt_compare_min() may order nodes. */
+struct mgpt_fbnr_head {
+	unsigned int        key;
+	const unsigned int *next;
+	const unsigned int *end;
+};
+
+static void mgpt_fbnr_copy(char *restrict dest, const char *restrict src)
+{
+	*(struct mgpt_fbnr_head *)dest = *(const struct mgpt_fbnr_head *)src;
+}
+
+static int mgpt_fbnr_merge(unsigned long long *nsecs)
+{
+	struct fbnr_heap      *heap;
+	struct timespec        start, elapse;
+	struct mgpt_fbnr_head  head;
+	unsigned int          *res = mgpt_result;
+	unsigned int           r;
+
+	heap = fbnr_heap_create(sizeof(head), mgpt_run_nr, pt_compare_min,
+	                        mgpt_fbnr_copy);
+	if (!heap)
+		return EXIT_FAILURE;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+
+	for (r = 0; r < mgpt_run_nr; r++) {
+		head.next = mgpt_run_begin(r);
+		head.end = mgpt_run_begin(r + 1);
+		if (head.next == head.end)
+			continue;
+
+		head.key = *head.next++;
+		fbnr_heap_insert(heap, (char *)&head);
+	}
+
+	while (!fbnr_heap_empty(heap)) {
+		fbnr_heap_extract(heap, (char *)&head);
+		*res++ = head.key;
+
+		if (head.next != head.end) {
+			head.key = *head.next++;
+			fbnr_heap_insert(heap, (char *)&head);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	fbnr_heap_destroy(heap);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+
+	return mgpt_validate();
+}
+
+#endif /* defined(CONFIG_KARN_FBNR_HEAP) */
+
+/******************************************************************************
+ * Main measurement task handling
+ ******************************************************************************/
+
+static const struct mgpt_iface mgpt_algos[] = {
+	{
+		.mgpt_name  = "ltree",
+		.mgpt_merge = mgpt_ltree_merge
+	},
+#if defined(CONFIG_KARN_FBNR_HEAP)
+	{
+		.mgpt_name  = "fbnr",
+		.mgpt_merge = mgpt_fbnr_merge
+	},
+#endif
+};
+
+static const struct mgpt_iface *
+mgpt_setup_algo(const char *algo_name)
+{
+	unsigned int a;
+
+	for (a = 0; a < array_nr(mgpt_algos); a++)
+		if (!strcmp(algo_name, mgpt_algos[a].mgpt_name))
+			return &mgpt_algos[a];
+
+	fprintf(stderr, "Invalid \"%s\" merge algorithm\n", algo_name);
+
+	return NULL;
+}
+
+static int
+mgpt_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &mgpt_entries))
+		return EXIT_FAILURE;
+
+	mgpt_orig = malloc(sizeof(*k) * mgpt_entries.pt_nr);
+	mgpt_keys = malloc(sizeof(*k) * mgpt_entries.pt_nr);
+	mgpt_result = malloc(sizeof(*k) * mgpt_entries.pt_nr);
+	if (!mgpt_orig || !mgpt_keys || !mgpt_result)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&mgpt_entries);
+	k = mgpt_orig;
+	while (!pt_iter_entry(&mgpt_entries, k))
+		k++;
+
+	return EXIT_SUCCESS;
+}
+
+/* Split keys into the given number of runs and sort each of them. */
+static void
+mgpt_split(unsigned int run_nr)
+{
+	unsigned int r;
+
+	mgpt_run_nr = run_nr;
+
+	memcpy(mgpt_keys, mgpt_orig, sizeof(*mgpt_keys) * mgpt_entries.pt_nr);
+
+	for (r = 0; r < run_nr; r++) {
+		unsigned int *run = (unsigned int *)mgpt_run_begin(r);
+
+		qsort(run, (size_t)(mgpt_run_begin(r + 1) - run), sizeof(*run),
+		      pt_qsort_compare);
+	}
+}
+
+static int mgpt_parse_run_nr(const char *arg, unsigned int *run_nr)
+{
+	char          *str;
+	unsigned long  nr;
+	int            err = 0;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str)
+		err = EINVAL;
+	else if ((nr < MGPT_RUN_NR_MIN) || (nr > UINT_MAX))
+		err = ERANGE;
+
+	if (err) {
+		fprintf(stderr, "Invalid number of runs specified: %s\n",
+		        strerror(err));
+		return EXIT_FAILURE;
+	}
+
+	*run_nr = (unsigned int)nr;
+
+	return EXIT_SUCCESS;
+}
+
+static void
+usage(const char *me)
+{
+	fprintf(stderr,
+	        "Usage: %s [OPTIONS] FILE ALGORITHM LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio  PRIORITY\n"
+	        "    -r|--runs  MAX_RUNS\n"
+	        "    -h|--help\n",
+	        me);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct mgpt_iface *algo;
+	unsigned int             l, loops = 0;
+	int                      prio = 0;
+	unsigned int             nr;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help",    0, NULL, 'h'},
+			{"prio",    1, NULL, 'p'},
+			{"runs",    1, NULL, 'r'},
+			{0,         0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:r:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (pt_parse_sched_prio(optarg, &prio)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'r': /* maximum number of runs */
+			if (mgpt_parse_run_nr(optarg, &mgpt_run_max)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+
+		case '?': /* Unknown option. */
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 3) {
+		fprintf(stderr, "Invalid number of arguments\n");
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	algo = mgpt_setup_algo(argv[optind + 1]);
+	if (!algo)
+		return EXIT_FAILURE;
+
+	if (pt_parse_loop_nr(argv[optind + 2], &loops))
+		return EXIT_FAILURE;
+
+	if (mgpt_load(argv[optind]))
+		return EXIT_FAILURE;
+
+	if (pt_setup_sched_prio(prio))
+		return EXIT_FAILURE;
+
+	/* Sweep number of runs, doubling it at each step. */
+	for (nr = MGPT_RUN_NR_MIN; nr <= mgpt_run_max; nr *= 2) {
+		mgpt_split(nr);
+
+		for (l = 0; l < loops; l++) {
+			unsigned long long nsecs;
+
+			if (algo->mgpt_merge(&nsecs))
+				return EXIT_FAILURE;
+			printf("runs=%u nsec=%llu\n", nr, nsecs);
+		}
+
+		if (nr > (mgpt_run_max / 2))
+			break;
+	}
+
+	return EXIT_SUCCESS;
+}
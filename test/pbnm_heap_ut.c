@@ -1672,3 +1672,47 @@ CUTE_PNP_TEST(pbnmhut_demote_altorder, &pbnmhut_demote)
 
 	pbnmhut_fini_entries(pbnmhut_entries, array_nr(pbnmhut_entries));
 }
+
+#define PBNMHUT_BATCH_NR (40U)
+
+static CUTE_PNP_FIXTURED_SUITE(pbnmhut_batch, &pbnmhut, pbnmhut_setup_empty,
+                               NULL);
+
+CUTE_PNP_TEST(pbnmhut_batch_insert_extract, &pbnmhut_batch)
+{
+	struct pbnmhut_entry   entries[PBNMHUT_BATCH_NR];
+	struct pbnm_heap_node *keys[PBNMHUT_BATCH_NR];
+	struct pbnm_heap_node *out[PBNMHUT_BATCH_NR];
+	unsigned int           n;
+	int                    prev = -1;
+
+	pbnmhut_init_entries(entries, array_nr(entries));
+
+	for (n = 0; n < array_nr(entries); n++) {
+		entries[n].key = (int)(((n * 37U) + 11U) % array_nr(entries)) /
+		                 2;
+		keys[n] = entries[n].heap;
+	}
+
+	pbnm_heap_insert_batch(&pbnmhut_heap, keys, 25);
+	cute_ensure(pbnm_heap_count(&pbnmhut_heap) == 25);
+	pbnm_heap_insert_batch(&pbnmhut_heap, &keys[25],
+	                       array_nr(entries) - 25);
+	cute_ensure(pbnm_heap_count(&pbnmhut_heap) == array_nr(entries));
+
+	cute_ensure(pbnm_heap_extract_batch(&pbnmhut_heap, out, 10) == 10);
+	cute_ensure(pbnm_heap_extract_batch(&pbnmhut_heap, &out[10],
+	                                    array_nr(out)) ==
+	            (array_nr(entries) - 10));
+	cute_ensure(pbnm_heap_empty(&pbnmhut_heap));
+
+	for (n = 0; n < array_nr(out); n++) {
+		int key = pbnm_heap_entry(out[n], struct pbnmhut_entry,
+		                          heap)->key;
+
+		cute_ensure(key >= prev);
+		prev = key;
+	}
+
+	pbnmhut_fini_entries(entries, array_nr(entries));
+}
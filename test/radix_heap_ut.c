@@ -0,0 +1,241 @@
+/**
+ * @file      radix_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Radix heap unit tests implementation
+ *
+ * @defgroup radixhut Radix heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/radix_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+
+#define RADIXHUT_NODE_NR (200U)
+
+struct radixhut_entry {
+	struct radix_heap_node node;
+	unsigned int           id;
+};
+
+static struct radix_heap     radixhut_heap;
+static struct radixhut_entry radixhut_entries[RADIXHUT_NODE_NR];
+
+static int radixhut_qsort_compare(const void *first, const void *second)
+{
+	uint64_t fst = *(const uint64_t *)first;
+	uint64_t snd = *(const uint64_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+/* Scrambled offsets with duplicates, spanning all of 16 bits range. */
+static uint64_t radixhut_offset(unsigned int index)
+{
+	return (((uint64_t)index * 7919U) + 13U) % 65521U;
+}
+
+static void radixhut_setup(void)
+{
+	unsigned int n;
+
+	for (n = 0; n < RADIXHUT_NODE_NR; n++)
+		radixhut_entries[n].id = n;
+}
+
+static void radixhut_teardown(void)
+{
+	radix_heap_fini(&radixhut_heap);
+}
+
+/*
+ * Insert all entries with keys base + offset[n] then check extraction order
+ * and payload consistency.
+ */
+static void radixhut_check_base(uint64_t base)
+{
+	uint64_t     check[RADIXHUT_NODE_NR];
+	unsigned int n;
+
+	radix_heap_init(&radixhut_heap, base);
+	cute_ensure(radix_heap_empty(&radixhut_heap));
+	cute_ensure(radix_heap_last_key(&radixhut_heap) == base);
+
+	for (n = 0; n < RADIXHUT_NODE_NR; n++) {
+		check[n] = base + radixhut_offset(n);
+		radix_heap_insert(&radixhut_heap, &radixhut_entries[n].node,
+		                  check[n]);
+	}
+	cute_ensure(radix_heap_count(&radixhut_heap) == RADIXHUT_NODE_NR);
+
+	qsort(check, RADIXHUT_NODE_NR, sizeof(check[0]),
+	      radixhut_qsort_compare);
+
+	for (n = 0; n < RADIXHUT_NODE_NR; n++) {
+		struct radix_heap_node *node;
+		struct radixhut_entry  *ent;
+
+		node = radix_heap_peek(&radixhut_heap);
+		cute_ensure(radix_heap_node_key(node) == check[n]);
+		cute_ensure(radix_heap_last_key(&radixhut_heap) == check[n]);
+
+		cute_ensure(radix_heap_extract(&radixhut_heap) == node);
+		ent = radix_heap_entry(node, struct radixhut_entry, node);
+		cute_ensure(base + radixhut_offset(ent->id) == check[n]);
+	}
+
+	cute_ensure(radix_heap_empty(&radixhut_heap));
+}
+
+static CUTE_PNP_SUITE(radixhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(radixhut_ops, &radixhut, radixhut_setup,
+                               radixhut_teardown);
+
+/**
+ * Insert then extract nodes with keys starting from zero
+ *
+ * @ingroup radixhut
+ */
+CUTE_PNP_TEST(radixhut_insert_extract, &radixhut_ops)
+{
+	radixhut_check_base(0);
+}
+
+/**
+ * Insert then extract nodes with keys close to 32 and 64 bits upper bounds
+ *
+ * @ingroup radixhut
+ */
+CUTE_PNP_TEST(radixhut_wide_keys, &radixhut_ops)
+{
+	radixhut_check_base(UINT32_MAX - 65521U);
+	radixhut_check_base((UINT64_C(1) << 63) - 1000U);
+	radixhut_check_base(UINT64_MAX - 65521U);
+}
+
+/**
+ * Interleave insertions of keys never smaller than the last extracted one with
+ * extractions, as a Dijkstra like workload would
+ *
+ * @ingroup radixhut
+ */
+CUTE_PNP_TEST(radixhut_monotone, &radixhut_ops)
+{
+	uint64_t     last = 0;
+	unsigned int n, nr = 0;
+
+	radix_heap_init(&radixhut_heap, 0);
+
+	for (n = 0; n < RADIXHUT_NODE_NR; n++) {
+		radix_heap_insert(&radixhut_heap, &radixhut_entries[n].node,
+		                  radix_heap_last_key(&radixhut_heap) +
+		                  (radixhut_offset(n) % 100));
+		nr++;
+
+		if (n % 3) {
+			struct radix_heap_node *node;
+
+			node = radix_heap_extract(&radixhut_heap);
+			cute_ensure(radix_heap_node_key(node) >= last);
+			last = radix_heap_node_key(node);
+			nr--;
+		}
+
+		cute_ensure(radix_heap_count(&radixhut_heap) == nr);
+	}
+
+	while (!radix_heap_empty(&radixhut_heap)) {
+		struct radix_heap_node *node;
+
+		node = radix_heap_extract(&radixhut_heap);
+		cute_ensure(radix_heap_node_key(node) >= last);
+		last = radix_heap_node_key(node);
+	}
+}
+
+/**
+ * Decrease keys, moving nodes within or across buckets, then check extraction
+ * order
+ *
+ * @ingroup radixhut
+ */
+CUTE_PNP_TEST(radixhut_promote, &radixhut_ops)
+{
+	bool         hosted[RADIXHUT_NODE_NR];
+	uint64_t     last;
+	unsigned int n;
+
+	radix_heap_init(&radixhut_heap, 0);
+
+	for (n = 0; n < RADIXHUT_NODE_NR; n++) {
+		radix_heap_insert(&radixhut_heap, &radixhut_entries[n].node,
+		                  1000 + radixhut_offset(n));
+		hosted[n] = true;
+	}
+
+	/* Move last extracted key forward so that buckets get redistributed. */
+	for (n = 0; n < 50; n++) {
+		struct radix_heap_node *node = radix_heap_extract(&radixhut_heap);
+
+		hosted[radix_heap_entry(node, struct radixhut_entry, node)->id] =
+			false;
+	}
+
+	last = radix_heap_last_key(&radixhut_heap);
+	for (n = 0; n < RADIXHUT_NODE_NR; n++) {
+		struct radix_heap_node *node = &radixhut_entries[n].node;
+		uint64_t                key = radix_heap_node_key(node);
+
+		if (!hosted[n])
+			continue;
+
+		switch (n % 3) {
+		case 0:
+			/* Same key, same bucket. */
+			break;
+
+		case 1:
+			/* Half way down: usually lands into a lower bucket. */
+			key -= (key - last) / 2;
+			break;
+
+		default:
+			/* Down to the last extracted key, i.e. bucket 0. */
+			key = last;
+		}
+
+		radix_heap_promote(&radixhut_heap, node, key);
+		cute_ensure(radix_heap_node_key(node) == key);
+	}
+
+	n = 0;
+	while (!radix_heap_empty(&radixhut_heap)) {
+		struct radix_heap_node *node = radix_heap_extract(&radixhut_heap);
+
+		cute_ensure(radix_heap_node_key(node) >= last);
+		last = radix_heap_node_key(node);
+		n++;
+	}
+
+	cute_ensure(n == (RADIXHUT_NODE_NR - 50));
+}
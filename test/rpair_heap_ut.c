@@ -0,0 +1,482 @@
+/**
+ * @file      rpair_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Rank-pairing heap unit tests implementation
+ *
+ * @defgroup rpairhut Rank-pairing heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/rpair_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+
+#define RPAIRHUT_NODE_NR (128U)
+
+struct rpairhut_entry {
+	struct rpair_heap_node node;
+	int                    key;
+	bool                   hosted;
+};
+
+static struct rpair_heap     rpairhut_heap;
+static struct rpairhut_entry rpairhut_entries[RPAIRHUT_NODE_NR];
+
+static int rpairhut_compare_min(const struct rpair_heap_node *restrict first,
+                                const struct rpair_heap_node *restrict second)
+{
+	return rpair_heap_entry(first, struct rpairhut_entry, node)->key -
+	       rpair_heap_entry(second, struct rpairhut_entry, node)->key;
+}
+
+static int rpairhut_qsort_compare(const void *first, const void *second)
+{
+	return *(const int *)first - *(const int *)second;
+}
+
+static struct rpair_heap_node *
+rpairhut_left(const struct rpair_heap_node *node)
+{
+	return (struct rpair_heap_node *)node->rpair_lcrs.lcrs_youngest;
+}
+
+static struct rpair_heap_node *
+rpairhut_right(const struct rpair_heap_node *node)
+{
+	return (struct rpair_heap_node *)node->rpair_lcrs.lcrs_sibling;
+}
+
+static int rpairhut_rank(const struct rpair_heap_node *node)
+{
+	return node ? (int)node->rpair_rank : -1;
+}
+
+/*
+ * Check half ordering, parent links and rank rule of the subtree rooted at
+ * node, root being the closest ancestor node belongs to the left subtree of.
+ * Return count of nodes found.
+ */
+static unsigned int rpairhut_check_tree(const struct rpair_heap_node *root,
+                                        const struct rpair_heap_node *node,
+                                        enum rpair_heap_type          type)
+{
+	const struct rpair_heap_node *left = rpairhut_left(node);
+	const struct rpair_heap_node *right = rpairhut_right(node);
+	int                           diff0, diff1;
+
+	cute_ensure(rpairhut_compare_min(root, node) <= 0);
+
+	diff0 = (int)node->rpair_rank - rpairhut_rank(left);
+	diff1 = (int)node->rpair_rank - rpairhut_rank(right);
+	if (diff0 > diff1) {
+		int tmp = diff0;
+
+		diff0 = diff1;
+		diff1 = tmp;
+	}
+
+	cute_ensure(diff0 >= 0);
+	if (diff0 == 0)
+		cute_ensure(diff1 >= 1);
+	else if (type == RPAIR_HEAP_TYPE1)
+		cute_ensure((diff0 == 1) && (diff1 == 1));
+	else
+		cute_ensure((diff0 == 1) && (diff1 <= 2));
+
+	if (left) {
+		cute_ensure(left->rpair_parent == node);
+		cute_ensure(rpair_heap_entry(left, struct rpairhut_entry,
+		                             node)->hosted);
+	}
+	if (right) {
+		cute_ensure(right->rpair_parent == node);
+		cute_ensure(rpair_heap_entry(right, struct rpairhut_entry,
+		                             node)->hosted);
+	}
+
+	return 1 + (left ? rpairhut_check_tree(node, left, type) : 0) +
+	       (right ? rpairhut_check_tree(root, right, type) : 0);
+}
+
+static void rpairhut_check_heap(const struct rpair_heap *heap)
+{
+	const struct rpair_heap_node *min = heap->rpair_min;
+	const struct rpair_heap_node *root;
+	unsigned int                  cnt = 0;
+
+	if (!min) {
+		cute_ensure(rpair_heap_empty(heap));
+		return;
+	}
+
+	root = min;
+	do {
+		const struct rpair_heap_node *left = rpairhut_left(root);
+
+		cute_ensure(!root->rpair_parent);
+		cute_ensure(rpair_heap_entry(root, struct rpairhut_entry,
+		                             node)->hosted);
+		cute_ensure(rpairhut_compare_min(min, root) <= 0);
+		cute_ensure((int)root->rpair_rank == (rpairhut_rank(left) + 1));
+
+		cnt++;
+		if (left) {
+			cute_ensure(left->rpair_parent == root);
+			cnt += rpairhut_check_tree(root, left, heap->rpair_type);
+		}
+
+		root = rpairhut_right(root);
+	} while (root != min);
+
+	cute_ensure(cnt == rpair_heap_count(heap));
+}
+
+/* Extract all hosted entries, checking they come out in order. */
+static void rpairhut_check_extract(struct rpair_heap *heap)
+{
+	int          check[RPAIRHUT_NODE_NR];
+	unsigned int n, nr = 0;
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++)
+		if (rpairhut_entries[n].hosted)
+			check[nr++] = rpairhut_entries[n].key;
+	cute_ensure(rpair_heap_count(heap) == nr);
+
+	qsort(check, nr, sizeof(check[0]), rpairhut_qsort_compare);
+
+	for (n = 0; n < nr; n++) {
+		struct rpair_heap_node *node = rpair_heap_peek(heap);
+		struct rpairhut_entry  *ent;
+
+		cute_ensure(rpair_heap_extract(heap, rpairhut_compare_min) ==
+		            node);
+		ent = rpair_heap_entry(node, struct rpairhut_entry, node);
+		cute_ensure(ent->key == check[n]);
+		ent->hosted = false;
+
+		rpairhut_check_heap(heap);
+	}
+
+	cute_ensure(rpair_heap_empty(heap));
+}
+
+/* Insert all entries with scrambled keys, including duplicates. */
+static void rpairhut_insert_all(struct rpair_heap *heap)
+{
+	unsigned int n;
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++) {
+		struct rpairhut_entry *ent = &rpairhut_entries[n];
+
+		ent->key = (int)(((n * 37U) + 11U) % RPAIRHUT_NODE_NR) / 2;
+		ent->hosted = true;
+		rpair_heap_insert(heap, &ent->node, rpairhut_compare_min);
+	}
+
+	rpairhut_check_heap(heap);
+}
+
+/*
+ * Extract a few entries so that half trees of various shapes and ranks get
+ * built.
+ */
+static void rpairhut_build(struct rpair_heap *heap, enum rpair_heap_type type)
+{
+	unsigned int n;
+
+	rpair_heap_init(heap, type);
+	rpairhut_insert_all(heap);
+
+	for (n = 0; n < (RPAIRHUT_NODE_NR / 8); n++) {
+		struct rpair_heap_node *node;
+
+		node = rpair_heap_extract(heap, rpairhut_compare_min);
+		rpair_heap_entry(node, struct rpairhut_entry, node)->hosted =
+			false;
+	}
+
+	rpairhut_check_heap(heap);
+}
+
+static void rpairhut_check_promote(enum rpair_heap_type type)
+{
+	unsigned int n;
+
+	rpairhut_build(&rpairhut_heap, type);
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++) {
+		struct rpairhut_entry *ent = &rpairhut_entries[n];
+
+		if (!ent->hosted)
+			continue;
+
+		/* Keep a few nodes in place, push others down to the top. */
+		ent->key -= (n % 3) ? (int)(n % 17) : 0;
+		rpair_heap_promote(&rpairhut_heap, &ent->node,
+		                   rpairhut_compare_min);
+		rpairhut_check_heap(&rpairhut_heap);
+
+		/* Interleave extractions to relink promoted nodes. */
+		if (!(n % 8)) {
+			struct rpair_heap_node *node;
+
+			node = rpair_heap_extract(&rpairhut_heap,
+			                          rpairhut_compare_min);
+			rpair_heap_entry(node, struct rpairhut_entry,
+			                 node)->hosted = false;
+			rpairhut_check_heap(&rpairhut_heap);
+		}
+	}
+
+	rpairhut_check_extract(&rpairhut_heap);
+}
+
+static void rpairhut_check_demote(enum rpair_heap_type type)
+{
+	unsigned int n;
+
+	rpairhut_build(&rpairhut_heap, type);
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++) {
+		struct rpairhut_entry *ent = &rpairhut_entries[n];
+
+		if (!ent->hosted)
+			continue;
+
+		ent->key += (n % 3) ? (int)(n % 23) : 0;
+		rpair_heap_demote(&rpairhut_heap, &ent->node,
+		                  rpairhut_compare_min);
+		rpairhut_check_heap(&rpairhut_heap);
+	}
+
+	/* Demote smallest node which requires searching for a new one. */
+	rpair_heap_entry(rpair_heap_peek(&rpairhut_heap), struct rpairhut_entry,
+	                 node)->key += (int)RPAIRHUT_NODE_NR;
+	rpair_heap_demote(&rpairhut_heap, rpair_heap_peek(&rpairhut_heap),
+	                  rpairhut_compare_min);
+	rpairhut_check_heap(&rpairhut_heap);
+
+	rpairhut_check_extract(&rpairhut_heap);
+}
+
+static void rpairhut_check_remove(enum rpair_heap_type type)
+{
+	unsigned int n;
+
+	rpairhut_build(&rpairhut_heap, type);
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n += 3) {
+		struct rpairhut_entry *ent = &rpairhut_entries[n];
+
+		if (!ent->hosted)
+			continue;
+
+		rpair_heap_remove(&rpairhut_heap, &ent->node,
+		                  rpairhut_compare_min);
+		ent->hosted = false;
+		rpairhut_check_heap(&rpairhut_heap);
+	}
+
+	rpairhut_check_extract(&rpairhut_heap);
+}
+
+static void rpairhut_teardown(void)
+{
+	rpair_heap_fini(&rpairhut_heap);
+}
+
+static CUTE_PNP_SUITE(rpairhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(rpairhut_ops, &rpairhut, NULL,
+                               rpairhut_teardown);
+
+/**
+ * Check heaps are initialized empty
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_init, &rpairhut_ops)
+{
+	rpair_heap_init(&rpairhut_heap, RPAIR_HEAP_TYPE2);
+
+	cute_ensure(rpair_heap_empty(&rpairhut_heap));
+	rpairhut_check_heap(&rpairhut_heap);
+}
+
+/**
+ * Insert then extract a single node
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_single, &rpairhut_ops)
+{
+	struct rpairhut_entry *ent = &rpairhut_entries[0];
+
+	rpair_heap_init(&rpairhut_heap, RPAIR_HEAP_TYPE2);
+
+	ent->key = 2;
+	ent->hosted = true;
+	rpair_heap_insert(&rpairhut_heap, &ent->node, rpairhut_compare_min);
+	cute_ensure(rpair_heap_count(&rpairhut_heap) == 1U);
+	cute_ensure(rpair_heap_peek(&rpairhut_heap) == &ent->node);
+	rpairhut_check_heap(&rpairhut_heap);
+
+	rpair_heap_remove(&rpairhut_heap, &ent->node, rpairhut_compare_min);
+	cute_ensure(rpair_heap_empty(&rpairhut_heap));
+
+	rpair_heap_insert(&rpairhut_heap, &ent->node, rpairhut_compare_min);
+	cute_ensure(rpair_heap_extract(&rpairhut_heap, rpairhut_compare_min) ==
+	            &ent->node);
+	cute_ensure(rpair_heap_empty(&rpairhut_heap));
+}
+
+/**
+ * Insert then extract RPAIRHUT_NODE_NR nodes using both rank rules
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_insert_extract, &rpairhut_ops)
+{
+	rpair_heap_init(&rpairhut_heap, RPAIR_HEAP_TYPE1);
+	rpairhut_insert_all(&rpairhut_heap);
+	rpairhut_check_extract(&rpairhut_heap);
+
+	rpair_heap_init(&rpairhut_heap, RPAIR_HEAP_TYPE2);
+	rpairhut_insert_all(&rpairhut_heap);
+	rpairhut_check_extract(&rpairhut_heap);
+}
+
+/**
+ * Decrease keys of nodes located anywhere in half trees then check extraction
+ * order
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_promote, &rpairhut_ops)
+{
+	rpairhut_check_promote(RPAIR_HEAP_TYPE1);
+	rpairhut_check_promote(RPAIR_HEAP_TYPE2);
+}
+
+/**
+ * Increase keys of nodes located anywhere in half trees then check extraction
+ * order
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_demote, &rpairhut_ops)
+{
+	rpairhut_check_demote(RPAIR_HEAP_TYPE1);
+	rpairhut_check_demote(RPAIR_HEAP_TYPE2);
+}
+
+/**
+ * Remove nodes located anywhere in half trees then check extraction order
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_remove, &rpairhut_ops)
+{
+	rpairhut_check_remove(RPAIR_HEAP_TYPE1);
+	rpairhut_check_remove(RPAIR_HEAP_TYPE2);
+}
+
+/**
+ * Merge heaps, including empty ones, then check extraction order
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_merge, &rpairhut_ops)
+{
+	struct rpair_heap source;
+	unsigned int      n;
+
+	rpair_heap_init(&rpairhut_heap, RPAIR_HEAP_TYPE2);
+	rpair_heap_init(&source, RPAIR_HEAP_TYPE2);
+
+	rpair_heap_merge(&rpairhut_heap, &source, rpairhut_compare_min);
+	cute_ensure(rpair_heap_empty(&rpairhut_heap));
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++) {
+		struct rpairhut_entry *ent = &rpairhut_entries[n];
+
+		ent->key = (int)(((n * 13U) + 5U) % RPAIRHUT_NODE_NR);
+		ent->hosted = true;
+		rpair_heap_insert((n & 1) ? &source : &rpairhut_heap,
+		                  &ent->node, rpairhut_compare_min);
+
+		/* Shape half trees of the first heap. */
+		if (n == (RPAIRHUT_NODE_NR / 2)) {
+			struct rpair_heap_node *node;
+
+			node = rpair_heap_extract(&rpairhut_heap,
+			                          rpairhut_compare_min);
+			rpair_heap_entry(node, struct rpairhut_entry,
+			                 node)->hosted = false;
+		}
+	}
+
+	rpair_heap_merge(&rpairhut_heap, &source, rpairhut_compare_min);
+	cute_ensure(rpair_heap_empty(&source));
+	rpairhut_check_heap(&rpairhut_heap);
+
+	/* Merge into an empty heap. */
+	rpair_heap_merge(&source, &rpairhut_heap, rpairhut_compare_min);
+	cute_ensure(rpair_heap_empty(&rpairhut_heap));
+	rpairhut_check_heap(&source);
+
+	rpairhut_check_extract(&source);
+}
+
+/**
+ * Insert nodes by batch then extract them
+ *
+ * @ingroup rpairhut
+ */
+CUTE_PNP_TEST(rpairhut_batch, &rpairhut_ops)
+{
+	struct rpair_heap_node *nodes[RPAIRHUT_NODE_NR];
+	unsigned int            n;
+
+	rpair_heap_init(&rpairhut_heap, RPAIR_HEAP_TYPE1);
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++) {
+		rpairhut_entries[n].key = (int)(((n * 37U) + 11U) %
+		                                RPAIRHUT_NODE_NR);
+		rpairhut_entries[n].hosted = true;
+		nodes[n] = &rpairhut_entries[n].node;
+	}
+
+	rpair_heap_insert_batch(&rpairhut_heap, nodes, RPAIRHUT_NODE_NR,
+	                        rpairhut_compare_min);
+	rpairhut_check_heap(&rpairhut_heap);
+
+	for (n = 0; n < RPAIRHUT_NODE_NR; n++) {
+		struct rpair_heap_node *node;
+
+		node = rpair_heap_extract(&rpairhut_heap, rpairhut_compare_min);
+		cute_ensure(rpair_heap_entry(node, struct rpairhut_entry,
+		                             node)->key == (int)n);
+	}
+
+	cute_ensure(rpair_heap_empty(&rpairhut_heap));
+}
@@ -0,0 +1,451 @@
+/**
+ * @file      rwk_heap_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * Relaxed weak heap unit tests implementation
+ *
+ * @defgroup rwkhut Relaxed weak heap unit tests
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/rwk_heap.h>
+#include <cute/cute.h>
+#include <stdlib.h>
+
+#define RWKHUT_NODE_NR (128U)
+
+struct rwkhut_entry {
+	struct rwk_heap_node node;
+	int                  key;
+	bool                 hosted;
+};
+
+static struct rwk_heap     rwkhut_heap;
+static struct rwkhut_entry rwkhut_entries[RWKHUT_NODE_NR];
+
+static int rwkhut_compare_min(const struct rwk_heap_node *restrict first,
+                              const struct rwk_heap_node *restrict second)
+{
+	return rwk_heap_entry(first, struct rwkhut_entry, node)->key -
+	       rwk_heap_entry(second, struct rwkhut_entry, node)->key;
+}
+
+static int rwkhut_qsort_compare(const void *first, const void *second)
+{
+	return *(const int *)first - *(const int *)second;
+}
+
+static struct rwk_heap_node * rwkhut_youngest(const struct rwk_heap_node *node)
+{
+	return (struct rwk_heap_node *)node->rwk_lcrs.lcrs_youngest;
+}
+
+static struct rwk_heap_node * rwkhut_next(const struct rwk_heap_node *node)
+{
+	return (struct rwk_heap_node *)node->rwk_lcrs.lcrs_sibling;
+}
+
+static bool rwkhut_marked(const struct rwk_heap_node *node)
+{
+	return node && (node->rwk_state != RWK_HEAP_CLEAN);
+}
+
+/*
+ * Check binomial shape, links, weak heap ordering and marks of the subtree
+ * rooted at node, skipping ordering of marked nodes against their parent.
+ * Return count of nodes found and update count of marked nodes found per
+ * state.
+ */
+static unsigned int rwkhut_check_tree(const struct rwk_heap_node *node,
+                                      const struct rwk_heap_node *min,
+                                      unsigned int                states[])
+{
+	const struct rwk_heap_node *child = rwkhut_youngest(node);
+	const struct rwk_heap_node *prev = NULL;
+	unsigned int                rank = node->rwk_rank;
+	unsigned int                cnt = 1;
+
+	cute_ensure(rwk_heap_entry(node, struct rwkhut_entry, node)->hosted);
+
+	while (child) {
+		cute_ensure(rank);
+		cute_ensure(child->rwk_rank == --rank);
+		cute_ensure(child->rwk_parent == node);
+		cute_ensure(child->rwk_prev == prev);
+
+		if (rwkhut_marked(child)) {
+			enum rwk_heap_state state;
+
+			if (rwkhut_marked(prev))
+				state = RWK_HEAP_MEMBER;
+			else if (rwkhut_marked(rwkhut_next(child)))
+				state = RWK_HEAP_RUN;
+			else
+				state = RWK_HEAP_SINGLE;
+			cute_ensure(child->rwk_state == state);
+			cute_ensure(rwkhut_compare_min(min, child) <= 0);
+
+			states[state]++;
+		}
+		else
+			cute_ensure(rwkhut_compare_min(node, child) <= 0);
+
+		cnt += rwkhut_check_tree(child, min, states);
+
+		prev = child;
+		child = rwkhut_next(child);
+	}
+
+	cute_ensure(!rank);
+
+	return cnt;
+}
+
+static unsigned int rwkhut_check_root(const struct rwk_heap_node *node,
+                                      unsigned int                rank,
+                                      const struct rwk_heap_node *min,
+                                      unsigned int                states[])
+{
+	cute_ensure(node->rwk_rank == rank);
+	cute_ensure(!node->rwk_parent);
+	cute_ensure(!rwkhut_marked(node));
+	cute_ensure(rwkhut_compare_min(min, node) <= 0);
+
+	return rwkhut_check_tree(node, min, states);
+}
+
+/* Check list of marked nodes holds nodes of given state and return length. */
+static unsigned int rwkhut_check_marks(const struct dlist_node *list,
+                                       enum rwk_heap_state      state)
+{
+	const struct rwk_heap_node *node;
+	unsigned int                cnt = 0;
+
+	dlist_foreach_entry(list, node, rwk_mark) {
+		cute_ensure(node->rwk_state == state);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+static void rwkhut_check_heap(const struct rwk_heap *heap)
+{
+	const struct rwk_heap_node *min;
+	unsigned int                cnt = 0;
+	unsigned int                states[RWK_HEAP_RUN + 1] = { 0, };
+	unsigned int                singles = 0;
+	unsigned int                marks;
+	bool                        carry = false;
+	unsigned int                r;
+
+	cute_ensure(!(heap->rwk_carries_bmap & ~heap->rwk_roots_bmap));
+	cute_ensure(!(heap->rwk_pairs_bmap & ~heap->rwk_singles_bmap));
+
+	if (rwk_heap_empty(heap)) {
+		cute_ensure(!heap->rwk_roots_bmap);
+		cute_ensure(!heap->rwk_singles_bmap);
+		cute_ensure(!heap->rwk_marks_nr);
+		cute_ensure(dlist_empty(&heap->rwk_runs));
+		return;
+	}
+
+	min = rwk_heap_peek(heap, rwkhut_compare_min);
+	cute_ensure(rwk_heap_entry(min, struct rwkhut_entry, node)->hosted);
+
+	for (r = 0; r < RWK_HEAP_RANK_NR; r++) {
+		const struct rwk_heap_node *node;
+		uint32_t                    bit = UINT32_C(1) << r;
+		unsigned int                nr;
+
+		nr = rwkhut_check_marks(&heap->rwk_singles[r],
+		                        RWK_HEAP_SINGLE);
+		cute_ensure(!nr == !(heap->rwk_singles_bmap & bit));
+		cute_ensure((nr > 1) == !!(heap->rwk_pairs_bmap & bit));
+		singles += nr;
+
+		if (!(heap->rwk_roots_bmap & bit)) {
+			/* A rank with no tree lies between ranks holding 2. */
+			carry = false;
+			continue;
+		}
+
+		if (heap->rwk_carries_bmap & bit) {
+			cute_ensure(!carry);
+			carry = true;
+		}
+
+		node = heap->rwk_roots[r];
+		cute_ensure(!node->rwk_prev);
+		cnt += rwkhut_check_root(node, r, min, states);
+
+		/* Second tree of same rank is chained as next root sibling. */
+		node = rwkhut_next(node);
+		cute_ensure(!node == !(heap->rwk_carries_bmap & bit));
+		if (node) {
+			cute_ensure(node->rwk_prev == heap->rwk_roots[r]);
+			cute_ensure(!rwkhut_next(node));
+			cnt += rwkhut_check_root(node, r, min, states);
+		}
+	}
+
+	cute_ensure(cnt == rwk_heap_count(heap));
+	cute_ensure(singles == states[RWK_HEAP_SINGLE]);
+	cute_ensure(states[RWK_HEAP_RUN] ==
+	            rwkhut_check_marks(&heap->rwk_runs, RWK_HEAP_RUN));
+
+	/* No more marks than ranks non root nodes may have. */
+	marks = states[RWK_HEAP_SINGLE] + states[RWK_HEAP_RUN] +
+	        states[RWK_HEAP_MEMBER];
+	cute_ensure(marks == heap->rwk_marks_nr);
+	cute_ensure(marks <= (unsigned int)(31 - __builtin_clz(cnt)));
+}
+
+/* Extract all hosted entries, checking they come out in order. */
+static void rwkhut_check_extract(struct rwk_heap *heap)
+{
+	int          check[RWKHUT_NODE_NR];
+	unsigned int n, nr = 0;
+
+	for (n = 0; n < RWKHUT_NODE_NR; n++)
+		if (rwkhut_entries[n].hosted)
+			check[nr++] = rwkhut_entries[n].key;
+	cute_ensure(rwk_heap_count(heap) == nr);
+
+	qsort(check, nr, sizeof(check[0]), rwkhut_qsort_compare);
+
+	for (n = 0; n < nr; n++) {
+		struct rwk_heap_node *node;
+		struct rwkhut_entry  *ent;
+
+		node = rwk_heap_peek(heap, rwkhut_compare_min);
+
+		cute_ensure(rwk_heap_extract(heap, rwkhut_compare_min) == node);
+		ent = rwk_heap_entry(node, struct rwkhut_entry, node);
+		cute_ensure(ent->key == check[n]);
+		ent->hosted = false;
+
+		rwkhut_check_heap(heap);
+	}
+
+	cute_ensure(rwk_heap_empty(heap));
+}
+
+/* Insert all entries with scrambled keys, including duplicates. */
+static void rwkhut_insert_all(struct rwk_heap *heap)
+{
+	unsigned int n;
+
+	for (n = 0; n < RWKHUT_NODE_NR; n++) {
+		struct rwkhut_entry *ent = &rwkhut_entries[n];
+
+		ent->key = (int)(((n * 37U) + 11U) % RWKHUT_NODE_NR) / 2;
+		ent->hosted = true;
+		rwk_heap_insert(heap, &ent->node, rwkhut_compare_min);
+	}
+
+	rwkhut_check_heap(heap);
+}
+
+/* Extract a few entries so that trees of various ranks get built. */
+static void rwkhut_build(struct rwk_heap *heap)
+{
+	unsigned int n;
+
+	rwk_heap_init(heap);
+	rwkhut_insert_all(heap);
+
+	for (n = 0; n < (RWKHUT_NODE_NR / 8); n++) {
+		struct rwk_heap_node *node;
+
+		node = rwk_heap_extract(heap, rwkhut_compare_min);
+		rwk_heap_entry(node, struct rwkhut_entry, node)->hosted = false;
+	}
+
+	rwkhut_check_heap(heap);
+}
+
+static void rwkhut_teardown(void)
+{
+	rwk_heap_fini(&rwkhut_heap);
+}
+
+static CUTE_PNP_SUITE(rwkhut, NULL);
+
+static CUTE_PNP_FIXTURED_SUITE(rwkhut_ops, &rwkhut, NULL, rwkhut_teardown);
+
+/**
+ * Check heaps are initialized empty
+ *
+ * @ingroup rwkhut
+ */
+CUTE_PNP_TEST(rwkhut_init, &rwkhut_ops)
+{
+	rwk_heap_init(&rwkhut_heap);
+
+	cute_ensure(rwk_heap_empty(&rwkhut_heap));
+	rwkhut_check_heap(&rwkhut_heap);
+}
+
+/**
+ * Insert then extract a single node
+ *
+ * @ingroup rwkhut
+ */
+CUTE_PNP_TEST(rwkhut_single, &rwkhut_ops)
+{
+	struct rwkhut_entry *ent = &rwkhut_entries[0];
+
+	rwk_heap_init(&rwkhut_heap);
+
+	ent->key = 2;
+	ent->hosted = true;
+	rwk_heap_insert(&rwkhut_heap, &ent->node, rwkhut_compare_min);
+	cute_ensure(rwk_heap_count(&rwkhut_heap) == 1U);
+	cute_ensure(rwk_heap_peek(&rwkhut_heap, rwkhut_compare_min) ==
+	            &ent->node);
+	rwkhut_check_heap(&rwkhut_heap);
+
+	rwk_heap_remove(&rwkhut_heap, &ent->node, rwkhut_compare_min);
+	cute_ensure(rwk_heap_empty(&rwkhut_heap));
+
+	rwk_heap_insert(&rwkhut_heap, &ent->node, rwkhut_compare_min);
+	cute_ensure(rwk_heap_extract(&rwkhut_heap, rwkhut_compare_min) ==
+	            &ent->node);
+	cute_ensure(rwk_heap_empty(&rwkhut_heap));
+}
+
+/**
+ * Insert then extract RWKHUT_NODE_NR nodes
+ *
+ * @ingroup rwkhut
+ */
+CUTE_PNP_TEST(rwkhut_insert_extract, &rwkhut_ops)
+{
+	rwk_heap_init(&rwkhut_heap);
+	rwkhut_insert_all(&rwkhut_heap);
+	rwkhut_check_extract(&rwkhut_heap);
+}
+
+/**
+ * Decrease keys of nodes located anywhere in trees then check extraction order
+ *
+ * @ingroup rwkhut
+ */
+CUTE_PNP_TEST(rwkhut_promote, &rwkhut_ops)
+{
+	unsigned int n;
+
+	rwkhut_build(&rwkhut_heap);
+
+	for (n = 0; n < RWKHUT_NODE_NR; n++) {
+		struct rwkhut_entry *ent = &rwkhut_entries[(n * 5U) %
+		                                           RWKHUT_NODE_NR];
+
+		if (!ent->hosted)
+			continue;
+
+		/* Keep a few nodes in place, push others up to the top. */
+		ent->key -= (n % 3) ? (int)(n % 29) : 0;
+		rwk_heap_promote(&rwkhut_heap, &ent->node, rwkhut_compare_min);
+		rwkhut_check_heap(&rwkhut_heap);
+
+		/* Interleave extractions to remove marked nodes. */
+		if (!(n % 8)) {
+			struct rwk_heap_node *node;
+
+			node = rwk_heap_extract(&rwkhut_heap,
+			                        rwkhut_compare_min);
+			rwk_heap_entry(node, struct rwkhut_entry,
+			               node)->hosted = false;
+			rwkhut_check_heap(&rwkhut_heap);
+		}
+	}
+
+	rwkhut_check_extract(&rwkhut_heap);
+}
+
+/**
+ * Remove nodes located anywhere in trees then check extraction order
+ *
+ * @ingroup rwkhut
+ */
+CUTE_PNP_TEST(rwkhut_remove, &rwkhut_ops)
+{
+	unsigned int n;
+
+	rwkhut_build(&rwkhut_heap);
+
+	for (n = 0; n < RWKHUT_NODE_NR; n += 3) {
+		struct rwkhut_entry *ent = &rwkhut_entries[n];
+
+		if (!ent->hosted)
+			continue;
+
+		rwk_heap_remove(&rwkhut_heap, &ent->node, rwkhut_compare_min);
+		ent->hosted = false;
+		rwkhut_check_heap(&rwkhut_heap);
+	}
+
+	rwkhut_check_extract(&rwkhut_heap);
+}
+
+/**
+ * Interleave promotions, removals and insertions of marked and unmarked nodes
+ * then check extraction order
+ *
+ * @ingroup rwkhut
+ */
+CUTE_PNP_TEST(rwkhut_mixed, &rwkhut_ops)
+{
+	unsigned int seed = 7;
+	unsigned int n;
+
+	rwkhut_build(&rwkhut_heap);
+
+	for (n = 0; n < (16 * RWKHUT_NODE_NR); n++) {
+		struct rwkhut_entry *ent;
+
+		seed = (seed * 1103515245U) + 12345U;
+		ent = &rwkhut_entries[(seed >> 8) % RWKHUT_NODE_NR];
+
+		if (!ent->hosted) {
+			ent->key = (int)((seed >> 4) % RWKHUT_NODE_NR);
+			ent->hosted = true;
+			rwk_heap_insert(&rwkhut_heap, &ent->node,
+			                rwkhut_compare_min);
+		}
+		else if ((seed >> 20) % 5) {
+			ent->key -= (int)((seed >> 12) % 64);
+			rwk_heap_promote(&rwkhut_heap, &ent->node,
+			                 rwkhut_compare_min);
+		}
+		else {
+			rwk_heap_remove(&rwkhut_heap, &ent->node,
+			                rwkhut_compare_min);
+			ent->hosted = false;
+		}
+
+		rwkhut_check_heap(&rwkhut_heap);
+	}
+
+	rwkhut_check_extract(&rwkhut_heap);
+}
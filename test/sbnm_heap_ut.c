@@ -2090,3 +2090,184 @@ CUTE_PNP_TEST(sbnmhut_remove27, &sbnmhut_remove)
 	sbnmhut_check_remove(&sbnmhut_heap, 8, sbnmhut_remove_nodes, checks,
 	                     array_nr(sbnmhut_remove_nodes));
 }
+
+#define SBNMHUT_BATCH_NR (40U)
+
+static void sbnmhut_check_batch(struct sbnmhut_node *nodes,
+                                unsigned int        nr)
+{
+	struct sbnm_heap_node *keys[SBNMHUT_BATCH_NR];
+	struct sbnm_heap_node *out[SBNMHUT_BATCH_NR];
+	unsigned int           n;
+	int                    prev = -1;
+
+	for (n = 0; n < nr; n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % nr) / 2;
+		keys[n] = &nodes[n].heap;
+	}
+
+	sbnm_heap_insert_batch(&sbnmhut_heap, keys, 25);
+	cute_ensure(sbnm_heap_count(&sbnmhut_heap) == 25);
+	sbnm_heap_insert_batch(&sbnmhut_heap, &keys[25], nr - 25);
+	cute_ensure(sbnm_heap_count(&sbnmhut_heap) == nr);
+
+	cute_ensure(sbnm_heap_extract_batch(&sbnmhut_heap, out, 10) == 10);
+	cute_ensure(sbnm_heap_extract_batch(&sbnmhut_heap, &out[10], nr) ==
+	            (nr - 10));
+	cute_ensure(sbnm_heap_empty(&sbnmhut_heap));
+
+	for (n = 0; n < nr; n++) {
+		int key = ((struct sbnmhut_node *)out[n])->key;
+
+		cute_ensure(key >= prev);
+		prev = key;
+	}
+}
+
+static CUTE_PNP_FIXTURED_SUITE(sbnmhut_batch, &sbnmhut, sbnmhut_setup_empty,
+                               NULL);
+
+CUTE_PNP_TEST(sbnmhut_batch_insert_extract, &sbnmhut_batch)
+{
+	struct sbnmhut_node nodes[SBNMHUT_BATCH_NR];
+
+	sbnmhut_check_batch(nodes, array_nr(nodes));
+}
+
+#define SBNMHUT_LAZY_NR (40U)
+
+static void sbnmhut_insert_lazy(struct sbnm_heap    *heap,
+                                struct sbnmhut_node *nodes,
+                                unsigned int         nr)
+{
+	unsigned int n;
+	unsigned int count = sbnm_heap_count(heap);
+
+	for (n = 0; n < nr; n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % nr) / 2;
+
+		sbnm_heap_insert_lazy(heap, &nodes[n].heap);
+		cute_ensure(sbnm_heap_count(heap) == (count + n + 1));
+	}
+}
+
+static void sbnmhut_check_lazy_extract(struct sbnm_heap *heap,
+                                       unsigned int      nr)
+{
+	unsigned int n;
+	int          prev = -1;
+
+	cute_ensure(sbnm_heap_count(heap) == nr);
+
+	for (n = 0; n < nr; n++) {
+		const struct sbnm_heap_node *node;
+		int                          key;
+
+		node = sbnm_heap_peek(heap);
+		key = ((struct sbnmhut_node *)node)->key;
+		cute_ensure(key >= prev);
+
+		/* Consolidation may reorder nodes with equal keys. */
+		node = sbnm_heap_extract(heap);
+		cute_ensure(((struct sbnmhut_node *)node)->key == key);
+		cute_ensure(sbnm_heap_count(heap) == (nr - n - 1));
+
+		prev = key;
+	}
+
+	cute_ensure(lcrs_istail(heap->sbnm_roots));
+}
+
+static CUTE_PNP_FIXTURED_SUITE(sbnmhut_lazy, &sbnmhut, sbnmhut_setup_empty,
+                               NULL);
+
+CUTE_PNP_TEST(sbnmhut_lazy_consolidate, &sbnmhut_lazy)
+{
+	struct sbnmhut_node nodes[SBNMHUT_LAZY_NR];
+	unsigned int        nr;
+
+	for (nr = 1; nr <= array_nr(nodes); nr++) {
+		sbnmhut_insert_lazy(&sbnmhut_heap, nodes, nr);
+
+		sbnm_heap_consolidate(&sbnmhut_heap);
+		sbnmhut_check_roots(&sbnmhut_heap, nr);
+
+		sbnmhut_check_lazy_extract(&sbnmhut_heap, nr);
+	}
+}
+
+CUTE_PNP_TEST(sbnmhut_lazy_extract, &sbnmhut_lazy)
+{
+	struct sbnmhut_node nodes[SBNMHUT_LAZY_NR];
+	unsigned int        nr;
+
+	for (nr = 1; nr <= array_nr(nodes); nr++) {
+		sbnmhut_insert_lazy(&sbnmhut_heap, nodes, nr);
+		sbnmhut_check_lazy_extract(&sbnmhut_heap, nr);
+	}
+}
+
+CUTE_PNP_TEST(sbnmhut_lazy_mixed, &sbnmhut_lazy)
+{
+	struct sbnmhut_node nodes[SBNMHUT_LAZY_NR];
+	bool                present[SBNMHUT_LAZY_NR] = { false, };
+	unsigned int        n;
+
+	for (n = 0; n < array_nr(nodes); n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % array_nr(nodes));
+
+		if (n % 3)
+			sbnm_heap_insert_lazy(&sbnmhut_heap, &nodes[n].heap);
+		else
+			sbnm_heap_insert(&sbnmhut_heap, &nodes[n].heap);
+		present[n] = true;
+
+		if (!(n % 5)) {
+			sbnm_heap_remove(&sbnmhut_heap, &nodes[n].heap);
+			present[n] = false;
+		}
+
+		if (!(n % 7) && !sbnm_heap_empty(&sbnmhut_heap)) {
+			struct sbnmhut_node *node;
+			unsigned int         m;
+
+			node = (struct sbnmhut_node *)
+			       sbnm_heap_extract(&sbnmhut_heap);
+
+			for (m = 0; m <= n; m++)
+				if (present[m])
+					cute_ensure(nodes[m].key >= node->key);
+
+			present[node - nodes] = false;
+		}
+	}
+
+	for (n = 0; n < array_nr(nodes); n++) {
+		if (!present[n])
+			continue;
+
+		sbnm_heap_remove(&sbnmhut_heap, &nodes[n].heap);
+		present[n] = false;
+		break;
+	}
+
+	sbnmhut_check_lazy_extract(&sbnmhut_heap,
+	                           sbnm_heap_count(&sbnmhut_heap));
+}
+
+CUTE_PNP_TEST(sbnmhut_lazy_merge, &sbnmhut_lazy)
+{
+	struct sbnmhut_node fst_nodes[SBNMHUT_LAZY_NR];
+	struct sbnmhut_node snd_nodes[SBNMHUT_LAZY_NR / 2];
+	struct sbnm_heap    snd = SBNM_HEAP_INIT(snd, sbnmhut_compare_min);
+
+	sbnmhut_insert_lazy(&sbnmhut_heap, fst_nodes, array_nr(fst_nodes));
+	sbnmhut_insert_lazy(&snd, snd_nodes, array_nr(snd_nodes));
+
+	sbnm_heap_merge(&sbnmhut_heap, &snd);
+
+	sbnmhut_check_roots(&sbnmhut_heap,
+	                    array_nr(fst_nodes) + array_nr(snd_nodes));
+	sbnmhut_check_lazy_extract(&sbnmhut_heap,
+	                           array_nr(fst_nodes) + array_nr(snd_nodes));
+}
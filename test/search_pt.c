@@ -0,0 +1,439 @@
+#include "karn_pt.h"
+#include <karn/feyt_tree.h>
+#include <karn/pavl.h>
+#include <utils/cdefs.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <string.h>
+
+struct srpt_iface {
+	char  *srpt_name;
+	int  (*srpt_validate)(void);
+	void (*srpt_build)(unsigned long long *nsecs);
+	void (*srpt_find)(unsigned long long *nsecs);
+};
+
+static struct pt_entries  srpt_entries;
+/* Keys in file order, used as lookup keys. */
+static unsigned int      *srpt_keys;
+/* Keys sorted in ascending order, used to build search structures. */
+static unsigned int      *srpt_sorted;
+/* Sink preventing compiler from optimizing lookups out. */
+static volatile unsigned int srpt_sink;
+
+static int srpt_check_found(const unsigned int *found, unsigned int key)
+{
+	if (!found || (*found != key)) {
+		fprintf(stderr, "Bogus search scheme\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Plain binary search over sorted array
+ ******************************************************************************/
+
+static const unsigned int * srpt_bsearch_find_key(const unsigned int *key)
+{
+	size_t lo = 0;
+	size_t hi = (size_t)srpt_entries.pt_nr;
+
+	while (lo < hi) {
+		size_t mid = lo + ((hi - lo) / 2);
+
+		if (pt_compare_min((const char *)&srpt_sorted[mid],
+		                   (const char *)key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if ((lo < (size_t)srpt_entries.pt_nr) && (srpt_sorted[lo] == *key))
+		return &srpt_sorted[lo];
+
+	return NULL;
+}
+
+static int srpt_bsearch_validate(void)
+{
+	int n;
+
+	for (n = 0; n < srpt_entries.pt_nr; n++)
+		if (srpt_check_found(srpt_bsearch_find_key(&srpt_keys[n]),
+		                     srpt_keys[n]))
+			return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+static void srpt_bsearch_find(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    sum = 0;
+	int             n;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < srpt_entries.pt_nr; n++)
+		sum += *srpt_bsearch_find_key(&srpt_keys[n]);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	srpt_sink = sum;
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+/******************************************************************************
+ * Eytzinger search tree
+ ******************************************************************************/
+
+static struct feyt_tree  *srpt_feyt_tree;
+static char             **srpt_feyt_nodes;
+
+static int srpt_feyt_validate(void)
+{
+	int n;
+
+	srpt_feyt_tree = feyt_tree_create(sizeof(*srpt_sorted),
+	                                  srpt_entries.pt_nr,
+	                                  pt_compare_min,
+	                                  pt_copy_key);
+	if (!srpt_feyt_tree)
+		return EXIT_FAILURE;
+
+	srpt_feyt_nodes = malloc(sizeof(*srpt_feyt_nodes) *
+	                         srpt_entries.pt_nr);
+	if (!srpt_feyt_nodes)
+		return EXIT_FAILURE;
+
+	feyt_tree_build(srpt_feyt_tree, (char *)srpt_sorted,
+	                srpt_entries.pt_nr);
+
+	feyt_tree_find_batch(srpt_feyt_tree, (char *)srpt_keys,
+	                     sizeof(*srpt_keys), srpt_entries.pt_nr,
+	                     srpt_feyt_nodes);
+
+	for (n = 0; n < srpt_entries.pt_nr; n++) {
+		const char *node;
+
+		node = feyt_tree_find(srpt_feyt_tree, (char *)&srpt_keys[n]);
+		if (srpt_check_found((const unsigned int *)node, srpt_keys[n]))
+			return EXIT_FAILURE;
+
+		if (srpt_feyt_nodes[n] != node) {
+			fprintf(stderr, "Bogus batched search scheme\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void srpt_feyt_build(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	feyt_tree_build(srpt_feyt_tree, (char *)srpt_sorted,
+	                srpt_entries.pt_nr);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void srpt_feyt_find(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    sum = 0;
+	int             n;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < srpt_entries.pt_nr; n++)
+		sum += *(unsigned int *)feyt_tree_find(srpt_feyt_tree,
+		                                       (char *)&srpt_keys[n]);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	srpt_sink = sum;
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void srpt_feyt_find_batch(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	feyt_tree_find_batch(srpt_feyt_tree, (char *)srpt_keys,
+	                     sizeof(*srpt_keys), srpt_entries.pt_nr,
+	                     srpt_feyt_nodes);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	srpt_sink = *(unsigned int *)srpt_feyt_nodes[0];
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+/******************************************************************************
+ * "Parented" AVL tree
+ ******************************************************************************/
+
+#if defined(CONFIG_KARN_PAVL)
+
+struct srpt_pavl_key {
+	struct pavl_node node;
+	unsigned int     value;
+};
+
+static struct srpt_pavl_key *srpt_pavl_keys;
+static struct pavl_tree      srpt_pavl_tree;
+
+static int srpt_pavl_compare(const struct pavl_node *node,
+                             const void             *key,
+                             const void             *data __unused)
+{
+	return pt_compare_min(
+		(const char *)&((const struct srpt_pavl_key *)node)->value,
+		(const char *)key);
+}
+
+static struct pavl_node * srpt_pavl_get(unsigned int index, const void *keys)
+{
+	return &((struct srpt_pavl_key *)keys)[index].node;
+}
+
+static void srpt_pavl_load(void)
+{
+	pavl_init_tree(&srpt_pavl_tree, srpt_pavl_compare, NULL, NULL);
+	pavl_load_tree_from_sorted(&srpt_pavl_tree, srpt_pavl_keys,
+	                           srpt_entries.pt_nr, srpt_pavl_get);
+}
+
+static int srpt_pavl_validate(void)
+{
+	int n;
+
+	srpt_pavl_keys = malloc(sizeof(*srpt_pavl_keys) * srpt_entries.pt_nr);
+	if (!srpt_pavl_keys)
+		return EXIT_FAILURE;
+
+	for (n = 0; n < srpt_entries.pt_nr; n++)
+		srpt_pavl_keys[n].value = srpt_sorted[n];
+
+	srpt_pavl_load();
+
+	for (n = 0; n < srpt_entries.pt_nr; n++) {
+		const struct pavl_node *node;
+
+		node = pavl_find_node(&srpt_pavl_tree, &srpt_keys[n]);
+		if (srpt_check_found(
+			node ? &((const struct srpt_pavl_key *)node)->value :
+			       NULL,
+			srpt_keys[n]))
+			return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void srpt_pavl_build(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	srpt_pavl_load();
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+static void srpt_pavl_find(unsigned long long *nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    sum = 0;
+	int             n;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+	for (n = 0; n < srpt_entries.pt_nr; n++)
+		sum += ((const struct srpt_pavl_key *)
+		        pavl_find_node(&srpt_pavl_tree,
+		                       &srpt_keys[n]))->value;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &elapse);
+
+	srpt_sink = sum;
+
+	elapse = pt_tspec_sub(&elapse, &start);
+	*nsecs = pt_tspec2ns(&elapse);
+}
+
+#endif /* defined(CONFIG_KARN_PAVL) */
+
+/******************************************************************************
+ * Main measurement task handling
+ ******************************************************************************/
+
+static const struct srpt_iface srpt_algos[] = {
+	{
+		.srpt_name     = "bsearch",
+		.srpt_validate = srpt_bsearch_validate,
+		.srpt_build    = NULL,
+		.srpt_find     = srpt_bsearch_find
+	},
+	{
+		.srpt_name     = "feyt",
+		.srpt_validate = srpt_feyt_validate,
+		.srpt_build    = srpt_feyt_build,
+		.srpt_find     = srpt_feyt_find
+	},
+	{
+		.srpt_name     = "feyt_batch",
+		.srpt_validate = srpt_feyt_validate,
+		.srpt_build    = srpt_feyt_build,
+		.srpt_find     = srpt_feyt_find_batch
+	},
+#if defined(CONFIG_KARN_PAVL)
+	{
+		.srpt_name     = "pavl",
+		.srpt_validate = srpt_pavl_validate,
+		.srpt_build    = srpt_pavl_build,
+		.srpt_find     = srpt_pavl_find
+	},
+#endif
+};
+
+static const struct srpt_iface *
+srpt_setup_algo(const char *algo_name)
+{
+	unsigned int a;
+
+	for (a = 0; a < array_nr(srpt_algos); a++)
+		if (!strcmp(algo_name, srpt_algos[a].srpt_name))
+			return &srpt_algos[a];
+
+	fprintf(stderr, "Invalid \"%s\" search algorithm\n", algo_name);
+
+	return NULL;
+}
+
+static int
+srpt_load(const char *pathname)
+{
+	unsigned int *k;
+
+	if (pt_open_entries(pathname, &srpt_entries))
+		return EXIT_FAILURE;
+
+	srpt_keys = malloc(sizeof(*k) * srpt_entries.pt_nr);
+	srpt_sorted = malloc(sizeof(*k) * srpt_entries.pt_nr);
+	if (!srpt_keys || !srpt_sorted)
+		return EXIT_FAILURE;
+
+	pt_init_entry_iter(&srpt_entries);
+	k = srpt_keys;
+	while (!pt_iter_entry(&srpt_entries, k))
+		k++;
+
+	memcpy(srpt_sorted, srpt_keys, sizeof(*k) * srpt_entries.pt_nr);
+	qsort(srpt_sorted, srpt_entries.pt_nr, sizeof(*k), pt_qsort_compare);
+
+	return EXIT_SUCCESS;
+}
+
+static void
+usage(const char *me)
+{
+	fprintf(stderr,
+	        "Usage: %s [OPTIONS] FILE ALGORITHM LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio  PRIORITY\n"
+	        "    -h|--help\n",
+	        me);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct srpt_iface *algo;
+	unsigned int             l, loops = 0;
+	int                      prio = 0;
+	unsigned long long       nsecs;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help",    0, NULL, 'h'},
+			{"prio",    1, NULL, 'p'},
+			{0,         0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (pt_parse_sched_prio(optarg, &prio)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+
+		case '?': /* Unknown option. */
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 3) {
+		fprintf(stderr, "Invalid number of arguments\n");
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	algo = srpt_setup_algo(argv[optind + 1]);
+	if (!algo)
+		return EXIT_FAILURE;
+
+	if (pt_parse_loop_nr(argv[optind + 2], &loops))
+		return EXIT_FAILURE;
+
+	if (srpt_load(argv[optind]))
+		return EXIT_FAILURE;
+
+	if (algo->srpt_validate())
+		return EXIT_FAILURE;
+
+	if (pt_setup_sched_prio(prio))
+		return EXIT_FAILURE;
+
+	if (algo->srpt_build) {
+		for (l = 0; l < loops; l++) {
+			algo->srpt_build(&nsecs);
+			printf("build: nsec=%llu\n", nsecs);
+		}
+	}
+
+	for (l = 0; l < loops; l++) {
+		algo->srpt_find(&nsecs);
+		printf("find: nsec=%llu\n", nsecs);
+	}
+
+	return EXIT_SUCCESS;
+}
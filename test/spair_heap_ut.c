@@ -1752,3 +1752,210 @@ CUTE_PNP_TEST(spairhut_demote_altorder, &spairhut_demote)
 	                          array_nr(spairhut_nodes),
 	                          spairhut_compare_min);
 }
+
+#define SPAIRHUT_BATCH_NR (40U)
+
+static void spairhut_check_batch(struct spairhut_node *nodes,
+                                 unsigned int         nr)
+{
+	struct lcrs_node *keys[SPAIRHUT_BATCH_NR];
+	struct lcrs_node *out[SPAIRHUT_BATCH_NR];
+	unsigned int      n;
+	int               prev = -1;
+
+	for (n = 0; n < nr; n++) {
+		nodes[n].key = (int)(((n * 37U) + 11U) % nr) / 2;
+		keys[n] = &nodes[n].heap;
+	}
+
+	spair_heap_insert_batch(&spairhut_heap, keys, 25, spairhut_compare_min);
+	cute_ensure(spair_heap_count(&spairhut_heap) == 25);
+	spair_heap_insert_batch(&spairhut_heap, &keys[25], nr - 25,
+	                        spairhut_compare_min);
+	cute_ensure(spair_heap_count(&spairhut_heap) == nr);
+
+	cute_ensure(spair_heap_extract_batch(&spairhut_heap, out, 10,
+	                                     spairhut_compare_min) == 10);
+	cute_ensure(spair_heap_extract_batch(&spairhut_heap, &out[10], nr,
+	                                     spairhut_compare_min) ==
+	            (nr - 10));
+	cute_ensure(spair_heap_empty(&spairhut_heap));
+
+	for (n = 0; n < nr; n++) {
+		int key = ((struct spairhut_node *)out[n])->key;
+
+		cute_ensure(key >= prev);
+		prev = key;
+	}
+}
+
+static CUTE_PNP_FIXTURED_SUITE(spairhut_batch, &spairhut, spairhut_setup_empty,
+                               NULL);
+
+CUTE_PNP_TEST(spairhut_batch_insert_extract, &spairhut_batch)
+{
+	struct spairhut_node nodes[SPAIRHUT_BATCH_NR];
+
+	spairhut_check_batch(nodes, array_nr(nodes));
+}
+
+#define SPAIRHUT_MODE_NR (48U)
+
+static int spairhut_mode_min(const struct spairhut_node *nodes,
+                             const bool                 *present,
+                             unsigned int               *count)
+{
+	unsigned int n;
+	int          min = -1;
+
+	*count = 0;
+	for (n = 0; n < SPAIRHUT_MODE_NR; n++) {
+		if (!present[n])
+			continue;
+
+		if (!*count || (nodes[n].key < min))
+			min = nodes[n].key;
+		(*count)++;
+	}
+
+	return min;
+}
+
+static void spairhut_check_mode_heap(const struct spair_heap    *heap,
+                                     const struct spairhut_node *nodes,
+                                     const bool                 *present)
+{
+	const struct lcrs_node *tree;
+	unsigned int            count;
+	int                     min;
+
+	min = spairhut_mode_min(nodes, present, &count);
+
+	cute_ensure(spair_heap_count(heap) == count);
+	if (!count)
+		return;
+
+	cute_ensure(((struct spairhut_node *)spair_heap_peek(heap))->key ==
+	            min);
+
+	spairhut_check_root(heap->spair_root, spairhut_compare_min);
+	for (tree = heap->spair_aux; !lcrs_istail(tree); tree = lcrs_next(tree))
+		spairhut_check_root(tree, spairhut_compare_min);
+}
+
+static void spairhut_extract_mode(struct spair_heap          *heap,
+                                  const struct spairhut_node *nodes,
+                                  bool                       *present)
+{
+	const struct spairhut_node *node;
+	unsigned int                count;
+	int                         min;
+
+	min = spairhut_mode_min(nodes, present, &count);
+
+	node = (struct spairhut_node *)spair_heap_extract(heap,
+	                                                  spairhut_compare_min);
+	cute_ensure(node->key == min);
+
+	present[node - nodes] = false;
+}
+
+/*
+ * Run a sequence of interleaved insertions, promotions, demotions, removals
+ * and extractions then drain heap, checking the smallest node is retrieved
+ * at each step.
+ */
+static void spairhut_check_mode(unsigned int mode)
+{
+	struct spair_heap     heap;
+	struct spairhut_node  nodes[SPAIRHUT_MODE_NR];
+	struct lcrs_node     *keys[SPAIRHUT_MODE_NR / 4];
+	bool                  present[SPAIRHUT_MODE_NR] = { false, };
+	unsigned int          nr = SPAIRHUT_MODE_NR - array_nr(keys);
+	unsigned int          n, k;
+
+	spair_heap_init_mode(&heap, mode);
+
+	for (n = 0; n < SPAIRHUT_MODE_NR; n++)
+		nodes[n].key = (int)(((n * 37U) + 11U) % SPAIRHUT_MODE_NR);
+
+	for (n = 0; n < nr; n++) {
+		spair_heap_insert(&heap, &nodes[n].heap, spairhut_compare_min);
+		present[n] = true;
+		spairhut_check_mode_heap(&heap, nodes, present);
+
+		k = n / 2;
+		if (((n % 4) == 3) && present[k]) {
+			nodes[k].key -= SPAIRHUT_MODE_NR / 2;
+			spair_heap_promote(&heap, &nodes[k].heap,
+			                   spairhut_compare_min);
+			spairhut_check_mode_heap(&heap, nodes, present);
+		}
+
+		k = n / 3;
+		if (((n % 5) == 4) && present[k]) {
+			nodes[k].key += SPAIRHUT_MODE_NR / 2;
+			spair_heap_demote(&heap, &nodes[k].heap,
+			                  spairhut_compare_min);
+			spairhut_check_mode_heap(&heap, nodes, present);
+		}
+
+		k = n - 1;
+		if (((n % 7) == 6) && present[k]) {
+			spair_heap_remove(&heap, &nodes[k].heap,
+			                  spairhut_compare_min);
+			present[k] = false;
+			spairhut_check_mode_heap(&heap, nodes, present);
+		}
+
+		if ((n % 6) == 5) {
+			spairhut_extract_mode(&heap, nodes, present);
+			spairhut_check_mode_heap(&heap, nodes, present);
+		}
+	}
+
+	for (k = 0; k < array_nr(keys); k++) {
+		keys[k] = &nodes[nr + k].heap;
+		present[nr + k] = true;
+	}
+	spair_heap_insert_batch(&heap, keys, array_nr(keys),
+	                        spairhut_compare_min);
+	spairhut_check_mode_heap(&heap, nodes, present);
+
+	while (!spair_heap_empty(&heap)) {
+		spairhut_extract_mode(&heap, nodes, present);
+		spairhut_check_mode_heap(&heap, nodes, present);
+	}
+}
+
+static CUTE_PNP_SUITE(spairhut_mode, &spairhut);
+
+CUTE_PNP_TEST(spairhut_mode_twopass, &spairhut_mode)
+{
+	spairhut_check_mode(SPAIR_HEAP_TWOPASS_MODE);
+}
+
+CUTE_PNP_TEST(spairhut_mode_multipass, &spairhut_mode)
+{
+	spairhut_check_mode(SPAIR_HEAP_MULTIPASS_MODE);
+}
+
+CUTE_PNP_TEST(spairhut_mode_front2back, &spairhut_mode)
+{
+	spairhut_check_mode(SPAIR_HEAP_FRONT2BACK_MODE);
+}
+
+CUTE_PNP_TEST(spairhut_mode_aux_twopass, &spairhut_mode)
+{
+	spairhut_check_mode(SPAIR_HEAP_AUX_MODE | SPAIR_HEAP_TWOPASS_MODE);
+}
+
+CUTE_PNP_TEST(spairhut_mode_aux_multipass, &spairhut_mode)
+{
+	spairhut_check_mode(SPAIR_HEAP_AUX_MODE | SPAIR_HEAP_MULTIPASS_MODE);
+}
+
+CUTE_PNP_TEST(spairhut_mode_aux_front2back, &spairhut_mode)
+{
+	spairhut_check_mode(SPAIR_HEAP_AUX_MODE | SPAIR_HEAP_FRONT2BACK_MODE);
+}
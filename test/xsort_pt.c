@@ -0,0 +1,226 @@
+#include "karn_pt.h"
+#include <karn/xsort.h>
+#include <utils/cdefs.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <errno.h>
+#include <string.h>
+
+#define XSPT_MEM_SIZE_MIN (3 * sizeof(uint32_t))
+
+static struct pt_entries  xspt_entries;
+static size_t             xspt_mem_size = 64U << 20;
+static const char        *xspt_tmp_dir;
+
+static int xspt_compare(const char *first, const char *second)
+{
+	uint32_t fst = *(const uint32_t *)first;
+	uint32_t snd = *(const uint32_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static void xspt_copy(char *restrict dest, const char *restrict src)
+{
+	*(uint32_t *)dest = *(const uint32_t *)src;
+}
+
+/* Check output file holds the same number of keys as input, in order. */
+static int xspt_validate(FILE *out)
+{
+	uint32_t prev = 0;
+	uint32_t key;
+	int      nr = 0;
+
+	rewind(out);
+
+	while (fread(&key, sizeof(key), 1, out) == 1) {
+		if (nr && (prev > key)) {
+			fprintf(stderr, "Bogus sorting scheme\n");
+			return EXIT_FAILURE;
+		}
+
+		prev = key;
+		nr++;
+	}
+
+	if (nr != xspt_entries.pt_nr) {
+		fprintf(stderr, "Bogus number of sorted keys\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int xspt_sort(bool validate)
+{
+	FILE               *out;
+	struct timespec     start, elapse;
+	struct xsort_stats  stats;
+	int                 err;
+	int                 ret = EXIT_FAILURE;
+
+	out = tmpfile();
+	if (!out) {
+		perror("Failed to create output file");
+		return EXIT_FAILURE;
+	}
+
+	pt_init_entry_iter(&xspt_entries);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	err = xsort_file(fileno(xspt_entries.pt_file), fileno(out),
+	                 sizeof(uint32_t), xspt_mem_size, xspt_compare,
+	                 xspt_copy, xspt_tmp_dir, &stats);
+	clock_gettime(CLOCK_MONOTONIC, &elapse);
+
+	if (err) {
+		fprintf(stderr, "Failed to sort: %s\n", strerror(-err));
+		goto close;
+	}
+
+	if (validate) {
+		ret = xspt_validate(out);
+		goto close;
+	}
+
+	elapse = pt_tspec_sub(&elapse, &start);
+
+	printf("nsec=%llu read_nsec=%llu sort_nsec=%llu spill_nsec=%llu "
+	       "merge_nsec=%llu runs=%u passes=%u\n",
+	       pt_tspec2ns(&elapse),
+	       (unsigned long long)stats.xsort_read_nsec,
+	       (unsigned long long)stats.xsort_sort_nsec,
+	       (unsigned long long)stats.xsort_spill_nsec,
+	       (unsigned long long)stats.xsort_merge_nsec,
+	       stats.xsort_run_nr,
+	       stats.xsort_pass_nr);
+
+	ret = EXIT_SUCCESS;
+
+close:
+	fclose(out);
+
+	return ret;
+}
+
+static int xspt_parse_mem_size(const char *arg, size_t *mem_size)
+{
+	char          *str;
+	unsigned long  size;
+	int            err = 0;
+
+	size = strtoul(arg, &str, 0);
+	if (*str)
+		err = EINVAL;
+	else if (size < XSPT_MEM_SIZE_MIN)
+		err = ERANGE;
+
+	if (err) {
+		fprintf(stderr, "Invalid memory size specified: %s\n",
+		        strerror(err));
+		return EXIT_FAILURE;
+	}
+
+	*mem_size = size;
+
+	return EXIT_SUCCESS;
+}
+
+static void
+usage(const char *me)
+{
+	fprintf(stderr,
+	        "Usage: %s [OPTIONS] FILE LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio       PRIORITY\n"
+	        "    -m|--memory     BYTES\n"
+	        "    -d|--tmpdir     DIRECTORY\n"
+	        "    -h|--help\n",
+	        me);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int loops = 0;
+	unsigned int l;
+	int          prio = 0;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help",   0, NULL, 'h'},
+			{"prio",   1, NULL, 'p'},
+			{"memory", 1, NULL, 'm'},
+			{"tmpdir", 1, NULL, 'd'},
+			{0,        0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:m:d:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (pt_parse_sched_prio(optarg, &prio)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'm': /* memory budget */
+			if (xspt_parse_mem_size(optarg, &xspt_mem_size)) {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'd': /* temporary files directory */
+			xspt_tmp_dir = optarg;
+			break;
+
+		case 'h': /* Help message. */
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+
+		case '?': /* Unknown option. */
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 2) {
+		fprintf(stderr, "Invalid number of arguments\n");
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (pt_parse_loop_nr(argv[optind + 1], &loops))
+		return EXIT_FAILURE;
+
+	if (pt_open_entries(argv[optind], &xspt_entries))
+		return EXIT_FAILURE;
+
+	if (xspt_sort(true))
+		return EXIT_FAILURE;
+
+	if (pt_setup_sched_prio(prio))
+		return EXIT_FAILURE;
+
+	for (l = 0; l < loops; l++)
+		if (xspt_sort(false))
+			return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file      xsort_ut.c
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      16 Oct 2026
+ * @copyright GNU Public License v3
+ *
+ * External sorting unit tests implementation
+ *
+ * This file is part of Karn
+ *
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <karn/xsort.h>
+#include <cute/cute.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define XSORTUT_REC_NR (4096U)
+
+static int xsortut_compare(const char *first, const char *second)
+{
+	uint32_t fst = *(const uint32_t *)first;
+	uint32_t snd = *(const uint32_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static void xsortut_copy(char *restrict dest, const char *restrict src)
+{
+	*(uint32_t *)dest = *(const uint32_t *)src;
+}
+
+static uint32_t xsortut_rand(unsigned int *seed)
+{
+	*seed = (*seed * 1103515245U) + 12345U;
+
+	return *seed >> 4;
+}
+
+/*
+ * Write nr pseudo random records to a temporary file, sort them using the
+ * given memory budget and check output is a sorted permutation of input.
+ */
+static void xsortut_check(unsigned int        nr,
+                          size_t              mem_size,
+                          unsigned int        seed,
+                          struct xsort_stats *stats)
+{
+	FILE         *in;
+	FILE         *out;
+	uint32_t     *recs;
+	uint32_t     *res;
+	unsigned int  r;
+
+	recs = malloc(2 * nr * sizeof(*recs));
+	cute_ensure(recs || !nr);
+	res = &recs[nr];
+
+	for (r = 0; r < nr; r++)
+		recs[r] = xsortut_rand(&seed);
+
+	in = tmpfile();
+	cute_ensure(in);
+	out = tmpfile();
+	cute_ensure(out);
+
+	cute_ensure(fwrite(recs, sizeof(*recs), nr, in) == nr);
+	fflush(in);
+	rewind(in);
+
+	cute_ensure(!xsort_file(fileno(in), fileno(out), sizeof(*recs),
+	                        mem_size, xsortut_compare, xsortut_copy, NULL,
+	                        stats));
+
+	rewind(out);
+	cute_ensure(fread(res, sizeof(*res), nr, out) == nr);
+	cute_ensure(fgetc(out) == EOF);
+
+	qsort(recs, nr, sizeof(*recs),
+	      (int (*)(const void *, const void *))xsortut_compare);
+	cute_ensure(!memcmp(recs, res, nr * sizeof(*recs)));
+
+	fclose(out);
+	fclose(in);
+	free(recs);
+}
+
+static CUTE_PNP_SUITE(xsortut, NULL);
+
+CUTE_PNP_TEST(xsortut_in_memory, &xsortut)
+{
+	struct xsort_stats stats;
+
+	xsortut_check(XSORTUT_REC_NR, XSORTUT_REC_NR * sizeof(uint32_t) * 2, 1,
+	              &stats);
+
+	cute_ensure(stats.xsort_rec_nr == XSORTUT_REC_NR);
+	cute_ensure(stats.xsort_run_nr == 1);
+	cute_ensure(!stats.xsort_pass_nr);
+}
+
+CUTE_PNP_TEST(xsortut_exact_run, &xsortut)
+{
+	struct xsort_stats stats;
+
+	xsortut_check(XSORTUT_REC_NR, XSORTUT_REC_NR * sizeof(uint32_t), 2,
+	              &stats);
+
+	cute_ensure(stats.xsort_run_nr == 1);
+	cute_ensure(stats.xsort_pass_nr == 1);
+}
+
+CUTE_PNP_TEST(xsortut_single_pass, &xsortut)
+{
+	struct xsort_stats stats;
+
+	/* 2 runs merged using 3 blocks. */
+	xsortut_check(XSORTUT_REC_NR, (XSORTUT_REC_NR / 2) * sizeof(uint32_t),
+	              3, &stats);
+
+	cute_ensure(stats.xsort_run_nr == 2);
+	cute_ensure(stats.xsort_pass_nr == 1);
+}
+
+CUTE_PNP_TEST(xsortut_multi_pass, &xsortut)
+{
+	struct xsort_stats stats;
+
+	/* 41 runs of 100 records merged 2 by 2. */
+	xsortut_check(XSORTUT_REC_NR, 100 * sizeof(uint32_t), 4, &stats);
+
+	cute_ensure(stats.xsort_run_nr == 41);
+	cute_ensure(stats.xsort_pass_nr == 6);
+}
+
+CUTE_PNP_TEST(xsortut_empty, &xsortut)
+{
+	struct xsort_stats stats;
+
+	xsortut_check(0, 16 * sizeof(uint32_t), 5, &stats);
+
+	cute_ensure(!stats.xsort_rec_nr);
+	cute_ensure(!stats.xsort_run_nr);
+}
+
+CUTE_PNP_TEST(xsortut_partial_record, &xsortut)
+{
+	FILE           *in;
+	FILE           *out;
+	const uint16_t  rec = 0;
+
+	in = tmpfile();
+	cute_ensure(in);
+	out = tmpfile();
+	cute_ensure(out);
+
+	cute_ensure(fwrite(&rec, sizeof(rec), 1, in) == 1);
+	fflush(in);
+	rewind(in);
+
+	cute_ensure(xsort_file(fileno(in), fileno(out), sizeof(uint32_t),
+	                       16 * sizeof(uint32_t), xsortut_compare,
+	                       xsortut_copy, NULL, NULL) == -EINVAL);
+
+	fclose(out);
+	fclose(in);
+}
+
+CUTE_PNP_TEST(xsortut_tiny_budget, &xsortut)
+{
+	cute_ensure(xsort_file(STDIN_FILENO, STDOUT_FILENO, sizeof(uint32_t),
+	                       2 * sizeof(uint32_t), xsortut_compare,
+	                       xsortut_copy, NULL, NULL) == -EINVAL);
+}